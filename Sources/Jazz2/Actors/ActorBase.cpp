@@ -34,7 +34,7 @@ namespace Jazz2::Actors
 		: _state(ActorState::None), _levelHandler(nullptr), _internalForceY(0.0f), _elasticity(0.0f), _friction(1.5f),
 			_unstuckCooldown(0.0f), _frozenTimeLeft(0.0f), _maxHealth(1), _health(1), _spawnFrames(0.0f), _metadata(nullptr),
 			_renderer(this), _currentAnimation(nullptr), _currentTransition(nullptr), _currentTransitionCancellable(false),
-			_collisionProxyID(Collisions::NullNode)
+			_collisionProxyID(Collisions::NullNode), _cullingCell(-1)
 	{
 	}
 
@@ -717,17 +717,14 @@ namespace Jazz2::Actors
 
 	std::shared_ptr<AudioBufferPlayer> ActorBase::PlaySfx(StringView identifier, float gain, float pitch)
 	{
-		auto it = _metadata->Sounds.find(String::nullTerminatedView(identifier));
-		if (it != _metadata->Sounds.end()) {
-			AudioBuffer* buffer;
-			if (!it->second.Buffers.empty()) {
-				std::int32_t idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (std::int32_t)it->second.Buffers.size()) : 0);
-				buffer = &it->second.Buffers[idx]->Buffer;
-			} else {
-				buffer = nullptr;
-			}
+		return PlaySfx(_metadata->FindSound(identifier), gain, pitch);
+	}
 
-			return _levelHandler->PlaySfx(this, identifier, buffer, Vector3f(_pos.X, _pos.Y, 0.0f), false, gain, pitch);
+	std::shared_ptr<AudioBufferPlayer> ActorBase::PlaySfx(SoundHandle sound, float gain, float pitch)
+	{
+		auto* resource = _metadata->GetSound(sound);
+		if (resource != nullptr) {
+			return _levelHandler->PlaySfx(this, resource->Identifier, resource->PickBuffer(), Vector3f(_pos.X, _pos.Y, 0.0f), false, gain, pitch, resource->Priority);
 		}
 
 		return nullptr;
@@ -41,6 +41,7 @@ namespace Jazz2
 
 namespace Jazz2::Rendering
 {
+	class ActorCullingNode;
 	class LightingRenderer;
 	class CombineRenderer;
 }
@@ -320,6 +321,7 @@ namespace Jazz2::Actors
 
 		friend class Player;
 		friend class Jazz2::LevelHandler;
+		friend class Jazz2::Rendering::ActorCullingNode;
 		friend class Jazz2::Rendering::LightingRenderer;
 		// Software renderer approximates the dynamic lighting in the combine step and needs the same light source
 		friend class Jazz2::Rendering::CombineRenderer;
@@ -564,6 +566,10 @@ namespace Jazz2::Actors
 		virtual bool OnDraw(RenderQueue& renderQueue);
 		/** @brief Called when emitting lights */
 		virtual void OnEmitLights(SmallVectorImpl<LightEmitter>& lights) { }
+		/** @brief Returns `true` if @ref OnDraw() can draw far from the object position, so it's never spatially culled */
+		virtual bool HasUnboundedDraw() const {
+			return false;
+		}
 		/** @brief Called when the object hits a floor */
 		virtual void OnHitFloor(float timeMult);
 		/** @brief Called when the object hits a ceiling */
@@ -598,6 +604,8 @@ namespace Jazz2::Actors
 
 		/** @brief Plays a sound effect for the object */
 		std::shared_ptr<AudioBufferPlayer> PlaySfx(StringView identifier, float gain = 1.0f, float pitch = 1.0f);
+		/** @overload */
+		std::shared_ptr<AudioBufferPlayer> PlaySfx(SoundHandle sound, float gain = 1.0f, float pitch = 1.0f);
 		/** @brief Sets an animation of the object */
 		bool SetAnimation(AnimState state, bool skipAnimation = false);
 		/** @brief Sets a transition animation of the object */
@@ -671,6 +679,7 @@ namespace Jazz2::Actors
 		ActorBase& operator=(const ActorBase&) = delete;
 
 		std::int32_t _collisionProxyID;
+		std::int32_t _cullingCell;
 		ActorState _state;
 		Function<void()> _currentTransitionCallback;
 
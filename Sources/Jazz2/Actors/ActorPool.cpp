@@ -0,0 +1,73 @@
+#include "ActorPool.h"
+
+#include <mutex>
+
+using namespace Death::Threading;
+
+namespace Jazz2::Actors
+{
+	Spinlock ActorPool::_registryLock;
+	ActorPool::FreeList* ActorPool::_registry = nullptr;
+
+	ActorPool::FreeList& ActorPool::Register(std::size_t size, std::size_t alignment)
+	{
+		// Free lists live for the whole process, the pooled types are known at compile time
+		FreeList* list = new FreeList();
+		list->Head = nullptr;
+		list->Count = 0;
+		list->Size = size;
+		list->Alignment = alignment;
+
+		std::unique_lock lock(_registryLock);
+		list->Next = _registry;
+		_registry = list;
+		return *list;
+	}
+
+	void* ActorPool::Allocate(FreeList& list)
+	{
+		{
+			std::unique_lock lock(list.Lock);
+			void* block = list.Head;
+			if (block != nullptr) {
+				list.Head = *static_cast<void**>(block);
+				list.Count--;
+				return block;
+			}
+		}
+		return ::operator new(list.Size, std::align_val_t(list.Alignment));
+	}
+
+	void ActorPool::Deallocate(FreeList& list, void* p) noexcept
+	{
+		{
+			std::unique_lock lock(list.Lock);
+			if (list.Count < MaxFreeBlocksPerType) {
+				*static_cast<void**>(p) = list.Head;
+				list.Head = p;
+				list.Count++;
+				return;
+			}
+		}
+		::operator delete(p, std::align_val_t(list.Alignment));
+	}
+
+	void ActorPool::Trim()
+	{
+		std::unique_lock registryLock(_registryLock);
+		for (FreeList* list = _registry; list != nullptr; list = list->Next) {
+			void* block;
+			{
+				std::unique_lock lock(list->Lock);
+				block = list->Head;
+				list->Head = nullptr;
+				list->Count = 0;
+			}
+			while (block != nullptr) {
+				void* next = *static_cast<void**>(block);
+				::operator delete(block, std::align_val_t(list->Alignment));
+				block = next;
+			}
+		}
+	}
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "../../Main.h"
+
+#include <Threading/Spinlock.h>
+
+#include <memory>
+#include <new>
+
+namespace Jazz2::Actors
+{
+	/**
+		@brief Recycles the memory of short-lived actors
+
+		Projectiles, explosions and spawned enemies are created and destroyed at a high rate, a volley of rapid
+		fire in a crowded multiplayer session alone churns thousands of heap blocks per second. Actors created by
+		@ref CreatePooledActor() share one allocation for the object and its reference counts (as with
+		`std::make_shared()`), which returns to a free list of its type once the last `std::shared_ptr` and
+		`std::weak_ptr` are gone - normally when @ref LevelHandler removes the destroyed actor at the end of
+		its collision pass. The next actor of the same type is constructed in it again, so the object itself
+		always starts from its constructor and no reset logic is needed per actor type.
+	*/
+	class ActorPool
+	{
+	public:
+		/** @brief Maximum number of free blocks kept for each actor type, any further blocks are freed */
+		static constexpr std::int32_t MaxFreeBlocksPerType = 256;
+
+		/** @brief Allocator for `std::allocate_shared()` taking the blocks from the free list of the allocated type */
+		template<class T>
+		class Allocator
+		{
+		public:
+			using value_type = T;
+
+			Allocator() noexcept = default;
+			template<class U> Allocator(const Allocator<U>&) noexcept {}
+
+			T* allocate(std::size_t n) {
+				if DEATH_UNLIKELY(n != 1) {
+					return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+				}
+				return static_cast<T*>(ActorPool::Allocate(GetFreeList<T>()));
+			}
+
+			void deallocate(T* p, std::size_t n) noexcept {
+				if DEATH_UNLIKELY(n != 1) {
+					::operator delete(p, std::align_val_t(alignof(T)));
+					return;
+				}
+				ActorPool::Deallocate(GetFreeList<T>(), p);
+			}
+
+			template<class U> bool operator==(const Allocator<U>&) const noexcept { return true; }
+			template<class U> bool operator!=(const Allocator<U>&) const noexcept { return false; }
+		};
+
+		ActorPool() = delete;
+		~ActorPool() = delete;
+
+		/** @brief Frees all blocks kept in the free lists, called when a level is unloaded */
+		static void Trim();
+
+	private:
+		struct FreeList {
+			Death::Threading::Spinlock Lock;
+			void* Head;
+			std::int32_t Count;
+			std::size_t Size;
+			std::size_t Alignment;
+			FreeList* Next;
+		};
+
+		static Death::Threading::Spinlock _registryLock;
+		static FreeList* _registry;
+
+		// One free list per allocated type (the control block `std::allocate_shared()` rebinds the allocator to),
+		// registered on first use so Trim() can reach it
+		template<class T>
+		static FreeList& GetFreeList() {
+			static_assert(sizeof(T) >= sizeof(void*), "Pooled blocks must be able to hold a pointer");
+			static FreeList& list = Register(sizeof(T), alignof(T));
+			return list;
+		}
+
+		static FreeList& Register(std::size_t size, std::size_t alignment);
+		static void* Allocate(FreeList& list);
+		static void Deallocate(FreeList& list, void* p) noexcept;
+	};
+
+	/** @brief Creates an actor whose memory is recycled through @ref ActorPool */
+	template<class T, class... Args>
+	std::shared_ptr<T> CreatePooledActor(Args&&... args)
+	{
+		return std::allocate_shared<T>(ActorPool::Allocator<T>(), std::forward<Args>(args)...);
+	}
+}
@@ -117,7 +117,7 @@ namespace Jazz2::Actors::Collectibles
 					instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatVector(Colorf(1.0f, 1.0f, 1.0f, 0.7f).Data());
 
 					auto& pos = _pieces[i].Pos;
-					command->SetTransformation(Matrix4x4f::Translation(pos.X, pos.Y, 0.0f).RotateZ(_pieces[i].Angle));
+					command->SetTransformation(Matrix2x3f::Translation(pos.X, pos.Y).RotateZ(_pieces[i].Angle));
 					command->SetLayer(_renderer.layer() - 2);
 					resolver.BindSpritePalette(*command, *res->Base->TextureDiffuse.get(), indexed, res->PaletteOffset);
 
@@ -1,4 +1,5 @@
 #include "Bilsy.h"
+#include "../../ActorPool.h"
 #include "../../../ILevelHandler.h"
 #include "../../Player.h"
 #include "../../Explosion.h"
@@ -100,7 +101,7 @@ namespace Jazz2::Actors::Bosses
 						SetTransition((AnimState)1073741826, false, [this]() {
 							PlaySfx("ThrowFireball"_s);
 
-							std::shared_ptr<Fireball> fireball = std::make_shared<Fireball>();
+							std::shared_ptr<Fireball> fireball = CreatePooledActor<Fireball>();
 							uint8_t fireballParams[2] = { _theme, (uint8_t)(IsFacingLeft() ? 1 : 0) };
 							fireball->OnActivated(ActorActivationDetails(
 								_levelHandler,
@@ -1,4 +1,5 @@
 #include "Bolly.h"
+#include "../../ActorPool.h"
 #include "../../../ILevelHandler.h"
 #include "../Crab.h"
 #include "../../Player.h"
@@ -273,7 +274,7 @@ namespace Jazz2::Actors::Bosses
 		if (found) {
 			Vector2f diff = (targetPos - _pos).Normalized();
 
-			std::shared_ptr<Rocket> rocket = std::make_shared<Rocket>();
+			std::shared_ptr<Rocket> rocket = CreatePooledActor<Rocket>();
 			rocket->OnActivated(ActorActivationDetails(
 				_levelHandler,
 				Vector3i((std::int32_t)_pos.X + (IsFacingLeft() ? 10 : -10), (std::int32_t)_pos.Y + 10, _renderer.layer() - 4)
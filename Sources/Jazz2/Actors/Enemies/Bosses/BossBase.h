@@ -25,6 +25,9 @@ namespace Jazz2::Actors::Bosses
 
 	protected:
 		bool OnTileDeactivated() override;
+		bool HasUnboundedDraw() const override {
+			return true;
+		}
 		void SetHealthByDifficulty(std::int32_t health) override;
 	};
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "Bubba.h"
+#include "../../ActorPool.h"
 #include "../../../ILevelHandler.h"
 #include "../../Player.h"
 #include "../../Explosion.h"
@@ -85,7 +86,7 @@ namespace Jazz2::Actors::Bosses
 								float x = (IsFacingLeft() ? -16.0f : 16.0f);
 								float y = -5.0f;
 
-								std::shared_ptr<Fireball> fireball = std::make_shared<Fireball>();
+								std::shared_ptr<Fireball> fireball = CreatePooledActor<Fireball>();
 								uint8_t fireballParams[1] = { (uint8_t)(IsFacingLeft() ? 1 : 0) };
 								fireball->OnActivated(ActorActivationDetails(
 									_levelHandler,
@@ -1,4 +1,5 @@
 ﻿#include "Devan.h"
+#include "../../ActorPool.h"
 #include "../../../ILevelHandler.h"
 #include "../../Player.h"
 #include "../../Explosion.h"
@@ -236,7 +237,7 @@ namespace Jazz2::Actors::Bosses
 				SetTransition(DemonSpewFireball, false, [this]() {
 					PlaySfx("SpitFireball"_s);
 
-					std::shared_ptr<Fireball> fireball = std::make_shared<Fireball>();
+					std::shared_ptr<Fireball> fireball = CreatePooledActor<Fireball>();
 					std::uint8_t fireballParams[1] = { (std::uint8_t)(IsFacingLeft() ? 1 : 0) };
 					fireball->OnActivated(ActorActivationDetails(
 						_levelHandler,
@@ -399,7 +400,7 @@ namespace Jazz2::Actors::Bosses
 		PlaySfx("Shoot"_s);
 
 		SetTransition(ShootInProgress, false, [this]() {
-			std::shared_ptr<Bullet> bullet = std::make_shared<Bullet>();
+			std::shared_ptr<Bullet> bullet = CreatePooledActor<Bullet>();
 			std::uint8_t fireballParams[1] = { (std::uint8_t)(IsFacingLeft() ? 1 : 0) };
 			bullet->OnActivated(ActorActivationDetails(
 				_levelHandler,
@@ -1,4 +1,5 @@
 #include "Queen.h"
+#include "../../ActorPool.h"
 #include "../../../ILevelHandler.h"
 #include "../../Player.h"
 #include "../../Environment/Spring.h"
@@ -145,7 +146,7 @@ namespace Jazz2::Actors::Bosses
 								}
 							}
 
-							std::shared_ptr<Brick> brick = std::make_shared<Brick>();
+							std::shared_ptr<Brick> brick = CreatePooledActor<Brick>();
 							brick->OnActivated(ActorActivationDetails(
 								_levelHandler,
 								Vector3i((std::int32_t)(player->GetPos().X + Random().NextFloat(-50.0f, 50.0f)), (std::int32_t)(_pos.Y - 200.0f), _renderer.layer() - 20)
@@ -1,4 +1,5 @@
 ﻿#include "Robot.h"
+#include "../../ActorPool.h"
 #include "../../../ILevelHandler.h"
 #include "../../Player.h"
 #include "../../Explosion.h"
@@ -173,7 +174,7 @@ namespace Jazz2::Actors::Bosses
 			return;
 		}
 
-		std::shared_ptr<SpikeBall> spikeBall = std::make_shared<SpikeBall>();
+		std::shared_ptr<SpikeBall> spikeBall = CreatePooledActor<SpikeBall>();
 		uint8_t spikeBallParams[1] = { (uint8_t)(IsFacingLeft() ? 1 : 0) };
 		spikeBall->OnActivated(ActorActivationDetails(
 			_levelHandler,
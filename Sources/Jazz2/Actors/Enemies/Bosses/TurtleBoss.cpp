@@ -1,4 +1,5 @@
 #include "TurtleBoss.h"
+#include "../../ActorPool.h"
 #include "../../../ILevelHandler.h"
 #include "../../Player.h"
 #include "../../Explosion.h"
@@ -149,7 +150,7 @@ namespace Jazz2::Actors::Bosses
 			shellSpeedY = -0.98f;
 		}
 
-		std::shared_ptr<Enemies::TurtleShell> shell = std::make_shared<Enemies::TurtleShell>();
+		std::shared_ptr<Enemies::TurtleShell> shell = CreatePooledActor<Enemies::TurtleShell>();
 		uint8_t shellParams[9];
 		EventParamsWriter writer(shellParams);
 		writer.SetFloat(0, _speed.X * 1.1f);
@@ -1,4 +1,5 @@
 #include "Uterus.h"
+#include "../../ActorPool.h"
 #include "../../../ILevelHandler.h"
 #include "../../Player.h"
 #include "../../Explosion.h"
@@ -99,7 +100,7 @@ namespace Jazz2::Actors::Bosses
 					float force = Random().NextFloat(-15.0f, 15.0f);
 
 					// TODO: Implement Crab spawn animation
-					std::shared_ptr<Enemies::Crab> crab = std::make_shared<Enemies::Crab>();
+					std::shared_ptr<Enemies::Crab> crab = CreatePooledActor<Enemies::Crab>();
 					crab->OnActivated(ActorActivationDetails(
 						_levelHandler,
 						Vector3i((std::int32_t)_pos.X, (std::int32_t)_pos.Y, _renderer.layer() - 4)
@@ -1,4 +1,5 @@
 #include "Caterpillar.h"
+#include "../ActorPool.h"
 #include "../../ILevelHandler.h"
 #include "../../Tiles/TileMap.h"
 #include "../Player.h"
@@ -65,7 +66,7 @@ namespace Jazz2::Actors::Enemies
 
 					SetAnimation((AnimState)5);
 					SetTransition((AnimState)4, true, [this]() {
-						std::shared_ptr<Smoke> smoke = std::make_shared<Smoke>();
+						std::shared_ptr<Smoke> smoke = CreatePooledActor<Smoke>();
 						smoke->OnActivated(ActorActivationDetails(
 							_levelHandler,
 							Vector3i((std::int32_t)_pos.X - 26, (std::int32_t)_pos.Y - 18, _renderer.layer() + 20)
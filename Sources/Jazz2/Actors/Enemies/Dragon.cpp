@@ -1,4 +1,5 @@
 ﻿#include "Dragon.h"
+#include "../ActorPool.h"
 #include "../../ILevelHandler.h"
 #include "../../Tiles/TileMap.h"
 #include "../Explosion.h"
@@ -90,7 +91,7 @@ namespace Jazz2::Actors::Enemies
 						});
 					} else {
 						if (_attackTime <= 0.0f) {
-							std::shared_ptr<Fire> fire = std::make_shared<Fire>();
+							std::shared_ptr<Fire> fire = CreatePooledActor<Fire>();
 							uint8_t fireParams[1];
 							fireParams[0] = (IsFacingLeft() ? 1 : 0);
 							fire->OnActivated(ActorActivationDetails(
@@ -1,4 +1,5 @@
 ﻿#include "LizardFloat.h"
+#include "../ActorPool.h"
 #include "Lizard.h"
 #include "../../ILevelHandler.h"
 #include "../../Tiles/TileMap.h"
@@ -120,7 +121,7 @@ namespace Jazz2::Actors::Enemies
 
 			if (distance < 280.0f && _attackTime <= 0.0f) {
 				SetTransition(AnimState::TransitionAttack, false, [this]() {
-					std::shared_ptr<Environment::Bomb> bomb = std::make_shared<Environment::Bomb>();
+					std::shared_ptr<Environment::Bomb> bomb = CreatePooledActor<Environment::Bomb>();
 					uint8_t bombParams[2];
 					bombParams[0] = (uint8_t)(_theme + 1);
 					bombParams[1] = (IsFacingLeft() ? 1 : 0);
@@ -181,7 +182,7 @@ namespace Jazz2::Actors::Enemies
 
 			TryGenerateRandomDrop();
 		} else {
-			std::shared_ptr<Lizard> lizard = std::make_shared<Lizard>();
+			std::shared_ptr<Lizard> lizard = CreatePooledActor<Lizard>();
 			std::uint8_t lizardParams[3];
 			lizardParams[0] = _theme;
 			lizardParams[1] = 1;
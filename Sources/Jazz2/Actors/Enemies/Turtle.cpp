@@ -1,4 +1,5 @@
 ﻿#include "Turtle.h"
+#include "../ActorPool.h"
 #include "../../ILevelHandler.h"
 #include "../../Tiles/TileMap.h"
 #include "TurtleShell.h"
@@ -165,7 +166,7 @@ namespace Jazz2::Actors::Enemies
 				shellSpeedY = -0.98f;
 			}
 
-			std::shared_ptr<TurtleShell> shell = std::make_shared<TurtleShell>();
+			std::shared_ptr<TurtleShell> shell = CreatePooledActor<TurtleShell>();
 			uint8_t shellParams[9];
 			EventParamsWriter writer(shellParams);
 			writer.SetFloat(0, _speed.X * 1.1f);
@@ -1,4 +1,5 @@
 #include "Witch.h"
+#include "../ActorPool.h"
 #include "../../ILevelHandler.h"
 #include "../../Tiles/TileMap.h"
 #include "../Player.h"
@@ -80,7 +81,7 @@ namespace Jazz2::Actors::Enemies
 				SetTransition(AnimState::TransitionAttack, true, [this]() {
 					Vector2f bulletPos = Vector2f(_pos.X + (IsFacingLeft() ? -24.0f : 24.0f), _pos.Y);
 
-					std::shared_ptr<MagicBullet> magicBullet = std::make_shared<MagicBullet>(this);
+					std::shared_ptr<MagicBullet> magicBullet = CreatePooledActor<MagicBullet>(this);
 					magicBullet->OnActivated(ActorActivationDetails(
 						_levelHandler,
 						Vector3i((std::int32_t)bulletPos.X, (std::int32_t)bulletPos.Y, _renderer.layer() + 1)
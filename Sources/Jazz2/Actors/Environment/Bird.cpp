@@ -1,4 +1,5 @@
 #include "Bird.h"
+#include "../ActorPool.h"
 #include "../../ILevelHandler.h"
 #include "../Player.h"
 #include "../Enemies/EnemyBase.h"
@@ -164,7 +165,7 @@ namespace Jazz2::Actors::Environment
 							uint8_t shotParams[1] = { 0 };
 							std::shared_ptr<ActorBase> sharedOwner = _owner->shared_from_this();
 
-							std::shared_ptr<Weapons::BlasterShot> shot1 = std::make_shared<Weapons::BlasterShot>();
+							std::shared_ptr<Weapons::BlasterShot> shot1 = CreatePooledActor<Weapons::BlasterShot>();
 							shot1->OnActivated(ActorActivationDetails(
 								_levelHandler,
 								Vector3i((std::int32_t)_pos.X, (std::int32_t)_pos.Y, _renderer.layer() - 2),
@@ -173,7 +174,7 @@ namespace Jazz2::Actors::Environment
 							shot1->OnFire(sharedOwner, _pos, _speed, 0.0f, IsFacingLeft());
 							_levelHandler->AddActor(shot1);
 
-							std::shared_ptr<Weapons::BlasterShot> shot2 = std::make_shared<Weapons::BlasterShot>();
+							std::shared_ptr<Weapons::BlasterShot> shot2 = CreatePooledActor<Weapons::BlasterShot>();
 							shot2->OnActivated(ActorActivationDetails(
 								_levelHandler,
 								Vector3i((std::int32_t)_pos.X, (std::int32_t)_pos.Y, _renderer.layer() - 2),
@@ -130,7 +130,7 @@ namespace Jazz2::Actors::Environment
 				instanceBlock->GetUniform(Material::SpriteSizeUniformName)->SetFloatValue(texSize.X, ChunkSize);
 				instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatVector(Colorf::White.Data());
 
-				Matrix4x4f worldMatrix = Matrix4x4f::Translation(_chunkPos[i].X - texSize.X / 2, _chunkPos[i].Y - ChunkSize / 2, 0.0f);
+				Matrix2x3f worldMatrix = Matrix2x3f::Translation(_chunkPos[i].X - texSize.X / 2, _chunkPos[i].Y - ChunkSize / 2);
 				worldMatrix.RotateZ(chunkAngle);
 				command->SetTransformation(worldMatrix);
 				command->SetLayer(_renderer.layer());
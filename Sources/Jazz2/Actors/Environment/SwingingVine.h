@@ -30,6 +30,9 @@ namespace Jazz2::Actors::Environment
 		void OnUpdate(float timeMult) override;
 		void OnUpdateHitbox() override;
 		bool OnDraw(RenderQueue& renderQueue) override;
+		bool HasUnboundedDraw() const override {
+			return true;
+		}
 
 	private:
 		static constexpr std::int32_t ChunkCount = 16;
@@ -1,4 +1,5 @@
 ﻿#include "Explosion.h"
+#include "ActorPool.h"
 #include "../ILevelHandler.h"
 
 #include "../../nCine/Base/Random.h"
@@ -12,7 +13,7 @@ namespace Jazz2::Actors
 
 	void Explosion::Create(ILevelHandler* levelHandler, const Vector3i& pos, Type type, float scale)
 	{
-		std::shared_ptr<Explosion> explosion = std::make_shared<Explosion>();
+		std::shared_ptr<Explosion> explosion = CreatePooledActor<Explosion>();
 		std::uint8_t explosionParams[8];
 		EventParamsWriter writer(explosionParams);
 		writer.SetUint16(0, (std::uint16_t)type);
@@ -3,6 +3,7 @@
 #if defined(WITH_MULTIPLAYER) || defined(DOXYGEN_GENERATING_OUTPUT)
 
 #include "MpPlayer.h"
+#include "../../Multiplayer/SnapshotEncoding.h"
 
 using namespace Jazz2::Multiplayer;
 
@@ -47,6 +48,10 @@ namespace Jazz2::Actors::Multiplayer
 		float _bumpCooldown;
 		/** @brief Whether player-vs-player collision dispatch has been enabled (done lazily after activation) */
 		bool _bumpInitialized;
+		/** @brief State sent to clients in the last update, the next update contains only differences */
+		ActorSnapshot _lastSnapshot;
+		/** @brief Whether @ref _lastSnapshot was sent, otherwise the next update contains the full state */
+		bool _hasLastSnapshot;
 
 		void OnUpdate(float timeMult) override;
 
@@ -1,4 +1,5 @@
 #include "RemoteActor.h"
+#include "../ActorPool.h"
 
 #if defined(WITH_MULTIPLAYER)
 
@@ -44,13 +45,13 @@ namespace Jazz2::Actors::Multiplayer
 		// Actors that render through something else than their own sprite need a specialized representation
 		// that replays those visuals on the receiving side; everything else is a generic remote actor
 		if (metadataPath == "Weapon/Electro"_s) {
-			return std::make_shared<RemoteElectroShot>();
+			return CreatePooledActor<RemoteElectroShot>();
 		}
 		if (metadataPath == "Weapon/Thunderbolt"_s) {
-			return std::make_shared<RemoteThunderbolt>();
+			return CreatePooledActor<RemoteThunderbolt>();
 		}
 
-		return std::make_shared<RemoteActor>();
+		return CreatePooledActor<RemoteActor>();
 	}
 
 	RemoteActor::~RemoteActor()
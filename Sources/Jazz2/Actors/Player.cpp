@@ -1,4 +1,5 @@
 #include "Player.h"
+#include "ActorPool.h"
 #include "../ContentResolver.h"
 #include "../ILevelHandler.h"
 #include "../Events/EventMap.h"
@@ -1492,11 +1493,11 @@ namespace Jazz2::Actors
 				instanceBlock->GetUniform(Material::SpriteSizeUniformName)->SetFloatValue(frameRect.W, frameRect.H * scaleY);
 				instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatValue(1.0f, 1.0f, 1.0f, 1.8f);
 
-				Matrix4x4f worldMatrix = Matrix4x4f::Translation(gunspotPosX, gunspotPosY, 0.0f);
+				Matrix2x3f worldMatrix = Matrix2x3f::Translation(gunspotPosX, gunspotPosY);
 				if (lookUp) {
 					worldMatrix.RotateZ(-fRadAngle90);
 				}
-				worldMatrix.Translate(frameRect.W * -0.5f, frameRect.H * scaleY * -0.5f, 0.0f);
+				worldMatrix.Translate(frameRect.W * -0.5f, frameRect.H * scaleY * -0.5f);
 				command->SetTransformation(worldMatrix);
 				command->SetLayer(_renderer.layer() + 2);
 				command->GetMaterial().SetTexture(*res->Base->TextureDiffuse.get());
@@ -1575,7 +1576,7 @@ namespace Jazz2::Actors
 						instanceBlock->GetUniform(Material::SpriteSizeUniformName)->SetFloatValue(shieldSize, shieldSize);
 						instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatValue(2.0f, 2.0f, 0.8f, 0.9f * shieldAlpha);
 
-						command->SetTransformation(Matrix4x4f::Translation(shieldPosX, shieldPosY, 0.0f));
+						command->SetTransformation(Matrix2x3f::Translation(shieldPosX, shieldPosY));
 						command->SetLayer(baseLayer - 4);
 						command->GetMaterial().SetTexture(*res->Base->TextureDiffuse.get());
 
@@ -1606,7 +1607,7 @@ namespace Jazz2::Actors
 						instanceBlock->GetUniform(Material::SpriteSizeUniformName)->SetFloatValue(shieldSize, shieldSize);
 						instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatValue(2.0f, 2.0f, 1.0f, 1.0f * shieldAlpha);
 
-						command->SetTransformation(Matrix4x4f::Translation(shieldPosX, shieldPosY, 0.0f));
+						command->SetTransformation(Matrix2x3f::Translation(shieldPosX, shieldPosY));
 						command->SetLayer(baseLayer + 4);
 						command->GetMaterial().SetTexture(*res->Base->TextureDiffuse.get());
 
@@ -1657,7 +1658,7 @@ namespace Jazz2::Actors
 					instanceBlock->GetUniform(Material::SpriteSizeUniformName)->SetFloatValue(frameRect.W * shieldScale, frameRect.H * shieldScale);
 					instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatValue(1.0f, 1.0f, 1.0f, shieldAlpha);
 
-					command->SetTransformation(Matrix4x4f::Translation(shieldPosX, shieldPosY, 0.0f));
+					command->SetTransformation(Matrix2x3f::Translation(shieldPosX, shieldPosY));
 					command->SetLayer(baseLayer + 4);
 					// Use the default palette (offset 0) so the shield keeps its own colors, not the player's fur recolor
 					ContentResolver::Get().BindSpritePalette(*command, *res->Base->TextureDiffuse.get(), shieldIndexed, res->PaletteOffset);
@@ -1708,7 +1709,7 @@ namespace Jazz2::Actors
 						instanceBlock->GetUniform(Material::SpriteSizeUniformName)->SetFloatValue(shieldSize, shieldSize);
 						instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatValue(2.0f, 2.0f, 0.8f, 0.9f * shieldAlpha);
 
-						command->SetTransformation(Matrix4x4f::Translation(shieldPosX, shieldPosY, 0.0f));
+						command->SetTransformation(Matrix2x3f::Translation(shieldPosX, shieldPosY));
 						command->SetLayer(baseLayer - 4);
 						command->GetMaterial().SetTexture(*res->Base->TextureDiffuse.get());
 
@@ -1739,7 +1740,7 @@ namespace Jazz2::Actors
 						instanceBlock->GetUniform(Material::SpriteSizeUniformName)->SetFloatValue(shieldSize, shieldSize);
 						instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatValue(2.0f, 2.0f, 1.0f, shieldAlpha);
 
-						command->SetTransformation(Matrix4x4f::Translation(shieldPosX, shieldPosY, 0.0f));
+						command->SetTransformation(Matrix2x3f::Translation(shieldPosX, shieldPosY));
 						command->SetLayer(baseLayer + 4);
 						command->GetMaterial().SetTexture(*res->Base->TextureDiffuse.get());
 
@@ -3029,17 +3030,9 @@ namespace Jazz2::Actors
 
 	std::shared_ptr<AudioBufferPlayer> Player::PlayPlayerSfx(StringView identifier, float gain, float pitch)
 	{
-		auto it = _metadata->Sounds.find(String::nullTerminatedView(identifier));
-		if (it != _metadata->Sounds.end()) {
-			AudioBuffer* buffer;
-			if (!it->second.Buffers.empty()) {
-				std::int32_t idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (std::int32_t)it->second.Buffers.size()) : 0);
-				buffer = &it->second.Buffers[idx]->Buffer;
-			} else {
-				buffer = nullptr;
-			}
-			
-			return _levelHandler->PlaySfx(this, identifier, buffer, Vector3f::Zero, true, gain, pitch);
+		auto* resource = _metadata->GetSound(identifier);
+		if (resource != nullptr) {
+			return _levelHandler->PlaySfx(this, identifier, resource->PickBuffer(), Vector3f::Zero, true, gain, pitch, resource->Priority);
 		}
 
 		return nullptr;
@@ -3217,7 +3210,7 @@ namespace Jazz2::Actors
 		float angle;
 		GetFirePointAndAngle(initialPos, gunspotPos, angle);
 
-		std::shared_ptr<T> shot = std::make_shared<T>();
+		std::shared_ptr<T> shot = CreatePooledActor<T>();
 		std::uint8_t shotParams[1] = { _inventory.WeaponUpgrades[(std::int32_t)weaponType] };
 		shot->OnActivated(ActorActivationDetails(
 			_levelHandler,
@@ -3245,7 +3238,7 @@ namespace Jazz2::Actors
 		uint8_t shotParams[1] = { _inventory.WeaponUpgrades[(std::int32_t)WeaponType::RF] };
 
 		if ((_inventory.WeaponUpgrades[(std::int32_t)WeaponType::RF] & 0x1) != 0) {
-			std::shared_ptr<Weapons::RFShot> shot1 = std::make_shared<Weapons::RFShot>();
+			std::shared_ptr<Weapons::RFShot> shot1 = CreatePooledActor<Weapons::RFShot>();
 			shot1->OnActivated(ActorActivationDetails(
 				_levelHandler,
 				initialPos,
@@ -3254,7 +3247,7 @@ namespace Jazz2::Actors
 			shot1->OnFire(shared_from_this(), gunspotPos, _speed, angle - 0.3f, IsFacingLeft());
 			_levelHandler->AddActor(shot1);
 
-			std::shared_ptr<Weapons::RFShot> shot2 = std::make_shared<Weapons::RFShot>();
+			std::shared_ptr<Weapons::RFShot> shot2 = CreatePooledActor<Weapons::RFShot>();
 			shot2->OnActivated(ActorActivationDetails(
 				_levelHandler,
 				initialPos,
@@ -3263,7 +3256,7 @@ namespace Jazz2::Actors
 			shot2->OnFire(shared_from_this(), gunspotPos, _speed, angle, IsFacingLeft());
 			_levelHandler->AddActor(shot2);
 
-			std::shared_ptr<Weapons::RFShot> shot3 = std::make_shared<Weapons::RFShot>();
+			std::shared_ptr<Weapons::RFShot> shot3 = CreatePooledActor<Weapons::RFShot>();
 			shot3->OnActivated(ActorActivationDetails(
 				_levelHandler,
 				initialPos,
@@ -3272,7 +3265,7 @@ namespace Jazz2::Actors
 			shot3->OnFire(shared_from_this(), gunspotPos, _speed, angle + 0.3f, IsFacingLeft());
 			_levelHandler->AddActor(shot3);
 		} else {
-			std::shared_ptr<Weapons::RFShot> shot1 = std::make_shared<Weapons::RFShot>();
+			std::shared_ptr<Weapons::RFShot> shot1 = CreatePooledActor<Weapons::RFShot>();
 			shot1->OnActivated(ActorActivationDetails(
 				_levelHandler,
 				initialPos,
@@ -3281,7 +3274,7 @@ namespace Jazz2::Actors
 			shot1->OnFire(shared_from_this(), gunspotPos, _speed, angle - 0.26f, IsFacingLeft());
 			_levelHandler->AddActor(shot1);
 
-			std::shared_ptr<Weapons::RFShot> shot2 = std::make_shared<Weapons::RFShot>();
+			std::shared_ptr<Weapons::RFShot> shot2 = CreatePooledActor<Weapons::RFShot>();
 			shot2->OnActivated(ActorActivationDetails(
 				_levelHandler,
 				initialPos,
@@ -3304,7 +3297,7 @@ namespace Jazz2::Actors
 
 		uint8_t shotParams[1] = { _inventory.WeaponUpgrades[(std::int32_t)WeaponType::Pepper] };
 
-		std::shared_ptr<Weapons::PepperShot> shot1 = std::make_shared<Weapons::PepperShot>();
+		std::shared_ptr<Weapons::PepperShot> shot1 = CreatePooledActor<Weapons::PepperShot>();
 		shot1->OnActivated(ActorActivationDetails(
 			_levelHandler,
 			initialPos,
@@ -3313,7 +3306,7 @@ namespace Jazz2::Actors
 		shot1->OnFire(shared_from_this(), gunspotPos, _speed, angle - Random().NextFloat(-0.2f, 0.2f), IsFacingLeft());
 		_levelHandler->AddActor(shot1);
 
-		std::shared_ptr<Weapons::PepperShot> shot2 = std::make_shared<Weapons::PepperShot>();
+		std::shared_ptr<Weapons::PepperShot> shot2 = CreatePooledActor<Weapons::PepperShot>();
 		shot2->OnActivated(ActorActivationDetails(
 			_levelHandler,
 			initialPos,
@@ -3329,7 +3322,7 @@ namespace Jazz2::Actors
 
 	void Player::FireWeaponTNT()
 	{
-		std::shared_ptr<Weapons::TNT> tnt = std::make_shared<Weapons::TNT>();
+		std::shared_ptr<Weapons::TNT> tnt = CreatePooledActor<Weapons::TNT>();
 		tnt->OnActivated(ActorActivationDetails(
 			_levelHandler,
 			Vector3i((std::int32_t)_pos.X, (std::int32_t)_pos.Y, _renderer.layer() - 2)
@@ -3353,7 +3346,7 @@ namespace Jazz2::Actors
 		float angle;
 		GetFirePointAndAngle(initialPos, gunspotPos, angle);
 
-		std::shared_ptr<Weapons::Thunderbolt> shot = std::make_shared<Weapons::Thunderbolt>();
+		std::shared_ptr<Weapons::Thunderbolt> shot = CreatePooledActor<Weapons::Thunderbolt>();
 		uint8_t shotParams[1] = { _inventory.WeaponUpgrades[(std::int32_t)WeaponType::Thunderbolt] };
 		shot->OnActivated(ActorActivationDetails(
 			_levelHandler,
@@ -550,6 +550,9 @@ namespace Jazz2::Actors
 		void OnUpdate(float timeMult) override;
 		void OnUpdateHitbox() override;
 		bool OnDraw(RenderQueue& renderQueue) override;
+		bool HasUnboundedDraw() const override {
+			return true;
+		}
 		void OnEmitLights(SmallVectorImpl<LightEmitter>& lights) override;
 
 		bool OnHandleCollision(ActorBase* other) override;
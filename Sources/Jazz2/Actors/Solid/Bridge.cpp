@@ -250,7 +250,7 @@ namespace Jazz2::Actors::Solid
 				instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatVector(Colorf::White.Data());
 
 				auto pos = _pieces[i].Pos;
-				command->SetTransformation(Matrix4x4f::Translation(pos.X - frameRect.W / 2, pos.Y - frameRect.H / 2, 0.0f));
+				command->SetTransformation(Matrix2x3f::Translation(pos.X - frameRect.W / 2, pos.Y - frameRect.H / 2));
 				command->SetLayer(_renderer.layer());
 				resolver.BindSpritePalette(*command, *_currentAnimation->Base->TextureDiffuse.get(), indexed, _currentAnimation->PaletteOffset);
 
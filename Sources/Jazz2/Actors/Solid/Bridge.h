@@ -28,6 +28,9 @@ namespace Jazz2::Actors::Solid
 		void OnUpdate(float timeMult) override;
 		void OnUpdateHitbox() override;
 		bool OnDraw(RenderQueue& renderQueue) override;
+		bool HasUnboundedDraw() const override {
+			return true;
+		}
 		/** @brief Applies authoritative sag state received from the server (clients only, in multiplayer) */
 		void OnPacketReceived(MemoryStream& packet) override;
 
@@ -31,6 +31,9 @@ namespace Jazz2::Actors::Solid
 		void OnUpdateHitbox() override;
 		bool OnPerish(ActorBase* collider) override;
 		bool OnDraw(RenderQueue& renderQueue) override;
+		bool HasUnboundedDraw() const override {
+			return true;
+		}
 
 	private:
 		enum class PlatformType {
@@ -125,7 +125,7 @@ namespace Jazz2::Actors::Solid
 					}
 
 					auto& pos = _pieces[i].Pos;
-					command->SetTransformation(Matrix4x4f::Translation(pos.X - frameRect.W / 2, pos.Y - frameRect.H / 2, 0.0f));
+					command->SetTransformation(Matrix2x3f::Translation(pos.X - frameRect.W / 2, pos.Y - frameRect.H / 2));
 					command->SetLayer(_originLayer + (uint16_t)(scale * 20));
 					resolver.BindSpritePalette(*command, *chainAnim->Base->TextureDiffuse.get(), chainIndexed, chainAnim->PaletteOffset);
 
@@ -26,6 +26,9 @@ namespace Jazz2::Actors::Solid
 		void OnUpdate(float timeMult) override;
 		void OnUpdateHitbox() override;
 		bool OnDraw(RenderQueue& renderQueue) override;
+		bool HasUnboundedDraw() const override {
+			return true;
+		}
 
 	private:
 #ifndef DOXYGEN_GENERATING_OUTPUT
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "DynamicTreeBroadPhase.h"
+#include "SpatialHashBroadPhase.h"
+
+namespace Jazz2::Collisions
+{
+	/** @brief Broad-phase implementation, see @ref BroadPhase */
+	enum class BroadPhaseType
+	{
+		DynamicTree,		/**< @ref DynamicTreeBroadPhase */
+		SpatialHash			/**< @ref SpatialHashBroadPhase */
+	};
+
+	/**
+		@brief Broad-phase for collision detection with an implementation selectable at runtime
+
+		Forwards all calls to either @ref DynamicTreeBroadPhase or @ref SpatialHashBroadPhase. The implementation
+		can be changed only while there are no proxies, i.e., before a level creates its actors.
+	*/
+	class BroadPhase
+	{
+	public:
+		/** @brief Creates a new instance */
+		BroadPhase()
+			: _type(BroadPhaseType::DynamicTree) {}
+
+		/** @brief Returns the active implementation */
+		BroadPhaseType GetType() const {
+			return _type;
+		}
+
+		/** @brief Sets the active implementation */
+		void SetType(BroadPhaseType type) {
+			DEATH_ASSERT(GetProxyCount() == 0, "Broad-phase cannot be changed while it contains proxies", );
+			_type = type;
+		}
+
+		/** @copydoc DynamicTreeBroadPhase::CreateProxy() */
+		std::int32_t CreateProxy(const AABBf& aabb, void* userData) {
+			return (_type == BroadPhaseType::SpatialHash ? _spatialHash.CreateProxy(aabb, userData) : _tree.CreateProxy(aabb, userData));
+		}
+
+		/** @copydoc DynamicTreeBroadPhase::DestroyProxy() */
+		void DestroyProxy(std::int32_t proxyId) {
+			if (_type == BroadPhaseType::SpatialHash) {
+				_spatialHash.DestroyProxy(proxyId);
+			} else {
+				_tree.DestroyProxy(proxyId);
+			}
+		}
+
+		/** @copydoc DynamicTreeBroadPhase::MoveProxy() */
+		void MoveProxy(std::int32_t proxyId, const AABBf& aabb, Vector2f displacement) {
+			if (_type == BroadPhaseType::SpatialHash) {
+				_spatialHash.MoveProxy(proxyId, aabb, displacement);
+			} else {
+				_tree.MoveProxy(proxyId, aabb, displacement);
+			}
+		}
+
+		/** @copydoc DynamicTreeBroadPhase::TouchProxy() */
+		void TouchProxy(std::int32_t proxyId) {
+			if (_type == BroadPhaseType::SpatialHash) {
+				_spatialHash.TouchProxy(proxyId);
+			} else {
+				_tree.TouchProxy(proxyId);
+			}
+		}
+
+		/** @copydoc DynamicTreeBroadPhase::GetFatAABB() */
+		const AABBf& GetFatAABB(std::int32_t proxyId) const {
+			return (_type == BroadPhaseType::SpatialHash ? _spatialHash.GetFatAABB(proxyId) : _tree.GetFatAABB(proxyId));
+		}
+
+		/** @copydoc DynamicTreeBroadPhase::GetUserData() */
+		void* GetUserData(std::int32_t proxyId) const {
+			return (_type == BroadPhaseType::SpatialHash ? _spatialHash.GetUserData(proxyId) : _tree.GetUserData(proxyId));
+		}
+
+		/** @copydoc DynamicTreeBroadPhase::TestOverlap() */
+		bool TestOverlap(std::int32_t proxyIdA, std::int32_t proxyIdB) const {
+			return (_type == BroadPhaseType::SpatialHash ? _spatialHash.TestOverlap(proxyIdA, proxyIdB) : _tree.TestOverlap(proxyIdA, proxyIdB));
+		}
+
+		/** @copydoc DynamicTreeBroadPhase::GetProxyCount() */
+		std::int32_t GetProxyCount() const {
+			return (_type == BroadPhaseType::SpatialHash ? _spatialHash.GetProxyCount() : _tree.GetProxyCount());
+		}
+
+		/** @copydoc DynamicTreeBroadPhase::UpdatePairs() */
+		template<typename T>
+		void UpdatePairs(T* callback) {
+			if (_type == BroadPhaseType::SpatialHash) {
+				_spatialHash.UpdatePairs(callback);
+			} else {
+				_tree.UpdatePairs(callback);
+			}
+		}
+
+		/** @copydoc DynamicTreeBroadPhase::Query() */
+		template<typename T>
+		void Query(T* callback, const AABBf& aabb) const {
+			if (_type == BroadPhaseType::SpatialHash) {
+				_spatialHash.Query(callback, aabb);
+			} else {
+				_tree.Query(callback, aabb);
+			}
+		}
+
+		/** @copydoc DynamicTreeBroadPhase::ShiftOrigin() */
+		void ShiftOrigin(Vector2f newOrigin) {
+			if (_type == BroadPhaseType::SpatialHash) {
+				_spatialHash.ShiftOrigin(newOrigin);
+			} else {
+				_tree.ShiftOrigin(newOrigin);
+			}
+		}
+
+	private:
+		BroadPhaseType _type;
+		DynamicTreeBroadPhase _tree;
+		SpatialHashBroadPhase _spatialHash;
+	};
+}
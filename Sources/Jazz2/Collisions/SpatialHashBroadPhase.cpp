@@ -0,0 +1,192 @@
+#include "SpatialHashBroadPhase.h"
+
+namespace Jazz2::Collisions
+{
+	SpatialHashBroadPhase::SpatialHashBroadPhase()
+		: _freeList(NullNode), _proxyCount(0), _bucketMask(MinBucketCount - 1)
+	{
+		_bucketStart.resize(MinBucketCount + 1, 0);
+	}
+
+	SpatialHashBroadPhase::~SpatialHashBroadPhase()
+	{
+	}
+
+	std::int32_t SpatialHashBroadPhase::CreateProxy(const AABBf& aabb, void* userData)
+	{
+		std::int32_t proxyId;
+		if (_freeList != NullNode) {
+			proxyId = _freeList;
+			_freeList = _proxies[proxyId].NextFree;
+		} else {
+			proxyId = (std::int32_t)_proxies.size();
+			_proxies.emplace_back();
+		}
+
+		ProxyNode& proxy = _proxies[proxyId];
+		proxy.UserData = userData;
+		proxy.NextFree = NullNode;
+		proxy.Flags = ProxyAllocated;
+		SetBounds(proxyId, aabb);
+		++_proxyCount;
+
+		BufferMove(proxyId);
+		return proxyId;
+	}
+
+	void SpatialHashBroadPhase::DestroyProxy(std::int32_t proxyId)
+	{
+		ProxyNode& proxy = _proxies[proxyId];
+		if ((proxy.Flags & ProxyMoved) != 0) {
+			for (std::int32_t& movedProxyId : _moveBuffer) {
+				if (movedProxyId == proxyId) {
+					movedProxyId = NullNode;
+				}
+			}
+		}
+
+		// The grid may still reference the proxy until the next rebuild, it's skipped there by its flags
+		proxy.UserData = nullptr;
+		proxy.Flags = 0;
+		proxy.NextFree = _freeList;
+		_freeList = proxyId;
+		--_proxyCount;
+	}
+
+	void SpatialHashBroadPhase::MoveProxy(std::int32_t proxyId, const AABBf& aabb, Vector2f displacement)
+	{
+		SetBounds(proxyId, aabb);
+		BufferMove(proxyId);
+	}
+
+	void SpatialHashBroadPhase::TouchProxy(std::int32_t proxyId)
+	{
+		BufferMove(proxyId);
+	}
+
+	void SpatialHashBroadPhase::ShiftOrigin(Vector2f newOrigin)
+	{
+		for (ProxyNode& proxy : _proxies) {
+			if ((proxy.Flags & ProxyAllocated) != 0) {
+				proxy.Aabb.L -= newOrigin.X;
+				proxy.Aabb.T -= newOrigin.Y;
+				proxy.Aabb.R -= newOrigin.X;
+				proxy.Aabb.B -= newOrigin.Y;
+			}
+		}
+		RebuildGrid();
+	}
+
+	void SpatialHashBroadPhase::BufferMove(std::int32_t proxyId)
+	{
+		// Each proxy is in the move buffer at most once, so queries don't have to filter duplicates
+		ProxyNode& proxy = _proxies[proxyId];
+		if ((proxy.Flags & ProxyMoved) == 0) {
+			proxy.Flags |= ProxyMoved;
+			_moveBuffer.push_back(proxyId);
+		}
+	}
+
+	void SpatialHashBroadPhase::SetBounds(std::int32_t proxyId, const AABBf& aabb)
+	{
+		ProxyNode& proxy = _proxies[proxyId];
+		proxy.Aabb.L = aabb.L - AabbExtension;
+		proxy.Aabb.T = aabb.T - AabbExtension;
+		proxy.Aabb.R = aabb.R + AabbExtension;
+		proxy.Aabb.B = aabb.B + AabbExtension;
+	}
+
+	void SpatialHashBroadPhase::RebuildGrid()
+	{
+		std::uint32_t bucketCount = MinBucketCount;
+		while (bucketCount < (std::uint32_t)_proxyCount * 2) {
+			bucketCount *= 2;
+		}
+		_bucketMask = bucketCount - 1;
+
+		_bucketStart.assign(bucketCount + 1, 0);
+		_oversized.clear();
+
+		// Count entries of each bucket, the counts are shifted by one, so the prefix sum yields the start offsets
+		std::int32_t proxyCount = (std::int32_t)_proxies.size();
+		std::int32_t entryCount = 0;
+		for (std::int32_t proxyId = 0; proxyId < proxyCount; proxyId++) {
+			ProxyNode& proxy = _proxies[proxyId];
+			proxy.Flags &= ~ProxyOversized;
+			if ((proxy.Flags & ProxyAllocated) == 0) {
+				continue;
+			}
+
+			std::uint32_t buckets[MaxCellsPerProxy];
+			std::int32_t bucketsCount = GetProxyBuckets(proxy.Aabb, buckets);
+			if (bucketsCount < 0) {
+				proxy.Flags |= ProxyOversized;
+				_oversized.push_back(proxyId);
+				continue;
+			}
+
+			for (std::int32_t i = 0; i < bucketsCount; i++) {
+				_bucketStart[buckets[i] + 1]++;
+			}
+			entryCount += bucketsCount;
+		}
+
+		for (std::uint32_t i = 1; i <= bucketCount; i++) {
+			_bucketStart[i] += _bucketStart[i - 1];
+		}
+
+		_entryBounds.resize_for_overwrite(entryCount);
+		_entryIds.resize_for_overwrite(entryCount);
+
+		// Fill the buckets, the start offsets are advanced temporarily and restored afterwards
+		for (std::int32_t proxyId = 0; proxyId < proxyCount; proxyId++) {
+			const ProxyNode& proxy = _proxies[proxyId];
+			if ((proxy.Flags & (ProxyAllocated | ProxyOversized)) != ProxyAllocated) {
+				continue;
+			}
+
+			PackedBounds bounds = PackBounds(proxy.Aabb);
+			std::uint32_t buckets[MaxCellsPerProxy];
+			std::int32_t bucketsCount = GetProxyBuckets(proxy.Aabb, buckets);
+			for (std::int32_t i = 0; i < bucketsCount; i++) {
+				std::int32_t entry = _bucketStart[buckets[i]]++;
+				_entryBounds[entry] = bounds;
+				_entryIds[entry] = proxyId;
+			}
+		}
+
+		for (std::uint32_t i = bucketCount; i > 0; i--) {
+			_bucketStart[i] = _bucketStart[i - 1];
+		}
+		_bucketStart[0] = 0;
+	}
+
+	std::int32_t SpatialHashBroadPhase::GetProxyBuckets(const AABBf& aabb, std::uint32_t* buckets) const
+	{
+		std::int32_t cx0 = GetCell(aabb.L), cy0 = GetCell(aabb.T);
+		std::int32_t cx1 = GetCell(aabb.R), cy1 = GetCell(aabb.B);
+		if ((std::int64_t)(cx1 - cx0 + 1) * (cy1 - cy0 + 1) > MaxCellsPerProxy) {
+			return -1;
+		}
+
+		// Multiple cells of the same proxy can map to the same bucket, but it must be there only once,
+		// otherwise a query would report it multiple times
+		std::int32_t count = 0;
+		for (std::int32_t cy = cy0; cy <= cy1; cy++) {
+			for (std::int32_t cx = cx0; cx <= cx1; cx++) {
+				std::uint32_t bucket = GetBucket(cx, cy);
+				bool isDuplicate = false;
+				for (std::int32_t i = 0; i < count; i++) {
+					if (buckets[i] == bucket) {
+						isDuplicate = true;
+						break;
+					}
+				}
+				if (!isDuplicate) {
+					buckets[count++] = bucket;
+				}
+			}
+		}
+		return count;
+	}
+}
@@ -0,0 +1,315 @@
+#pragma once
+
+#include "DynamicTreeBroadPhase.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(DEATH_TARGET_SSE2)
+#	include <emmintrin.h>
+#elif defined(DEATH_TARGET_NEON)
+#	include <arm_neon.h>
+#endif
+
+namespace Jazz2::Collisions
+{
+	/**
+		@brief Broad-phase for collision detection based on a spatial hash
+
+		Alternative to @ref DynamicTreeBroadPhase with the same interface, intended for levels with many small
+		actors of similar size. Proxies are stored in flat arrays indexed by proxy ID. The grid of cells is not
+		updated incrementally, it's rebuilt from scratch by @ref UpdatePairs() whenever any proxy moved, using
+		a counting sort into one contiguous array per hash bucket. Proxies created or moved since the last
+		rebuild are found by a linear scan of the move buffer instead. Proxies spanning too many cells are kept
+		in a separate list that is tested by every query.
+
+		Queries don't report the same proxy twice even if it spans multiple cells, each overlapping proxy is
+		only reported from the cell that contains the top-left corner of the intersection.
+	*/
+	class SpatialHashBroadPhase
+	{
+	public:
+		/** @brief Size of a grid cell, equal to the tile size */
+		static constexpr float CellSize = 32.0f;
+		/** @brief Maximum number of cells covered by a proxy stored in the grid */
+		static constexpr std::int32_t MaxCellsPerProxy = 16;
+
+		/** @brief Creates a new instance */
+		SpatialHashBroadPhase();
+		~SpatialHashBroadPhase();
+
+		/**
+		 * @brief Creates a proxy with an initial AABB
+		 *
+		 * Pairs are not reported until @ref UpdatePairs() is called
+		 */
+		std::int32_t CreateProxy(const AABBf& aabb, void* userData);
+
+		/** @brief Destroys a proxy */
+		void DestroyProxy(std::int32_t proxyId);
+
+		/**
+		 * @brief Moves a proxy
+		 *
+		 * The grid is rebuilt on every update, so the fat AABB is not enlarged in the direction of @p displacement.
+		 */
+		void MoveProxy(std::int32_t proxyId, const AABBf& aabb, Vector2f displacement);
+
+		/** @brief Triggers a re-processing of it's pairs on the next call to @ref UpdatePairs() */
+		void TouchProxy(std::int32_t proxyId);
+
+		/** @brief Returns the fat AABB for a proxy */
+		const AABBf& GetFatAABB(std::int32_t proxyId) const {
+			return _proxies[proxyId].Aabb;
+		}
+
+		/** @brief Returns a user data from a proxy */
+		void* GetUserData(std::int32_t proxyId) const {
+			return _proxies[proxyId].UserData;
+		}
+
+		/** @brief Tests overlap of fat AABBs */
+		bool TestOverlap(std::int32_t proxyIdA, std::int32_t proxyIdB) const {
+			return _proxies[proxyIdA].Aabb.Overlaps(_proxies[proxyIdB].Aabb);
+		}
+
+		/** @brief Returns the number of proxies */
+		std::int32_t GetProxyCount() const {
+			return _proxyCount;
+		}
+
+		/** @brief Updates the pairs */
+		template<typename T>
+		void UpdatePairs(T* callback);
+
+		/**
+		 * @brief Queries an AABB for overlapping proxies
+		 *
+		 * The callback class is called for each proxy that overlaps the supplied AABB.
+		 */
+		template<typename T>
+		void Query(T* callback, const AABBf& aabb) const;
+
+		/**
+		 * @brief Shifts the world origin
+		 *
+		 * The shift formula is: `position -= newOrigin`
+		 */
+		void ShiftOrigin(Vector2f newOrigin);
+
+	private:
+		static constexpr std::int32_t MinBucketCount = 256;
+
+		enum {
+			ProxyAllocated = 0x01,
+			ProxyMoved = 0x02,
+			ProxyOversized = 0x04
+		};
+
+		struct ProxyNode {
+			AABBf Aabb;
+			void* UserData;
+			std::int32_t NextFree;
+			std::uint8_t Flags;
+		};
+
+		// Bounds stored as (L, T, -R, -B), so the overlap with (R, B, -L, -T) of the other box is a single
+		// less-or-equal comparison of 4 lanes
+		struct PackedBounds {
+			float L, T, NegR, NegB;
+		};
+
+		SmallVector<ProxyNode, 0> _proxies;
+		std::int32_t _freeList;
+		std::int32_t _proxyCount;
+
+		SmallVector<std::int32_t, 0> _moveBuffer;
+		SmallVector<CollisionPair, 0> _pairBuffer;
+
+		SmallVector<std::int32_t, 0> _bucketStart;
+		SmallVector<PackedBounds, 0> _entryBounds;
+		SmallVector<std::int32_t, 0> _entryIds;
+		SmallVector<std::int32_t, 0> _oversized;
+		std::uint32_t _bucketMask;
+
+		void BufferMove(std::int32_t proxyId);
+		void SetBounds(std::int32_t proxyId, const AABBf& aabb);
+		void RebuildGrid();
+		// Returns unique buckets of all cells covered by the box, or -1 if it covers more than `MaxCellsPerProxy` cells
+		std::int32_t GetProxyBuckets(const AABBf& aabb, std::uint32_t* buckets) const;
+
+		static std::int32_t GetCell(float value) {
+			// Coordinates are clamped, so even invalid ones always map to a finite range of cells
+			return (std::int32_t)std::floor(std::clamp(value * (1.0f / CellSize), -1048576.0f, 1048576.0f));
+		}
+
+		std::uint32_t GetBucket(std::int32_t cx, std::int32_t cy) const {
+			return (((std::uint32_t)cx * 73856093u) ^ ((std::uint32_t)cy * 19349663u)) & _bucketMask;
+		}
+
+		static PackedBounds PackBounds(const AABBf& aabb) {
+			return { aabb.L, aabb.T, -aabb.R, -aabb.B };
+		}
+
+		// Calls `onOverlap(proxyId)` for each proxy in the grid overlapping the specified box, until it returns `false`
+		template<typename F>
+		bool QueryGrid(const AABBf& aabb, bool skipMoved, F&& onOverlap) const;
+	};
+
+	namespace Implementation
+	{
+		/** @brief Tests whether packed bounds (L, T, -R, -B) overlap a box packed as (R, B, -L, -T) */
+#if defined(DEATH_TARGET_SSE2)
+		DEATH_ALWAYS_INLINE bool OverlapsPacked(const float* bounds, __m128 query)
+		{
+			return (_mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(bounds), query)) == 0x0F);
+		}
+#elif defined(DEATH_TARGET_NEON)
+		DEATH_ALWAYS_INLINE bool OverlapsPacked(const float* bounds, float32x4_t query)
+		{
+			uint32x4_t mask = vcleq_f32(vld1q_f32(bounds), query);
+			uint32x2_t halves = vand_u32(vget_low_u32(mask), vget_high_u32(mask));
+			return ((vget_lane_u32(halves, 0) & vget_lane_u32(halves, 1)) != 0);
+		}
+#else
+		DEATH_ALWAYS_INLINE bool OverlapsPacked(const float* bounds, const float* query)
+		{
+			return (bounds[0] <= query[0] && bounds[1] <= query[1] && bounds[2] <= query[2] && bounds[3] <= query[3]);
+		}
+#endif
+	}
+
+	template<typename F>
+	bool SpatialHashBroadPhase::QueryGrid(const AABBf& aabb, bool skipMoved, F&& onOverlap) const
+	{
+#if defined(DEATH_TARGET_SSE2)
+		const __m128 query = _mm_setr_ps(aabb.R, aabb.B, -aabb.L, -aabb.T);
+#elif defined(DEATH_TARGET_NEON)
+		const float queryData[4] = { aabb.R, aabb.B, -aabb.L, -aabb.T };
+		const float32x4_t query = vld1q_f32(queryData);
+#else
+		const float query[4] = { aabb.R, aabb.B, -aabb.L, -aabb.T };
+#endif
+
+		for (std::int32_t proxyId : _oversized) {
+			const ProxyNode& proxy = _proxies[proxyId];
+			if ((proxy.Flags & (ProxyAllocated | ProxyOversized)) != (ProxyAllocated | ProxyOversized) ||
+				(skipMoved && (proxy.Flags & ProxyMoved) != 0)) {
+				continue;
+			}
+			PackedBounds bounds = PackBounds(proxy.Aabb);
+			if (Implementation::OverlapsPacked(&bounds.L, query) && !onOverlap(proxyId)) {
+				return false;
+			}
+		}
+
+		std::int32_t cx0 = GetCell(aabb.L), cy0 = GetCell(aabb.T);
+		std::int32_t cx1 = GetCell(aabb.R), cy1 = GetCell(aabb.B);
+
+		if ((std::int64_t)(cx1 - cx0 + 1) * (cy1 - cy0 + 1) > (std::int64_t)_bucketMask + 1) {
+			// The box covers more cells than there are buckets, so all entries would be visited anyway,
+			// it's cheaper to test all proxies directly
+			std::int32_t proxyCount = (std::int32_t)_proxies.size();
+			for (std::int32_t proxyId = 0; proxyId < proxyCount; proxyId++) {
+				const ProxyNode& proxy = _proxies[proxyId];
+				if ((proxy.Flags & (ProxyAllocated | ProxyOversized)) != ProxyAllocated ||
+					(skipMoved && (proxy.Flags & ProxyMoved) != 0)) {
+					continue;
+				}
+				PackedBounds bounds = PackBounds(proxy.Aabb);
+				if (Implementation::OverlapsPacked(&bounds.L, query) && !onOverlap(proxyId)) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		for (std::int32_t cy = cy0; cy <= cy1; cy++) {
+			for (std::int32_t cx = cx0; cx <= cx1; cx++) {
+				std::uint32_t bucket = GetBucket(cx, cy);
+				std::int32_t end = _bucketStart[bucket + 1];
+				for (std::int32_t i = _bucketStart[bucket]; i < end; i++) {
+					const PackedBounds& bounds = _entryBounds[i];
+					if (!Implementation::OverlapsPacked(&bounds.L, query)) {
+						continue;
+					}
+					// Report the proxy only from the cell containing the top-left corner of the intersection,
+					// this also filters out proxies from other cells that share the same bucket
+					if (GetCell(std::max(bounds.L, aabb.L)) != cx || GetCell(std::max(bounds.T, aabb.T)) != cy) {
+						continue;
+					}
+					std::int32_t proxyId = _entryIds[i];
+					std::uint8_t flags = _proxies[proxyId].Flags;
+					if ((flags & ProxyAllocated) == 0 || (skipMoved && (flags & ProxyMoved) != 0)) {
+						continue;
+					}
+					if (!onOverlap(proxyId)) {
+						return false;
+					}
+				}
+			}
+		}
+		return true;
+	}
+
+	template<typename T>
+	void SpatialHashBroadPhase::UpdatePairs(T* callback)
+	{
+		_pairBuffer.clear();
+		if (_moveBuffer.empty()) {
+			return;
+		}
+
+		RebuildGrid();
+
+		for (std::int32_t queryProxyId : _moveBuffer) {
+			if (queryProxyId == NullNode) {
+				continue;
+			}
+
+			QueryGrid(_proxies[queryProxyId].Aabb, false, [this, queryProxyId](std::int32_t proxyId) {
+				// A proxy cannot form a pair with itself, and if both proxies moved, the pair is reported only once
+				if (proxyId == queryProxyId || (proxyId > queryProxyId && (_proxies[proxyId].Flags & ProxyMoved) != 0)) {
+					return true;
+				}
+				CollisionPair& pair = _pairBuffer.emplace_back();
+				pair.ProxyIdA = std::min(proxyId, queryProxyId);
+				pair.ProxyIdB = std::max(proxyId, queryProxyId);
+				return true;
+			});
+		}
+
+		// Each pair is found only once, the order is the same as in DynamicTreeBroadPhase for consistency
+		std::sort(_pairBuffer.begin(), _pairBuffer.end(), [](const CollisionPair& a, const CollisionPair& b) {
+			return (a.ProxyIdA < b.ProxyIdA || (a.ProxyIdA == b.ProxyIdA && a.ProxyIdB < b.ProxyIdB));
+		});
+
+		for (const CollisionPair& pair : _pairBuffer) {
+			callback->OnPairAdded(_proxies[pair.ProxyIdA].UserData, _proxies[pair.ProxyIdB].UserData);
+		}
+
+		for (std::int32_t proxyId : _moveBuffer) {
+			if (proxyId != NullNode) {
+				_proxies[proxyId].Flags &= ~ProxyMoved;
+			}
+		}
+		_moveBuffer.clear();
+	}
+
+	template<typename T>
+	void SpatialHashBroadPhase::Query(T* callback, const AABBf& aabb) const
+	{
+		// Proxies moved since the last rebuild are stale in the grid, so they are tested separately
+		if (!QueryGrid(aabb, true, [callback](std::int32_t proxyId) { return callback->OnCollisionQuery(proxyId); })) {
+			return;
+		}
+
+		for (std::int32_t proxyId : _moveBuffer) {
+			if (proxyId != NullNode && _proxies[proxyId].Aabb.Overlaps(aabb)) {
+				if (!callback->OnCollisionQuery(proxyId)) {
+					return;
+				}
+			}
+		}
+	}
+}
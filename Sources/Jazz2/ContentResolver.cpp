@@ -11,11 +11,18 @@
 #include "../nCine/AppConfiguration.h"
 #include "../nCine/ServiceLocator.h"
 #include "../nCine/tracy.h"
+#include "../nCine/Audio/IAudioLoader.h"
 #include "../nCine/Graphics/ITextureLoader.h"
 #include "../nCine/Graphics/RenderResources.h"
 #include "../nCine/Graphics/RenderCommand.h"
 #include "../nCine/Base/Random.h"
 
+#if defined(WITH_THREADS)
+#	include "../nCine/Threading/Thread.h"
+#	include "../nCine/Threading/ThreadSync.h"
+#	include <atomic>
+#endif
+
 #if defined(DEATH_TARGET_ANDROID)
 #	include "../nCine/Backends/Android/AndroidJniHelper.h"
 #	include <IO/AndroidAssetStream.h>
@@ -25,9 +32,11 @@
 
 #include <cmath>
 
+#include <Containers/DateTime.h>
 #include <Containers/StringConcatenable.h>
 #include <Containers/StringStlView.h>
 #include <IO/MemoryStream.h>
+#include <IO/SpanReader.h>
 #include <IO/Compression/DeflateStream.h>
 
 #include <jsoncpp/json.h>
@@ -53,6 +62,194 @@ namespace Jazz2
 	// are invalidated (12 = the switch from embedded sources to ShaderCompiler-generated artifacts)
 	static constexpr std::uint64_t ShadersVersion = 13;
 
+	struct ContentResolver::DecodedGraphics
+	{
+		String Path;
+		std::uint16_t PaletteOffset = 0;
+		bool KeepIndexed = false;
+		bool LinearSampling = false;
+		// Description and collision mask, the texture is created by FinishGraphics()
+		std::unique_ptr<GenericGraphicResource> Resource;
+		std::unique_ptr<ITextureLoader> TextureLoader;
+	};
+
+	struct ContentResolver::PreloadedMetadata
+	{
+		String Path;
+		bool Exists = false;
+		bool IsParsed = false;
+		Json::Value Document;
+		SmallVector<DecodedGraphics, 0> Graphics;
+	};
+
+	struct ContentResolver::DecodedTileSet
+	{
+		String Path;
+		String FullPath;
+		std::uint16_t CaptionTileId = 0;
+		const std::uint8_t* PaletteRemapping = nullptr;
+		// Palette used for baked tiles and the caption tile, the tile set's own palette if null
+		const std::uint32_t* BakePalette = nullptr;
+		bool IsDecoded = false;
+
+		std::uint16_t TileCount = 0;
+		std::uint32_t Palette[ColorsPerPalette];
+		std::unique_ptr<std::uint8_t[]> Mask;
+		std::uint32_t MaskSize = 0;
+		Tiles::TileSet::BakedCollision BakedCollision;
+		String BakedPath;
+		std::int64_t SourceSize = 0;
+		std::int64_t SourceTime = 0;
+
+		// Whether tiles keep raw palette indices (recolored at draw time) vs baked colors
+		bool IndexTiles = false;
+		std::uint32_t AtlasWidth = 0;
+		std::uint32_t AtlasTileRows = 0;
+		std::unique_ptr<std::uint8_t[]> Atlas;
+		// Per-tile flag (1 = fully opaque diffuse); used to cull hidden debris
+		std::unique_ptr<std::uint8_t[]> TileDiffuseOpaque;
+		std::unique_ptr<Color[]> CaptionTile;
+	};
+
+	struct ContentResolver::PreparedMusic
+	{
+		String FullPath;
+		std::unique_ptr<IAudioLoader> Loader;
+		std::unique_ptr<IAudioReader> Reader;
+	};
+
+	struct ContentResolver::LevelHeader
+	{
+		struct ExtraTileSet
+		{
+			String Path;
+			std::uint16_t Offset;
+			std::uint16_t Count;
+			bool IsRemapped;
+			std::uint8_t PaletteRemapping[ColorsPerPalette];
+		};
+
+		LevelFlags Flags = LevelFlags::None;
+		String DisplayName;
+		String NextLevel;
+		String SecretLevel;
+		String BonusLevel;
+		String DefaultTileset;
+		String MusicPath;
+		std::uint32_t AmbientColor = 0;
+		WeatherType Weather = WeatherType::None;
+		std::uint8_t WeatherIntensity = 0;
+		std::uint16_t WaterLevel = 0;
+		std::uint16_t CaptionTileId = 0;
+		std::uint32_t Palette[ColorsPerPalette];
+		SmallVector<ExtraTileSet, 0> ExtraTileSets;
+		// Palette of the default tile set baked into the extra tile sets, see PrepareLevelTileSets()
+		std::uint32_t TileSetPalette[ColorsPerPalette];
+
+		bool HasCustomPalette() const {
+			return ((Flags & LevelFlags::UseLevelPalette) == LevelFlags::UseLevelPalette);
+		}
+	};
+
+	struct ContentResolver::PrefetchedLevel
+	{
+		String FullPath;
+		// Whole level file, the header is parsed again by TryLoadLevel()
+		std::unique_ptr<std::uint8_t[]> FileData;
+		std::int64_t FileSize = 0;
+		LevelHeader Header;
+		SmallVector<DecodedTileSet, 0> TileSets;
+#if defined(WITH_THREADS)
+		std::atomic<bool> IsCancelled;
+		Mutex FinishedMutex;
+		CondVariable FinishedCV;
+		bool IsFinished = false;
+#endif
+	};
+
+#if defined(WITH_THREADS)
+	namespace
+	{
+		// Shared by the calling thread and the workers of one RunParallel() call. Jobs are picked one at a time,
+		// because their cost differs a lot (a large tile set takes much longer than a small metadata file).
+		struct ParallelJobs
+		{
+			Function<void(std::int32_t)>* Job;
+			std::int32_t Count;
+			std::atomic<std::int32_t> NextIndex;
+			Mutex PendingMutex;
+			CondVariable PendingCV;
+			std::int32_t PendingWorkers;
+
+			void RunAll()
+			{
+				while (true) {
+					std::int32_t i = NextIndex.fetch_add(1, std::memory_order_relaxed);
+					if (i >= Count) {
+						break;
+					}
+					(*Job)(i);
+				}
+			}
+		};
+
+		class ParallelJobsCommand : public IThreadCommand
+		{
+		public:
+			explicit ParallelJobsCommand(ParallelJobs* jobs)
+				: _jobs(jobs) {}
+
+			void Execute() override
+			{
+				_jobs->RunAll();
+
+				_jobs->PendingMutex.Lock();
+				_jobs->PendingWorkers--;
+				if (_jobs->PendingWorkers == 0) {
+					_jobs->PendingCV.Signal();
+				}
+				_jobs->PendingMutex.Unlock();
+			}
+
+		private:
+			ParallelJobs* _jobs;
+		};
+	}
+#endif
+
+	void ContentResolver::RunParallel(std::int32_t count, Function<void(std::int32_t)>&& job)
+	{
+#if defined(WITH_THREADS)
+		const std::int32_t numWorkers = std::min(std::int32_t(theServiceLocator().GetThreadPool().GetThreadCount()), count - 1);
+		if (numWorkers > 0) {
+			ParallelJobs jobs;
+			jobs.Job = &job;
+			jobs.Count = count;
+			jobs.NextIndex.store(0, std::memory_order_relaxed);
+			jobs.PendingWorkers = numWorkers;
+
+			IThreadPool& threadPool = theServiceLocator().GetThreadPool();
+			for (std::int32_t i = 0; i < numWorkers; i++) {
+				threadPool.EnqueueCommand(std::make_unique<ParallelJobsCommand>(&jobs));
+			}
+
+			// The calling thread takes jobs too, then waits for the ones still running on the workers
+			jobs.RunAll();
+
+			jobs.PendingMutex.Lock();
+			while (jobs.PendingWorkers > 0) {
+				jobs.PendingCV.Wait(jobs.PendingMutex);
+			}
+			jobs.PendingMutex.Unlock();
+			return;
+		}
+#endif
+
+		for (std::int32_t i = 0; i < count; i++) {
+			job(i);
+		}
+	}
+
 	ContentResolver& ContentResolver::Get()
 	{
 		static ContentResolver current;
@@ -60,7 +257,7 @@ namespace Jazz2
 	}
 
 	ContentResolver::ContentResolver()
-		: _isHeadless(false), _isLoading(false), _isContentPrebaked(false), _cachedMetadata(64), _cachedGraphics(256),
+		: _isHeadless(false), _isLoading(false), _isPreloading(false), _isContentPrebaked(false), _loadingHolder(0), _contentHolders(1), _cachedMetadata(64), _cachedGraphics(256),
 #if defined(WITH_AUDIO)
 			_cachedSounds(192),
 #endif
@@ -76,6 +273,9 @@ namespace Jazz2
 
 	void ContentResolver::Release()
 	{
+		// No level has an empty path, so the prefetch is only cancelled
+		TakePrefetchedLevel({});
+
 		_cachedMetadata.clear();
 		_cachedGraphics.clear();
 #if defined(WITH_AUDIO)
@@ -476,21 +676,109 @@ namespace Jazz2
 	{
 		_isLoading = true;
 
-		// Reset Referenced flag
+		// Assets marked since the last loading were requested on demand by any of the running level handlers,
+		// so all of them hold the assets until they load their next level, then reset Referenced flag
 		for (auto& resource : _cachedMetadata) {
-			resource.second->Flags &= ~MetadataFlags::Referenced;
+			if ((resource.second->Flags & MetadataFlags::Referenced) == MetadataFlags::Referenced) {
+				resource.second->Flags &= ~MetadataFlags::Referenced;
+				resource.second->Holders |= _contentHolders;
+			}
 		}
 		for (auto& resource : _cachedGraphics) {
-			resource.second->Flags &= ~GenericGraphicResourceFlags::Referenced;
+			if ((resource.second->Flags & GenericGraphicResourceFlags::Referenced) == GenericGraphicResourceFlags::Referenced) {
+				resource.second->Flags &= ~GenericGraphicResourceFlags::Referenced;
+				resource.second->Holders |= _contentHolders;
+			}
 		}
 #if defined(WITH_AUDIO)
 		for (auto& resource : _cachedSounds) {
-			resource.second->Flags &= ~GenericSoundResourceFlags::Referenced;
+			if ((resource.second->Flags & GenericSoundResourceFlags::Referenced) == GenericSoundResourceFlags::Referenced) {
+				resource.second->Flags &= ~GenericSoundResourceFlags::Referenced;
+				resource.second->Holders |= _contentHolders;
+			}
 		}
 #endif
 	}
 
 	void ContentResolver::EndLoading()
+	{
+		// Only assets referenced by the level just loaded are marked now, they replace what the holder used before
+		std::uint32_t holderMask = (1u << _loadingHolder);
+
+		for (auto& resource : _cachedMetadata) {
+			if ((resource.second->Flags & MetadataFlags::Referenced) == MetadataFlags::Referenced) {
+				resource.second->Flags &= ~MetadataFlags::Referenced;
+				resource.second->Holders |= holderMask;
+			} else {
+				resource.second->Holders &= ~holderMask;
+			}
+		}
+		for (auto& resource : _cachedGraphics) {
+			if ((resource.second->Flags & GenericGraphicResourceFlags::Referenced) == GenericGraphicResourceFlags::Referenced) {
+				resource.second->Flags &= ~GenericGraphicResourceFlags::Referenced;
+				resource.second->Holders |= holderMask;
+			} else {
+				resource.second->Holders &= ~holderMask;
+			}
+		}
+#if defined(WITH_AUDIO)
+		for (auto& resource : _cachedSounds) {
+			if ((resource.second->Flags & GenericSoundResourceFlags::Referenced) == GenericSoundResourceFlags::Referenced) {
+				resource.second->Flags &= ~GenericSoundResourceFlags::Referenced;
+				resource.second->Holders |= holderMask;
+			} else {
+				resource.second->Holders &= ~holderMask;
+			}
+		}
+#endif
+
+		ReleaseUnheldContent();
+
+		_isLoading = false;
+	}
+
+	std::int32_t ContentResolver::RetainSharedContent()
+	{
+		for (std::int32_t i = 1; i < MaxContentHolders; i++) {
+			if ((_contentHolders & (1u << i)) == 0) {
+				_contentHolders |= (1u << i);
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	void ContentResolver::ReleaseSharedContent(std::int32_t holder)
+	{
+		DEATH_DEBUG_ASSERT(holder > 0 && holder < MaxContentHolders && (_contentHolders & (1u << holder)) != 0, "Invalid content holder", );
+
+		std::uint32_t holderMask = (1u << holder);
+		_contentHolders &= ~holderMask;
+
+		for (auto& resource : _cachedMetadata) {
+			resource.second->Holders &= ~holderMask;
+		}
+		for (auto& resource : _cachedGraphics) {
+			resource.second->Holders &= ~holderMask;
+		}
+#if defined(WITH_AUDIO)
+		for (auto& resource : _cachedSounds) {
+			resource.second->Holders &= ~holderMask;
+		}
+#endif
+
+		if (!_isLoading) {
+			ReleaseUnheldContent();
+		}
+	}
+
+	void ContentResolver::SetLoadingHolder(std::int32_t holder)
+	{
+		DEATH_DEBUG_ASSERT(holder >= 0 && holder < MaxContentHolders && (_contentHolders & (1u << holder)) != 0, "Invalid content holder", );
+		_loadingHolder = holder;
+	}
+
+	void ContentResolver::ReleaseUnheldContent()
 	{
 #if defined(DEATH_DEBUG)
 		std::int32_t metadataKept = 0, metadataReleased = 0;
@@ -502,7 +790,7 @@ namespace Jazz2
 		{
 			auto it = _cachedMetadata.begin();
 			while (it != _cachedMetadata.end()) {
-				if ((it->second->Flags & MetadataFlags::Referenced) != MetadataFlags::Referenced) {
+				if (it->second->Holders == 0 && (it->second->Flags & MetadataFlags::Referenced) != MetadataFlags::Referenced) {
 					it = _cachedMetadata.erase(it);
 #if defined(DEATH_DEBUG)
 					metadataReleased++;
@@ -520,7 +808,7 @@ namespace Jazz2
 		{
 			auto it = _cachedGraphics.begin();
 			while (it != _cachedGraphics.end()) {
-				if ((it->second->Flags & GenericGraphicResourceFlags::Referenced) != GenericGraphicResourceFlags::Referenced) {
+				if (it->second->Holders == 0 && (it->second->Flags & GenericGraphicResourceFlags::Referenced) != GenericGraphicResourceFlags::Referenced) {
 					it = _cachedGraphics.erase(it);
 #if defined(DEATH_DEBUG)
 					animationsReleased++;
@@ -539,7 +827,7 @@ namespace Jazz2
 		{
 			auto it = _cachedSounds.begin();
 			while (it != _cachedSounds.end()) {
-				if ((it->second->Flags & GenericSoundResourceFlags::Referenced) != GenericSoundResourceFlags::Referenced) {
+				if (it->second->Holders == 0 && (it->second->Flags & GenericSoundResourceFlags::Referenced) != GenericSoundResourceFlags::Referenced) {
 					it = _cachedSounds.erase(it);
 #	if defined(DEATH_DEBUG)
 					soundsReleased++;
@@ -558,8 +846,6 @@ namespace Jazz2
 		LOGW("Metadata: {}|{}, Animations: {}|{}, Sounds: {}|{}", metadataKept, metadataReleased,
 			animationsKept, animationsReleased, soundsKept, soundsReleased);
 #endif
-
-		_isLoading = false;
 	}
 
 	void ContentResolver::OverridePathHandler(Function<String(StringView)>&& callback)
@@ -569,8 +855,57 @@ namespace Jazz2
 
 	void ContentResolver::PreloadMetadataAsync(StringView path)
 	{
-		// TODO: Reimplement async preloading
-		RequestMetadata(path);
+		if (!_isPreloading) {
+			RequestMetadata(path);
+			return;
+		}
+
+		// Events of the same type usually request the same metadata many times
+		auto pathNormalized = fs::ToNativeSeparators(path);
+		for (const String& pendingPath : _pendingPreloads) {
+			if (pendingPath == pathNormalized) {
+				return;
+			}
+		}
+		_pendingPreloads.push_back(std::move(pathNormalized));
+	}
+
+	void ContentResolver::BeginPreloading()
+	{
+		_isPreloading = true;
+	}
+
+	void ContentResolver::EndPreloading()
+	{
+		ZoneScopedC(0x95A5A6);
+
+		_isPreloading = false;
+
+		SmallVector<PreloadedMetadata, 0> preloaded;
+		preloaded.reserve(_pendingPreloads.size());
+		for (String& path : _pendingPreloads) {
+			if (_cachedMetadata.find(path) != _cachedMetadata.end()) {
+				// Already loaded, only mark it as referenced
+				RequestMetadata(path);
+			} else {
+				preloaded.emplace_back().Path = std::move(path);
+			}
+		}
+		_pendingPreloads.clear();
+
+		RunParallel(std::int32_t(preloaded.size()), [this, &preloaded](std::int32_t i) {
+			DecodeMetadata(preloaded[i]);
+		});
+
+		// Textures can be uploaded only from the main thread
+		for (PreloadedMetadata& item : preloaded) {
+			if (!item.Exists || _cachedMetadata.find(item.Path) != _cachedMetadata.end()) {
+				// Let RequestMetadata() report the missing file
+				RequestMetadata(item.Path);
+			} else {
+				CreateMetadata(item.Path, String(item.Path), String(item.Path), item.IsParsed ? &item.Document : nullptr, item.Graphics);
+			}
+		}
 	}
 
 	Metadata* ContentResolver::RequestMetadata(StringView path, bool forceIndexed)
@@ -594,7 +929,7 @@ namespace Jazz2
 			}
 
 #if defined(WITH_AUDIO)
-			for (const auto& [key, resource] : it->second->Sounds) {
+			for (const auto& resource : it->second->Sounds) {
 				for (const auto& base : resource.Buffers) {
 					base->Flags |= GenericSoundResourceFlags::Referenced;
 				}
@@ -618,6 +953,16 @@ namespace Jazz2
 		auto buffer = std::make_unique<char[]>(fileSize);
 		s->Read(buffer.get(), fileSize);
 
+		Json::CharReaderBuilder builder;
+		auto reader = std::unique_ptr<Json::CharReader>(builder.newCharReader());
+		Json::Value doc; std::string errors;
+		bool isParsed = reader->parse(buffer.get(), buffer.get() + fileSize, &doc, &errors);
+		return CreateMetadata(path, std::move(pathNormalized), std::move(cacheKey), isParsed ? &doc : nullptr, {});
+	}
+
+	Metadata* ContentResolver::CreateMetadata(StringView path, String&& pathNormalized, String&& cacheKey, const Json::Value* document,
+		ArrayView<DecodedGraphics> decodedGraphics)
+	{
 		bool multipleAnimsNoStatesWarning = false;
 
 		std::unique_ptr<Metadata> metadata = std::make_unique<Metadata>();
@@ -626,10 +971,8 @@ namespace Jazz2
 		metadata->CacheKey = std::move(cacheKey);
 		metadata->Flags |= MetadataFlags::Referenced;
 
-		Json::CharReaderBuilder builder;
-		auto reader = std::unique_ptr<Json::CharReader>(builder.newCharReader());
-		Json::Value doc; std::string errors;
-		if (reader->parse(buffer.get(), buffer.get() + fileSize, &doc, &errors)) {
+		if (document != nullptr) {
+			const Json::Value& doc = *document;
 			metadata->BoundingBox = GetVector2iFromJson(doc["BoundingBox"], Vector2i(InvalidValue, InvalidValue));
 
 			// A file can declare all of its animations deferred at once, and any single entry can opt in or out
@@ -712,7 +1055,20 @@ namespace Jazz2
 						deferredGraphics.HasAnimDuration = hasAnimDuration;
 						deferredGraphics.HasFrameCount = hasFrameCount;
 					} else {
-						graphics.Base = RequestGraphics(assetPath, (std::uint16_t)paletteOffset, keepIndexed);
+						// Graphics decoded by EndPreloading() only have to be uploaded
+						DecodedGraphics* decoded = nullptr;
+						if (!decodedGraphics.empty()) {
+							auto assetPathNormalized = fs::ToNativeSeparators(assetPath);
+							for (DecodedGraphics& item : decodedGraphics) {
+								if (item.PaletteOffset == (std::uint16_t)paletteOffset && item.KeepIndexed == keepIndexed && item.Path == assetPathNormalized) {
+									decoded = &item;
+									break;
+								}
+							}
+						}
+						graphics.Base = (decoded != nullptr
+							? FinishGraphics(decoded->Path, (std::uint16_t)paletteOffset, keepIndexed, *decoded)
+							: RequestGraphics(assetPath, (std::uint16_t)paletteOffset, keepIndexed));
 						if (graphics.Base == nullptr) {
 							continue;
 						}
@@ -765,6 +1121,7 @@ namespace Jazz2
 			if (sounds.isObject()) {
 				std::size_t count = sounds.getMemberCount();
 				metadata->Sounds.reserve(count);
+				metadata->SoundHandles.reserve(count);
 
 				for (auto it = sounds.begin(); it != sounds.end(); ++it) {
 					std::string_view key = it.memberName();
@@ -774,6 +1131,11 @@ namespace Jazz2
 					}
 
 					SoundResource sound;
+					sound.Identifier = key;
+					std::int64_t priority;
+					if ((*it)["Priority"].get(priority) == Json::SUCCESS) {
+						sound.Priority = (std::int32_t)priority;
+					}
 #if defined(WITH_AUDIO)
 					// Don't load sounds in headless mode
 					if (!_isHeadless) {
@@ -795,7 +1157,8 @@ namespace Jazz2
 						}
 					}
 #endif
-					metadata->Sounds.emplace(key, std::move(sound));
+					metadata->SoundHandles.emplace(key, SoundHandle(metadata->Sounds.size()));
+					metadata->Sounds.push_back(std::move(sound));
 				}
 			}
 		}
@@ -803,6 +1166,69 @@ namespace Jazz2
 		return _cachedMetadata.emplace(metadata->CacheKey, std::move(metadata)).first->second.get();
 	}
 
+	void ContentResolver::DecodeMetadata(PreloadedMetadata& preloaded)
+	{
+		auto s = OpenContentFile(fs::CombinePath("Metadata"_s, String(preloaded.Path + ".res"_s)));
+		auto fileSize = s->GetSize();
+		if (fileSize < 4 || fileSize > 64 * 1024 * 1024) {
+			return;
+		}
+
+		auto buffer = std::make_unique<char[]>(fileSize);
+		s->Read(buffer.get(), fileSize);
+		s->Dispose();
+		preloaded.Exists = true;
+
+		Json::CharReaderBuilder builder;
+		auto reader = std::unique_ptr<Json::CharReader>(builder.newCharReader());
+		std::string errors;
+		if (!reader->parse(buffer.get(), buffer.get() + fileSize, &preloaded.Document, &errors)) {
+			return;
+		}
+		preloaded.IsParsed = true;
+
+		// Only decode the graphics that CreateMetadata() would request immediately
+		const Json::Value& doc = preloaded.Document;
+		bool deferredByDefault = false;
+		doc["Deferred"].get(deferredByDefault);
+
+		const auto& animations = doc["Animations"];
+		if (!animations.isObject()) {
+			return;
+		}
+
+		for (auto it = animations.begin(); it != animations.end(); ++it) {
+			std::string_view assetPath;
+			if ((*it)["Path"].get(assetPath) != Json::SUCCESS || assetPath.empty()) {
+				continue;
+			}
+
+			bool deferred = deferredByDefault;
+			(*it)["Deferred"].get(deferred);
+			if (deferred) {
+				continue;
+			}
+
+			std::int64_t paletteOffset;
+			if ((*it)["PaletteOffset"].get(paletteOffset) != Json::SUCCESS || paletteOffset < 0) {
+				paletteOffset = 0;
+			}
+
+			DecodedGraphics& decoded = preloaded.Graphics.emplace_back();
+			decoded.Path = fs::ToNativeSeparators(assetPath);
+			decoded.PaletteOffset = (std::uint16_t)paletteOffset;
+			// All palette-based sprites are indexed, see CreateMetadata()
+			decoded.KeepIndexed = true;
+
+			// The cache is not modified until all jobs are finished, so it can be read here
+			bool isCached = (_cachedGraphics.find(Pair(String::nullTerminatedView(decoded.Path), IndexedGraphicsCacheKey)) != _cachedGraphics.end());
+			if (isCached || fs::GetExtension(decoded.Path) == "aura"_s ||
+				!DecodeGraphics(decoded.Path, decoded.PaletteOffset, decoded.KeepIndexed, decoded)) {
+				preloaded.Graphics.pop_back();
+			}
+		}
+	}
+
 	bool ContentResolver::ResolveAnimation(Metadata& metadata, GraphicResource& animation)
 	{
 		if (animation.DeferredIndex == GraphicResource::NotDeferred) {
@@ -848,14 +1274,23 @@ namespace Jazz2
 			return RequestGraphicsAura(pathNormalized, paletteOffset, keepIndexed);
 		}
 
+		DecodedGraphics decoded;
+		if (!DecodeGraphics(pathNormalized, paletteOffset, keepIndexed, decoded)) {
+			return nullptr;
+		}
+		return FinishGraphics(pathNormalized, paletteOffset, keepIndexed, decoded);
+	}
+
+	bool ContentResolver::DecodeGraphics(StringView pathNormalized, std::uint16_t paletteOffset, bool keepIndexed, DecodedGraphics& decoded)
+	{
 		auto s = OpenContentFile(fs::CombinePath("Animations"_s, String(pathNormalized + ".res"_s)));
 		auto fileSize = s->GetSize();
 		if (fileSize < 4 || fileSize > 64 * 1024 * 1024) {
 			// 64 MB file size limit, also if not found try to use cache
 			if (s->IsValid()) {
-				LOGE("Cannot load animation \"{}\" with unexpected file size of {} bytes", path, fileSize);
+				LOGE("Cannot load animation \"{}\" with unexpected file size of {} bytes", pathNormalized, fileSize);
 			}
-			return nullptr;
+			return false;
 		}
 
 		auto buffer = std::make_unique<char[]>(fileSize);
@@ -875,7 +1310,7 @@ namespace Jazz2
 			if (texLoader->hasLoaded()) {
 				auto texFormat = texLoader->texFormat().pixelFormat();
 				if (texFormat != PixelFormat::RGBA8 && texFormat != PixelFormat::RGB8) {
-					return nullptr;
+					return false;
 				}
 
 				std::int32_t w = texLoader->width();
@@ -936,18 +1371,6 @@ namespace Jazz2
 					}
 				}
 
-				if (!_isHeadless) {
-					// Don't load textures in headless mode, only collision masks
-					if ((graphics->Flags & GenericGraphicResourceFlags::Indexed) == GenericGraphicResourceFlags::Indexed) {
-						bool paletteBaseTransparent = (((_palettes[paletteOffset] >> 24) & 0xFF) == 0);
-						graphics->TextureDiffuse = CreateIndexedTexture(fullPath.data(), pixels, w, h, PixelSize, paletteBaseTransparent);
-					} else {
-						graphics->TextureDiffuse = std::make_unique<Texture>(fullPath.data(), Texture::Format::RGBA8, w, h);
-						graphics->TextureDiffuse->LoadFromTexels(pixels, 0, 0, w, h);
-					}
-					graphics->TextureDiffuse->SetMinFiltering(linearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
-					graphics->TextureDiffuse->SetMagFiltering(linearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
-				}
 
 				double animDuration;
 				if (doc["Duration"].get(animDuration) != Json::SUCCESS) {
@@ -968,14 +1391,51 @@ namespace Jazz2
 				graphics->Coldspot = GetVector2iFromJson(doc["Coldspot"], Vector2i(InvalidValue, InvalidValue));
 				graphics->Gunspot = GetVector2iFromJson(doc["Gunspot"], Vector2i(InvalidValue, InvalidValue));
 
-#if defined(DEATH_DEBUG)
-				MigrateGraphics(pathNormalized);
-#endif
-				return _cachedGraphics.emplace(Pair(String(pathNormalized), cacheKeyOffset), std::move(graphics)).first->second.get();
+				decoded.Resource = std::move(graphics);
+				decoded.TextureLoader = std::move(texLoader);
+				decoded.LinearSampling = linearSampling;
+				return true;
 			}
 		}
 
-		return nullptr;
+		return false;
+	}
+
+	GenericGraphicResource* ContentResolver::FinishGraphics(StringView pathNormalized, std::uint16_t paletteOffset, bool keepIndexed, DecodedGraphics& decoded)
+	{
+		_isLoading = false;
+
+		// The same graphics could have been requested by another metadata in the meantime
+		std::uint16_t cacheKeyOffset = (keepIndexed ? IndexedGraphicsCacheKey : paletteOffset);
+		auto it = _cachedGraphics.find(Pair(String::nullTerminatedView(pathNormalized), cacheKeyOffset));
+		if (it != _cachedGraphics.end()) {
+			it->second->Flags |= GenericGraphicResourceFlags::Referenced;
+			return it->second.get();
+		}
+
+		std::unique_ptr<GenericGraphicResource>& graphics = decoded.Resource;
+		if (!_isHeadless) {
+			// Don't load textures in headless mode, only collision masks
+			String fullPath = fs::CombinePath("Animations"_s, pathNormalized);
+			std::int32_t w = decoded.TextureLoader->width();
+			std::int32_t h = decoded.TextureLoader->height();
+			const std::uint8_t* pixels = (const std::uint8_t*)decoded.TextureLoader->pixels();
+			if ((graphics->Flags & GenericGraphicResourceFlags::Indexed) == GenericGraphicResourceFlags::Indexed) {
+				bool paletteBaseTransparent = (((_palettes[paletteOffset] >> 24) & 0xFF) == 0);
+				graphics->TextureDiffuse = CreateIndexedTexture(fullPath.data(), pixels, w, h, PixelSize, paletteBaseTransparent);
+			} else {
+				graphics->TextureDiffuse = std::make_unique<Texture>(fullPath.data(), Texture::Format::RGBA8, w, h);
+				graphics->TextureDiffuse->LoadFromTexels(pixels, 0, 0, w, h);
+			}
+			graphics->TextureDiffuse->SetMinFiltering(decoded.LinearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
+			graphics->TextureDiffuse->SetMagFiltering(decoded.LinearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
+		}
+		decoded.TextureLoader = nullptr;
+
+#if defined(DEATH_DEBUG)
+		MigrateGraphics(pathNormalized);
+#endif
+		return _cachedGraphics.emplace(Pair(String(pathNormalized), cacheKeyOffset), std::move(graphics)).first->second.get();
 	}
 
 	GenericGraphicResource* ContentResolver::RequestGraphicsAura(StringView path, std::uint16_t paletteOffset, bool keepIndexed)
@@ -1279,6 +1739,25 @@ namespace Jazz2
 	}
 
 	std::unique_ptr<Tiles::TileSet> ContentResolver::RequestTileSet(StringView path, std::uint16_t captionTileId, bool applyPalette, const std::uint8_t* paletteRemapping)
+	{
+		DecodedTileSet decoded;
+		decoded.Path = path;
+		decoded.FullPath = ResolveTileSetPath(path);
+		decoded.CaptionTileId = captionTileId;
+		decoded.PaletteRemapping = paletteRemapping;
+		// The tile set bakes its own palette if it's going to be applied
+		decoded.BakePalette = (applyPalette ? nullptr : _palettes);
+
+		if (!DecodeTileSet(decoded)) {
+			return nullptr;
+		}
+		if (applyPalette) {
+			ApplyTilesetPalette(decoded.Palette);
+		}
+		return CreateTileSet(decoded);
+	}
+
+	String ContentResolver::ResolveTileSetPath(StringView path)
 	{
 		// Try "Content" directory first, then "Cache" directory
 		String fullPath;
@@ -1291,10 +1770,40 @@ namespace Jazz2
 				fullPath = fs::CombinePath({ GetCachePath(), "Tilesets"_s, String(path + ".j2t"_s) });
 			}
 		}
+		return fullPath;
+	}
 
-		auto s = fs::Open(fullPath, FileAccess::Read, 16 * 1024);
+	bool ContentResolver::ReadTileSetPalette(StringView fullPath, std::uint32_t* palette)
+	{
+		auto s = fs::Open(fullPath, FileAccess::Read);
 		if (!s->IsValid()) {
-			return nullptr;
+			return false;
+		}
+
+		std::uint64_t signature1 = s->ReadValueAsLE<std::uint64_t>();
+		std::uint16_t signature2 = s->ReadValueAsLE<std::uint16_t>();
+		std::uint8_t version = s->ReadValue<std::uint8_t>();
+		if (signature1 != 0xB8EF8498E2BFBBEF || signature2 != 0x208F || version != 2) {
+			return false;
+		}
+
+		// Flags, channel count, width, height and tile count
+		s->Seek(1 + 1 + 4 + 4 + 2, SeekOrigin::Current);
+
+		// The palette is at the beginning of the compressed block
+		std::int32_t compressedSize = s->ReadValueAsLE<std::int32_t>();
+		DeflateStream uc(*s, compressedSize);
+		for (std::int32_t i = 0; i < ColorsPerPalette; i++) {
+			palette[i] = uc.ReadValueAsLE<std::uint32_t>();
+		}
+		return uc.IsValid();
+	}
+
+	bool ContentResolver::DecodeTileSet(DecodedTileSet& decoded)
+	{
+		auto s = fs::Open(decoded.FullPath, FileAccess::Read, 16 * 1024);
+		if (!s->IsValid()) {
+			return false;
 		}
 
 		std::uint64_t signature1 = s->ReadValueAsLE<std::uint64_t>();
@@ -1302,19 +1811,43 @@ namespace Jazz2
 		std::uint8_t version = s->ReadValue<std::uint8_t>();
 		/*std::uint8_t flags =*/ s->ReadValue<std::uint8_t>();
 		DEATH_ASSERT(signature1 == 0xB8EF8498E2BFBBEF && signature2 == 0x208F && version == 2,
-			("Tile set \"{}\" has invalid signature", fullPath), nullptr);
+			("Tile set \"{}\" has invalid signature", decoded.FullPath), false);
 
 		std::uint8_t channelCount = s->ReadValue<std::uint8_t>();
 		std::uint32_t width = s->ReadValueAsLE<std::uint32_t>();
 		std::uint32_t height = s->ReadValueAsLE<std::uint32_t>();
 		std::uint16_t tileCount = s->ReadValueAsLE<std::uint16_t>();
+		decoded.TileCount = tileCount;
 
 		// Read compressed palette and mask
 		std::int32_t compressedSize = s->ReadValueAsLE<std::int32_t>();
 
+		// Collision data baked by a previous run are mapped from the cache, so processes hosting the same tile set
+		// share one copy of them in memory instead of inflating and classifying the mask each time
+#if defined(NCINE_HAS_WRITABLE_CACHE) && (defined(DEATH_TARGET_ANDROID) || defined(DEATH_TARGET_APPLE) || defined(DEATH_TARGET_UNIX) || (defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT)))
+		decoded.SourceSize = fs::GetFileSize(decoded.FullPath);
+		DateTime sourceLastModified = fs::GetLastModificationTime(decoded.FullPath);
+		if (decoded.SourceSize > 0 && sourceLastModified.IsValid()) {
+			decoded.SourceTime = sourceLastModified.ToUnixMilliseconds();
+			decoded.BakedPath = fs::CombinePath({ GetCachePath(), "Baked"_s, "Tilesets"_s, String(decoded.Path + ".bin"_s) });
+			decoded.BakedCollision = Tiles::TileSet::MapBakedCollision(decoded.BakedPath, tileCount, decoded.SourceSize, decoded.SourceTime);
+		}
+#endif
+
+		if (_isHeadless && decoded.BakedCollision.Mask != nullptr) {
+			// Nothing else is needed in headless mode, so the compressed block doesn't have to be inflated at all
+			return true;
+		}
+
 		DeflateStream uc(*s, compressedSize);
 
-		ReadTilesetPalette(uc, applyPalette);
+		if (!_isHeadless) {
+			for (std::int32_t i = 0; i < ColorsPerPalette; i++) {
+				decoded.Palette[i] = uc.ReadValueAsLE<std::uint32_t>();
+			}
+		} else {
+			uc.Seek(ColorsPerPalette * sizeof(std::uint32_t), SeekOrigin::Current);
+		}
 
 		// Mark individual tiles as 32-bit or 8-bit
 		std::unique_ptr<uint8_t[]> is32bitTile;
@@ -1326,45 +1859,50 @@ namespace Jazz2
 		}
 
 		// Mask (kept packed, 1 bit per pixel - see ReadTilesetMask)
-		std::uint32_t maskSize;
-		std::unique_ptr<std::uint8_t[]> mask = ReadTilesetMask(uc, maskSize);
-
-		SmallVector<std::unique_ptr<Texture>, 1> textureDiffuse;
-		std::unique_ptr<Color[]> captionTile;
-		// Per-tile flag (1 = fully opaque diffuse); used to cull hidden debris. Set by BuildTilesetDiffuse().
-		std::unique_ptr<std::uint8_t[]> tileDiffuseOpaque;
-		// Whether tiles keep raw palette indices (recolored at draw time) vs baked colors; set by BuildTilesetDiffuse()
-		bool indexTiles = false;
+		if (decoded.BakedCollision.Mask != nullptr) {
+			decoded.MaskSize = uc.ReadValueAsLE<std::uint32_t>();
+			uc.Seek(decoded.MaskSize, SeekOrigin::Current);
+		} else {
+			decoded.Mask = ReadTilesetMask(uc, decoded.MaskSize);
+		}
 
 		// The image content follows the compressed block, so it's read from the raw stream (headless builds masks only)
 		if (!_isHeadless) {
-			textureDiffuse = BuildTilesetDiffuse(s, fullPath.data(), channelCount, width, height, tileCount,
-				is32bitTile.get(), paletteRemapping, captionTileId, indexTiles, tileDiffuseOpaque, captionTile);
+			BuildTilesetDiffuse(s, channelCount, width, height, is32bitTile.get(),
+				decoded.BakePalette != nullptr ? decoded.BakePalette : decoded.Palette, decoded);
 		}
 
-		if (!uc.IsValid()) {
-			return nullptr;
+		return uc.IsValid();
+	}
+
+	std::unique_ptr<Tiles::TileSet> ContentResolver::CreateTileSet(DecodedTileSet& decoded)
+	{
+		SmallVector<std::unique_ptr<Texture>, 1> textureDiffuse;
+		if (decoded.Atlas != nullptr) {
+			textureDiffuse = UploadTilesetDiffuse(decoded);
 		}
 
-		auto tileSet = std::make_unique<Tiles::TileSet>(path,
-			tileCount, Death::move(textureDiffuse), Death::move(mask),
-			maskSize, Death::move(captionTile), tileDiffuseOpaque.get());
-		tileSet->IsIndexed = indexTiles;
+		std::unique_ptr<Tiles::TileSet> tileSet;
+		if (decoded.BakedCollision.Mask != nullptr) {
+			tileSet = std::make_unique<Tiles::TileSet>(decoded.Path, decoded.TileCount, Death::move(textureDiffuse),
+				Death::move(decoded.BakedCollision), Death::move(decoded.CaptionTile), decoded.TileDiffuseOpaque.get());
+		} else {
+			tileSet = std::make_unique<Tiles::TileSet>(decoded.Path, decoded.TileCount, Death::move(textureDiffuse),
+				Death::move(decoded.Mask), decoded.MaskSize, Death::move(decoded.CaptionTile), decoded.TileDiffuseOpaque.get());
+			if (!decoded.BakedPath.empty() && !tileSet->SaveBakedCollision(decoded.BakedPath, decoded.SourceSize, decoded.SourceTime)) {
+				LOGW("Failed to bake collision data of tile set \"{}\"", decoded.Path);
+			}
+		}
+		tileSet->IsIndexed = decoded.IndexTiles;
 		return tileSet;
 	}
 
-	void ContentResolver::ReadTilesetPalette(Stream& uc, bool applyPalette)
+	void ContentResolver::ApplyTilesetPalette(const std::uint32_t* newPalette)
 	{
-		if (!applyPalette || _isHeadless) {
-			uc.Seek(ColorsPerPalette * sizeof(std::uint32_t), SeekOrigin::Current);
+		if (_isHeadless) {
 			return;
 		}
 
-		std::uint32_t newPalette[ColorsPerPalette];
-		for (std::size_t i = 0; i < arraySize(newPalette); i++) {
-			newPalette[i] = uc.ReadValueAsLE<std::uint32_t>();
-		}
-
 		if (std::memcmp(_palettes, newPalette, ColorsPerPalette * sizeof(std::uint32_t)) != 0) {
 			// The sprite palette changed. Indexed sprites/tiles recolor from the live palette texture, so they don't
 			// need reloading; only the baked fonts are dropped so they rebake with the new palette.
@@ -1392,14 +1930,16 @@ namespace Jazz2
 		return mask;
 	}
 
-	SmallVector<std::unique_ptr<Texture>, 1> ContentResolver::BuildTilesetDiffuse(std::unique_ptr<Stream>& s, const char* name, std::uint8_t channelCount,
-		std::uint32_t width, std::uint32_t height, std::uint16_t tileCount, const std::uint8_t* is32bitTile,
-		const std::uint8_t* paletteRemapping, std::uint16_t captionTileId, bool& indexTiles,
-		std::unique_ptr<std::uint8_t[]>& tileDiffuseOpaque, std::unique_ptr<Color[]>& captionTile)
+	void ContentResolver::BuildTilesetDiffuse(std::unique_ptr<Stream>& s, std::uint8_t channelCount, std::uint32_t width,
+		std::uint32_t height, const std::uint8_t* is32bitTile, const std::uint32_t* palette, DecodedTileSet& decoded)
 	{
+		const std::uint16_t tileCount = decoded.TileCount;
+		const std::uint8_t* paletteRemapping = decoded.PaletteRemapping;
+		const std::uint16_t captionTileId = decoded.CaptionTileId;
+
 		// 32-bit (true-color) tiles have no palette index, so a tileset containing any must stay baked as RGBA;
 		// an all-8-bit tileset keeps raw palette indices and recolors at draw time (uploaded as R8).
-		indexTiles = true;
+		bool indexTiles = true;
 		for (std::int32_t t = 0; t < (std::int32_t)tileCount; t++) {
 			if ((is32bitTile[t / 8] & (1 << (t & 7))) != 0) {
 				indexTiles = false;
@@ -1454,7 +1994,7 @@ namespace Jazz2
 		const std::uint32_t dstChannels = (indexTiles ? 1u : 4u);
 
 		std::unique_ptr<std::uint8_t[]> atlas = std::make_unique<std::uint8_t[]>(paddedWidth * paddedHeight * dstChannels);
-		tileDiffuseOpaque = std::make_unique<std::uint8_t[]>(tileCount);
+		std::unique_ptr<std::uint8_t[]> tileDiffuseOpaque = std::make_unique<std::uint8_t[]>(tileCount);
 
 		for (std::uint32_t ty = 0; ty < srcTilesPerColumn; ty++) {
 			for (std::uint32_t tx = 0; tx < srcTilesPerRow; tx++) {
@@ -1497,7 +2037,7 @@ namespace Jazz2
 									opaque = false;
 								}
 							} else {
-								const std::uint32_t color = _palettes[index];
+								const std::uint32_t color = palette[index];
 								const std::uint8_t alpha = (transparent ? 0 : (std::uint8_t)((color >> 24) & 0xFF));
 								dstTile[dst + 0] = (color >> 0) & 0xFF;
 								dstTile[dst + 1] = (color >> 8) & 0xFF;
@@ -1519,6 +2059,51 @@ namespace Jazz2
 			}
 		}
 
+		// Caption tile (level-select thumbnail): downscale one tile 1:3 vertically, averaging 3 source rows. Resolve
+		// 8-bit indices through the palette here (32-bit tiles already hold RGB).
+		std::unique_ptr<Color[]> captionTile;
+		if (captionTileId > 0) {
+			const std::uint32_t tileX = (captionTileId % srcTilesPerRow) * TileSet::DefaultTileSize;
+			const std::uint32_t tileY = (captionTileId / srcTilesPerRow) * TileSet::DefaultTileSize;
+			if (tileX + TileSet::DefaultTileSize <= width && tileY + TileSet::DefaultTileSize <= height) {
+				const bool captionIs32bit = ((is32bitTile[captionTileId / 8] & (1 << (captionTileId & 7))) != 0);
+				captionTile = std::make_unique<Color[]>(TileSet::DefaultTileSize * TileSet::DefaultTileSize / 3);
+
+				for (std::uint32_t y = 0; y < TileSet::DefaultTileSize / 3; y++) {
+					for (std::uint32_t x = 0; x < TileSet::DefaultTileSize; x++) {
+						std::uint32_t r = 0, g = 0, b = 0;
+						for (std::uint32_t row = 0; row < 3; row++) {
+							const std::uint32_t src = ((tileY + y * 3 + row) * width + (tileX + x)) * channelCount;
+							if (captionIs32bit) {
+								r += pixels[src + 0]; g += pixels[src + 1]; b += pixels[src + 2];
+							} else {
+								const std::uint32_t color = palette[pixels[src]];
+								r += (color >> 0) & 0xFF; g += (color >> 8) & 0xFF; b += (color >> 16) & 0xFF;
+							}
+						}
+						captionTile[y * TileSet::DefaultTileSize + x] = Color((std::uint8_t)(r / 3), (std::uint8_t)(g / 3), (std::uint8_t)(b / 3));
+					}
+				}
+			}
+		}
+
+		decoded.IndexTiles = indexTiles;
+		decoded.AtlasWidth = paddedWidth;
+		decoded.AtlasTileRows = tilesPerColumn;
+		decoded.Atlas = std::move(atlas);
+		decoded.TileDiffuseOpaque = std::move(tileDiffuseOpaque);
+		decoded.CaptionTile = std::move(captionTile);
+	}
+
+	SmallVector<std::unique_ptr<Texture>, 1> ContentResolver::UploadTilesetDiffuse(const DecodedTileSet& decoded)
+	{
+		const char* name = decoded.FullPath.data();
+		const bool indexTiles = decoded.IndexTiles;
+		const std::uint32_t paddedWidth = decoded.AtlasWidth;
+		const std::uint32_t tilesPerColumn = decoded.AtlasTileRows;
+		const std::uint32_t dstChannels = (indexTiles ? 1u : 4u);
+		const std::uint8_t* atlas = decoded.Atlas.get();
+
 		// Upload the atlas, splitting it into consecutive row-band textures when it exceeds the device's
 		// texture-size limit (a 4096-limit desktop always gets a single texture - identical to before; a
 		// 1024-limit console splits e.g. a 2790-tile set into 4 chunks). Bands are aligned to whole padded
@@ -1578,33 +2163,6 @@ namespace Jazz2
 			textures.push_back(Death::move(textureDiffuse));
 		}
 
-		// Caption tile (level-select thumbnail): downscale one tile 1:3 vertically, averaging 3 source rows. Resolve
-		// 8-bit indices through the palette here (32-bit tiles already hold RGB).
-		if (captionTileId > 0) {
-			const std::uint32_t tileX = (captionTileId % srcTilesPerRow) * TileSet::DefaultTileSize;
-			const std::uint32_t tileY = (captionTileId / srcTilesPerRow) * TileSet::DefaultTileSize;
-			if (tileX + TileSet::DefaultTileSize <= width && tileY + TileSet::DefaultTileSize <= height) {
-				const bool captionIs32bit = ((is32bitTile[captionTileId / 8] & (1 << (captionTileId & 7))) != 0);
-				captionTile = std::make_unique<Color[]>(TileSet::DefaultTileSize * TileSet::DefaultTileSize / 3);
-
-				for (std::uint32_t y = 0; y < TileSet::DefaultTileSize / 3; y++) {
-					for (std::uint32_t x = 0; x < TileSet::DefaultTileSize; x++) {
-						std::uint32_t r = 0, g = 0, b = 0;
-						for (std::uint32_t row = 0; row < 3; row++) {
-							const std::uint32_t src = ((tileY + y * 3 + row) * width + (tileX + x)) * channelCount;
-							if (captionIs32bit) {
-								r += pixels[src + 0]; g += pixels[src + 1]; b += pixels[src + 2];
-							} else {
-								const std::uint32_t color = _palettes[pixels[src]];
-								r += (color >> 0) & 0xFF; g += (color >> 8) & 0xFF; b += (color >> 16) & 0xFF;
-							}
-						}
-						captionTile[y * TileSet::DefaultTileSize + x] = Color((std::uint8_t)(r / 3), (std::uint8_t)(g / 3), (std::uint8_t)(b / 3));
-					}
-				}
-			}
-		}
-
 		return textures;
 	}
 
@@ -1618,19 +2176,17 @@ namespace Jazz2
 
 	bool ContentResolver::TryLoadLevel(StringView path, GameDifficulty difficulty, LevelDescriptor& descriptor)
 	{
-		// Try "Content" directory first, then "Cache" directory
-		auto pathNormalized = fs::ToNativeSeparators(path);
-		if (_pathHandler) {
-			descriptor.FullPath = _pathHandler(String(pathNormalized + ".j2l"_s));
-		}
-		if (descriptor.FullPath.empty()) {
-			descriptor.FullPath = fs::CombinePath({ GetContentPath(), "Episodes"_s, String(pathNormalized + ".j2l"_s) });
-			if (!fs::IsReadableFile(descriptor.FullPath)) {
-				descriptor.FullPath = fs::CombinePath({ GetCachePath(), "Episodes"_s, String(pathNormalized + ".j2l"_s) });
-			}
-		}
+		descriptor.FullPath = ResolveLevelPath(path);
+
+		// The level could have been read in the background already, see PrefetchLevelAsync()
+		std::unique_ptr<PrefetchedLevel> prefetched = TakePrefetchedLevel(descriptor.FullPath);
 
-		auto s = fs::Open(descriptor.FullPath, FileAccess::Read, 16 * 1024);
+		std::unique_ptr<Stream> s;
+		if (prefetched != nullptr && prefetched->FileData != nullptr) {
+			s = std::make_unique<MemoryStream>(prefetched->FileData.get(), prefetched->FileSize);
+		} else {
+			s = fs::Open(descriptor.FullPath, FileAccess::Read, 16 * 1024);
+		}
 		if (!s->IsValid()) return false;
 
 		std::uint64_t signature = s->ReadValueAsLE<std::uint64_t>();
@@ -1638,65 +2194,40 @@ namespace Jazz2
 		DEATH_ASSERT(signature == 0x2095A59FF0BFBBEF && fileType == ContentFileType::Level,
 			("Level \"{}\" has invalid signature", descriptor.FullPath), false);
 
-		LevelFlags flags = (LevelFlags)s->ReadValueAsLE<std::uint16_t>();
+		LevelHeader header;
+		header.Flags = (LevelFlags)s->ReadValueAsLE<std::uint16_t>();
 
 		// Read compressed data
 		std::int32_t compressedSize = s->ReadValueAsLE<std::int32_t>();
 
 		DeflateStream uc(*s, compressedSize);
 
-		// Read metadata
-		std::uint8_t stringSize = uc.ReadValue<std::uint8_t>();
-		descriptor.DisplayName = String(NoInit, stringSize);
-		uc.Read(descriptor.DisplayName.data(), stringSize);
-
-		stringSize = uc.ReadValue<std::uint8_t>();
-		descriptor.NextLevel = String(NoInit, stringSize);
-		uc.Read(descriptor.NextLevel.data(), stringSize);
-
-		stringSize = uc.ReadValue<std::uint8_t>();
-		descriptor.SecretLevel = String(NoInit, stringSize);
-		uc.Read(descriptor.SecretLevel.data(), stringSize);
-
-		stringSize = uc.ReadValue<std::uint8_t>();
-		descriptor.BonusLevel = String(NoInit, stringSize);
-		uc.Read(descriptor.BonusLevel.data(), stringSize);
-
-		// Default Tileset
-		stringSize = uc.ReadValue<std::uint8_t>();
-		String defaultTileset(NoInit, stringSize);
-		uc.Read(defaultTileset.data(), stringSize);
+		ReadLevelHeader(uc, header);
 
-		// Default Music
-		stringSize = uc.ReadValue<std::uint8_t>();
-		descriptor.MusicPath = String(NoInit, stringSize);
-		uc.Read(descriptor.MusicPath.data(), stringSize);
+		descriptor.DisplayName = std::move(header.DisplayName);
+		descriptor.NextLevel = std::move(header.NextLevel);
+		descriptor.SecretLevel = std::move(header.SecretLevel);
+		descriptor.BonusLevel = std::move(header.BonusLevel);
+		descriptor.MusicPath = std::move(header.MusicPath);
 
-		uint32_t rawAmbientColor = uc.ReadValueAsLE<std::uint32_t>();
+		std::uint32_t rawAmbientColor = header.AmbientColor;
 		descriptor.AmbientColor = Vector4f((rawAmbientColor & 0xff) / 255.0f, ((rawAmbientColor >> 8) & 0xff) / 255.0f,
 			((rawAmbientColor >> 16) & 0xff) / 255.0f, ((rawAmbientColor >> 24) & 0xff) / 255.0f);
 
-		descriptor.Weather = (WeatherType)uc.ReadValue<std::uint8_t>();
-		descriptor.WeatherIntensity = uc.ReadValue<std::uint8_t>();
-		descriptor.WaterLevel = uc.ReadValueAsLE<std::uint16_t>();
-
-		std::uint16_t captionTileId = uc.ReadValueAsLE<std::uint16_t>();
+		descriptor.Weather = header.Weather;
+		descriptor.WeatherIntensity = header.WeatherIntensity;
+		descriptor.WaterLevel = header.WaterLevel;
 
 		PitType pitType;
-		if ((flags & LevelFlags::HasPit) == LevelFlags::HasPit) {
-			pitType = ((flags & LevelFlags::HasPitInstantDeath) == LevelFlags::HasPitInstantDeath ? PitType::InstantDeathPit : PitType::FallForever);
+		if ((header.Flags & LevelFlags::HasPit) == LevelFlags::HasPit) {
+			pitType = ((header.Flags & LevelFlags::HasPitInstantDeath) == LevelFlags::HasPitInstantDeath ? PitType::InstantDeathPit : PitType::FallForever);
 		} else {
 			pitType = PitType::StandOnPlatform;
 		}
 
-		bool hasCustomPalette = ((flags & LevelFlags::UseLevelPalette) == LevelFlags::UseLevelPalette);
+		bool hasCustomPalette = header.HasCustomPalette();
 		if (hasCustomPalette) {
-			std::uint32_t newPalette[ColorsPerPalette];
-			for (std::size_t i = 0; i < arraySize(newPalette); i++) {
-				newPalette[i] = uc.ReadValueAsLE<std::uint32_t>();
-			}
-
-			if (!_isHeadless && std::memcmp(_palettes, newPalette, ColorsPerPalette * sizeof(std::uint32_t)) != 0) {
+			if (!_isHeadless && std::memcmp(_palettes, header.Palette, ColorsPerPalette * sizeof(std::uint32_t)) != 0) {
 				// Palettes differs, drop all cached resources, so it will be reloaded with new palette
 				if (_isLoading) {
 					// Indexed sprites/tiles recolor from the live palette texture and need no reload; only the baked
@@ -1706,54 +2237,60 @@ namespace Jazz2
 					}
 				}
 
-				std::memcpy(_palettes, newPalette, ColorsPerPalette * sizeof(std::uint32_t));
+				std::memcpy(_palettes, header.Palette, ColorsPerPalette * sizeof(std::uint32_t));
 				RecreateGemPalettes();
 			}
 		}
 
-		std::uint8_t additionalPaletteCount = uc.ReadValue<std::uint8_t>();
-		for (std::int32_t i = 0; i < additionalPaletteCount; i++) {
-			std::uint8_t nameLength = uc.ReadValue<std::uint8_t>();
-			String name(NoInit, nameLength);
-			uc.Read(name.data(), nameLength);
-			std::uint32_t palette[ColorsPerPalette];
-			for (std::size_t i = 0; i < arraySize(palette); i++) {
-				palette[i] = uc.ReadValueAsLE<std::uint32_t>();
-			}
+		// All tile sets are decoded at once together with opening the music, only the textures are uploaded in order
+		bool applyPalette = !hasCustomPalette;
+		SmallVector<DecodedTileSet, 0> tileSets;
+		PrepareLevelTileSets(header, tileSets);
 
-			// TODO: Store and use the palette (if not headless)
+		// Tile sets decoded by the prefetch were prepared from the same file, so they only have to be taken over
+		if (prefetched != nullptr && prefetched->TileSets.size() == tileSets.size()) {
+			for (std::size_t i = 0; i < tileSets.size(); i++) {
+				DecodedTileSet& staged = prefetched->TileSets[i];
+				if (staged.IsDecoded && staged.FullPath == tileSets[i].FullPath) {
+					tileSets[i] = std::move(staged);
+				}
+			}
 		}
 
-		descriptor.TileMap = std::make_unique<Tiles::TileMap>(defaultTileset, captionTileId, !hasCustomPalette);
-		descriptor.TileMap->SetPitType(pitType);
-
-		// Extra Tilesets
-		std::uint8_t extraTilesetCount = uc.ReadValue<std::uint8_t>();
-		for (std::uint32_t i = 0; i < extraTilesetCount; i++) {
-			std::uint8_t tilesetFlags = uc.ReadValue<std::uint8_t>();
-
-			stringSize = uc.ReadValue<std::uint8_t>();
-			String extraTileset{NoInit, stringSize};
-			uc.Read(extraTileset.data(), stringSize);
-
-			std::uint16_t offset = uc.ReadValueAsLE<std::uint16_t>();
-			std::uint16_t count = uc.ReadValueAsLE<std::uint16_t>();
+		PreparedMusic music;
+#if defined(WITH_AUDIO)
+		if (!_isHeadless && !descriptor.MusicPath.empty()) {
+			music.FullPath = ResolveMusicPath(descriptor.MusicPath);
+		}
+#endif
 
-			std::uint8_t paletteRemapping[ColorsPerPalette];
-			bool isRemapped = ((tilesetFlags & 0x01) == 0x01);
-			bool is24bit = ((tilesetFlags & 0x02) == 0x02);
-			if (isRemapped) {
-				if (is24bit) {
-					// Alternate palette index
-					paletteRemapping[0] = uc.ReadValue<std::uint8_t>();
-				} else {
-					uc.Read(paletteRemapping, sizeof(paletteRemapping));
+		std::int32_t tileSetCount = std::int32_t(tileSets.size());
+		RunParallel(tileSetCount + (music.FullPath.empty() ? 0 : 1), [this, &tileSets, &music, tileSetCount](std::int32_t i) {
+			if (i < tileSetCount) {
+				if (!tileSets[i].IsDecoded) {
+					tileSets[i].IsDecoded = DecodeTileSet(tileSets[i]);
 				}
+			} else {
+				PrepareMusic(music);
 			}
+		});
+
+		if (applyPalette && tileSets[0].IsDecoded) {
+			ApplyTilesetPalette(tileSets[0].Palette);
+		}
+
+		descriptor.TileMap = std::make_unique<Tiles::TileMap>(header.DefaultTileset, tileSets[0].IsDecoded ? CreateTileSet(tileSets[0]) : nullptr);
+		descriptor.TileMap->SetPitType(pitType);
 
-			descriptor.TileMap->AddTileSet(extraTileset, offset, count, isRemapped ? paletteRemapping : nullptr);
+		for (std::size_t i = 0; i < header.ExtraTileSets.size(); i++) {
+			const LevelHeader::ExtraTileSet& extraTileset = header.ExtraTileSets[i];
+			DecodedTileSet& decoded = tileSets[1 + i];
+			descriptor.TileMap->AddTileSet(extraTileset.Path, decoded.IsDecoded ? CreateTileSet(decoded) : nullptr,
+				extraTileset.Offset, extraTileset.Count);
 		}
 
+		descriptor.Music = CreateMusicPlayer(music);
+
 		if (!descriptor.TileMap->IsValid()) {
 			// Cannot load one of required tilesets (errors already logged by TileMap)
 			return false;
@@ -1805,24 +2342,272 @@ namespace Jazz2
 			uc.Read(text.data(), textLength);
 		}
 
+		// The rest of the file consists of many small values, so it's read in blocks without a virtual call for each
+		// value, nothing else reads the decompressed stream afterwards
+		SpanReader reader(uc);
+
 		// Animated Tiles
-		descriptor.TileMap->ReadAnimatedTiles(uc);
+		descriptor.TileMap->ReadAnimatedTiles(reader);
 
 		// Layers
-		std::uint8_t layerCount = uc.ReadValue<std::uint8_t>();
+		std::uint8_t layerCount = reader.ReadValue<std::uint8_t>();
 		for (std::uint32_t i = 0; i < layerCount; i++) {
-			descriptor.TileMap->ReadLayerConfiguration(uc);
+			descriptor.TileMap->ReadLayerConfiguration(reader);
 		}
 
 		// Events
 		descriptor.EventMap = std::make_unique<Events::EventMap>(descriptor.TileMap->GetSize());
 		descriptor.EventMap->SetPitType(pitType);
-		descriptor.EventMap->ReadEvents(uc, descriptor.TileMap, difficulty);
+		descriptor.EventMap->ReadEvents(reader, descriptor.TileMap, difficulty);
+
+		DEATH_ASSERT(uc.IsValid() && reader.IsValid(), "File cannot be decompressed", false);
+		return true;
+	}
+
+	bool ContentResolver::PrefetchLevelAsync(StringView path)
+	{
+#if defined(WITH_THREADS)
+		if (_pathHandler || Thread::GetProcessorCount() < 2) {
+			return true;
+		}
+
+		String fullPath = ResolveLevelPath(path);
+		if (_prefetchedLevel != nullptr) {
+			if (_prefetchedLevel->FullPath == fullPath) {
+				return true;
+			}
+
+			// The caller is not blocked until the worker leaves the previous level
+			_prefetchedLevel->IsCancelled.store(true, std::memory_order_relaxed);
+			_prefetchedLevel->FinishedMutex.Lock();
+			bool isFinished = _prefetchedLevel->IsFinished;
+			_prefetchedLevel->FinishedMutex.Unlock();
+			if (!isFinished) {
+				return false;
+			}
+			_prefetchedLevel = nullptr;
+		}
+
+		_prefetchedLevel = std::make_unique<PrefetchedLevel>();
+		_prefetchedLevel->FullPath = std::move(fullPath);
+		_prefetchedLevel->IsCancelled.store(false, std::memory_order_relaxed);
+
+		// Not enqueued to the thread pool, the jobs of a frame would otherwise wait for the worker that decodes
+		// the level. The thread is detached, TakePrefetchedLevel() waits for the finished flag instead.
+		Thread prefetchThread([this, prefetched = _prefetchedLevel.get()]() {
+			Thread::SetCurrentName("Level prefetch");
+			DecodePrefetchedLevel(*prefetched);
 
-		DEATH_ASSERT(uc.IsValid(), "File cannot be decompressed", false);
+			prefetched->FinishedMutex.Lock();
+			prefetched->IsFinished = true;
+			prefetched->FinishedCV.Signal();
+			prefetched->FinishedMutex.Unlock();
+		});
+		if (!prefetchThread) {
+			_prefetchedLevel = nullptr;
+		}
+#endif
 		return true;
 	}
 
+	String ContentResolver::ResolveLevelPath(StringView path)
+	{
+		// Try "Content" directory first, then "Cache" directory
+		auto pathNormalized = fs::ToNativeSeparators(path);
+		String fullPath;
+		if (_pathHandler) {
+			fullPath = _pathHandler(String(pathNormalized + ".j2l"_s));
+		}
+		if (fullPath.empty()) {
+			fullPath = fs::CombinePath({ GetContentPath(), "Episodes"_s, String(pathNormalized + ".j2l"_s) });
+			if (!fs::IsReadableFile(fullPath)) {
+				fullPath = fs::CombinePath({ GetCachePath(), "Episodes"_s, String(pathNormalized + ".j2l"_s) });
+			}
+		}
+		return fullPath;
+	}
+
+	void ContentResolver::ReadLevelHeader(Stream& uc, LevelHeader& header)
+	{
+		// Read metadata
+		std::uint8_t stringSize = uc.ReadValue<std::uint8_t>();
+		header.DisplayName = String(NoInit, stringSize);
+		uc.Read(header.DisplayName.data(), stringSize);
+
+		stringSize = uc.ReadValue<std::uint8_t>();
+		header.NextLevel = String(NoInit, stringSize);
+		uc.Read(header.NextLevel.data(), stringSize);
+
+		stringSize = uc.ReadValue<std::uint8_t>();
+		header.SecretLevel = String(NoInit, stringSize);
+		uc.Read(header.SecretLevel.data(), stringSize);
+
+		stringSize = uc.ReadValue<std::uint8_t>();
+		header.BonusLevel = String(NoInit, stringSize);
+		uc.Read(header.BonusLevel.data(), stringSize);
+
+		// Default Tileset
+		stringSize = uc.ReadValue<std::uint8_t>();
+		header.DefaultTileset = String(NoInit, stringSize);
+		uc.Read(header.DefaultTileset.data(), stringSize);
+
+		// Default Music
+		stringSize = uc.ReadValue<std::uint8_t>();
+		header.MusicPath = String(NoInit, stringSize);
+		uc.Read(header.MusicPath.data(), stringSize);
+
+		header.AmbientColor = uc.ReadValueAsLE<std::uint32_t>();
+		header.Weather = (WeatherType)uc.ReadValue<std::uint8_t>();
+		header.WeatherIntensity = uc.ReadValue<std::uint8_t>();
+		header.WaterLevel = uc.ReadValueAsLE<std::uint16_t>();
+		header.CaptionTileId = uc.ReadValueAsLE<std::uint16_t>();
+
+		if (header.HasCustomPalette()) {
+			for (std::int32_t i = 0; i < ColorsPerPalette; i++) {
+				header.Palette[i] = uc.ReadValueAsLE<std::uint32_t>();
+			}
+		}
+
+		std::uint8_t additionalPaletteCount = uc.ReadValue<std::uint8_t>();
+		for (std::int32_t i = 0; i < additionalPaletteCount; i++) {
+			std::uint8_t nameLength = uc.ReadValue<std::uint8_t>();
+			uc.Seek(nameLength, SeekOrigin::Current);
+
+			// TODO: Store and use the palette (if not headless)
+			uc.Seek(ColorsPerPalette * sizeof(std::uint32_t), SeekOrigin::Current);
+		}
+
+		// Extra Tilesets
+		std::uint8_t extraTilesetCount = uc.ReadValue<std::uint8_t>();
+		header.ExtraTileSets.reserve(extraTilesetCount);
+		for (std::uint32_t i = 0; i < extraTilesetCount; i++) {
+			LevelHeader::ExtraTileSet& extraTileset = header.ExtraTileSets.emplace_back();
+			std::uint8_t tilesetFlags = uc.ReadValue<std::uint8_t>();
+
+			stringSize = uc.ReadValue<std::uint8_t>();
+			extraTileset.Path = String(NoInit, stringSize);
+			uc.Read(extraTileset.Path.data(), stringSize);
+
+			extraTileset.Offset = uc.ReadValueAsLE<std::uint16_t>();
+			extraTileset.Count = uc.ReadValueAsLE<std::uint16_t>();
+
+			extraTileset.IsRemapped = ((tilesetFlags & 0x01) == 0x01);
+			bool is24bit = ((tilesetFlags & 0x02) == 0x02);
+			if (extraTileset.IsRemapped) {
+				if (is24bit) {
+					// Alternate palette index
+					extraTileset.PaletteRemapping[0] = uc.ReadValue<std::uint8_t>();
+				} else {
+					uc.Read(extraTileset.PaletteRemapping, sizeof(extraTileset.PaletteRemapping));
+				}
+			}
+		}
+	}
+
+	void ContentResolver::PrepareLevelTileSets(LevelHeader& header, SmallVector<DecodedTileSet, 0>& tileSets)
+	{
+		bool applyPalette = !header.HasCustomPalette();
+		tileSets.reserve(1 + header.ExtraTileSets.size());
+
+		// The custom palette of the level is already the live palette when the tile sets are created
+		DecodedTileSet& defaultDecoded = tileSets.emplace_back();
+		defaultDecoded.Path = header.DefaultTileset;
+		defaultDecoded.FullPath = ResolveTileSetPath(header.DefaultTileset);
+		defaultDecoded.CaptionTileId = header.CaptionTileId;
+		defaultDecoded.BakePalette = (applyPalette ? nullptr : header.Palette);
+
+		// Extra tile sets bake the palette of the default tile set if it's going to be applied, so it's read upfront
+		const std::uint32_t* extraPalette = header.Palette;
+		if (applyPalette && !_isHeadless && !header.ExtraTileSets.empty()) {
+			if (!ReadTileSetPalette(defaultDecoded.FullPath, header.TileSetPalette)) {
+				// The level cannot be loaded without its default tile set anyway
+				std::memset(header.TileSetPalette, 0, sizeof(header.TileSetPalette));
+			}
+			extraPalette = header.TileSetPalette;
+		}
+
+		for (const LevelHeader::ExtraTileSet& extraTileset : header.ExtraTileSets) {
+			DecodedTileSet& decoded = tileSets.emplace_back();
+			decoded.Path = extraTileset.Path;
+			decoded.FullPath = ResolveTileSetPath(extraTileset.Path);
+			decoded.PaletteRemapping = (extraTileset.IsRemapped ? extraTileset.PaletteRemapping : nullptr);
+			decoded.BakePalette = extraPalette;
+		}
+	}
+
+	void ContentResolver::DecodePrefetchedLevel(PrefetchedLevel& prefetched)
+	{
+#if defined(WITH_THREADS)
+		ZoneScopedC(0x95A5A6);
+
+		auto s = fs::Open(prefetched.FullPath, FileAccess::Read);
+		std::int64_t fileSize = (s->IsValid() ? s->GetSize() : 0);
+		if (fileSize <= 0) {
+			return;
+		}
+
+		std::unique_ptr<std::uint8_t[]> fileData = std::make_unique<std::uint8_t[]>(fileSize);
+		if (s->Read(fileData.get(), fileSize) != fileSize) {
+			return;
+		}
+		s = nullptr;
+
+		MemoryStream ms(fileData.get(), fileSize);
+		std::uint64_t signature = ms.ReadValueAsLE<std::uint64_t>();
+		std::uint8_t fileType = ms.ReadValue<std::uint8_t>();
+		if (signature != 0x2095A59FF0BFBBEF || fileType != ContentFileType::Level) {
+			return;
+		}
+
+		prefetched.Header.Flags = (LevelFlags)ms.ReadValueAsLE<std::uint16_t>();
+		std::int32_t compressedSize = ms.ReadValueAsLE<std::int32_t>();
+		{
+			DeflateStream uc(ms, compressedSize);
+			ReadLevelHeader(uc, prefetched.Header);
+			if (!uc.IsValid()) {
+				return;
+			}
+		}
+
+		prefetched.FileData = std::move(fileData);
+		prefetched.FileSize = fileSize;
+
+		// Tile sets are decoded one at a time and the remaining ones are skipped when the prefetch is cancelled
+		PrepareLevelTileSets(prefetched.Header, prefetched.TileSets);
+		for (DecodedTileSet& decoded : prefetched.TileSets) {
+			if (prefetched.IsCancelled.load(std::memory_order_relaxed)) {
+				break;
+			}
+			decoded.IsDecoded = DecodeTileSet(decoded);
+		}
+#endif
+	}
+
+	std::unique_ptr<ContentResolver::PrefetchedLevel> ContentResolver::TakePrefetchedLevel(StringView fullPath)
+	{
+		if (_prefetchedLevel == nullptr) {
+			return nullptr;
+		}
+
+#if defined(WITH_THREADS)
+		if (_prefetchedLevel->FullPath != fullPath) {
+			_prefetchedLevel->IsCancelled.store(true, std::memory_order_relaxed);
+		}
+
+		_prefetchedLevel->FinishedMutex.Lock();
+		while (!_prefetchedLevel->IsFinished) {
+			_prefetchedLevel->FinishedCV.Wait(_prefetchedLevel->FinishedMutex);
+		}
+		_prefetchedLevel->FinishedMutex.Unlock();
+#endif
+
+		std::unique_ptr<PrefetchedLevel> prefetched = std::move(_prefetchedLevel);
+		if (prefetched->FullPath != fullPath) {
+			return nullptr;
+		}
+		return prefetched;
+	}
+
 	void ContentResolver::ApplyDefaultPalette()
 	{
 		static_assert(sizeof(SpritePalette) == ColorsPerPalette * sizeof(std::uint32_t));
@@ -1960,6 +2745,18 @@ namespace Jazz2
 			return nullptr;
 		}
 
+		String fullPath = ResolveMusicPath(path);
+		if (fullPath.empty()) {
+			return nullptr;
+		}
+		return std::make_unique<AudioStreamPlayer>(fullPath);
+#else
+		return nullptr;
+#endif
+	}
+
+	String ContentResolver::ResolveMusicPath(StringView path)
+	{
 		String fullPath;
 		if (_pathHandler) {
 			fullPath = _pathHandler(path);
@@ -1972,14 +2769,35 @@ namespace Jazz2
 			}
 		}
 		if (!fs::IsReadableFile(fullPath)) {
-			return nullptr;
+			return {};
+		}
+		return fullPath;
+	}
+
+	void ContentResolver::PrepareMusic(PreparedMusic& prepared)
+	{
+#if defined(WITH_AUDIO)
+		prepared.Loader = IAudioLoader::createFromFile(prepared.FullPath);
+		if (prepared.Loader->hasLoaded()) {
+			// Creating the reader parses the whole file for some formats (e.g., modules)
+			prepared.Reader = prepared.Loader->createReader();
 		}
-		return std::make_unique<AudioStreamPlayer>(fullPath);
-#else
-		return nullptr;
 #endif
 	}
 
+	std::unique_ptr<AudioStreamPlayer> ContentResolver::CreateMusicPlayer(PreparedMusic& prepared)
+	{
+#if defined(WITH_AUDIO)
+		if (prepared.Reader != nullptr) {
+			auto player = std::make_unique<AudioStreamPlayer>();
+			if (player->loadFromReader(*prepared.Loader, std::move(prepared.Reader))) {
+				return player;
+			}
+		}
+#endif
+		return nullptr;
+	}
+
 	UI::Font* ContentResolver::GetFont(FontType fontType)
 	{
 		if (fontType >= FontType::Count) {
@@ -28,8 +28,14 @@ namespace ShaderCompiler
 	struct Program;
 }
 
+namespace Json
+{
+	class Value;
+}
+
 namespace nCine
 {
+	class ITextureLoader;
 	class RenderCommand;
 }
 
@@ -74,6 +80,8 @@ namespace Jazz2
 		static constexpr std::int32_t FirstDynamicPaletteRow = 8;
 		/** @brief Invalid value */
 		static constexpr std::int32_t InvalidValue = INT_MAX;
+		/** @brief Maximum number of level handlers sharing the cached assets, including the main session */
+		static constexpr std::int32_t MaxContentHolders = 32;
 
 		/** @{ @name Player recolor palette sections */
 
@@ -166,14 +174,35 @@ namespace Jazz2
 		
 		/** @brief Marks beginning of the loading assets */
 		void BeginLoading();
-		/** @brief Marks end of the loading assets */
+		/** @brief Marks end of the loading assets, assets no longer used by any holder are released */
 		void EndLoading();
+		/**
+		 * @brief Registers another level handler that shares the cached assets, returns its holder index
+		 *
+		 * Used when several level handlers run side by side (e.g., rooms of a dedicated server). Each cached asset
+		 * keeps track of the holders whose last loaded level referenced it, so it's released only when none of them
+		 * uses it anymore. The main session always uses holder 0. Returns -1 if all holders are already in use.
+		 */
+		std::int32_t RetainSharedContent();
+		/** @brief Counterpart of @ref RetainSharedContent(), assets used only by the holder are released */
+		void ReleaseSharedContent(std::int32_t holder);
+		/** @brief Selects the holder whose level is loaded by the following @ref BeginLoading() and @ref EndLoading() */
+		void SetLoadingHolder(std::int32_t holder);
 
 		/** @brief Overrides the default path handler */
 		void OverridePathHandler(Function<String(StringView)>&& callback);
 
 		/** @brief Preloads specified metadata and its linked assets to cache */
 		void PreloadMetadataAsync(StringView path);
+		/**
+		 * @brief Collects the metadata requested by @ref PreloadMetadataAsync() until @ref EndPreloading() is called
+		 *
+		 * The collected metadata files and their graphics are then read and decoded together, on the workers of the
+		 * thread pool if one is registered. Only the texture uploads are left for the calling thread.
+		 */
+		void BeginPreloading();
+		/** @brief Loads all metadata collected since @ref BeginPreloading() */
+		void EndPreloading();
 		/**
 		 * @brief Loads specified metadata and its linked assets (cached)
 		 *
@@ -298,6 +327,16 @@ namespace Jazz2
 		bool LevelExists(StringView levelName);
 		/** @brief Loads specified level into a level descriptor */
 		bool TryLoadLevel(StringView path, GameDifficulty difficulty, LevelDescriptor& descriptor);
+		/**
+		 * @brief Reads the specified level and decodes its tile sets in the background
+		 *
+		 * The work runs on a dedicated thread, so it never holds up the jobs of a frame in the thread pool, and the
+		 * results are kept aside until @ref TryLoadLevel() is called for the same level, any other level drops them.
+		 * Returns `false` if the request cannot be accepted yet, because a prefetch of another level is still being
+		 * cancelled, so it should be repeated later. Does nothing on single-processor machines or with an overridden
+		 * path handler.
+		 */
+		bool PrefetchLevelAsync(StringView path);
 		/** @brief Loads default (sprite) palette */
 		void ApplyDefaultPalette();
 		/**
@@ -353,27 +392,71 @@ namespace Jazz2
 		// from any real paletteOffset so indexed and baked variants of the same sprite are cached separately
 		static constexpr std::uint16_t IndexedGraphicsCacheKey = UINT16_MAX;
 
+#ifndef DOXYGEN_GENERATING_OUTPUT
+		// Intermediate results of the loading steps that don't need the main thread, defined in the source file
+		struct DecodedGraphics;
+		struct PreloadedMetadata;
+		struct DecodedTileSet;
+		struct PreparedMusic;
+		struct LevelHeader;
+		struct PrefetchedLevel;
+#endif
+
+		// Runs `job` for each index in [0, count), spread over the thread pool workers and the calling thread, or in
+		// order on the calling thread if no pool is registered. Returns when all of them finished.
+		static void RunParallel(std::int32_t count, Function<void(std::int32_t)>&& job);
+
+		// Creates the metadata from its parsed file (or empty if it couldn't be parsed) and adds it to the cache, the
+		// graphics found in `decodedGraphics` are only uploaded, the rest is requested as usual
+		Metadata* CreateMetadata(StringView path, String&& pathNormalized, String&& cacheKey, const Json::Value* doc,
+			ArrayView<DecodedGraphics> decodedGraphics);
+		// Reads and parses one metadata file and decodes its eagerly loaded graphics, safe to call from worker threads
+		void DecodeMetadata(PreloadedMetadata& preloaded);
+		// Reads the graphics asset and prepares its pixels, collision mask and description without touching the
+		// GPU, safe to call from worker threads
+		bool DecodeGraphics(StringView pathNormalized, std::uint16_t paletteOffset, bool keepIndexed, DecodedGraphics& decoded);
+		// Uploads the decoded graphics and adds them to the cache, unless the same graphics were cached meanwhile
+		GenericGraphicResource* FinishGraphics(StringView pathNormalized, std::uint16_t paletteOffset, bool keepIndexed, DecodedGraphics& decoded);
 		GenericGraphicResource* RequestGraphicsAura(StringView path, std::uint16_t paletteOffset, bool keepIndexed = false);
 		static void ReadImageFromFile(std::unique_ptr<Stream>& s, std::uint8_t* data, std::int32_t width, std::int32_t height, std::int32_t channelCount);
 		// Copies a tile's edge pixels into its 1px atlas padding (so sampling never bleeds across tiles); `bytesPerPixel`
 		// is 1 for an indexed (R8) atlas or 4 for a baked RGBA atlas
 		static void ExpandTileDiffuse(std::uint8_t* pixelsOffset, std::uint32_t widthWithPadding, std::uint32_t bytesPerPixel);
 
-		// Reads the tileset's 256-color palette from the decompressed stream and applies it to the live sprite palette
-		// (drops baked fonts, regenerates gem palettes); just skips the bytes when headless or `applyPalette` is false
-		void ReadTilesetPalette(Stream& uc, bool applyPalette);
+		// Returns the full path of the level file, has to be called on the main thread (see OverridePathHandler())
+		String ResolveLevelPath(StringView path);
+		// Reads the level properties and the list of its tile sets that precede the actual content of the level
+		static void ReadLevelHeader(Stream& uc, LevelHeader& header);
+		// Fills the decoding inputs of the default and extra tile sets of the level, `header` has to outlive them
+		void PrepareLevelTileSets(LevelHeader& header, SmallVector<DecodedTileSet, 0>& tileSets);
+		// Reads the level file and decodes its tile sets, runs on the prefetch thread
+		void DecodePrefetchedLevel(PrefetchedLevel& prefetched);
+		// Waits for the prefetch and returns it if it belongs to the level, otherwise it's cancelled and dropped
+		std::unique_ptr<PrefetchedLevel> TakePrefetchedLevel(StringView fullPath);
+
+		// Returns the full path of the tile set file, has to be called on the main thread (see OverridePathHandler())
+		String ResolveTileSetPath(StringView path);
+		// Reads only the 256-color palette of the tile set file, so the tile sets that bake it can be decoded
+		// before the tile set that brings it is finished
+		static bool ReadTileSetPalette(StringView fullPath, std::uint32_t* palette);
+		// Reads the tile set file, its mask and builds the diffuse atlas in memory, safe to call from worker threads
+		bool DecodeTileSet(DecodedTileSet& decoded);
+		// Uploads the decoded atlas and creates the tile set, has to be called on the main thread
+		std::unique_ptr<Tiles::TileSet> CreateTileSet(DecodedTileSet& decoded);
+		// Applies the tileset's 256-color palette to the live sprite palette (drops baked fonts, regenerates gem
+		// palettes); does nothing when headless
+		void ApplyTilesetPalette(const std::uint32_t* newPalette);
 		// Reads the tileset's packed collision mask from the decompressed stream (kept in the cache's 1-bit-per-pixel
 		// form, see TileSet::MaskBytesPerTile); `maskSize` receives its size in bytes
 		static std::unique_ptr<std::uint8_t[]> ReadTilesetMask(Stream& uc, std::uint32_t& maskSize);
-		// Builds the padded tileset diffuse atlas (R8 indexed for all-8-bit tilesets, RGBA8 baked when any tile is
-		// 32-bit), the per-tile fully-opaque flags and the optional caption thumbnail. Reads pixels from the raw stream
-		// `s` (the image content follows the compressed block). Sets `indexTiles` to the chosen mode.
-		// Returns one texture normally, or several consecutive row-band chunks when the atlas exceeds the
+		// Builds the padded tileset diffuse atlas in memory (single index channel for all-8-bit tilesets, RGBA baked
+		// with `palette` when any tile is 32-bit), the per-tile fully-opaque flags and the optional caption thumbnail.
+		// Reads pixels from the raw stream `s` (the image content follows the compressed block).
+		static void BuildTilesetDiffuse(std::unique_ptr<Stream>& s, std::uint8_t channelCount, std::uint32_t width,
+			std::uint32_t height, const std::uint8_t* is32bitTile, const std::uint32_t* palette, DecodedTileSet& decoded);
+		// Uploads the atlas as one texture normally, or several consecutive row-band chunks when it exceeds the
 		// device's texture-size limit (console targets); see TileSet::ResolveTextureDiffuse
-		SmallVector<std::unique_ptr<Texture>, 1> BuildTilesetDiffuse(std::unique_ptr<Stream>& s, const char* name, std::uint8_t channelCount,
-			std::uint32_t width, std::uint32_t height, std::uint16_t tileCount, const std::uint8_t* is32bitTile,
-			const std::uint8_t* paletteRemapping, std::uint16_t captionTileId, bool& indexTiles,
-			std::unique_ptr<std::uint8_t[]>& tileDiffuseOpaque, std::unique_ptr<Color[]>& captionTile);
+		SmallVector<std::unique_ptr<Texture>, 1> UploadTilesetDiffuse(const DecodedTileSet& decoded);
 		// Packs an indexed sprite/tile (palette index in the red/first channel) into the smallest texture format: R8
 		// when alpha is on/off only (4x less VRAM than RGBA8), or RG8 keeping the per-pixel alpha in green (sampled
 		// into .a via swizzle) when alpha is partial. `srcChannels` is the bytes-per-pixel of `pixels`: 1 (index
@@ -392,6 +475,13 @@ namespace Jazz2
 			return CompileShader(shaderName, program, nullptr, introspection);
 		}
 		
+		// Resolves the path of the music file, empty if it doesn't exist
+		String ResolveMusicPath(StringView path);
+		// Opens the music file and creates its reader, safe to call from worker threads
+		static void PrepareMusic(PreparedMusic& prepared);
+		// Creates the player from the prepared reader, has to be called on the main thread
+		static std::unique_ptr<AudioStreamPlayer> CreateMusicPlayer(PreparedMusic& prepared);
+
 		void RecreateGemPalettes();
 		// Expands the dirty palette-row range so the next GetPaletteTexture re-uploads at least rows [firstRow, lastRow]
 		void MarkPaletteDirty(std::int32_t firstRow, std::int32_t lastRow);
@@ -401,13 +491,18 @@ namespace Jazz2
 		static std::int32_t GetFurSchemeIndex(PlayerType playerType);
 		// Core recolor builder, keyed by the scheme index stored on each dynamic palette row
 		void BuildPlayerColorPaletteForScheme(std::uint32_t furColor, std::int32_t schemeIndex, std::uint32_t* outPalette) const;
+		// Releases cached assets that are neither held by any holder nor referenced since the last loading
+		void ReleaseUnheldContent();
 #if defined(DEATH_DEBUG)
 		void MigrateGraphics(StringView path);
 #endif
 
 		bool _isHeadless;
 		bool _isLoading;
+		bool _isPreloading;
 		bool _isContentPrebaked;
+		std::int32_t _loadingHolder;
+		std::uint32_t _contentHolders;
 		std::uint32_t _palettes[PaletteCount * ColorsPerPalette];
 		// Shared palette texture (256x256: one palette per row). Rows changed since the last upload are tracked by
 		// the dirty range below and re-uploaded lazily. Dynamically allocated per-player rows are reference-counted
@@ -436,6 +531,10 @@ namespace Jazz2
 		SmallVector<std::unique_ptr<PakFile>> _mountedPaks;
 #endif
 		Function<String(StringView)> _pathHandler;
+		// Paths collected by PreloadMetadataAsync() between BeginPreloading() and EndPreloading()
+		SmallVector<String, 0> _pendingPreloads;
+		// Level read in the background by PrefetchLevelAsync(), only the main thread replaces the pointer
+		std::unique_ptr<PrefetchedLevel> _prefetchedLevel;
 
 #if defined(DEATH_TARGET_UNIX) || defined(DEATH_TARGET_WINDOWS_RT)
 		String _contentPath;
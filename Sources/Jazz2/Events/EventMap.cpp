@@ -386,7 +386,7 @@ namespace Jazz2::Events
 		return Vector2f(-1.0f, -1.0f);
 	}
 
-	void EventMap::ReadEvents(Stream& s, const std::unique_ptr<Tiles::TileMap>& tileMap, GameDifficulty difficulty)
+	void EventMap::ReadEvents(SpanReader& s, const std::unique_ptr<Tiles::TileMap>& tileMap, GameDifficulty difficulty)
 	{
 		_eventLayout = std::make_unique<EventTile[]>(_layoutSize.X * _layoutSize.Y);
 
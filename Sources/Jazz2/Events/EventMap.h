@@ -7,6 +7,7 @@
 
 #include "../../nCine/Base/BitArray.h"
 
+#include <IO/SpanReader.h>
 #include <IO/Stream.h>
 
 using namespace Death::IO;
@@ -100,7 +101,7 @@ namespace Jazz2::Events
 		Vector2f GetWarpTarget(std::uint32_t id);
 
 		/** @brief Reads event layer data from stream */
-		void ReadEvents(Stream& s, const std::unique_ptr<Tiles::TileMap>& tileMap, GameDifficulty difficulty);
+		void ReadEvents(SpanReader& s, const std::unique_ptr<Tiles::TileMap>& tileMap, GameDifficulty difficulty);
 		/** @brief Adds target position for specified warp */
 		void AddWarpTarget(std::uint16_t id, std::int32_t x, std::int32_t y);
 		/** @brief Adds spawn position with specified player type mask */
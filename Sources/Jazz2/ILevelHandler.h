@@ -146,8 +146,13 @@ namespace Jazz2
 		/** @brief Adds an actor (object) to the level */
 		virtual void AddActor(std::shared_ptr<Actors::ActorBase> actor) = 0;
 
-		/** @brief Plays a sound effect for a given actor (object) */
-		virtual std::shared_ptr<AudioBufferPlayer> PlaySfx(Actors::ActorBase* self, StringView identifier, AudioBuffer* buffer, const Vector3f& pos, bool sourceRelative, float gain = 1.0f, float pitch = 1.0f) = 0;
+		/**
+		 * @brief Plays a sound effect for a given actor (object)
+		 *
+		 * Sounds with higher @p priority keep their voice when there are more sounds than the audio device can play,
+		 * see @ref SoundResource::Priority.
+		 */
+		virtual std::shared_ptr<AudioBufferPlayer> PlaySfx(Actors::ActorBase* self, StringView identifier, AudioBuffer* buffer, const Vector3f& pos, bool sourceRelative, float gain = 1.0f, float pitch = 1.0f, std::int32_t priority = SoundResource::DefaultPriority) = 0;
 		/** @brief Plays a common sound effect */
 		virtual std::shared_ptr<AudioBufferPlayer> PlayCommonSfx(StringView identifier, const Vector3f& pos, float gain = 1.0f, float pitch = 1.0f) = 0;
 		/** @brief Warps a camera to its assigned target */
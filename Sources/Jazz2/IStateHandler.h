@@ -35,6 +35,8 @@ namespace Jazz2
 		virtual void OnBeginFrame() {}
 		/** @brief Called at the end of each frame */
 		virtual void OnEndFrame() {}
+		/** @brief Called before rendering in fixed-timestep mode, @p alpha is the position of the frame between the last two ticks */
+		virtual void OnInterpolate(float alpha) {}
 		/** @brief Called when the viewport needs to be initialized (e.g., when the resolution is changed) */
 		virtual void OnInitializeViewport(std::int32_t width, std::int32_t height) {}
 
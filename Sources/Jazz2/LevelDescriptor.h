@@ -3,6 +3,7 @@
 #include "../Main.h"
 #include "WeatherType.h"
 
+#include "../nCine/Audio/AudioStreamPlayer.h"
 #include "../nCine/Primitives/Vector4.h"
 
 #include <Containers/SmallVector.h>
@@ -48,6 +49,8 @@ namespace Jazz2
 		std::unique_ptr<Events::EventMap> EventMap;
 		/** @brief Music file path */
 		String MusicPath;
+		/** @brief Music stream opened together with the level, `nullptr` if the level handler has to open it */
+		std::unique_ptr<AudioStreamPlayer> Music;
 		/** @brief Ambient color */
 		Vector4f AmbientColor;
 		/** @brief Weather type */
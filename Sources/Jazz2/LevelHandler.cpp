@@ -70,7 +70,8 @@ namespace Jazz2
 
 	Vector3f AudioBufferPlayerForSplitscreen::getAdjustedPosition(IAudioDevice& device, const Vector3f& pos, bool isSourceRelative, bool isAs2D)
 	{
-		if (isSourceRelative || isAs2D) {
+		// With a single viewport, the listener is already placed at its camera
+		if (isSourceRelative || isAs2D || _viewports.size() <= 1) {
 			return AudioBufferPlayer::getAdjustedPosition(device, pos, isSourceRelative, isAs2D);
 		}
 
@@ -91,7 +92,7 @@ namespace Jazz2
 
 	void AudioBufferPlayerForSplitscreen::updatePosition()
 	{
-		if (_state != PlayerState::Playing || GetFlags(PlayerFlags::SourceRelative) || GetFlags(PlayerFlags::As2D)) {
+		if (_state != PlayerState::Playing || _sourceId == IAudioDevice::UnavailableSource || GetFlags(PlayerFlags::SourceRelative) || GetFlags(PlayerFlags::As2D)) {
 			return;
 		}
 
@@ -112,10 +113,20 @@ namespace Jazz2
 #endif
 			_eventSpawner(this), _difficulty(GameDifficulty::Default), _isReforged(false),
 			_cheatsUsed(false), _checkpointCreated(false), _nextLevelType(ExitType::None),
-			_nextLevelTime(0.0f), _elapsedMillisecondsBegin(0), _elapsedFrames(0.0f), _checkpointFrames(0.0f),
+			_nextLevelTime(0.0f), _prefetchedNextLevelExit(UINT32_MAX), _elapsedMillisecondsBegin(0), _elapsedFrames(0.0f), _checkpointFrames(0.0f),
 			_waterLevel(FLT_MAX), _weatherType(WeatherType::None), _pressedKeys(ValueInit, (std::size_t)Keys::Count),
 			_overrideActions(0), _overrideMovement(0.0f, 0.0f)
 	{
+#if defined(WITH_AUDIO)
+		_sfxVoices.reserve(SfxVoiceCount);
+		for (std::int32_t i = 0; i < SfxVoiceCount; i++) {
+			auto& voice = _sfxVoices.emplace_back();
+			voice.Player = std::make_shared<AudioBufferPlayerForSplitscreen>(nullptr, _assignedViewports);
+			voice.Priority = SoundResource::DefaultPriority;
+			voice.Score = 0.0f;
+			voice.VirtualTime = 0.0f;
+		}
+#endif
 	}
 
 	LevelHandler::~LevelHandler()
@@ -254,9 +265,12 @@ namespace Jazz2
 	{
 		auto& resolver = ContentResolver::Get();
 		_commonResources = resolver.RequestMetadata("Common/Scenery"_s);
-		resolver.PreloadMetadataAsync("Common/Explosions"_s);
 
+		// Metadata of all events are collected first, so they can be decoded in parallel
+		resolver.BeginPreloading();
+		resolver.PreloadMetadataAsync("Common/Explosions"_s);
 		_eventMap->PreloadEventsAsync();
+		resolver.EndPreloading();
 
 		InitializeRumbleEffects();
 		UpdateRichPresence();
@@ -478,11 +492,28 @@ namespace Jazz2
 		_tileMap->SetOwner(this);
 		_tileMap->setParent(_rootNode.get());
 
+		_actorsNode = std::make_unique<Rendering::ActorCullingNode>();
+		_actorsNode->setParent(_rootNode.get());
+
 		_eventMap = std::move(descriptor.EventMap);
 		_eventMap->SetLevelHandler(this);
 
+		// Most actors are spawned from events, so their count decides which broad-phase is faster in this level. Below
+		// SpatialHashMinEventCount events, the tree was as fast or faster in a synthetic benchmark, so the spatial hash
+		// is used only in more populated levels. Level exits are remembered for PrefetchNextLevel().
+		std::int32_t eventCount = 0;
+		_eventMap->ForEachEvent([this, &eventCount](Events::EventMap::EventTile& e, std::int32_t x, std::int32_t y) {
+			eventCount++;
+			if (e.Event == EventType::AreaEndOfLevel) {
+				_levelExitTiles.emplace_back(x, y);
+			}
+			return true;
+		});
+		_collisions.SetType(eventCount >= SpatialHashMinEventCount ? Collisions::BroadPhaseType::SpatialHash : Collisions::BroadPhaseType::DynamicTree);
+
 		Vector2i levelBounds = _tileMap->GetLevelBounds();
 		_levelBounds = Recti(0, 0, levelBounds.X, levelBounds.Y);
+		_actorsNode->SetLevelBounds(levelBounds);
 		_viewBoundsTarget = _levelBounds.As<float>();
 
 		_defaultAmbientLight = descriptor.AmbientColor;
@@ -496,7 +527,8 @@ namespace Jazz2
 
 #if defined(WITH_AUDIO)
 		if (!_musicCurrentPath.empty()) {
-			_music = ContentResolver::Get().GetMusic(_musicCurrentPath);
+			// The stream is usually opened already, while the tile sets of the level were decoded
+			_music = (descriptor.Music != nullptr ? std::move(descriptor.Music) : ContentResolver::Get().GetMusic(_musicCurrentPath));
 			if (_music != nullptr) {
 				_music->setLooping(true);
 				_music->setGain(PreferencesCache::MasterVolume * PreferencesCache::MusicVolume);
@@ -625,14 +657,7 @@ namespace Jazz2
 			}
 		}
 
-		auto it = _playingSounds.begin();
-		while (it != _playingSounds.end()) {
-			if ((*it)->isStopped()) {
-				it = _playingSounds.eraseUnordered(it);
-				continue;
-			}
-			++it;
-		}
+		UpdateSfxVoices(timeMult);
 #endif
 
 		if (!IsPausable() || _pauseMenu == nullptr) {
@@ -644,6 +669,10 @@ namespace Jazz2
 			ProcessEvents(timeMult);
 			ProcessWeather(timeMult);
 
+			if (_nextLevelType == ExitType::None && IsLocalSession()) {
+				PrefetchNextLevel();
+			}
+
 			// Active Boss
 			if (_activeBoss != nullptr && _activeBoss->GetHealth() <= 0) {
 				_activeBoss = nullptr;
@@ -690,8 +719,8 @@ namespace Jazz2
 						audioDevice.updateListener(Vector3f::Zero, Vector3f::Zero);
 
 						// All audio players must be updated to the nearest listener
-						for (auto& current : _playingSounds) {
-							if (auto* currentForSplitscreen = runtime_cast<AudioBufferPlayerForSplitscreen>(current.get())) {
+						for (auto& voice : _sfxVoices) {
+							if (auto* currentForSplitscreen = runtime_cast<AudioBufferPlayerForSplitscreen>(voice.Player.get())) {
 								currentForSplitscreen->updatePosition();
 							}
 						}
@@ -735,6 +764,13 @@ namespace Jazz2
 		TracyPlot("Actors", static_cast<std::int64_t>(_actors.size()));
 	}
 
+	void LevelHandler::OnInterpolate(float alpha)
+	{
+		for (auto& viewport : _assignedViewports) {
+			viewport->InterpolateCamera(alpha);
+		}
+	}
+
 	void LevelHandler::OnInitializeViewport(std::int32_t width, std::int32_t height)
 	{
 		ZoneScopedC(0x4876AF);
@@ -926,7 +962,8 @@ namespace Jazz2
 
 	void LevelHandler::AddActor(std::shared_ptr<Actors::ActorBase> actor)
 	{
-		actor->SetParent(_rootNode.get());
+		actor->SetParent(_actorsNode.get());
+		_actorsNode->AddActor(actor.get());
 
 		if (!actor->GetState(Actors::ActorState::ForceDisableCollisions)) {
 			actor->UpdateAABB();
@@ -936,16 +973,17 @@ namespace Jazz2
 		_actors.push_back(std::move(actor));
 	}
 
-	std::shared_ptr<AudioBufferPlayer> LevelHandler::PlaySfx(Actors::ActorBase* self, StringView identifier, AudioBuffer* buffer, const Vector3f& pos, bool sourceRelative, float gain, float pitch)
+	std::shared_ptr<AudioBufferPlayer> LevelHandler::PlaySfx(Actors::ActorBase* self, StringView identifier, AudioBuffer* buffer, const Vector3f& pos, bool sourceRelative, float gain, float pitch, std::int32_t priority)
 	{
 #if defined(WITH_AUDIO)
 		if (buffer != nullptr) {
-			auto& player = _playingSounds.emplace_back(_assignedViewports.size() > 1
-				? std::make_shared<AudioBufferPlayerForSplitscreen>(buffer, _assignedViewports)
-				: std::make_shared<AudioBufferPlayer>(buffer));
-			player->setPosition(Vector3f(pos.X, pos.Y, 100.0f));
+			SfxVoice* voice = AcquireSfxVoice(buffer, Vector3f(pos.X, pos.Y, 100.0f), sourceRelative, priority);
+			if (voice == nullptr) {
+				return nullptr;
+			}
+
+			auto& player = voice->Player;
 			player->setGain(gain * PreferencesCache::MasterVolume * PreferencesCache::SfxVolume);
-			player->setSourceRelative(sourceRelative);
 
 			if (pos.Y >= _waterLevel) {
 				player->setLowPass(0.05f);
@@ -954,7 +992,7 @@ namespace Jazz2
 				player->setPitch(pitch);
 			}
 
-			player->play();
+			StartSfxVoice(*voice);
 			return player;
 		}
 #endif
@@ -964,30 +1002,221 @@ namespace Jazz2
 	std::shared_ptr<AudioBufferPlayer> LevelHandler::PlayCommonSfx(StringView identifier, const Vector3f& pos, float gain, float pitch)
 	{
 #if defined(WITH_AUDIO)
-		auto it = _commonResources->Sounds.find(String::nullTerminatedView(identifier));
-		if (it != _commonResources->Sounds.end() && !it->second.Buffers.empty()) {
-			std::int32_t idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (std::int32_t)it->second.Buffers.size()) : 0);
-			auto* buffer = &it->second.Buffers[idx]->Buffer;
-			auto& player = _playingSounds.emplace_back(_assignedViewports.size() > 1
-				? std::make_shared<AudioBufferPlayerForSplitscreen>(buffer, _assignedViewports)
-				: std::make_shared<AudioBufferPlayer>(buffer));
-			player->setPosition(Vector3f(pos.X, pos.Y, 100.0f));
-			player->setGain(gain * PreferencesCache::MasterVolume * PreferencesCache::SfxVolume);
+		auto* resource = _commonResources->GetSound(identifier);
+		if (resource != nullptr && !resource->Buffers.empty()) {
+			return LevelHandler::PlaySfx(nullptr, identifier, resource->PickBuffer(), pos, false, gain, pitch, resource->Priority);
+		}
+#endif
+		return nullptr;
+	}
 
-			if (pos.Y >= _waterLevel) {
-				player->setLowPass(0.05f);
-				player->setPitch(pitch * 0.7f);
+#if defined(WITH_AUDIO)
+	LevelHandler::SfxVoice* LevelHandler::AcquireSfxVoice(AudioBuffer* buffer, const Vector3f& pos, bool sourceRelative, std::int32_t priority)
+	{
+		float score = (float)priority * SfxPriorityDistance;
+		if (!sourceRelative) {
+			score -= GetSfxDistance(pos);
+		}
+
+		// Take a free voice, or the least audible one that isn't referenced outside of the pool
+		SfxVoice* voice = nullptr;
+		SfxVoice* weakest = nullptr;
+		SfxVoice* weakestHeld = nullptr;
+		for (auto& current : _sfxVoices) {
+			if (current.Player.use_count() > 1) {
+				if (weakestHeld == nullptr || weakestHeld->Score > current.Score) {
+					weakestHeld = &current;
+				}
+				continue;
+			}
+			if (!current.Player->isPlaying() && !current.Player->isPaused()) {
+				voice = &current;
+				break;
+			}
+			if (weakest == nullptr || weakest->Score > current.Score) {
+				weakest = &current;
+			}
+		}
+
+		if (voice == nullptr) {
+			if (weakest == nullptr) {
+				// All voices are held by their callers and the pool doesn't grow, so the least audible one is stolen.
+				// Its caller keeps a stopped player of its own, the voice gets a new one.
+				if (weakestHeld == nullptr || weakestHeld->Score >= score) {
+					return nullptr;
+				}
+				weakestHeld->Player->stop();
+				weakestHeld->Player = std::make_shared<AudioBufferPlayerForSplitscreen>(nullptr, _assignedViewports);
+				voice = weakestHeld;
+			} else if (weakest->Score < score) {
+				voice = weakest;
 			} else {
-				player->setPitch(pitch);
+				// The new sound is the least audible of all, drop it
+				return nullptr;
+			}
+		}
+
+		auto& player = voice->Player;
+		// Stops the previous sound, if any, and resets everything the previous use of the voice could change
+		player->setAudioBuffer(buffer);
+		player->setPosition(pos);
+		player->setSourceRelative(sourceRelative);
+		player->setAs2D(false);
+		player->setLooping(false);
+		player->setLowPass(1.0f);
+		player->setPitch(1.0f);
+
+		voice->Priority = priority;
+		voice->Score = score;
+		voice->VirtualTime = 0.0f;
+		return voice;
+	}
+
+	void LevelHandler::StartSfxVoice(SfxVoice& voice)
+	{
+		auto& player = voice.Player;
+		if (IsSfxAudible(*player)) {
+			IAudioDevice& device = theServiceLocator().GetAudioDevice();
+			if ((std::int32_t)device.numPlayers() >= GetSfxSourceBudget()) {
+				// Take the source of the least audible voice, if it's less audible than the new one
+				SfxVoice* weakest = nullptr;
+				for (auto& current : _sfxVoices) {
+					if (current.Player->isPlaying() && !current.Player->isVirtual() && (weakest == nullptr || weakest->Score > current.Score)) {
+						weakest = &current;
+					}
+				}
+				if (weakest != nullptr && weakest->Score < voice.Score) {
+					weakest->VirtualTime = (float)weakest->Player->virtualize() / (float)std::max(weakest->Player->frequency(), 1);
+				}
 			}
 
-			player->play();
-			return player;
-		}	
-#endif
-		return nullptr;
+			if ((std::int32_t)device.numPlayers() < GetSfxSourceBudget()) {
+				player->play();
+			}
+		}
+
+		if (!player->isPlaying()) {
+			player->playVirtual();
+		}
 	}
 
+	void LevelHandler::UpdateSfxVoices(float timeMult)
+	{
+		float elapsedSeconds = timeMult * FrameTimer::SecondsPerFrame;
+
+		SfxVoice* strongestVirtual[SfxMaxSwapsPerFrame] = {};
+		std::int32_t strongestVirtualCount = 0;
+
+		for (auto& voice : _sfxVoices) {
+			auto& player = *voice.Player;
+			if (!player.isPlaying()) {
+				continue;
+			}
+
+			bool isAudible = IsSfxAudible(player);
+			voice.Score = GetSfxScore(player, voice.Priority);
+
+			if (!player.isVirtual()) {
+				// Sounds that moved out of range release their source, so they don't keep it from the others
+				if (!isAudible) {
+					voice.VirtualTime = (float)player.virtualize() / (float)std::max(player.frequency(), 1);
+				}
+				continue;
+			}
+
+			voice.VirtualTime += elapsedSeconds * player.pitch();
+			float duration = player.duration();
+			if (voice.VirtualTime >= duration) {
+				if (!player.isLooping() || duration <= 0.0f) {
+					player.stop();
+					continue;
+				}
+				voice.VirtualTime = std::fmod(voice.VirtualTime, duration);
+			}
+
+			if (isAudible) {
+				// Keep the most audible virtual voices sorted by descending score
+				std::int32_t i;
+				if (strongestVirtualCount < SfxMaxSwapsPerFrame) {
+					i = strongestVirtualCount++;
+				} else if (strongestVirtual[SfxMaxSwapsPerFrame - 1]->Score < voice.Score) {
+					i = SfxMaxSwapsPerFrame - 1;
+				} else {
+					continue;
+				}
+				while (i > 0 && strongestVirtual[i - 1]->Score < voice.Score) {
+					strongestVirtual[i] = strongestVirtual[i - 1];
+					i--;
+				}
+				strongestVirtual[i] = &voice;
+			}
+		}
+
+		if (strongestVirtualCount == 0) {
+			return;
+		}
+
+		// Give sources to the most audible virtual voices, taking them from less audible ones when there is none free
+		IAudioDevice& device = theServiceLocator().GetAudioDevice();
+		std::int32_t budget = GetSfxSourceBudget();
+		for (std::int32_t i = 0; i < strongestVirtualCount; i++) {
+			SfxVoice& voice = *strongestVirtual[i];
+			if ((std::int32_t)device.numPlayers() >= budget) {
+				SfxVoice* weakest = nullptr;
+				for (auto& current : _sfxVoices) {
+					if (current.Player->isPlaying() && !current.Player->isVirtual() && (weakest == nullptr || weakest->Score > current.Score)) {
+						weakest = &current;
+					}
+				}
+				// Require a margin, so two voices of similar score don't keep swapping the source every frame
+				if (weakest == nullptr || weakest->Score + SfxPriorityDistance > voice.Score) {
+					break;
+				}
+				weakest->VirtualTime = (float)weakest->Player->virtualize() / (float)std::max(weakest->Player->frequency(), 1);
+			}
+
+			std::int32_t sampleOffset = (std::int32_t)(voice.VirtualTime * voice.Player->frequency());
+			if (!voice.Player->devirtualize(sampleOffset)) {
+				break;
+			}
+		}
+	}
+
+	float LevelHandler::GetSfxScore(const AudioBufferPlayer& player, std::int32_t priority) const
+	{
+		float score = (float)priority * SfxPriorityDistance;
+		if (!player.isSourceRelative()) {
+			score -= GetSfxDistance(player.position());
+		}
+		return score;
+	}
+
+	float LevelHandler::GetSfxDistance(const Vector3f& pos) const
+	{
+		float minDistance = FLT_MAX;
+		for (auto& viewport : _assignedViewports) {
+			float distance = (pos.ToVector2() - viewport->_cameraPos).Length();
+			if (minDistance > distance) {
+				minDistance = distance;
+			}
+		}
+		return minDistance;
+	}
+
+	bool LevelHandler::IsSfxAudible(const AudioBufferPlayer& player) const
+	{
+		// Sources beyond the maximum distance of the device are attenuated to silence
+		constexpr float MaxAudibleDistance = IAudioDevice::MaxDistance / IAudioDevice::LengthToPhysical;
+		return (player.isSourceRelative() || player.isAs2D() || GetSfxDistance(player.position()) <= MaxAudibleDistance);
+	}
+
+	std::int32_t LevelHandler::GetSfxSourceBudget() const
+	{
+		IAudioDevice& device = theServiceLocator().GetAudioDevice();
+		return (std::int32_t)device.maxNumPlayers() - SfxReservedSources;
+	}
+#endif
+
 	void LevelHandler::WarpCameraToTarget(Actors::ActorBase* actor, bool fast)
 	{
 		for (auto& viewport : _assignedViewports) {
@@ -1371,14 +1600,14 @@ namespace Jazz2
 			return;
 		}
 
-		auto it = _commonResources->Sounds.find(String::nullTerminatedView("SugarRush"_s));
-		if (it != _commonResources->Sounds.end()) {
-			std::int32_t idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (std::int32_t)it->second.Buffers.size()) : 0);
-			_sugarRushMusic = _playingSounds.emplace_back(std::make_shared<AudioBufferPlayer>(&it->second.Buffers[idx]->Buffer));
-			_sugarRushMusic->setPosition(Vector3f(0.0f, 0.0f, 100.0f));
+		auto* resource = _commonResources->GetSound("SugarRush"_s);
+		SfxVoice* voice = (resource != nullptr && !resource->Buffers.empty()
+			? AcquireSfxVoice(resource->PickBuffer(), Vector3f(0.0f, 0.0f, 100.0f), true, SfxMusicPriority)
+			: nullptr);
+		if (voice != nullptr) {
+			_sugarRushMusic = voice->Player;
 			_sugarRushMusic->setGain(PreferencesCache::MasterVolume * PreferencesCache::MusicVolume);
-			_sugarRushMusic->setSourceRelative(true);
-			_sugarRushMusic->play();
+			StartSfxVoice(*voice);
 
 			if (_music != nullptr) {
 				_music->pause();
@@ -1677,22 +1906,8 @@ namespace Jazz2
 
 	void LevelHandler::PrepareNextLevelInitialization(LevelInitialization& levelInit)
 	{
-		StringView realNextLevel;
-		if (!_nextLevelName.empty()) {
-			realNextLevel = _nextLevelName;
-		} else {
-			realNextLevel = ((_nextLevelType & ExitType::TypeMask) == ExitType::Bonus ? _defaultSecretLevel : _defaultNextLevel);
-		}
-
 		auto p = _levelName.partition('/');
-		if (!realNextLevel.empty()) {
-			if (realNextLevel.contains('/')) {
-				levelInit.LevelName = realNextLevel;
-			} else {
-				levelInit.LevelName = p[0] + '/' + realNextLevel;
-			}
-		}
-
+		levelInit.LevelName = GetNextLevelName(_nextLevelType, _nextLevelName);
 		levelInit.Difficulty = _difficulty;
 		levelInit.IsReforged = _isReforged;
 		levelInit.CheatsUsed = _cheatsUsed;
@@ -1706,6 +1921,86 @@ namespace Jazz2
 		}
 	}
 
+	String LevelHandler::GetNextLevelName(ExitType exitType, StringView nextLevel) const
+	{
+		StringView realNextLevel;
+		if (!nextLevel.empty()) {
+			realNextLevel = nextLevel;
+		} else {
+			realNextLevel = ((exitType & ExitType::TypeMask) == ExitType::Bonus ? _defaultSecretLevel : _defaultNextLevel);
+		}
+
+		if (realNextLevel.empty()) {
+			return {};
+		}
+		if (realNextLevel.contains('/')) {
+			return realNextLevel;
+		}
+		auto p = _levelName.partition('/');
+		return p[0] + '/' + realNextLevel;
+	}
+
+	void LevelHandler::PrefetchNextLevel()
+	{
+		ExitType exitType = ExitType::None;
+		std::uint8_t textId = 0, textOffset = 0;
+		bool isNearExit = false;
+
+		if (_activeBoss != nullptr) {
+			// The level ends when the boss is defeated
+			exitType = ExitType::Boss;
+			isNearExit = true;
+		} else {
+			for (auto player : _players) {
+				Vector2f pos = player->GetPos();
+				std::int32_t tx = (std::int32_t)pos.X / TileSet::DefaultTileSize;
+				std::int32_t ty = (std::int32_t)pos.Y / TileSet::DefaultTileSize;
+
+				for (Vector2i exitTile : _levelExitTiles) {
+					if (std::abs(exitTile.X - tx) > PrefetchNextLevelTileRange || std::abs(exitTile.Y - ty) > PrefetchNextLevelTileRange) {
+						continue;
+					}
+
+					// The event could have been replaced in the meantime
+					const auto& tile = _eventMap->GetEventTile(exitTile.X, exitTile.Y);
+					if (tile.Event != EventType::AreaEndOfLevel) {
+						continue;
+					}
+
+					// ExitType, Fast, TextID, TextOffset, Coins (see Player::OnHandleAreaEvents())
+					exitType = (ExitType)tile.EventParams[0];
+					textId = tile.EventParams[2];
+					textOffset = tile.EventParams[3];
+					isNearExit = true;
+					break;
+				}
+
+				if (isNearExit) {
+					break;
+				}
+			}
+		}
+
+		if (!isNearExit) {
+			return;
+		}
+
+		// The name is resolved only once per exit, not on every tick spent near it
+		const std::uint32_t exitKey = (std::uint32_t(exitType) << 16) | (std::uint32_t(textId) << 8) | textOffset;
+		if (exitKey == _prefetchedNextLevelExit) {
+			return;
+		}
+
+		StringView nextLevel;
+		if (textId != 0) {
+			nextLevel = GetLevelText(textId, textOffset, '|');
+		}
+		String levelName = GetNextLevelName(exitType, nextLevel);
+		if (levelName.empty() || ContentResolver::Get().PrefetchLevelAsync(levelName)) {
+			_prefetchedNextLevelExit = exitKey;
+		}
+	}
+
 	Recti LevelHandler::GetPlayerViewportBounds(std::int32_t w, std::int32_t h, std::int32_t index)
 	{
 		std::int32_t count = (std::int32_t)_assignedViewports.size();
@@ -1855,6 +2150,7 @@ namespace Jazz2
 			Actors::ActorBase* actor = it->get();
 			if (actor->GetState(Actors::ActorState::IsDestroyed)) {
 				BeforeActorDestroyed(actor);
+				_actorsNode->RemoveActor(actor);
 				if (actor->_collisionProxyID != Collisions::NullNode) {
 					_collisions.DestroyProxy(actor->_collisionProxyID);
 					actor->_collisionProxyID = Collisions::NullNode;
@@ -1862,7 +2158,11 @@ namespace Jazz2
 				it = _actors.eraseUnordered(it);
 				continue;
 			}
-			
+
+			// Every actor is checked, not only dirty ones, because actors without collisions can move without setting
+			// the flag. It's a few integer operations unless the actor crossed to another cell.
+			_actorsNode->UpdateActor(actor);
+
 			if (actor->GetState(Actors::ActorState::IsDirty)) {
 				if (actor->_collisionProxyID == Collisions::NullNode) {
 					continue;
@@ -1899,8 +2199,8 @@ namespace Jazz2
 		_assignedViewports.push_back(std::make_unique<Rendering::PlayerViewport>(this, player));
 
 #if defined(WITH_AUDIO)
-		for (auto& current : _playingSounds) {
-			if (auto* currentForSplitscreen = runtime_cast<AudioBufferPlayerForSplitscreen>(current.get())) {
+		for (auto& voice : _sfxVoices) {
+			if (auto* currentForSplitscreen = runtime_cast<AudioBufferPlayerForSplitscreen>(voice.Player.get())) {
 				currentForSplitscreen->updateViewports(_assignedViewports);
 			}
 		}
@@ -1920,8 +2220,8 @@ namespace Jazz2
 		
 #if defined(WITH_AUDIO)
 		if (success) {
-			for (auto& current : _playingSounds) {
-				if (auto* currentForSplitscreen = runtime_cast<AudioBufferPlayerForSplitscreen>(current.get())) {
+			for (auto& voice : _sfxVoices) {
+				if (auto* currentForSplitscreen = runtime_cast<AudioBufferPlayerForSplitscreen>(voice.Player.get())) {
 					currentForSplitscreen->updateViewports(_assignedViewports);
 				}
 			}
@@ -2367,9 +2667,9 @@ namespace Jazz2
 			_music->setLowPass(0.1f);
 		}
 		if (IsPausable()) {
-			for (auto& sound : _playingSounds) {
-				if (sound->isPlaying()) {
-					sound->pause();
+			for (auto& voice : _sfxVoices) {
+				if (voice.Player->isPlaying()) {
+					voice.Player->pause();
 				}
 			}
 			// If Sugar Rush music is playing, pause it and play normal music instead
@@ -2393,9 +2693,9 @@ namespace Jazz2
 			_music->pause();
 		}
 		// Resume all SFX
-		for (auto& sound : _playingSounds) {
-			if (sound->isPaused()) {
-				sound->play();
+		for (auto& voice : _sfxVoices) {
+			if (voice.Player->isPaused()) {
+				voice.Player->play();
 			}
 		}
 		if (_music != nullptr) {
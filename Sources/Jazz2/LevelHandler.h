@@ -10,9 +10,10 @@
 #include "Events/EventSpawner.h"
 #include "Tiles/ITileMapOwner.h"
 #include "Tiles/TileMap.h"
-#include "Collisions/DynamicTreeBroadPhase.h"
+#include "Collisions/BroadPhase.h"
 #include "Input/RumbleProcessor.h"
 #include "Input/ControlScheme.h"
+#include "Rendering/ActorCullingNode.h"
 #include "Rendering/UpscaleRenderPass.h"
 
 #include "../nCine/Graphics/Shader.h"
@@ -93,6 +94,10 @@ namespace Jazz2
 		static constexpr std::int32_t DefaultHeight = 405;
 		/** @brief Range of tile activation */
 		static constexpr std::int32_t ActivateTileRange = 26;
+		/** @brief Minimum number of events in a level to use the spatial hash as collision broad-phase */
+		static constexpr std::int32_t SpatialHashMinEventCount = 200;
+		/** @brief Distance in tiles from a level exit at which the next level starts to be read in the background */
+		static constexpr std::int32_t PrefetchNextLevelTileRange = 64;
 
 		/** @} */
 
@@ -151,6 +156,7 @@ namespace Jazz2
 
 		void OnBeginFrame() override;
 		void OnEndFrame() override;
+		void OnInterpolate(float alpha) override;
 		void OnInitializeViewport(std::int32_t width, std::int32_t height) override;
 		/** @brief Called when a console command is entered */
 		virtual bool OnConsoleCommand(StringView line);
@@ -162,7 +168,7 @@ namespace Jazz2
 
 		void AddActor(std::shared_ptr<Actors::ActorBase> actor) override;
 
-		std::shared_ptr<AudioBufferPlayer> PlaySfx(Actors::ActorBase* self, StringView identifier, AudioBuffer* buffer, const Vector3f& pos, bool sourceRelative, float gain, float pitch) override;
+		std::shared_ptr<AudioBufferPlayer> PlaySfx(Actors::ActorBase* self, StringView identifier, AudioBuffer* buffer, const Vector3f& pos, bool sourceRelative, float gain, float pitch, std::int32_t priority = SoundResource::DefaultPriority) override;
 		std::shared_ptr<AudioBufferPlayer> PlayCommonSfx(StringView identifier, const Vector3f& pos, float gain = 1.0f, float pitch = 1.0f) override;
 		void WarpCameraToTarget(Actors::ActorBase* actor, bool fast = false) override;
 		bool IsPositionEmpty(Actors::ActorBase* self, const AABBf& aabb, Tiles::TileCollisionParams& params, Actors::ActorBase** collider) override;
@@ -231,6 +237,37 @@ namespace Jazz2
 			PlayerInput();
 		};
 
+#if defined(WITH_AUDIO)
+		/**
+			@brief Voice of the sound effect pool
+
+			Players are allocated once and reused for the whole level. A voice is free when its player is no longer
+			playing and nobody outside of the pool holds a reference to it. Only the most audible voices get one of
+			the audio sources of the device, the rest play as virtual voices until a source frees up.
+		*/
+		struct SfxVoice {
+			/** @brief Player of the voice */
+			std::shared_ptr<AudioBufferPlayer> Player;
+			/** @brief Priority of the sound, see @ref SoundResource::Priority */
+			std::int32_t Priority;
+			/** @brief Audibility score from the priority and the distance to the nearest viewport */
+			float Score;
+			/** @brief Playback position in seconds, tracked while the voice is virtual */
+			float VirtualTime;
+		};
+
+		/** @brief Number of voices, the pool never grows beyond it */
+		static constexpr std::int32_t SfxVoiceCount = 64;
+		/** @brief Number of audio sources left for music and UI sounds */
+		static constexpr std::int32_t SfxReservedSources = 4;
+		/** @brief Distance in pixels that one step of priority outweighs */
+		static constexpr float SfxPriorityDistance = 64.0f;
+		/** @brief Priority of sounds that should never lose their audio source */
+		static constexpr std::int32_t SfxMusicPriority = 1000;
+		/** @brief Maximum number of audio sources moved between voices per frame */
+		static constexpr std::int32_t SfxMaxSwapsPerFrame = 4;
+#endif
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 		// Hide these members from documentation before refactoring
 		IRootController* _root;
@@ -258,6 +295,8 @@ namespace Jazz2
 		bool _hudOverlayActive = false;
 
 		std::unique_ptr<SceneNode> _rootNode;
+		// Parent of all actors, each viewport visits only the actors near it
+		std::unique_ptr<Rendering::ActorCullingNode> _actorsNode;
 		std::unique_ptr<Texture> _noiseTexture;
 		SmallVector<std::unique_ptr<Rendering::PlayerViewport>, 0> _assignedViewports;
 
@@ -277,6 +316,9 @@ namespace Jazz2
 		ExitType _nextLevelType;
 		float _nextLevelTime;
 		String _nextLevelName;
+		// Exit type and text of the exit the next level was prefetched for, see PrefetchNextLevel()
+		std::uint32_t _prefetchedNextLevelExit;
+		SmallVector<Vector2i, 0> _levelExitTiles;
 		String _musicDefaultPath, _musicCurrentPath;
 		Recti _levelBounds;
 		bool _isReforged, _cheatsUsed;
@@ -286,7 +328,7 @@ namespace Jazz2
 		Events::EventSpawner _eventSpawner;
 		std::unique_ptr<Events::EventMap> _eventMap;
 		std::unique_ptr<Tiles::TileMap> _tileMap;
-		Collisions::DynamicTreeBroadPhase _collisions;
+		Collisions::BroadPhase _collisions;
 
 		Vector2i _viewSize;
 		Rectf _viewBoundsTarget;
@@ -297,7 +339,7 @@ namespace Jazz2
 		Vector4f _defaultAmbientLight;
 #if defined(WITH_AUDIO)
 		std::unique_ptr<AudioStreamPlayer> _music;
-		SmallVector<std::shared_ptr<AudioBufferPlayer>> _playingSounds;
+		SmallVector<SfxVoice, 0> _sfxVoices;
 		std::shared_ptr<AudioBufferPlayer> _sugarRushMusic;
 #endif
 		Metadata* _commonResources;
@@ -341,6 +383,10 @@ namespace Jazz2
 		virtual void ProcessQueuedNextLevel();
 		/** @brief Prepares @ref LevelInitialization for transition to the next level */
 		virtual void PrepareNextLevelInitialization(LevelInitialization& levelInit);
+		/** @brief Returns full name of the level that follows the specified exit, `nextLevel` overrides the default one */
+		String GetNextLevelName(ExitType exitType, StringView nextLevel) const;
+		/** @brief Starts reading the next level in the background when a player approaches an exit */
+		void PrefetchNextLevel();
 
 		/** @brief Returns player viewport bounds */
 		Recti GetPlayerViewportBounds(std::int32_t w, std::int32_t h, std::int32_t index);
@@ -394,6 +440,16 @@ namespace Jazz2
 #endif
 
 	private:
+#if defined(WITH_AUDIO)
+		SfxVoice* AcquireSfxVoice(AudioBuffer* buffer, const Vector3f& pos, bool sourceRelative, std::int32_t priority);
+		void StartSfxVoice(SfxVoice& voice);
+		void UpdateSfxVoices(float timeMult);
+		float GetSfxScore(const AudioBufferPlayer& player, std::int32_t priority) const;
+		float GetSfxDistance(const Vector3f& pos) const;
+		bool IsSfxAudible(const AudioBufferPlayer& player) const;
+		std::int32_t GetSfxSourceBudget() const;
+#endif
+
 		bool TryInvokeCheat(StringView line);
 
 		void CheatKill(ArrayView<Actors::Player* const> targets);
@@ -18,6 +18,8 @@
 
 #include "../../nCine/Application.h"
 #include "../../nCine/I18n.h"
+#include "../../nCine/Base/FrameArena.h"
+#include "../../nCine/Base/FrameProfiler.h"
 #include "../../nCine/Base/Random.h"
 #include "../../nCine/Primitives/Half.h"
 
@@ -51,10 +53,10 @@
 #include <Containers/StringConcatenable.h>
 #include <Containers/StringUtils.h>
 #include <IO/MemoryStream.h>
-#include <IO/Compression/DeflateStream.h>
+#include <IO/SpanReader.h>
+#include <IO/SpanWriter.h>
 #include <Utf8.h>
 
-using namespace Death::IO::Compression;
 using namespace nCine;
 using namespace Jazz2::Actors::Multiplayer;
 using namespace Jazz2::Multiplayer::GameModes;
@@ -83,7 +85,7 @@ namespace Jazz2::Multiplayer
 		}
 	}
 
-	static PlayerCarryOver ReadCarryOver(MemoryStream& packet, PlayerType type)
+	static PlayerCarryOver ReadCarryOver(SpanReader& packet, PlayerType type)
 	{
 		PlayerCarryOver c;
 		c.Type = type;
@@ -120,7 +122,7 @@ namespace Jazz2::Multiplayer
 	MpLevelHandler::MpLevelHandler(IRootController* root, NetworkManager* networkManager, MpLevelHandler::LevelState levelState, bool enableLedgeClimb)
 		: LevelHandler(root), _networkManager(networkManager), _updateTimeLeft(1.0f), _gameTimeLeft(0.0f),
 			_levelState(LevelState::InitialUpdatePending), _forceResyncPending(true), _enableSpawning(true), _enqueuedPlaylistChange(false), _lastSpawnedActorId(-1), _waitingForPlayerCount(0),
-			_lastUpdated(0), _seqNumWarped(0), _suppressRemoting(false), _ignorePackets(false), _changingCharacterInLobby(false), _enableLedgeClimb(enableLedgeClimb),
+			_lastUpdated(0), _actorSnapshotsValid(false), _actorSnapshotsResyncRequested(0), _seqNumWarped(0), _predictedStates{}, _predictedStateIndex(0), _suppressRemoting(false), _ignorePackets(false), _changingCharacterInLobby(false), _enableLedgeClimb(enableLedgeClimb),
 			_controllableExternal(true), _autoWeightTreasure(false), _activePoll(VoteType::None), _activePollTimeLeft(0.0f), _recalcPositionInRoundTime(0.0f),
 			_overtimeTimeLeft(0.0f), _overtimeStarted(false), _raceFinishedCount(0), _roundStartedFrames(0.0f),
 			_limitCameraLeft(0), _limitCameraWidth(0), _totalTreasureCount(0), _raceCheckpointsOrdered(false), _ctfCaptures{}, _teamKills{}, _scoreboardSyncTime(0.0f),
@@ -375,7 +377,7 @@ namespace Jazz2::Multiplayer
 		LevelHandler::OnEndFrame();
 
 		float timeMult = theApplication().GetTimeMult();
-		std::uint32_t frameCount = theApplication().GetFrameCount();
+		std::uint32_t frameCount = theApplication().GetUpdateCount();
 		auto& serverConfig = _networkManager->GetServerConfiguration();
 
 		if (_isServer) {
@@ -758,16 +760,20 @@ namespace Jazz2::Multiplayer
 					std::uint32_t playerCount = GetNonSpectatePlayerCount();
 					std::uint32_t actorCount = playerCount + (std::uint32_t)_remotingActors.size();
 
-					MemoryStream packet(8 + actorCount * 24);
-					packet.WriteVariableUint32(_lastUpdated);
-					packet.WriteVariableUint64((std::uint64_t)_elapsedFrames);
-					packet.WriteVariableUint32((actorCount << 1) | (_forceResyncPending ? 1 : 0));
+					// Snapshots of all actors are taken once, the differences for most peers and the full update for peers
+					// that requested a re-sync are both written from them
+					ArrayView<std::uint32_t> actorIds = FrameArena::AllocateArray<std::uint32_t>(actorCount);
+					ArrayView<ActorSnapshot> snapshots = FrameArena::AllocateArray<ActorSnapshot>(actorCount);
+					ArrayView<ActorSnapshot*> baselines = FrameArena::AllocateArray<ActorSnapshot*>(actorCount);
+					ArrayView<bool> hasBaseline = FrameArena::AllocateArray<bool>(actorCount);
+					std::uint32_t snapshotCount = 0;
 
 					for (Actors::Player* player : _players) {
 						auto* mpPlayer = static_cast<PlayerOnServer*>(player);
 
 						// Skip spectate players - don't send their position to other clients
 						if (mpPlayer->_playerType == PlayerType::Spectate) {
+							mpPlayer->_hasLastSnapshot = false;
 							continue;
 						}
 
@@ -795,131 +801,96 @@ namespace Jazz2::Multiplayer
 							// Local players
 							pos = player->_pos;
 						}*/
-						Vector2f pos = player->_pos;
-
-						packet.WriteVariableUint32(player->_playerIndex);
-
-						std::uint8_t flags = 0x01 | 0x02; // PositionChanged | AnimationChanged
-						if (player->_renderer.isDrawEnabled()) {
-							flags |= 0x04;
-						}
-						if (player->_renderer.AnimPaused) {
-							flags |= 0x08;
-						}
-						if (player->_renderer.isFlippedX()) {
-							flags |= 0x10;
-						}
-						if (player->_renderer.isFlippedY()) {
-							flags |= 0x20;
+						ActorSnapshot snapshot = CreateActorSnapshot(player);
+						if (snapshot.RendererType == (std::uint8_t)Actors::ActorRendererType::Outline) {
+							// Outline renderer type is local-only
+							snapshot.RendererType = (std::uint8_t)Actors::ActorRendererType::Default;
 						}
 						if (mpPlayer->_justWarped) {
 							mpPlayer->_justWarped = false;
-							flags |= 0x40;
+							snapshot.Flags |= 0x40;
 						}
-						packet.WriteValue<std::uint8_t>(flags);
-
-						packet.WriteValue<std::int32_t>((std::int32_t)(pos.X * 512.0f));
-						packet.WriteValue<std::int32_t>((std::int32_t)(pos.Y * 512.0f));
-						packet.WriteVariableUint32((std::uint32_t)(player->_currentTransition != nullptr ? player->_currentTransition->State : player->_currentAnimation->State));
-
-						float rotation = player->_renderer.rotation();
-						if (rotation < 0.0f) rotation += fRadAngle360;
-						packet.WriteValue<std::uint16_t>((std::uint16_t)(rotation * UINT16_MAX / fRadAngle360));
-						Vector2f scale = player->_renderer.scale();
-						packet.WriteValue<std::uint16_t>((std::uint16_t)Half{scale.X});
-						packet.WriteValue<std::uint16_t>((std::uint16_t)Half{scale.Y});
-						Actors::ActorRendererType rendererType = player->_renderer.GetRendererType();
-						if (rendererType == Actors::ActorRendererType::Outline) {
-							// Outline renderer type is local-only
-							rendererType = Actors::ActorRendererType::Default;
-						}
-						packet.WriteValue<std::uint8_t>((std::uint8_t)rendererType);
+						actorIds[snapshotCount] = player->_playerIndex;
+						snapshots[snapshotCount] = snapshot;
+						baselines[snapshotCount] = &mpPlayer->_lastSnapshot;
+						hasBaseline[snapshotCount] = mpPlayer->_hasLastSnapshot;
+						mpPlayer->_hasLastSnapshot = true;
+						snapshotCount++;
 					}
 
 					// TODO: Does this need to be locked?
 					{
 						std::unique_lock lock(_lock);
 						for (auto& [remotingActor, remotingActorInfo] : _remotingActors) {
-							packet.WriteVariableUint32(remotingActorInfo.ActorID);
-
-							std::int32_t newPosX = (std::int32_t)(remotingActor->_pos.X * 512.0f);
-							std::int32_t newPosY = (std::int32_t)(remotingActor->_pos.Y * 512.0f);
-							bool positionChanged = (_forceResyncPending || newPosX != remotingActorInfo.LastPosX || newPosY != remotingActorInfo.LastPosY);
-
-							std::uint32_t newAnimation = (std::uint32_t)(remotingActor->_currentTransition != nullptr ? remotingActor->_currentTransition->State : (remotingActor->_currentAnimation != nullptr ? remotingActor->_currentAnimation->State : AnimState::Idle));
-							float rotation = remotingActor->_renderer.rotation();
-							if (rotation < 0.0f) rotation += fRadAngle360;
-							std::uint16_t newRotation = (std::uint16_t)(rotation * UINT16_MAX / fRadAngle360);
-							Vector2f newScale = remotingActor->_renderer.scale();
-							std::uint16_t newScaleX = (std::uint16_t)Half{newScale.X};
-							std::uint16_t newScaleY = (std::uint16_t)Half{newScale.Y};
-							std::uint8_t newRendererType = (std::uint8_t)remotingActor->_renderer.GetRendererType();
-							bool animationChanged = (_forceResyncPending || newAnimation != remotingActorInfo.LastAnimation || newRotation != remotingActorInfo.LastRotation ||
-								newScaleX != remotingActorInfo.LastScaleX || newScaleY != remotingActorInfo.LastScaleY || newRendererType != remotingActorInfo.LastRendererType);
-
-							std::uint8_t flags = 0;
-							if (positionChanged) {
-								flags |= 0x01;
-							}
-							if (animationChanged) {
-								flags |= 0x02;
-							}
-							if (remotingActor->_renderer.isDrawEnabled()) {
-								flags |= 0x04;
-							}
-							if (remotingActor->_renderer.AnimPaused) {
-								flags |= 0x08;
-							}
-							if (remotingActor->_renderer.isFlippedX()) {
-								flags |= 0x10;
-							}
-							if (remotingActor->_renderer.isFlippedY()) {
-								flags |= 0x20;
-							}
-							packet.WriteValue<std::uint8_t>(flags);
-
-							if (positionChanged) {
-								packet.WriteValue<std::int32_t>(newPosX);
-								packet.WriteValue<std::int32_t>(newPosY);
-
-								remotingActorInfo.LastPosX = newPosX;
-								remotingActorInfo.LastPosY = newPosY;
-							}
-							if (animationChanged) {
-								packet.WriteVariableUint32(newAnimation);
-								packet.WriteValue<std::uint16_t>(newRotation);
-								packet.WriteValue<std::uint16_t>(newScaleX);
-								packet.WriteValue<std::uint16_t>(newScaleY);
-								packet.WriteValue<std::uint8_t>(newRendererType);
-
-								remotingActorInfo.LastAnimation = newAnimation;
-								remotingActorInfo.LastRotation = newRotation;
-								remotingActorInfo.LastScaleX = newScaleX;
-								remotingActorInfo.LastScaleY = newScaleY;
-								remotingActorInfo.LastRendererType = newRendererType;
-							}
+							actorIds[snapshotCount] = remotingActorInfo.ActorID;
+							snapshots[snapshotCount] = CreateActorSnapshot(remotingActor);
+							baselines[snapshotCount] = &remotingActorInfo.LastSnapshot;
+							hasBaseline[snapshotCount] = remotingActorInfo.HasSnapshot;
+							remotingActorInfo.HasSnapshot = true;
+							snapshotCount++;
 						}
 					}
 
-					MemoryStream packetCompressed(1024);
-					{
-						DeflateWriter dw(packetCompressed);
-						dw.Write(packet.GetBuffer(), packet.GetSize());
-					}
+					// Built in the frame arena instead of the heap every update. A header is at most three variable-length
+					// integers (20 bytes) and an actor at most ActorSnapshot::MaxEncodedSize bytes, so the packet can never
+					// outgrow the buffer it is written into.
+					auto buildPacket = [&](bool fullUpdate) {
+						constexpr std::size_t MaxHeaderSize = 20;
+						ArrayView<std::uint8_t> packetBuffer = FrameArena::AllocateArray<std::uint8_t>(MaxHeaderSize + snapshotCount * ActorSnapshot::MaxEncodedSize);
+						MemoryStream packetHeader(packetBuffer.data(), MaxHeaderSize);
+						packetHeader.WriteVariableUint32(_lastUpdated);
+						packetHeader.WriteVariableUint64((std::uint64_t)_elapsedFrames);
+						packetHeader.WriteVariableUint32((snapshotCount << 1) | (fullUpdate ? 1 : 0));
+
+						const std::size_t headerSize = (std::size_t)packetHeader.GetPosition();
+						BitWriter packet(packetBuffer.data() + headerSize, packetBuffer.size() - headerSize);
+						for (std::uint32_t i = 0; i < snapshotCount; i++) {
+							// Writing the full update after the differences leaves the baseline at the same snapshot
+							WriteActorSnapshot(packet, actorIds[i], snapshots[i], *baselines[i], fullUpdate || !hasBaseline[i]);
+						}
+
+						const std::size_t packetSize = headerSize + packet.Flush();
+						DEATH_DEBUG_ASSERT(packetSize <= packetBuffer.size(), "Update packet exceeded its worst-case size", packetBuffer);
+						return FrameArena::Shrink(packetBuffer, packetSize);
+					};
+
+					// Actors are bit-packed, each carrying only the fields that changed since the previous update and
+					// its position as a difference, which leaves nothing worth compressing. All peers share the same
+					// baseline, so a client that missed an update can't apply the differences anymore and requests
+					// a full update, which is then sent only to that peer, see HandleServerPacketUpdateAllActors().
+					ArrayView<std::uint8_t> packetBuffer = buildPacket(_forceResyncPending);
+					const std::size_t packetSize = packetBuffer.size();
 
 #if defined(DEATH_DEBUG)
-					_debugAverageUpdatePacketSize = lerp(_debugAverageUpdatePacketSize, (std::int32_t)(packet.GetSize() * UpdatesPerSecond), 0.04f * timeMult);
+					_debugAverageUpdatePacketSize = lerp(_debugAverageUpdatePacketSize, (std::int32_t)(packetSize * UpdatesPerSecond), 0.04f * timeMult);
 #endif
 #if defined(DEATH_DEBUG) && defined(WITH_IMGUI)
-					_updatePacketSize[_plotIndex] = packet.GetSize();
+					_updatePacketSize[_plotIndex] = (float)packetSize;
 					_updatePacketMaxSize = std::max(_updatePacketMaxSize, _updatePacketSize[_plotIndex]);
-					_compressedUpdatePacketSize[_plotIndex] = packetCompressed.GetSize();
+					_compressedUpdatePacketSize[_plotIndex] = _updatePacketSize[_plotIndex];
 #endif
 
-					_networkManager->SendTo([this](const Peer& peer) {
+					bool anyResyncPending = false;
+					_networkManager->SendTo([this, &anyResyncPending](const Peer& peer) {
 						auto peerDesc = _networkManager->GetPeerDescriptor(peer);
-						return (peerDesc && peerDesc->LevelState >= PeerLevelState::LevelSynchronized);
-					}, _forceResyncPending ? NetworkChannel::Main : NetworkChannel::UnreliableUpdates, (std::uint8_t)ServerPacketType::UpdateAllActors, packetCompressed);
+						if (!peerDesc || peerDesc->LevelState < PeerLevelState::LevelSynchronized) {
+							return false;
+						}
+						if (!_forceResyncPending && peerDesc->ActorsResyncPending.load(std::memory_order_relaxed)) {
+							anyResyncPending = true;
+							return false;
+						}
+						return true;
+					}, _forceResyncPending ? NetworkChannel::Main : NetworkChannel::UnreliableUpdates, (std::uint8_t)ServerPacketType::UpdateAllActors, packetBuffer);
+
+					if (anyResyncPending) {
+						ArrayView<std::uint8_t> fullPacketBuffer = buildPacket(true);
+						_networkManager->SendTo([this](const Peer& peer) {
+							auto peerDesc = _networkManager->GetPeerDescriptor(peer);
+							return (peerDesc && peerDesc->LevelState >= PeerLevelState::LevelSynchronized &&
+								peerDesc->ActorsResyncPending.exchange(false, std::memory_order_relaxed));
+						}, NetworkChannel::Main, (std::uint8_t)ServerPacketType::UpdateAllActors, fullPacketBuffer);
+					}
 
 					_lastUpdated++;
 					_forceResyncPending = false;
@@ -960,7 +931,9 @@ namespace Jazz2::Multiplayer
 						flags |= RemotePlayerOnServer::PlayerFlags::InConsole;
 					}
 
-					MemoryStream packet(20);
+					// Sent every frame, so it's built on the stack instead of in a heap-allocated stream
+					std::uint8_t packetBuffer[42];
+					SpanWriter packet(packetBuffer);
 					packet.WriteVariableUint32(_lastSpawnedActorId);
 					packet.WriteVariableUint64(now);
 					packet.WriteValue<std::int32_t>((std::int32_t)(player->_pos.X * 512.0f));
@@ -973,13 +946,21 @@ namespace Jazz2::Multiplayer
 						packet.WriteVariableUint64(_seqNumWarped);
 					}
 
+					// The timestamp doubles as the sequence number of this state, the server echoes the last one it
+					// accepted with every correction, so the movement made since then can be replayed on top of it
+					auto& predicted = _predictedStates[_predictedStateIndex];
+					predicted.Timestamp = now;
+					predicted.Pos = player->_pos;
+					predicted.Speed = player->_speed;
+					_predictedStateIndex = (_predictedStateIndex + 1) % PredictedStateCount;
+
 #if defined(DEATH_DEBUG) && defined(WITH_IMGUI)
-					_updatePacketSize[_plotIndex] = packet.GetSize();
+					_updatePacketSize[_plotIndex] = packet.GetPosition();
 					_compressedUpdatePacketSize[_plotIndex] = _updatePacketSize[_plotIndex];
 					_updatePacketMaxSize = std::max(_updatePacketMaxSize, _updatePacketSize[_plotIndex]);
 #endif
 
-					_networkManager->SendTo(AllPeers, NetworkChannel::UnreliableUpdates, (std::uint8_t)ClientPacketType::PlayerUpdate, packet);
+					_networkManager->SendTo(AllPeers, NetworkChannel::UnreliableUpdates, (std::uint8_t)ClientPacketType::PlayerUpdate, packet.GetWrittenView());
 				}
 			}
 		}
@@ -1180,7 +1161,7 @@ namespace Jazz2::Multiplayer
 		}
 	}
 
-	std::shared_ptr<AudioBufferPlayer> MpLevelHandler::PlaySfx(Actors::ActorBase* self, StringView identifier, AudioBuffer* buffer, const Vector3f& pos, bool sourceRelative, float gain, float pitch)
+	std::shared_ptr<AudioBufferPlayer> MpLevelHandler::PlaySfx(Actors::ActorBase* self, StringView identifier, AudioBuffer* buffer, const Vector3f& pos, bool sourceRelative, float gain, float pitch, std::int32_t priority)
 	{
 		Vector3f adjustedPos = pos;
 
@@ -1228,7 +1209,7 @@ namespace Jazz2::Multiplayer
 			}
 		}
 
-		return LevelHandler::PlaySfx(self, identifier, buffer, adjustedPos, sourceRelative, gain, pitch);
+		return LevelHandler::PlaySfx(self, identifier, buffer, adjustedPos, sourceRelative, gain, pitch, priority);
 	}
 
 	std::shared_ptr<AudioBufferPlayer> MpLevelHandler::PlayCommonSfx(StringView identifier, const Vector3f& pos, float gain, float pitch)
@@ -1646,7 +1627,7 @@ namespace Jazz2::Multiplayer
 					_networkManager->SendTo(peerDesc->RemotePeer, NetworkChannel::Main, (std::uint8_t)ServerPacketType::PlayerSetProperty, packet2);
 				}
 
-				MemoryStream packet(20);
+				MemoryStream packet(21);
 				packet.WriteVariableUint32(mpPlayer->_playerIndex);
 				packet.WriteValue<std::int32_t>((std::int32_t)(mpPlayer->_pos.X * 512.0f));
 				packet.WriteValue<std::int32_t>((std::int32_t)(mpPlayer->_pos.Y * 512.0f));
@@ -1654,6 +1635,8 @@ namespace Jazz2::Multiplayer
 				packet.WriteValue<std::int16_t>((std::int16_t)(mpPlayer->_speed.Y * 512.0f));
 				packet.WriteValue<std::int16_t>((std::int16_t)(mpPlayer->_externalForce.X * 512.0f));
 				packet.WriteValue<std::int16_t>((std::int16_t)(mpPlayer->_externalForce.Y * 512.0f));
+				// A warp is a teleport, so nothing the client did before it may be replayed
+				packet.WriteVariableUint64(0);
 				_networkManager->SendTo(peerDesc->RemotePeer, NetworkChannel::Main, (std::uint8_t)ServerPacketType::PlayerMoveInstantly, packet);
 			}
 		} else {
@@ -2837,6 +2820,33 @@ namespace Jazz2::Multiplayer
 				SendMessage(peer, UI::MessageLevel::Info, "Server configuration reloaded"_s);
 			}
 			return true;
+#if defined(WITH_FRAME_PROFILER)
+		} else if (line.hasPrefix("/profile "_s)) {
+			if (isAdmin) {
+				StringView action = line.exceptPrefix("/profile "_s).trimmed();
+				if (action == "on"_s) {
+					FrameProfiler::SetEnabled(true);
+					SendMessage(peer, UI::MessageLevel::Confirm, "Frame profiler enabled"_s);
+				} else if (action == "off"_s) {
+					FrameProfiler::SetEnabled(false);
+					SendMessage(peer, UI::MessageLevel::Confirm, "Frame profiler disabled"_s);
+				} else if (action == "dump"_s) {
+					if (FrameProfiler::IsEnabled()) {
+						// Written at the end of the frame, so the current one is still included
+						FrameProfiler::RequestDump();
+						SendMessage(peer, UI::MessageLevel::Confirm, "Frame profile will be saved to the config directory"_s);
+					} else {
+						SendMessage(peer, UI::MessageLevel::Error, "Frame profiler is not enabled"_s);
+					}
+				} else if (action.hasPrefix("slow "_s)) {
+					float threshold = strtof(String::nullTerminatedView(action.exceptPrefix("slow "_s)).data(), nullptr);
+					FrameProfiler::SetSlowFrameThreshold(std::max(threshold, 0.0f));
+					std::size_t length = formatInto(infoBuffer, "Frames slower than {:.1f} ms will be saved", threshold);
+					SendMessage(peer, UI::MessageLevel::Confirm, { infoBuffer, length });
+				}
+			}
+			return true;
+#endif
 		} else if (line == "/reset points"_s) {
 			if (isAdmin) {
 				ResetPeerPoints();
@@ -3644,7 +3654,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleClientPacketLevelReady(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint8_t flags = packet.ReadValue<std::uint8_t>();
 
 		LOGD("[MP] ClientPacketType::LevelReady [{}] - flags: 0x{:.2x}", peer, flags);
@@ -3685,7 +3695,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleClientPacketChatMessage(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t playerIndex = packet.ReadVariableUint32();
 
 		auto peerDesc = _networkManager->GetPeerDescriptor(peer);
@@ -3774,7 +3784,7 @@ namespace Jazz2::Multiplayer
 		bool success = true;
 		SmallVector<RequiredAsset*> missingAssets;
 
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t assetCount = packet.ReadVariableUint32();
 
 		LOGD("[MP] ClientPacketType::ValidateAssetsResponse [{}] - {}/{} assets", peer, assetCount, _requiredAssets.size());
@@ -3907,7 +3917,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleClientPacketPlayerReady(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		PlayerType preferredPlayerType = (PlayerType)packet.ReadValue<std::uint8_t>();
 		std::uint8_t preferredTeam = packet.ReadValue<std::uint8_t>();
 
@@ -3947,13 +3957,16 @@ namespace Jazz2::Multiplayer
 	bool MpLevelHandler::HandleClientPacketForceResyncActors(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
 		LOGD("[MP] ClientPacketType::ForceResyncActors [{}] - update: {}", peer, _lastUpdated);
-		_forceResyncPending = true;
+		// Only the peer that missed an update gets the next one in full, the others keep receiving the differences
+		if (auto peerDesc = _networkManager->GetPeerDescriptor(peer)) {
+			peerDesc->ActorsResyncPending.store(true, std::memory_order_relaxed);
+		}
 		return true;
 	}
 
 	bool MpLevelHandler::HandleClientPacketPlayerUpdate(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t playerIndex = packet.ReadVariableUint32();
 		std::uint64_t now = packet.ReadVariableUint64();
 		float posX = packet.ReadValue<std::int32_t>() / 512.0f;
@@ -4025,8 +4038,10 @@ namespace Jazz2::Multiplayer
 			}
 
 			if (corrected) {
-				// Snap the offending client back to the accepted authoritative state
-				MemoryStream packet2(20);
+				// Snap the offending client back to the accepted authoritative state. A rejected position must not be
+				// replayed, the client may only build on a position that was accepted along with this update.
+				bool positionAccepted = (acceptedX == posX && acceptedY == posY);
+				MemoryStream packet2(30);
 				packet2.WriteVariableUint32(remotePlayerOnServer->_playerIndex);
 				packet2.WriteValue<std::int32_t>((std::int32_t)(acceptedX * 512.0f));
 				packet2.WriteValue<std::int32_t>((std::int32_t)(acceptedY * 512.0f));
@@ -4034,6 +4049,7 @@ namespace Jazz2::Multiplayer
 				packet2.WriteValue<std::int16_t>((std::int16_t)(acceptedSpeedY * 512.0f));
 				packet2.WriteValue<std::int16_t>((std::int16_t)(remotePlayerOnServer->_externalForce.X * 512.0f));
 				packet2.WriteValue<std::int16_t>((std::int16_t)(remotePlayerOnServer->_externalForce.Y * 512.0f));
+				packet2.WriteVariableUint64(positionAccepted ? now : 0);
 				_networkManager->SendTo(peer, NetworkChannel::Main, (std::uint8_t)ServerPacketType::PlayerMoveInstantly, packet2);
 			}
 
@@ -4064,7 +4080,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleClientPacketPlayerKeyPress(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t playerIndex = packet.ReadVariableUint32();
 		std::uint64_t pressedKeys = packet.ReadVariableUint64();
 
@@ -4076,7 +4092,7 @@ namespace Jazz2::Multiplayer
 			}
 
 			if (auto* remotePlayerOnServer = runtime_cast<RemotePlayerOnServer>(peerDesc->Player)) {
-				std::uint32_t frameCount = theApplication().GetFrameCount();
+				std::uint32_t frameCount = theApplication().GetUpdateCount();
 				if (remotePlayerOnServer->UpdatedFrame != frameCount) {
 					remotePlayerOnServer->UpdatedFrame = frameCount;
 					remotePlayerOnServer->PressedKeysLast = remotePlayerOnServer->PressedKeys;
@@ -4091,7 +4107,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleClientPacketPlayerChangeWeaponRequest(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t playerIndex = packet.ReadVariableUint32();
 		std::uint8_t weaponType = packet.ReadValue<std::uint8_t>();
 
@@ -4121,7 +4137,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleClientPacketPlayerSpectateRequest(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t playerIndex = packet.ReadVariableUint32();
 		std::uint8_t enable = packet.ReadValue<std::uint8_t>();
 
@@ -4154,7 +4170,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleClientPacketPlayerChangeCharacter(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t playerIndex = packet.ReadVariableUint32();
 		PlayerType playerType = (PlayerType)packet.ReadValue<std::uint8_t>();
 
@@ -4195,7 +4211,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleClientPacketPlayerChangeTeamRequest(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint8_t requestedTeam = packet.ReadValue<std::uint8_t>();
 
 		auto peerDesc = _networkManager->GetPeerDescriptor(peer);
@@ -4222,7 +4238,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleClientPacketPlayerAckWarped(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t playerIndex = packet.ReadVariableUint32();
 		std::uint64_t seqNum = packet.ReadVariableUint64();
 		float posX = packet.ReadValue<std::int32_t>() / 512.0f;
@@ -4306,7 +4322,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketPeerSetProperty(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		PeerPropertyType type = (PeerPropertyType)packet.ReadValue<std::uint8_t>();
 		DEATH_UNUSED std::uint64_t peerId = packet.ReadVariableUint64();
 
@@ -4363,13 +4379,20 @@ namespace Jazz2::Multiplayer
 		// Start to ignore all incoming packets, because they no longer belong to this handler
 		_ignorePackets = true;
 
+		{
+			// Actor IDs of the next level start over, so snapshots of this level must not be used to decode them
+			std::unique_lock lock(_lock);
+			_actorSnapshots.clear();
+			_actorSnapshotsValid = false;
+		}
+
 		LOGD("[MP] ServerPacketType::LoadLevel");
 		return false;
 	}
 
 	bool MpLevelHandler::HandleServerPacketLevelSetProperty(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		LevelPropertyType propertyType = (LevelPropertyType)packet.ReadValue<std::uint8_t>();
 		switch (propertyType) {
 			case LevelPropertyType::State: {
@@ -4561,7 +4584,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketShowInGameLobby(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint8_t flags = packet.ReadValue<std::uint8_t>();
 		std::uint8_t allowedPlayerTypes = packet.ReadValue<std::uint8_t>();
 
@@ -4617,7 +4640,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketFadeOut(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::int32_t fadeOutDelay = packet.ReadVariableInt32();
 
 		LOGD("[MP] ServerPacketType::FadeOut - delay: {}", fadeOutDelay);
@@ -4643,7 +4666,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketPlaySfx(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t actorId = packet.ReadVariableUint32();
 		float gain = halfToFloat(packet.ReadValue<std::uint16_t>());
 		float pitch = halfToFloat(packet.ReadValue<std::uint16_t>());
@@ -4676,7 +4699,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketPlayCommonSfx(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::int32_t posX = packet.ReadVariableInt32();
 		std::int32_t posY = packet.ReadVariableInt32();
 		float gain = halfToFloat(packet.ReadValue<std::uint16_t>());
@@ -4700,7 +4723,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketShowAlert(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		/*std::uint8_t flags =*/ packet.ReadValue<std::uint8_t>();
 		std::uint32_t textLength = packet.ReadVariableUint32();
 		if DEATH_UNLIKELY(textLength > 1024) {
@@ -4723,7 +4746,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketChatMessage(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t playerIndex = packet.ReadVariableUint32();
 		UI::MessageLevel level = (UI::MessageLevel)packet.ReadValue<std::uint8_t>();
 
@@ -4768,7 +4791,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketSetTrigger(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint8_t triggerId = packet.ReadValue<std::uint8_t>();
 		bool newState = (bool)packet.ReadValue<std::uint8_t>();
 
@@ -4782,7 +4805,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketAdvanceTileAnimation(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::int32_t tx = packet.ReadVariableInt32();
 		std::int32_t ty = packet.ReadVariableInt32();
 		std::int32_t amount = packet.ReadVariableInt32();
@@ -4797,7 +4820,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketCreateDebris(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint8_t effect = packet.ReadValue<std::uint8_t>();
 		std::uint32_t actorId = packet.ReadVariableUint32();
 
@@ -4835,7 +4858,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketCreateControllablePlayer(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t playerIndex = packet.ReadVariableUint32();
 		PlayerType playerType = (PlayerType)packet.ReadValue<std::uint8_t>();
 		std::int32_t health = packet.ReadVariableInt32();
@@ -4904,7 +4927,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketCreateRemoteActor(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t actorId = packet.ReadVariableUint32();
 		std::uint8_t flags = packet.ReadValue<std::uint8_t>();
 		std::int32_t posX = packet.ReadVariableInt32();
@@ -4964,7 +4987,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketCreateMirroredActor(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t actorId = packet.ReadVariableUint32();
 		EventType eventType = (EventType)packet.ReadVariableUint32();
 		StaticArray<Events::EventSpawner::SpawnParamsSize, std::uint8_t> eventParams(NoInit);
@@ -5002,13 +5025,16 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketDestroyRemoteActor(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t actorId = packet.ReadVariableUint32();
 
 		LOGD("[MP] ServerPacketType::DestroyRemoteActor - actorId: {}", actorId);
 
 		InvokeAsync([this, actorId]() {
 			std::unique_lock lock(_lock);
+			// The actor ID can be reused later, so the new actor must not be decoded against the old snapshot
+			_actorSnapshots.erase(actorId);
+
 			if DEATH_UNLIKELY(actorId == _lastSpawnedActorId) {
 				// Server requested to despawn controllable player
 				if (!_players.empty()) {
@@ -5040,11 +5066,10 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketUpdateAllActors(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packetCompressed(data);
-		DeflateStream packet(packetCompressed);
-		std::uint32_t now = packet.ReadVariableUint32();
-		float elapsedFrames = (float)packet.ReadVariableUint64();
-		std::uint32_t actorCount = packet.ReadVariableUint32();
+		MemoryStream packetHeader(data);
+		std::uint32_t now = packetHeader.ReadVariableUint32();
+		float elapsedFrames = (float)packetHeader.ReadVariableUint64();
+		std::uint32_t actorCount = packetHeader.ReadVariableUint32();
 
 		bool forceResyncInvoked = (actorCount & 1) == 1;
 		if DEATH_UNLIKELY(!forceResyncInvoked && _lastUpdated >= now) {
@@ -5060,53 +5085,47 @@ namespace Jazz2::Multiplayer
 
 		std::unique_lock lock(_lock);
 
+		// Position differences are relative to the previous update, so after a missed update they're skipped until
+		// the requested re-sync arrives. If the re-sync itself arrived out of order, it's requested again later.
+		if (forceResyncInvoked) {
+			_actorSnapshotsValid = true;
+		} else if (forceResyncRequired) {
+			_actorSnapshotsValid = false;
+			_actorSnapshotsResyncRequested = now;
+		} else if (!_actorSnapshotsValid && (_actorSnapshotsResyncRequested == 0 || now - _actorSnapshotsResyncRequested > (std::uint32_t)UpdatesPerSecond)) {
+			forceResyncRequired = true;
+			_actorSnapshotsResyncRequested = now;
+		}
+
 		_lastUpdated = now;
 		_elapsedFrames = lerp(_elapsedFrames, elapsedFrames + _networkManager->GetRoundTripTimeMs() * FrameTimer::FramesPerSecond * 0.002f, 0.05f);
 
 		actorCount >>= 1;
 
-		for (std::uint32_t i = 0; i < actorCount; i++) {
-			std::uint32_t actorId = packet.ReadVariableUint32();
-			std::uint8_t flags = packet.ReadValue<std::uint8_t>();
-
-			bool positionChanged = (flags & 0x01) != 0;
-			bool animationChanged = (flags & 0x02) != 0;
+		std::size_t headerSize = (std::size_t)packetHeader.GetPosition();
+		BitReader packet(data.data() + headerSize, data.size() - headerSize);
 
-			float posX, posY, rotation, scaleX, scaleY;
-			AnimState anim; Actors::ActorRendererType rendererType;
-
-			if (positionChanged) {
-				posX = packet.ReadValue<std::int32_t>() / 512.0f;
-				posY = packet.ReadValue<std::int32_t>() / 512.0f;
-			} else {
-				posX = 0.0f;
-				posY = 0.0f;
-			}
-
-			if (animationChanged) {
-				anim = (AnimState)packet.ReadVariableUint32();
-				rotation = packet.ReadValue<std::uint16_t>() * fRadAngle360 / UINT16_MAX;
-				scaleX = (float)Half{packet.ReadValue<std::uint16_t>()};
-				scaleY = (float)Half{packet.ReadValue<std::uint16_t>()};
-				rendererType = (Actors::ActorRendererType)packet.ReadValue<std::uint8_t>();
-			} else {
-				anim = AnimState::Idle;
-				rotation = 0.0f;
-				scaleX = 0.0f;
-				scaleY = 0.0f;
-				rendererType = Actors::ActorRendererType::Default;
+		for (std::uint32_t i = 0; i < actorCount; i++) {
+			std::uint32_t actorId = ReadActorSnapshotId(packet);
+			ActorSnapshot& snapshot = _actorSnapshots[actorId];
+			SnapshotFields fields = ReadActorSnapshot(packet, snapshot, _actorSnapshotsValid);
+			if DEATH_UNLIKELY(!packet.IsValid()) {
+				LOGW("[MP] ServerPacketType::UpdateAllActors - Malformed packet");
+				break;
 			}
 
 			auto it = _remoteActors.find(actorId);
 			if (it != _remoteActors.end()) {
 				if (auto* remoteActor = runtime_cast<Actors::Multiplayer::RemoteActor>(it->second.get())) {
-					if (positionChanged) {
-						remoteActor->SyncPositionWithServer(Vector2f(posX, posY));
+					if ((fields & SnapshotFields::Position) == SnapshotFields::Position) {
+						remoteActor->SyncPositionWithServer(Vector2f(ActorSnapshot::DequantizePosition(snapshot.PosX),
+							ActorSnapshot::DequantizePosition(snapshot.PosY)));
 					}
-					if (animationChanged) {
-						remoteActor->SyncAnimationWithServer(anim, rotation, scaleX, scaleY, rendererType);
+					if ((fields & SnapshotFields::AnyAnimation) != SnapshotFields::None) {
+						remoteActor->SyncAnimationWithServer((AnimState)snapshot.Animation, snapshot.Rotation * fRadAngle360 / UINT16_MAX,
+							(float)Half{snapshot.ScaleX}, (float)Half{snapshot.ScaleY}, (Actors::ActorRendererType)snapshot.RendererType);
 					}
-					remoteActor->SyncMiscWithServer(flags);
+					remoteActor->SyncMiscWithServer(snapshot.Flags);
 				}
 			}
 		}
@@ -5119,7 +5138,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketChangeRemoteActorMetadata(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t actorId = packet.ReadVariableUint32();
 		// TODO: Flags are unused
 		DEATH_UNUSED std::uint8_t flags = packet.ReadValue<std::uint8_t>();
@@ -5149,7 +5168,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketMarkRemoteActorAsPlayer(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t actorId = packet.ReadVariableUint32();
 		std::uint8_t flags = packet.ReadValue<std::uint8_t>();
 		std::uint32_t playerNameLength = packet.ReadVariableUint32();
@@ -5210,7 +5229,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketUpdatePositionsInRound(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t count = packet.ReadVariableUint32();
 		if DEATH_UNLIKELY(count > 1024) {
 			// Refuse an implausible (attacker-controlled) count before allocating a buffer for it
@@ -5234,7 +5253,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketSyncRaceCheckpoints(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		Vector2i boundsMin, boundsMax;
 		boundsMin.X = packet.ReadVariableInt32();
 		boundsMin.Y = packet.ReadVariableInt32();
@@ -5279,7 +5298,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketSyncTeamScores(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint8_t teamCount = packet.ReadValue<std::uint8_t>();
 		SmallVector<std::uint32_t, 0> teamScores;
 		teamScores.resize_for_overwrite(teamCount);
@@ -5332,7 +5351,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketSyncScoreboard(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t count = packet.ReadVariableUint32();
 		if DEATH_UNLIKELY(count > 1024) {
 			// Refuse an implausible (attacker-controlled) count before allocating a buffer for it
@@ -5379,7 +5398,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketSyncRoundResults(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t count = packet.ReadVariableUint32();
 		if DEATH_UNLIKELY(count > MaxRoundResults) {
 			// Refuse an implausible (attacker-controlled) count before allocating a buffer for it
@@ -5421,7 +5440,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketPlayerSetProperty(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		PlayerPropertyType propertyType = (PlayerPropertyType)packet.ReadValue<std::uint8_t>();
 		std::uint32_t playerIndex = packet.ReadVariableUint32();
 
@@ -5800,7 +5819,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketPlayerResetProperties(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t playerIndex = packet.ReadVariableUint32();
 		if (_lastSpawnedActorId != playerIndex) {
 			LOGD("[MP] ServerPacketType::PlayerSetProperty - Received playerIndex {} instead of {}", playerIndex, _lastSpawnedActorId);
@@ -5845,7 +5864,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketPlayerRespawn(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t playerIndex = packet.ReadVariableUint32();
 		if DEATH_UNLIKELY(_lastSpawnedActorId != playerIndex) {
 			LOGD("[MP] ServerPacketType::PlayerRespawn - Received playerIndex {} instead of {}", playerIndex, _lastSpawnedActorId);
@@ -5881,7 +5900,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketPlayerMoveInstantly(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t playerIndex = packet.ReadVariableUint32();
 		if (_lastSpawnedActorId != playerIndex) {
 			return true;
@@ -5893,22 +5912,71 @@ namespace Jazz2::Multiplayer
 		float speedY = packet.ReadValue<std::int16_t>() / 512.0f;
 		float externalForceX = packet.ReadValue<std::int16_t>() / 512.0f;
 		float externalForceY = packet.ReadValue<std::int16_t>() / 512.0f;
+		// Timestamp of the last PlayerUpdate the server built this state on, 0 if the state must be taken as is
+		std::uint64_t ackTimestamp = (packet.GetPosition() < (std::int64_t)data.size() ? packet.ReadVariableUint64() : 0);
 
-		LOGD("[MP] ServerPacketType::PlayerMoveInstantly - playerIndex: {}, x: {}, y: {}, sx: {}, sy: {}",
-			playerIndex, posX, posY, speedX, speedY);
+		LOGD("[MP] ServerPacketType::PlayerMoveInstantly - playerIndex: {}, x: {}, y: {}, sx: {}, sy: {}, ack: {}",
+			playerIndex, posX, posY, speedX, speedY, ackTimestamp);
 
-		InvokeAsync([this, posX, posY, speedX, speedY, externalForceX, externalForceY]() {
-			if (!_players.empty()) {
-				auto* player = static_cast<RemotablePlayer*>(_players[0]);
-				player->MoveRemotely(Vector2f(posX, posY), Vector2f(speedX, speedY), Vector2f(externalForceX, externalForceY));
+		InvokeAsync([this, posX, posY, speedX, speedY, externalForceX, externalForceY, ackTimestamp]() {
+			if (_players.empty()) {
+				return;
+			}
+
+			auto* player = static_cast<RemotablePlayer*>(_players[0]);
+			Vector2f pos = Vector2f(posX, posY);
+			Vector2f speed = Vector2f(speedX, speedY);
+			Vector2f externalForce = Vector2f(externalForceX, externalForceY);
+			if (ackTimestamp != 0 && !ReconcilePredictedState(player, ackTimestamp, pos, speed)) {
+				// The prediction already ends where the correction does, but a push the server applied (a spring,
+				// a pole) is not part of the predicted state, so it still has to reach the player
+				if (externalForce != Vector2f::Zero) {
+					player->_externalForce = externalForce;
+				}
+				return;
+			}
+
+			// A later correction can acknowledge the same state again, so the remembered states move along with
+			// the player - the movement measured from them then never includes a correction already applied
+			Vector2f posOffset = pos - player->_pos;
+			Vector2f speedOffset = speed - player->_speed;
+			for (auto& predicted : _predictedStates) {
+				predicted.Pos += posOffset;
+				predicted.Speed += speedOffset;
 			}
+
+			player->MoveRemotely(pos, speed, externalForce);
 		});
 		return true;
 	}
 
+	bool MpLevelHandler::ReconcilePredictedState(Actors::Player* player, std::uint64_t ackTimestamp, Vector2f& pos, Vector2f& speed)
+	{
+		// The authoritative state is where the player was when it reported the acknowledged state, corrected by the
+		// server. By the time it arrives, the player has kept moving for a round trip. The movement is not
+		// deterministic enough to re-simulate the inputs, so the displacement and the change of speed the client
+		// predicted since then are carried over instead - only the difference the server made is applied.
+		for (std::uint32_t i = 0; i < PredictedStateCount; i++) {
+			const auto& predicted = _predictedStates[i];
+			if (predicted.Timestamp != ackTimestamp) {
+				continue;
+			}
+
+			pos += player->_pos - predicted.Pos;
+			speed += player->_speed - predicted.Speed;
+
+			constexpr float MaxIgnoredError = 1.0f / 512.0f;
+			return ((pos - player->_pos).SqrLength() > MaxIgnoredError * MaxIgnoredError ||
+					(speed - player->_speed).SqrLength() > MaxIgnoredError * MaxIgnoredError);
+		}
+
+		// Too old to be remembered, so the state is taken as is
+		return true;
+	}
+
 	bool MpLevelHandler::HandleServerPacketPlayerAckWarped(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t playerIndex = packet.ReadVariableUint32();
 		std::uint64_t seqNum = packet.ReadVariableUint64();
 
@@ -5922,7 +5990,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketPlayerEmitWeaponFlare(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t playerIndex = packet.ReadVariableUint32();
 		if DEATH_UNLIKELY(_lastSpawnedActorId != playerIndex) {
 			LOGD("[MP] ServerPacketType::PlayerEmitWeaponFlare - Received playerIndex {} instead of {}", playerIndex, _lastSpawnedActorId);
@@ -5941,7 +6009,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketPlayerChangeWeapon(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t playerIndex = packet.ReadVariableUint32();
 		if DEATH_UNLIKELY(_lastSpawnedActorId != playerIndex) {
 			LOGD("[MP] ServerPacketType::PlayerChangeWeapon - Received playerIndex {} instead of {}", playerIndex, _lastSpawnedActorId);
@@ -5974,7 +6042,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketPlayerTakeDamage(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t playerIndex = packet.ReadVariableUint32();
 		if DEATH_UNLIKELY(_lastSpawnedActorId != playerIndex) {
 			LOGD("[MP] ServerPacketType::PlayerTakeDamage - Received playerIndex {} instead of {}", playerIndex, _lastSpawnedActorId);
@@ -5996,7 +6064,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketPlayerPush(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t playerIndex = packet.ReadVariableUint32();
 		if DEATH_UNLIKELY(_lastSpawnedActorId != playerIndex) {
 			LOGD("[MP] ServerPacketType::PlayerPush - Received playerIndex {} instead of {}", playerIndex, _lastSpawnedActorId);
@@ -6016,7 +6084,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketPlayerActivateSpring(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t playerIndex = packet.ReadVariableUint32();
 		if DEATH_UNLIKELY(_lastSpawnedActorId != playerIndex) {
 			LOGD("[MP] ServerPacketType::PlayerActivateSpring - Received playerIndex {} instead of {}", playerIndex, _lastSpawnedActorId);
@@ -6043,7 +6111,7 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketPlayerWarpIn(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packet(data);
+		SpanReader packet(data);
 		std::uint32_t playerIndex = packet.ReadVariableUint32();
 		if DEATH_UNLIKELY(_lastSpawnedActorId != playerIndex) {
 			LOGD("[MP] ServerPacketType::PlayerWarpIn - Received playerIndex {} instead of {}", playerIndex, _lastSpawnedActorId);
@@ -6392,6 +6460,7 @@ namespace Jazz2::Multiplayer
 			actorId = it->second.ActorID;
 			_remotingActors.erase(it);
 			_remoteActors.erase(actorId);
+			_actorSnapshots.erase(actorId);
 		}
 
 		MemoryStream packet(4);
@@ -6802,7 +6871,7 @@ namespace Jazz2::Multiplayer
 			// The owning client simulates its own physics, so resync the post-bump position and velocity;
 			// reuses the existing PlayerMoveInstantly packet.
 			if (peerDesc->RemotePeer) {
-				MemoryStream packet(20);
+				MemoryStream packet(30);
 				packet.WriteVariableUint32(mpPlayer->_playerIndex);
 				packet.WriteValue<std::int32_t>((std::int32_t)(mpPlayer->_pos.X * 512.0f));
 				packet.WriteValue<std::int32_t>((std::int32_t)(mpPlayer->_pos.Y * 512.0f));
@@ -6810,6 +6879,9 @@ namespace Jazz2::Multiplayer
 				packet.WriteValue<std::int16_t>((std::int16_t)(mpPlayer->_speed.Y * 512.0f));
 				packet.WriteValue<std::int16_t>((std::int16_t)(mpPlayer->_externalForce.X * 512.0f));
 				packet.WriteValue<std::int16_t>((std::int16_t)(mpPlayer->_externalForce.Y * 512.0f));
+				// The bump was applied on top of the last state the client reported, so the client replays what it
+				// did since then instead of snapping back a round trip (nothing to replay during a warp grace)
+				packet.WriteVariableUint64(peerDesc->LastUpdated != UINT64_MAX ? peerDesc->LastUpdated : 0);
 				_networkManager->SendTo(peerDesc->RemotePeer, NetworkChannel::Main, (std::uint8_t)ServerPacketType::PlayerMoveInstantly, packet);
 			}
 		}
@@ -10185,6 +10257,37 @@ namespace Jazz2::Multiplayer
 				runtime_cast<Actors::Solid::PinballPaddle>(actor) || runtime_cast<Actors::Solid::SpikeBall>(actor));
 	}
 
+	ActorSnapshot MpLevelHandler::CreateActorSnapshot(Actors::ActorBase* actor)
+	{
+		ActorSnapshot snapshot;
+		snapshot.PosX = ActorSnapshot::QuantizePosition(actor->_pos.X);
+		snapshot.PosY = ActorSnapshot::QuantizePosition(actor->_pos.Y);
+		snapshot.Animation = (std::uint32_t)(actor->_currentTransition != nullptr ? actor->_currentTransition->State
+			: (actor->_currentAnimation != nullptr ? actor->_currentAnimation->State : AnimState::Idle));
+
+		float rotation = actor->_renderer.rotation();
+		if (rotation < 0.0f) rotation += fRadAngle360;
+		snapshot.Rotation = (std::uint16_t)(rotation * UINT16_MAX / fRadAngle360);
+		Vector2f scale = actor->_renderer.scale();
+		snapshot.ScaleX = (std::uint16_t)Half{scale.X};
+		snapshot.ScaleY = (std::uint16_t)Half{scale.Y};
+		snapshot.RendererType = (std::uint8_t)actor->_renderer.GetRendererType();
+
+		if (actor->_renderer.isDrawEnabled()) {
+			snapshot.Flags |= 0x04;
+		}
+		if (actor->_renderer.AnimPaused) {
+			snapshot.Flags |= 0x08;
+		}
+		if (actor->_renderer.isFlippedX()) {
+			snapshot.Flags |= 0x10;
+		}
+		if (actor->_renderer.isFlippedY()) {
+			snapshot.Flags |= 0x20;
+		}
+		return snapshot;
+	}
+
 	std::int32_t MpLevelHandler::GetTreasureWeight(std::uint8_t gemType)
 	{
 		switch (gemType) {
@@ -6,6 +6,7 @@
 #include "MpGameMode.h"
 #include "Teams.h"
 #include "NetworkManager.h"
+#include "SnapshotEncoding.h"
 #include "WebhookClient.h"
 #include "GameModes/GameModeFactory.h"
 #include "../Actors/Player.h"
@@ -148,7 +149,7 @@ namespace Jazz2::Multiplayer
 
 		void AddActor(std::shared_ptr<Actors::ActorBase> actor) override;
 
-		std::shared_ptr<AudioBufferPlayer> PlaySfx(Actors::ActorBase* self, StringView identifier, AudioBuffer* buffer, const Vector3f& pos, bool sourceRelative, float gain, float pitch) override;
+		std::shared_ptr<AudioBufferPlayer> PlaySfx(Actors::ActorBase* self, StringView identifier, AudioBuffer* buffer, const Vector3f& pos, bool sourceRelative, float gain, float pitch, std::int32_t priority = SoundResource::DefaultPriority) override;
 		std::shared_ptr<AudioBufferPlayer> PlayCommonSfx(StringView identifier, const Vector3f& pos, float gain = 1.0f, float pitch = 1.0f) override;
 		void WarpCameraToTarget(Actors::ActorBase* actor, bool fast = false) override;
 
@@ -377,13 +378,8 @@ namespace Jazz2::Multiplayer
 		// Doxygen 1.12.0 outputs also private structs/unions even if it shouldn't
 		struct RemotingActorInfo {
 			std::uint32_t ActorID;
-			std::int32_t LastPosX;
-			std::int32_t LastPosY;
-			std::uint32_t LastAnimation;
-			std::uint16_t LastRotation;
-			std::uint16_t LastScaleX;
-			std::uint16_t LastScaleY;
-			std::uint8_t LastRendererType;
+			ActorSnapshot LastSnapshot;
+			bool HasSnapshot;
 		};
 
 		struct PlayerName {
@@ -447,6 +443,13 @@ namespace Jazz2::Multiplayer
 				: Type(type), Crc32(crc32), FullPath(fullPath), Path(path), Size(size) {}
 		};
 
+		/** @brief Local player state as reported to the server in one `PlayerUpdate`, kept by the client for reconciliation */
+		struct PredictedPlayerState {
+			std::uint64_t Timestamp;
+			Vector2f Pos;
+			Vector2f Speed;
+		};
+
 		enum class VoteType : std::uint8_t {
 			None,
 			Restart,
@@ -468,6 +471,8 @@ namespace Jazz2::Multiplayer
 		static constexpr float RecalcPositionInRoundInterval = FrameTimer::FramesPerSecond / 4.0f;
 		static constexpr float TeamSwitchCooldownFrames = 5.0f * FrameTimer::FramesPerSecond;
 		static constexpr float CtfTouchRadius = 40.0f;	// Pixel radius for picking up / returning / capturing flags
+		// Reported states the client remembers, a correction acknowledging anything older snaps instead (~2 s of updates)
+		static constexpr std::uint32_t PredictedStateCount = 64;
 
 		NetworkManager* _networkManager;
 		std::unique_ptr<GameModes::IGameMode> _gameMode;
@@ -476,7 +481,7 @@ namespace Jazz2::Multiplayer
 		LevelState _levelState;
 		bool _isServer;
 		bool _isLocalSession;	// Local splitscreen session - there are no peers, so no packets are ever built
-		bool _forceResyncPending;
+		bool _forceResyncPending;	// Server: the next update goes in full to all peers, single peers are marked in PeerDescriptor instead
 		bool _enableSpawning;
 		bool _enqueuedPlaylistChange; // Server: apply the next playlist entry once the end-of-level transition finishes
 		HashMap<std::uint32_t, std::shared_ptr<Actors::ActorBase>> _remoteActors; // Client: Actor ID -> Remote Actor created by server
@@ -504,7 +509,12 @@ namespace Jazz2::Multiplayer
 		std::uint32_t _lastSpawnedActorId;	// Server: last assigned actor/player ID, Client: ID assigned by server
 		std::int32_t _waitingForPlayerCount;	// Client: number of players needed to start the game
 		std::uint32_t _lastUpdated; // Server/Client: last update from the server
+		HashMap<std::uint32_t, ActorSnapshot> _actorSnapshots; // Client: Actor ID -> State received in the last update
+		bool _actorSnapshotsValid; // Client: if false, an update was missed and position differences can't be applied
+		std::uint32_t _actorSnapshotsResyncRequested; // Client: update in which the last re-sync was requested
 		std::uint64_t _seqNumWarped; // Client: set to _seqNum from HandlePlayerWarped() when warped
+		PredictedPlayerState _predictedStates[PredictedStateCount];	// Client: ring of the states sent in PlayerUpdate
+		std::uint32_t _predictedStateIndex;							// Client: next slot of _predictedStates to write
 		Threading::Spinlock _lock;
 		bool _suppressRemoting; // Server: if true, actor will not be automatically remoted to other players
 		bool _ignorePackets;
@@ -618,6 +628,7 @@ namespace Jazz2::Multiplayer
 		void EndActivePoll();
 
 		static bool ActorShouldBeMirrored(Actors::ActorBase* actor);
+		static ActorSnapshot CreateActorSnapshot(Actors::ActorBase* actor);
 		static std::int32_t GetTreasureWeight(std::uint8_t gemType);
 		static bool PlayerShouldHaveUnlimitedHealth(MpGameMode gameMode);
 		void InitializeValidateAssetsPacket(MemoryStream& packet);
@@ -670,6 +681,7 @@ namespace Jazz2::Multiplayer
 		bool HandleServerPacketPlayerResetProperties(const Peer& peer, ArrayView<const std::uint8_t> data);
 		bool HandleServerPacketPlayerRespawn(const Peer& peer, ArrayView<const std::uint8_t> data);
 		bool HandleServerPacketPlayerMoveInstantly(const Peer& peer, ArrayView<const std::uint8_t> data);
+		bool ReconcilePredictedState(Actors::Player* player, std::uint64_t ackTimestamp, Vector2f& pos, Vector2f& speed);
 		bool HandleServerPacketPlayerAckWarped(const Peer& peer, ArrayView<const std::uint8_t> data);
 		bool HandleServerPacketPlayerEmitWeaponFlare(const Peer& peer, ArrayView<const std::uint8_t> data);
 		bool HandleServerPacketPlayerChangeWeapon(const Peer& peer, ArrayView<const std::uint8_t> data);
@@ -279,6 +279,7 @@ namespace Jazz2::Multiplayer
 		serverConfig.AllowedPlayerTypes = 0x01 | 0x02 | 0x04;
 		serverConfig.IdleKickTimeSecs = -1;
 		serverConfig.ReconnectWindowSecs = 300;
+		serverConfig.TickRate = DefaultTickRate;
 		serverConfig.MinPlayerCount = 1;
 		serverConfig.ReforgedGameplay = PreferencesCache::EnableReforgedGameplay;
 		serverConfig.PreGameSecs = 30;
@@ -467,6 +468,22 @@ namespace Jazz2::Multiplayer
 					serverConfig.ReconnectWindowSecs = std::int32_t(reconnectWindowSecs);
 				}
 
+				std::int64_t tickRate;
+				if (doc["TickRate"].get(tickRate) == Json::SUCCESS && tickRate >= MinTickRate && tickRate <= MaxTickRate) {
+					serverConfig.TickRate = std::uint32_t(tickRate);
+				}
+
+				Json::Value& rooms = doc["Rooms"];
+				if (rooms.isArray()) {
+					serverConfig.Rooms.clear();
+					for (auto& entry : rooms) {
+						std::string_view roomPath;
+						if (entry.get(roomPath) == Json::SUCCESS && !roomPath.empty()) {
+							serverConfig.Rooms.push_back(roomPath);
+						}
+					}
+				}
+
 				bool allowCheats;
 				if (doc["AllowCheats"].get(allowCheats) == Json::SUCCESS) {
 					serverConfig.AllowCheats = allowCheats;
@@ -30,6 +30,13 @@ namespace Jazz2::Multiplayer
 	class NetworkManager : public NetworkManagerBase
 	{
 	public:
+		/** @brief Default number of simulation ticks per second of a dedicated server */
+		static constexpr std::uint32_t DefaultTickRate = 60;
+		/** @brief Minimum allowed number of simulation ticks per second of a dedicated server */
+		static constexpr std::uint32_t MinTickRate = 10;
+		/** @brief Maximum allowed number of simulation ticks per second of a dedicated server */
+		static constexpr std::uint32_t MaxTickRate = 240;
+
 		/** @brief Creates a new instance */
 		NetworkManager();
 		~NetworkManager();
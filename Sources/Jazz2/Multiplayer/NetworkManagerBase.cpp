@@ -9,6 +9,7 @@
 #include "PacketTypes.h"
 #include "../../nCine/Base/Algorithms.h"
 #include "../../nCine/Threading/Thread.h"
+#include "../../nCine/tracy.h"
 
 #include <atomic>
 #include <mutex>
@@ -1609,6 +1610,7 @@ namespace Jazz2::Multiplayer
 					continue;
 				}
 
+				ZoneScopedNC("Network event", 0xC49A6D);
 				switch (ev.type) {
 					case ENET_EVENT_TYPE_RECEIVE: {
 						// A valid packet carries at least the 1-byte packet-type prefix. Drop empty packets so the
@@ -1715,6 +1717,7 @@ namespace Jazz2::Multiplayer
 				continue;
 			}
 
+			ZoneScopedNC("Network event", 0xC49A6D);
 			switch (ev.type) {
 				case ENET_EVENT_TYPE_CONNECT: {
 					ConnectionResult result = _this->OnPeerConnected(ev.peer, ev.data);
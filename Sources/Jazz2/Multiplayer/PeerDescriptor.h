@@ -11,6 +11,8 @@
 
 #include <Containers/String.h>
 
+#include <atomic>
+
 using namespace Death::Containers;
 using namespace nCine;
 
@@ -103,6 +105,9 @@ namespace Jazz2::Multiplayer
 		/** @brief Number of packets received from this peer within the current rate window */
 		std::uint32_t PacketRateCount = 0;
 
+		/** @brief Whether the peer missed an actor update and waits for a full one (set from the network thread) */
+		std::atomic<bool> ActorsResyncPending{false};
+
 		/** @brief Elapsed frames when the player is idle */
 		float IdleElapsedFrames;
 		/** @brief Time remaining for join cooldown */
@@ -130,6 +130,11 @@ namespace Jazz2::Multiplayer
 		-   @cpp "AllowedPlayerTypes" @ce : @m_span{m-label m-warning m-flat} integer @m_endspan Bitmask for allowed player types (@cpp 1 @ce - Jazz, @cpp 2 @ce - Spaz, @cpp 4 @ce - Lori)
 		-   @cpp "IdleKickTimeSecs" @ce : @m_span{m-label m-warning m-flat} integer @m_endspan Time in seconds after idle players are kicked (default is **never**)
 		-   @cpp "ReconnectWindowSecs" @ce : @m_span{m-label m-warning m-flat} integer @m_endspan Time window in seconds during which a disconnected player can reconnect and resume their progression (weapons, lives, score, gems), @cpp 0 @ce or less to disable (default is **300**, i.e. 5 minutes)
+		-   @cpp "TickRate" @ce : @m_span{m-label m-warning m-flat} integer @m_endspan Number of simulation ticks per second of a dedicated server (default is **60**)
+			-   Lower values (e.g., @cpp 30 @ce) reduce CPU usage of the server, the simulation advances by a larger step instead
+		-   @cpp "Rooms" @ce : @m_span{m-label m-success m-flat} array @m_endspan List of paths to configuration files of additional rooms hosted by the same dedicated server
+			-   Each room runs its own session on its own @cpp "ServerPort" @ce, while the loaded assets are shared by all rooms
+			-   Only the configuration the server was started with is searched for rooms, and all rooms run at its @cpp "TickRate" @ce
 		-   @cpp "AllowCheats" @ce : @m_span{m-label m-default m-flat} bool @m_endspan Whether cheats can be used on the server (default is **false**)
 			-   Admins can use cheats in any game mode, other players only in Cooperation
 			-   Cheats are applied only to the player that invoked them
@@ -256,6 +261,10 @@ namespace Jazz2::Multiplayer
 		std::int32_t IdleKickTimeSecs;
 		/** @brief Time window in seconds during which a disconnected player can reconnect and resume their progression, 0 or less to disable */
 		std::int32_t ReconnectWindowSecs;
+		/** @brief Number of simulation ticks per second of a dedicated server */
+		std::uint32_t TickRate;
+		/** @brief Paths to configuration files of additional rooms hosted by the same dedicated server */
+		SmallVector<String, 0> Rooms;
 		/** @brief Whether cheats can be used, admins in any game mode, other players only in Cooperation */
 		bool AllowCheats;
 		/** @brief List of unique player IDs with admin rights, value contains list of privileges, or `*` for all privileges */
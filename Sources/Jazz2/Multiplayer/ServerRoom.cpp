@@ -0,0 +1,575 @@
+#include "ServerRoom.h"
+
+#if defined(WITH_MULTIPLAYER)
+
+#include "MpLevelHandler.h"
+#include "NetworkManager.h"
+#include "PacketTypes.h"
+#include "../ContentResolver.h"
+#include "../PreferencesCache.h"
+#include "../Actors/ActorPool.h"
+#include "../../nCine/Application.h"
+#include "../../nCine/I18n.h"
+#include "../../nCine/tracy.h"
+#include "../../nCine/Base/Algorithms.h"
+
+#include <cstring>
+#include <mutex>
+
+#include <Containers/StringConcatenable.h>
+#include <IO/MemoryStream.h>
+
+using namespace Death::Containers::Literals;
+using namespace Death::IO;
+using namespace nCine;
+
+/** @brief @ref Death::Containers::StringView from @ref NCINE_PROTOCOL_VERSION */
+#define NCINE_PROTOCOL_VERSION_s DEATH_PASTE(NCINE_PROTOCOL_VERSION, _s)
+
+namespace Jazz2::Multiplayer
+{
+	ServerRoom::ServerRoom(IRootController* host, std::int32_t index)
+		: _host(host), _index(index)
+	{
+		// Other rooms keep running while this one loads a level, so the room needs its own references to cached assets
+		_contentHolder = ContentResolver::Get().RetainSharedContent();
+	}
+
+	ServerRoom::~ServerRoom()
+	{
+		Dispose();
+		if (_contentHolder >= 0) {
+			ContentResolver::Get().ReleaseSharedContent(_contentHolder);
+		}
+	}
+
+	bool ServerRoom::Start(ServerInitialization&& serverInit)
+	{
+		if (_contentHolder < 0) {
+			LOGE("Room {} cannot share the cached assets, too many rooms are running", _index);
+			return false;
+		}
+		if (!PrepareInitialization(serverInit)) {
+			return false;
+		}
+
+		_networkManager = std::make_unique<NetworkManager>();
+		if (!_networkManager->CreateServer(this, std::move(serverInit.Configuration))) {
+			_networkManager = nullptr;
+			return false;
+		}
+
+		auto& serverConfig = _networkManager->GetServerConfiguration();
+		LOGI("Creating {} server \"{}\" on port {} in room {}...", serverConfig.IsPrivate ? "private"_s : "public"_s,
+			serverConfig.ServerName, serverConfig.ServerPort, _index);
+
+		InvokeAsync([this, levelInit = std::move(serverInit.InitialLevel)]() {
+			if (_networkManager == nullptr) {
+				return;
+			}
+			auto levelHandler = std::make_shared<MpLevelHandler>(this,
+				_networkManager.get(), MpLevelHandler::LevelState::InitialUpdatePending, true);
+			if (!InitializeLevel(*levelHandler, levelInit)) {
+				LOGE("Failed to load initial level \"{}\" in room {}", levelInit.LevelName, _index);
+				Stop("initial level cannot be loaded"_s);
+				return;
+			}
+			SetLevelHandler(std::move(levelHandler));
+		});
+
+		return true;
+	}
+
+	void ServerRoom::Dispose()
+	{
+		if (_networkManager != nullptr) {
+			_networkManager->Dispose();
+		}
+
+		// The network thread is stopped now, so the level handler can be released safely
+		SetLevelHandler(nullptr);
+		_networkManager = nullptr;
+		_pendingAuths.clear();
+	}
+
+	bool ServerRoom::IsRunning() const
+	{
+		return (_networkManager != nullptr);
+	}
+
+	NetworkManager* ServerRoom::GetNetworkManager() const
+	{
+		return _networkManager.get();
+	}
+
+	void ServerRoom::OnBeginFrame()
+	{
+		if (!_pendingCallbacks.empty()) {
+			ZoneScopedNC("Pending callbacks", 0x888888);
+
+			std::weak_ptr<void> emptyRef;
+			Function<void()> callbackFunc;
+			std::size_t i = 0;
+
+			while (true) {
+				{
+#if defined(WITH_THREADS)
+					std::unique_lock<std::mutex> lock(_pendingCallbacksLock);
+#endif
+					if (i >= _pendingCallbacks.size()) {
+						break;
+					}
+
+					auto& callback = _pendingCallbacks[i];
+					auto& callbackRef = callback.first();
+					// Invoke the callback only if it has no corresponding reference or the reference is still alive
+					if (!callbackRef.expired() || !(callbackRef.owner_before(emptyRef) || emptyRef.owner_before(callbackRef))) {
+						// Callback cannot be invoked under the lock, because it can invoke another callback and it would cause deadlock
+						callbackFunc = std::move(callback.second());
+					} else {
+						i++;
+						continue;
+					}
+				}
+
+				callbackFunc();
+				i++;
+			}
+
+			_pendingCallbacks.clear();
+		}
+
+		if (!_pendingAuths.empty()) {
+			ProcessPendingAuths();
+		}
+
+		if (_levelHandler != nullptr) {
+			_levelHandler->OnBeginFrame();
+		}
+	}
+
+	void ServerRoom::OnEndFrame()
+	{
+		if (_levelHandler != nullptr) {
+			_levelHandler->OnEndFrame();
+		}
+	}
+
+	void ServerRoom::ProcessCommand(StringView line)
+	{
+		if (auto levelHandler = GetLevelHandler()) {
+			if (!levelHandler->ProcessCommand({}, line, true) && !line.hasPrefix('/')) {
+				levelHandler->SendMessageToAll(line, true);
+			}
+		} else {
+			LOGW("Room {} is not running", _index);
+		}
+	}
+
+	void ServerRoom::InvokeAsync(Function<void()>&& callback)
+	{
+		DEATH_DEBUG_ASSERT(callback, "callback cannot be empty", );
+
+#if defined(WITH_THREADS)
+		std::unique_lock<std::mutex> lock(_pendingCallbacksLock);
+#endif
+		_pendingCallbacks.emplace_back(std::weak_ptr<void>{}, std::move(callback));
+	}
+
+	void ServerRoom::InvokeAsync(std::weak_ptr<void> reference, Function<void()>&& callback)
+	{
+		DEATH_DEBUG_ASSERT(callback, "callback cannot be empty", );
+
+#if defined(WITH_THREADS)
+		std::unique_lock<std::mutex> lock(_pendingCallbacksLock);
+#endif
+		_pendingCallbacks.emplace_back(std::move(reference), std::move(callback));
+	}
+
+	void ServerRoom::GoToMainMenu(bool afterIntro)
+	{
+		InvokeAsync([this]() {
+			Stop("main menu requested"_s);
+		});
+	}
+
+	void ServerRoom::ChangeLevel(LevelInitialization&& levelInit)
+	{
+		InvokeAsync([this, levelInit = std::move(levelInit)]() mutable {
+			ZoneScopedNC("ServerRoom::ChangeLevel", 0x888888);
+
+			if (_networkManager == nullptr) {
+				return;
+			}
+
+			// Special targets (end of episode, credits, game over) have no meaning for a server room
+			auto p = levelInit.LevelName.partition('/');
+			auto levelName = (!p[2].empty() ? p[2] : p[0]);
+			if (levelName.empty() || levelName.hasPrefix(':')) {
+				LOGW("Room {} has no next level to load", _index);
+				Stop("no next level"_s);
+				return;
+			}
+
+			auto levelHandler = std::make_shared<MpLevelHandler>(this,
+				_networkManager.get(), MpLevelHandler::LevelState::InitialUpdatePending, true);
+			if (!InitializeLevel(*levelHandler, levelInit)) {
+				LOGW("Failed to load level \"{}\" in room {}", levelInit.LevelName, _index);
+				Stop("level cannot be loaded"_s);
+				return;
+			}
+			SetLevelHandler(std::move(levelHandler));
+		});
+	}
+
+	bool ServerRoom::HasResumableState() const
+	{
+		return false;
+	}
+
+	void ServerRoom::ResumeSavedState()
+	{
+	}
+
+	bool ServerRoom::SaveCurrentStateIfAny()
+	{
+		return false;
+	}
+
+	void ServerRoom::ConnectToServer(StringView endpoint, std::uint16_t defaultPort, StringView password)
+	{
+	}
+
+	bool ServerRoom::CreateServer(ServerInitialization&& serverInit)
+	{
+		// Rooms are created only by the hosting root controller
+		return false;
+	}
+
+	IRootController::Flags ServerRoom::GetFlags() const
+	{
+		return _host->GetFlags();
+	}
+
+	StringView ServerRoom::GetNewestVersion() const
+	{
+		return _host->GetNewestVersion();
+	}
+
+	void ServerRoom::RefreshCacheLevels(bool recreateAll)
+	{
+		_host->RefreshCacheLevels(recreateAll);
+	}
+
+	ConnectionResult ServerRoom::OnPeerConnected(const Peer& peer, std::uint32_t clientData)
+	{
+		LOGI("Peer connected to room {} ({}) [{}]", _index, _networkManager->AddressToString(peer), peer);
+
+		return AcceptPeer(*_networkManager, peer, clientData);
+	}
+
+	void ServerRoom::OnPeerDisconnected(const Peer& peer, Reason reason)
+	{
+		if (auto peerDesc = _networkManager->GetPeerDescriptor(peer)) {
+			LOGI("Peer disconnected from room {} \"{}\" ({}) [{}]: {} ({})", _index, peerDesc->PlayerName.data(),
+				_networkManager->AddressToString(peer), peer, NetworkManagerBase::ReasonToString(reason), reason);
+		} else {
+			LOGI("Peer disconnected from room {} ({}) [{}]: {} ({})", _index, _networkManager->AddressToString(peer), peer,
+				NetworkManagerBase::ReasonToString(reason), reason);
+		}
+
+		{
+			std::unique_lock lock(_pendingAuthsLock);
+			for (std::size_t i = 0; i < _pendingAuths.size(); ) {
+				if (_pendingAuths[i].Sender == peer) {
+					_pendingAuths.eraseUnordered(i);
+				} else {
+					i++;
+				}
+			}
+		}
+
+		if (auto levelHandler = GetLevelHandler()) {
+			levelHandler->OnPeerDisconnected(peer);
+		}
+	}
+
+	void ServerRoom::OnPacketReceived(const Peer& peer, std::uint8_t channelId, std::uint8_t packetType, ArrayView<const std::uint8_t> data)
+	{
+		if (ProcessServerPacket(*_networkManager, peer, packetType, data)) {
+			return;
+		}
+
+		if (auto levelHandler = GetLevelHandler()) {
+			if (levelHandler->OnPacketReceived(peer, channelId, packetType, data)) {
+				return;
+			}
+		}
+
+		if ((ClientPacketType)packetType == ClientPacketType::Auth) {
+			// Message was not processed by level handler (the level is still loading), retry it between frames,
+			// so the network thread is not blocked in the meantime
+			std::unique_lock lock(_pendingAuthsLock);
+			auto& auth = _pendingAuths.emplace_back();
+			auth.Sender = peer;
+			auth.ChannelId = channelId;
+			auth.Data.append(data);
+			auth.ReceivedTime = TimeStamp::now();
+		}
+	}
+
+	bool ServerRoom::PrepareInitialization(ServerInitialization& serverInit)
+	{
+		if (serverInit.Configuration.ServerName.empty()) {
+			serverInit.Configuration.ServerName = _("Unnamed server");
+		}
+
+		if (serverInit.Configuration.PlaylistIndex >= 0 && serverInit.Configuration.PlaylistIndex < serverInit.Configuration.Playlist.size()) {
+			auto& playlistEntry = serverInit.Configuration.Playlist[serverInit.Configuration.PlaylistIndex];
+
+			if (playlistEntry.LevelName.contains('/')) {
+				serverInit.InitialLevel.LevelName = playlistEntry.LevelName;
+			} else {
+				serverInit.InitialLevel.LevelName = "unknown/"_s + playlistEntry.LevelName;
+			}
+
+			// Override properties
+			serverInit.Configuration.ReforgedGameplay = playlistEntry.ReforgedGameplay;
+			serverInit.Configuration.Elimination = playlistEntry.Elimination;
+			serverInit.Configuration.InitialPlayerHealth = playlistEntry.InitialPlayerHealth;
+			serverInit.Configuration.MaxGameTimeSecs = playlistEntry.MaxGameTimeSecs;
+			serverInit.Configuration.PreGameSecs = playlistEntry.PreGameSecs;
+			serverInit.Configuration.TotalKills = playlistEntry.TotalKills;
+			serverInit.Configuration.TotalLaps = playlistEntry.TotalLaps;
+			serverInit.Configuration.TotalTreasureCollected = playlistEntry.TotalTreasureCollected;
+			serverInit.Configuration.AllowMinimap = playlistEntry.AllowMinimap;
+			serverInit.Configuration.ColorizePlayersByTeam = playlistEntry.ColorizePlayersByTeam;
+			serverInit.Configuration.GameMode = playlistEntry.GameMode;
+		}
+
+		if (serverInit.InitialLevel.LevelName.empty()) {
+			LOGE("Initial level is not specified");
+			return false;
+		} else if (!ContentResolver::Get().LevelExists(serverInit.InitialLevel.LevelName)) {
+			LOGE("Cannot find initial level \"{}\"", serverInit.InitialLevel.LevelName);
+			return false;
+		}
+
+		serverInit.InitialLevel.IsReforged = serverInit.Configuration.ReforgedGameplay;
+		return true;
+	}
+
+	ConnectionResult ServerRoom::AcceptPeer(NetworkManager& networkManager, const Peer& peer, std::uint32_t clientData)
+	{
+		std::uint32_t clientVersion = (clientData & 0x000FFFFF);
+		if ((clientData & 0xFFF00000) != 0xDEA00000 || clientVersion > MultiplayerProtocolVersion || clientVersion < MinMultiplayerProtocolVersion) {
+			// Connected client is newer than server or too old to understand its updates, reject it
+			LOGI("Peer kicked ({}) [{}]: Incompatible protocol version", networkManager.AddressToString(peer), peer);
+			return Reason::IncompatibleVersion;
+		}
+
+		const auto& serverConfig = networkManager.GetServerConfiguration();
+		std::uint32_t peerCount = networkManager.GetPeerCount();
+		if (peerCount >= serverConfig.MaxPlayerCount) {
+			// The connecting peer is not counted yet, so reject already when the count reaches the limit
+			LOGI("Peer kicked ({}) [{}]: Server is full ({}/{} players)", networkManager.AddressToString(peer),
+				peer, peerCount, serverConfig.MaxPlayerCount);
+			return Reason::ServerIsFull;
+		}
+
+		return true;
+	}
+
+	bool ServerRoom::ProcessServerPacket(NetworkManager& networkManager, const Peer& peer, std::uint8_t packetType, ArrayView<const std::uint8_t> data)
+	{
+		switch ((ClientPacketType)packetType) {
+			case ClientPacketType::Ping: {
+				networkManager.SendTo(peer, NetworkChannel::Main, (std::uint8_t)ServerPacketType::Pong, {});
+				return true;
+			}
+			case ClientPacketType::Auth: {
+				MemoryStream packet(data);
+				char gameID[4];
+				packet.Read(gameID, 4);
+				std::uint64_t protocolVersion = packet.ReadVariableUint64();
+
+				constexpr std::uint64_t VersionMask = ~0xFFFFFFFFULL; // Exclude patch from version check
+				constexpr std::uint64_t currentVersion = parseVersion(NCINE_PROTOCOL_VERSION_s);
+
+				if (strncmp("J2R ", gameID, sizeof("J2R ") - 1) != 0 || (protocolVersion & VersionMask) != (currentVersion & VersionMask)) {
+					LOGI("Peer kicked ({}) [{}]: Incompatible protocol version", networkManager.AddressToString(peer), peer);
+					networkManager.Kick(peer, Reason::IncompatibleVersion);
+					return true;
+				}
+
+				Uuid uuid;
+				packet.Read(uuid.data(), uuid.size());
+				String uniquePlayerId = NetworkManager::UuidToString(uuid);
+
+				LOGD("[MP] ClientPacketType::Auth [{}] - gameID: \"{}\", protocolVersion: 0x{:x}, uuid: \"{}\"",
+					peer, StringView(gameID, 4), protocolVersion, uniquePlayerId);
+
+				std::uint32_t passwordLength = packet.ReadVariableUint32();
+				String password{NoInit, passwordLength};
+				packet.Read(password.data(), passwordLength);
+
+				std::uint8_t playerNameLength = packet.ReadValue<std::uint8_t>();
+
+				// TODO: Sanitize (\n,\r,\t) and strip formatting (\f) from player name
+				if (playerNameLength == 0 || playerNameLength > MaxPlayerNameLength) {
+					LOGI("Peer kicked ({}) [{}]: Invalid player name", networkManager.AddressToString(peer), peer);
+					networkManager.Kick(peer, Reason::InvalidPlayerName);
+					return true;
+				}
+
+				String playerName{NoInit, playerNameLength};
+				packet.Read(playerName.data(), playerNameLength);
+
+				const auto& serverConfig = networkManager.GetServerConfiguration();
+				if (serverConfig.BannedUniquePlayerIDs.contains(uniquePlayerId)) {
+					LOGI("Peer kicked \"{}\" ({}) [{}]: Banned by unique player ID", playerName, networkManager.AddressToString(peer), peer);
+					networkManager.Kick(peer, Reason::Banned);
+					return true;
+				}
+				if (!serverConfig.WhitelistedUniquePlayerIDs.empty() && !serverConfig.WhitelistedUniquePlayerIDs.contains(uniquePlayerId)) {
+					LOGI("Peer kicked \"{}\" ({}) [{}]: Not in whitelist", playerName, networkManager.AddressToString(peer), peer);
+					networkManager.Kick(peer, Reason::NotInWhitelist);
+					return true;
+				}
+
+				if (!serverConfig.ServerPassword.empty() && password != serverConfig.ServerPassword) {
+					LOGI("Peer kicked \"{}\" ({}) [{}]: Invalid password", playerName, networkManager.AddressToString(peer), peer);
+					networkManager.Kick(peer, Reason::InvalidPassword);
+					return true;
+				}
+
+				std::uint8_t deviceIdLength = packet.ReadValue<std::uint8_t>();
+				String deviceId{NoInit, deviceIdLength};
+				packet.Read(deviceId.data(), deviceIdLength);
+
+				std::uint64_t playerUserId = packet.ReadVariableUint64();
+				if (serverConfig.RequiresDiscordAuth && playerUserId == 0) {
+					LOGI("Peer kicked \"{}\" ({}) [{}]: Discord authentication is required", playerName, networkManager.AddressToString(peer), peer);
+					networkManager.Kick(peer, Reason::Requires3rdPartyAuthProvider);
+					return true;
+				}
+				// TODO: Check playerUserId for whitelist (Reason::NotInWhitelist)
+
+				std::uint32_t furColor = packet.ReadValueAsLE<std::uint32_t>();
+
+				if (auto peerDesc = networkManager.GetPeerDescriptor(peer)) {
+					peerDesc->UniquePlayerID = std::move(uuid);
+					peerDesc->PlayerName = std::move(playerName);
+					peerDesc->FurColor = furColor;
+					peerDesc->IsAuthenticated = true;
+
+					if (serverConfig.AdminUniquePlayerIDs.contains(uniquePlayerId)) {
+						peerDesc->IsAdmin = true;
+					}
+
+					// Reconnect: if this player disconnected recently (and no new round invalidated it), restore
+					// their progression (weapons, lives, score, gems) and championship points so they resume
+					if (auto previous = networkManager.ReclaimDisconnectedPeer(peerDesc->UniquePlayerID)) {
+						if (previous->HasCarryOver) {
+							peerDesc->CarryOver = previous->CarryOver;
+							peerDesc->HasCarryOver = true;
+							peerDesc->Points = previous->Points;
+							peerDesc->Team = previous->Team;
+							peerDesc->PreferredPlayerType = previous->CarryOver.Type;
+							LOGI("Peer \"{}\" [{}] reconnected, restoring progression", peerDesc->PlayerName, peer);
+						}
+					}
+
+					LOGI("Peer authenticated as \"{}\" ({}){} [{}]", peerDesc->PlayerName, networkManager.AddressToString(peer),
+						peerDesc->IsAdmin ? " [Admin]" : "", peer);
+
+					MemoryStream packet(17);
+					packet.WriteValue<std::uint8_t>(0);	// Flags
+					packet.Write(PreferencesCache::UniqueServerID, PreferencesCache::UniqueServerID.size() - sizeof(std::uint16_t));
+					packet.WriteValue<std::uint16_t>(networkManager.GetServerPort());	// Server port is part of Unique Server ID
+					networkManager.SendTo(peer, NetworkChannel::Main, (std::uint8_t)ServerPacketType::AuthResponse, packet);
+				} else {
+					DEATH_ASSERT_UNREACHABLE();
+				}
+				// The level handler spawns the authenticated player
+				return false;
+			}
+			default: {
+				return false;
+			}
+		}
+	}
+
+	std::shared_ptr<MpLevelHandler> ServerRoom::GetLevelHandler() const
+	{
+		std::unique_lock lock(_levelHandlerLock);
+		return _levelHandler;
+	}
+
+	void ServerRoom::SetLevelHandler(std::shared_ptr<MpLevelHandler>&& levelHandler)
+	{
+		std::shared_ptr<MpLevelHandler> previousHandler;
+		{
+			std::unique_lock lock(_levelHandlerLock);
+			previousHandler = std::move(_levelHandler);
+			_levelHandler = std::move(levelHandler);
+		}
+		// The previous level is released outside of the lock, it can take a while
+		previousHandler = nullptr;
+
+		if (_levelHandler != nullptr) {
+			// Actors of the previous level were released with its handler, return their pooled memory to the system
+			Actors::ActorPool::Trim();
+
+			Vector2i res = theApplication().GetResolution();
+			_levelHandler->OnInitializeViewport(res.X, res.Y);
+			_networkManager->SetStatusProvider(_levelHandler);
+		}
+	}
+
+	bool ServerRoom::InitializeLevel(MpLevelHandler& levelHandler, const LevelInitialization& levelInit)
+	{
+		// Assets referenced by the level are tracked per room, so they are released only when no room uses them
+		auto& resolver = ContentResolver::Get();
+		resolver.SetLoadingHolder(_contentHolder);
+		bool result = levelHandler.Initialize(levelInit);
+		resolver.SetLoadingHolder(0);
+		return result;
+	}
+
+	void ServerRoom::ProcessPendingAuths()
+	{
+		// Kick the client if the level cannot process the authentication for too long
+		constexpr float MaxPendingSecs = 5.0f;
+
+		SmallVector<PendingAuth, 0> pendingAuths;
+		{
+			std::unique_lock lock(_pendingAuthsLock);
+			std::swap(pendingAuths, _pendingAuths);
+		}
+
+		for (auto& auth : pendingAuths) {
+			if (_levelHandler != nullptr && _levelHandler->OnPacketReceived(auth.Sender, auth.ChannelId,
+				(std::uint8_t)ClientPacketType::Auth, auth.Data)) {
+				continue;
+			}
+			if (_networkManager == nullptr) {
+				continue;
+			}
+			if (auth.ReceivedTime.secondsSince() < MaxPendingSecs) {
+				std::unique_lock lock(_pendingAuthsLock);
+				_pendingAuths.push_back(std::move(auth));
+			} else {
+				_networkManager->Kick(auth.Sender, Reason::ServerNotReady);
+			}
+		}
+	}
+
+	void ServerRoom::Stop(StringView reason)
+	{
+		LOGW("Stopping room {}: {}", _index, reason);
+		Dispose();
+	}
+}
+
+#endif
@@ -0,0 +1,138 @@
+#pragma once
+
+#if defined(WITH_MULTIPLAYER) || defined(DOXYGEN_GENERATING_OUTPUT)
+
+#include "INetworkHandler.h"
+#include "ServerInitialization.h"
+#include "../IRootController.h"
+#include "../../nCine/Base/TimeStamp.h"
+
+#include <Containers/Pair.h>
+#include <Containers/SmallVector.h>
+#include <Threading/Spinlock.h>
+
+#if defined(WITH_THREADS)
+#	include <mutex>
+#endif
+
+namespace Jazz2::Multiplayer
+{
+	class MpLevelHandler;
+	class NetworkManager;
+
+	/**
+		@brief Additional session hosted by a dedicated server
+
+		A dedicated server can host several independent sessions (rooms) in one process, each with its own
+		@ref MpLevelHandler, connected peers and port, listed in @ref ServerConfiguration::Rooms. The room acts
+		as the root controller of its level handler, so level changes and deferred callbacks stay within the
+		room, while the assets cached by @ref ContentResolver are loaded only once and shared by all rooms.
+		Each room holds its own references to the cached assets, so an asset is released once no room uses it.
+		Rooms are ticked by the hosting root controller on the main thread, because the simulation relies on
+		state that is not thread-safe, their root nodes are attached to the same scene graph.
+
+		@experimental
+	*/
+	class ServerRoom : public IRootController, public INetworkHandler
+	{
+	public:
+		/** @brief Version of the multiplayer protocol accepted by the server */
+		static constexpr std::uint32_t MultiplayerProtocolVersion = 2;
+		/** @brief Oldest version of the multiplayer protocol accepted by the server (bit-packed actor updates) */
+		static constexpr std::uint32_t MinMultiplayerProtocolVersion = 2;
+		/** @brief Maximum length of a player name in bytes */
+		static constexpr std::uint32_t MaxPlayerNameLength = 32;
+
+		/** @brief Creates a new room owned by the specified root controller */
+		ServerRoom(IRootController* host, std::int32_t index);
+		~ServerRoom() override;
+
+		/** @brief Creates the server of the room and loads its initial level asynchronously */
+		bool Start(ServerInitialization&& serverInit);
+		/** @brief Disconnects all peers and releases the level of the room */
+		void Dispose();
+
+		/** @brief Returns index of the room */
+		std::int32_t GetIndex() const {
+			return _index;
+		}
+
+		/** @brief Returns `true` if the server of the room is running */
+		bool IsRunning() const;
+		/** @brief Returns the network manager of the room, or `nullptr` if it's not running */
+		NetworkManager* GetNetworkManager() const;
+
+		/** @brief Called by the host at the beginning of each frame (tick) */
+		void OnBeginFrame();
+		/** @brief Called by the host at the end of each frame (tick) */
+		void OnEndFrame();
+		/** @brief Processes a server console command or sends the line as a message to all players of the room */
+		void ProcessCommand(StringView line);
+
+		void InvokeAsync(Function<void()>&& callback) override;
+		void InvokeAsync(std::weak_ptr<void> reference, Function<void()>&& callback) override;
+		void GoToMainMenu(bool afterIntro) override;
+		void ChangeLevel(LevelInitialization&& levelInit) override;
+		bool HasResumableState() const override;
+		void ResumeSavedState() override;
+		bool SaveCurrentStateIfAny() override;
+
+		void ConnectToServer(StringView endpoint, std::uint16_t defaultPort, StringView password = {}) override;
+		bool CreateServer(ServerInitialization&& serverInit) override;
+
+		Flags GetFlags() const override;
+		StringView GetNewestVersion() const override;
+		void RefreshCacheLevels(bool recreateAll) override;
+
+		ConnectionResult OnPeerConnected(const Peer& peer, std::uint32_t clientData) override;
+		void OnPeerDisconnected(const Peer& peer, Reason reason) override;
+		void OnPacketReceived(const Peer& peer, std::uint8_t channelId, std::uint8_t packetType, ArrayView<const std::uint8_t> data) override;
+
+		/**
+		 * @brief Resolves the initial level of a server from its playlist and verifies that it exists
+		 *
+		 * Shared by all servers created in the process, so the rooms follow the same rules as the main session.
+		 */
+		static bool PrepareInitialization(ServerInitialization& serverInit);
+		/** @brief Decides whether a peer connecting to the specified server is accepted */
+		static ConnectionResult AcceptPeer(NetworkManager& networkManager, const Peer& peer, std::uint32_t clientData);
+		/**
+		 * @brief Handles session-independent client packets (ping and authentication) received by the specified server
+		 *
+		 * Returns `true` if the packet was fully processed and shouldn't be passed to the level handler.
+		 */
+		static bool ProcessServerPacket(NetworkManager& networkManager, const Peer& peer, std::uint8_t packetType, ArrayView<const std::uint8_t> data);
+
+	private:
+		// Authentication that arrived before the level of the room was ready
+		struct PendingAuth {
+			Peer Sender;
+			std::uint8_t ChannelId;
+			SmallVector<std::uint8_t, 0> Data;
+			TimeStamp ReceivedTime;
+		};
+
+		IRootController* _host;
+		std::int32_t _index;
+		// Holder of the cached assets referenced by levels of the room, see ContentResolver::RetainSharedContent()
+		std::int32_t _contentHolder;
+		std::unique_ptr<NetworkManager> _networkManager;
+		std::shared_ptr<MpLevelHandler> _levelHandler;
+		// Guards `_levelHandler` which is also read from the network thread
+		mutable Death::Threading::Spinlock _levelHandlerLock;
+		SmallVector<Pair<std::weak_ptr<void>, Function<void()>>> _pendingCallbacks;
+#if defined(WITH_THREADS)
+		std::mutex _pendingCallbacksLock;
+#endif
+		SmallVector<PendingAuth, 0> _pendingAuths;
+		Death::Threading::Spinlock _pendingAuthsLock;
+
+		std::shared_ptr<MpLevelHandler> GetLevelHandler() const;
+		void SetLevelHandler(std::shared_ptr<MpLevelHandler>&& levelHandler);
+		bool InitializeLevel(MpLevelHandler& levelHandler, const LevelInitialization& levelInit);
+		void ProcessPendingAuths();
+		void Stop(StringView reason);
+	};
+}
+
+#endif
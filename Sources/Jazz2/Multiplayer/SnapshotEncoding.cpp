@@ -0,0 +1,207 @@
+#include "SnapshotEncoding.h"
+
+#if defined(WITH_MULTIPLAYER)
+
+namespace Jazz2::Multiplayer
+{
+	namespace
+	{
+		// Value widths selected by the 2-bit prefix of variable-length integers. Position differences of slowly moving
+		// actors fit into the smallest class, absolute positions within a level into the third one.
+		constexpr std::int32_t VariableBitWidths[4] = { 6, 12, 20, 32 };
+
+		constexpr std::int32_t MiscFlagsShift = 2;
+		constexpr std::int32_t MiscFlagsBits = 5;
+		constexpr std::int32_t FieldsBits = 5;
+		constexpr std::int32_t RendererTypeBits = 3;
+
+		std::uint32_t ZigZagEncode(std::int32_t value)
+		{
+			return ((std::uint32_t)value << 1) ^ (std::uint32_t)(value >> 31);
+		}
+
+		std::int32_t ZigZagDecode(std::uint32_t value)
+		{
+			return (std::int32_t)(value >> 1) ^ -(std::int32_t)(value & 1);
+		}
+	}
+
+	BitWriter::BitWriter(std::uint8_t* data, std::size_t capacity)
+		: _data(data), _capacity(capacity), _position(0), _pending(0), _pendingBits(0)
+	{
+	}
+
+	void BitWriter::WriteBits(std::uint32_t value, std::int32_t bitCount)
+	{
+		DEATH_DEBUG_ASSERT(bitCount > 0 && bitCount <= 32, "Bit count out of range", );
+
+		std::uint64_t mask = (bitCount == 32 ? 0xFFFFFFFFull : ((1ull << bitCount) - 1));
+		_pending |= ((std::uint64_t)value & mask) << _pendingBits;
+		_pendingBits += bitCount;
+
+		while (_pendingBits >= 8) {
+			DEATH_DEBUG_ASSERT(_position < _capacity, "Bit buffer overflow", );
+			_data[_position++] = (std::uint8_t)_pending;
+			_pending >>= 8;
+			_pendingBits -= 8;
+		}
+	}
+
+	void BitWriter::WriteVariableUint32(std::uint32_t value)
+	{
+		std::int32_t sizeClass = 0;
+		while (sizeClass < 3 && (value >> VariableBitWidths[sizeClass]) != 0) {
+			sizeClass++;
+		}
+		WriteBits((std::uint32_t)sizeClass, 2);
+		WriteBits(value, VariableBitWidths[sizeClass]);
+	}
+
+	void BitWriter::WriteVariableInt32(std::int32_t value)
+	{
+		WriteVariableUint32(ZigZagEncode(value));
+	}
+
+	std::size_t BitWriter::Flush()
+	{
+		if (_pendingBits > 0) {
+			DEATH_DEBUG_ASSERT(_position < _capacity, "Bit buffer overflow", _position);
+			_data[_position++] = (std::uint8_t)_pending;
+			_pending = 0;
+			_pendingBits = 0;
+		}
+		return _position;
+	}
+
+	BitReader::BitReader(const std::uint8_t* data, std::size_t size)
+		: _data(data), _size(size), _position(0), _pending(0), _pendingBits(0), _isValid(true)
+	{
+	}
+
+	std::uint32_t BitReader::ReadBits(std::int32_t bitCount)
+	{
+		DEATH_DEBUG_ASSERT(bitCount > 0 && bitCount <= 32, "Bit count out of range", 0);
+
+		while (_pendingBits < bitCount) {
+			if DEATH_UNLIKELY(_position >= _size) {
+				_isValid = false;
+				return 0;
+			}
+			_pending |= (std::uint64_t)_data[_position++] << _pendingBits;
+			_pendingBits += 8;
+		}
+
+		std::uint64_t mask = (bitCount == 32 ? 0xFFFFFFFFull : ((1ull << bitCount) - 1));
+		std::uint32_t value = (std::uint32_t)(_pending & mask);
+		_pending >>= bitCount;
+		_pendingBits -= bitCount;
+		return value;
+	}
+
+	std::uint32_t BitReader::ReadVariableUint32()
+	{
+		std::uint32_t sizeClass = ReadBits(2);
+		return ReadBits(VariableBitWidths[sizeClass]);
+	}
+
+	std::int32_t BitReader::ReadVariableInt32()
+	{
+		return ZigZagDecode(ReadVariableUint32());
+	}
+
+	void WriteActorSnapshot(BitWriter& writer, std::uint32_t actorId, const ActorSnapshot& current, ActorSnapshot& baseline, bool fullUpdate)
+	{
+		// A warped actor gets an absolute position, so the client doesn't depend on the previous one at all
+		bool absolutePosition = (fullUpdate || (current.Flags & 0x40) != 0);
+
+		SnapshotFields fields = SnapshotFields::None;
+		if (absolutePosition || current.PosX != baseline.PosX || current.PosY != baseline.PosY) {
+			fields |= SnapshotFields::Position;
+		}
+		if (fullUpdate || current.Animation != baseline.Animation) {
+			fields |= SnapshotFields::Animation;
+		}
+		if (fullUpdate || current.Rotation != baseline.Rotation) {
+			fields |= SnapshotFields::Rotation;
+		}
+		if (fullUpdate || current.ScaleX != baseline.ScaleX || current.ScaleY != baseline.ScaleY) {
+			fields |= SnapshotFields::Scale;
+		}
+		if (fullUpdate || current.RendererType != baseline.RendererType) {
+			fields |= SnapshotFields::RendererType;
+		}
+
+		writer.WriteVariableUint32(actorId);
+		writer.WriteBits((current.Flags & ActorSnapshot::MiscFlagsMask) >> MiscFlagsShift, MiscFlagsBits);
+		writer.WriteBits((std::uint32_t)fields, FieldsBits);
+
+		if ((fields & SnapshotFields::Position) == SnapshotFields::Position) {
+			writer.WriteBool(absolutePosition);
+			if (absolutePosition) {
+				writer.WriteVariableInt32(current.PosX);
+				writer.WriteVariableInt32(current.PosY);
+			} else {
+				writer.WriteVariableInt32(current.PosX - baseline.PosX);
+				writer.WriteVariableInt32(current.PosY - baseline.PosY);
+			}
+		}
+		if ((fields & SnapshotFields::Animation) == SnapshotFields::Animation) {
+			writer.WriteVariableUint32(current.Animation);
+		}
+		if ((fields & SnapshotFields::Rotation) == SnapshotFields::Rotation) {
+			writer.WriteBits(current.Rotation, 16);
+		}
+		if ((fields & SnapshotFields::Scale) == SnapshotFields::Scale) {
+			writer.WriteBits(current.ScaleX, 16);
+			writer.WriteBits(current.ScaleY, 16);
+		}
+		if ((fields & SnapshotFields::RendererType) == SnapshotFields::RendererType) {
+			writer.WriteBits(current.RendererType, RendererTypeBits);
+		}
+
+		baseline = current;
+	}
+
+	std::uint32_t ReadActorSnapshotId(BitReader& reader)
+	{
+		return reader.ReadVariableUint32();
+	}
+
+	SnapshotFields ReadActorSnapshot(BitReader& reader, ActorSnapshot& baseline, bool baselineValid)
+	{
+		baseline.Flags = (std::uint8_t)(reader.ReadBits(MiscFlagsBits) << MiscFlagsShift);
+		SnapshotFields fields = (SnapshotFields)reader.ReadBits(FieldsBits);
+
+		if ((fields & SnapshotFields::Position) == SnapshotFields::Position) {
+			bool absolutePosition = reader.ReadBool();
+			std::int32_t x = reader.ReadVariableInt32();
+			std::int32_t y = reader.ReadVariableInt32();
+			if (absolutePosition) {
+				baseline.PosX = x;
+				baseline.PosY = y;
+			} else if (baselineValid) {
+				baseline.PosX += x;
+				baseline.PosY += y;
+			} else {
+				fields &= ~SnapshotFields::Position;
+			}
+		}
+		if ((fields & SnapshotFields::Animation) == SnapshotFields::Animation) {
+			baseline.Animation = reader.ReadVariableUint32();
+		}
+		if ((fields & SnapshotFields::Rotation) == SnapshotFields::Rotation) {
+			baseline.Rotation = (std::uint16_t)reader.ReadBits(16);
+		}
+		if ((fields & SnapshotFields::Scale) == SnapshotFields::Scale) {
+			baseline.ScaleX = (std::uint16_t)reader.ReadBits(16);
+			baseline.ScaleY = (std::uint16_t)reader.ReadBits(16);
+		}
+		if ((fields & SnapshotFields::RendererType) == SnapshotFields::RendererType) {
+			baseline.RendererType = (std::uint8_t)reader.ReadBits(RendererTypeBits);
+		}
+
+		return fields;
+	}
+}
+
+#endif
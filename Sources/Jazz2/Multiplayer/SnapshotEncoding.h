@@ -0,0 +1,157 @@
+#pragma once
+
+#if defined(WITH_MULTIPLAYER) || defined(DOXYGEN_GENERATING_OUTPUT)
+
+#include "../../Main.h"
+
+namespace Jazz2::Multiplayer
+{
+	/**
+		@brief Writes values with bit granularity into a fixed-size buffer
+
+		Bits are packed LSB-first into little-endian bytes. The buffer must be large enough for everything written,
+		which is only checked in debug builds.
+	*/
+	class BitWriter
+	{
+	public:
+		/** @brief Creates a new writer filling the specified buffer */
+		BitWriter(std::uint8_t* data, std::size_t capacity);
+
+		/** @brief Writes the lowest @p bitCount bits of @p value (at most 32) */
+		void WriteBits(std::uint32_t value, std::int32_t bitCount);
+		/** @brief Writes a single bit */
+		void WriteBool(bool value) {
+			WriteBits(value ? 1 : 0, 1);
+		}
+		/** @brief Writes an unsigned integer using 8 to 34 bits depending on its magnitude */
+		void WriteVariableUint32(std::uint32_t value);
+		/** @brief Writes a signed integer using 8 to 34 bits depending on its magnitude (zigzag-encoded) */
+		void WriteVariableInt32(std::int32_t value);
+
+		/** @brief Writes the remaining partial byte and returns the number of bytes written */
+		std::size_t Flush();
+
+	private:
+		std::uint8_t* _data;
+		std::size_t _capacity;
+		std::size_t _position;
+		std::uint64_t _pending;
+		std::int32_t _pendingBits;
+	};
+
+	/**
+		@brief Reads values written by @ref BitWriter
+
+		Reading past the end of the buffer returns zero bits and marks the reader invalid, so a malformed packet
+		can be detected once after reading it all.
+	*/
+	class BitReader
+	{
+	public:
+		/** @brief Creates a new reader of the specified buffer */
+		BitReader(const std::uint8_t* data, std::size_t size);
+
+		/** @brief Reads @p bitCount bits (at most 32) */
+		std::uint32_t ReadBits(std::int32_t bitCount);
+		/** @brief Reads a single bit */
+		bool ReadBool() {
+			return (ReadBits(1) != 0);
+		}
+		/** @brief Reads an unsigned integer written by @ref BitWriter::WriteVariableUint32() */
+		std::uint32_t ReadVariableUint32();
+		/** @brief Reads a signed integer written by @ref BitWriter::WriteVariableInt32() */
+		std::int32_t ReadVariableInt32();
+
+		/** @brief Returns `false` if the reader ran past the end of the buffer */
+		bool IsValid() const {
+			return _isValid;
+		}
+
+	private:
+		const std::uint8_t* _data;
+		std::size_t _size;
+		std::size_t _position;
+		std::uint64_t _pending;
+		std::int32_t _pendingBits;
+		bool _isValid;
+	};
+
+	/**
+		@brief State of a remote actor as transferred in periodic updates
+
+		Values are quantized the same way as on the wire, so the state last sent by the server is exactly the state
+		last received by the client. Each update then carries only the fields that changed since the previous update,
+		and the position only as a difference from the previous one.
+	*/
+	struct ActorSnapshot
+	{
+		/** @brief Number of position units per pixel */
+		static constexpr float PositionScale = 16.0f;
+		/** @brief Worst-case size of one actor in an update, in bytes */
+		static constexpr std::size_t MaxEncodedSize = 26;
+
+		/** @brief Bits of @ref Flags that are transferred with every update, see `RemoteActor::SyncMiscWithServer()` */
+		static constexpr std::uint8_t MiscFlagsMask = 0x7C;
+
+		/** @brief Quantized X coordinate */
+		std::int32_t PosX = 0;
+		/** @brief Quantized Y coordinate */
+		std::int32_t PosY = 0;
+		/** @brief Animation state */
+		std::uint32_t Animation = 0;
+		/** @brief Rotation mapped to the full 16-bit range */
+		std::uint16_t Rotation = 0;
+		/** @brief Horizontal scale as half-precision float */
+		std::uint16_t ScaleX = 0;
+		/** @brief Vertical scale as half-precision float */
+		std::uint16_t ScaleY = 0;
+		/** @brief Renderer type */
+		std::uint8_t RendererType = 0;
+		/** @brief Visibility, paused animation, flipping and warp flags */
+		std::uint8_t Flags = 0;
+
+		/** @brief Quantizes a coordinate */
+		static std::int32_t QuantizePosition(float value) {
+			return (std::int32_t)(value * PositionScale);
+		}
+		/** @brief Converts a quantized coordinate back */
+		static float DequantizePosition(std::int32_t value) {
+			return (float)value / PositionScale;
+		}
+	};
+
+	/** @brief Fields of @ref ActorSnapshot that were transferred in an update */
+	enum class SnapshotFields : std::uint8_t
+	{
+		None = 0,
+		Position = 0x01,		/**< Position changed */
+		Animation = 0x02,		/**< Animation state changed */
+		Rotation = 0x04,		/**< Rotation changed */
+		Scale = 0x08,			/**< Scale changed */
+		RendererType = 0x10,	/**< Renderer type changed */
+
+		AnyAnimation = Animation | Rotation | Scale | RendererType	/**< Any field describing the animation changed */
+	};
+
+	DEATH_ENUM_FLAGS(SnapshotFields);
+
+	/**
+	 * @brief Writes an actor to an update and replaces @p baseline with its current state
+	 *
+	 * If @p fullUpdate is `true`, all fields are written and the position is absolute, otherwise only the changed
+	 * fields are written against @p baseline.
+	 */
+	void WriteActorSnapshot(BitWriter& writer, std::uint32_t actorId, const ActorSnapshot& current, ActorSnapshot& baseline, bool fullUpdate);
+	/** @brief Reads the identifier of the next actor in an update */
+	std::uint32_t ReadActorSnapshotId(BitReader& reader);
+	/**
+	 * @brief Reads the state of an actor from an update and applies it to @p baseline
+	 *
+	 * A position difference is applied only if @p baselineValid is `true`, otherwise it's skipped and missing from
+	 * the returned fields. The misc flags are always read.
+	 */
+	SnapshotFields ReadActorSnapshot(BitReader& reader, ActorSnapshot& baseline, bool baselineValid);
+}
+
+#endif
@@ -6,6 +6,7 @@
 
 #include "../nCine/Application.h"
 #include "../nCine/I18n.h"
+#include "../nCine/Base/FrameProfiler.h"
 #include "../nCine/Base/Random.h"
 
 #include <Containers/StringConcatenable.h>
@@ -77,6 +78,7 @@ namespace Jazz2
 	bool PreferencesCache::EnableReforgedMainMenuInitial = true;
 #endif
 	bool PreferencesCache::EnableContinuousJump = true;
+	bool PreferencesCache::FixedTimestep = false;
 	bool PreferencesCache::EnableLedgeClimb = true;
 	WeaponWheelStyle PreferencesCache::WeaponWheel = WeaponWheelStyle::Enabled;
 	bool PreferencesCache::SwitchToNewWeapon = true;
@@ -1138,6 +1140,7 @@ namespace
 
 					if (version >= 15) {
 						ShowMinimap = ((boolOptions & BoolOptions::ShowMinimap) == BoolOptions::ShowMinimap);
+						FixedTimestep = ((boolOptions & BoolOptions::FixedTimestep) == BoolOptions::FixedTimestep);
 						PlayerFurColor = uc.ReadValueAsLE<std::uint32_t>();
 						PlayerColors = (PlayerColorMode)uc.ReadValue<std::uint8_t>();
 					}
@@ -1197,6 +1200,11 @@ namespace
 		!defined(DEATH_TARGET_WII) && !defined(DEATH_TARGET_GAMECUBE) && !defined(DEATH_TARGET_PS2) && \
 		!defined(DEATH_TARGET_PSP) && !defined(DEATH_TARGET_VITA) && !defined(DEATH_TARGET_DREAMCAST) && \
 		!defined(DEATH_TARGET_PS3)
+#	if defined(WITH_FRAME_PROFILER)
+		// Profiles are dumped next to the config file, even if the recording is started later by a server command
+		FrameProfiler::SetOutputDirectory(fs::GetDirectoryName(_configPath));
+#	endif
+
 		// Override some settings by command-line arguments
 		for (std::int32_t i = 0; i < config.argc(); i++) {
 			auto arg = config.argv(i);
@@ -1241,6 +1249,21 @@ namespace
 			} else if (arg == "/reset-controls"_s) {
 				ControlScheme::Reset();
 			}
+#	if defined(WITH_FRAME_PROFILER)
+			else if (arg == "/profile"_s || arg.hasPrefix("/profile:"_s)) {
+				// "/profile:<ms>" also dumps the recorded zones after each frame that takes longer than that
+				if (arg.size() > "/profile:"_s.size()) {
+					char* end;
+					float paramValue = strtof(arg.exceptPrefix("/profile:"_s).data(), &end);
+					if (paramValue > 0.0f) {
+						FrameProfiler::SetSlowFrameThreshold(paramValue);
+					}
+				}
+				FrameProfiler::SetEnabled(true);
+			} else if (arg == "/profile-binary"_s) {
+				FrameProfiler::SetDumpFormat(FrameProfiler::DumpFormat::Binary);
+			}
+#	endif
 #	if defined(DEATH_TARGET_EMSCRIPTEN)
 			else if (arg == "/standalone"_s) {
 				IsStandalone = true;
@@ -1303,6 +1326,7 @@ namespace
 		if (EnableTouchJoystick) boolOptions |= BoolOptions::EnableTouchJoystick;
 		if (EnableTouchVibration) boolOptions |= BoolOptions::EnableTouchVibration;
 		if (ShowMinimap) boolOptions |= BoolOptions::ShowMinimap;
+		if (FixedTimestep) boolOptions |= BoolOptions::FixedTimestep;
 		co.WriteValueAsLE<std::uint64_t>(std::uint64_t(boolOptions));
 
 		if (Language[0] != '\0') {
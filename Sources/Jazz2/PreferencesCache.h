@@ -305,6 +305,8 @@ namespace Jazz2
 #endif
 		/** @brief Whether continuous jump is enabled */
 		static bool EnableContinuousJump;
+		/** @brief Whether gameplay runs in fixed ticks with interpolated rendering, so it doesn't depend on the frame rate */
+		static bool FixedTimestep;
 		/** @brief Whether ledge climbing is enabled */
 		static bool EnableLedgeClimb;
 		/** @brief Current weapon wheel style */
@@ -443,7 +445,8 @@ namespace Jazz2
 			EnableTouchJoystick = 0x40000000,
 			EnableTouchVibration = 0x80000000,
 
-			ShowMinimap = 0x100000000
+			ShowMinimap = 0x100000000,
+			FixedTimestep = 0x200000000
 		};
 
 		DEATH_PRIVATE_ENUM_FLAGS(BoolOptions);
@@ -0,0 +1,140 @@
+﻿#include "ActorCullingNode.h"
+#include "../Actors/ActorBase.h"
+
+#include "../../nCine/Application.h"
+#include "../../nCine/Graphics/RenderResources.h"
+#include "../../nCine/Graphics/Viewport.h"
+#include "../../nCine/tracy.h"
+
+#include <algorithm>
+
+namespace Jazz2::Rendering
+{
+	ActorCullingNode::ActorCullingNode()
+		: _gridSize(1, 1)
+	{
+		// Actor renderers are members of the actors, so they must never be deleted by the node
+		setDeleteChildrenOnDestruction(false);
+		_cells.resize(1);
+	}
+
+	void ActorCullingNode::SetLevelBounds(Vector2i levelBounds)
+	{
+		Vector2i gridSize = Vector2i(std::max((levelBounds.X + CellSize - 1) / CellSize, 1),
+			std::max((levelBounds.Y + CellSize - 1) / CellSize, 1));
+		if (gridSize == _gridSize) {
+			return;
+		}
+
+		SmallVector<Actors::ActorBase*, 0> actors;
+		for (auto& cell : _cells) {
+			actors.append(cell.begin(), cell.end());
+		}
+
+		_gridSize = gridSize;
+		_cells.clear();
+		_cells.resize(std::size_t(gridSize.X) * gridSize.Y);
+
+		for (Actors::ActorBase* actor : actors) {
+			actor->_cullingCell = GetCellIndex(actor->_pos);
+			_cells[actor->_cullingCell].push_back(actor);
+		}
+	}
+
+	void ActorCullingNode::AddActor(Actors::ActorBase* actor)
+	{
+		actor->_cullingCell = (actor->HasUnboundedDraw() ? UnboundedCell : GetCellIndex(actor->_pos));
+		GetCell(actor->_cullingCell).push_back(actor);
+	}
+
+	void ActorCullingNode::UpdateActor(Actors::ActorBase* actor)
+	{
+		if (actor->_cullingCell < 0) {
+			return;
+		}
+
+		std::int32_t cellIndex = GetCellIndex(actor->_pos);
+		if (cellIndex != actor->_cullingCell) {
+			RemoveActor(actor);
+			actor->_cullingCell = cellIndex;
+			_cells[cellIndex].push_back(actor);
+		}
+	}
+
+	void ActorCullingNode::RemoveActor(Actors::ActorBase* actor)
+	{
+		if (actor->_cullingCell == -1) {
+			return;
+		}
+
+		auto& cell = GetCell(actor->_cullingCell);
+		for (std::size_t i = 0; i < cell.size(); i++) {
+			if (cell[i] == actor) {
+				cell.eraseUnordered(i);
+				break;
+			}
+		}
+		actor->_cullingCell = -1;
+	}
+
+	void ActorCullingNode::OnVisit(RenderQueue& renderQueue, std::uint32_t& visitOrderIndex)
+	{
+		const Viewport* viewport = RenderResources::GetCurrentViewport();
+		if (!theApplication().GetRenderingSettings().cullingEnabled || viewport == nullptr) {
+			SceneNode::OnVisit(renderQueue, visitOrderIndex);
+			return;
+		}
+
+		if (!_drawEnabled) {
+			return;
+		}
+
+		ZoneScopedC(0x81A861);
+
+		// The node itself draws nothing, only its visit order index is updated like in SceneNode::OnVisit()
+		_visitOrderIndex = visitOrderIndex;
+
+		_visibleNodes.clear();
+		for (Actors::ActorBase* actor : _unboundedActors) {
+			_visibleNodes.push_back(&actor->_renderer);
+		}
+
+		const Rectf& cullingRect = viewport->GetCullingRect();
+		const std::int32_t x1 = std::clamp(std::int32_t((cullingRect.X - DrawMargin) / CellSize), 0, _gridSize.X - 1);
+		const std::int32_t y1 = std::clamp(std::int32_t((cullingRect.Y - DrawMargin) / CellSize), 0, _gridSize.Y - 1);
+		const std::int32_t x2 = std::clamp(std::int32_t((cullingRect.X + cullingRect.W + DrawMargin) / CellSize), 0, _gridSize.X - 1);
+		const std::int32_t y2 = std::clamp(std::int32_t((cullingRect.Y + cullingRect.H + DrawMargin) / CellSize), 0, _gridSize.Y - 1);
+
+		for (std::int32_t y = y1; y <= y2; y++) {
+			for (std::int32_t x = x1; x <= x2; x++) {
+				for (Actors::ActorBase* actor : _cells[y * _gridSize.X + x]) {
+					_visibleNodes.push_back(&actor->_renderer);
+				}
+			}
+		}
+
+		// Same order as SceneNode::OnVisit(), otherwise the draw order of overlapping actors in the same layer
+		// would depend on the cells and change whenever an actor moves to another one
+		std::sort(_visibleNodes.begin(), _visibleNodes.end(), [](const SceneNode* a, const SceneNode* b) {
+			return a->childOrderIndex() < b->childOrderIndex();
+		});
+		for (SceneNode* node : _visibleNodes) {
+			node->OnVisit(renderQueue, visitOrderIndex);
+		}
+	}
+
+	std::int32_t ActorCullingNode::GetCellIndex(Vector2f pos) const
+	{
+		// Positions outside of the level (and NaNs) end up in the border cells
+		const float cx = pos.X / CellSize;
+		const float cy = pos.Y / CellSize;
+		const std::int32_t x = (cx > 0.0f ? std::int32_t(std::min(cx, float(_gridSize.X - 1))) : 0);
+		const std::int32_t y = (cy > 0.0f ? std::int32_t(std::min(cy, float(_gridSize.Y - 1))) : 0);
+		return y * _gridSize.X + x;
+	}
+
+	SmallVectorImpl<Actors::ActorBase*>& ActorCullingNode::GetCell(std::int32_t cellIndex)
+	{
+		return (cellIndex == UnboundedCell ? _unboundedActors : _cells[cellIndex]);
+	}
+}
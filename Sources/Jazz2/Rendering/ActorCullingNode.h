@@ -0,0 +1,68 @@
+﻿#pragma once
+
+#include "../../Main.h"
+
+#include "../../nCine/Graphics/SceneNode.h"
+#include "../../nCine/Primitives/Vector2.h"
+
+#include <Containers/SmallVector.h>
+
+using namespace Death::Containers;
+using namespace nCine;
+
+namespace Jazz2::Actors
+{
+	class ActorBase;
+}
+
+namespace Jazz2::Rendering
+{
+	/**
+		@brief Parent node of all actors that visits only the ones near the current viewport
+		
+		Actors are binned by their position into a coarse uniform grid over the level. A viewport visit only
+		walks the cells overlapping its culling rectangle enlarged by @ref DrawMargin, so the cost scales with
+		the visible actors instead of all active ones, which matters most in split-screen where it's paid once
+		per viewport. Actors that can draw further from their position are always visited, see
+		@ref Actors::ActorBase::HasUnboundedDraw(). The visit order index is part of the sort key of actors in
+		the same layer, so the visible actors are still visited in the order of the children of this node.
+	*/
+	class ActorCullingNode : public SceneNode
+	{
+	public:
+		/** @{ @name Constants */
+
+		/** @brief Size of a grid cell in pixels */
+		static constexpr std::int32_t CellSize = 256;
+		/** @brief Maximum distance from the actor position that the actor is expected to draw at */
+		static constexpr float DrawMargin = 256.0f;
+
+		/** @} */
+
+		ActorCullingNode();
+
+		/** @brief Resizes the grid to cover the level, actors outside of it are kept in the border cells */
+		void SetLevelBounds(Vector2i levelBounds);
+
+		/** @brief Registers an actor that is already attached to this node */
+		void AddActor(Actors::ActorBase* actor);
+		/** @brief Moves an actor to the cell of its current position */
+		void UpdateActor(Actors::ActorBase* actor);
+		/** @brief Unregisters an actor, it's no longer visited */
+		void RemoveActor(Actors::ActorBase* actor);
+
+		void OnVisit(RenderQueue& renderQueue, std::uint32_t& visitOrderIndex) override;
+
+	private:
+		/** @brief Cell index of actors that are visited regardless of their position */
+		static constexpr std::int32_t UnboundedCell = -2;
+
+		Vector2i _gridSize;
+		SmallVector<SmallVector<Actors::ActorBase*, 0>, 0> _cells;
+		SmallVector<Actors::ActorBase*, 0> _unboundedActors;
+		SmallVector<SceneNode*, 0> _visibleNodes;
+
+		std::int32_t GetCellIndex(Vector2f pos) const;
+		SmallVectorImpl<Actors::ActorBase*>& GetCell(std::int32_t cellIndex);
+	};
+}
@@ -30,7 +30,7 @@ namespace Jazz2::Rendering
 			_renderCommand.GetMaterial().ReserveUniformsDataMemory();
 			_renderCommand.GetGeometry().SetDrawParameters(PrimitiveType::TriangleStrip, 0, 4);
 		}
-		_renderCommand.SetTransformation(Matrix4x4f::Translation((float)x, (float)y, 0.0f));
+		_renderCommand.SetTransformation(Matrix2x3f::Translation((float)x, (float)y));
 #else
 		if (_renderCommand.GetMaterial().SetShader(_owner->_levelHandler->_combineShader)) {
 			_renderCommand.GetMaterial().ReserveUniformsDataMemory();
@@ -78,8 +78,8 @@ namespace Jazz2::Rendering
 			}
 		}
 
-		_renderCommand.SetTransformation(Matrix4x4f::Translation((float)x, (float)y, 0.0f));
-		_renderCommandWithWater.SetTransformation(Matrix4x4f::Translation((float)x, (float)y, 0.0f));
+		_renderCommand.SetTransformation(Matrix2x3f::Translation((float)x, (float)y));
+		_renderCommandWithWater.SetTransformation(Matrix2x3f::Translation((float)x, (float)y));
 #endif
 	}
 
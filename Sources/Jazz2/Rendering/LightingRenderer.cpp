@@ -1,6 +1,7 @@
 ﻿#include "LightingRenderer.h"
 #include "PlayerViewport.h"
 
+#include "../../nCine/Base/FrameArena.h"
 #include "../../nCine/Graphics/RenderBuffersManager.h"
 #include "../../nCine/Graphics/RenderQueue.h"
 #include "../../nCine/Graphics/RenderResources.h"
@@ -47,7 +48,10 @@ namespace Jazz2::Rendering
 		const float cullMinX = cullingRect.X, cullMaxX = cullingRect.X + cullingRect.W;
 		const float cullMinY = cullingRect.Y, cullMaxY = cullingRect.Y + cullingRect.H;
 
-		_vertices.clear();
+		// Sized for every collected light, the part the culling dropped is given back to the arena afterwards.
+		// The host vertex pointers below reference it until the render queue is flushed.
+		ArrayView<float> vertices = FrameArena::AllocateArray<float>(_emittedLightsCache.size() * 6 * FloatsPerVertex);
+		float* v = vertices.data();
 		for (auto& light : _emittedLightsCache) {
 			// A light with no far radius covers no pixels at all (the quad the shader path built for it was
 			// zero-sized), and its normalized near radius would divide by zero
@@ -59,10 +63,11 @@ namespace Jazz2::Rendering
 				continue;
 			}
 
-			AppendLightQuad(light);
+			v = AppendLightQuad(v, light);
 		}
 
-		if (_vertices.empty()) {
+		vertices = FrameArena::Shrink(vertices, (std::size_t)(v - vertices.data()));
+		if (vertices.empty()) {
 			return true;
 		}
 
@@ -73,7 +78,7 @@ namespace Jazz2::Rendering
 		std::uint32_t maxVerticesPerChunk = maxVertexDataSize / (FloatsPerVertex * sizeof(float));
 		maxVerticesPerChunk -= (maxVerticesPerChunk % 6);
 
-		const std::uint32_t totalVertices = (std::uint32_t)(_vertices.size() / FloatsPerVertex);
+		const std::uint32_t totalVertices = (std::uint32_t)(vertices.size() / FloatsPerVertex);
 		std::int32_t commandIndex = 0;
 		for (std::uint32_t firstVertex = 0; firstVertex < totalVertices; firstVertex += maxVerticesPerChunk) {
 			const std::uint32_t count = std::min(maxVerticesPerChunk, totalVertices - firstVertex);
@@ -83,12 +88,12 @@ namespace Jazz2::Rendering
 			// Vertex positions are already in world space, so the model matrix is identity. Re-set every frame
 			// because committing it also folds in the depth of the command's layer, which is derived from the
 			// camera's clip planes - those are rebuilt whenever the viewport is resized.
-			command->SetTransformation(Matrix4x4f::Translation(0.0f, 0.0f, 0.0f));
+			command->SetTransformation(Matrix2x3f::Translation(0.0f, 0.0f));
 
 			auto& geometry = command->GetGeometry();
 			geometry.SetElementsPerVertex(FloatsPerVertex);
 			geometry.SetVertexCount(count);
-			geometry.SetHostVertexPointer(_vertices.data() + firstVertex * FloatsPerVertex);
+			geometry.SetHostVertexPointer(vertices.data() + firstVertex * FloatsPerVertex);
 			geometry.SetDrawParameters(PrimitiveType::Triangles, 0, count);
 
 			renderQueue.AddCommand(command);
@@ -99,7 +104,7 @@ namespace Jazz2::Rendering
 	}
 
 #if defined(RHI_CAP_SHADERS) && defined(RHI_CAP_FRAMEBUFFERS)
-	void LightingRenderer::AppendLightQuad(const LightEmitter& light)
+	float* LightingRenderer::AppendLightQuad(float* v, const LightEmitter& light)
 	{
 		// What the single-light shader derived from its instance block, written out per vertex instead: the quad
 		// spans the far radius around the light, the corner offset it measures the distance from is carried in the
@@ -109,10 +114,6 @@ namespace Jazz2::Rendering
 		const float y0 = light.Pos.Y - light.RadiusFar, y1 = light.Pos.Y + light.RadiusFar;
 		const float radiusNear = light.RadiusNear / light.RadiusFar;
 
-		std::size_t base = _vertices.size();
-		// Every float is written below, so the zero-initialization resize() would do first is wasted work
-		_vertices.resize_for_overwrite(base + 6 * FloatsPerVertex);
-		float* v = _vertices.data() + base;
 		auto put = [&](float px, float py, float cx, float cy) {
 			*v++ = px; *v++ = py; *v++ = radiusNear; *v++ = 0.0f;
 			*v++ = light.Intensity; *v++ = light.Brightness; *v++ = cx; *v++ = cy;
@@ -124,6 +125,7 @@ namespace Jazz2::Rendering
 		put(x0, y0, -1.0f, -1.0f);
 		put(x1, y1,  1.0f,  1.0f);
 		put(x0, y1, -1.0f,  1.0f);
+		return v;
 	}
 
 	RenderCommand* LightingRenderer::RentRenderCommand(std::int32_t index)
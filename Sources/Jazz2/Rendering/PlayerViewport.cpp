@@ -2,6 +2,7 @@
 #include "../PreferencesCache.h"
 #include "../Actors/Player.h"
 
+#include "../../nCine/Application.h"
 #include "../../nCine/tracy.h"
 #include "../../nCine/Base/Random.h"
 #include "../../nCine/Graphics/RenderQueue.h"
@@ -13,7 +14,7 @@ namespace Jazz2::Rendering
 #if defined(RHI_CAP_POSTPROCESSING)
 			_downsamplePass(this), _blurPass1(this), _blurPass2(this), _blurPass3(this), _blurPass4(this),
 #endif
-			_cameraViewCenterY(0.0f), _shakeDuration(0.0f)
+			_cameraUpdateCount(0), _cameraViewCenterY(0.0f), _shakeDuration(0.0f)
 	{
 		_ambientLight = levelHandler->_defaultAmbientLight;
 		_ambientLightTarget = _ambientLight.W;
@@ -310,6 +311,33 @@ namespace Jazz2::Rendering
 		}
 
 		_camera->SetView(_cameraPos - halfView.As<float>(), 0.0f, 1.0f);
+
+		std::uint32_t updateCount = theApplication().GetUpdateCount();
+		_cameraPreviousTickPos = (_cameraUpdateCount + 1 == updateCount ? _cameraTickPos : _cameraPos);
+		_cameraTickPos = _cameraPos;
+		_cameraUpdateCount = updateCount;
+	}
+
+	void PlayerViewport::InterpolateCamera(float alpha)
+	{
+		if (_cameraUpdateCount != theApplication().GetUpdateCount()) {
+			// The camera wasn't updated by the last tick (e.g., the game is paused)
+			return;
+		}
+
+		Vector2f delta = _cameraTickPos - _cameraPreviousTickPos;
+		if ((delta.X == 0.0f && delta.Y == 0.0f) || delta.SqrLength() > InterpolationSnapDistance * InterpolationSnapDistance) {
+			return;
+		}
+
+		_cameraPos = _cameraPreviousTickPos + delta * alpha;
+		if (!PreferencesCache::UnalignedViewport) {
+			_cameraPos.X = std::floor(_cameraPos.X);
+			_cameraPos.Y = std::floor(_cameraPos.Y);
+		}
+
+		Vector2i halfView = GetViewportSize() / 2;
+		_camera->SetView(_cameraPos - halfView.As<float>(), 0.0f, 1.0f);
 	}
 
 	void PlayerViewport::ShakeCameraView(float duration)
@@ -340,6 +368,8 @@ namespace Jazz2::Rendering
 		_cameraPos = focusPos;
 		_cameraLastPos = focusPos;
 		_cameraViewCenterY = focusPos.Y;
+		// Don't interpolate from the position before the warp
+		_cameraUpdateCount = 0;
 		if (!fast) {
 			_cameraDistanceFactor = Vector2f(0.0f, 0.0f);
 		}
@@ -46,6 +46,10 @@ namespace Jazz2::Rendering
 		Rectf _viewBounds;
 		Vector2f _cameraPos;
 		Vector2f _cameraLastPos;
+		// Camera positions of the last two ticks, the rendered position is interpolated between them in fixed-timestep mode
+		Vector2f _cameraPreviousTickPos;
+		Vector2f _cameraTickPos;
+		std::uint32_t _cameraUpdateCount;
 		Vector2f _cameraDistanceFactor;
 		// Vertical follow anchor for the deadzone (see UpdateCamera): the camera holds this Y while the player makes
 		// only small vertical movements, so bumps on uneven ground don't jolt the view.
@@ -86,6 +90,8 @@ namespace Jazz2::Rendering
 		void OnEndFrame();
 		/** @brief Updates the camera position */
 		void UpdateCamera(float timeMult);
+		/** @brief Moves the camera between the positions of the last two ticks, used in fixed-timestep mode */
+		void InterpolateCamera(float alpha);
 		/** @brief Shakes the camera view for a given duration */
 		void ShakeCameraView(float duration);
 		/** @brief Overrides the camera position */
@@ -114,5 +120,7 @@ namespace Jazz2::Rendering
 		// pixel-by-pixel crawl.
 		static constexpr float VerticalRecenter = 0.05f;
 		static constexpr float VerticalRecenterThreshold = 4.0f;
+		// Longer camera moves between two ticks (warps, viewport changes) are not interpolated
+		static constexpr float InterpolationSnapDistance = 256.0f;
 	};
 }
\ No newline at end of file
@@ -60,6 +60,26 @@ namespace Jazz2::Rendering
 
 		// No rescale/antialiasing subpass on the direct tier; OnDraw is a no-op (nothing to blit)
 		_antialiasing._view = nullptr;
+
+#	if defined(RHI_CAP_CPU_RESCALE)
+		// The rescale mode is applied by the backend to the finished screen framebuffer while presenting instead
+		if (!overlay) {
+			using RHI::Software::SwRescaleFilter;
+			SwRescaleFilter filter;
+			switch (PreferencesCache::ActiveRescaleMode & RescaleMode::TypeMask) {
+				case RescaleMode::HQ2x: filter = SwRescaleFilter::HQ2x; break;
+				case RescaleMode::_3xBrz: filter = SwRescaleFilter::Xbrz3x; break;
+				case RescaleMode::CrtScanlines: filter = SwRescaleFilter::CrtScanlines; break;
+				case RescaleMode::CrtShadowMask: filter = SwRescaleFilter::CrtShadowMask; break;
+				case RescaleMode::CrtApertureGrille: filter = SwRescaleFilter::CrtApertureGrille; break;
+				case RescaleMode::Monochrome: filter = SwRescaleFilter::Monochrome; break;
+				case RescaleMode::Sabr: filter = SwRescaleFilter::Sabr; break;
+				case RescaleMode::CleanEdge: filter = SwRescaleFilter::CleanEdge; break;
+				default: filter = SwRescaleFilter::None; break;
+			}
+			RHI::Device::SetScreenRescaleFilter(filter);
+		}
+#	endif
 #else
 		// The scene is always drawn in [0, width]x[0, height] coordinates (the ortho projection below), but the target
 		// texture may be rendered at a higher resolution. This is used for splitscreen zoom-out, where each player's
@@ -1,10 +1,11 @@
 ﻿#include "Resources.h"
 #include "ContentResolver.h"
+#include "../nCine/Base/Random.h"
 
 namespace Jazz2::Resources
 {
 	GenericGraphicResource::GenericGraphicResource() noexcept
-		: Flags(GenericGraphicResourceFlags::None), MaskStride(0)
+		: Flags(GenericGraphicResourceFlags::None), Holders(0), MaskStride(0)
 	{
 	}
 
@@ -19,16 +20,26 @@ namespace Jazz2::Resources
 	}
 
 	GenericSoundResource::GenericSoundResource(std::unique_ptr<Stream> stream, StringView filename) noexcept
-		: Buffer(std::move(stream), filename), Flags(GenericSoundResourceFlags::None)
+		: Buffer(std::move(stream), filename), Flags(GenericSoundResourceFlags::None), Holders(0)
 	{
 	}
 
 	SoundResource::SoundResource() noexcept
+		: Priority(DefaultPriority)
 	{
 	}
 
+	AudioBuffer* SoundResource::PickBuffer() const
+	{
+		if (Buffers.empty()) {
+			return nullptr;
+		}
+		std::int32_t idx = (Buffers.size() > 1 ? Random().Next(0, (std::int32_t)Buffers.size()) : 0);
+		return &Buffers[idx]->Buffer;
+	}
+
 	Metadata::Metadata() noexcept
-		: Flags(MetadataFlags::None)
+		: Flags(MetadataFlags::None), Holders(0), _soundLookups{}
 	{
 	}
 
@@ -50,6 +61,26 @@ namespace Jazz2::Resources
 		return it;
 	}
 
+	SoundHandle Metadata::FindSound(StringView identifier) const
+	{
+		// Actors pass literals, so the address usually identifies the name. It's still compared, because a temporary
+		// string can reuse the address of another one.
+		SoundLookup& lookup = _soundLookups[(reinterpret_cast<std::uintptr_t>(identifier.data()) >> 3) & (SoundLookupCount - 1)];
+		if (lookup.Data == identifier.data() && std::size_t(lookup.Handle) < Sounds.size() &&
+			Sounds[std::size_t(lookup.Handle)].Identifier == identifier) {
+			return lookup.Handle;
+		}
+
+		auto it = SoundHandles.find(String::nullTerminatedView(identifier));
+		if (it == SoundHandles.end()) {
+			return SoundHandle::Invalid;
+		}
+
+		lookup.Data = identifier.data();
+		lookup.Handle = it->second;
+		return it->second;
+	}
+
 	Episode::Episode() noexcept
 	{
 	}
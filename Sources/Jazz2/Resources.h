@@ -80,6 +80,8 @@ namespace Jazz2::Resources
 	{
 		/** @brief Resource flags */
 		GenericGraphicResourceFlags Flags;
+		/** @brief Level handlers that still use the resource, one bit per holder of @ref ContentResolver */
+		std::uint32_t Holders;
 		/** @brief Diffuse texture */
 		std::unique_ptr<Texture> TextureDiffuse;
 		//std::unique_ptr<Texture> TextureNormal;
@@ -270,6 +272,8 @@ namespace Jazz2::Resources
 		AudioBuffer Buffer;
 		/** @brief Resource flags */
 		GenericSoundResourceFlags Flags;
+		/** @brief Level handlers that still use the resource, one bit per holder of @ref ContentResolver */
+		std::uint32_t Holders;
 
 		/**
 		 * @brief Creates a new instance from a stream
@@ -285,15 +289,35 @@ namespace Jazz2::Resources
 		
 		A named sound declared in an object's metadata, holding the list of shared @ref GenericSoundResource buffers
 		it can use. When the sound has several variants, one of the buffers is chosen at playback time. Stored in a
-		@ref Metadata keyed by the sound's name.
+		@ref Metadata and addressed by a @ref SoundHandle resolved from the sound's name.
 	*/
 	struct SoundResource
 	{
+		/** @brief Default priority of a sound that doesn't specify one in its metadata */
+		static constexpr std::int32_t DefaultPriority = 0;
+
+		/** @brief Name of the sound */
+		String Identifier;
 		/** @brief List of underlying generic resources */
 		SmallVector<GenericSoundResource*, 1> Buffers;
+		/** @brief Priority used when all voices are taken, higher values are more important */
+		std::int32_t Priority;
 
 		/** @brief Creates a new instance */
 		SoundResource() noexcept;
+
+		/** @brief Returns a buffer to play, randomly chosen if there are several variants */
+		AudioBuffer* PickBuffer() const;
+	};
+
+	/**
+		@brief Handle of a sound in @ref Metadata
+
+		Index of the sound in @ref Metadata::Sounds, assigned when the metadata is loaded. Callers that play the same
+		sound often can resolve it once with @ref Metadata::FindSound() instead of looking it up by name every time.
+	*/
+	enum class SoundHandle : std::int32_t {
+		Invalid = -1		/**< No sound */
 	};
 
 	/**
@@ -343,12 +367,16 @@ namespace Jazz2::Resources
 		String CacheKey;
 		/** @brief Metadata flags */
 		MetadataFlags Flags;
+		/** @brief Level handlers that still use the metadata, one bit per holder of @ref ContentResolver */
+		std::uint32_t Holders;
 		/** @brief Animations */
 		SmallVector<GraphicResource, 0> Animations;
 		/** @brief Descriptions of the animations that are loaded on first use (see @ref metadata-deferred) */
 		SmallVector<DeferredGraphicResource, 0> DeferredAnimations;
-		/** @brief Sounds */
-		HashMap<String, SoundResource> Sounds;
+		/** @brief Sounds, indexed by @ref SoundHandle */
+		SmallVector<SoundResource, 0> Sounds;
+		/** @brief Handles of sounds by their name */
+		HashMap<String, SoundHandle> SoundHandles;
 		/** @brief Bounding box */
 		Vector2i BoundingBox;
 
@@ -362,6 +390,36 @@ namespace Jazz2::Resources
 		 * is asked for, and returns `nullptr` if they cannot be loaded.
 		 */
 		GraphicResource* FindAnimation(AnimState state);
+
+		/**
+		 * @brief Returns handle of a sound with specified name, or @ref SoundHandle::Invalid if it doesn't exist
+		 *
+		 * Resolved names are remembered by the address of their characters, so a caller that passes the same
+		 * string literal every time goes through the hash map only once per metadata.
+		 */
+		SoundHandle FindSound(StringView identifier) const;
+
+		/** @brief Returns sound with specified handle, or `nullptr` if the handle is invalid */
+		SoundResource* GetSound(SoundHandle handle) {
+			return (std::size_t(handle) < Sounds.size() ? &Sounds[std::size_t(handle)] : nullptr);
+		}
+
+		/** @overload */
+		SoundResource* GetSound(StringView identifier) {
+			return GetSound(FindSound(identifier));
+		}
+
+	private:
+		static constexpr std::uint32_t SoundLookupCount = 16;
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+		struct SoundLookup {
+			const char* Data;
+			SoundHandle Handle;
+		};
+#endif
+
+		mutable SoundLookup _soundLookups[SoundLookupCount];
 	};
 	
 	/**
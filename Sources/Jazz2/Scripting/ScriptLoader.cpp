@@ -3,8 +3,11 @@
 #include "ScriptLoader.h"
 #include "../ContentResolver.h"
 
+#include <cstring>
+#include <Base/Format.h>
 #include <Containers/GrowableArray.h>
 #include <Containers/StringConcatenable.h>
+#include <Cryptography/xxHash.h>
 #include <IO/FileSystem.h>
 
 #if defined(DEATH_TARGET_WINDOWS) && !defined(CMAKE_BUILD)
@@ -25,12 +28,60 @@
 #   endif
 #endif
 
+using namespace Death::Cryptography;
 using namespace Death::IO;
 
 namespace Jazz2::Scripting
 {
+	namespace
+	{
+#if defined(NCINE_HAS_WRITABLE_CACHE)
+		struct ByteCodeCacheHeader
+		{
+			std::uint64_t Signature;
+			std::uint16_t Version;
+			std::uint16_t PointerSize;
+			std::uint32_t EngineVersion;
+			std::uint64_t Key;
+		};
+
+		constexpr std::uint64_t ByteCodeCacheSignature = 0x45444F4353414A32ULL;
+		constexpr std::uint16_t ByteCodeCacheVersion = 1;
+
+		/** @brief Adapts @ref Stream to the binary stream interface used to save and load compiled bytecode */
+		class ByteCodeStream : public asIBinaryStream
+		{
+		public:
+			explicit ByteCodeStream(Stream& stream)
+				: _stream(stream) {}
+
+			int Read(void* ptr, asUINT size) override {
+				return (_stream.Read(ptr, size) == (std::int64_t)size ? asSUCCESS : asERROR);
+			}
+
+			int Write(const void* ptr, asUINT size) override {
+				return (_stream.Write(ptr, size) == (std::int64_t)size ? asSUCCESS : asERROR);
+			}
+
+		private:
+			Stream& _stream;
+		};
+#endif
+
+		/** @brief Value type of @ref asITypeInfo::GetEnumValueByIndex(), which differs between library versions */
+		template<class T> struct EnumValueOf;
+		template<class R, class C, class V> struct EnumValueOf<R(C::*)(asUINT, V*) const> { using Type = V; };
+
+		void HashString(std::uint64_t& hash, const char* str)
+		{
+			if (str != nullptr) {
+				hash = xxHash3(str, std::strlen(str) + 1, hash);
+			}
+		}
+	}
+
 	ScriptLoader::ScriptLoader()
-		: _module(nullptr), _scriptContextType(ScriptContextType::Unknown)
+		: _module(nullptr), _scriptContextType(ScriptContextType::Unknown), _sourceHash(0)
 	{
 		_engine = asCreateScriptEngine();
 		_engine->SetEngineProperty(asEP_COPY_SCRIPT_SECTIONS, true);
@@ -291,7 +342,9 @@ namespace Jazz2::Scripting
 						pos += len;
 						for (; pos < scriptSize && scriptContent[pos] != '\n'; pos++);
 
-						OnProcessPragma(scriptContent.slice(start + 7, pos).trimmed(), contextType);
+						StringView pragma = scriptContent.slice(start + 7, pos).trimmed();
+						_sourceHash = xxHash3(pragma.data(), pragma.size(), _sourceHash);
+						OnProcessPragma(pragma, contextType);
 
 						for (std::int32_t i = start; i < pos; i++) {
 							if (scriptContent[i] != '\n') {
@@ -318,8 +371,9 @@ namespace Jazz2::Scripting
 			}
 		}
 
-		// Append the actual script
-		_module->AddScriptSection(path.data(), scriptContent.data(), scriptSize, 0);
+		// Append the actual script, it's added to the module later only if it has to be compiled
+		_sourceHash = xxHash3(scriptContent.data(), scriptContent.size(), _sourceHash);
+		_scriptSections.emplace_back(path, std::move(scriptContent));
 
 		if (includes.size() > 0) {
 			// Load all included scripts
@@ -335,7 +389,35 @@ namespace Jazz2::Scripting
 
 	ScriptBuildResult ScriptLoader::Build()
 	{
-		std::int32_t r = _module->Build();
+		bool loadedFromCache = false;
+#if defined(NCINE_HAS_WRITABLE_CACHE)
+		// Bytecode is cached per main script, so a changed script replaces its previous bytecode instead of piling up
+		String cachePath;
+		std::uint64_t cacheKey = 0;
+		if (!_scriptSections.empty()) {
+			StringView mainPath = _scriptSections[0].Name;
+			cachePath = fs::CombinePath({ ContentResolver::Get().GetCachePath(), "Baked"_s, "Scripts"_s,
+				format("{:.16x}.bin", xxHash3(mainPath.data(), mainPath.size())) });
+			cacheKey = ComputeInterfaceHash(_sourceHash);
+			loadedFromCache = LoadCachedByteCode(cachePath, cacheKey);
+		}
+#endif
+
+		std::int32_t r = asSUCCESS;
+		if (!loadedFromCache) {
+			for (const auto& section : _scriptSections) {
+				_module->AddScriptSection(section.Name.data(), section.Content.data(), section.Content.size(), 0);
+			}
+			r = _module->Build();
+#if defined(NCINE_HAS_WRITABLE_CACHE)
+			if (r >= 0 && !cachePath.empty() && !SaveCachedByteCode(cachePath, cacheKey)) {
+				LOGW("Failed to save compiled script to \"{}\"", cachePath);
+			}
+#endif
+		}
+
+		_scriptSections.clear();
+
 		if (r < 0) {
 			return (ScriptBuildResult)r;
 		}
@@ -500,6 +582,121 @@ namespace Jazz2::Scripting
 		_scriptContextType = value;
 	}
 
+	std::uint64_t ScriptLoader::ComputeInterfaceHash(std::uint64_t seed) const
+	{
+		// Compiled bytecode refers to the registered application interface by declarations, so any registered
+		// type, function, property or enum value that changed (or was registered in a different order) must
+		// invalidate it. Walking the whole interface is still orders of magnitude cheaper than compiling scripts.
+		std::uint64_t hash = seed;
+		std::uint32_t engineVersion = ANGELSCRIPT_VERSION;
+		hash = xxHash3(&engineVersion, sizeof(engineVersion), hash);
+
+		for (asUINT i = 0; i < _engine->GetObjectTypeCount(); i++) {
+			asITypeInfo* type = _engine->GetObjectTypeByIndex(i);
+			HashString(hash, type->GetNamespace());
+			HashString(hash, type->GetName());
+			for (asUINT j = 0; j < type->GetBehaviourCount(); j++) {
+				asEBehaviours behaviour;
+				asIScriptFunction* func = type->GetBehaviourByIndex(j, &behaviour);
+				hash = xxHash3(&behaviour, sizeof(behaviour), hash);
+				HashString(hash, func->GetDeclaration(true, true, true));
+			}
+			for (asUINT j = 0; j < type->GetMethodCount(); j++) {
+				HashString(hash, type->GetMethodByIndex(j, false)->GetDeclaration(true, true, true));
+			}
+			for (asUINT j = 0; j < type->GetPropertyCount(); j++) {
+				HashString(hash, type->GetPropertyDeclaration(j, true));
+			}
+		}
+
+		for (asUINT i = 0; i < _engine->GetGlobalFunctionCount(); i++) {
+			HashString(hash, _engine->GetGlobalFunctionByIndex(i)->GetDeclaration(true, true, true));
+		}
+
+		for (asUINT i = 0; i < _engine->GetGlobalPropertyCount(); i++) {
+			const char* name; const char* nameSpace; std::int32_t typeId; bool isConst;
+			_engine->GetGlobalPropertyByIndex(i, &name, &nameSpace, &typeId, &isConst);
+			HashString(hash, nameSpace);
+			HashString(hash, name);
+			HashString(hash, _engine->GetTypeDeclaration(typeId, true));
+			hash = xxHash3(&isConst, sizeof(isConst), hash);
+		}
+
+		// Enum values are compiled into the bytecode as constants
+		for (asUINT i = 0; i < _engine->GetEnumCount(); i++) {
+			asITypeInfo* type = _engine->GetEnumByIndex(i);
+			HashString(hash, type->GetNamespace());
+			HashString(hash, type->GetName());
+			for (asUINT j = 0; j < type->GetEnumValueCount(); j++) {
+				typename EnumValueOf<decltype(&asITypeInfo::GetEnumValueByIndex)>::Type value;
+				HashString(hash, type->GetEnumValueByIndex(j, &value));
+				hash = xxHash3(&value, sizeof(value), hash);
+			}
+		}
+
+		for (asUINT i = 0; i < _engine->GetFuncdefCount(); i++) {
+			HashString(hash, _engine->GetFuncdefByIndex(i)->GetFuncdefSignature()->GetDeclaration(true, true, true));
+		}
+
+		for (asUINT i = 0; i < _engine->GetTypedefCount(); i++) {
+			asITypeInfo* type = _engine->GetTypedefByIndex(i);
+			HashString(hash, type->GetNamespace());
+			HashString(hash, type->GetName());
+			HashString(hash, _engine->GetTypeDeclaration(type->GetTypedefTypeId(), true));
+		}
+
+		return hash;
+	}
+
+#if defined(NCINE_HAS_WRITABLE_CACHE)
+	bool ScriptLoader::LoadCachedByteCode(StringView path, std::uint64_t key)
+	{
+		auto s = fs::Open(path, FileAccess::Read);
+		if (!s->IsValid()) {
+			return false;
+		}
+
+		ByteCodeCacheHeader header;
+		if (s->Read(&header, sizeof(header)) != sizeof(header) || header.Signature != ByteCodeCacheSignature ||
+			header.Version != ByteCodeCacheVersion || header.PointerSize != sizeof(void*) ||
+			header.EngineVersion != ANGELSCRIPT_VERSION || header.Key != key) {
+			return false;
+		}
+
+		ByteCodeStream stream(*s);
+		std::int32_t r = _module->LoadByteCode(&stream);
+		if (r < 0) {
+			// The module is reset by the engine on failure, so it can still be compiled from sources
+			LOGW("Failed to load compiled script from \"{}\" with error {}", path, r);
+			return false;
+		}
+
+		LOGD("Script loaded from \"{}\"", path);
+		return true;
+	}
+
+	bool ScriptLoader::SaveCachedByteCode(StringView path, std::uint64_t key) const
+	{
+		fs::CreateDirectories(fs::GetDirectoryName(path));
+
+		ByteCodeCacheHeader header = {};
+		header.Signature = ByteCodeCacheSignature;
+		header.Version = ByteCodeCacheVersion;
+		header.PointerSize = (std::uint16_t)sizeof(void*);
+		header.EngineVersion = ANGELSCRIPT_VERSION;
+		header.Key = key;
+
+		// Multiple processes may compile the same script at once
+		return fs::WriteAtomically(path, [&](Stream& s) {
+			if (s.Write(&header, sizeof(header)) != sizeof(header)) {
+				return false;
+			}
+			ByteCodeStream stream(s);
+			return (_module->SaveByteCode(&stream) >= 0);
+		});
+	}
+#endif
+
 	std::int32_t ScriptLoader::ExcludeCode(String& scriptContent, std::int32_t pos)
 	{
 		std::int32_t scriptSize = (std::int32_t)scriptContent.size();
@@ -99,7 +99,12 @@ namespace Jazz2::Scripting
 	protected:
 		/** @brief Adds a script path from file to the main module */
 		ScriptContextType AddScriptFromFile(StringView path, const HashMap<String, bool>& definedSymbols);
-		/** @brief Builds the main module and extracts metadata */
+		/**
+			@brief Builds the main module and extracts metadata
+
+			If the bytecode cache contains the module compiled from the same preprocessed sources against the same
+			registered application interface, it's loaded from there instead of compiling the sources again.
+		*/
 		ScriptBuildResult Build();
 		/** @brief Sets context type */
 		void SetContextType(ScriptContextType value);
@@ -152,6 +157,14 @@ namespace Jazz2::Scripting
 			HashMap<std::int32_t, Array<String>> FuncMetadataMap;
 			HashMap<std::int32_t, Array<String>> VarMetadataMap;
 		};
+
+		struct ScriptSection {
+			ScriptSection(String name, String content)
+				: Name(std::move(name)), Content(std::move(content)) {}
+
+			String Name;
+			String Content;
+		};
 #endif
 
 		static constexpr asPWORD EngineToOwner = 0;
@@ -162,6 +175,10 @@ namespace Jazz2::Scripting
 		SmallVector<asIScriptContext*, 4> _contextPool;
 
 		HashMap<String, bool> _includedFiles;
+		/// Preprocessed script sections, added to the main module only if it has to be compiled from sources
+		SmallVector<ScriptSection, 0> _scriptSections;
+		/// Digest of all preprocessed script sections and `#pragma` directives in the order they were added
+		std::uint64_t _sourceHash;
 		SmallVector<RawMetadataDeclaration, 0> _foundDeclarations;
 		HashMap<std::int32_t, Array<String>> _typeMetadataMap;
 		HashMap<std::int32_t, Array<String>> _funcMetadataMap;
@@ -173,6 +190,12 @@ namespace Jazz2::Scripting
 		std::int32_t ExtractMetadata(MutableStringView scriptContent, std::int32_t pos, SmallVectorImpl<String>& metadata);
 		std::int32_t ExtractDeclaration(StringView scriptContent, std::int32_t pos, String& name, String& declaration, MetadataType& type);
 
+		std::uint64_t ComputeInterfaceHash(std::uint64_t seed) const;
+#if defined(NCINE_HAS_WRITABLE_CACHE)
+		bool LoadCachedByteCode(StringView path, std::uint64_t key);
+		bool SaveCachedByteCode(StringView path, std::uint64_t key) const;
+#endif
+
 		static asIScriptContext* RequestContextCallback(asIScriptEngine* engine, void* param);
 		static void ReturnContextCallback(asIScriptEngine* engine, asIScriptContext* ctx, void* param);
 
@@ -4,6 +4,7 @@
 #include "../PreferencesCache.h"
 
 #include "../../nCine/tracy.h"
+#include "../../nCine/Base/FrameArena.h"
 #include "../../nCine/Base/Random.h"
 #include "../../nCine/Graphics/RenderQueue.h"
 #include "../../nCine/Graphics/RenderResources.h"
@@ -11,6 +12,12 @@
 
 #include <Containers/GrowableArray.h>
 
+#if defined(DEATH_TARGET_SSE2)
+#	include <IntrinsicsSse2.h>
+#elif defined(DEATH_TARGET_NEON)
+#	include <arm_neon.h>
+#endif
+
 namespace Jazz2::Tiles
 {
 	namespace
@@ -31,13 +38,8 @@ namespace Jazz2::Tiles
 		// How long a pool has to stay below its peak before the slots above it are released again. A burst of
 		// debris fades out over about 300 frames, so trimming sooner would only fight the effect still running.
 		constexpr std::int32_t RenderCommandPoolTrimInterval = 600;
-		// Capacity _debrisList keeps around, so the usual handful of particles never reallocates
+		// Capacity the debris streams keep around, so the usual handful of particles never reallocates
 		constexpr std::int32_t MinDebrisCapacity = 64;
-		// Buffers the mesh vertex pool keeps around (one per drawn tile layer plus one per debris group, which a
-		// level of eight layers with a burst running fits into), and the floats each of them keeps - 48 per quad,
-		// so this holds a modest layer or burst without reallocating
-		constexpr std::int32_t MinPooledMeshBuffers = 12;
-		constexpr std::int32_t MinMeshBufferCapacity = 48 * 128;
 #	if !defined(TILEMAP_USE_SINGLE_DRAW)
 		// Absolute ceiling on the render command pool for the fallback path that rents one command per visible
 		// particle (~840 bytes each on the Dreamcast). TileMap::MaxDebrisCount already bounds it for a single
@@ -50,22 +52,42 @@ namespace Jazz2::Tiles
 		constexpr std::int32_t MinPooledRenderCommands = 0;
 		constexpr std::int32_t RenderCommandPoolTrimInterval = 0;
 		constexpr std::int32_t MinDebrisCapacity = 0;
-		constexpr std::int32_t MinPooledMeshBuffers = 0;
-		constexpr std::int32_t MinMeshBufferCapacity = 0;
 #	if !defined(TILEMAP_USE_SINGLE_DRAW)
 		constexpr std::int32_t MaxPooledRenderCommands = 0;
 #	endif
 #endif
+
+		/** @brief Returns `true` if bits `x0` to `x1` (inclusive) are set in `empty | (solid & solidMask)` of one bitset row */
+		DEATH_ALWAYS_INLINE bool AreAllTileBitsSet(const std::uint64_t* empty, const std::uint64_t* solid, std::uint64_t solidMask, std::int32_t x0, std::int32_t x1)
+		{
+			std::int32_t w0 = (x0 >> 6);
+			std::int32_t w1 = (x1 >> 6);
+			std::uint64_t firstMask = (~0ull << (x0 & 63));
+			std::uint64_t lastMask = (~0ull >> (63 - (x1 & 63)));
+			if (w0 == w1) {
+				std::uint64_t mask = (firstMask & lastMask);
+				return ((empty[w0] | (solid[w0] & solidMask)) & mask) == mask;
+			}
+			if (((empty[w0] | (solid[w0] & solidMask)) & firstMask) != firstMask) {
+				return false;
+			}
+			for (std::int32_t w = w0 + 1; w < w1; w++) {
+				if ((empty[w] | (solid[w] & solidMask)) != ~0ull) {
+					return false;
+				}
+			}
+			return ((empty[w1] | (solid[w1] & solidMask)) & lastMask) == lastMask;
+		}
 	}
 
-	TileMap::TileMap(StringView tileSetPath, std::uint16_t captionTileId, bool applyPalette)
+	TileMap::TileMap(StringView tileSetPath, std::unique_ptr<TileSet> tileSet)
 		: _owner(nullptr), _sprLayerIndex(-1), _pitType(PitType::FallForever), _hasRollbackCheckpoint(false),
 			_renderCommandsCount(0), _renderCommandsPeak(0), _renderCommandsPeakAge(0), _collapsingTimer(0.0f),
 			_animatedTilesOffset(0), _triggerState(ValueInit, TriggerCount), _triggerStateForRollback(ValueInit, TriggerCount),
-			_texturedBackgroundLayer(-1), _texturedBackgroundPass(this)
+			_tileCollisionStride(0), _tileCollisionDirty(true), _texturedBackgroundLayer(-1), _texturedBackgroundPass(this)
 	{
 		auto& tileSetPart = _tileSets.emplace_back();
-		tileSetPart.Data = ContentResolver::Get().RequestTileSet(tileSetPath, captionTileId, applyPalette);
+		tileSetPart.Data = std::move(tileSet);
 		DEATH_ASSERT(tileSetPart.Data != nullptr, ("Failed to load main tileset \"{}\"", tileSetPath), );
 		
 		tileSetPart.Offset = 0;
@@ -223,11 +245,6 @@ namespace Jazz2::Tiles
 			if (_renderCommandsPeak < _renderCommandsCount) {
 				_renderCommandsPeak = _renderCommandsCount;
 			}
-#if defined(TILEMAP_USE_SINGLE_DRAW)
-			if (_meshVerticesPeak < _meshVerticesCount) {
-				_meshVerticesPeak = _meshVerticesCount;
-			}
-#endif
 			_renderCommandsPeakAge++;
 			if (_renderCommandsPeakAge >= RenderCommandPoolTrimInterval) {
 				std::size_t target = (std::size_t)std::max(_renderCommandsPeak, MinPooledRenderCommands);
@@ -243,32 +260,14 @@ namespace Jazz2::Tiles
 						_renderCommandUniforms.shrink(target);
 					}
 				}
-#if defined(TILEMAP_USE_SINGLE_DRAW)
-				// Aggregating moved what a burst costs from the command pool into these vertex buffers - 192 bytes
-				// per particle per viewport that sees it - so they are trimmed the same way. A buffer above the
-				// peak is dropped whole, which is what frees the floats; the slot array is left at its high-water
-				// mark because shrinking it reallocates bitwise, and a relocated buffer that never allocated
-				// would be left believing the inline storage it no longer sits in is a heap block of its own.
-				// The buffers still in use only give back capacity they have grown far past, as the layer or
-				// group they serve asks for about the same size every frame.
-				std::size_t bufferTarget = (std::size_t)std::max(_meshVerticesPeak, MinPooledMeshBuffers);
-				if (_meshVertices.size() > bufferTarget) {
-					_meshVertices.pop_back_n(_meshVertices.size() - bufferTarget);
-				}
-				for (auto& buffer : _meshVertices) {
-					if (buffer.capacity() > (std::size_t)MinMeshBufferCapacity && buffer.size() * 4 < buffer.capacity()) {
-						buffer.shrink(std::max(buffer.size() * 2, (std::size_t)MinMeshBufferCapacity));
-					}
-				}
-				_meshVerticesPeak = 0;
-#endif
 				_renderCommandsPeak = 0;
 				_renderCommandsPeakAge = 0;
 			}
 
 			// Same for the particle storage itself: 100 bytes per particle stayed reserved for the level's lifetime
-			if (_debrisList.capacity() > (std::size_t)MinDebrisCapacity && _debrisList.size() * 4 < _debrisList.capacity()) {
-				_debrisList.shrink(std::max(_debrisList.size() * 2, (std::size_t)MinDebrisCapacity));
+			if (_debris.Capacity > MinDebrisCapacity && _debris.Count * 4 < _debris.Capacity) {
+				_debris.Shrink(std::max(_debris.Count * 2, MinDebrisCapacity));
+				_debrisCollidable.shrink((std::size_t)_debris.Capacity);
 			}
 		}
 
@@ -276,7 +275,6 @@ namespace Jazz2::Tiles
 		// OnDraw() is called multiple times if multiple viewports are active
 		_renderCommandsCount = 0;
 #if defined(TILEMAP_USE_SINGLE_DRAW)
-		_meshVerticesCount = 0;
 		_meshCommandCount = 0;
 #endif
 	}
@@ -308,7 +306,7 @@ namespace Jazz2::Tiles
 					instanceBlock->GetUniform(Material::SpriteSizeUniformName)->SetFloatValue(w, cullingRect.H);
 					instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatValue(0.0f, 0.0f, 0.0f, 1.0f);
 
-					command->SetTransformation(Matrix4x4f::Translation(cullingRect.X, cullingRect.Y, 0.0f));
+					command->SetTransformation(Matrix2x3f::Translation(cullingRect.X, cullingRect.Y));
 					command->SetLayer(spriteLayer.Description.Depth);
 
 					renderQueue.AddCommand(command);
@@ -322,7 +320,7 @@ namespace Jazz2::Tiles
 					instanceBlock->GetUniform(Material::SpriteSizeUniformName)->SetFloatValue(w, cullingRect.H);
 					instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatValue(0.0f, 0.0f, 0.0f, 1.0f);
 
-					command->SetTransformation(Matrix4x4f::Translation(cullingRect.X + cullingRect.W - w, cullingRect.Y, 0.0f));
+					command->SetTransformation(Matrix2x3f::Translation(cullingRect.X + cullingRect.W - w, cullingRect.Y));
 					command->SetLayer(spriteLayer.Description.Depth);
 
 					renderQueue.AddCommand(command);
@@ -568,8 +566,30 @@ namespace Jazz2::Tiles
 
 		auto* sprLayerLayout = _layers[_sprLayerIndex].Layout.get();
 
+		if (_tileCollisionDirty) {
+			RebuildTileCollisionClasses();
+		}
+
+		// Solid tiles count as empty if they are ignored, both classes are never destructible, so no tile is skipped
+		// that could have been destroyed here
+		const std::uint64_t solidMask = ((params.DestructType & TileDestructType::IgnoreSolidTiles) == TileDestructType::IgnoreSolidTiles ? ~0ull : 0ull);
+
 		for (std::int32_t y = hy1t; y <= hy2t; y++) {
+			const std::uint64_t* emptyRow = &_tileCollisionEmpty[y * _tileCollisionStride];
+			const std::uint64_t* solidRow = &_tileCollisionSolid[y * _tileCollisionStride];
+			if (AreAllTileBitsSet(emptyRow, solidRow, solidMask, hx1t, hx2t)) {
+				continue;
+			}
+
 			for (std::int32_t x = hx1t; x <= hx2t; x++) {
+				std::uint64_t tileBit = (1ull << (x & 63));
+				if (((emptyRow[x >> 6] | (solidRow[x >> 6] & solidMask)) & tileBit) != 0) {
+					continue;
+				}
+				if ((solidRow[x >> 6] & tileBit) != 0) {
+					return false;
+				}
+
 			RecheckTile:
 				LayerTile& tile = sprLayerLayout[y * layoutSize.X + x];
 
@@ -932,6 +952,7 @@ namespace Jazz2::Tiles
 				if (!AdvanceDestructibleTileAnimation(tile, tilePos.X, tilePos.Y, amount, "SceneryCollapse"_s)) {
 					tile.DestructType = TileDestructType::None;
 					tile.Flags = tile.Flags & ~LayerTileFlags::Collapsing;
+					UpdateTileCollisionClass(tilePos.X, tilePos.Y);
 					it = _activeCollapsingTiles.eraseUnordered(it);
 					continue;
 				} else {
@@ -1109,12 +1130,17 @@ namespace Jazz2::Tiles
 #if defined(TILEMAP_USE_SINGLE_DRAW)
 			bool meshMode = (rendererType == LayerRendererType::Default && _tileSets.size() == 1);
 			TileSet* meshTileSet = (meshMode ? _tileSets[0].Data.get() : nullptr);
-			// One vertex buffer per chunk, rented on first use - a layer usually touches only some of them.
-			// Indices rather than pointers, because renting can grow (and so reallocate) _meshVertices.
-			SmallVector<std::int32_t, 2> chunkVertices;
+			// One vertex stream per chunk, allocated on first use - a layer usually touches only some of them.
+			// Each is sized for every cell the loops below can visit, the unused tail of the last one is given
+			// back to the frame arena afterwards (with a single chunk, that is all of it).
+			SmallVector<MeshVertices, 2> chunkVertices;
+			std::size_t maxLayerQuads = 0;
 			if DEATH_LIKELY(meshMode) {
-				chunkVertices.resize(meshTileSet->GetTextureCount(), -1);
+				chunkVertices.resize(meshTileSet->GetTextureCount());
+				maxLayerQuads = ((std::size_t)((x3 - x1) / TileSet::DefaultTileSize) + 2) *
+					((std::size_t)((y3 - y1) / TileSet::DefaultTileSize) + 2);
 			}
+			MeshVertices* lastAllocatedVertices = nullptr;
 #endif
 
 			std::int32_t tile_xo = -1;
@@ -1196,11 +1222,12 @@ namespace Jazz2::Tiles
 					if DEATH_LIKELY(meshMode) {
 						// Accumulate this tile into its chunk's mesh; the layer tint and palette are applied once
 						// per emitted mesh in EmitMesh(). The per-tile alpha rides along in the vertex color.
-						std::int32_t& verticesIndex = chunkVertices[tileChunk];
-						if (verticesIndex < 0) {
-							verticesIndex = RentMeshVertices();
+						MeshVertices& vertices = chunkVertices[tileChunk];
+						if (vertices.Storage.empty()) {
+							vertices.Storage = FrameArena::AllocateArray<float>(maxLayerQuads * 6 * 8);
+							lastAllocatedVertices = &vertices;
 						}
-						AppendTileQuad(_meshVertices[verticesIndex], x2r, y2r, (float)TileSet::DefaultTileSize,
+						AppendTileQuad(vertices, x2r, y2r, (float)TileSet::DefaultTileSize,
 							texScaleX, texBiasX, texScaleY, texBiasY, tile.Alpha / 255.0f);
 						continue;
 					}
@@ -1230,7 +1257,7 @@ namespace Jazz2::Tiles
 					}
 #endif
 
-					command->SetTransformation(Matrix4x4f::Translation(x2r, y2r, 0.0f));
+					command->SetTransformation(Matrix2x3f::Translation(x2r, y2r));
 					command->SetLayer(layer.Description.Depth);
 					// Tiles use the default sprite palette (row 0, offset 0); binds the shared palette texture when
 					// indexed. Open-coded rather than through ContentResolver::BindSpritePalette() so the palette
@@ -1255,14 +1282,17 @@ namespace Jazz2::Tiles
 				// Whole visible layer is submitted as one command per touched texture chunk (or a few
 				// <=64 KB pieces for very large layers). Tiles within a layer never overlap, so the order
 				// between chunks doesn't matter - they all share the layer's depth.
+				if (lastAllocatedVertices != nullptr) {
+					lastAllocatedVertices->Storage = FrameArena::Shrink(lastAllocatedVertices->Storage, lastAllocatedVertices->Size);
+				}
 				for (std::int32_t chunk = 0; chunk < (std::int32_t)chunkVertices.size(); chunk++) {
-					const std::int32_t verticesIndex = chunkVertices[chunk];
-					if (verticesIndex < 0 || _meshVertices[verticesIndex].empty()) {
+					const MeshVertices& vertices = chunkVertices[chunk];
+					if (vertices.Size == 0) {
 						continue;
 					}
 					// Tiles use the default sprite palette (row 0, offset 0); every tile accumulated into these
 					// vertices resolved to this chunk of the tileset atlas
-					EmitMesh(renderQueue, _meshVertices[verticesIndex], *meshTileSet->TextureDiffuse[chunk],
+					EmitMesh(renderQueue, vertices.Storage.prefix(vertices.Size), *meshTileSet->TextureDiffuse[chunk],
 						meshTileSet->IsIndexed, 0, layerColor, layer.Description.Depth, RenderCommand::Type::TileMap, false);
 				}
 			}
@@ -1342,7 +1372,7 @@ namespace Jazz2::Tiles
 	}
 
 #if defined(TILEMAP_USE_SINGLE_DRAW)
-	void TileMap::AppendTileQuad(SmallVector<float, 0>& vertices, float x, float y, float size,
+	void TileMap::AppendTileQuad(MeshVertices& vertices, float x, float y, float size,
 		float texScaleX, float texBiasX, float texScaleY, float texBiasY, float alpha)
 	{
 		// UVs at the quad corners: u = px * texScaleX + texBiasX (px in {0,1}), same for v. Any flip is already
@@ -1353,10 +1383,9 @@ namespace Jazz2::Tiles
 
 		// Two triangles, 8 floats per vertex: position.xy, texcoords.uv, color.rgba (white * per-tile alpha; the
 		// layer tint is applied via the command's instance color in EmitMesh)
-		std::size_t base = vertices.size();
-		// Every float is written below, so the zero-initialization resize() would do first is wasted work
-		vertices.resize_for_overwrite(base + 6 * 8);
-		float* v = vertices.data() + base;
+		DEATH_DEBUG_ASSERT(vertices.Size + 6 * 8 <= vertices.Storage.size(), "Mesh vertex stream is full", );
+		float* v = vertices.Storage.data() + vertices.Size;
+		vertices.Size += 6 * 8;
 		auto put = [&](float px, float py, float pu, float pv) {
 			*v++ = px; *v++ = py; *v++ = pu; *v++ = pv;
 			*v++ = 1.0f; *v++ = 1.0f; *v++ = 1.0f; *v++ = alpha;
@@ -1369,48 +1398,43 @@ namespace Jazz2::Tiles
 		put(x,  yr, u0, v1);
 	}
 
-	std::int32_t TileMap::RentMeshVertices()
+	void TileMap::AppendDebrisQuad(MeshVertices& vertices, std::int32_t index) const
 	{
-		if (_meshVerticesCount >= (std::int32_t)_meshVertices.size()) {
-			_meshVertices.emplace_back();
-		}
-		std::int32_t verticesIndex = _meshVerticesCount++;
-		_meshVertices[verticesIndex].clear();
-		return verticesIndex;
-	}
+		const DebrisLook& look = _debris.Looks[index];
+		const float angle = _debris[DebrisStreams::Angle][index];
+		const float scale = _debris[DebrisStreams::Scale][index];
+		const float alpha = _debris[DebrisStreams::Alpha][index];
 
-	void TileMap::AppendDebrisQuad(SmallVector<float, 0>& vertices, const DestructibleDebris& debris)
-	{
 		// The sprite shader would have built this quad from the particle's model matrix: a unit quad scaled by
 		// Size, rotated around the centre of the drawn area and translated to Pos. The mesh stream is in world
 		// space, so the same Translation * RotationZ * Scaling * Translation is folded into the four corners here
 		// - which is the whole point, as it costs less than the three 4x4 multiplies the chain used to.
-		const float c = std::cos(debris.Angle);
-		const float s = std::sin(debris.Angle);
-		const float ns = std::sin(-debris.Angle);	// Never "-s", see the note in Matrix4x4::RotationZ()
-		const float xx = c * debris.Scale, xy = s * debris.Scale;
-		const float yx = ns * debris.Scale, yy = c * debris.Scale;
+		const float c = std::cos(angle);
+		const float s = std::sin(angle);
+		const float ns = std::sin(-angle);	// Never "-s", see the note in Matrix4x4::RotationZ()
+		const float xx = c * scale, xy = s * scale;
+		const float yx = ns * scale, yy = c * scale;
 		// Local extent of the quad before the rotation, centred on the drawn area (see GetFrameOffset())
-		const float localX = debris.FrameOffset.X - debris.Size.X * 0.5f;
-		const float localY = debris.FrameOffset.Y - debris.Size.Y * 0.5f;
+		const float localX = look.FrameOffset.X - look.Size.X * 0.5f;
+		const float localY = look.FrameOffset.Y - look.Size.Y * 0.5f;
 		// One corner plus the two rotated edge vectors, so the remaining three corners are additions
-		const float x0 = debris.Pos.X + xx * localX + yx * localY;
-		const float y0 = debris.Pos.Y + xy * localX + yy * localY;
-		const float ex = xx * debris.Size.X, ey = xy * debris.Size.X;
-		const float fx = yx * debris.Size.Y, fy = yy * debris.Size.Y;
+		const float x0 = _debris[DebrisStreams::PosX][index] + xx * localX + yx * localY;
+		const float y0 = _debris[DebrisStreams::PosY][index] + xy * localX + yy * localY;
+		const float ex = xx * look.Size.X, ey = xy * look.Size.X;
+		const float fx = yx * look.Size.Y, fy = yy * look.Size.Y;
 
 		// UVs at the quad corners, exactly as the sprite vertex stage maps them: u = px * texScaleX + texBiasX
-		const float u0 = debris.TexBiasX, v0 = debris.TexBiasY;
-		const float u1 = debris.TexScaleX + debris.TexBiasX, v1 = debris.TexScaleY + debris.TexBiasY;
+		const float u0 = look.TexBiasX, v0 = look.TexBiasY;
+		const float u1 = look.TexScaleX + look.TexBiasX, v1 = look.TexScaleY + look.TexBiasY;
 
 		// Same 8-float layout and same vertex order as AppendTileQuad(), so a particle is still recognized as a
 		// quad by the backends that fold the two triangles back into one four-vertex strip
-		std::size_t base = vertices.size();
-		vertices.resize_for_overwrite(base + 6 * 8);
-		float* v = vertices.data() + base;
+		DEATH_DEBUG_ASSERT(vertices.Size + 6 * 8 <= vertices.Storage.size(), "Mesh vertex stream is full", );
+		float* v = vertices.Storage.data() + vertices.Size;
+		vertices.Size += 6 * 8;
 		auto put = [&](float px, float py, float pu, float pv) {
 			*v++ = px; *v++ = py; *v++ = pu; *v++ = pv;
-			*v++ = 1.0f; *v++ = 1.0f; *v++ = 1.0f; *v++ = debris.Alpha;
+			*v++ = 1.0f; *v++ = 1.0f; *v++ = 1.0f; *v++ = alpha;
 		};
 		put(x0,           y0,           u0, v0);
 		put(x0 + ex,      y0 + ey,      u1, v0);
@@ -1420,7 +1444,7 @@ namespace Jazz2::Tiles
 		put(x0 + fx,      y0 + fy,      u0, v1);
 	}
 
-	void TileMap::EmitMesh(RenderQueue& renderQueue, SmallVector<float, 0>& vertices, const Texture& texture, bool indexed,
+	void TileMap::EmitMesh(RenderQueue& renderQueue, ArrayView<const float> vertices, const Texture& texture, bool indexed,
 		std::uint16_t paletteOffset, const Vector4f& color, std::uint16_t depth, RenderCommand::Type type, bool additiveBlending)
 	{
 		constexpr std::uint32_t FloatsPerVertex = 8;
@@ -1473,7 +1497,7 @@ namespace Jazz2::Tiles
 			geometry.SetDrawParameters(PrimitiveType::Triangles, 0, count);
 
 			// Vertex positions are already in world space, so the model matrix is identity
-			command->SetTransformation(Matrix4x4f::Translation(0.0f, 0.0f, 0.0f));
+			command->SetTransformation(Matrix2x3f::Translation(0.0f, 0.0f));
 			command->SetLayer(depth);
 			// Binds diffuse on unit 0 and, when the mesh is recolored at draw time, the palette on unit 1
 			ContentResolver::Get().BindSpritePalette(*command, texture, indexed, paletteOffset);
@@ -1483,25 +1507,28 @@ namespace Jazz2::Tiles
 	}
 #endif
 
-	void TileMap::AddTileSet(StringView tileSetPath, std::uint16_t offset, std::uint16_t count, const std::uint8_t* paletteRemapping)
+	void TileMap::AddTileSet(StringView tileSetPath, std::unique_ptr<TileSet> tileSet, std::uint16_t offset, std::uint16_t count)
 	{
 		auto& tileSetPart = _tileSets.emplace_back();
-		tileSetPart.Data = ContentResolver::Get().RequestTileSet(tileSetPath, 0, false, paletteRemapping);
+		tileSetPart.Data = std::move(tileSet);
 		tileSetPart.Offset = offset;
 		tileSetPart.Count = count;
 
 		if (tileSetPart.Data == nullptr) {
 			LOGE("Cannot load extra tileset \"{}\"", tileSetPath);
 		}
+
+		_tileCollisionDirty = true;
 	}
 
-	void TileMap::ReadLayerConfiguration(Stream& s)
+	void TileMap::ReadLayerConfiguration(SpanReader& s)
 	{
 		LayerType layerType = (LayerType)s.ReadValue<std::uint8_t>();
 		std::uint16_t layerFlags = s.ReadValueAsLE<std::uint16_t>();
 
 		if (layerType == LayerType::Sprite) {
 			_sprLayerIndex = (std::int32_t)_layers.size();
+			_tileCollisionDirty = true;
 		}
 
 		TileMapLayer& newLayer = _layers.emplace_back();
@@ -1589,7 +1616,7 @@ namespace Jazz2::Tiles
 		}
 	}
 
-	void TileMap::ReadAnimatedTiles(Stream& s)
+	void TileMap::ReadAnimatedTiles(SpanReader& s)
 	{
 		_animatedTilesOffset = s.ReadValueAsLE<std::uint16_t>();
 
@@ -1625,6 +1652,7 @@ namespace Jazz2::Tiles
 	void TileMap::SetTileEventFlags(std::int32_t x, std::int32_t y, EventType tileEvent, std::uint8_t* tileParams)
 	{
 		auto& tile = _layers[_sprLayerIndex].Layout[x + y * _layers[_sprLayerIndex].LayoutSize.X];
+		_tileCollisionDirty = true;
 
 		switch (tileEvent) {
 			case EventType::ModifierOneWay:
@@ -1680,6 +1708,7 @@ namespace Jazz2::Tiles
 			return false;
 		}
 
+		_tileCollisionDirty = true;
 		return tileSet->OverrideTileMask(tileId, tileMask);
 	}
 
@@ -1735,7 +1764,7 @@ namespace Jazz2::Tiles
 	{
 		// Every live particle pins a pooled render command and a slice of the streaming uniform buffers, so on the
 		// consoles the effect has a budget (see MaxDebrisCount) and new particles are dropped once it is used up
-		if (MaxDebrisCount > 0 && (std::int32_t)_debrisList.size() >= MaxDebrisCount) {
+		if (MaxDebrisCount > 0 && _debris.Count >= MaxDebrisCount) {
 			return;
 		}
 
@@ -1763,7 +1792,7 @@ namespace Jazz2::Tiles
 			}
 		}
 
-		_debrisList.push_back(debris);
+		_debris.Add(debris);
 	}
 
 	void TileMap::CreateTileDebris(std::int32_t tileId, std::int32_t x, std::int32_t y)
@@ -1777,7 +1806,7 @@ namespace Jazz2::Tiles
 		}
 
 		// A tile always breaks into its four quarters, so it is dropped as a whole once the budget is used up
-		if (MaxDebrisCount > 0 && (std::int32_t)_debrisList.size() + 4 > MaxDebrisCount) {
+		if (MaxDebrisCount > 0 && _debris.Count + 4 > MaxDebrisCount) {
 			return;
 		}
 
@@ -1809,8 +1838,10 @@ namespace Jazz2::Tiles
 			texScaleY *= -1;
 		}*/
 
+		_debris.Reserve(_debris.Count + 4);
+
 		for (std::int32_t i = 0; i < 4; i++) {
-			DestructibleDebris& debris = _debrisList.emplace_back();
+			DestructibleDebris debris{};
 			debris.Pos = Vector2f(x * TileSet::DefaultTileSize + (i % 2) * QuarterSize, y * TileSet::DefaultTileSize + (i / 2) * QuarterSize);
 			debris.Depth = z;
 			debris.Size = Vector2f(QuarterSize, QuarterSize);
@@ -1836,6 +1867,7 @@ namespace Jazz2::Tiles
 			// The tileset atlas is indexed now, so recolor tile debris through palette row 0 (or -1 if baked)
 			debris.PaletteOffset = (tileSet->IsIndexed ? 0 : -1);
 			debris.Flags = DebrisFlags::None;
+			_debris.Add(debris);
 		}
 	}
 
@@ -1859,14 +1891,17 @@ namespace Jazz2::Tiles
 		const std::int32_t step = GetParticleDebrisStep(DebrisSize, debrisRect.W, debrisRect.H);
 		const float particleSize = (float)(step - 1);
 
+		// The whole burst is reserved up front, the streams would otherwise grow several times over a big sprite
+		_debris.Reserve(_debris.Count + ((debrisRect.W + step - 1) / step) * ((debrisRect.H + step - 1) / step));
+
 		for (std::int32_t fy = 0; fy < debrisRect.H; fy += step) {
-			if (MaxDebrisCount > 0 && (std::int32_t)_debrisList.size() >= MaxDebrisCount) {
+			if (MaxDebrisCount > 0 && _debris.Count >= MaxDebrisCount) {
 				break;
 			}
 			for (std::int32_t fx = 0; fx < debrisRect.W; fx += step) {
 				float currentSize = particleSize * Random().FastFloat(0.2f, 1.1f);
 
-				DestructibleDebris& debris = _debrisList.emplace_back();
+				DestructibleDebris debris{};
 				debris.Pos = Vector2f(x + (isFacingLeft ? res->Base->FrameDimensions.X - frameOffset.X - fx : frameOffset.X + fx), y + frameOffset.Y + fy);
 				debris.Depth = (std::uint16_t)pos.Z;
 				debris.Size = Vector2f(currentSize, currentSize);
@@ -1893,6 +1928,7 @@ namespace Jazz2::Tiles
 				// Indexed sprite debris is recolored at draw time; -1 keeps a baked (e.g., tileset) texture on plain Sprite
 				debris.PaletteOffset = (((res->Base->Flags & GenericGraphicResourceFlags::Indexed) == GenericGraphicResourceFlags::Indexed) ? (std::int32_t)res->PaletteOffset : -1);
 				debris.Flags = DebrisFlags::Bounce;
+				_debris.Add(debris);
 			}
 		}
 	}
@@ -1910,8 +1946,13 @@ namespace Jazz2::Tiles
 		if (MaxDebrisCount > 0) {
 			// Clamped instead of dropped: the count is the caller's intent (and also scales the speed below),
 			// so a partial burst still reads as the same effect
-			count = std::min(count, MaxDebrisCount - (std::int32_t)_debrisList.size());
+			count = std::min(count, MaxDebrisCount - _debris.Count);
 		}
+		if (count <= 0) {
+			return;
+		}
+
+		_debris.Reserve(_debris.Count + count);
 
 		for (std::int32_t i = 0; i < count; i++) {
 			float speedX = Random().FastFloat(-1.0f, 1.0f) * Random().FastFloat(0.2f, 0.8f) * count;
@@ -1920,7 +1961,7 @@ namespace Jazz2::Tiles
 			Recti frameRect = res->Base->GetFrameRect(curAnimFrame);
 			Vector2i frameOffset = res->Base->GetFrameOffset(curAnimFrame);
 
-			DestructibleDebris& debris = _debrisList.emplace_back();
+			DestructibleDebris debris{};
 			debris.Pos = Vector2f(x, y);
 			debris.Depth = (std::uint16_t)pos.Z;
 			// Sized by the frame's own area rather than the logical cell: with trimmed frames the two
@@ -1950,83 +1991,338 @@ namespace Jazz2::Tiles
 			// Indexed sprite debris is recolored at draw time; -1 keeps a baked texture on the plain Sprite shader
 			debris.PaletteOffset = (((res->Base->Flags & GenericGraphicResourceFlags::Indexed) == GenericGraphicResourceFlags::Indexed) ? (std::int32_t)res->PaletteOffset : -1);
 			debris.Flags = DebrisFlags::Bounce;
+			_debris.Add(debris);
 		}
 	}
 
+	void TileMap::DebrisStreams::Reserve(std::int32_t capacity)
+	{
+		if (capacity > Capacity) {
+			// Grow geometrically, a burst adds its particles in one go but weather keeps adding a few every frame
+			Reallocate(std::max(capacity, Capacity * 2));
+		}
+	}
+
+	void TileMap::DebrisStreams::Shrink(std::int32_t capacity)
+	{
+		capacity = std::max(capacity, Count);
+		if ((capacity + BlockSize - 1) / BlockSize * BlockSize < Capacity) {
+			Reallocate(capacity);
+		}
+	}
+
+	void TileMap::DebrisStreams::Add(const DestructibleDebris& debris)
+	{
+		if (Count >= Capacity) {
+			Reserve(std::max(Count + 1, 4 * BlockSize));
+		}
+
+		std::int32_t i = Count++;
+		(*this)[PosX][i] = debris.Pos.X;
+		(*this)[PosY][i] = debris.Pos.Y;
+		(*this)[SpeedX][i] = debris.Speed.X;
+		(*this)[SpeedY][i] = debris.Speed.Y;
+		(*this)[AccelX][i] = debris.Acceleration.X;
+		(*this)[AccelY][i] = debris.Acceleration.Y;
+		(*this)[Scale][i] = debris.Scale;
+		(*this)[ScaleSpeed][i] = debris.ScaleSpeed;
+		(*this)[Angle][i] = debris.Angle;
+		(*this)[AngleSpeed][i] = debris.AngleSpeed;
+		(*this)[Alpha][i] = debris.Alpha;
+		(*this)[AlphaSpeed][i] = debris.AlphaSpeed;
+		(*this)[Time][i] = debris.Time;
+		(*this)[Elasticity][i] = debris.Elasticity;
+
+		DebrisLook& look = Looks[i];
+		look.Size = debris.Size;
+		look.FrameOffset = debris.FrameOffset;
+		look.TexScaleX = debris.TexScaleX;
+		look.TexBiasX = debris.TexBiasX;
+		look.TexScaleY = debris.TexScaleY;
+		look.TexBiasY = debris.TexBiasY;
+		look.DiffuseTexture = debris.DiffuseTexture;
+		look.PaletteOffset = debris.PaletteOffset;
+		look.Depth = debris.Depth;
+		look.Flags = debris.Flags;
+	}
+
+	void TileMap::DebrisStreams::Reallocate(std::int32_t capacity)
+	{
+		capacity = (capacity + BlockSize - 1) / BlockSize * BlockSize;
+		if (capacity == 0) {
+			Data = nullptr;
+			Looks = nullptr;
+			Capacity = 0;
+			return;
+		}
+
+		// Value-initialized, so the padding lanes the block loops run over hold zeros rather than garbage
+		// that could be a denormal or a NaN and slow the whole block down
+		std::unique_ptr<float[]> data = std::make_unique<float[]>((std::size_t)capacity * FieldCount);
+		std::unique_ptr<DebrisLook[]> looks = std::make_unique<DebrisLook[]>(capacity);
+		if (Count > 0) {
+			for (std::int32_t field = 0; field < FieldCount; field++) {
+				std::memcpy(data.get() + (std::size_t)field * capacity, Data.get() + (std::size_t)field * Capacity, Count * sizeof(float));
+			}
+			std::copy(Looks.get(), Looks.get() + Count, looks.get());
+		}
+
+		Data = std::move(data);
+		Looks = std::move(looks);
+		Capacity = capacity;
+	}
+
 	void TileMap::UpdateDebris(float timeMult)
 	{
 		ZoneScopedC(0xA09359);
 
-		std::int32_t size = (std::int32_t)_debrisList.size();
-		for (std::int32_t i = 0; i < size; i++) {
-			DestructibleDebris& debris = _debrisList[i];
+		CompactDebris();
 
-			if (debris.Scale <= 0.0f || debris.Alpha <= 0.0f) {
-				std::swap(debris, _debrisList[size - 1]);
-				_debrisList.pop_back();
-				i--;
-				size--;
-				continue;
+		const std::int32_t count = _debris.Count;
+		if (count == 0) {
+			return;
+		}
+
+		float* time = _debris[DebrisStreams::Time];
+		float* alphaSpeed = _debris[DebrisStreams::AlphaSpeed];
+
+		// Time's up - fade out smoothly instead of popping while still partly visible (e.g., the Fire/Lightning
+		// death effects, whose own AlphaSpeed is too slow to reach zero within their lifetime). It has to run
+		// before the collision pass, which overrides the fade of a particle that just hit a wall.
+		for (std::int32_t i = 0; i < count; i++) {
+			time[i] -= timeMult;
+			if (time[i] <= 0.0f) {
+				alphaSpeed[i] = std::min(alphaSpeed[i], -0.08f);
+			}
+		}
+
+		CollideDebris(timeMult);
+
+		float* posX = _debris[DebrisStreams::PosX];
+		float* posY = _debris[DebrisStreams::PosY];
+		float* speedX = _debris[DebrisStreams::SpeedX];
+		float* speedY = _debris[DebrisStreams::SpeedY];
+		const float* accelX = _debris[DebrisStreams::AccelX];
+		const float* accelY = _debris[DebrisStreams::AccelY];
+		float* scale = _debris[DebrisStreams::Scale];
+		const float* scaleSpeed = _debris[DebrisStreams::ScaleSpeed];
+		float* angle = _debris[DebrisStreams::Angle];
+		const float* angleSpeed = _debris[DebrisStreams::AngleSpeed];
+		float* alpha = _debris[DebrisStreams::Alpha];
+
+		// The capacity is a multiple of the block size, so the last block may run over the padding lanes
+		static_assert(DebrisStreams::BlockSize == 4, "The integration below processes 4 particles per iteration");
+
+#if defined(DEATH_TARGET_SSE2)
+		const __m128 t = _mm_set1_ps(timeMult);
+		const __m128 half = _mm_set1_ps(0.5f);
+		const __m128 maxSpeed = _mm_set1_ps(10.0f);
+		const __m128 zero = _mm_setzero_ps();
+
+		for (std::int32_t i = 0; i < count; i += DebrisStreams::BlockSize) {
+			const __m128 ax = _mm_loadu_ps(accelX + i);
+			const __m128 ay = _mm_loadu_ps(accelY + i);
+			__m128 sx = _mm_loadu_ps(speedX + i);
+			__m128 sy = _mm_loadu_ps(speedY + i);
+
+			// pos += speed * t + 0.5 * acc * t * t, in the same order of operations as the scalar variant
+			_mm_storeu_ps(posX + i, _mm_add_ps(_mm_loadu_ps(posX + i), _mm_add_ps(_mm_mul_ps(sx, t), _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(half, ax), t), t))));
+			_mm_storeu_ps(posY + i, _mm_add_ps(_mm_loadu_ps(posY + i), _mm_add_ps(_mm_mul_ps(sy, t), _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(half, ay), t), t))));
+
+			// Only accelerating particles get the terminal speed clamp, the rest keep their speed as it is
+			const __m128 hasAx = _mm_cmpneq_ps(ax, zero);
+			const __m128 hasAy = _mm_cmpneq_ps(ay, zero);
+			const __m128 nsx = _mm_min_ps(_mm_add_ps(sx, _mm_mul_ps(ax, t)), maxSpeed);
+			const __m128 nsy = _mm_min_ps(_mm_add_ps(sy, _mm_mul_ps(ay, t)), maxSpeed);
+			_mm_storeu_ps(speedX + i, _mm_or_ps(_mm_and_ps(hasAx, nsx), _mm_andnot_ps(hasAx, sx)));
+			_mm_storeu_ps(speedY + i, _mm_or_ps(_mm_and_ps(hasAy, nsy), _mm_andnot_ps(hasAy, sy)));
+
+			_mm_storeu_ps(scale + i, _mm_add_ps(_mm_loadu_ps(scale + i), _mm_mul_ps(_mm_loadu_ps(scaleSpeed + i), t)));
+			_mm_storeu_ps(angle + i, _mm_add_ps(_mm_loadu_ps(angle + i), _mm_mul_ps(_mm_loadu_ps(angleSpeed + i), t)));
+			_mm_storeu_ps(alpha + i, _mm_add_ps(_mm_loadu_ps(alpha + i), _mm_mul_ps(_mm_loadu_ps(alphaSpeed + i), t)));
+		}
+#elif defined(DEATH_TARGET_NEON)
+		const float32x4_t t = vdupq_n_f32(timeMult);
+		const float32x4_t half = vdupq_n_f32(0.5f);
+		const float32x4_t maxSpeed = vdupq_n_f32(10.0f);
+		const float32x4_t zero = vdupq_n_f32(0.0f);
+
+		for (std::int32_t i = 0; i < count; i += DebrisStreams::BlockSize) {
+			const float32x4_t ax = vld1q_f32(accelX + i);
+			const float32x4_t ay = vld1q_f32(accelY + i);
+			const float32x4_t sx = vld1q_f32(speedX + i);
+			const float32x4_t sy = vld1q_f32(speedY + i);
+
+			// Plain multiplies and adds instead of vmlaq_f32(), which may be fused and round differently
+			vst1q_f32(posX + i, vaddq_f32(vld1q_f32(posX + i), vaddq_f32(vmulq_f32(sx, t), vmulq_f32(vmulq_f32(vmulq_f32(half, ax), t), t))));
+			vst1q_f32(posY + i, vaddq_f32(vld1q_f32(posY + i), vaddq_f32(vmulq_f32(sy, t), vmulq_f32(vmulq_f32(vmulq_f32(half, ay), t), t))));
+
+			const uint32x4_t noAx = vceqq_f32(ax, zero);
+			const uint32x4_t noAy = vceqq_f32(ay, zero);
+			vst1q_f32(speedX + i, vbslq_f32(noAx, sx, vminq_f32(vaddq_f32(sx, vmulq_f32(ax, t)), maxSpeed)));
+			vst1q_f32(speedY + i, vbslq_f32(noAy, sy, vminq_f32(vaddq_f32(sy, vmulq_f32(ay, t)), maxSpeed)));
+
+			vst1q_f32(scale + i, vaddq_f32(vld1q_f32(scale + i), vmulq_f32(vld1q_f32(scaleSpeed + i), t)));
+			vst1q_f32(angle + i, vaddq_f32(vld1q_f32(angle + i), vmulq_f32(vld1q_f32(angleSpeed + i), t)));
+			vst1q_f32(alpha + i, vaddq_f32(vld1q_f32(alpha + i), vmulq_f32(vld1q_f32(alphaSpeed + i), t)));
+		}
+#else
+		// Written as independent per-stream loops, which is the shape compilers vectorize on their own
+		for (std::int32_t i = 0; i < count; i++) {
+			posX[i] += speedX[i] * timeMult + 0.5f * accelX[i] * timeMult * timeMult;
+			posY[i] += speedY[i] * timeMult + 0.5f * accelY[i] * timeMult * timeMult;
+		}
+		for (std::int32_t i = 0; i < count; i++) {
+			if (accelX[i] != 0.0f) {
+				speedX[i] = std::min(speedX[i] + accelX[i] * timeMult, 10.0f);
+			}
+			if (accelY[i] != 0.0f) {
+				speedY[i] = std::min(speedY[i] + accelY[i] * timeMult, 10.0f);
 			}
+		}
+		for (std::int32_t i = 0; i < count; i++) {
+			scale[i] += scaleSpeed[i] * timeMult;
+			angle[i] += angleSpeed[i] * timeMult;
+			alpha[i] += alphaSpeed[i] * timeMult;
+		}
+#endif
+	}
 
-			debris.Time -= timeMult;
-			if (debris.Time <= 0.0f) {
-				// Time's up - fade out smoothly instead of popping while still partly visible (e.g., the Fire/Lightning
-				// death effects, whose own AlphaSpeed is too slow to reach zero within their lifetime)
-				debris.AlphaSpeed = std::min(debris.AlphaSpeed, -0.08f);
-			}
-
-			if ((debris.Flags & (DebrisFlags::Disappear | DebrisFlags::Bounce)) != DebrisFlags::None) {
-				// Debris should collide with tilemap
-				float nx = debris.Pos.X + debris.Speed.X * timeMult;
-				float ny = debris.Pos.Y + debris.Speed.Y * timeMult;
-				// Debris is a few pixels across and destroys nothing, so it samples the collision mask at
-				// its centre rather than sweeping its whole box - a burst after an enemy dies is hundreds
-				// of these, and the box test carries setup a point sample does not need
-				if (IsTilePointEmpty((std::int32_t)nx, (std::int32_t)ny, true)) {
-					// Nothing...
-				} else if ((debris.Flags & DebrisFlags::Disappear) == DebrisFlags::Disappear) {
-					debris.ScaleSpeed = -0.02f;
-					debris.AlphaSpeed = -0.006f;
-					debris.Speed = Vector2f::Zero;
-					debris.Acceleration = Vector2f::Zero;
-				} else {
-					// Place us to the ground only if no horizontal movement was
-					// involved (this prevents speeds resetting if the actor
-					// collides with a wall from the side while in the air)
-					if (IsTilePointEmpty((std::int32_t)nx, (std::int32_t)debris.Pos.Y, true)) {
-						if (debris.Speed.Y > 0.0f) {
-							debris.Speed.Y = -(debris.Elasticity * debris.Speed.Y);
-							//OnHitFloorHook();
-						} else {
-							debris.Speed.Y = 0;
-							//OnHitCeilingHook();
-						}
-					}
+	void TileMap::CompactDebris()
+	{
+		// Particles that shrank or faded away are dropped in one pass per frame instead of being swapped out one
+		// by one in the middle of the integration. Survivors keep their order, so a burst also keeps its draw order.
+		const std::int32_t count = _debris.Count;
+		const float* scale = _debris[DebrisStreams::Scale];
+		const float* alpha = _debris[DebrisStreams::Alpha];
+		DebrisLook* looks = _debris.Looks.get();
 
-					// If the actor didn't move all the way horizontally,
-					// it hit a wall (or was already touching it)
-					if (IsTilePointEmpty((std::int32_t)debris.Pos.X, (std::int32_t)ny, true)) {
-						debris.Speed.X = -(debris.Elasticity * debris.Speed.X);
-						debris.AngleSpeed = -(debris.Elasticity * debris.AngleSpeed);
-						//OnHitWallHook();
-					}
+		float* fields[DebrisStreams::FieldCount];
+		for (std::int32_t field = 0; field < DebrisStreams::FieldCount; field++) {
+			fields[field] = _debris[(DebrisStreams::Field)field];
+		}
+
+		_debrisCollidable.clear();
+
+		std::int32_t j = 0;
+		for (std::int32_t i = 0; i < count; i++) {
+			if (scale[i] <= 0.0f || alpha[i] <= 0.0f) {
+				continue;
+			}
+			if (i != j) {
+				for (std::int32_t field = 0; field < DebrisStreams::FieldCount; field++) {
+					fields[field][j] = fields[field][i];
 				}
+				looks[j] = looks[i];
 			}
+			if ((looks[j].Flags & (DebrisFlags::Disappear | DebrisFlags::Bounce)) != DebrisFlags::None) {
+				_debrisCollidable.push_back(j);
+			}
+			j++;
+		}
+
+		_debris.Count = j;
+	}
+
+	void TileMap::CollideDebris(float timeMult)
+	{
+		if (_debrisCollidable.empty() || _sprLayerIndex == -1) {
+			return;
+		}
 
-			debris.Pos.X += debris.Speed.X * timeMult + 0.5f * debris.Acceleration.X * timeMult * timeMult;
-			debris.Pos.Y += debris.Speed.Y * timeMult + 0.5f * debris.Acceleration.Y * timeMult * timeMult;
+		const TileMapLayer& sprLayer = _layers[_sprLayerIndex];
+		const std::int32_t limitRightPx = sprLayer.LayoutSize.X * TileSet::DefaultTileSize;
+		const std::int32_t limitBottomPx = sprLayer.LayoutSize.Y * TileSet::DefaultTileSize;
 
-			if (debris.Acceleration.X != 0.0f) {
-				debris.Speed.X = std::min(debris.Speed.X + debris.Acceleration.X * timeMult, 10.0f);
+		// Debris is a few pixels across and destroys nothing, so it samples the collision mask at its centre
+		// rather than sweeping its whole box. The particles of a burst are also packed closely together, so
+		// consecutive samples mostly land on the same tile - its classification is kept from the last sample
+		// and only a partially solid tile still has to test its mask bit.
+		enum class TileClass { Empty, Solid, Partial };
+		std::int32_t cachedTileIndex = -1;
+		TileClass cachedClass = TileClass::Empty;
+
+		auto isPointEmpty = [&](std::int32_t x, std::int32_t y) {
+			if (x < 0 || y < 0 || x >= limitRightPx || y >= limitBottomPx) {
+				// Out-of-level rules (walls, pits) are left to the full sample
+				return IsTilePointEmpty(x, y, true);
+			}
+
+			std::int32_t tileIndex = (y / TileSet::DefaultTileSize) * sprLayer.LayoutSize.X + (x / TileSet::DefaultTileSize);
+			if (tileIndex != cachedTileIndex) {
+				cachedTileIndex = tileIndex;
+
+				// Same decisions as IsTilePointEmpty() in the same order, minus the pixel test. Debris always
+				// samples downwards, so a one-way tile is classified by its mask like any other.
+				const LayerTile& tile = sprLayer.Layout[tileIndex];
+				if (tile.HasSuspendType != SuspendType::None) {
+					cachedClass = TileClass::Empty;
+				} else {
+					std::int32_t tileId = ResolveTileID(tile);
+					TileSet* tileSet = ResolveTileSet(tileId);
+					if (tileSet == nullptr || tileSet->IsTileMaskEmpty(tileId)) {
+						cachedClass = TileClass::Empty;
+					} else if (tileSet->IsTileMaskFilled(tileId)) {
+						cachedClass = TileClass::Solid;
+					} else {
+						cachedClass = TileClass::Partial;
+					}
+				}
 			}
-			if (debris.Acceleration.Y != 0.0f) {
-				debris.Speed.Y = std::min(debris.Speed.Y + debris.Acceleration.Y * timeMult, 10.0f);
+
+			switch (cachedClass) {
+				case TileClass::Empty: return true;
+				case TileClass::Solid: return false;
+				default: return IsTilePointEmpty(x, y, true);
 			}
+		};
 
-			debris.Scale += debris.ScaleSpeed * timeMult;
-			debris.Angle += debris.AngleSpeed * timeMult;
-			debris.Alpha += debris.AlphaSpeed * timeMult;
+		float* posX = _debris[DebrisStreams::PosX];
+		float* posY = _debris[DebrisStreams::PosY];
+		float* speedX = _debris[DebrisStreams::SpeedX];
+		float* speedY = _debris[DebrisStreams::SpeedY];
+		float* accelX = _debris[DebrisStreams::AccelX];
+		float* accelY = _debris[DebrisStreams::AccelY];
+		float* scaleSpeed = _debris[DebrisStreams::ScaleSpeed];
+		float* angleSpeed = _debris[DebrisStreams::AngleSpeed];
+		float* alphaSpeed = _debris[DebrisStreams::AlphaSpeed];
+		const float* elasticity = _debris[DebrisStreams::Elasticity];
+		const DebrisLook* looks = _debris.Looks.get();
+
+		for (std::int32_t i : _debrisCollidable) {
+			float nx = posX[i] + speedX[i] * timeMult;
+			float ny = posY[i] + speedY[i] * timeMult;
+			if (isPointEmpty((std::int32_t)nx, (std::int32_t)ny)) {
+				// Nothing...
+			} else if ((looks[i].Flags & DebrisFlags::Disappear) == DebrisFlags::Disappear) {
+				scaleSpeed[i] = -0.02f;
+				alphaSpeed[i] = -0.006f;
+				speedX[i] = 0.0f;
+				speedY[i] = 0.0f;
+				accelX[i] = 0.0f;
+				accelY[i] = 0.0f;
+			} else {
+				// Place us to the ground only if no horizontal movement was
+				// involved (this prevents speeds resetting if the actor
+				// collides with a wall from the side while in the air)
+				if (isPointEmpty((std::int32_t)nx, (std::int32_t)posY[i])) {
+					if (speedY[i] > 0.0f) {
+						speedY[i] = -(elasticity[i] * speedY[i]);
+						//OnHitFloorHook();
+					} else {
+						speedY[i] = 0;
+						//OnHitCeilingHook();
+					}
+				}
+
+				// If the actor didn't move all the way horizontally,
+				// it hit a wall (or was already touching it)
+				if (isPointEmpty((std::int32_t)posX[i], (std::int32_t)ny)) {
+					speedX[i] = -(elasticity[i] * speedX[i]);
+					angleSpeed[i] = -(elasticity[i] * angleSpeed[i]);
+					//OnHitWallHook();
+				}
+			}
 		}
 	}
 
@@ -2049,35 +2345,59 @@ namespace Jazz2::Tiles
 		// one depth, so the whole effect ends up as a single draw instead of one command per particle.
 		_debrisMeshGroups.clear();
 
-		for (const auto& debris : _debrisList) {
-			if (!viewportRect.Contains(debris.Pos)) {
+		const float* posX = _debris[DebrisStreams::PosX];
+		const float* posY = _debris[DebrisStreams::PosY];
+		const std::int32_t count = _debris.Count;
+
+		// The first pass only sorts the visible particles into groups, so each group's vertex stream can then be
+		// allocated in the frame arena at its exact size
+		struct VisibleDebris {
+			std::int32_t Index;
+			std::int32_t Group;
+		};
+		ArrayView<VisibleDebris> visible = FrameArena::AllocateArray<VisibleDebris>((std::size_t)count);
+		std::size_t visibleCount = 0;
+
+		for (std::int32_t i = 0; i < count; i++) {
+			if (!viewportRect.Contains(Vector2f(posX[i], posY[i]))) {
 				continue;
 			}
 
-			const bool additiveBlending = ((debris.Flags & DebrisFlags::AdditiveBlending) == DebrisFlags::AdditiveBlending);
-			std::int32_t verticesIndex = -1;
+			const DebrisLook& look = _debris.Looks[i];
+			const bool additiveBlending = ((look.Flags & DebrisFlags::AdditiveBlending) == DebrisFlags::AdditiveBlending);
+			std::int32_t groupIndex = -1;
 			// A handful of groups at most (the burst, the tile debris, the weather), so a linear scan beats a map
-			for (auto& group : _debrisMeshGroups) {
-				if (group.DiffuseTexture == debris.DiffuseTexture && group.PaletteOffset == debris.PaletteOffset &&
-					group.Depth == debris.Depth && group.AdditiveBlending == additiveBlending) {
-					verticesIndex = group.VerticesIndex;
+			for (std::int32_t j = 0; j < (std::int32_t)_debrisMeshGroups.size(); j++) {
+				const auto& group = _debrisMeshGroups[j];
+				if (group.DiffuseTexture == look.DiffuseTexture && group.PaletteOffset == look.PaletteOffset &&
+					group.Depth == look.Depth && group.AdditiveBlending == additiveBlending) {
+					groupIndex = j;
 					break;
 				}
 			}
-			if (verticesIndex < 0) {
-				verticesIndex = RentMeshVertices();
-				_debrisMeshGroups.push_back({ debris.DiffuseTexture, debris.PaletteOffset, debris.Depth,
-					additiveBlending, verticesIndex });
+			if (groupIndex < 0) {
+				groupIndex = (std::int32_t)_debrisMeshGroups.size();
+				_debrisMeshGroups.push_back({ look.DiffuseTexture, look.PaletteOffset, look.Depth,
+					additiveBlending, 0, {} });
 			}
 
-			AppendDebrisQuad(_meshVertices[verticesIndex], debris);
+			_debrisMeshGroups[groupIndex].QuadCount++;
+			visible[visibleCount++] = { i, groupIndex };
+		}
+
+		visible = FrameArena::Shrink(visible, visibleCount);
+		for (auto& group : _debrisMeshGroups) {
+			group.Vertices.Storage = FrameArena::AllocateArray<float>((std::size_t)group.QuadCount * 6 * 8);
+		}
+		for (std::size_t i = 0; i < visibleCount; i++) {
+			AppendDebrisQuad(_debrisMeshGroups[visible[i].Group].Vertices, visible[i].Index);
 		}
 
 		for (const auto& group : _debrisMeshGroups) {
 			// Indexed sprite debris is recolored at draw time through the palette shader; baked debris (a tileset
 			// texture, for instance) carries its colors already and uses the plain mesh shader
 			const bool indexed = (group.PaletteOffset >= 0);
-			EmitMesh(renderQueue, _meshVertices[group.VerticesIndex], *group.DiffuseTexture, indexed,
+			EmitMesh(renderQueue, group.Vertices.Storage, *group.DiffuseTexture, indexed,
 				(std::uint16_t)(indexed ? group.PaletteOffset : 0), Vector4f(1.0f, 1.0f, 1.0f, 1.0f),
 				group.Depth, RenderCommand::Type::Particle, group.AdditiveBlending);
 		}
@@ -2086,8 +2406,15 @@ namespace Jazz2::Tiles
 		auto& resolver = ContentResolver::Get();
 		Texture* paletteTexture = resolver.GetPaletteTexture();
 
-		for (const auto& debris : _debrisList) {
-			if (!viewportRect.Contains(debris.Pos)) {
+		const float* posX = _debris[DebrisStreams::PosX];
+		const float* posY = _debris[DebrisStreams::PosY];
+		const float* scale = _debris[DebrisStreams::Scale];
+		const float* angle = _debris[DebrisStreams::Angle];
+		const float* alpha = _debris[DebrisStreams::Alpha];
+		const std::int32_t count = _debris.Count;
+
+		for (std::int32_t i = 0; i < count; i++) {
+			if (!viewportRect.Contains(Vector2f(posX[i], posY[i]))) {
 				continue;
 			}
 
@@ -2102,45 +2429,45 @@ namespace Jazz2::Tiles
 			// on Sprite. Renting with that choice picks the same shader ConfigureSpriteShader() would, and
 			// hands back the instance uniforms already resolved - an exploding enemy emits hundreds of these
 			// in one frame, so a by-name lookup per uniform per debris is worth avoiding.
-			bool debrisIndexed = (debris.PaletteOffset >= 0);
+			const DebrisLook& look = _debris.Looks[i];
+			bool debrisIndexed = (look.PaletteOffset >= 0);
 			TileCommandUniforms* commandUniforms;
 			auto command = RentRenderCommand(LayerRendererType::Default, debrisIndexed, &commandUniforms);
 			command->SetType(RenderCommand::Type::Particle);
 
-			if ((debris.Flags & DebrisFlags::AdditiveBlending) == DebrisFlags::AdditiveBlending) {
+			if ((look.Flags & DebrisFlags::AdditiveBlending) == DebrisFlags::AdditiveBlending) {
 				command->GetMaterial().SetBlendingFactors(BlendingFactor::SrcAlpha, BlendingFactor::One);
 			} else {
 				command->GetMaterial().SetBlendingFactors(BlendingFactor::SrcAlpha, BlendingFactor::OneMinusSrcAlpha);
 			}
 
-			commandUniforms->TexRect->SetFloatValue(debris.TexScaleX, debris.TexBiasX, debris.TexScaleY, debris.TexBiasY);
-			commandUniforms->SpriteSize->SetFloatValue(debris.Size.X, debris.Size.Y);
-			commandUniforms->Color->SetFloatVector(Colorf(1.0f, 1.0f, 1.0f, debris.Alpha).Data());
+			commandUniforms->TexRect->SetFloatValue(look.TexScaleX, look.TexBiasX, look.TexScaleY, look.TexBiasY);
+			commandUniforms->SpriteSize->SetFloatValue(look.Size.X, look.Size.Y);
+			commandUniforms->Color->SetFloatVector(Colorf(1.0f, 1.0f, 1.0f, alpha[i]).Data());
 
 			// Translation * RotationZ * Scaling * Translation, composed directly. Chaining the four
 			// operations meant three 4x4 multiplies per particle - and a burst of debris is hundreds of
 			// them in one frame - where the result is just a scaled rotation plus an offset origin.
-			const float c = std::cos(debris.Angle);
-			const float s = std::sin(debris.Angle);
-			const float ns = std::sin(-debris.Angle);	// Never "-s", see the note in Matrix4x4::RotationZ()
-			const float xx = c * debris.Scale, xy = s * debris.Scale;
-			const float yx = ns * debris.Scale, yy = c * debris.Scale;
-			const float localX = debris.FrameOffset.X - debris.Size.X * 0.5f;
-			const float localY = debris.FrameOffset.Y - debris.Size.Y * 0.5f;
-			command->SetTransformation(Matrix4x4f(
-				Vector4f(xx, xy, 0.0f, 0.0f),
-				Vector4f(yx, yy, 0.0f, 0.0f),
-				Vector4f(0.0f, 0.0f, 1.0f, 0.0f),
-				Vector4f(debris.Pos.X + xx * localX + yx * localY,
-					debris.Pos.Y + xy * localX + yy * localY, 0.0f, 1.0f)));
-			command->SetLayer(debris.Depth);
-			command->GetMaterial().SetTexture(0, *debris.DiffuseTexture);
+			const float c = std::cos(angle[i]);
+			const float s = std::sin(angle[i]);
+			const float ns = std::sin(-angle[i]);	// Never "-s", see the note in Matrix4x4::RotationZ()
+			const float xx = c * scale[i], xy = s * scale[i];
+			const float yx = ns * scale[i], yy = c * scale[i];
+			const float localX = look.FrameOffset.X - look.Size.X * 0.5f;
+			const float localY = look.FrameOffset.Y - look.Size.Y * 0.5f;
+			command->SetTransformation(Matrix2x3f(
+				Vector2f(xx, xy),
+				Vector2f(yx, yy),
+				Vector2f(posX[i] + xx * localX + yx * localY,
+					posY[i] + xy * localX + yy * localY)));
+			command->SetLayer(look.Depth);
+			command->GetMaterial().SetTexture(0, *look.DiffuseTexture);
 			if (debrisIndexed) {
 				if (paletteTexture != nullptr) {
 					command->GetMaterial().SetTexture(1, *paletteTexture);
 				}
 				if (commandUniforms->PaletteOffset != nullptr) {
-					commandUniforms->PaletteOffset->SetFloatValue((float)debris.PaletteOffset);
+					commandUniforms->PaletteOffset->SetFloatValue((float)look.PaletteOffset);
 				}
 			}
 
@@ -2253,6 +2580,10 @@ namespace Jazz2::Tiles
 			flags |= (std::uint8_t)LayerTileFlags::FlipY;
 		}
 		tile.Flags = (LayerTileFlags)flags;
+
+		if (layerIndex == _sprLayerIndex) {
+			UpdateTileCollisionClass(x, y);
+		}
 		return true;
 	}
 
@@ -2308,6 +2639,7 @@ namespace Jazz2::Tiles
 		for (const auto& saved : _sprLayerForRollback) {
 			layout[saved.TileIndex] = saved.Tile;
 		}
+		_tileCollisionDirty = true;
 
 		std::memcpy(_triggerState.data(), _triggerStateForRollback.data(), _triggerState.sizeInBytes());
 	}
@@ -2355,6 +2687,7 @@ namespace Jazz2::Tiles
 		}
 
 		src.Read(_triggerState.data(), _triggerState.sizeInBytes());
+		_tileCollisionDirty = true;
 	}
 
 	void TileMap::SerializeResumableToStream(Stream& dest, bool fromCheckpoint)
@@ -2411,7 +2744,7 @@ namespace Jazz2::Tiles
 		command->GetMaterial().Uniform("uShift")->SetFloatValue(x, y);
 		command->GetMaterial().Uniform("uHorizonColor")->SetFloatVector(layer.Description.Color.Data());
 
-		command->SetTransformation(Matrix4x4f::Translation(cullingRect.X, cullingRect.Y, 0.0f));
+		command->SetTransformation(Matrix2x3f::Translation(cullingRect.X, cullingRect.Y));
 		command->SetLayer(layer.Description.Depth);
 		command->GetMaterial().SetTexture(*target);
 
@@ -2455,6 +2788,73 @@ namespace Jazz2::Tiles
 		return tileId;
 	}
 
+	TileMap::TileCollisionClass TileMap::GetTileCollisionClass(const LayerTile& tile)
+	{
+		// Destructible and animated tiles change their mask at runtime and one-way tiles depend on the direction,
+		// so they always take the per-tile path. Destruction animations thus never have to touch the bitsets.
+		if (tile.DestructType != TileDestructType::None || tile.TileID >= _animatedTilesOffset ||
+			(tile.Flags & LayerTileFlags::OneWay) == LayerTileFlags::OneWay) {
+			return TileCollisionClass::Partial;
+		}
+		if (tile.HasSuspendType != SuspendType::None) {
+			return TileCollisionClass::Empty;
+		}
+
+		std::int32_t tileId = ResolveTileID(tile);
+		TileSet* tileSet = ResolveTileSet(tileId);
+		if (tileSet == nullptr || tileSet->IsTileMaskEmpty(tileId)) {
+			return TileCollisionClass::Empty;
+		}
+		return (tileSet->IsTileMaskFilled(tileId) ? TileCollisionClass::Solid : TileCollisionClass::Partial);
+	}
+
+	void TileMap::RebuildTileCollisionClasses()
+	{
+		ZoneScopedC(0xA09359);
+
+		_tileCollisionDirty = false;
+
+		const TileMapLayer& sprLayer = _layers[_sprLayerIndex];
+		_tileCollisionStride = (sprLayer.LayoutSize.X + 63) / 64;
+		std::size_t wordCount = (std::size_t)_tileCollisionStride * sprLayer.LayoutSize.Y;
+		_tileCollisionEmpty.assign(wordCount, 0);
+		_tileCollisionSolid.assign(wordCount, 0);
+
+		for (std::int32_t y = 0; y < sprLayer.LayoutSize.Y; y++) {
+			std::uint64_t* emptyRow = &_tileCollisionEmpty[y * _tileCollisionStride];
+			std::uint64_t* solidRow = &_tileCollisionSolid[y * _tileCollisionStride];
+			const LayerTile* tiles = &sprLayer.Layout[y * sprLayer.LayoutSize.X];
+			for (std::int32_t x = 0; x < sprLayer.LayoutSize.X; x++) {
+				switch (GetTileCollisionClass(tiles[x])) {
+					case TileCollisionClass::Empty: emptyRow[x >> 6] |= (1ull << (x & 63)); break;
+					case TileCollisionClass::Solid: solidRow[x >> 6] |= (1ull << (x & 63)); break;
+					default: break;
+				}
+			}
+		}
+	}
+
+	void TileMap::UpdateTileCollisionClass(std::int32_t tx, std::int32_t ty)
+	{
+		if (_tileCollisionDirty) {
+			// The whole bitsets will be rebuilt on the next query anyway
+			return;
+		}
+
+		const TileMapLayer& sprLayer = _layers[_sprLayerIndex];
+		TileCollisionClass tileClass = GetTileCollisionClass(sprLayer.Layout[ty * sprLayer.LayoutSize.X + tx]);
+
+		std::size_t word = (std::size_t)ty * _tileCollisionStride + (tx >> 6);
+		std::uint64_t tileBit = (1ull << (tx & 63));
+		_tileCollisionEmpty[word] &= ~tileBit;
+		_tileCollisionSolid[word] &= ~tileBit;
+		if (tileClass == TileCollisionClass::Empty) {
+			_tileCollisionEmpty[word] |= tileBit;
+		} else if (tileClass == TileCollisionClass::Solid) {
+			_tileCollisionSolid[word] |= tileBit;
+		}
+	}
+
 	void TileMap::TexturedBackgroundPass::Initialize()
 	{
 		bool notInitialized = (_view == nullptr);
@@ -2546,7 +2946,7 @@ namespace Jazz2::Tiles
 				instanceBlock->GetUniform(Material::SpriteSizeUniformName)->SetFloatValue(TileSet::DefaultTileSize, TileSet::DefaultTileSize);
 				instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatVector(Colorf::White.Data());
 
-				command->SetTransformation(Matrix4x4f::Translation(x * TileSet::DefaultTileSize, y * TileSet::DefaultTileSize, 0.0f));
+				command->SetTransformation(Matrix2x3f::Translation(x * TileSet::DefaultTileSize, y * TileSet::DefaultTileSize));
 				ContentResolver::Get().BindSpritePalette(*command, *tileTexture, tileSet->IsIndexed, 0);
 
 				renderQueue.AddCommand(command);
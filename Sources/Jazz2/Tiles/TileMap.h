@@ -10,6 +10,7 @@
 #include "../../nCine/Graphics/Camera.h"
 #include "../../nCine/Graphics/Viewport.h"
 
+#include <IO/SpanReader.h>
 #include <IO/Stream.h>
 
 using namespace Death::IO;
@@ -292,11 +293,10 @@ namespace Jazz2::Tiles
 		/**
 		 * @brief Creates a new instance
 		 *
-		 * @param tileSetPath   Relative path to the main tile set
-		 * @param captionTileId  Tile used to render the level-preview caption thumbnail
-		 * @param applyPalette   Whether to apply the tile set's palette to the live sprite palette
+		 * @param tileSetPath   Relative path to the main tile set, used only for diagnostics
+		 * @param tileSet       Main tile set loaded by @ref ContentResolver, or `nullptr` if it couldn't be loaded
 		 */
-		TileMap(StringView tileSetPath, std::uint16_t captionTileId, bool applyPalette);
+		TileMap(StringView tileSetPath, std::unique_ptr<TileSet> tileSet);
 		~TileMap();
 
 		/** @brief Returns `true` if all used tile sets are loaded */
@@ -348,12 +348,12 @@ namespace Jazz2::Tiles
 		/** @brief Advances descructible animation of a given tile */
 		bool AdvanceDestructibleTileAnimation(std::int32_t tx, std::int32_t ty, std::int32_t amount);
 
-		/** @brief Adds an additional tile set as a continuation of the previous one */
-		void AddTileSet(StringView tileSetPath, std::uint16_t offset, std::uint16_t count, const std::uint8_t* paletteRemapping = nullptr);
+		/** @brief Adds an additional tile set as a continuation of the previous one, `tileSet` is `nullptr` if it couldn't be loaded */
+		void AddTileSet(StringView tileSetPath, std::unique_ptr<TileSet> tileSet, std::uint16_t offset, std::uint16_t count);
 		/** @brief Reads layer configuration from a stream */
-		void ReadLayerConfiguration(Stream& s);
+		void ReadLayerConfiguration(SpanReader& s);
 		/** @brief Reads description of animated tiles from a stream */
-		void ReadAnimatedTiles(Stream& s);
+		void ReadAnimatedTiles(SpanReader& s);
 		/** @brief Sets tile event flags */
 		void SetTileEventFlags(std::int32_t x, std::int32_t y, EventType tileEvent, std::uint8_t* tileParams);
 		/** @brief Overrides the diffuse texture of the specified tile */
@@ -380,7 +380,7 @@ namespace Jazz2::Tiles
 		/**
 			@brief Maximum number of live debris particles, or `0` if the effect is unbounded
 
-			A live particle is far more expensive than its 100 bytes in @ref _debrisList: it also rents a pooled
+			A live particle is far more expensive than its 100 bytes in @ref _debris: it also rents a pooled
 			@ref RenderCommand for every frame it is visible (~840 bytes on the Dreamcast, see @ref
 			RentRenderCommand()) and its instance uniforms take a slice of both the render batcher's and the
 			streaming uniform buffer's pools, which only ever grow to their high-water mark. Together that is
@@ -421,7 +421,7 @@ namespace Jazz2::Tiles
 
 		/** @brief Returns number of live debris particles */
 		std::int32_t GetDebrisCount() const {
-			return (std::int32_t)_debrisList.size();
+			return _debris.Count;
 		}
 		/**
 		 * @brief Returns the step in which a particle debris burst walks a sprite frame of the given size
@@ -507,6 +507,57 @@ namespace Jazz2::Tiles
 			LayerTile Tile;
 		};
 
+		// Live debris, stored as one stream per simulated field instead of an array of DestructibleDebris. A
+		// burst is hundreds of particles that all run the same few multiply-adds every frame, so the integration
+		// walks each stream linearly in SIMD-wide blocks and only touches the fields it needs. The per-particle
+		// appearance (texture, UVs, size, depth, flags) is never simulated, so it stays together in one record
+		// that only DrawDebris() and the collision pass read. Every stream has the same capacity, rounded up to
+		// the block width, so a block loop may run over the padding at the tail without a scalar remainder.
+		struct DebrisLook {
+			Vector2f Size;
+			Vector2f FrameOffset;
+			float TexScaleX;
+			float TexBiasX;
+			float TexScaleY;
+			float TexBiasY;
+			Texture* DiffuseTexture;
+			std::int32_t PaletteOffset;
+			std::uint16_t Depth;
+			DebrisFlags Flags;
+		};
+
+		struct DebrisStreams {
+			enum Field {
+				PosX, PosY, SpeedX, SpeedY, AccelX, AccelY, Scale, ScaleSpeed,
+				Angle, AngleSpeed, Alpha, AlphaSpeed, Time, Elasticity,
+				FieldCount
+			};
+
+			// Number of particles processed together by the integration, the capacity is always a multiple of it
+			static constexpr std::int32_t BlockSize = 4;
+
+			std::unique_ptr<float[]> Data;
+			std::unique_ptr<DebrisLook[]> Looks;
+			std::int32_t Count = 0;
+			std::int32_t Capacity = 0;
+
+			float* operator[](Field field) {
+				return Data.get() + (std::size_t)field * Capacity;
+			}
+			const float* operator[](Field field) const {
+				return Data.get() + (std::size_t)field * Capacity;
+			}
+
+			void Reserve(std::int32_t capacity);
+			void Shrink(std::int32_t capacity);
+			void Add(const DestructibleDebris& debris);
+
+		private:
+			void Reallocate(std::int32_t capacity);
+		};
+#endif
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
 		class TexturedBackgroundPass : public SceneNode
 		{
 			friend class TileMap;
@@ -548,6 +599,22 @@ namespace Jazz2::Tiles
 		BitArray _triggerState;
 		BitArray _triggerStateForRollback;
 
+		/// Collision class of a sprite layer tile, see @ref GetTileCollisionClass()
+		enum class TileCollisionClass : std::uint8_t {
+			Empty,
+			Solid,
+			Partial
+		};
+
+		/// Per-row bitsets of sprite layer tiles classified as @ref TileCollisionClass::Empty and @ref TileCollisionClass::Solid,
+		/// @ref _tileCollisionStride words per row. @ref IsTileEmpty(const AABBf&, TileCollisionParams&) resolves these with a few
+		/// bit operations and only walks the remaining (partial, destructible, animated or one-way) tiles one by one.
+		SmallVector<std::uint64_t, 0> _tileCollisionEmpty;
+		SmallVector<std::uint64_t, 0> _tileCollisionSolid;
+		std::int32_t _tileCollisionStride;
+		/// Set when the bitsets have to be rebuilt as a whole, e.g., after loading or when a tile set or its mask changes
+		bool _tileCollisionDirty;
+
 		/// Cached instance-block uniforms of one pooled per-tile render command
 		struct TileCommandUniforms
 		{
@@ -557,7 +624,10 @@ namespace Jazz2::Tiles
 			RHI::UniformCache* PaletteOffset = nullptr;
 		};
 
-		SmallVector<DestructibleDebris, 0> _debrisList;
+		DebrisStreams _debris;
+		/// Indices of the live particles that collide with the sprite layer (@ref DebrisFlags::Bounce or @ref
+		/// DebrisFlags::Disappear), collected by the compaction at the start of @ref UpdateDebris()
+		SmallVector<std::int32_t, 0> _debrisCollidable;
 		SmallVector<std::unique_ptr<RenderCommand>, 0> _renderCommands;
 		/// Instance-block uniforms of the correspondingly indexed pooled command. Resolving them by name costs
 		/// a linear scan of the block, which at one command per visible tile dominated the layer build - they
@@ -570,18 +640,21 @@ namespace Jazz2::Tiles
 		std::int32_t _renderCommandsPeakAge;
 
 #if defined(TILEMAP_USE_SINGLE_DRAW)
-		// Per-frame pools for aggregated meshes, replacing the per-tile and per-particle commands. One vertex buffer
-		// is filled per drawn tile layer and per debris group; each mesh is then split into chunks that individually
-		// fit the shared array buffer limit (64 KB), so a mesh emits one command per chunk (usually just one). Both
-		// pools grow on demand and reset in OnEndFrame(); host vertex pointers reference the buffers until the render
-		// queue is flushed, so a buffer is never reused within a frame (across viewports the counts simply keep growing).
-		SmallVector<SmallVector<float, 0>, 0> _meshVertices;
+		// Per-frame pool of commands for aggregated meshes, replacing the per-tile and per-particle commands. One
+		// vertex stream is filled per drawn tile layer and per debris group; each mesh is then split into chunks that
+		// individually fit the shared array buffer limit (64 KB), so a mesh emits one command per chunk (usually just
+		// one). The pool grows on demand and resets in OnEndFrame(). The vertex streams themselves live in the frame
+		// arena, which keeps them valid until the render queue is flushed (see @ref FrameArena).
 		SmallVector<std::unique_ptr<RenderCommand>, 0> _meshCommands;
-		std::int32_t _meshVerticesCount = 0;
 		std::int32_t _meshCommandCount = 0;
-		/// Highest number of vertex buffers rented in one frame since the pool was last trimmed. Shares the age
-		/// counter of the command pool, as both are trimmed together (see @ref OnEndFrame()).
-		std::int32_t _meshVerticesPeak = 0;
+
+		/// Vertex stream of one aggregated mesh, allocated in the frame arena for the most quads it can receive
+		/// and filled from the front
+		struct MeshVertices
+		{
+			ArrayView<float> Storage;
+			std::size_t Size = 0;
+		};
 
 		/// One accumulated batch of debris quads - everything a particle carries outside the vertex stream, so
 		/// particles that agree on all of it share a single draw (a death burst is one sprite at one depth, hence
@@ -592,7 +665,8 @@ namespace Jazz2::Tiles
 			std::int32_t PaletteOffset;
 			std::uint16_t Depth;
 			bool AdditiveBlending;
-			std::int32_t VerticesIndex;
+			std::int32_t QuadCount;
+			MeshVertices Vertices;
 		};
 
 		SmallVector<DebrisMeshGroup, 4> _debrisMeshGroups;
@@ -607,16 +681,13 @@ namespace Jazz2::Tiles
 #if defined(TILEMAP_USE_SINGLE_DRAW)
 		// Appends one tile's two triangles (6 vertices, 8 floats each: position.xy, texcoords.xy, color.rgba) to a
 		// layer mesh buffer. Color is (1,1,1,alpha); the layer tint is applied via the command's instance color.
-		static void AppendTileQuad(SmallVector<float, 0>& vertices, float x, float y, float size,
+		static void AppendTileQuad(MeshVertices& vertices, float x, float y, float size,
 			float texScaleX, float texBiasX, float texScaleY, float texBiasY, float alpha);
 		// Appends one particle's two triangles in the same layout, with its rotation, scale and frame offset already
 		// folded into the four corners - the quad the sprite shader would have synthesized from its model matrix
-		static void AppendDebrisQuad(SmallVector<float, 0>& vertices, const DestructibleDebris& debris);
-		// Rents a mesh vertex buffer from the per-frame pool and returns its index (the pool can reallocate, so
-		// callers hold indices rather than pointers)
-		std::int32_t RentMeshVertices();
+		void AppendDebrisQuad(MeshVertices& vertices, std::int32_t index) const;
 		// Emits an accumulated mesh as one or more render commands (split into <=64 KB chunks)
-		void EmitMesh(RenderQueue& renderQueue, SmallVector<float, 0>& vertices, const Texture& texture, bool indexed,
+		void EmitMesh(RenderQueue& renderQueue, ArrayView<const float> vertices, const Texture& texture, bool indexed,
 			std::uint16_t paletteOffset, const Vector4f& color, std::uint16_t depth, RenderCommand::Type type, bool additiveBlending);
 #endif
 
@@ -628,11 +699,17 @@ namespace Jazz2::Tiles
 		std::int32_t GetTileDestructibleFrameCount(const LayerTile& tile);
 
 		void UpdateDebris(float timeMult);
+		void CompactDebris();
+		void CollideDebris(float timeMult);
 		void DrawDebris(RenderQueue& renderQueue);
 
 		void RenderTexturedBackground(RenderQueue& renderQueue, const Rectf& cullingRect, Vector2f viewCenter, TileMapLayer& layer, float x, float y);
 
 		TileSet* ResolveTileSet(std::int32_t& tileId);
 		std::int32_t ResolveTileID(const LayerTile& tile) const;
+
+		TileCollisionClass GetTileCollisionClass(const LayerTile& tile);
+		void RebuildTileCollisionClasses();
+		void UpdateTileCollisionClass(std::int32_t tx, std::int32_t ty);
 	};
 }
\ No newline at end of file
@@ -2,30 +2,41 @@
 
 #include <cstring>
 
+#include <Containers/Array.h>
+#include <Containers/StringConcatenable.h>
+#include <IO/FileSystem.h>
+
+using namespace Death::IO;
+
 namespace Jazz2::Tiles
 {
+	namespace
+	{
+		// Baked collision data are only valid on the machine that wrote them, so the values are stored in native
+		// byte order - a file from a machine with a different byte order fails the signature check and is rebaked.
+		// The header is followed by the packed mask, the column spans and the per-tile flags.
+		struct BakedCollisionHeader {
+			std::uint64_t Signature;
+			std::uint16_t Version;
+			std::uint16_t TileCount;
+			std::uint32_t MaskSize;
+			std::int64_t SourceSize;
+			std::int64_t SourceTime;
+		};
+
+		constexpr std::uint64_t BakedCollisionSignature = 0x4C4F43544A325A4AULL;
+		constexpr std::uint16_t BakedCollisionVersion = 1;
+	}
+
 	TileSet::TileSet(StringView path, std::uint16_t tileCount, SmallVector<std::unique_ptr<Texture>, 1>&& textureDiffuse, std::unique_ptr<uint8_t[]> mask, std::uint32_t maskSize, std::unique_ptr<Color[]> captionTile, const std::uint8_t* tileDiffuseOpaque)
-		: FilePath(path), TextureDiffuse(std::move(textureDiffuse)), _mask(std::move(mask)), _captionTile(std::move(captionTile)),
-			_isMaskEmpty(), _isMaskFilled(), _isTileFilled(), _isColumnContiguous()
+		: FilePath(path), TextureDiffuse(std::move(textureDiffuse)), _mask(mask.get()), _maskSize(maskSize), _ownedMask(std::move(mask)),
+			_captionTile(std::move(captionTile)), _isMaskEmpty(), _isMaskFilled(), _isTileFilled(), _isColumnContiguous()
 	{
-		// TilesPerRow/TilesPerTexture are used only for rendering. Every chunk shares the layout of chunk 0
-		// (the last one may be shorter), so its size defines how many tiles each chunk covers.
-		if (!TextureDiffuse.empty() && TextureDiffuse[0] != nullptr) {
-			Vector2i texSize = TextureDiffuse[0]->GetSize();
-			TilesPerRow = (texSize.X / (DefaultTileSize + 2));
-			TilesPerTexture = TilesPerRow * (texSize.Y / (DefaultTileSize + 2));
-		} else {
-			TilesPerRow = 0;
-			TilesPerTexture = 0;
-		}
+		InitializeTiles(tileCount, tileDiffuseOpaque);
 
-		TileCount = tileCount;
-		_isMaskEmpty.resize(ValueInit, TileCount);
-		_isMaskFilled.resize(ValueInit, TileCount);
-		_isTileFilled.resize(ValueInit, TileCount);
-		_isColumnContiguous.resize(ValueInit, TileCount);
 		// 2 bytes per column (first/last solid row); zero-initialized by make_unique
-		_columnSpans = std::make_unique<std::uint8_t[]>((std::size_t)TileCount * DefaultTileSize * 2);
+		_ownedColumnSpans = std::make_unique<std::uint8_t[]>((std::size_t)TileCount * DefaultTileSize * 2);
+		_columnSpans = _ownedColumnSpans.get();
 
 		std::uint32_t maskMaxTiles = maskSize / MaskBytesPerTile;
 
@@ -50,19 +61,12 @@ namespace Jazz2::Tiles
 				_isMaskFilled.set(i);
 			}
 
-			// A tile is "filled" for rendering when its diffuse is fully opaque (used to cull hidden debris).
-			// The flag is computed from the diffuse alpha by the content loader; it is absent in headless
-			// mode, where rendering - and therefore this optimization - does not run.
-			if (tileDiffuseOpaque != nullptr && tileDiffuseOpaque[i] != 0) {
-				_isTileFilled.set(i);
-			}
-
 			// Precompute per-column solid spans. A tile whose every column is vertically contiguous
 			// (no solid-empty-solid gaps) can answer "is any pixel in this sub-rectangle solid?" with
 			// an exact per-column span overlap test, avoiding the O(width*height) per-pixel scan.
 			// Fully filled tiles are handled by an earlier IsTileMaskFilled() early-out, and empty
 			// tiles by IsTileMaskEmpty(), so this mainly accelerates slopes and other partial tiles.
-			std::uint8_t* spans = &_columnSpans[(std::size_t)i * DefaultTileSize * 2];
+			std::uint8_t* spans = &_ownedColumnSpans[(std::size_t)i * DefaultTileSize * 2];
 			bool columnContiguous = (i < maskMaxTiles && !maskEmpty);
 			if (columnContiguous) {
 				// Load each packed row once as a 32-bit word, then walk columns as bit tests
@@ -101,6 +105,58 @@ namespace Jazz2::Tiles
 		}
 	}
 
+	TileSet::TileSet(StringView path, std::uint16_t tileCount, SmallVector<std::unique_ptr<Texture>, 1>&& textureDiffuse, BakedCollision&& collision, std::unique_ptr<Color[]> captionTile, const std::uint8_t* tileDiffuseOpaque)
+		: FilePath(path), TextureDiffuse(std::move(textureDiffuse)), _mask(collision.Mask), _maskSize(collision.MaskSize),
+			_columnSpans(collision.ColumnSpans), _bakedOwner(std::move(collision.Owner)), _captionTile(std::move(captionTile)),
+			_isMaskEmpty(), _isMaskFilled(), _isTileFilled(), _isColumnContiguous()
+	{
+		InitializeTiles(tileCount, tileDiffuseOpaque);
+
+		for (std::uint32_t i = 0; i < tileCount; i++) {
+			std::uint8_t flags = collision.TileFlags[i];
+			if (flags & BakedCollision::MaskEmpty) {
+				_isMaskEmpty.set(i);
+			}
+			if (flags & BakedCollision::MaskFilled) {
+				_isMaskFilled.set(i);
+			}
+			if (flags & BakedCollision::ColumnContiguous) {
+				_isColumnContiguous.set(i);
+			}
+		}
+	}
+
+	void TileSet::InitializeTiles(std::uint16_t tileCount, const std::uint8_t* tileDiffuseOpaque)
+	{
+		// TilesPerRow/TilesPerTexture are used only for rendering. Every chunk shares the layout of chunk 0
+		// (the last one may be shorter), so its size defines how many tiles each chunk covers.
+		if (!TextureDiffuse.empty() && TextureDiffuse[0] != nullptr) {
+			Vector2i texSize = TextureDiffuse[0]->GetSize();
+			TilesPerRow = (texSize.X / (DefaultTileSize + 2));
+			TilesPerTexture = TilesPerRow * (texSize.Y / (DefaultTileSize + 2));
+		} else {
+			TilesPerRow = 0;
+			TilesPerTexture = 0;
+		}
+
+		TileCount = tileCount;
+		_isMaskEmpty.resize(ValueInit, TileCount);
+		_isMaskFilled.resize(ValueInit, TileCount);
+		_isTileFilled.resize(ValueInit, TileCount);
+		_isColumnContiguous.resize(ValueInit, TileCount);
+
+		// A tile is "filled" for rendering when its diffuse is fully opaque (used to cull hidden debris).
+		// The flag is computed from the diffuse alpha by the content loader; it is absent in headless
+		// mode, where rendering - and therefore this optimization - does not run.
+		if (tileDiffuseOpaque != nullptr) {
+			for (std::uint32_t i = 0; i < tileCount; i++) {
+				if (tileDiffuseOpaque[i] != 0) {
+					_isTileFilled.set(i);
+				}
+			}
+		}
+	}
+
 	bool TileSet::OverrideTileDiffuse(std::int32_t tileId, StaticArrayView<(DefaultTileSize + 2) * (DefaultTileSize + 2), std::uint32_t> tileDiffuse)
 	{
 		if (tileId >= TileCount) {
@@ -175,8 +231,15 @@ namespace Jazz2::Tiles
 			return false;
 		}
 
+		if (_ownedMask == nullptr) {
+			// The baked mask is mapped read-only and may be shared with other processes, so copy it on first change
+			_ownedMask = std::make_unique<std::uint8_t[]>(_maskSize);
+			std::memcpy(_ownedMask.get(), _mask, _maskSize);
+			_mask = _ownedMask.get();
+		}
+
 		// The level cache delivers overridden masks byte-per-pixel; pack them into the tile's 1-bit store
-		auto* maskOffset = &_mask[tileId * MaskBytesPerTile];
+		auto* maskOffset = &_ownedMask[tileId * MaskBytesPerTile];
 		std::memset(maskOffset, 0, MaskBytesPerTile);
 
 		bool maskEmpty = true;
@@ -197,4 +260,63 @@ namespace Jazz2::Tiles
 
 		return true;
 	}
+
+	TileSet::BakedCollision TileSet::MapBakedCollision(StringView path, std::uint16_t tileCount, std::int64_t sourceSize, std::int64_t sourceTime)
+	{
+		BakedCollision collision;
+#if defined(DEATH_TARGET_ANDROID) || defined(DEATH_TARGET_APPLE) || defined(DEATH_TARGET_UNIX) || (defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT))
+		auto mapped = fs::OpenAsMemoryMapped(path, FileAccess::Read);
+		if (!mapped || mapped->size() < sizeof(BakedCollisionHeader)) {
+			return collision;
+		}
+
+		BakedCollisionHeader header;
+		std::memcpy(&header, mapped->data(), sizeof(BakedCollisionHeader));
+		std::size_t spansSize = (std::size_t)tileCount * DefaultTileSize * 2;
+		if (header.Signature != BakedCollisionSignature || header.Version != BakedCollisionVersion || header.TileCount != tileCount ||
+			header.SourceSize != sourceSize || header.SourceTime != sourceTime ||
+			mapped->size() != sizeof(BakedCollisionHeader) + header.MaskSize + spansSize + tileCount) {
+			return collision;
+		}
+
+		const std::uint8_t* data = reinterpret_cast<const std::uint8_t*>(mapped->data()) + sizeof(BakedCollisionHeader);
+		collision.Mask = data;
+		collision.MaskSize = header.MaskSize;
+		collision.ColumnSpans = data + header.MaskSize;
+		collision.TileFlags = data + header.MaskSize + spansSize;
+		// The pages stay mapped as long as the tile set lives, unmapping the shared copy only when it's the last one
+		collision.Owner = std::make_shared<Array<char, fs::MapDeleter>>(std::move(*mapped));
+#endif
+		return collision;
+	}
+
+	bool TileSet::SaveBakedCollision(StringView path, std::int64_t sourceSize, std::int64_t sourceTime) const
+	{
+		fs::CreateDirectories(fs::GetDirectoryName(path));
+
+		BakedCollisionHeader header = {};
+		header.Signature = BakedCollisionSignature;
+		header.Version = BakedCollisionVersion;
+		header.TileCount = (std::uint16_t)TileCount;
+		header.MaskSize = _maskSize;
+		header.SourceSize = sourceSize;
+		header.SourceTime = sourceTime;
+
+		std::unique_ptr<std::uint8_t[]> tileFlags = std::make_unique<std::uint8_t[]>(TileCount);
+		for (std::int32_t i = 0; i < TileCount; i++) {
+			tileFlags[i] = (_isMaskEmpty[i] ? BakedCollision::MaskEmpty : 0) |
+				(_isMaskFilled[i] ? BakedCollision::MaskFilled : 0) |
+				(_isColumnContiguous[i] ? BakedCollision::ColumnContiguous : 0);
+		}
+
+		std::int64_t spansSize = (std::int64_t)TileCount * DefaultTileSize * 2;
+
+		// Multiple processes may bake the same tile set at once, those that already mapped the previous file keep using it
+		return fs::WriteAtomically(path, [&](Stream& s) {
+			return (s.Write(&header, sizeof(header)) == sizeof(header) &&
+				s.Write(_mask, _maskSize) == _maskSize &&
+				s.Write(_columnSpans, spansSize) == spansSize &&
+				s.Write(tileFlags.get(), TileCount) == TileCount);
+		});
+	}
 }
\ No newline at end of file
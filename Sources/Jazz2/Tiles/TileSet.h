@@ -46,6 +46,40 @@ namespace Jazz2::Tiles
 		 */
 		TileSet(StringView path, std::uint16_t tileCount, SmallVector<std::unique_ptr<Texture>, 1>&& textureDiffuse, std::unique_ptr<std::uint8_t[]> mask, std::uint32_t maskSize, std::unique_ptr<Color[]> captionTile, const std::uint8_t* tileDiffuseOpaque = nullptr);
 
+		/**
+		 * @brief Collision data of a tile set baked by a previous run, usually memory-mapped from the cache
+		 *
+		 * The data are read-only and position-independent, so all processes mapping the same file share one copy
+		 * of them in memory, see @ref MapBakedCollision().
+		 */
+		struct BakedCollision {
+			/** @brief Flag of a tile with completely empty mask */
+			static constexpr std::uint8_t MaskEmpty = 0x01;
+			/** @brief Flag of a tile with completely filled mask */
+			static constexpr std::uint8_t MaskFilled = 0x02;
+			/** @brief Flag of a tile with vertically contiguous columns, see @ref IsColumnContiguous() */
+			static constexpr std::uint8_t ColumnContiguous = 0x04;
+
+			/** @brief Packed collision mask of all tiles (@ref MaskBytesPerTile bytes each) */
+			const std::uint8_t* Mask = nullptr;
+			/** @brief Size of the packed collision mask in bytes */
+			std::uint32_t MaskSize = 0;
+			/** @brief Per-column solid spans of all tiles, see @ref GetColumnSpans() */
+			const std::uint8_t* ColumnSpans = nullptr;
+			/** @brief Combination of the flags above for each tile */
+			const std::uint8_t* TileFlags = nullptr;
+			/** @brief Keeps the memory of the data alive (e.g., the file mapping) */
+			std::shared_ptr<void> Owner;
+		};
+
+		/**
+		 * @brief Creates a new instance from baked collision data
+		 *
+		 * The per-tile classification is taken from @p collision instead of scanning the mask. The mask itself is
+		 * copied only if @ref OverrideTileMask() is called.
+		 */
+		TileSet(StringView path, std::uint16_t tileCount, SmallVector<std::unique_ptr<Texture>, 1>&& textureDiffuse, BakedCollision&& collision, std::unique_ptr<Color[]> captionTile, const std::uint8_t* tileDiffuseOpaque = nullptr);
+
 		/** @brief Relative path to source file */
 		String FilePath;
 		/** @brief Main (diffuse) texture(s): a single texture normally, consecutive row-band chunks when the device texture-size limit forced a split */
@@ -104,6 +138,12 @@ namespace Jazz2::Tiles
 			return &_mask[tileId * MaskBytesPerTile];
 		}
 
+		/** @brief Returns size of the packed collision mask of all tiles in bytes */
+		std::uint32_t GetMaskSize() const
+		{
+			return _maskSize;
+		}
+
 		/** @brief Returns one row of a packed tile mask as a 32-bit word (bit `x` set = column `x` solid) */
 		static std::uint32_t GetTileMaskRow(const std::uint8_t* packedMask, std::int32_t y)
 		{
@@ -184,13 +224,37 @@ namespace Jazz2::Tiles
 		/** @brief Overrides the collision mask of the specified tile */
 		bool OverrideTileMask(std::int32_t tileId, StaticArrayView<DefaultTileSize * DefaultTileSize, std::uint8_t> tileMask);
 
+		/**
+		 * @brief Maps collision data baked by @ref SaveBakedCollision() to memory
+		 *
+		 * Returns empty data (with @cpp nullptr @ce mask) if the file doesn't exist, is damaged or was baked from
+		 * a different source file, which is identified by its size and last modification time.
+		 *
+		 * @partialsupport Returns empty data on platforms without memory-mapped files.
+		 */
+		static BakedCollision MapBakedCollision(StringView path, std::uint16_t tileCount, std::int64_t sourceSize, std::int64_t sourceTime);
+		/**
+		 * @brief Bakes the collision data of all tiles to the specified file
+		 *
+		 * The file is written under a temporary name first and then renamed, so other processes never map
+		 * a partially written file.
+		 */
+		bool SaveBakedCollision(StringView path, std::int64_t sourceSize, std::int64_t sourceTime) const;
+
 	private:
-		std::unique_ptr<uint8_t[]> _mask;
-		std::unique_ptr<std::uint8_t[]> _columnSpans;
+		// Either owned by the tile set or baked, `_ownedMask`/`_ownedColumnSpans` are empty if baked
+		const std::uint8_t* _mask;
+		std::uint32_t _maskSize;
+		const std::uint8_t* _columnSpans;
+		std::unique_ptr<std::uint8_t[]> _ownedMask;
+		std::unique_ptr<std::uint8_t[]> _ownedColumnSpans;
+		std::shared_ptr<void> _bakedOwner;
 		std::unique_ptr<Color[]> _captionTile;
 		BitArray _isMaskEmpty;
 		BitArray _isMaskFilled;
 		BitArray _isTileFilled;
 		BitArray _isColumnContiguous;
+
+		void InitializeTiles(std::uint16_t tileCount, const std::uint8_t* tileDiffuseOpaque);
 	};
 }
\ No newline at end of file
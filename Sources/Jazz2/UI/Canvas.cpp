@@ -82,11 +82,11 @@ namespace Jazz2::UI
 			}
 		}
 
-		Matrix4x4f worldMatrix = Matrix4x4f::Translation(pos.X, pos.Y, 0.0f);
+		Matrix2x3f worldMatrix = Matrix2x3f::Translation(pos.X, pos.Y);
 		if (std::abs(angle) > 0.01f) {
-			worldMatrix.Translate(size.X * 0.5f, size.Y * 0.5f, 0.0f);
+			worldMatrix.Translate(size.X * 0.5f, size.Y * 0.5f);
 			worldMatrix.RotateZ(angle);
-			worldMatrix.Translate(size.X * -0.5f, size.Y * -0.5f, 0.0f);
+			worldMatrix.Translate(size.X * -0.5f, size.Y * -0.5f);
 		}
 		command->SetTransformation(worldMatrix);
 		command->SetLayer(z);
@@ -141,7 +141,7 @@ namespace Jazz2::UI
 			palOffsetUniform->SetFloatValue(paletteOffset);
 		}
 
-		command->SetTransformation(Matrix4x4f::Translation(pos.X, pos.Y, 0.0f));
+		command->SetTransformation(Matrix2x3f::Translation(pos.X, pos.Y));
 		command->SetLayer(z);
 		command->GetMaterial().SetTexture(0, texture);
 		command->GetMaterial().SetTexture(1, palette);
@@ -174,7 +174,7 @@ namespace Jazz2::UI
 		instanceBlock->GetUniform(Material::SpriteSizeUniformName)->SetFloatVector(size.Data());
 		instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatVector(finalColor.Data());
 
-		command->SetTransformation(Matrix4x4f::Translation(pos.X, pos.Y, 0.0f));
+		command->SetTransformation(Matrix2x3f::Translation(pos.X, pos.Y));
 		command->SetLayer(z);
 		command->GetMaterial().SetTexture(0, nullptr);
 
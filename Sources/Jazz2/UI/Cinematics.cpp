@@ -1030,7 +1030,7 @@ namespace Jazz2::UI
 		instanceBlock->GetUniform(Material::SpriteSizeUniformName)->SetFloatVector(frameSize.Data());
 		instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatVector(Colorf::White.Data());
 
-		_renderCommand.SetTransformation(Matrix4x4f::Translation(frameOffset.X, frameOffset.Y, 0.0f));
+		_renderCommand.SetTransformation(Matrix2x3f::Translation(frameOffset.X, frameOffset.Y));
 		_renderCommand.GetMaterial().SetTexture(0, *_owner->_textures[_owner->_textureIndex]);
 		if (!_owner->_convertTo565) {
 			_renderCommand.GetMaterial().SetTexture(1, *_owner->_paletteTexture);
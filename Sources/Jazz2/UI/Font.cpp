@@ -6,17 +6,21 @@
 #include "../../nCine/Graphics/RenderQueue.h"
 #include "../../nCine/Base/Random.h"
 
+#include <Cryptography/xxHash.h>
 #include <IO/Compression/DeflateStream.h>
 
 #include <Utf8.h>
 
+#include <cstring>
+
 using namespace Death;
+using namespace Death::Cryptography;
 using namespace Death::IO::Compression;
 
 namespace Jazz2::UI
 {
 	Font::Font(const std::unique_ptr<Stream>& s, StringView path, const std::uint32_t* palette)
-		: _asciiChars{}, _lineHeight(0), _baseSpacing(0)
+		: _glyphs{}, _lineHeight(0), _baseSpacing(0)
 	{
 		if (!s->IsValid()) {
 			// A font that can't be opened at all used to fail silently here, which then looked like a
@@ -77,20 +81,30 @@ namespace Jazz2::UI
 		for (std::int32_t i = 0; i < asciiCount; i++) {
 			const std::int32_t c = asciiFirst + i;
 			FontFormat::Glyph glyph = readGlyph();
-			if (c < std::int32_t(arraySize(_asciiChars))) {
-				_asciiChars[c] = glyph;
+			if (c < 128) {
+				_glyphs[c] = glyph;
 			}
 		}
 
+		// Characters of the flat range the font doesn't have are pointed at the fallback once it's known
+		bool hasGlyph[FlatGlyphCount - 128] = {};
 		for (std::int32_t i = 0; i < unicodeCount; i++) {
 			const std::uint32_t codepoint = uc.ReadValueAsLE<std::uint32_t>();
 			FontFormat::Glyph glyph = readGlyph();
 			if (codepoint == FontFormat::FallbackCodepoint) {
 				// The character drawn in place of anything the font doesn't have, kept where the lookup below
 				// can reach it without a second branch
-				_asciiChars[0] = glyph;
-			} else {
+				_glyphs[0] = glyph;
+			} else if (codepoint >= FlatGlyphCount) {
 				_unicodeChars[codepoint] = glyph;
+			} else if (codepoint >= 128) {
+				_glyphs[codepoint] = glyph;
+				hasGlyph[codepoint - 128] = true;
+			}
+		}
+		for (std::uint32_t c = 128; c < FlatGlyphCount; c++) {
+			if (!hasGlyph[c - 128]) {
+				_glyphs[c] = _glyphs[0];
 			}
 		}
 
@@ -156,12 +170,13 @@ namespace Jazz2::UI
 
 	const FontFormat::Glyph& Font::GetGlyph(char32_t c) const
 	{
-		if (c < arraySize(_asciiChars)) {
-			return _asciiChars[c];
+		// Every script of the bundled translations is covered by the array, the hash map only holds symbols
+		if (c < FlatGlyphCount) {
+			return _glyphs[c];
 		}
 
 		auto it = _unicodeChars.find(std::uint32_t(c));
-		return (it != _unicodeChars.end() ? it->second : _asciiChars[0]);
+		return (it != _unicodeChars.end() ? it->second : _glyphs[0]);
 	}
 
 	Vector2f Font::MeasureChar(char32_t c) const
@@ -269,37 +284,40 @@ namespace Jazz2::UI
 		return Vector2f(ceilf(totalWidth), ceilf(totalHeight));
 	}
 
-	void Font::DrawString(Canvas* canvas, StringView text, std::int32_t& charOffset, float x, float y, std::uint16_t z, Alignment align, Colorf color, float scale, float angleOffset, float varianceX, float varianceY, float speed, float charSpacing, float lineSpacing)
+	const Font::TextLayout& Font::GetLayout(StringView text, float scale, float charSpacing, float lineSpacing)
 	{
-		std::size_t textLength = text.size();
-		if (textLength == 0 || _lineHeight <= 0) {
-			return;
+		// Direct-mapped, a string that collides with another one drawn in the same frame is simply laid out
+		// again, which is no worse than what every string used to cost. The text is compared in full, the hash
+		// only picks the slot.
+		const std::uint64_t hash = xxHash3(text.data(), text.size());
+		TextLayout& layout = _layoutCache[hash & (LayoutCacheSize - 1)];
+		if (layout.Hash != hash || layout.Scale != scale || layout.CharSpacing != charSpacing || layout.LineSpacing != lineSpacing ||
+			layout.Text.size() != text.size() || std::memcmp(layout.Text.data(), text.data(), text.size()) != 0) {
+			LayOutString(text, scale, charSpacing, lineSpacing, layout);
+			layout.Hash = hash;
+			layout.Scale = scale;
+			layout.CharSpacing = charSpacing;
+			layout.LineSpacing = lineSpacing;
+			// The storage of the evicted string is reused, so a slot stops allocating once it held its longest string
+			layout.Text.clear();
+			layout.Text.append(text.begin(), text.end());
 		}
+		return layout;
+	}
 
-		// TODO: Revise this
-		float phase = canvas->AnimTime * speed * 16.0f;
-
-		// Maximum number of lines - center and right alignment starts to glitch if text has more lines, but it should be enough in most cases
-		constexpr std::int32_t MaxLines = 16;
-
-		// Preprocessing. Its whole output - the total extent and the per-line widths - exists to place
-		// text that is centred, right aligned or bottom aligned. Left/top aligned text reads none of it,
-		// so measuring for it means walking every character of the string a second time to compute
-		// numbers nothing goes on to use. The credits are one long left-aligned block redrawn every
-		// frame, which is exactly the case that pays for it.
-		const Alignment horizontalAlign = (align & Alignment::HorizontalMask);
-		const Alignment verticalAlign = (align & Alignment::VerticalMask);
-		const bool measureExtent = (horizontalAlign == Alignment::Center || horizontalAlign == Alignment::Right ||
-			verticalAlign == Alignment::Center || verticalAlign == Alignment::Bottom);
+	void Font::LayOutString(StringView text, float scale, float charSpacing, float lineSpacing, TextLayout& layout)
+	{
+		std::size_t textLength = text.size();
 
+		// Measuring. Only centred, right aligned and bottom aligned text reads the extent, but the alignment
+		// is not part of the key, so it's always measured - once per string instead of once per frame.
 		float totalWidth = 0.0f, lastWidth = 0.0f, totalHeight = 0.0f;
-		float lineWidths[MaxLines];
 		float charSpacingPre = charSpacing;
 		float scalePre = scale;
 
 		std::int32_t idx = 0;
 		std::int32_t line = 0;
-		while (measureExtent) {
+		while (true) {
 			Pair<char32_t, std::size_t> cursor = Utf8::NextChar(text, idx);
 
 			if (cursor.first() == '\n') {
@@ -307,7 +325,7 @@ namespace Jazz2::UI
 				if (totalWidth < lastWidth) {
 					totalWidth = lastWidth;
 				}
-				lineWidths[line & (MaxLines - 1)] = lastWidth;
+				layout.LineWidths[line & (MaxLines - 1)] = lastWidth;
 				line++;
 				lastWidth = 0.0f;
 				totalHeight += (_lineHeight * scale * lineSpacing);
@@ -371,66 +389,35 @@ namespace Jazz2::UI
 			}
 		}
 
-		if (measureExtent) {
-			if (totalWidth < lastWidth) {
-				totalWidth = lastWidth;
-			}
-			lineWidths[line & (MaxLines - 1)] = lastWidth;
-			totalHeight += (_lineHeight * scale * lineSpacing);
-
-			// Format tags inside the walk above move this; the render pass has to start where the caller left it
-			charSpacing = charSpacingPre;
-		}
-
-		// Rendering
-		Vector2f originPos = Vector2f(x, y);
-		switch (align & Alignment::HorizontalMask) {
-			case Alignment::Center: originPos.X -= totalWidth * 0.5f; break;
-			case Alignment::Right: originPos.X -= totalWidth; break;
-		}
-		switch (align & Alignment::VerticalMask) {
-			case Alignment::Center: originPos.Y -= totalHeight * 0.5f; break;
-			case Alignment::Bottom: originPos.Y -= totalHeight; break;
+		if (totalWidth < lastWidth) {
+			totalWidth = lastWidth;
 		}
+		layout.LineWidths[line & (MaxLines - 1)] = lastWidth;
+		totalHeight += (_lineHeight * scale * lineSpacing);
+		layout.TotalWidth = totalWidth;
+		layout.TotalHeight = totalHeight;
 
-		float lineStart = originPos.X;
+		// Format tags inside the walk above move this; the glyph walk has to start where the caller left it
+		charSpacing = charSpacingPre;
 
-		switch (align & Alignment::HorizontalMask) {
-			case Alignment::Center: originPos.X += (totalWidth - lineWidths[0]) * 0.5f; break;
-			case Alignment::Right: originPos.X += (totalWidth - lineWidths[0]); break;
-		}
-
-		Vector2i texSize = _texture->GetSize();
-		Shader* colorizeShader;
-		bool useRandomColor, isShadow;
-		float alpha;
-		if (color.R == DefaultColor.R && color.G == DefaultColor.G && color.B == DefaultColor.B) {
-			colorizeShader = nullptr;
-			useRandomColor = false;
-			isShadow = false;
-			alpha = color.A;
-			color = Colorf(1.0f, 1.0f, 1.0f, alpha);
-		} else {
-			colorizeShader = ContentResolver::Get().GetShader(PrecompiledShader::Colorized);
-			useRandomColor = (color.R == RandomColor.R && color.G == RandomColor.G && color.B == RandomColor.B);
-			isShadow = (color.R == 0.0f && color.G == 0.0f && color.B == 0.0f);
-			alpha = std::min(color.A * 2.0f, 1.0f);
-		}
+		// Decoding into the glyphs that move the pen and the line breaks. Color tags are only recorded here,
+		// whether they apply depends on the color the string is drawn with, which is not part of the key.
+		LayoutColor colorState = LayoutColor::Initial;
+		std::uint32_t customColor = 0;
 
+		layout.Items.clear();
 		idx = 0;
-		line = 0;
 		do {
 			Pair<char32_t, std::size_t> cursor = Utf8::NextChar(text, idx);
 
 			if (cursor.first() == '\n') {
 				// New line
-				line++;
-				originPos.X = lineStart;
-				switch (align & Alignment::HorizontalMask) {
-					case Alignment::Center: originPos.X += (totalWidth - lineWidths[line & (MaxLines - 1)]) * 0.5f; break;
-					case Alignment::Right: originPos.X += (totalWidth - lineWidths[line & (MaxLines - 1)]); break;
-				}
-				originPos.Y += (_lineHeight * scale * lineSpacing);
+				LayoutItem& item = layout.Items.emplace_back();
+				item.Glyph = {};
+				item.IsNewLine = true;
+				item.ColorState = colorState;
+				item.Advance = 0.0f;
+				item.CustomColor = customColor;
 			} else if (cursor.first() == '\f') {
 				// Formatting
 				cursor = Utf8::NextChar(text, cursor.second());
@@ -459,16 +446,13 @@ namespace Jazz2::UI
 									idx = std::int32_t(cursor.second());
 								} while (idx < textLength);
 
-								if (paramLength > 0 && !useRandomColor && !isShadow) {
+								if (paramLength > 0) {
 									param[paramLength] = '\0';
 									char* end = &param[paramLength];
 									unsigned long paramValue = strtoul(param, &end, 16);
 									if (param != end) {
-										color = Color(paramValue);
-										color.SetAlpha(0.5f * alpha);
-										if (colorizeShader == nullptr) {
-											colorizeShader = ContentResolver::Get().GetShader(PrecompiledShader::Colorized);
-										}
+										colorState = LayoutColor::Custom;
+										customColor = std::uint32_t(paramValue);
 									}
 								}
 							}
@@ -505,10 +489,7 @@ namespace Jazz2::UI
 						cursor = Utf8::NextChar(text, idx);
 						if (cursor.first() == 'c') {
 							// Reset color
-							if (!useRandomColor && !isShadow) {
-								color = Colorf(1.0f, 1.0f, 1.0f, alpha);
-								colorizeShader = nullptr;
-							}
+							colorState = LayoutColor::Reset;
 						} else if (cursor.first() == 'w') {
 							// Reset char spacing
 							charSpacing = charSpacingPre;
@@ -521,117 +502,215 @@ namespace Jazz2::UI
 				}
 			} else {
 				const FontFormat::Glyph& glyph = GetGlyph(cursor.first());
-
 				if (glyph.Advance > 0) {
-					// A glyph is stored trimmed to the pixels it inks, so it draws at its bearing from the pen
-					// rather than at the pen itself. One with no pixels at all - a space - only moves the pen.
-					if (glyph.Width > 0 && glyph.Height > 0) {
-						if (useRandomColor) {
-							const Colorf& newColor = RandomColors[charOffset % std::int32_t(arraySize(RandomColors))];
-							color = Colorf(newColor.R, newColor.G, newColor.B, color.A);
-						}
+					LayoutItem& item = layout.Items.emplace_back();
+					item.Glyph = glyph;
+					item.IsNewLine = false;
+					item.ColorState = colorState;
+					item.Advance = ((glyph.Advance + _baseSpacing) * scale * charSpacing);
+					item.CustomColor = customColor;
+				}
+			}
 
-						Vector2f pos = Vector2f(originPos.X + glyph.BearingX * scale, originPos.Y + glyph.BearingY * scale);
-
-						// A glyph outside the view is laid out but not drawn. Nothing above depends on this
-						// and nothing below it does either - the pen, the character counter and the wobble
-						// phase all advance regardless - so the text lays out identically either way, and a
-						// glyph that cannot be seen costs neither the two trigonometric calls of the wobble
-						// nor a render command, a material setup and a draw. That is the difference between
-						// the cost of a screen of text and the cost of all the text there is: the credits
-						// are one long block scrolled past a small window, and every line of it, on screen
-						// or not, used to be submitted every frame.
-						//
-						// Tested before the wobble rather than after, which is where the saving mostly is -
-						// a sine and a cosine per glyph is the dearest thing in this loop. That costs
-						// nothing in accuracy: the wobble is bounded by the variance, so a glyph further
-						// out than that cannot be brought back into view by it, and it is carried here as
-						// a margin. The transform is the glyph's TOP-LEFT corner, not its centre - the
-						// canvas_item vertex stage spans the quad from the model origin by spriteSize.
-						//
-						// Tested against the whole view rather than the caller's clip rectangle, which is
-						// the conservative choice: a section that clips more tightly still gets everything
-						// it asks for. A canvas that never set its view size fails open and draws
-						// everything, since culling against a zero view would silently swallow the text.
-						const float layerScale = canvas->LayerScale;
-						const Vector2f unwobbled = pos * layerScale + canvas->LayerOffset;
-						const float glyphW = glyph.Width * scale * layerScale;
-						const float glyphH = glyph.Height * scale * layerScale;
-						// One extra pixel covers the rounding to whole pixels below
-						const float marginX = (angleOffset > 0.0f ? std::abs(varianceX) * scale * layerScale : 0.0f) + 1.0f;
-						const float marginY = (angleOffset > 0.0f ? std::abs(varianceY) * scale * layerScale : 0.0f) + 1.0f;
-						const bool boundsKnown = (canvas->ViewSize.X > 0 && canvas->ViewSize.Y > 0);
-						const bool onScreen = (!boundsKnown ||
-							(unwobbled.X + glyphW + marginX >= 0.0f && unwobbled.Y + glyphH + marginY >= 0.0f &&
-							 unwobbled.X - marginX <= float(canvas->ViewSize.X) &&
-							 unwobbled.Y - marginY <= float(canvas->ViewSize.Y)));
-						if (onScreen) {
-							if (angleOffset > 0.0f) {
-								float currentPhase = (phase + charOffset) * angleOffset * fPi;
-								if (speed > 0.0f && (charOffset % 2) == 1) {
-									currentPhase = -currentPhase;
-								}
+			idx = std::int32_t(cursor.second());
+		} while (idx < textLength);
+	}
 
-								pos.X += cosf(currentPhase) * varianceX * scale;
-								pos.Y += sinf(currentPhase) * varianceY * scale;
-							}
+	void Font::DrawString(Canvas* canvas, StringView text, std::int32_t& charOffset, float x, float y, std::uint16_t z, Alignment align, Colorf color, float scale, float angleOffset, float varianceX, float varianceY, float speed, float charSpacing, float lineSpacing)
+	{
+		std::size_t textLength = text.size();
+		if (textLength == 0 || _lineHeight <= 0) {
+			return;
+		}
 
-							// Apply the canvas-wide draw transform (menu section transitions; identity by default)
-							pos = pos * layerScale + canvas->LayerOffset;
-							float glyphScale = scale * layerScale;
-							Colorf glyphColor = color * canvas->LayerColor;
-
-							pos.X = std::round(pos.X);
-							pos.Y = std::round(pos.Y);
-
-							Vector4f texCoords = Vector4f(
-								glyph.Width / float(texSize.X),
-								glyph.X / float(texSize.X),
-								glyph.Height / float(texSize.Y),
-								glyph.Y / float(texSize.Y)
-							);
-
-							auto command = canvas->RentRenderCommand();
-							command->SetType(RenderCommand::Type::Text);
-							bool shaderChanged = (colorizeShader
-								? command->GetMaterial().SetShader(colorizeShader)
-								: command->GetMaterial().SetShaderProgramType(Material::ShaderProgramType::Sprite));
-							if (shaderChanged) {
-								command->GetMaterial().ReserveUniformsDataMemory();
-								command->GetGeometry().SetDrawParameters(PrimitiveType::TriangleStrip, 0, 4);
-								// Required to reset render command properly
-								//command->SetTransformation(command->transformation());
-
-								auto* textureUniform = command->GetMaterial().Uniform(Material::TextureUniformName);
-								if (textureUniform && textureUniform->GetIntValue(0) != 0) {
-									textureUniform->SetIntValue(0); // GL_TEXTURE0
-								}
-							}
+		// TODO: Revise this
+		float phase = canvas->AnimTime * speed * 16.0f;
 
-							// Separate alpha blend so text (e.g. semi-transparent shadows) accumulates correct alpha coverage
-							// when drawn into an RGBA render target, harmless for opaque/RGB targets
-							command->GetMaterial().SetBlendingFactors(BlendingFactor::SrcAlpha, BlendingFactor::OneMinusSrcAlpha, BlendingFactor::One, BlendingFactor::OneMinusSrcAlpha);
+		// Menus, the HUD and the console draw the same strings every frame, so the decoding and measuring is
+		// done once and only the cached result is walked here
+		const TextLayout& layout = GetLayout(text, scale, charSpacing, lineSpacing);
+		const float totalWidth = layout.TotalWidth;
+		const float totalHeight = layout.TotalHeight;
+		const float* lineWidths = layout.LineWidths;
+
+		// Rendering
+		Vector2f originPos = Vector2f(x, y);
+		switch (align & Alignment::HorizontalMask) {
+			case Alignment::Center: originPos.X -= totalWidth * 0.5f; break;
+			case Alignment::Right: originPos.X -= totalWidth; break;
+		}
+		switch (align & Alignment::VerticalMask) {
+			case Alignment::Center: originPos.Y -= totalHeight * 0.5f; break;
+			case Alignment::Bottom: originPos.Y -= totalHeight; break;
+		}
 
-							auto* instanceBlock = command->GetInstanceBlock();
-							instanceBlock->GetUniform(Material::TexRectUniformName)->SetFloatVector(texCoords.Data());
-							instanceBlock->GetUniform(Material::SpriteSizeUniformName)->SetFloatValue(glyph.Width * glyphScale, glyph.Height * glyphScale);
-							instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatVector(glyphColor.Data());
+		float lineStart = originPos.X;
 
-							command->SetTransformation(Matrix4x4f::Translation(pos.X, pos.Y, 0.0f));
-							command->SetLayer(z - (charOffset & 1));
-							command->GetMaterial().SetTexture(*_texture.get());
+		switch (align & Alignment::HorizontalMask) {
+			case Alignment::Center: originPos.X += (totalWidth - lineWidths[0]) * 0.5f; break;
+			case Alignment::Right: originPos.X += (totalWidth - lineWidths[0]); break;
+		}
 
-							canvas->_currentRenderQueue->AddCommand(command);
+		Vector2i texSize = _texture->GetSize();
+		Shader* colorizeShader;
+		bool useRandomColor, isShadow;
+		float alpha;
+		if (color.R == DefaultColor.R && color.G == DefaultColor.G && color.B == DefaultColor.B) {
+			colorizeShader = nullptr;
+			useRandomColor = false;
+			isShadow = false;
+			alpha = color.A;
+			color = Colorf(1.0f, 1.0f, 1.0f, alpha);
+		} else {
+			colorizeShader = ContentResolver::Get().GetShader(PrecompiledShader::Colorized);
+			useRandomColor = (color.R == RandomColor.R && color.G == RandomColor.G && color.B == RandomColor.B);
+			isShadow = (color.R == 0.0f && color.G == 0.0f && color.B == 0.0f);
+			alpha = std::min(color.A * 2.0f, 1.0f);
+		}
+
+		// Random colors and shadows ignore the color tags of the string
+		const bool applyColorTags = (!useRandomColor && !isShadow);
+		LayoutColor colorState = LayoutColor::Initial;
+		std::uint32_t customColor = 0;
+
+		std::int32_t line = 0;
+		for (const LayoutItem& item : layout.Items) {
+			if (item.IsNewLine) {
+				// New line
+				line++;
+				originPos.X = lineStart;
+				switch (align & Alignment::HorizontalMask) {
+					case Alignment::Center: originPos.X += (totalWidth - lineWidths[line & (MaxLines - 1)]) * 0.5f; break;
+					case Alignment::Right: originPos.X += (totalWidth - lineWidths[line & (MaxLines - 1)]); break;
+				}
+				originPos.Y += (_lineHeight * scale * lineSpacing);
+				continue;
+			}
+
+			if (applyColorTags && (item.ColorState != colorState || item.CustomColor != customColor)) {
+				colorState = item.ColorState;
+				customColor = item.CustomColor;
+				if (colorState == LayoutColor::Custom) {
+					// Set custom color
+					color = Color(customColor);
+					color.SetAlpha(0.5f * alpha);
+					if (colorizeShader == nullptr) {
+						colorizeShader = ContentResolver::Get().GetShader(PrecompiledShader::Colorized);
+					}
+				} else if (colorState == LayoutColor::Reset) {
+					// Reset color
+					color = Colorf(1.0f, 1.0f, 1.0f, alpha);
+					colorizeShader = nullptr;
+				}
+			}
+
+			const FontFormat::Glyph& glyph = item.Glyph;
+
+			// A glyph is stored trimmed to the pixels it inks, so it draws at its bearing from the pen
+			// rather than at the pen itself. One with no pixels at all - a space - only moves the pen.
+			if (glyph.Width > 0 && glyph.Height > 0) {
+				if (useRandomColor) {
+					const Colorf& newColor = RandomColors[charOffset % std::int32_t(arraySize(RandomColors))];
+					color = Colorf(newColor.R, newColor.G, newColor.B, color.A);
+				}
+
+				Vector2f pos = Vector2f(originPos.X + glyph.BearingX * scale, originPos.Y + glyph.BearingY * scale);
+
+				// A glyph outside the view is laid out but not drawn. Nothing above depends on this
+				// and nothing below it does either - the pen, the character counter and the wobble
+				// phase all advance regardless - so the text lays out identically either way, and a
+				// glyph that cannot be seen costs neither the two trigonometric calls of the wobble
+				// nor a render command, a material setup and a draw. That is the difference between
+				// the cost of a screen of text and the cost of all the text there is: the credits
+				// are one long block scrolled past a small window, and every line of it, on screen
+				// or not, used to be submitted every frame.
+				//
+				// Tested before the wobble rather than after, which is where the saving mostly is -
+				// a sine and a cosine per glyph is the dearest thing in this loop. That costs
+				// nothing in accuracy: the wobble is bounded by the variance, so a glyph further
+				// out than that cannot be brought back into view by it, and it is carried here as
+				// a margin. The transform is the glyph's TOP-LEFT corner, not its centre - the
+				// canvas_item vertex stage spans the quad from the model origin by spriteSize.
+				//
+				// Tested against the whole view rather than the caller's clip rectangle, which is
+				// the conservative choice: a section that clips more tightly still gets everything
+				// it asks for. A canvas that never set its view size fails open and draws
+				// everything, since culling against a zero view would silently swallow the text.
+				const float layerScale = canvas->LayerScale;
+				const Vector2f unwobbled = pos * layerScale + canvas->LayerOffset;
+				const float glyphW = glyph.Width * scale * layerScale;
+				const float glyphH = glyph.Height * scale * layerScale;
+				// One extra pixel covers the rounding to whole pixels below
+				const float marginX = (angleOffset > 0.0f ? std::abs(varianceX) * scale * layerScale : 0.0f) + 1.0f;
+				const float marginY = (angleOffset > 0.0f ? std::abs(varianceY) * scale * layerScale : 0.0f) + 1.0f;
+				const bool boundsKnown = (canvas->ViewSize.X > 0 && canvas->ViewSize.Y > 0);
+				const bool onScreen = (!boundsKnown ||
+					(unwobbled.X + glyphW + marginX >= 0.0f && unwobbled.Y + glyphH + marginY >= 0.0f &&
+					 unwobbled.X - marginX <= float(canvas->ViewSize.X) &&
+					 unwobbled.Y - marginY <= float(canvas->ViewSize.Y)));
+				if (onScreen) {
+					if (angleOffset > 0.0f) {
+						float currentPhase = (phase + charOffset) * angleOffset * fPi;
+						if (speed > 0.0f && (charOffset % 2) == 1) {
+							currentPhase = -currentPhase;
 						}
+
+						pos.X += cosf(currentPhase) * varianceX * scale;
+						pos.Y += sinf(currentPhase) * varianceY * scale;
 					}
 
-					originPos.X += ((glyph.Advance + _baseSpacing) * scale * charSpacing);
-					charOffset++;
+					// Apply the canvas-wide draw transform (menu section transitions; identity by default)
+					pos = pos * layerScale + canvas->LayerOffset;
+					float glyphScale = scale * layerScale;
+					Colorf glyphColor = color * canvas->LayerColor;
+
+					pos.X = std::round(pos.X);
+					pos.Y = std::round(pos.Y);
+
+					Vector4f texCoords = Vector4f(
+						glyph.Width / float(texSize.X),
+						glyph.X / float(texSize.X),
+						glyph.Height / float(texSize.Y),
+						glyph.Y / float(texSize.Y)
+					);
+
+					auto command = canvas->RentRenderCommand();
+					command->SetType(RenderCommand::Type::Text);
+					bool shaderChanged = (colorizeShader
+						? command->GetMaterial().SetShader(colorizeShader)
+						: command->GetMaterial().SetShaderProgramType(Material::ShaderProgramType::Sprite));
+					if (shaderChanged) {
+						command->GetMaterial().ReserveUniformsDataMemory();
+						command->GetGeometry().SetDrawParameters(PrimitiveType::TriangleStrip, 0, 4);
+						// Required to reset render command properly
+						//command->SetTransformation(command->transformation());
+
+						auto* textureUniform = command->GetMaterial().Uniform(Material::TextureUniformName);
+						if (textureUniform && textureUniform->GetIntValue(0) != 0) {
+							textureUniform->SetIntValue(0); // GL_TEXTURE0
+						}
+					}
+
+					// Separate alpha blend so text (e.g. semi-transparent shadows) accumulates correct alpha coverage
+					// when drawn into an RGBA render target, harmless for opaque/RGB targets
+					command->GetMaterial().SetBlendingFactors(BlendingFactor::SrcAlpha, BlendingFactor::OneMinusSrcAlpha, BlendingFactor::One, BlendingFactor::OneMinusSrcAlpha);
+
+					auto* instanceBlock = command->GetInstanceBlock();
+					instanceBlock->GetUniform(Material::TexRectUniformName)->SetFloatVector(texCoords.Data());
+					instanceBlock->GetUniform(Material::SpriteSizeUniformName)->SetFloatValue(glyph.Width * glyphScale, glyph.Height * glyphScale);
+					instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatVector(glyphColor.Data());
+
+					command->SetTransformation(Matrix2x3f::Translation(pos.X, pos.Y));
+					command->SetLayer(z - (charOffset & 1));
+					command->GetMaterial().SetTexture(*_texture.get());
+
+					canvas->_currentRenderQueue->AddCommand(command);
 				}
 			}
 
-			idx = std::int32_t(cursor.second());
-		} while (idx < textLength);
+			originPos.X += item.Advance;
+			charOffset++;
+		}
 		charOffset++;
 	}
 
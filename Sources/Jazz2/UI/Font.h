@@ -7,6 +7,7 @@
 #include "../../nCine/Base/HashMap.h"
 #include "../../nCine/Graphics/Texture.h"
 
+#include <Containers/SmallVector.h>
 #include <IO/Stream.h>
 
 using namespace nCine;
@@ -66,13 +67,31 @@ namespace Jazz2::UI
 		Vector2f MeasureString(StringView text, float scale = 1.0f, float charSpacing = 1.0f, float lineSpacing = 1.0f);
 		/** @brief Returns size of a string and its cumulative widths */
 		Vector2f MeasureStringEx(StringView text, float scale, float charSpacing, float maxWidth, std::int32_t* charFit, float* charFitWidths);
-		/** @brief Draws a string */
+		/**
+		 * @brief Draws a string
+		 *
+		 * The layout of the string (its glyphs, pen advances, formatting and line widths) is kept in a small
+		 * per-font cache keyed by the text, the scale and the spacing, so text that is drawn every frame is only
+		 * decoded and measured when it changes.
+		 */
 		void DrawString(Canvas* canvas, StringView text, std::int32_t& charOffset, float x, float y, std::uint16_t z, Alignment align, Colorf color, float scale = 1.0f, float angleOffset = 0.0f, float varianceX = 4.0f, float varianceY = 4.0f, float speed = 0.4f, float charSpacing = 1.0f, float lineSpacing = 1.0f);
 
 		/** @brief Strips formatting from the specified text */
 		static String StripFormatting(StringView text);
 
 	private:
+		/**
+		 * @brief Number of codepoints looked up directly in @ref _glyphs
+		 *
+		 * Covers ASCII, the Latin supplements and extensions, Greek and Cyrillic, which is every script the
+		 * bundled translations are written in. Anything above falls back to the hash map.
+		 */
+		static constexpr std::uint32_t FlatGlyphCount = 0x0530;
+		/** @brief Number of laid out strings kept by @ref DrawString(), must be a power of two */
+		static constexpr std::uint32_t LayoutCacheSize = 128;
+		/** @brief Maximum number of lines - center and right alignment starts to glitch if text has more lines, but it should be enough in most cases */
+		static constexpr std::int32_t MaxLines = 16;
+
 		static constexpr Colorf RandomColors[] = {
 			Colorf(0.4f, 0.55f, 0.85f, 0.5f),
 			Colorf(0.7f, 0.45f, 0.42f, 0.5f),
@@ -85,14 +104,52 @@ namespace Jazz2::UI
 			Colorf(0.56f, 0.50f, 0.42f, 0.5f),
 		};
 
-		FontFormat::Glyph _asciiChars[128];
+#ifndef DOXYGEN_GENERATING_OUTPUT
+		enum class LayoutColor : std::uint8_t
+		{
+			Initial,	// The color the string is drawn with
+			Custom,		// Set by "\f[c:#RRGGBB]"
+			Reset		// Reset by "\f[/c]"
+		};
+
+		// One advancing glyph or a line break of a laid out string
+		struct LayoutItem
+		{
+			FontFormat::Glyph Glyph;
+			bool IsNewLine;
+			LayoutColor ColorState;
+			float Advance;
+			std::uint32_t CustomColor;
+		};
+
+		// Laid out string, a slot of the layout cache
+		struct TextLayout
+		{
+			std::uint64_t Hash = 0;
+			float Scale = 0.0f;
+			float CharSpacing = 0.0f;
+			float LineSpacing = 0.0f;
+			float TotalWidth = 0.0f;
+			float TotalHeight = 0.0f;
+			float LineWidths[MaxLines] = {};
+			SmallVector<char, 0> Text;
+			SmallVector<LayoutItem, 0> Items;
+		};
+#endif
+
+		FontFormat::Glyph _glyphs[FlatGlyphCount];
 		HashMap<std::uint32_t, FontFormat::Glyph> _unicodeChars;
 		/** @brief How far one line of text sits below the previous one */
 		std::int32_t _lineHeight;
 		std::int32_t _baseSpacing;
 		std::unique_ptr<Texture> _texture;
+		TextLayout _layoutCache[LayoutCacheSize];
 
 		/** @brief Returns the glyph of the specified character, or the placeholder if the font doesn't have it */
 		const FontFormat::Glyph& GetGlyph(char32_t c) const;
+		/** @brief Returns the cached layout of a string, laying it out first if it's not cached */
+		const TextLayout& GetLayout(StringView text, float scale, float charSpacing, float lineSpacing);
+		/** @brief Decodes and measures a string into the specified layout */
+		void LayOutString(StringView text, float scale, float charSpacing, float lineSpacing, TextLayout& layout);
 	};
 }
\ No newline at end of file
@@ -5,8 +5,8 @@ using namespace Death::Containers::Literals;
 
 namespace Jazz2::UI
 {
-	FormattedTextBlock::Part::Part(std::uint32_t begin, std::uint32_t length, Vector2f location, float height, Colorf color, float scale, float charSpacing, bool allowVariance) noexcept
-		: Begin(begin), Length(length), Location(location), Height(height), CurrentColor(color), Scale(scale), CharSpacing(charSpacing), AllowVariance(allowVariance)
+	FormattedTextBlock::Part::Part(std::uint32_t begin, std::uint32_t length, Vector2f location, float height, Colorf color, bool isDefaultColor, float scale, float charSpacing, bool allowVariance) noexcept
+		: Begin(begin), Length(length), Location(location), Height(height), CurrentColor(color), IsDefaultColor(isDefaultColor), Scale(scale), CharSpacing(charSpacing), AllowVariance(allowVariance)
 	{
 	}
 
@@ -17,6 +17,7 @@ namespace Jazz2::UI
 		Location = other.Location;
 		Height = other.Height;
 		CurrentColor = other.CurrentColor;
+		IsDefaultColor = other.IsDefaultColor;
 		Scale = other.Scale;
 		CharSpacing = other.CharSpacing;
 		AllowVariance = other.AllowVariance;
@@ -29,6 +30,7 @@ namespace Jazz2::UI
 		Location = other.Location;
 		Height = other.Height;
 		CurrentColor = std::move(other.CurrentColor);
+		IsDefaultColor = other.IsDefaultColor;
 		Scale = other.Scale;
 		CharSpacing = other.CharSpacing;
 		AllowVariance = other.AllowVariance;
@@ -41,6 +43,7 @@ namespace Jazz2::UI
 		Location = other.Location;
 		Height = other.Height;
 		CurrentColor = other.CurrentColor;
+		IsDefaultColor = other.IsDefaultColor;
 		Scale = other.Scale;
 		CharSpacing = other.CharSpacing;
 		AllowVariance = other.AllowVariance;
@@ -54,6 +57,7 @@ namespace Jazz2::UI
 		Location = other.Location;
 		Height = other.Height;
 		CurrentColor = std::move(other.CurrentColor);
+		IsDefaultColor = other.IsDefaultColor;
 		Scale = other.Scale;
 		CharSpacing = other.CharSpacing;
 		AllowVariance = other.AllowVariance;
@@ -241,6 +245,7 @@ namespace Jazz2::UI
 		SmallVector<float, 1000> charFitWidths(DefaultInit, unprocessedLength + 1);
 
 		Colorf currentColor = _defaultColor;
+		bool isDefaultColor = true;
 		float scale = _defaultScale;
 		float charSpacing = _defaultCharSpacing;
 		float lineSpacing = _defaultLineSpacing;
@@ -308,6 +313,7 @@ namespace Jazz2::UI
 
 									// Swap red and blue channel, because Color stores it in 0xAABBGGRR format internally
 									currentColor = Uint32ToColorf(color);
+									isDefaultColor = false;
 								}
 								break;
 							case 'u': // Underline
@@ -412,6 +418,7 @@ namespace Jazz2::UI
 										}
 										case 'c': {
 											currentColor = _defaultColor;
+											isDefaultColor = true;
 											break;
 										}
 										case 'r': {
@@ -546,7 +553,7 @@ namespace Jazz2::UI
 				char* toPtr = (nextPtr[0] == L'\n' && nextPtr[-1] == L'\r' ? nextPtr - 1 : nextPtr);
 				std::int32_t partLength = (std::int32_t)(toPtr - unprocessedText);
 				Part& part = _parts.emplace_back((std::uint32_t)(unprocessedText - _text.data()), partLength, currentLocation,
-					size.Y * lineSpacing, currentColor, scale, charSpacing,
+					size.Y * lineSpacing, currentColor, isDefaultColor, scale, charSpacing,
 					styleCount[(std::int32_t)StyleIndex::AllowVariance] > 0);
 
 				if (nextPtr[0] == L'\n') {
@@ -603,7 +610,7 @@ namespace Jazz2::UI
 						if (charFit > 2) {
 							charFit -= 2;
 							Part& part = _parts.emplace_back((std::uint32_t)(unprocessedText - _text.data()), charFit, currentLocation,
-								size.Y * lineSpacing, currentColor, scale, charSpacing,
+								size.Y * lineSpacing, currentColor, isDefaultColor, scale, charSpacing,
 								styleCount[(std::int32_t)StyleIndex::AllowVariance] > 0);
 
 							if (styleCount[(std::int32_t)StyleIndex::DottedUnderline] > 0) {
@@ -614,7 +621,7 @@ namespace Jazz2::UI
 							maxWidth -= charFitWidths[charFit - 1];
 						}
 
-						InsertEllipsis(currentLocation, currentColor, scale, charSpacing, lineSpacing,
+						InsertEllipsis(currentLocation, currentColor, isDefaultColor, scale, charSpacing, lineSpacing,
 							styleCount[(std::int32_t)StyleIndex::AllowVariance] > 0, maxWidth, charFitWidths.data());
 						skipTill = SkipTill::EndOfHighlight;
 						continue;
@@ -672,7 +679,7 @@ namespace Jazz2::UI
 						if (lastWhitespacePtr != nullptr) {
 							std::int32_t partLength = (std::int32_t)(lastWhitespacePtr - unprocessedText);
 							Part& part = _parts.emplace_back((std::uint32_t)(unprocessedText - _text.data()), partLength, currentLocation,
-								size.Y * lineSpacing, currentColor, scale, charSpacing,
+								size.Y * lineSpacing, currentColor, isDefaultColor, scale, charSpacing,
 								styleCount[(std::int32_t)StyleIndex::AllowVariance] > 0);
 
 							if (styleCount[(std::int32_t)StyleIndex::DottedUnderline] > 0) {
@@ -713,7 +720,7 @@ namespace Jazz2::UI
 					if (charFit > 2) {
 						charFit -= 2;
 						Part& part = _parts.emplace_back((std::uint32_t)(unprocessedText - _text.data()), charFit, currentLocation,
-							size.Y * lineSpacing, currentColor, scale, charSpacing,
+							size.Y * lineSpacing, currentColor, isDefaultColor, scale, charSpacing,
 							styleCount[(std::int32_t)StyleIndex::AllowVariance] > 0);
 
 						if (styleCount[(std::int32_t)StyleIndex::DottedUnderline] > 0) {
@@ -724,7 +731,7 @@ namespace Jazz2::UI
 						maxWidth -= charFitWidths[charFit - 1];
 					}
 
-					InsertEllipsis(currentLocation, currentColor, scale, charSpacing, lineSpacing,
+					InsertEllipsis(currentLocation, currentColor, isDefaultColor, scale, charSpacing, lineSpacing,
 						styleCount[(std::int32_t)StyleIndex::AllowVariance] > 0, maxWidth, charFitWidths.data());
 					_flags |= FormattedTextBlockFlags::Ellipsized;
 
@@ -812,13 +819,13 @@ namespace Jazz2::UI
 		lineBeginIndex = (std::int32_t)_parts.size();
 	}
 
-	void FormattedTextBlock::InsertEllipsis(Vector2f& currentLocation, Colorf currentColor, float scale, float charSpacing, float lineSpacing, bool allowVariance, float maxWidth, float* charFitWidths)
+	void FormattedTextBlock::InsertEllipsis(Vector2f& currentLocation, Colorf currentColor, bool isDefaultColor, float scale, float charSpacing, float lineSpacing, bool allowVariance, float maxWidth, float* charFitWidths)
 	{
 		std::int32_t charFit;
 		Vector2f size = _font->MeasureStringEx("..."_s, scale, charSpacing, maxWidth, &charFit, charFitWidths);
 		if (charFit > 0) {
 			_parts.emplace_back(Ellipsis, charFit, currentLocation,
-				size.Y * lineSpacing, currentColor, scale, charSpacing, allowVariance);
+				size.Y * lineSpacing, currentColor, isDefaultColor, scale, charSpacing, allowVariance);
 			currentLocation.X += charFitWidths[charFit - 1];
 		}
 	}
@@ -899,8 +906,20 @@ namespace Jazz2::UI
 		}
 
 		_defaultColor = color;
-		_parts.clear();
-		_background.clear();
+
+		// A fading or blinking line only changes the color of its parts, not where they are, so the parts
+		// that don't set their own color are recolored in place instead of laying out the whole block again.
+		// Background parts copy the color of the text they underline, so they still need the full rebuild.
+		if (!_background.empty()) {
+			_parts.clear();
+			_background.clear();
+			return;
+		}
+		for (auto& part : _parts) {
+			if (part.IsDefaultColor) {
+				part.CurrentColor = color;
+			}
+		}
 	}
 
 	void FormattedTextBlock::SetFont(Font* value)
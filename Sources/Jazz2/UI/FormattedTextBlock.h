@@ -169,11 +169,13 @@ namespace Jazz2::UI
 			Vector2f Location;
 			float Height;
 			Colorf CurrentColor;
+			// Whether the part is drawn with the default color of the block, not with a color of its own
+			bool IsDefaultColor;
 			float Scale;
 			float CharSpacing;
 			bool AllowVariance;
 
-			Part(std::uint32_t begin, std::uint32_t length, Vector2f location, float height, Colorf color, float scale, float charSpacing, bool allowVariance) noexcept;
+			Part(std::uint32_t begin, std::uint32_t length, Vector2f location, float height, Colorf color, bool isDefaultColor, float scale, float charSpacing, bool allowVariance) noexcept;
 			
 			Part(const Part& other) noexcept;
 			Part(Part&& other) noexcept;
@@ -215,7 +217,7 @@ namespace Jazz2::UI
 
 		void RecreateCache();
 		void HandleEndOfLine(Vector2f currentLocation, std::int32_t& lineBeginIndex, std::int32_t& lineAlignIndex, std::int32_t& backgroundIndex);
-		void InsertEllipsis(Vector2f& currentLocation, Colorf currentColor, float scale, float charSpacing, float lineSpacing, bool allowVariance, float maxWidth, float* charFitWidths);
+		void InsertEllipsis(Vector2f& currentLocation, Colorf currentColor, bool isDefaultColor, float scale, float charSpacing, float lineSpacing, bool allowVariance, float maxWidth, float* charFitWidths);
 		void InsertDottedUnderline(Part& part, float width);
 
 		static float PerformVerticalAlignment(SmallVectorImpl<Part>& processedParts, std::int32_t firstPartOfLine);
@@ -285,7 +285,7 @@ namespace Jazz2::UI
 			instanceBlock->GetUniform(Material::SpriteSizeUniformName)->SetFloatVector(Vector2f(static_cast<float>(ViewSize.X), static_cast<float>(ViewSize.Y)).Data());
 			instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatVector(Colorf(0.0f, 0.0f, 0.0f, _transitionTime).Data());
 
-			command->SetTransformation(Matrix4x4f::Identity);
+			command->SetTransformation(Matrix2x3f::Identity);
 			command->SetLayer(600);
 
 			renderQueue.AddCommand(command);
@@ -1275,7 +1275,7 @@ namespace Jazz2::UI
 			palOffsetUniform->SetFloatValue(paletteOffset);
 		}
 
-		command->SetTransformation(Matrix4x4f::Translation(adjustedPos.X, adjustedPos.Y, 0.0f));
+		command->SetTransformation(Matrix2x3f::Translation(adjustedPos.X, adjustedPos.Y));
 		command->SetLayer(z);
 		command->GetMaterial().SetTexture(0, *base->TextureDiffuse.get());
 		command->GetMaterial().SetTexture(1, *palette);
@@ -1700,7 +1700,7 @@ namespace Jazz2::UI
 		instanceBlock->GetUniform(Material::SpriteSizeUniformName)->SetFloatValue(1.0f, 1.0f);
 		instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatVector(color.Data());
 
-		command->SetTransformation(Matrix4x4f::Identity);
+		command->SetTransformation(Matrix2x3f::Identity);
 		command->SetLayer(z);
 		command->GetMaterial().SetTexture(texture);
 
@@ -1850,7 +1850,7 @@ namespace Jazz2::UI
 			instanceBlock->GetUniform(Material::SpriteSizeUniformName)->SetFloatVector(Vector2f(radius * 2.0f, radius * 2.0f).Data());
 			instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatVector(color.Data());
 
-			command->SetTransformation(Matrix4x4f::Translation(std::round(cx - radius), std::round(cy - radius), 0.0f));
+			command->SetTransformation(Matrix2x3f::Translation(std::round(cx - radius), std::round(cy - radius)));
 			command->SetLayer(TouchButtonsLayer + 1);
 
 			DrawRenderCommand(command);
@@ -252,7 +252,7 @@ namespace Jazz2::UI::Menu
 			instanceBlock->GetUniform(Material::SpriteSizeUniformName)->SetFloatVector(Vector2f(static_cast<float>(canvas->ViewSize.X), static_cast<float>(canvas->ViewSize.Y)).Data());
 			instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatVector(Colorf(0.0f, 0.0f, 0.0f, _transitionTime).Data());
 
-			command->SetTransformation(Matrix4x4f::Identity);
+			command->SetTransformation(Matrix2x3f::Identity);
 			command->SetLayer(999);
 
 			canvas->DrawRenderCommand(command);
@@ -9,7 +9,9 @@
 #include "../../PreferencesCache.h"
 #include "../../ContentResolver.h"
 
+#include "../../../nCine/Application.h"
 #include "../../../nCine/I18n.h"
+#include "../../../nCine/Base/FrameTimer.h"
 
 #include <cmath>
 
@@ -66,6 +68,15 @@ namespace Jazz2::UI::Menu
 		list->Add<ChoiceItem>(_("Continuous Jump"),
 			[]() -> StringView { return (PreferencesCache::EnableContinuousJump ? _("Enabled") : _("Disabled")); },
 			[this](std::int32_t) { PreferencesCache::EnableContinuousJump = !PreferencesCache::EnableContinuousJump; _isDirty = true; });
+		// Gameplay then advances in ticks of the original frame rate and rendering interpolates between them
+		// TRANSLATORS: Menu item in Options > Gameplay section
+		list->Add<ChoiceItem>(_("Fixed Timestep"),
+			[]() -> StringView { return (PreferencesCache::FixedTimestep ? _("Enabled") : _("Disabled")); },
+			[this](std::int32_t) {
+				PreferencesCache::FixedTimestep = !PreferencesCache::FixedTimestep;
+				theApplication().SetFixedTickRate(PreferencesCache::FixedTimestep ? (std::uint32_t)FrameTimer::FramesPerSecond : 0);
+				_isDirty = true;
+			});
 		// TRANSLATORS: Menu item in Options > Gameplay section
 		list->Add<ChoiceItem>(_("Switch To New Weapon"),
 			[]() -> StringView { return (PreferencesCache::SwitchToNewWeapon ? _("Enabled") : _("Disabled")); },
@@ -7,7 +7,7 @@
 #include "../../../nCine/Application.h"
 #include "../../../nCine/Base/FrameTimer.h"
 #include "../../../nCine/I18n.h"
-#include "../../../nCine/Graphics/RHI/RhiFwd.h"	// RHI_CAP_POSTPROCESSING (a header macro, not a build define)
+#include "../../../nCine/Graphics/RHI/RhiFwd.h"	// RHI_CAP_POSTPROCESSING/RHI_CAP_CPU_RESCALE (header macros, not build defines)
 
 #include <Environment.h>
 #include <Utf8.h>
@@ -38,10 +38,10 @@ namespace Jazz2::UI::Menu
 
 		auto list = std::make_unique<ScrollView>();
 
-#if defined(RHI_CAP_POSTPROCESSING)
+#if defined(RHI_CAP_POSTPROCESSING) || defined(RHI_CAP_CPU_RESCALE)
 		// The direct rendering tier has no rescale/antialiasing shader passes (the scene is rendered at the
 		// logical resolution directly into the screen framebuffer, see UpscaleRenderPass), so the option is
-		// hidden there
+		// hidden there, unless the backend can apply the rescale filters to the screen framebuffer itself
 		// TRANSLATORS: Menu item in Options > Graphics section
 		list->Add<ListItem>(_("Rescale Mode"), [root]() { root->SwitchToSection<RescaleModeSection>(); });
 #endif
@@ -581,10 +581,10 @@ namespace Jazz2::UI::Menu
 			instanceBlock->GetUniform(Material::SpriteSizeUniformName)->SetFloatValue(debris.Size.X, debris.Size.Y);
 			instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatVector(Colorf(1.0f, 1.0f, 1.0f, debris.Alpha).Data());
 
-			Matrix4x4f worldMatrix = Matrix4x4f::Translation(debris.Pos.X, debris.Pos.Y, 0.0f);
+			Matrix2x3f worldMatrix = Matrix2x3f::Translation(debris.Pos.X, debris.Pos.Y);
 			worldMatrix.RotateZ(debris.Angle);
-			worldMatrix.Scale(debris.Scale, debris.Scale, 1.0f);
-			worldMatrix.Translate(debris.Size.X * -0.5f, debris.Size.Y * -0.5f, 0.0f);
+			worldMatrix.Scale(debris.Scale, debris.Scale);
+			worldMatrix.Translate(debris.Size.X * -0.5f, debris.Size.Y * -0.5f);
 			command->SetTransformation(worldMatrix);
 			command->SetLayer(debris.Depth);
 			ContentResolver::Get().BindSpritePalette(*command, *debris.DiffuseTexture, debris.PaletteOffset >= 0, (std::uint16_t)(debris.PaletteOffset >= 0 ? debris.PaletteOffset : 0));
@@ -741,7 +741,7 @@ namespace Jazz2::UI::Menu
 						instanceBlock->GetUniform(Material::SpriteSizeUniformName)->SetFloatValue(TileSize, TileSize);
 						instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatVector(Colorf::White.Data());
 
-						command->SetTransformation(Matrix4x4f::Translation(posX, posY, 0.0f));
+						command->SetTransformation(Matrix2x3f::Translation(posX, posY));
 						command->SetLayer(0);
 						ContentResolver::Get().BindSpritePalette(*command, *tileTexture, _tileSet->IsIndexed, 0);
 
@@ -777,7 +777,7 @@ namespace Jazz2::UI::Menu
 		command->GetMaterial().Uniform("uShift")->SetFloatVector(_texturedBackgroundPos.Data());
 		command->GetMaterial().Uniform("uHorizonColor")->SetFloatVector(horizonColor.Data());
 
-		command->SetTransformation(Matrix4x4f::Translation(0.0f, 0.0f, 0.0f));
+		command->SetTransformation(Matrix2x3f::Translation(0.0f, 0.0f));
 		command->GetMaterial().SetTexture(*target);
 
 		renderQueue.AddCommand(command);
@@ -818,9 +818,9 @@ namespace Jazz2::UI::Menu
 			instanceBlock->GetUniform(Material::SpriteSizeUniformName)->SetFloatVector(size.Data());
 			instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatVector(Colorf::White.Data());
 
-			Matrix4x4f worldMatrix = Matrix4x4f::Translation(center.X, center.Y, 0.0f);
+			Matrix2x3f worldMatrix = Matrix2x3f::Translation(center.X, center.Y);
 			worldMatrix.RotateZ(animTime * -0.2f);
-			worldMatrix.Translate(size.X * -0.5f, size.Y * -0.5f, 0.0f);
+			worldMatrix.Translate(size.X * -0.5f, size.Y * -0.5f);
 			command->SetTransformation(worldMatrix);
 			command->SetLayer(100);
 			ContentResolver::Get().BindSpritePalette(*command, *base->TextureDiffuse.get(), indexed, 0);
@@ -855,9 +855,9 @@ namespace Jazz2::UI::Menu
 			instanceBlock->GetUniform(Material::SpriteSizeUniformName)->SetFloatVector(size.Data());
 			instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatVector(Colorf::White.Data());
 
-			Matrix4x4f worldMatrix = Matrix4x4f::Translation(centerBg.X, centerBg.Y, 0.0f);
+			Matrix2x3f worldMatrix = Matrix2x3f::Translation(centerBg.X, centerBg.Y);
 			worldMatrix.RotateZ(animTime * 0.4f);
-			worldMatrix.Translate(size.X * -0.5f, size.Y * -0.5f, 0.0f);
+			worldMatrix.Translate(size.X * -0.5f, size.Y * -0.5f);
 			command->SetTransformation(worldMatrix);
 			command->SetLayer(110);
 			ContentResolver::Get().BindSpritePalette(*command, *base->TextureDiffuse.get(), indexed, 0);
@@ -892,9 +892,9 @@ namespace Jazz2::UI::Menu
 			instanceBlock->GetUniform(Material::SpriteSizeUniformName)->SetFloatVector(size.Data());
 			instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatVector(Colorf::White.Data());
 
-			Matrix4x4f worldMatrix = Matrix4x4f::Translation(centerBg.X, centerBg.Y, 0.0f);
+			Matrix2x3f worldMatrix = Matrix2x3f::Translation(centerBg.X, centerBg.Y);
 			worldMatrix.RotateZ(animTime * 0.3f);
-			worldMatrix.Translate(size.X * -0.5f, size.Y * -0.5f, 0.0f);
+			worldMatrix.Translate(size.X * -0.5f, size.Y * -0.5f);
 			command->SetTransformation(worldMatrix);
 			command->SetLayer(120);
 			ContentResolver::Get().BindSpritePalette(*command, *base->TextureDiffuse.get(), indexed, 0);
@@ -994,7 +994,7 @@ namespace Jazz2::UI::Menu
 				instanceBlock->GetUniform(Material::SpriteSizeUniformName)->SetFloatValue(TileSet::DefaultTileSize, TileSet::DefaultTileSize);
 				instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatVector(Colorf::White.Data());
 
-				command->SetTransformation(Matrix4x4f::Translation(x * TileSet::DefaultTileSize, y * TileSet::DefaultTileSize, 0.0f));
+				command->SetTransformation(Matrix2x3f::Translation(x * TileSet::DefaultTileSize, y * TileSet::DefaultTileSize));
 				ContentResolver::Get().BindSpritePalette(*command, *tileTexture, _owner->_tileSet->IsIndexed, 0);
 
 				renderQueue.AddCommand(command);
@@ -301,10 +301,9 @@ namespace Jazz2::UI::Menu
 	void MenuContainerBase::PlaySfx(StringView identifier, float gain)
 	{
 #if defined(WITH_AUDIO)
-		auto it = _metadata->Sounds.find(String::nullTerminatedView(identifier));
-		if (it != _metadata->Sounds.end()) {
-			std::int32_t idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (std::int32_t)it->second.Buffers.size()) : 0);
-			auto& player = _playingSounds.emplace_back(std::make_shared<AudioBufferPlayer>(&it->second.Buffers[idx]->Buffer));
+		auto* resource = _metadata->GetSound(identifier);
+		if (resource != nullptr) {
+			auto& player = _playingSounds.emplace_back(std::make_shared<AudioBufferPlayer>(resource->PickBuffer()));
 			player->setPosition(Vector3f(0.0f, 0.0f, 100.0f));
 			player->setGain(gain * PreferencesCache::MasterVolume * PreferencesCache::SfxVolume);
 			player->setSourceRelative(true);
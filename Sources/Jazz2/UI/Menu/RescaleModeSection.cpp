@@ -2,7 +2,7 @@
 #include "../../PreferencesCache.h"
 
 #include "../../../nCine/I18n.h"
-#include "../../../nCine/Graphics/RHI/RhiFwd.h"	// RHI_CAP_POSTPROCESSING (a header macro, not a build define)
+#include "../../../nCine/Graphics/RHI/RhiFwd.h"	// RHI_CAP_POSTPROCESSING/RHI_CAP_CPU_RESCALE (header macros, not build defines)
 
 namespace Jazz2::UI::Menu
 {
@@ -46,20 +46,20 @@ namespace Jazz2::UI::Menu
 
 		// TRANSLATORS: Menu item in Options > Graphics > Rescale Mode section
 		add(RescaleMode::None, _("None / Pixel-perfect"));
-#if defined(RHI_CAP_POSTPROCESSING)
+#if defined(RHI_CAP_POSTPROCESSING) || defined(RHI_CAP_CPU_RESCALE)
 		// The direct rendering tier has no rescale shader passes (see UpscaleRenderPass), only the default
-		// pixel-perfect mode works there - the section itself is already hidden in GraphicsOptionsSection,
-		// this is just defense in depth
+		// pixel-perfect mode works there, unless the backend applies the filters on the CPU while presenting -
+		// the section itself is already hidden in GraphicsOptionsSection, this is just defense in depth
 		// CleanEdge, SABR and Monochrome are left out on a backend whose offline shader profile rejected them
-		// (see RHI_CAP_HEAVY_RESCALE_SHADERS). Omitting them here is all that is needed: a value stored by
+		// (see RHI_CAP_HEAVY_RESCALE_SHADERS), the CPU filters have no such limitation. Omitting them here is all that is needed: a value stored by
 		// another backend needs no fallback, because UpscaleRenderPass already falls back to the plain sprite
 		// shader whenever the mode resolves to no program, which is exactly the pixel-perfect mode.
-#if defined(RHI_CAP_HEAVY_RESCALE_SHADERS)
+#if defined(RHI_CAP_HEAVY_RESCALE_SHADERS) || defined(RHI_CAP_CPU_RESCALE)
 		add(RescaleMode::CleanEdge, "CleanEdge"_s);
 #endif
 		add(RescaleMode::HQ2x, "HQ2×"_s);
 		add(RescaleMode::_3xBrz, "3×BRZ"_s);
-#if defined(RHI_CAP_HEAVY_RESCALE_SHADERS)
+#if defined(RHI_CAP_HEAVY_RESCALE_SHADERS) || defined(RHI_CAP_CPU_RESCALE)
 		add(RescaleMode::Sabr, "SABR"_s);
 #endif
 		// TRANSLATORS: Menu item in Options > Graphics > Rescale Mode section
@@ -68,7 +68,7 @@ namespace Jazz2::UI::Menu
 		add(RescaleMode::CrtShadowMask, _("CRT Shadow Mask"));
 		// TRANSLATORS: Menu item in Options > Graphics > Rescale Mode section
 		add(RescaleMode::CrtApertureGrille, _("CRT Aperture Grille"));
-#	if defined(RHI_CAP_HEAVY_RESCALE_SHADERS)
+#	if defined(RHI_CAP_HEAVY_RESCALE_SHADERS) || defined(RHI_CAP_CPU_RESCALE)
 		// TRANSLATORS: Menu item in Options > Graphics > Rescale Mode section
 		add(RescaleMode::Monochrome, _("Monochrome"));
 #	endif
@@ -156,9 +156,9 @@ namespace Jazz2::UI::Multiplayer
 		_countdownTimeLeft = FrameTimer::FramesPerSecond;
 
 #if defined(WITH_AUDIO)
-		auto it = _metadata->Sounds.find(String::nullTerminatedView(sfxName));
-		if (it != _metadata->Sounds.end() && !it->second.Buffers.empty()) {
-			_levelHandler->PlaySfx(nullptr, sfxName, &it->second.Buffers[0]->Buffer, Vector3f::Zero, true, 1.0f, 1.0f);
+		auto* resource = _metadata->GetSound(sfxName);
+		if (resource != nullptr && !resource->Buffers.empty()) {
+			_levelHandler->PlaySfx(nullptr, sfxName, &resource->Buffers[0]->Buffer, Vector3f::Zero, true, 1.0f, 1.0f, resource->Priority);
 		}
 #endif
 	}
@@ -834,7 +834,7 @@ namespace Jazz2::UI::Multiplayer
 		instanceBlock->GetUniform(Material::SpriteSizeUniformName)->SetFloatValue(1.0f, 1.0f);
 		instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatVector(color.Data());
 
-		command->SetTransformation(Matrix4x4f::Identity);
+		command->SetTransformation(Matrix2x3f::Identity);
 		command->SetLayer(z);
 		command->GetMaterial().SetTexture(0, *_minimapLineTexture);
 
@@ -0,0 +1,170 @@
+// Equivalence tests of the collision broad-phases (Jazz2/Collisions/BroadPhase.h).
+//
+// SpatialHashBroadPhase must report the same pairs from UpdatePairs() and the same proxies from Query() as
+// DynamicTreeBroadPhase for the same proxies. The tree enlarges its fat AABBs in the direction of movement
+// and keeps them while they still contain the proxy, which the spatial hash doesn't, so the proxies here are
+// moved with zero displacement and far enough that the tree re-inserts them with exactly the same fat AABB.
+//
+// Built and registered with CTest by the CMakeLists.txt next to this file (NCINE_BUILD_GAME_TESTS).
+
+#include "GameTestCommon.h"
+#include "Jazz2/Collisions/DynamicTreeBroadPhase.h"
+#include "Jazz2/Collisions/SpatialHashBroadPhase.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+using namespace Jazz2::Collisions;
+using namespace nCine;
+
+namespace
+{
+	using PairSet = std::vector<std::pair<std::intptr_t, std::intptr_t>>;
+
+	struct PairCollector
+	{
+		PairSet Pairs;
+
+		void OnPairAdded(void* userDataA, void* userDataB)
+		{
+			std::intptr_t a = (std::intptr_t)userDataA, b = (std::intptr_t)userDataB;
+			Pairs.emplace_back(std::min(a, b), std::max(a, b));
+		}
+	};
+
+	template<typename TBroadPhase>
+	struct QueryCollector
+	{
+		const TBroadPhase* BroadPhase;
+		std::vector<std::intptr_t> Proxies;
+
+		bool OnCollisionQuery(std::int32_t proxyId)
+		{
+			Proxies.push_back((std::intptr_t)BroadPhase->GetUserData(proxyId));
+			return true;
+		}
+	};
+
+	// Deterministic generator, so a failure can be reproduced
+	struct TestRandom
+	{
+		std::uint32_t State = 0x2545F491u;
+
+		float Next(float min, float max)
+		{
+			State = State * 1664525u + 1013904223u;
+			return min + (float)(State >> 8) * (1.0f / 16777216.0f) * (max - min);
+		}
+	};
+
+	AABBf RandomBox(TestRandom& random, float levelSize)
+	{
+		// Mostly actor-sized boxes, some of them spanning many cells to hit the oversized list
+		float size = (random.Next(0.0f, 1.0f) < 0.05f ? random.Next(200.0f, 600.0f) : random.Next(8.0f, 48.0f));
+		float x = random.Next(-64.0f, levelSize);
+		float y = random.Next(-64.0f, levelSize);
+		return AABBf(x, y, x + size, y + random.Next(8.0f, 48.0f));
+	}
+
+	template<typename TBroadPhase>
+	PairSet CollectPairs(TBroadPhase& broadPhase)
+	{
+		PairCollector collector;
+		broadPhase.UpdatePairs(&collector);
+		std::sort(collector.Pairs.begin(), collector.Pairs.end());
+		return collector.Pairs;
+	}
+
+	template<typename TBroadPhase>
+	std::vector<std::intptr_t> CollectQuery(const TBroadPhase& broadPhase, const AABBf& aabb)
+	{
+		QueryCollector<TBroadPhase> collector{&broadPhase};
+		broadPhase.Query(&collector, aabb);
+		std::sort(collector.Proxies.begin(), collector.Proxies.end());
+		return collector.Proxies;
+	}
+
+	void TestPopulation(std::int32_t proxyCount, float levelSize)
+	{
+		std::printf("%d proxies in %.0f px\n", proxyCount, levelSize);
+
+		TestRandom random;
+		DynamicTreeBroadPhase tree;
+		SpatialHashBroadPhase hash;
+		std::vector<std::int32_t> treeIds(proxyCount), hashIds(proxyCount);
+		std::vector<bool> alive(proxyCount, true);
+
+		for (std::int32_t i = 0; i < proxyCount; i++) {
+			AABBf aabb = RandomBox(random, levelSize);
+			// User data are 1-based indices, so they are never null
+			treeIds[i] = tree.CreateProxy(aabb, (void*)(std::intptr_t)(i + 1));
+			hashIds[i] = hash.CreateProxy(aabb, (void*)(std::intptr_t)(i + 1));
+		}
+
+		PairSet treePairs = CollectPairs(tree);
+		PairSet hashPairs = CollectPairs(hash);
+		std::printf("  %zu pairs of created proxies\n", treePairs.size());
+		Check(treePairs == hashPairs, "pairs of created proxies");
+
+		bool noPairs = CollectPairs(tree).empty() && CollectPairs(hash).empty();
+		Check(noPairs, "no pairs without movement");
+
+		for (std::int32_t step = 0; step < 8; step++) {
+			// Move a quarter of proxies, destroy and touch a few of them
+			for (std::int32_t i = 0; i < proxyCount; i++) {
+				if (!alive[i]) {
+					continue;
+				}
+				float action = random.Next(0.0f, 1.0f);
+				if (action < 0.25f) {
+					AABBf aabb = RandomBox(random, levelSize);
+					// The new box must not be contained in the old fat AABB, otherwise the tree keeps the old one
+					const AABBf& fatAABB = tree.GetFatAABB(treeIds[i]);
+					if (fatAABB.Contains(aabb)) {
+						float shift = fatAABB.R - aabb.L + 1.0f;
+						aabb = AABBf(aabb.L + shift, aabb.T, aabb.R + shift, aabb.B);
+					}
+					tree.MoveProxy(treeIds[i], aabb, Vector2f::Zero);
+					hash.MoveProxy(hashIds[i], aabb, Vector2f::Zero);
+				} else if (action < 0.27f) {
+					tree.DestroyProxy(treeIds[i]);
+					hash.DestroyProxy(hashIds[i]);
+					alive[i] = false;
+				} else if (action < 0.30f) {
+					tree.TouchProxy(treeIds[i]);
+					hash.TouchProxy(hashIds[i]);
+				}
+			}
+
+			// Queries see the moved proxies even before the pairs are updated
+			bool queriesMatched = true;
+			for (std::int32_t i = 0; i < 32; i++) {
+				AABBf queryBox = RandomBox(random, levelSize);
+				queriesMatched &= (CollectQuery(tree, queryBox) == CollectQuery(hash, queryBox));
+			}
+			Check(queriesMatched, "queries after movement");
+
+			treePairs = CollectPairs(tree);
+			hashPairs = CollectPairs(hash);
+			if (treePairs != hashPairs) {
+				std::printf("  step %d: %zu pairs in the tree, %zu in the spatial hash\n", step, treePairs.size(), hashPairs.size());
+			}
+			Check(treePairs == hashPairs, "pairs of moved proxies");
+		}
+
+		Check(tree.GetProxyCount() == hash.GetProxyCount(), "proxy count");
+	}
+}
+
+int main()
+{
+	// Sparse and dense populations, around SpatialHashMinEventCount and far above it
+	TestPopulation(50, 2048.0f);
+	TestPopulation(200, 2048.0f);
+	TestPopulation(2000, 4096.0f);
+	TestPopulation(2000, 512.0f);
+	return Finish("BroadPhaseTests");
+}
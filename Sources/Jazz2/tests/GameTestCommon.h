@@ -0,0 +1,29 @@
+// Helpers shared by the standalone game logic tests in this directory (SnapshotEncodingTests, BroadPhaseTests).
+//
+// Header-only on purpose: every test is a single translation unit linked straight against the sources it
+// tests, without the rest of the game, so there is no library to put these into.
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+
+inline int g_checks = 0;
+inline int g_failures = 0;
+
+/** @brief Records a single check, failed checks are printed with their label */
+inline void Check(bool condition, const char* label)
+{
+	g_checks++;
+	if (!condition) {
+		g_failures++;
+		std::printf("  FAIL %s\n", label);
+	}
+}
+
+/** @brief Prints the summary and returns the exit code of the test */
+inline int Finish(const char* name)
+{
+	std::printf("%s: %d checks, %d failures\n", name, g_checks, g_failures);
+	return (g_failures == 0 ? 0 : 1);
+}
@@ -0,0 +1,258 @@
+// Round-trip tests of the bit-packed actor updates (Jazz2/Multiplayer/SnapshotEncoding.h).
+//
+// Values written by BitWriter must be read back unchanged by BitReader for every bit width, including the
+// widths that straddle byte boundaries, and at the boundaries of each variable-length size class. Snapshots
+// must survive full and delta updates, and the quantized positions must stay within their precision.
+//
+// Built and registered with CTest by the CMakeLists.txt next to this file (NCINE_BUILD_GAME_TESTS).
+
+#include "GameTestCommon.h"
+#include "Jazz2/Multiplayer/SnapshotEncoding.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+using namespace Jazz2::Multiplayer;
+
+namespace
+{
+	void TestBitWidths()
+	{
+		std::printf("Bit widths\n");
+
+		// Every width from 1 to 32 bits, one after another, so each one starts at a different bit offset (528 bits)
+		std::uint8_t buffer[66] = {};
+		BitWriter writer(buffer, sizeof(buffer));
+		std::uint32_t seed = 0x9E3779B9u;
+		for (std::int32_t bits = 1; bits <= 32; bits++) {
+			seed = seed * 1664525u + 1013904223u;
+			writer.WriteBits(seed, bits);
+		}
+		std::size_t size = writer.Flush();
+		Check(size == sizeof(buffer), "written size of 1..32 bit widths");
+
+		BitReader reader(buffer, size);
+		seed = 0x9E3779B9u;
+		bool allMatched = true;
+		for (std::int32_t bits = 1; bits <= 32; bits++) {
+			seed = seed * 1664525u + 1013904223u;
+			std::uint32_t expected = (bits == 32 ? seed : (seed & ((1u << bits) - 1)));
+			if (reader.ReadBits(bits) != expected) {
+				std::printf("  width %d doesn't match\n", bits);
+				allMatched = false;
+			}
+		}
+		Check(allMatched, "values of 1..32 bit widths");
+		Check(reader.IsValid(), "reader valid after 1..32 bit widths");
+
+		// Odd widths only, interleaved with single bits
+		std::uint8_t oddBuffer[64] = {};
+		BitWriter oddWriter(oddBuffer, sizeof(oddBuffer));
+		const std::int32_t oddWidths[] = { 3, 5, 7, 9, 11, 13, 17, 19, 23, 29, 31 };
+		for (std::int32_t bits : oddWidths) {
+			oddWriter.WriteBool(true);
+			oddWriter.WriteBits(0xFFFFFFFFu, bits);
+			oddWriter.WriteBool(false);
+			oddWriter.WriteBits(0x55555555u, bits);
+		}
+		std::size_t oddSize = oddWriter.Flush();
+
+		BitReader oddReader(oddBuffer, oddSize);
+		allMatched = true;
+		for (std::int32_t bits : oddWidths) {
+			std::uint32_t mask = (1u << bits) - 1;
+			allMatched &= (oddReader.ReadBool() == true);
+			allMatched &= (oddReader.ReadBits(bits) == mask);
+			allMatched &= (oddReader.ReadBool() == false);
+			allMatched &= (oddReader.ReadBits(bits) == (0x55555555u & mask));
+		}
+		Check(allMatched, "values of odd bit widths");
+		Check(oddReader.IsValid(), "reader valid after odd bit widths");
+
+		// Reading past the end returns zero and invalidates the reader
+		Check(oddReader.ReadBits(32) == 0, "zero read past the end");
+		Check(!oddReader.IsValid(), "reader invalid past the end");
+	}
+
+	void TestVariableIntegers()
+	{
+		std::printf("Variable-length integers\n");
+
+		// Both sides of every size class boundary (6, 12, 20 and 32 bits)
+		const std::uint32_t unsignedValues[] = { 0, 1, 63, 64, 4095, 4096, 1048575, 1048576, 0x7FFFFFFFu, 0xFFFFFFFFu };
+		const std::int32_t signedValues[] = { 0, -1, 1, -32, 31, 32, -33, -2048, 2047, 2048, -524288, 524287, 524288,
+			INT32_MIN, INT32_MAX };
+
+		std::uint8_t buffer[256] = {};
+		BitWriter writer(buffer, sizeof(buffer));
+		for (std::uint32_t value : unsignedValues) {
+			writer.WriteVariableUint32(value);
+		}
+		for (std::int32_t value : signedValues) {
+			writer.WriteVariableInt32(value);
+		}
+		std::size_t size = writer.Flush();
+
+		BitReader reader(buffer, size);
+		bool allMatched = true;
+		for (std::uint32_t value : unsignedValues) {
+			std::uint32_t read = reader.ReadVariableUint32();
+			if (read != value) {
+				std::printf("  unsigned %u read as %u\n", value, read);
+				allMatched = false;
+			}
+		}
+		for (std::int32_t value : signedValues) {
+			std::int32_t read = reader.ReadVariableInt32();
+			if (read != value) {
+				std::printf("  signed %d read as %d\n", value, read);
+				allMatched = false;
+			}
+		}
+		Check(allMatched, "variable-length values at size class boundaries");
+		Check(reader.IsValid(), "reader valid after variable-length values");
+
+		// The smallest class takes 8 bits, the largest one 34 bits
+		std::uint8_t smallBuffer[8] = {};
+		BitWriter smallWriter(smallBuffer, sizeof(smallBuffer));
+		smallWriter.WriteVariableInt32(-32);
+		Check(smallWriter.Flush() == 1, "size of the smallest class");
+
+		std::uint8_t largeBuffer[8] = {};
+		BitWriter largeWriter(largeBuffer, sizeof(largeBuffer));
+		largeWriter.WriteVariableUint32(0xFFFFFFFFu);
+		Check(largeWriter.Flush() == 5, "size of the largest class");
+	}
+
+	void TestQuantization()
+	{
+		std::printf("Quantization\n");
+
+		// Quantization truncates, so the error is always below one position unit
+		const float maxError = 1.0f / ActorSnapshot::PositionScale;
+		bool withinError = true;
+		for (float value = -40000.0f; value <= 40000.0f; value += 12.34567f) {
+			float roundTrip = ActorSnapshot::DequantizePosition(ActorSnapshot::QuantizePosition(value));
+			if (std::abs(roundTrip - value) >= maxError) {
+				std::printf("  %f dequantized as %f\n", value, roundTrip);
+				withinError = false;
+			}
+		}
+		Check(withinError, "quantization error below one position unit");
+
+		// Values on the grid are exact
+		Check(ActorSnapshot::DequantizePosition(ActorSnapshot::QuantizePosition(123.5625f)) == 123.5625f, "exact position on the grid");
+		Check(ActorSnapshot::QuantizePosition(-0.03125f) == 0, "position below one unit truncated to zero");
+
+		// Absolute coordinates of the largest levels (1024 tiles of 32 px) fit into the third size class
+		std::uint8_t buffer[16] = {};
+		BitWriter writer(buffer, sizeof(buffer));
+		writer.WriteVariableInt32(ActorSnapshot::QuantizePosition(32767.9f));
+		writer.WriteVariableInt32(ActorSnapshot::QuantizePosition(-32768.0f));
+		Check(writer.Flush() <= 6, "absolute coordinates fit into 22 bits");
+
+		// Worst-case actor must fit into MaxEncodedSize
+		ActorSnapshot worst;
+		worst.PosX = INT32_MIN;
+		worst.PosY = INT32_MAX;
+		worst.Animation = 0xFFFFFFFFu;
+		worst.Rotation = 0xFFFF;
+		worst.ScaleX = 0xFFFF;
+		worst.ScaleY = 0xFFFF;
+		worst.RendererType = 7;
+		worst.Flags = ActorSnapshot::MiscFlagsMask;
+
+		std::uint8_t worstBuffer[ActorSnapshot::MaxEncodedSize] = {};
+		BitWriter worstWriter(worstBuffer, sizeof(worstBuffer));
+		ActorSnapshot baseline;
+		WriteActorSnapshot(worstWriter, 0xFFFFFFFFu, worst, baseline, true);
+		Check(worstWriter.Flush() <= ActorSnapshot::MaxEncodedSize, "worst-case actor fits into MaxEncodedSize");
+	}
+
+	bool SnapshotsEqual(const ActorSnapshot& a, const ActorSnapshot& b)
+	{
+		return (a.PosX == b.PosX && a.PosY == b.PosY && a.Animation == b.Animation && a.Rotation == b.Rotation &&
+			a.ScaleX == b.ScaleX && a.ScaleY == b.ScaleY && a.RendererType == b.RendererType &&
+			(a.Flags & ActorSnapshot::MiscFlagsMask) == (b.Flags & ActorSnapshot::MiscFlagsMask));
+	}
+
+	void TestSnapshots()
+	{
+		std::printf("Snapshots\n");
+
+		ActorSnapshot states[4];
+		states[0].PosX = ActorSnapshot::QuantizePosition(1000.25f);
+		states[0].PosY = ActorSnapshot::QuantizePosition(-20.5f);
+		states[0].Animation = 0x10;
+		states[0].ScaleX = 0x3C00;
+		states[0].ScaleY = 0x3C00;
+		states[0].Flags = 0x04;
+
+		// Small movement, only the position changes
+		states[1] = states[0];
+		states[1].PosX += 3;
+		states[1].PosY -= 2;
+
+		// Large movement with a new animation, rotation, scale and renderer type
+		states[2] = states[1];
+		states[2].PosX += 100000;
+		states[2].Animation = 0x2345;
+		states[2].Rotation = 0x8001;
+		states[2].ScaleX = 0xBC00;
+		states[2].RendererType = 5;
+		states[2].Flags = 0x38;
+
+		// Warped, the position is absolute even in a delta update
+		states[3] = states[2];
+		states[3].PosX = ActorSnapshot::QuantizePosition(-5.0f);
+		states[3].Flags = 0x40;
+
+		std::uint8_t buffer[4 * ActorSnapshot::MaxEncodedSize] = {};
+		BitWriter writer(buffer, sizeof(buffer));
+		ActorSnapshot serverBaseline;
+		for (std::int32_t i = 0; i < 4; i++) {
+			WriteActorSnapshot(writer, 1234, states[i], serverBaseline, i == 0);
+		}
+		std::size_t size = writer.Flush();
+
+		BitReader reader(buffer, size);
+		ActorSnapshot clientBaseline;
+		bool allMatched = true;
+		for (std::int32_t i = 0; i < 4; i++) {
+			allMatched &= (ReadActorSnapshotId(reader) == 1234);
+			ReadActorSnapshot(reader, clientBaseline, true);
+			if (!SnapshotsEqual(clientBaseline, states[i])) {
+				std::printf("  update %d doesn't match\n", i);
+				allMatched = false;
+			}
+		}
+		Check(allMatched, "full and delta updates");
+		Check(reader.IsValid(), "reader valid after updates");
+
+		// A delta position cannot be applied to an invalid baseline, but the rest of the update is still read
+		std::uint8_t deltaBuffer[ActorSnapshot::MaxEncodedSize] = {};
+		BitWriter deltaWriter(deltaBuffer, sizeof(deltaBuffer));
+		ActorSnapshot deltaBaseline = states[0];
+		WriteActorSnapshot(deltaWriter, 7, states[1], deltaBaseline, false);
+		std::size_t deltaSize = deltaWriter.Flush();
+
+		BitReader deltaReader(deltaBuffer, deltaSize);
+		ActorSnapshot staleBaseline;
+		Check(ReadActorSnapshotId(deltaReader) == 7, "actor ID of delta update");
+		SnapshotFields fields = ReadActorSnapshot(deltaReader, staleBaseline, false);
+		Check((fields & SnapshotFields::Position) == SnapshotFields::None, "delta position skipped without baseline");
+		Check(staleBaseline.PosX == 0 && staleBaseline.PosY == 0, "stale baseline not moved");
+		Check(deltaReader.IsValid(), "reader valid after skipped delta");
+	}
+}
+
+int main()
+{
+	TestBitWidths();
+	TestVariableIntegers();
+	TestQuantization();
+	TestSnapshots();
+	return Finish("SnapshotEncodingTests");
+}
@@ -33,6 +33,7 @@
 #include "Jazz2/ContentResolver.h"
 #include "Jazz2/LevelHandler.h"
 #include "Jazz2/PreferencesCache.h"
+#include "Jazz2/Actors/ActorPool.h"
 #include "Jazz2/UI/Cinematics.h"
 #include "Jazz2/UI/DiscordRpcClient.h"
 #include "Jazz2/UI/InGameConsole.h"
@@ -55,6 +56,7 @@
 #	include "Jazz2/Multiplayer/INetworkHandler.h"
 #	include "Jazz2/Multiplayer/MpLevelHandler.h"
 #	include "Jazz2/Multiplayer/PacketTypes.h"
+#	include "Jazz2/Multiplayer/ServerRoom.h"
 using namespace Jazz2::Multiplayer;
 #endif
 
@@ -124,13 +126,14 @@ public:
 
 #if defined(WITH_MULTIPLAYER)
 	static constexpr std::uint16_t MultiplayerDefaultPort = 7438;
-	static constexpr std::uint32_t MultiplayerProtocolVersion = 1;
+	static constexpr std::uint32_t MultiplayerProtocolVersion = ServerRoom::MultiplayerProtocolVersion;
 #endif
 
 	void OnPreInitialize(AppConfiguration& config) override;
 	void OnInitialize() override;
 	void OnBeginFrame() override;
 	void OnPostUpdate() override;
+	void OnInterpolate(float alpha) override;
 	void OnResizeWindow(std::int32_t width, std::int32_t height) override;
 	void OnShutdown() override;
 	void OnSuspend() override;
@@ -180,7 +183,9 @@ public:
 #endif
 
 private:
-	constexpr static std::uint32_t MaxPlayerNameLength = 32;
+#if defined(WITH_MULTIPLAYER)
+	constexpr static std::uint32_t MaxPlayerNameLength = ServerRoom::MaxPlayerNameLength;
+#endif
 
 	Flags _flags = Flags::None;
 	std::int32_t _backInvokedTimeLeft = 0;
@@ -193,6 +198,8 @@ private:
 #if defined(WITH_MULTIPLAYER)
 	std::unique_ptr<NetworkManager> _networkManager;
 	std::unique_ptr<Stream> _streamedAsset;
+	// Additional rooms of a dedicated server, the main session is not included
+	SmallVector<std::unique_ptr<ServerRoom>, 0> _serverRooms;
 #endif
 
 	void OnBeginInitialize();
@@ -215,6 +222,8 @@ private:
 #if defined(WITH_MULTIPLAYER) && defined(WITH_THREADS) && !defined(DEATH_TARGET_EMSCRIPTEN)
 	void RunDedicatedServer(StringView configPath);
 	void StartProcessingStdin();
+	void ProcessRoomCommand(StringView line);
+	static void PrepareDedicatedServerInitialization(ServerInitialization& serverInit);
 #endif
 	static void WriteCacheDescriptor(StringView path, std::uint64_t currentVersion, std::int64_t animsModified);
 	static void SaveEpisodeEnd(const LevelInitialization& levelInit);
@@ -377,6 +386,7 @@ void GameEventHandler::OnPreInitialize(AppConfiguration& config)
 			config.withVSync = false;
 			config.frameLimit = PreferencesCache::MaxFps;
 		}
+		config.fixedTickRate = (PreferencesCache::FixedTimestep ? (std::uint32_t)FrameTimer::FramesPerSecond : 0);
 #if !defined(DEATH_TARGET_SWITCH) && !defined(DEATH_TARGET_PSP) && !defined(DEATH_TARGET_VITA) && !defined(DEATH_TARGET_WII) && !defined(DEATH_TARGET_GAMECUBE) && !defined(DEATH_TARGET_DREAMCAST)
 		// Fixed-panel consoles keep the native output resolution (the device pins it); the level viewport
 		// aspect-fits the logical view into it, so no explicit override is wanted there
@@ -449,6 +459,11 @@ void GameEventHandler::OnInitialize()
 	const AppConfiguration& config = theApplication().GetAppConfiguration();
 	for (std::int32_t i = 0; i < config.argc(); i++) {
 		auto arg = config.argv(i);
+		if (arg == "/flat-scene-graph"_s) {
+			// Linear transform and culling passes (see FlatSceneGraph), otherwise toggled from the debug overlay
+			theApplication().GetRenderingSettings().flatSceneGraph = true;
+			continue;
+		}
 		if (arg.size() > 4) {
 			String ext = arg.suffix(arg.end() - 4);
 			StringUtils::lowercaseInPlace(ext);
@@ -586,12 +601,24 @@ void GameEventHandler::OnBeginFrame()
 	}
 
 	_currentHandler->OnBeginFrame();
+
+#if defined(WITH_MULTIPLAYER)
+	for (auto& room : _serverRooms) {
+		room->OnBeginFrame();
+	}
+#endif
 }
 
 void GameEventHandler::OnPostUpdate()
 {
 	_currentHandler->OnEndFrame();
 
+#if defined(WITH_MULTIPLAYER)
+	for (auto& room : _serverRooms) {
+		room->OnEndFrame();
+	}
+#endif
+
 	if (_backInvokedTimeLeft > 0) {
 		_backInvokedTimeLeft--;
 		if (_backInvokedTimeLeft <= 0) {
@@ -602,6 +629,11 @@ void GameEventHandler::OnPostUpdate()
 	}
 }
 
+void GameEventHandler::OnInterpolate(float alpha)
+{
+	_currentHandler->OnInterpolate(alpha);
+}
+
 void GameEventHandler::OnResizeWindow(std::int32_t width, std::int32_t height)
 {
 	// Resolution was changed, all viewports have to be recreated
@@ -630,6 +662,7 @@ void GameEventHandler::OnShutdown()
 
 	_currentHandler = nullptr;
 #if defined(WITH_MULTIPLAYER)
+	_serverRooms.clear();
 	if (_networkManager != nullptr) {
 		_networkManager->Dispose();
 		_networkManager = nullptr;
@@ -1112,6 +1145,59 @@ void GameEventHandler::RunDedicatedServer(StringView configPath)
 	} else {
 		serverInit.Configuration = NetworkManager::CreateDefaultServerConfiguration();
 	}
+	PrepareDedicatedServerInitialization(serverInit);
+
+	// Nothing is rendered on a dedicated server, so the simulation runs in fixed ticks and the frame rate follows them
+	std::uint32_t tickRate = serverInit.Configuration.TickRate;
+	theApplication().SetFixedTickRate(tickRate);
+	theApplication().SetFrameLimit(tickRate);
+	LOGI("Server is running at {} ticks per second", tickRate);
+
+	SmallVector<String, 0> roomPaths = std::move(serverInit.Configuration.Rooms);
+	SmallVector<std::uint16_t, 0> usedPorts;
+	usedPorts.push_back(serverInit.Configuration.ServerPort);
+
+	WaitForVerify();
+	if (!CreateServer(std::move(serverInit))) {
+		LOGE("Server cannot be started because of invalid configuration");
+		theApplication().Quit();
+		return;
+	} 
+
+	if (!roomPaths.empty()) {
+		if (!ContentResolver::Get().IsHeadless()) {
+			// Root nodes of all rooms would be attached to the same scene, so they can be hosted only without rendering
+			LOGW("Additional rooms are supported only by the dedicated server");
+		} else {
+			for (std::size_t i = 0; i < roomPaths.size(); i++) {
+				std::int32_t roomIndex = std::int32_t(i + 1);
+				ServerInitialization roomInit;
+				roomInit.Configuration = NetworkManager::LoadServerConfigurationFromFile(roomPaths[i]);
+				PrepareDedicatedServerInitialization(roomInit);
+
+				std::uint16_t roomPort = roomInit.Configuration.ServerPort;
+				if (std::find(usedPorts.begin(), usedPorts.end(), roomPort) != usedPorts.end()) {
+					LOGE("Room {} from \"{}\" cannot be started, port {} is already used", roomIndex, roomPaths[i], roomPort);
+					continue;
+				}
+
+				auto room = std::make_unique<ServerRoom>(this, roomIndex);
+				if (!room->Start(std::move(roomInit))) {
+					LOGE("Room {} from \"{}\" cannot be started because of invalid configuration", roomIndex, roomPaths[i]);
+					continue;
+				}
+				usedPorts.push_back(roomPort);
+				_serverRooms.push_back(std::move(room));
+			}
+			LOGI("Server is hosting {} additional rooms", _serverRooms.size());
+		}
+	}
+
+	StartProcessingStdin();
+}
+
+void GameEventHandler::PrepareDedicatedServerInitialization(ServerInitialization& serverInit)
+{
 	serverInit.InitialLevel.IsLocalSession = false;
 	serverInit.InitialLevel.IsReforged = PreferencesCache::EnableReforgedGameplay;
 	serverInit.Configuration.GameMode = MpGameMode::Cooperation;
@@ -1123,15 +1209,6 @@ void GameEventHandler::RunDedicatedServer(StringView configPath)
 			Random().Shuffle<PlaylistEntry>(serverInit.Configuration.Playlist);
 		}
 	}
-
-	WaitForVerify();
-	if (!CreateServer(std::move(serverInit))) {
-		LOGE("Server cannot be started because of invalid configuration");
-		theApplication().Quit();
-		return;
-	} 
-
-	StartProcessingStdin();
 }
 
 #if !defined(DEATH_TARGET_WINDOWS)
@@ -1214,12 +1291,20 @@ void GameEventHandler::StartProcessingStdin()
 
 			if (!line.empty()) {
 				if (line == "/exit"_s || line == "/quit"_s) {
-					if (_this->_networkManager != nullptr) {
-						_this->_networkManager->Dispose();
-						_this->_networkManager = nullptr;
-					}
-					theApplication().Quit();
+					// Level handlers are ticked on the main thread, so they can be released only between frames
+					_this->InvokeAsync([_this]() {
+						for (auto& room : _this->_serverRooms) {
+							room->Dispose();
+						}
+						if (_this->_networkManager != nullptr) {
+							_this->_networkManager->Dispose();
+							_this->_networkManager = nullptr;
+						}
+						theApplication().Quit();
+					});
 					break;
+				} else if (line == "/rooms"_s || line.hasPrefix("/room "_s)) {
+					_this->ProcessRoomCommand(line);
 				} else if (auto levelHandler = runtime_cast<MpLevelHandler>(_this->_currentHandler)) {
 					if (!levelHandler->ProcessCommand({}, line, true) && !line.hasPrefix('/')) {
 						levelHandler->SendMessageToAll(line, true);
@@ -1229,6 +1314,37 @@ void GameEventHandler::StartProcessingStdin()
 		}
 	}, this);
 }
+
+void GameEventHandler::ProcessRoomCommand(StringView line)
+{
+	if (line == "/rooms"_s) {
+		LOGI("Room 0: main session on port {}", _networkManager != nullptr ? _networkManager->GetServerPort() : 0);
+		for (auto& room : _serverRooms) {
+			if (auto* networkManager = room->GetNetworkManager()) {
+				LOGI("Room {}: \"{}\" on port {} with {} players", room->GetIndex(), networkManager->GetServerConfiguration().ServerName,
+					networkManager->GetServerPort(), networkManager->GetPeerCount());
+			} else {
+				LOGI("Room {}: stopped", room->GetIndex());
+			}
+		}
+		return;
+	}
+
+	// Syntax: /room <index> <command or message>
+	auto p = line.exceptPrefix("/room "_s).trimmedPrefix().partition(' ');
+	StringView index = p[0];
+	StringView command = p[2].trimmed();
+	auto roomIndex = stou32(index.data(), index.size());
+	for (auto& room : _serverRooms) {
+		if (room->GetIndex() == std::int32_t(roomIndex)) {
+			if (!command.empty()) {
+				room->ProcessCommand(command);
+			}
+			return;
+		}
+	}
+	LOGW("Room \"{}\" doesn't exist", index);
+}
 #endif
 
 #if defined(WITH_MULTIPLAYER)
@@ -1251,44 +1367,10 @@ bool GameEventHandler::CreateServer(ServerInitialization&& serverInit)
 #	else
 	_networkManager = std::make_unique<NetworkManager>();
 
-	if (serverInit.Configuration.ServerName.empty()) {
-		serverInit.Configuration.ServerName = _("Unnamed server");
-	}
-
-	if (serverInit.Configuration.PlaylistIndex >= 0 && serverInit.Configuration.PlaylistIndex < serverInit.Configuration.Playlist.size()) {
-		auto& playlistEntry = serverInit.Configuration.Playlist[serverInit.Configuration.PlaylistIndex];
-
-		auto level = playlistEntry.LevelName.partition('/');
-		if (playlistEntry.LevelName.contains('/')) {
-			serverInit.InitialLevel.LevelName = playlistEntry.LevelName;
-		} else {
-			serverInit.InitialLevel.LevelName = "unknown/"_s + playlistEntry.LevelName;
-		}
-
-		// Override properties
-		serverInit.Configuration.ReforgedGameplay = playlistEntry.ReforgedGameplay;
-		serverInit.Configuration.Elimination = playlistEntry.Elimination;
-		serverInit.Configuration.InitialPlayerHealth = playlistEntry.InitialPlayerHealth;
-		serverInit.Configuration.MaxGameTimeSecs = playlistEntry.MaxGameTimeSecs;
-		serverInit.Configuration.PreGameSecs = playlistEntry.PreGameSecs;
-		serverInit.Configuration.TotalKills = playlistEntry.TotalKills;
-		serverInit.Configuration.TotalLaps = playlistEntry.TotalLaps;
-		serverInit.Configuration.TotalTreasureCollected = playlistEntry.TotalTreasureCollected;
-		serverInit.Configuration.AllowMinimap = playlistEntry.AllowMinimap;
-		serverInit.Configuration.ColorizePlayersByTeam = playlistEntry.ColorizePlayersByTeam;
-		serverInit.Configuration.GameMode = playlistEntry.GameMode;
-	}
-
-	if (serverInit.InitialLevel.LevelName.empty()) {
-		LOGE("Initial level is not specified");
-		return false;
-	} else if (!ContentResolver::Get().LevelExists(serverInit.InitialLevel.LevelName)) {
-		LOGE("Cannot find initial level \"{}\"", serverInit.InitialLevel.LevelName);
+	if (!ServerRoom::PrepareInitialization(serverInit)) {
 		return false;
 	}
 
-	serverInit.InitialLevel.IsReforged = serverInit.Configuration.ReforgedGameplay;
-
 	if (!_networkManager->CreateServer(this, std::move(serverInit.Configuration))) {
 		return false;
 	}
@@ -1316,20 +1398,7 @@ ConnectionResult GameEventHandler::OnPeerConnected(const Peer& peer, std::uint32
 	LOGI("Peer connected ({}) [{}]", _networkManager->AddressToString(peer), peer);
 
 	if (_networkManager->GetState() == NetworkState::Listening) {
-		if ((clientData & 0xFFF00000) != 0xDEA00000 || (clientData & 0x000FFFFF) > MultiplayerProtocolVersion) {
-			// Connected client is newer than server, reject it
-			LOGI("Peer kicked ({}) [{}]: Incompatible protocol version", _networkManager->AddressToString(peer), peer);
-			return Reason::IncompatibleVersion;
-		}
-
-		const auto& serverConfig = _networkManager->GetServerConfiguration();
-		std::uint32_t peerCount = _networkManager->GetPeerCount();
-		if (peerCount >= serverConfig.MaxPlayerCount) {
-			// The connecting peer is not counted yet, so reject already when the count reaches the limit
-			LOGI("Peer kicked ({}) [{}]: Server is full ({}/{} players)", _networkManager->AddressToString(peer),
-				peer, peerCount, serverConfig.MaxPlayerCount);
-			return Reason::ServerIsFull;
-		}
+		return ServerRoom::AcceptPeer(*_networkManager, peer, clientData);
 	} else {
 		MemoryStream packet(64 + MaxPlayerNameLength);
 		packet.Write("J2R ", 4);
@@ -1449,117 +1518,8 @@ void GameEventHandler::OnPacketReceived(const Peer& peer, std::uint8_t channelId
 {
 	bool isServer = (_networkManager->GetState() == NetworkState::Listening);
 	if (isServer) {
-		switch ((ClientPacketType)packetType) {
-			case ClientPacketType::Ping: {
-				_networkManager->SendTo(peer, NetworkChannel::Main, (std::uint8_t)ServerPacketType::Pong, {});
-				return;
-			}
-			case ClientPacketType::Auth: {
-				MemoryStream packet(data);
-				char gameID[4];
-				packet.Read(gameID, 4);
-				std::uint64_t protocolVersion = packet.ReadVariableUint64();
-
-				constexpr std::uint64_t VersionMask = ~0xFFFFFFFFULL; // Exclude patch from version check
-				constexpr std::uint64_t currentVersion = parseVersion(NCINE_PROTOCOL_VERSION_s);
-
-				if (strncmp("J2R ", gameID, sizeof("J2R ") - 1) != 0 || (protocolVersion & VersionMask) != (currentVersion & VersionMask)) {
-					LOGI("Peer kicked ({}) [{}]: Incompatible protocol version", _networkManager->AddressToString(peer), peer);
-					_networkManager->Kick(peer, Reason::IncompatibleVersion);
-					return;
-				}
-
-				Uuid uuid;
-				packet.Read(uuid.data(), uuid.size());
-				String uniquePlayerId = NetworkManager::UuidToString(uuid);
-
-				LOGD("[MP] ClientPacketType::Auth [{}] - gameID: \"{}\", protocolVersion: 0x{:x}, uuid: \"{}\"",
-					peer, StringView(gameID, 4), protocolVersion, uniquePlayerId);
-
-				std::uint32_t passwordLength = packet.ReadVariableUint32();
-				String password{NoInit, passwordLength};
-				packet.Read(password.data(), passwordLength);
-
-				std::uint8_t playerNameLength = packet.ReadValue<std::uint8_t>();
-
-				// TODO: Sanitize (\n,\r,\t) and strip formatting (\f) from player name
-				if (playerNameLength == 0 || playerNameLength > MaxPlayerNameLength) {
-					LOGI("Peer kicked ({}) [{}]: Invalid player name", _networkManager->AddressToString(peer), peer);
-					_networkManager->Kick(peer, Reason::InvalidPlayerName);
-					return;
-				}
-
-				String playerName{NoInit, playerNameLength};
-				packet.Read(playerName.data(), playerNameLength);
-
-				const auto& serverConfig = _networkManager->GetServerConfiguration();
-				if (serverConfig.BannedUniquePlayerIDs.contains(uniquePlayerId)) {
-					LOGI("Peer kicked \"{}\" ({}) [{}]: Banned by unique player ID", playerName, _networkManager->AddressToString(peer), peer);
-					_networkManager->Kick(peer, Reason::Banned);
-					return;
-				}
-				if (!serverConfig.WhitelistedUniquePlayerIDs.empty() && !serverConfig.WhitelistedUniquePlayerIDs.contains(uniquePlayerId)) {
-					LOGI("Peer kicked \"{}\" ({}) [{}]: Not in whitelist", playerName, _networkManager->AddressToString(peer), peer);
-					_networkManager->Kick(peer, Reason::NotInWhitelist);
-					return;
-				}
-
-				if (!serverConfig.ServerPassword.empty() && password != serverConfig.ServerPassword) {
-					LOGI("Peer kicked \"{}\" ({}) [{}]: Invalid password", playerName, _networkManager->AddressToString(peer), peer);
-					_networkManager->Kick(peer, Reason::InvalidPassword);
-					return;
-				}
-
-				std::uint8_t deviceIdLength = packet.ReadValue<std::uint8_t>();
-				String deviceId{NoInit, deviceIdLength};
-				packet.Read(deviceId.data(), deviceIdLength);
-
-				std::uint64_t playerUserId = packet.ReadVariableUint64();
-				if (serverConfig.RequiresDiscordAuth && playerUserId == 0) {
-					LOGI("Peer kicked \"{}\" ({}) [{}]: Discord authentication is required", playerName, _networkManager->AddressToString(peer), peer);
-					_networkManager->Kick(peer, Reason::Requires3rdPartyAuthProvider);
-					return;
-				}
-				// TODO: Check playerUserId for whitelist (Reason::NotInWhitelist)
-
-				std::uint32_t furColor = packet.ReadValueAsLE<std::uint32_t>();
-
-				if (auto peerDesc = _networkManager->GetPeerDescriptor(peer)) {
-					peerDesc->UniquePlayerID = std::move(uuid);
-					peerDesc->PlayerName = std::move(playerName);
-					peerDesc->FurColor = furColor;
-					peerDesc->IsAuthenticated = true;
-
-					if (serverConfig.AdminUniquePlayerIDs.contains(uniquePlayerId)) {
-						peerDesc->IsAdmin = true;
-					}
-
-					// Reconnect: if this player disconnected recently (and no new round invalidated it), restore
-					// their progression (weapons, lives, score, gems) and championship points so they resume
-					if (auto previous = _networkManager->ReclaimDisconnectedPeer(peerDesc->UniquePlayerID)) {
-						if (previous->HasCarryOver) {
-							peerDesc->CarryOver = previous->CarryOver;
-							peerDesc->HasCarryOver = true;
-							peerDesc->Points = previous->Points;
-							peerDesc->Team = previous->Team;
-							peerDesc->PreferredPlayerType = previous->CarryOver.Type;
-							LOGI("Peer \"{}\" [{}] reconnected, restoring progression", peerDesc->PlayerName, peer);
-						}
-					}
-
-					LOGI("Peer authenticated as \"{}\" ({}){} [{}]", peerDesc->PlayerName, _networkManager->AddressToString(peer),
-						peerDesc->IsAdmin ? " [Admin]" : "", peer);
-
-					MemoryStream packet(17);
-					packet.WriteValue<std::uint8_t>(0);	// Flags
-					packet.Write(PreferencesCache::UniqueServerID, PreferencesCache::UniqueServerID.size() - sizeof(std::uint16_t));
-					packet.WriteValue<std::uint16_t>(_networkManager->GetServerPort());	// Server port is part of Unique Server ID
-					_networkManager->SendTo(peer, NetworkChannel::Main, (std::uint8_t)ServerPacketType::AuthResponse, packet);
-				} else {
-					DEATH_ASSERT_UNREACHABLE();
-				}
-				break;
-			}
+		if (ServerRoom::ProcessServerPacket(*_networkManager, peer, packetType, data)) {
+			return;
 		}
 	} else {
 		switch ((ServerPacketType)packetType) {
@@ -1860,6 +1820,8 @@ void GameEventHandler::ReleasePreviousHandler()
 void GameEventHandler::SetStateHandler(std::shared_ptr<IStateHandler>&& handler)
 {
 	_currentHandler = std::move(handler);
+	// Actors of the previous level were released with its handler, return their pooled memory to the system
+	Actors::ActorPool::Trim();
 
 	Viewport::GetChain().clear();
 	Vector2i res = theApplication().GetResolution();
@@ -8,6 +8,9 @@
 #include "../Containers/DateTime.h"
 #include "../Containers/SmallVector.h"
 #include "../Containers/StringConcatenable.h"
+#include "../Base/Format.h"
+
+#include <atomic>
 
 #if defined(DEATH_TARGET_WINDOWS)
 #	include <fileapi.h>
@@ -2980,6 +2983,34 @@ namespace Death { namespace IO {
 		return std::make_unique<FileStream>(path, mode, bufferSize);
 	}
 
+	bool FileSystem::WriteAtomically(StringView path, Function<bool(Stream&)>&& writer)
+	{
+		// Multiple processes (or threads) may write the same file at once, so each writes its own temporary file
+		static std::atomic_uint32_t counter{0};
+		std::uint64_t unique = Environment::QueryUnbiasedInterruptTime() ^ ((std::uint64_t)counter.fetch_add(1) << 48);
+#if defined(DEATH_TARGET_WINDOWS)
+		unique ^= (std::uint64_t)::GetCurrentProcessId() << 32;
+#elif defined(DEATH_TARGET_ANDROID) || defined(DEATH_TARGET_APPLE) || defined(DEATH_TARGET_UNIX)
+		unique ^= (std::uint64_t)::getpid() << 32;
+#endif
+		char suffix[24];
+		std::size_t suffixLength = formatInto(suffix, ".{:x}.tmp", unique);
+		String tempPath = path + StringView(suffix, suffixLength);
+
+		bool success;
+		{
+			auto s = Open(tempPath, FileAccess::Write);
+			success = (s->IsValid() && writer(*s));
+		}
+
+		// Renaming replaces the file atomically, so a concurrent reader never sees a partially written file
+		if (!success || !Move(tempPath, path)) {
+			RemoveFile(tempPath);
+			return false;
+		}
+		return true;
+	}
+
 #if defined(DEATH_TARGET_ANDROID) || defined(DEATH_TARGET_APPLE) || defined(DEATH_TARGET_UNIX) || (defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT))
 	void FileSystem::MapDeleter::operator()(const char* const data, const std::size_t size)
 	{
@@ -6,6 +6,7 @@
 
 #include "Stream.h"
 #include "FileAccess.h"
+#include "../Containers/Function.h"
 #include "../Containers/String.h"
 
 #include <memory>
@@ -367,6 +368,16 @@ namespace Death { namespace IO {
 		/** @brief Opens a file stream with specified access mode */
 		static std::unique_ptr<Stream> Open(Containers::StringView path, FileAccess mode, std::int32_t bufferSize = 8192);
 
+		/**
+		 * @brief Replaces a file atomically with the content written by the callback
+		 *
+		 * The callback writes to a uniquely named temporary file next to @p path, which is then renamed to @p path,
+		 * so a concurrent reader (even in another process) never sees a partially written file, and handles that
+		 * already opened or mapped the previous file keep using it. The temporary file is removed if the callback
+		 * returns `false` or the file cannot be renamed.
+		 */
+		static bool WriteAtomically(Containers::StringView path, Containers::Function<bool(Stream&)>&& writer);
+
 #	if defined(DEATH_TARGET_ANDROID) || defined(DEATH_TARGET_APPLE) || defined(DEATH_TARGET_UNIX) || (defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT)) || defined(DOXYGEN_GENERATING_OUTPUT)
 		/**
 			@brief Memory-mapped file deleter
@@ -0,0 +1,129 @@
+#include "SpanReader.h"
+
+#include <algorithm>
+
+namespace Death { namespace IO {
+//###==##====#=====--==~--~=~- --- -- -  -  -   -
+
+	SpanReader::SpanReader(Containers::ArrayView<const std::uint8_t> data)
+		: _begin(data.data()), _ptr(data.data()), _end(data.data() + data.size()), _source(nullptr),
+			_consumed(0), _blockSize(0), _isValid(true)
+	{
+	}
+
+	SpanReader::SpanReader(Containers::ArrayView<const char> data)
+		: SpanReader(Containers::ArrayView<const std::uint8_t>(reinterpret_cast<const std::uint8_t*>(data.data()), data.size()))
+	{
+	}
+
+	SpanReader::SpanReader(Stream& source, std::int32_t blockSize)
+		: _begin(nullptr), _ptr(nullptr), _end(nullptr), _source(&source),
+			_buffer(std::make_unique<std::uint8_t[]>(blockSize)), _consumed(0), _blockSize(blockSize), _isValid(true)
+	{
+		_begin = _buffer.get();
+		_ptr = _begin;
+		_end = _begin;
+	}
+
+	SpanReader::~SpanReader()
+	{
+	}
+
+	void SpanReader::Skip(std::int64_t bytesToSkip)
+	{
+		while (bytesToSkip > 0) {
+			std::int64_t available = _end - _ptr;
+			if (available == 0) {
+				if (!Refill()) {
+					_isValid = false;
+					return;
+				}
+				continue;
+			}
+
+			std::int64_t bytesToSkipNow = std::min(available, bytesToSkip);
+			_ptr += bytesToSkipNow;
+			bytesToSkip -= bytesToSkipNow;
+		}
+	}
+
+	std::int64_t SpanReader::ReadSlow(void* destination, std::int64_t bytesToRead)
+	{
+		std::uint8_t* dst = static_cast<std::uint8_t*>(destination);
+		std::int64_t bytesRead = 0;
+
+		while (bytesRead < bytesToRead) {
+			std::int64_t available = _end - _ptr;
+			if (available == 0) {
+				// Large reads bypass the window and go directly to the destination
+				if (_source != nullptr && bytesToRead - bytesRead >= _blockSize) {
+					_consumed += (_ptr - _begin);
+					_ptr = _begin;
+					_end = _begin;
+
+					std::int64_t bytesReadNow = _source->Read(dst + bytesRead, bytesToRead - bytesRead);
+					if (bytesReadNow > 0) {
+						_consumed += bytesReadNow;
+						bytesRead += bytesReadNow;
+						continue;
+					}
+				} else if (Refill()) {
+					continue;
+				}
+
+				// Reading past the end, the rest of the destination is zeroed to make the result deterministic
+				std::memset(dst + bytesRead, 0, std::size_t(bytesToRead - bytesRead));
+				_isValid = false;
+				break;
+			}
+
+			std::int64_t bytesToCopy = std::min(available, bytesToRead - bytesRead);
+			std::memcpy(dst + bytesRead, _ptr, std::size_t(bytesToCopy));
+			_ptr += bytesToCopy;
+			bytesRead += bytesToCopy;
+		}
+
+		return bytesRead;
+	}
+
+	std::uint64_t SpanReader::ReadVariableSlow(std::int32_t maxBytes)
+	{
+		std::uint64_t result = 0;
+		std::int32_t shift = 0;
+		for (std::int32_t i = 0; i < maxBytes; i++) {
+			if (_ptr == _end && !Refill()) {
+				_isValid = false;
+				break;
+			}
+
+			std::uint8_t byte = *_ptr++;
+			result |= (std::uint64_t)(byte & 0x7f) << shift;
+			shift += 7;
+			if ((byte & 0x80) == 0) {
+				break;
+			}
+		}
+		return result;
+	}
+
+	bool SpanReader::Refill()
+	{
+		if (_source == nullptr) {
+			return false;
+		}
+
+		_consumed += (_ptr - _begin);
+
+		std::int64_t bytesRead = _source->Read(_buffer.get(), _blockSize);
+		if (bytesRead <= 0) {
+			_ptr = _begin;
+			_end = _begin;
+			return false;
+		}
+
+		_ptr = _begin;
+		_end = _begin + bytesRead;
+		return true;
+	}
+
+}}
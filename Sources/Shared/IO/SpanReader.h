@@ -0,0 +1,155 @@
+#pragma once
+
+/** @file
+	@brief Class @ref Death::IO::SpanReader
+*/
+
+#include "Stream.h"
+#include "../Containers/ArrayView.h"
+
+#include <cstring>
+#include <memory>
+
+namespace Death { namespace IO {
+//###==##====#=====--==~--~=~- --- -- -  -  -   -
+
+	/**
+		@brief Reads values from a contiguous window of memory without virtual calls
+
+		The reader either references an existing region of memory directly (zero-copy), or reads a @ref Stream
+		in large blocks into an internal window, so parsing many small values doesn't go through a virtual
+		@ref Stream::Read() call for each of them. Fixed-size values that fit into the current window are read
+		inline, only refilling the window takes the slow path.
+
+		Reading past the end returns zeros and marks the reader invalid, so malformed data can be checked
+		once after everything is read. In buffered mode, the reader consumes the source stream ahead of the
+		values actually read, so the source stream shouldn't be used directly while the reader exists.
+	*/
+	class SpanReader
+	{
+	public:
+		/** @brief Default size of the internal window used to read a @ref Stream */
+#if defined(DEATH_TARGET_EMSCRIPTEN)
+		static constexpr std::int32_t DefaultBlockSize = 8192;
+#else
+		static constexpr std::int32_t DefaultBlockSize = 16384;
+#endif
+
+		/** @brief Creates a reader that references the specified region of memory */
+		explicit SpanReader(Containers::ArrayView<const std::uint8_t> data);
+		/** @overload */
+		explicit SpanReader(Containers::ArrayView<const char> data);
+		/** @brief Creates a reader that reads the specified stream in blocks */
+		explicit SpanReader(Stream& source, std::int32_t blockSize = DefaultBlockSize);
+		~SpanReader();
+
+		SpanReader(const SpanReader&) = delete;
+		SpanReader& operator=(const SpanReader&) = delete;
+
+		/** @brief Returns `false` if the reader ran past the end of the data */
+		DEATH_ALWAYS_INLINE bool IsValid() const {
+			return _isValid;
+		}
+
+		/** @brief Returns the number of bytes read so far */
+		DEATH_ALWAYS_INLINE std::int64_t GetPosition() const {
+			return _consumed + (_ptr - _begin);
+		}
+
+		/** @brief Reads a certain amount of bytes to a buffer, returns the number of bytes actually read */
+		std::int64_t Read(void* destination, std::int64_t bytesToRead) {
+			if DEATH_LIKELY(bytesToRead <= _end - _ptr) {
+				std::memcpy(destination, _ptr, std::size_t(bytesToRead));
+				_ptr += bytesToRead;
+				return bytesToRead;
+			}
+			return ReadSlow(destination, bytesToRead);
+		}
+
+		/** @brief Skips a certain amount of bytes */
+		void Skip(std::int64_t bytesToSkip);
+
+		/** @brief Reads a trivial value */
+		template<typename T>
+		DEATH_ALWAYS_INLINE T ReadValue()
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "ReadValue() requires the source type to be trivially copyable");
+			static_assert(!std::is_pointer<T>::value && !std::is_reference<T>::value, "ReadValue() must not be used on pointer or reference types");
+
+			T value{};
+			Read(&value, sizeof(T));
+			return value;
+		}
+
+		/** @brief Reads a trivial value always as Little-Endian */
+		template<typename T>
+		DEATH_ALWAYS_INLINE T ReadValueAsLE()
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "ReadValueAsLE() requires the source type to be trivially copyable");
+			static_assert(!std::is_pointer<T>::value && !std::is_reference<T>::value, "ReadValueAsLE() must not be used on pointer or reference types");
+			static_assert(sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8, "ReadValueAsLE() requires the source type to be 2, 4 or 8 bytes");
+
+			T value{};
+			Read(&value, sizeof(T));
+#if defined(DEATH_TARGET_BIG_ENDIAN)
+			value = Memory::SwapBytes(value);
+#endif
+			return value;
+		}
+
+		/** @brief Reads a 32-bit integer value using variable-length quantity encoding, see @ref Stream::ReadVariableInt32() */
+		DEATH_ALWAYS_INLINE std::int32_t ReadVariableInt32() {
+			std::uint32_t n = ReadVariableUint32();
+			return (std::int32_t)(n >> 1) ^ -(std::int32_t)(n & 1);
+		}
+		/** @brief Reads a 64-bit integer value using variable-length quantity encoding, see @ref Stream::ReadVariableInt64() */
+		DEATH_ALWAYS_INLINE std::int64_t ReadVariableInt64() {
+			std::uint64_t n = ReadVariableUint64();
+			return (std::int64_t)(n >> 1) ^ -(std::int64_t)(n & 1);
+		}
+		/** @brief Reads a 32-bit unsigned integer value using variable-length quantity encoding */
+		DEATH_ALWAYS_INLINE std::uint32_t ReadVariableUint32() {
+			if DEATH_LIKELY(_end - _ptr >= 5) {
+				return (std::uint32_t)ReadVariableFast(5);
+			}
+			return (std::uint32_t)ReadVariableSlow(5);
+		}
+		/** @brief Reads a 64-bit unsigned integer value using variable-length quantity encoding */
+		DEATH_ALWAYS_INLINE std::uint64_t ReadVariableUint64() {
+			if DEATH_LIKELY(_end - _ptr >= 10) {
+				return ReadVariableFast(10);
+			}
+			return ReadVariableSlow(10);
+		}
+
+	private:
+		const std::uint8_t* _begin;
+		const std::uint8_t* _ptr;
+		const std::uint8_t* _end;
+		Stream* _source;
+		std::unique_ptr<std::uint8_t[]> _buffer;
+		std::int64_t _consumed;
+		std::int32_t _blockSize;
+		bool _isValid;
+
+		DEATH_ALWAYS_INLINE std::uint64_t ReadVariableFast(std::int32_t maxBytes) {
+			// The whole value is known to be in the window, so no bounds checks are needed
+			std::uint64_t result = 0;
+			std::int32_t shift = 0;
+			for (std::int32_t i = 0; i < maxBytes; i++) {
+				std::uint8_t byte = *_ptr++;
+				result |= (std::uint64_t)(byte & 0x7f) << shift;
+				shift += 7;
+				if ((byte & 0x80) == 0) {
+					break;
+				}
+			}
+			return result;
+		}
+
+		std::int64_t ReadSlow(void* destination, std::int64_t bytesToRead);
+		std::uint64_t ReadVariableSlow(std::int32_t maxBytes);
+		bool Refill();
+	};
+
+}}
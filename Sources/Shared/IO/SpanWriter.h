@@ -0,0 +1,112 @@
+#pragma once
+
+/** @file
+	@brief Class @ref Death::IO::SpanWriter
+*/
+
+#include "Stream.h"
+#include "../Containers/ArrayView.h"
+
+#include <cstring>
+
+namespace Death { namespace IO {
+//###==##====#=====--==~--~=~- --- -- -  -  -   -
+
+	/**
+		@brief Writes values to a fixed-size region of memory without virtual calls
+
+		Counterpart of @ref SpanReader for small messages of a known maximum size, e.g. network packets built
+		on the stack. Writing past the end of the buffer writes nothing and marks the writer invalid.
+	*/
+	class SpanWriter
+	{
+	public:
+		/** @brief Creates a writer that fills the specified region of memory */
+		explicit SpanWriter(Containers::ArrayView<std::uint8_t> buffer)
+			: _begin(buffer.data()), _ptr(buffer.data()), _end(buffer.data() + buffer.size()), _isValid(true) {}
+
+		SpanWriter(const SpanWriter&) = delete;
+		SpanWriter& operator=(const SpanWriter&) = delete;
+
+		/** @brief Returns `false` if the writer ran past the end of the buffer */
+		DEATH_ALWAYS_INLINE bool IsValid() const {
+			return _isValid;
+		}
+
+		/** @brief Returns the number of bytes written so far */
+		DEATH_ALWAYS_INLINE std::int64_t GetPosition() const {
+			return _ptr - _begin;
+		}
+
+		/** @brief Returns the written part of the buffer */
+		DEATH_ALWAYS_INLINE Containers::ArrayView<const std::uint8_t> GetWrittenView() const {
+			return { _begin, std::size_t(_ptr - _begin) };
+		}
+
+		/** @brief Writes a certain amount of bytes from a buffer, returns the number of bytes actually written */
+		DEATH_ALWAYS_INLINE std::int64_t Write(const void* source, std::int64_t bytesToWrite) {
+			if DEATH_UNLIKELY(bytesToWrite > _end - _ptr) {
+				_isValid = false;
+				return 0;
+			}
+			std::memcpy(_ptr, source, std::size_t(bytesToWrite));
+			_ptr += bytesToWrite;
+			return bytesToWrite;
+		}
+
+		/** @brief Writes a trivial value */
+		template<typename T>
+		DEATH_ALWAYS_INLINE void WriteValue(const T& value)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "WriteValue() requires the source type to be trivially copyable");
+			static_assert(!std::is_pointer<T>::value && !std::is_reference<T>::value, "WriteValue() must not be used on pointer or reference types");
+
+			Write(&value, sizeof(T));
+		}
+
+		/** @brief Writes a trivial value always as Little-Endian */
+		template<typename T>
+		DEATH_ALWAYS_INLINE void WriteValueAsLE(T value)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "WriteValueAsLE() requires the source type to be trivially copyable");
+			static_assert(!std::is_pointer<T>::value && !std::is_reference<T>::value, "WriteValueAsLE() must not be used on pointer or reference types");
+			static_assert(sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8, "WriteValueAsLE() requires the source type to be 2, 4 or 8 bytes");
+
+#if defined(DEATH_TARGET_BIG_ENDIAN)
+			value = Memory::SwapBytes(value);
+#endif
+			Write(&value, sizeof(T));
+		}
+
+		/** @brief Writes a 32-bit integer value using variable-length quantity encoding, see @ref Stream::WriteVariableInt32() */
+		DEATH_ALWAYS_INLINE void WriteVariableInt32(std::int32_t value) {
+			WriteVariableUint64((std::uint32_t)(value << 1) ^ (std::uint32_t)(value >> 31));
+		}
+		/** @brief Writes a 64-bit integer value using variable-length quantity encoding, see @ref Stream::WriteVariableInt64() */
+		DEATH_ALWAYS_INLINE void WriteVariableInt64(std::int64_t value) {
+			WriteVariableUint64((std::uint64_t)(value << 1) ^ (std::uint64_t)(value >> 63));
+		}
+		/** @brief Writes a 32-bit unsigned integer value using variable-length quantity encoding */
+		DEATH_ALWAYS_INLINE void WriteVariableUint32(std::uint32_t value) {
+			WriteVariableUint64(value);
+		}
+		/** @brief Writes a 64-bit unsigned integer value using variable-length quantity encoding */
+		void WriteVariableUint64(std::uint64_t value) {
+			std::uint8_t encoded[10];
+			std::int32_t length = 0;
+			while (value >= 0x80) {
+				encoded[length++] = (std::uint8_t)(value | 0x80);
+				value >>= 7;
+			}
+			encoded[length++] = (std::uint8_t)value;
+			Write(encoded, length);
+		}
+
+	private:
+		std::uint8_t* _begin;
+		std::uint8_t* _ptr;
+		std::uint8_t* _end;
+		bool _isValid;
+	};
+
+}}
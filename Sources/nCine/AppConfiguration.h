@@ -34,6 +34,13 @@ namespace nCine
 		
 		/** @brief Maximum number of frames to render per second or 0 for no limit */
 		std::uint32_t frameLimit;
+		/**
+		 * @brief Number of simulation ticks per second or 0 to update once per rendered frame
+		 *
+		 * When non-zero, the scenegraph is updated in fixed steps independent of the frame rate and the rendered
+		 * frames interpolate the node positions between the last two ticks, see @ref Application::SetFixedTickRate().
+		 */
+		std::uint32_t fixedTickRate;
 
 		/** @brief Interval for frame timer accumulation average and log */
 		float frameTimerLogInterval;
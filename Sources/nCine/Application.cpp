@@ -53,6 +53,8 @@ extern "C"
 #include "Graphics/RenderQueue.h"
 #include "Graphics/ScreenViewport.h"
 #include "Graphics/RHI/Rhi.h"
+#include "Base/FrameArena.h"
+#include "Base/FrameProfiler.h"
 #include "Base/FrameTimer.h"
 #include "Graphics/SceneNode.h"
 #include "Input/IInputManager.h"
@@ -748,7 +750,8 @@ static void AppendMessageColor(char* dest, std::int32_t& length, TraceLevel leve
 namespace nCine
 {
 	Application::Application()
-		: _isSuspended(false), _autoSuspension(false), _hasFocus(true), _shouldQuit(false)
+		: _isSuspended(false), _autoSuspension(false), _hasFocus(true), _shouldQuit(false), _updateCount(0),
+			_tickAccumulator(0.0f), _interpolationAlpha(1.0f)
 #if defined(DEATH_TRACE)
 			, _mainThreadId(Death::Trace::Implementation::GetNativeThreadId())
 #endif
@@ -776,9 +779,23 @@ namespace nCine
 
 	float Application::GetTimeMult() const
 	{
+		if (_appCfg.fixedTickRate > 0) {
+			return FrameTimer::FramesPerSecond / float(_appCfg.fixedTickRate);
+		}
 		return _frameTimer->GetTimeMult();
 	}
 
+	void Application::SetFixedTickRate(std::uint32_t ticksPerSecond)
+	{
+		if (_appCfg.fixedTickRate == ticksPerSecond) {
+			return;
+		}
+
+		_appCfg.fixedTickRate = ticksPerSecond;
+		_tickAccumulator = 0.0f;
+		_interpolationAlpha = 1.0f;
+	}
+
 	const FrameTimer& Application::GetFrameTimer() const
 	{
 		return *_frameTimer;
@@ -949,6 +966,11 @@ namespace nCine
 	void Application::Step()
 	{
 		_frameTimer->AddFrame();
+#if defined(WITH_FRAME_PROFILER)
+		// The previous frame is complete at this point, including the time spent in frame limiting
+		FrameProfiler::OnFrameEnd(_frameTimer->GetLastFrameDuration());
+#endif
+		ZoneScopedNC("Frame", 0x81A861);
 
 #if defined(WITH_IMGUI)
 		if (_appCfg.withGraphics) {
@@ -966,45 +988,78 @@ namespace nCine
 		LuaStatistics::update();
 #endif
 
-		{
-			ZoneScopedNC("OnBeginFrame", 0x81A861);
-#if defined(NCINE_PROFILING)
-			_profileStartTime = TimeStamp::now();
-#endif
-			_appEventHandler->OnBeginFrame();
-#if defined(NCINE_PROFILING)
-			_timings[(std::int32_t)Timings::BeginFrame] = _profileStartTime.secondsSince();
-#endif
+		// In fixed-timestep mode, the elapsed time is consumed in ticks of the same length, so a frame can run
+		// no tick at all (on high refresh rates) or several of them (on slow frames)
+		std::int32_t tickCount = 1;
+		if (_appCfg.fixedTickRate > 0) {
+			const float tickDuration = 1.0f / float(_appCfg.fixedTickRate);
+			_tickAccumulator += std::min(_frameTimer->GetLastFrameDuration(), MaxTickAccumulation);
+			tickCount = std::int32_t(_tickAccumulator / tickDuration);
+			if (tickCount > MaxTicksPerFrame) {
+				// The simulation can't keep up, drop the excess time instead of spiraling into ever longer frames
+				tickCount = MaxTicksPerFrame;
+				_tickAccumulator = std::fmod(_tickAccumulator, tickDuration);
+			} else {
+				_tickAccumulator -= float(tickCount) * tickDuration;
+			}
+			_interpolationAlpha = std::clamp(_tickAccumulator / tickDuration, 0.0f, 1.0f);
 		}
 
-#if defined(WITH_IMGUI)
-		if (_debugOverlay != nullptr) {
-			_debugOverlay->Update();
-		}
-#endif
+		for (std::int32_t i = 0; i < tickCount; i++) {
+			_updateCount++;
+			if (i > 0 && _appCfg.withScenegraph) {
+				_screenViewport->ResetUpdated();
+			}
 
-		if (_appCfg.withScenegraph) {
-			ZoneScopedNC("SceneGraph", 0x81A861);
 			{
-				ZoneScopedNC("Update", 0x81A861);
+				ZoneScopedNC("OnBeginFrame", 0x81A861);
 #if defined(NCINE_PROFILING)
 				_profileStartTime = TimeStamp::now();
 #endif
-				_screenViewport->Update();
+				_appEventHandler->OnBeginFrame();
 #if defined(NCINE_PROFILING)
-				_timings[(std::int32_t)Timings::Update] = _profileStartTime.secondsSince();
+				_timings[(std::int32_t)Timings::BeginFrame] = _profileStartTime.secondsSince();
 #endif
 			}
 
-			{
-				ZoneScopedNC("OnPostUpdate", 0x81A861);
+			if (_appCfg.withScenegraph) {
+				ZoneScopedNC("SceneGraph", 0x81A861);
+				{
+					ZoneScopedNC("Update", 0x81A861);
 #if defined(NCINE_PROFILING)
-				_profileStartTime = TimeStamp::now();
+					_profileStartTime = TimeStamp::now();
 #endif
-				_appEventHandler->OnPostUpdate();
+					_screenViewport->Update();
 #if defined(NCINE_PROFILING)
-				_timings[(std::int32_t)Timings::PostUpdate] = _profileStartTime.secondsSince();
+					_timings[(std::int32_t)Timings::Update] = _profileStartTime.secondsSince();
 #endif
+				}
+
+				{
+					ZoneScopedNC("OnPostUpdate", 0x81A861);
+#if defined(NCINE_PROFILING)
+					_profileStartTime = TimeStamp::now();
+#endif
+					_appEventHandler->OnPostUpdate();
+#if defined(NCINE_PROFILING)
+					_timings[(std::int32_t)Timings::PostUpdate] = _profileStartTime.secondsSince();
+#endif
+				}
+			}
+		}
+
+#if defined(WITH_IMGUI)
+		if (_debugOverlay != nullptr) {
+			_debugOverlay->Update();
+		}
+#endif
+
+		if (_appCfg.withScenegraph) {
+			ZoneScopedNC("SceneGraph", 0x81A861);
+			if (_appCfg.fixedTickRate > 0 && _appCfg.withGraphics) {
+				ZoneScopedNC("Interpolate", 0x81A861);
+				_appEventHandler->OnInterpolate(_interpolationAlpha);
+				_screenViewport->Interpolate(_interpolationAlpha);
 			}
 
 			if (_appCfg.withGraphics) {
@@ -1087,6 +1142,9 @@ namespace nCine
 			TracyGpuCollect;
 		}
 
+		// The render queues of this frame are flushed, scratch memory of the frame before it can be reused
+		FrameArena::OnFrameEnd();
+
 		if (_appCfg.frameLimit > 0) {
 			FrameMarkStart("Frame limiting");
 			const std::int64_t frameTimeDuration = clock().frequency() / _appCfg.frameLimit;
@@ -1168,6 +1226,7 @@ namespace nCine
 			RenderResources::Dispose();
 			_gfxDevice = nullptr;
 		}
+		FrameArena::Dispose();
 
 		_frameTimer = nullptr;
 		_inputManager = nullptr;
@@ -65,7 +65,7 @@ namespace nCine
 #else
 				: batchingEnabled(true),
 #endif
-				  batchingWithIndices(false), cullingEnabled(true), minBatchSize(4),
+				  batchingWithIndices(false), cullingEnabled(true), flatSceneGraph(false), minBatchSize(4),
 #if defined(WITH_RHI_RSX)
 				  // The PlayStation 3's batched shaders reach their instance array through the RSX's constant
 				  // registers rather than a uniform buffer, so the batch is bounded by what fits there and by
@@ -84,6 +84,8 @@ namespace nCine
 			bool batchingWithIndices;
 			/** @brief Whether node culling is enabled */
 			bool cullingEnabled;
+			/** @brief Whether viewports transform and cull their nodes through a @ref FlatSceneGraph */
+			bool flatSceneGraph;
 			/** @brief Minimum size for a batch to be collected */
 			std::uint32_t minBatchSize;
 			/** @brief Maximum size for a batch before a forced split */
@@ -161,6 +163,23 @@ namespace nCine
 		std::uint32_t GetFrameCount() const;
 		/** @brief Returns a factor that represents how long the last frame took relative to the desired frame time */
 		float GetTimeMult() const;
+		/** @brief Returns the total number of scenegraph updates, the same as @ref GetFrameCount() unless fixed-timestep mode is enabled */
+		inline std::uint32_t GetUpdateCount() const { return _updateCount; }
+		/** @brief Returns the position of the rendered frame between the previous and the last tick, always 1.0 in variable-step mode */
+		inline float GetInterpolationAlpha() const { return _interpolationAlpha; }
+		/** @brief Returns the number of simulation ticks per second or 0 if the scenegraph is updated once per frame */
+		inline std::uint32_t GetFixedTickRate() const { return _appCfg.fixedTickRate; }
+		/**
+		 * @brief Sets the number of simulation ticks per second or 0 to update the scenegraph once per frame
+		 *
+		 * In fixed-timestep mode, each frame runs as many ticks (@ref IAppEventHandler::OnBeginFrame(), scenegraph
+		 * update and @ref IAppEventHandler::OnPostUpdate()) as the elapsed time requires, each with the same time
+		 * multiplier, so the simulation doesn't depend on the frame rate. The rendered frame then interpolates
+		 * the positions of the nodes between the last two ticks.
+		 */
+		void SetFixedTickRate(std::uint32_t ticksPerSecond);
+		/** @brief Sets the maximum number of frames to render per second or 0 for no limit */
+		inline void SetFrameLimit(std::uint32_t frameLimit) { _appCfg.frameLimit = frameLimit; }
 		/** @brief Returns the frame timer interface */
 		const FrameTimer& GetFrameTimer() const;
 
@@ -255,6 +274,9 @@ namespace nCine
 
 		TimeStamp _profileStartTime;
 		std::unique_ptr<FrameTimer> _frameTimer;
+		std::uint32_t _updateCount;
+		float _tickAccumulator;
+		float _interpolationAlpha;
 		std::unique_ptr<IGfxDevice> _gfxDevice;
 		std::unique_ptr<SceneNode> _rootNode;
 		std::unique_ptr<ScreenViewport> _screenViewport;
@@ -296,6 +318,11 @@ namespace nCine
 #endif
 
 	private:
+		/** @brief Maximum number of ticks run in a single frame, the remaining time is dropped if the simulation can't keep up */
+		static constexpr std::int32_t MaxTicksPerFrame = 4;
+		/** @brief Maximum frame duration accumulated for the ticks, in seconds */
+		static constexpr float MaxTickAccumulation = 0.25f;
+
 		Application(const Application&) = delete;
 		Application& operator=(const Application&) = delete;
 
@@ -17,6 +17,8 @@ namespace nCine
 	AudioBufferPlayer::~AudioBufferPlayer()
 	{
 		stop();
+		// Final release, the source must not outlive the player even if the state got out of sync with it
+		theServiceLocator().GetAudioDevice().unregisterPlayer(this);
 	}
 
 	std::uint32_t AudioBufferPlayer::bufferId() const
@@ -63,8 +65,6 @@ namespace nCine
 
 	void AudioBufferPlayer::play()
 	{
-		IAudioDevice& device = theServiceLocator().GetAudioDevice();
-
 		switch (_state) {
 			case PlayerState::Initial:
 			case PlayerState::Stopped: {
@@ -72,38 +72,22 @@ namespace nCine
 					break;
 				}
 
-				const unsigned int source = device.registerPlayer(this);
-				if (source == IAudioDevice::UnavailableSource) {
+				if (!startSource()) {
+					IAudioDevice& device = theServiceLocator().GetAudioDevice();
 					if (device.isValid()) {
 						LOGW("No more available audio sources for playing");
 					}
 					break;
 				}
-				_sourceId = source;
-
-				device.setSourceBuffer(_sourceId, _audioBuffer->bufferId());
-				// Setting source looping only if not streaming
-				device.setSourceLooping(_sourceId, GetFlags(PlayerFlags::Looping));
-
-				device.setSourceGain(_sourceId, _gain);
-				device.setSourcePitch(_sourceId, _pitch);
-
-				updateFilters();
-
-				bool isSourceRelative = GetFlags(PlayerFlags::SourceRelative);
-				bool isAs2D = GetFlags(PlayerFlags::As2D);
-
-				device.setSourceRelative(_sourceId, isSourceRelative || isAs2D);
-				setPositionInternal(getAdjustedPosition(device, _position, isSourceRelative, isAs2D));
-
-				device.playSource(_sourceId);
 				_state = PlayerState::Playing;
 				break;
 			}
 			case PlayerState::Paused: {
-				updateFilters();
-
-				device.playSource(_sourceId);
+				// A player paused while virtual has no source to resume, it becomes virtual again
+				if (_sourceId != IAudioDevice::UnavailableSource) {
+					updateFilters();
+					theServiceLocator().GetAudioDevice().playSource(_sourceId);
+				}
 				_state = PlayerState::Playing;
 				break;
 			}
@@ -114,7 +98,9 @@ namespace nCine
 	{
 		switch (_state) {
 			case PlayerState::Playing: {
-				theServiceLocator().GetAudioDevice().pauseSource(_sourceId);
+				if (_sourceId != IAudioDevice::UnavailableSource) {
+					theServiceLocator().GetAudioDevice().pauseSource(_sourceId);
+				}
 				_state = PlayerState::Paused;
 				break;
 			}
@@ -123,21 +109,53 @@ namespace nCine
 
 	void AudioBufferPlayer::stop()
 	{
-		IAudioDevice& device = theServiceLocator().GetAudioDevice();
-
 		switch (_state) {
 			case PlayerState::Playing:
 			case PlayerState::Paused: {
-				device.stopSource(_sourceId);
-				// Detach the buffer from source
-				device.setSourceBuffer(_sourceId, 0);
-				device.setSourceLowPass(_sourceId, 1.0f);
+				// A virtual player holds no source, there is nothing to give back to the device
+				if (_sourceId != IAudioDevice::UnavailableSource) {
+					releaseSource();
+				}
 				_state = PlayerState::Stopped;
 				break;
 			}
 		}
+	}
 
-		device.unregisterPlayer(this);
+	void AudioBufferPlayer::playVirtual()
+	{
+		switch (_state) {
+			case PlayerState::Initial:
+			case PlayerState::Stopped: {
+				if (_audioBuffer != nullptr) {
+					_state = PlayerState::Playing;
+				}
+				break;
+			}
+		}
+	}
+
+	std::int32_t AudioBufferPlayer::virtualize()
+	{
+		if (_state != PlayerState::Playing || _sourceId == IAudioDevice::UnavailableSource) {
+			return 0;
+		}
+
+		std::int32_t offset = theServiceLocator().GetAudioDevice().sourceSampleOffset(_sourceId);
+		releaseSource();
+		return offset;
+	}
+
+	bool AudioBufferPlayer::devirtualize(std::int32_t sampleOffset)
+	{
+		if (!isVirtual() || !startSource()) {
+			return false;
+		}
+
+		if (sampleOffset > 0) {
+			theServiceLocator().GetAudioDevice().setSourceSampleOffset(_sourceId, sampleOffset);
+		}
+		return true;
 	}
 
 	void AudioBufferPlayer::setLooping(bool value)
@@ -165,4 +183,43 @@ namespace nCine
 			}
 		}
 	}
+
+	bool AudioBufferPlayer::startSource()
+	{
+		IAudioDevice& device = theServiceLocator().GetAudioDevice();
+
+		const unsigned int source = device.registerPlayer(this);
+		if (source == IAudioDevice::UnavailableSource) {
+			return false;
+		}
+		_sourceId = source;
+
+		device.setSourceBuffer(_sourceId, _audioBuffer->bufferId());
+		// Setting source looping only if not streaming
+		device.setSourceLooping(_sourceId, GetFlags(PlayerFlags::Looping));
+
+		device.setSourceGain(_sourceId, _gain);
+		device.setSourcePitch(_sourceId, _pitch);
+
+		updateFilters();
+
+		bool isSourceRelative = GetFlags(PlayerFlags::SourceRelative);
+		bool isAs2D = GetFlags(PlayerFlags::As2D);
+
+		device.setSourceRelative(_sourceId, isSourceRelative || isAs2D);
+		setPositionInternal(getAdjustedPosition(device, _position, isSourceRelative, isAs2D));
+
+		device.playSource(_sourceId);
+		return true;
+	}
+
+	void AudioBufferPlayer::releaseSource()
+	{
+		IAudioDevice& device = theServiceLocator().GetAudioDevice();
+		device.stopSource(_sourceId);
+		// Detach the buffer from source
+		device.setSourceBuffer(_sourceId, 0);
+		device.setSourceLowPass(_sourceId, 1.0f);
+		device.unregisterPlayer(this);
+	}
 }
@@ -11,6 +11,11 @@ namespace nCine
 		
 		Suitable for short sound effects that are decoded into memory ahead of time. The same
 		buffer can be shared between several players.
+
+		A player can also be @e virtual --- playing from the caller's point of view, but without an audio
+		source of the device assigned. This lets a voice manager keep more sounds alive than the device has
+		sources for, and move the sources between them as their audibility changes. While virtual, the
+		player doesn't advance on its own, the caller keeps track of the playback position.
 	*/
 	class AudioBufferPlayer : public IAudioPlayer
 	{
@@ -49,6 +54,25 @@ namespace nCine
 		void pause() override;
 		void stop() override;
 
+		/** @brief Returns `true` if the player is playing without an audio source assigned */
+		inline bool isVirtual() const {
+			return (_state == PlayerState::Playing && _sourceId == IAudioDevice::UnavailableSource);
+		}
+		/** @brief Starts playback without acquiring an audio source */
+		void playVirtual();
+		/**
+		 * @brief Releases the audio source of a playing player, but keeps it in playing state
+		 *
+		 * @return Playback position in samples at the time the source was released
+		 */
+		std::int32_t virtualize();
+		/**
+		 * @brief Acquires an audio source for a virtual player and continues playback from the specified position
+		 *
+		 * @return `true` if an audio source was available, otherwise the player stays virtual
+		 */
+		bool devirtualize(std::int32_t sampleOffset);
+
 		void setLooping(bool value) override;
 
 		void updateState() override;
@@ -60,5 +84,8 @@ namespace nCine
 
 	private:
 		AudioBuffer* _audioBuffer;
+
+		bool startSource();
+		void releaseSource();
 	};
 }
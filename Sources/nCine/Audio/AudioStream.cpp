@@ -213,8 +213,26 @@ namespace nCine
 		return false;
 	}
 
+	bool AudioStream::loadFromReader(IAudioLoader& audioLoader, std::unique_ptr<IAudioReader> audioReader)
+	{
+#if defined(WITH_AUDIO)
+		if (audioLoader.hasLoaded() && audioReader != nullptr) {
+			createReader(audioLoader, std::move(audioReader));
+			return true;
+		}
+#endif
+		return false;
+	}
+
 	void AudioStream::createReader(IAudioLoader& audioLoader)
 	{
+#if defined(WITH_AUDIO)
+		createReader(audioLoader, audioLoader.createReader());
+#endif
+	}
+
+	void AudioStream::createReader(IAudioLoader& audioLoader, std::unique_ptr<IAudioReader> audioReader)
+	{
 #if defined(WITH_AUDIO)
 		// The old reader can't be replaced while the decoding thread is still using it
 		if (_decodeRequest == nullptr) {
@@ -245,7 +263,7 @@ namespace nCine
 		_numSamples = audioLoader.numSamples();
 		_duration = (_numSamples == UINT32_MAX ? -1.0f : float(_numSamples) / _frequency);
 
-		_audioReader = audioLoader.createReader();
+		_audioReader = std::move(audioReader);
 		_decodeRequest->reader = _audioReader;
 		_audioReader->setLooping(_isLooping);
 #endif
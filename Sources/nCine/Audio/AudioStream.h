@@ -139,8 +139,10 @@ namespace nCine
 		AudioStream& operator=(const AudioStream&) = delete;
 
 		bool loadFromFile(StringView filename);
+		bool loadFromReader(IAudioLoader& audioLoader, std::unique_ptr<IAudioReader> audioReader);
 
 		void createReader(IAudioLoader& audioLoader);
+		void createReader(IAudioLoader& audioLoader, std::unique_ptr<IAudioReader> audioReader);
 
 	};
 }
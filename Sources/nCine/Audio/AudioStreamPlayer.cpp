@@ -1,4 +1,6 @@
 #include "AudioStreamPlayer.h"
+#include "IAudioLoader.h"
+#include "IAudioReader.h"
 #include "../ServiceLocator.h"
 
 namespace nCine
@@ -27,6 +29,15 @@ namespace nCine
 		return _audioStream.loadFromFile(filename);
 	}
 
+	bool AudioStreamPlayer::loadFromReader(IAudioLoader& audioLoader, std::unique_ptr<IAudioReader> audioReader)
+	{
+		if (_state != PlayerState::Stopped) {
+			_audioStream.stop(_sourceId);
+		}
+
+		return _audioStream.loadFromReader(audioLoader, std::move(audioReader));
+	}
+
 	void AudioStreamPlayer::play()
 	{
 		IAudioDevice& device = theServiceLocator().GetAudioDevice();
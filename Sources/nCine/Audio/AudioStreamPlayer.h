@@ -28,6 +28,13 @@ namespace nCine
 
 		/** @brief Loads the stream from the specified file */
 		bool loadFromFile(const char* filename);
+		/**
+		 * @brief Loads the stream from a reader created by the specified loader
+		 *
+		 * Opening the file and creating the reader can take a while for some formats, but doesn't touch the
+		 * audio device, so it can be done on a worker thread and only this call is left for the main thread.
+		 */
+		bool loadFromReader(IAudioLoader& audioLoader, std::unique_ptr<IAudioReader> audioReader);
 
 		inline std::uint32_t bufferId() const override {
 			return _audioStream.bufferId();
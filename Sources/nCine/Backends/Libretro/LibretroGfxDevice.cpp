@@ -135,7 +135,7 @@ namespace nCine::Backends
 		if (!LibretroApplication::IsInsideFrame) {
 			return;
 		}
-		const auto fb = RHI::Device::GetScreenFramebuffer();
+		const auto fb = RHI::Device::GetPresentFramebuffer();
 		if (fb.pixels == nullptr || fb.width <= 0 || fb.height <= 0) {
 			LibretroApplication::VideoRefreshCallback(nullptr, _lastWidth, _lastHeight, _lastWidth * 4);
 			return;
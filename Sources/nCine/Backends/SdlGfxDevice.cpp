@@ -739,6 +739,19 @@ namespace nCine::Backends
 	}
 
 	void SdlGfxDevice::resizeSoftwareTarget(int width, int height)
+	{
+		if (width <= 0 || height <= 0 || _softwareRenderer == nullptr) {
+			return;
+		}
+		if (_softwareTexture != nullptr && width == _softwareTextureWidth && height == _softwareTextureHeight) {
+			return;
+		}
+		resizeSoftwareTexture(width, height);
+		// Give the root screen viewport a CPU framebuffer of the same size to render into
+		RHI::Device::ResizeScreenFramebuffer(width, height);
+	}
+
+	void SdlGfxDevice::resizeSoftwareTexture(int width, int height)
 	{
 		if (width <= 0 || height <= 0 || _softwareRenderer == nullptr) {
 			return;
@@ -763,8 +776,6 @@ namespace nCine::Backends
 		FATAL_ASSERT_MSG(_softwareTexture, "SDL_CreateTexture failed: {}", SDL_GetError());
 		_softwareTextureWidth = width;
 		_softwareTextureHeight = height;
-		// Give the root screen viewport a CPU framebuffer of the same size to render into
-		RHI::Device::ResizeScreenFramebuffer(width, height);
 	}
 
 	void SdlGfxDevice::presentSoftware()
@@ -776,15 +787,16 @@ namespace nCine::Backends
 		RHI::Device::FlushSoftwareRenderer();
 		// All of this frame's Combine draws have run by now, so any lighting entries still queued are leftovers
 		RHI::Device::EndFrame();
-		const auto fb = RHI::Device::GetScreenFramebuffer();
+		// The screen framebuffer with the rescale filter applied, if any, so it can be larger than the framebuffer
+		const auto fb = RHI::Device::GetPresentFramebuffer();
 		// The render pipeline sizes the screen framebuffer to the internal/logical resolution (see
 		// UpscaleRenderPass, which resizes it on the software backend); keep the streaming texture matched to
-		// that size so SDL_RenderCopyEx below stretches the low-resolution image up to the window. The window
-		// (drawable) size no longer drives the framebuffer size — this is what makes the software renderer draw
-		// the scene at the cheap internal resolution instead of the full window resolution.
+		// the presented size so SDL_RenderCopyEx below stretches the low-resolution image up to the window. The
+		// window (drawable) size no longer drives the framebuffer size — this is what makes the software renderer
+		// draw the scene at the cheap internal resolution instead of the full window resolution.
 		if (fb.pixels != nullptr && fb.width > 0 && fb.height > 0 &&
 			(fb.width != _softwareTextureWidth || fb.height != _softwareTextureHeight)) {
-			resizeSoftwareTarget(fb.width, fb.height);
+			resizeSoftwareTexture(fb.width, fb.height);
 		}
 		if (_softwareTexture == nullptr) {
 			return;
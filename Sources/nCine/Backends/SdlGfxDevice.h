@@ -114,15 +114,17 @@ namespace nCine::Backends
 		SDL_Renderer* _softwareRenderer = nullptr;
 		/** @brief Streaming texture the software backend's screen framebuffer is uploaded into each frame */
 		SDL_Texture* _softwareTexture = nullptr;
-		/** @brief Current width of @ref _softwareTexture and the backend screen framebuffer */
+		/** @brief Current width of @ref _softwareTexture, i.e. of the presented surface */
 		std::int32_t _softwareTextureWidth = 0;
-		/** @brief Current height of @ref _softwareTexture and the backend screen framebuffer */
+		/** @brief Current height of @ref _softwareTexture, i.e. of the presented surface */
 		std::int32_t _softwareTextureHeight = 0;
 
 		/** @brief Creates the SDL2 renderer and the initial streaming target for the software present path */
 		void initSoftwarePresent(bool hasVSync);
 		/** @brief (Re)creates the streaming texture and resizes the backend screen framebuffer to match */
 		void resizeSoftwareTarget(int width, int height);
+		/** @brief (Re)creates only the streaming texture, e.g. for a present surface enlarged by a rescale filter */
+		void resizeSoftwareTexture(int width, int height);
 		/** @brief Uploads and blits the backend screen framebuffer to the window (replaces the GL buffer swap) */
 		void presentSoftware();
 #endif
@@ -0,0 +1,143 @@
+#include "FrameArena.h"
+#include "../../Main.h"
+
+#include <Containers/SmallVector.h>
+
+#include <memory>
+
+namespace nCine
+{
+	namespace
+	{
+		struct ArenaBlock {
+			std::unique_ptr<std::uint8_t[]> Data;
+			std::size_t Capacity;
+		};
+
+		// One arena per frame parity. Blocks are only ever appended during a frame, so pointers handed out
+		// earlier in the frame stay valid; the first block is the one bump allocations normally come from.
+		struct Arena {
+			SmallVector<ArenaBlock, 2> Blocks;
+			std::size_t Offset = 0;
+			// Bytes of the blocks already filled in this frame, not counting the current block
+			std::size_t RetiredBytes = 0;
+			std::uint8_t* LastAllocation = nullptr;
+		};
+
+		Arena _arenas[2];
+		std::int32_t _currentArena = 0;
+		std::size_t _peakBytes = 0;
+		std::uint32_t _growCount = 0;
+
+		std::size_t GetCapacity(const Arena& arena)
+		{
+			std::size_t capacity = 0;
+			for (const ArenaBlock& block : arena.Blocks) {
+				capacity += block.Capacity;
+			}
+			return capacity;
+		}
+
+		void AddBlock(Arena& arena, std::size_t capacity)
+		{
+			if (!arena.Blocks.empty()) {
+				arena.RetiredBytes += arena.Offset;
+			}
+			arena.Blocks.push_back({ std::make_unique<std::uint8_t[]>(capacity), capacity });
+			arena.Offset = 0;
+		}
+	}
+
+	void* FrameArena::Allocate(std::size_t size, std::size_t alignment)
+	{
+		DEATH_DEBUG_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0, "Alignment must be a power of two", nullptr);
+
+		Arena& arena = _arenas[_currentArena];
+		if DEATH_UNLIKELY(arena.Blocks.empty()) {
+			AddBlock(arena, DefaultCapacity);
+		}
+
+		ArenaBlock* block = &arena.Blocks.back();
+		std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block->Data.get());
+		std::size_t offset = ((base + arena.Offset + alignment - 1) & ~(std::uintptr_t)(alignment - 1)) - base;
+		if DEATH_UNLIKELY(offset + size > block->Capacity) {
+			// Chain a block large enough for this request, at least doubling the capacity so a frame that outgrew
+			// the arena doesn't chain a new block for every following allocation
+			std::size_t capacity = std::max(GetCapacity(arena), size + alignment);
+			AddBlock(arena, capacity);
+			_growCount++;
+
+			block = &arena.Blocks.back();
+			base = reinterpret_cast<std::uintptr_t>(block->Data.get());
+			offset = ((base + alignment - 1) & ~(std::uintptr_t)(alignment - 1)) - base;
+		}
+
+		arena.Offset = offset + size;
+		arena.LastAllocation = block->Data.get() + offset;
+		return arena.LastAllocation;
+	}
+
+	void FrameArena::Shrink(void* ptr, std::size_t size, std::size_t newSize)
+	{
+		DEATH_DEBUG_ASSERT(newSize <= size, "New size must not be larger than the allocated size", );
+
+		Arena& arena = _arenas[_currentArena];
+		if (ptr != nullptr && ptr == arena.LastAllocation) {
+			arena.Offset -= (size - newSize);
+		}
+	}
+
+	void FrameArena::OnFrameEnd()
+	{
+		Arena& finished = _arenas[_currentArena];
+		std::size_t usedBytes = finished.RetiredBytes + finished.Offset;
+		if (_peakBytes < usedBytes) {
+			_peakBytes = usedBytes;
+#if defined(DEATH_DEBUG)
+			if (finished.Blocks.size() > 1) {
+				LOGD("Frame arena grew to {} blocks, new high-water mark is {} bytes", finished.Blocks.size(), usedBytes);
+			}
+#endif
+		}
+
+		// Switch to the other arena, which was last used in the previous frame, so everything allocated in the
+		// frame that just ended stays valid for one more frame
+		_currentArena ^= 1;
+		Arena& next = _arenas[_currentArena];
+		if (next.Blocks.size() > 1) {
+			// Merge the chained blocks into one, so the arena doesn't have to grow again in the following frames
+			std::size_t capacity = GetCapacity(next);
+			next.Blocks.clear();
+			AddBlock(next, capacity);
+		}
+		next.Offset = 0;
+		next.RetiredBytes = 0;
+		next.LastAllocation = nullptr;
+	}
+
+	void FrameArena::Dispose()
+	{
+#if defined(DEATH_DEBUG)
+		if (_peakBytes > 0) {
+			LOGD("Frame arena high-water mark was {} bytes, grown {} times", _peakBytes, _growCount);
+		}
+#endif
+		for (Arena& arena : _arenas) {
+			arena.Blocks.clear();
+			arena.Offset = 0;
+			arena.RetiredBytes = 0;
+			arena.LastAllocation = nullptr;
+		}
+	}
+
+	FrameArena::Statistics FrameArena::GetStatistics()
+	{
+		const Arena& arena = _arenas[_currentArena];
+		Statistics stats;
+		stats.UsedBytes = arena.RetiredBytes + arena.Offset;
+		stats.PeakBytes = _peakBytes;
+		stats.CapacityBytes = GetCapacity(_arenas[0]) + GetCapacity(_arenas[1]);
+		stats.GrowCount = _growCount;
+		return stats;
+	}
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <Common.h>
+#include <Containers/ArrayView.h>
+
+#include <cstddef>
+#include <type_traits>
+
+using namespace Death::Containers;
+
+namespace nCine
+{
+	/**
+		@brief Frame-scoped linear allocator for transient scratch memory
+
+		Hands out memory by bumping an offset in a pre-allocated block, so building a vertex stream or a network
+		packet every frame doesn't touch the general-purpose heap (or contend on its locks with worker threads).
+		Nothing is freed individually, the whole arena is reset once per frame by the application. There are two
+		arenas used in alternating frames and a reset only clears the older one, so an allocation stays valid
+		until the end of the @e next frame, long enough for a render queue that references host memory to be
+		flushed and consumed by a deferred rasterizer.
+
+		When a frame needs more than the current capacity, additional blocks are chained and merged into a single
+		block of the combined size at the next reset, so the steady state runs from one block without allocating.
+		Only trivially destructible types can be placed in the arena, as no destructors are ever called. The arena
+		must be used from the main thread only.
+	*/
+	class FrameArena
+	{
+	public:
+		/** @brief Initial capacity of each of the two arenas */
+		static constexpr std::size_t DefaultCapacity = 256 * 1024;
+
+		/** @brief Memory usage statistics */
+		struct Statistics {
+			/** @brief Bytes allocated in the current frame so far */
+			std::size_t UsedBytes;
+			/** @brief Highest number of bytes allocated in a single frame */
+			std::size_t PeakBytes;
+			/** @brief Bytes reserved by both arenas */
+			std::size_t CapacityBytes;
+			/** @brief Number of times an arena had to chain another block */
+			std::uint32_t GrowCount;
+		};
+
+		FrameArena() = delete;
+		~FrameArena() = delete;
+
+		/** @brief Allocates uninitialized memory that stays valid until the end of the next frame */
+		static void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+		/** @brief Allocates an uninitialized array of @p count items */
+		template<class T>
+		static ArrayView<T> AllocateArray(std::size_t count) {
+			static_assert(std::is_trivially_destructible<T>::value, "Only trivially destructible types can be allocated in the frame arena");
+			return { static_cast<T*>(Allocate(count * sizeof(T), alignof(T))), count };
+		}
+
+		/**
+			@brief Gives back the unused tail of the most recent allocation
+
+			Lets a caller allocate for the worst case and keep only what it actually filled. Has no effect if
+			@p ptr isn't the most recent allocation of the current frame.
+		*/
+		static void Shrink(void* ptr, std::size_t size, std::size_t newSize);
+
+		/** @overload */
+		template<class T>
+		static ArrayView<T> Shrink(ArrayView<T> array, std::size_t newCount) {
+			Shrink(array.data(), array.size() * sizeof(T), newCount * sizeof(T));
+			return array.prefix(newCount);
+		}
+
+		/** @brief Called by the application at the end of each frame, releases the allocations of the previous frame */
+		static void OnFrameEnd();
+
+		/** @brief Releases all memory of both arenas */
+		static void Dispose();
+
+		/** @brief Returns memory usage statistics */
+		static Statistics GetStatistics();
+	};
+}
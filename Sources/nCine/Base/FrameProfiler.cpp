@@ -0,0 +1,422 @@
+#include "FrameProfiler.h"
+
+#if defined(WITH_FRAME_PROFILER)
+
+#include "../../Main.h"
+#include "Clock.h"
+#include "TimeStamp.h"
+#include "../Threading/ThreadSync.h"
+
+#include <Base/Format.h>
+#include <Containers/SmallVector.h>
+#include <Containers/String.h>
+#include <IO/FileSystem.h>
+#include <Threading/Spinlock.h>
+
+#include <cstring>
+#include <memory>
+
+#if defined(DEATH_TARGET_X86) && !defined(DEATH_TARGET_EMSCRIPTEN)
+#	if defined(DEATH_TARGET_MSVC)
+#		include <intrin.h>
+#	else
+#		include <x86intrin.h>
+#	endif
+#elif defined(DEATH_TARGET_MSVC) && defined(_M_ARM64)
+#	include <intrin.h>
+#endif
+
+using namespace Death;
+using namespace Death::Containers::Literals;
+using namespace Death::IO;
+
+namespace nCine
+{
+	namespace
+	{
+		static_assert((FrameProfiler::EventsPerThread & (FrameProfiler::EventsPerThread - 1)) == 0, "EventsPerThread must be a power of two");
+
+		constexpr std::uint32_t MaxThreadNameLength = 64;
+
+		struct ZoneEvent {
+			const FrameProfiler::SourceLocation* Location;
+			std::uint64_t Begin;
+			std::uint64_t End;
+		};
+
+		// Ring buffer of one thread. Only the owning thread writes, a dump copies it out while holding the lock,
+		// which the owner otherwise takes uncontended for each zone. A buffer outlives its thread and is handed
+		// over to the next new thread, threads like the network one come and go per session.
+		struct ThreadBuffer {
+			ZoneEvent Events[FrameProfiler::EventsPerThread];
+			Death::Threading::Spinlock Lock;
+			std::atomic<std::uint64_t> WriteIndex{0};
+			std::atomic<bool> InUse{false};
+			char Name[MaxThreadNameLength];
+			std::uint32_t Id;
+		};
+
+		struct ThreadBufferOwner {
+			ThreadBuffer* Buffer = nullptr;
+			char Name[MaxThreadNameLength] = {};
+
+			~ThreadBufferOwner() {
+				if (Buffer != nullptr) {
+					Buffer->InUse.store(false, std::memory_order_release);
+				}
+			}
+		};
+
+		thread_local ThreadBufferOwner t_owner;
+
+		Mutex g_registryMutex;
+		SmallVector<std::unique_ptr<ThreadBuffer>, 0> g_threadBuffers;
+
+		// Written only while recording is being switched on, read by dumps
+		std::uint64_t g_startTicks = 0;
+		TimeStamp g_startTime;
+
+		String g_outputDirectory;
+		FrameProfiler::DumpFormat g_dumpFormat = FrameProfiler::DumpFormat::ChromeTrace;
+		float g_slowFrameThreshold = 0.0f;
+		float g_slowFrameCooldown = 30.0f;
+		TimeStamp g_lastAutomaticDump;
+		bool g_hasAutomaticDump = false;
+		std::atomic<bool> g_dumpRequested{false};
+		std::uint32_t g_dumpCounter = 0;
+
+		ThreadBuffer* AcquireThreadBuffer()
+		{
+			g_registryMutex.Lock();
+
+			ThreadBuffer* buffer = nullptr;
+			for (auto& candidate : g_threadBuffers) {
+				bool expected = false;
+				if (candidate->InUse.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+					buffer = candidate.get();
+					break;
+				}
+			}
+			if (buffer == nullptr) {
+				// Huge, so it's allocated only once the thread records its first zone
+				auto& newBuffer = g_threadBuffers.emplace_back(std::make_unique<ThreadBuffer>());
+				buffer = newBuffer.get();
+				buffer->Id = (std::uint32_t)g_threadBuffers.size();
+				buffer->InUse.store(true, std::memory_order_relaxed);
+			}
+
+			// The zones of the previous owner would be attributed to this thread otherwise
+			buffer->Lock.lock();
+			buffer->WriteIndex.store(0, std::memory_order_relaxed);
+			buffer->Lock.unlock();
+			if (t_owner.Name[0] != '\0') {
+				std::memcpy(buffer->Name, t_owner.Name, sizeof(buffer->Name));
+			} else {
+				formatInto(buffer->Name, "Thread {}", buffer->Id);
+			}
+
+			g_registryMutex.Unlock();
+
+			t_owner.Buffer = buffer;
+			return buffer;
+		}
+
+		struct ThreadSnapshot {
+			String Name;
+			std::uint32_t Id;
+			SmallVector<ZoneEvent, 0> Events;
+		};
+
+		SmallVector<ThreadSnapshot, 0> TakeSnapshot()
+		{
+			SmallVector<ThreadSnapshot, 0> snapshots;
+
+			g_registryMutex.Lock();
+			for (auto& buffer : g_threadBuffers) {
+				// Allocated before taking the lock, the owner waits for the copy only
+				auto& snapshot = snapshots.emplace_back();
+				snapshot.Name = buffer->Name;
+				snapshot.Id = buffer->Id;
+				snapshot.Events.reserve(FrameProfiler::EventsPerThread);
+
+				buffer->Lock.lock();
+				std::uint64_t writeIndex = buffer->WriteIndex.load(std::memory_order_relaxed);
+				std::uint64_t first = (writeIndex > FrameProfiler::EventsPerThread ? writeIndex - FrameProfiler::EventsPerThread : 0);
+				for (std::uint64_t i = first; i < writeIndex; i++) {
+					snapshot.Events.push_back(buffer->Events[i & (FrameProfiler::EventsPerThread - 1)]);
+				}
+				buffer->Lock.unlock();
+
+				if (snapshot.Events.empty()) {
+					snapshots.pop_back();
+					continue;
+				}
+
+				// Zones recorded before the last time recording was switched on belong to an older session
+				std::size_t j = 0;
+				for (std::size_t i = 0; i < snapshot.Events.size(); i++) {
+					if (snapshot.Events[i].Begin >= g_startTicks && snapshot.Events[i].End >= snapshot.Events[i].Begin) {
+						snapshot.Events[j++] = snapshot.Events[i];
+					}
+				}
+				snapshot.Events.resize(j);
+			}
+			g_registryMutex.Unlock();
+
+			return snapshots;
+		}
+
+		double GetTicksPerMicrosecond()
+		{
+			double elapsedMicroseconds = (double)g_startTime.timeSince().ticks() * 1000000.0 / (double)clock().frequency();
+			std::uint64_t elapsedTicks = FrameProfiler::Now() - g_startTicks;
+			if (elapsedMicroseconds < 1000.0 || elapsedTicks == 0) {
+				// Too short to calibrate against the system clock, the profiler ticks are the clock's own then
+				return (double)clock().frequency() / 1000000.0;
+			}
+			return (double)elapsedTicks / elapsedMicroseconds;
+		}
+
+		void WriteString(Stream& s, StringView value)
+		{
+			s.Write(value.data(), (std::int64_t)value.size());
+		}
+
+		void WriteJsonString(Stream& s, const char* value)
+		{
+			char buffer[256];
+			std::size_t length = 0;
+			buffer[length++] = '"';
+			for (; *value != '\0' && length < sizeof(buffer) - 3; value++) {
+				char c = *value;
+				if (c == '"' || c == '\\') {
+					buffer[length++] = '\\';
+					buffer[length++] = c;
+				} else if ((unsigned char)c >= 0x20) {
+					buffer[length++] = c;
+				}
+			}
+			buffer[length++] = '"';
+			s.Write(buffer, (std::int64_t)length);
+		}
+
+		void WriteBinaryString(Stream& s, const char* value)
+		{
+			std::size_t length = (value != nullptr ? std::min(std::strlen(value), (std::size_t)UINT16_MAX) : 0);
+			s.WriteValueAsLE<std::uint16_t>((std::uint16_t)length);
+			s.Write(value, (std::int64_t)length);
+		}
+
+		const char* GetZoneName(const FrameProfiler::SourceLocation* location)
+		{
+			return (location->Name != nullptr ? location->Name : location->Function);
+		}
+
+		void WriteChromeTrace(Stream& s, ArrayView<const ThreadSnapshot> snapshots, double ticksPerMicrosecond)
+		{
+			char buffer[160];
+
+			WriteString(s, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"_s);
+			bool first = true;
+			for (const auto& snapshot : snapshots) {
+				std::size_t length = formatInto(buffer, "{}{{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":",
+					first ? "" : ",\n", snapshot.Id);
+				first = false;
+				s.Write(buffer, (std::int64_t)length);
+				WriteJsonString(s, snapshot.Name.data());
+				WriteString(s, "}}"_s);
+
+				for (const auto& e : snapshot.Events) {
+					double ts = (double)(e.Begin - g_startTicks) / ticksPerMicrosecond;
+					double dur = (double)(e.End - e.Begin) / ticksPerMicrosecond;
+					WriteString(s, ",\n{\"ph\":\"X\",\"name\":"_s);
+					WriteJsonString(s, GetZoneName(e.Location));
+					length = formatInto(buffer, ",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}", snapshot.Id, ts, dur);
+					s.Write(buffer, (std::int64_t)length);
+					if (e.Location->Color != 0) {
+						// Not part of the format, but kept for tools that know how to use it
+						length = formatInto(buffer, ",\"args\":{{\"color\":\"#{:.6x}\"}}", e.Location->Color);
+						s.Write(buffer, (std::int64_t)length);
+					}
+					WriteString(s, "}"_s);
+				}
+			}
+			WriteString(s, "\n]}\n"_s);
+		}
+
+		void WriteBinary(Stream& s, ArrayView<const ThreadSnapshot> snapshots, double ticksPerMicrosecond)
+		{
+			static const char Signature[8] = { 'J', '2', 'P', 'R', 'O', 'F', '\0', '\1' };
+			s.Write(Signature, sizeof(Signature));
+			std::uint64_t ticksPerMicrosecondBits;
+			std::memcpy(&ticksPerMicrosecondBits, &ticksPerMicrosecond, sizeof(ticksPerMicrosecondBits));
+			s.WriteValueAsLE<std::uint64_t>(ticksPerMicrosecondBits);
+
+			// Locations are referenced by index, in order of first appearance
+			SmallVector<const FrameProfiler::SourceLocation*, 0> locations;
+			auto indexOf = [&locations](const FrameProfiler::SourceLocation* location) -> std::uint32_t {
+				for (std::size_t i = locations.size(); i > 0; i--) {
+					if (locations[i - 1] == location) {
+						return (std::uint32_t)(i - 1);
+					}
+				}
+				locations.push_back(location);
+				return (std::uint32_t)(locations.size() - 1);
+			};
+
+			s.WriteValueAsLE<std::uint32_t>((std::uint32_t)snapshots.size());
+			for (const auto& snapshot : snapshots) {
+				WriteBinaryString(s, snapshot.Name.data());
+				s.WriteValueAsLE<std::uint32_t>((std::uint32_t)snapshot.Events.size());
+				for (const auto& e : snapshot.Events) {
+					s.WriteValueAsLE<std::uint32_t>(indexOf(e.Location));
+					s.WriteValueAsLE<std::uint64_t>(e.Begin - g_startTicks);
+					s.WriteValueAsLE<std::uint32_t>((std::uint32_t)std::min(e.End - e.Begin, (std::uint64_t)UINT32_MAX));
+				}
+			}
+
+			s.WriteValueAsLE<std::uint32_t>((std::uint32_t)locations.size());
+			for (const auto* location : locations) {
+				WriteBinaryString(s, GetZoneName(location));
+				WriteBinaryString(s, location->Function);
+				WriteBinaryString(s, location->File);
+				s.WriteValueAsLE<std::uint32_t>(location->Line);
+				s.WriteValueAsLE<std::uint32_t>(location->Color);
+			}
+		}
+
+		void DumpToOutputDirectory(const char* reason)
+		{
+			char fileName[64];
+			std::size_t length = formatInto(fileName, "Profile_{}_{}.{}", reason, ++g_dumpCounter,
+				g_dumpFormat == FrameProfiler::DumpFormat::ChromeTrace ? "json" : "bin");
+			String path = (g_outputDirectory.empty() ? String(StringView(fileName, length))
+				: fs::CombinePath(g_outputDirectory, StringView(fileName, length)));
+			if (FrameProfiler::Dump(path, g_dumpFormat)) {
+				LOGI("Frame profile saved to \"{}\"", path);
+			} else {
+				LOGW("Failed to save frame profile to \"{}\"", path);
+			}
+		}
+	}
+
+	std::atomic<bool> FrameProfiler::_enabled{false};
+
+	void FrameProfiler::SetEnabled(bool value)
+	{
+		if (value && !_enabled.load(std::memory_order_relaxed)) {
+			g_startTime = TimeStamp::now();
+			g_startTicks = Now();
+		}
+		_enabled.store(value, std::memory_order_relaxed);
+	}
+
+	void FrameProfiler::SetOutputDirectory(StringView path)
+	{
+		g_outputDirectory = path;
+	}
+
+	void FrameProfiler::SetSlowFrameThreshold(float milliseconds, float cooldownSeconds)
+	{
+		g_slowFrameThreshold = milliseconds;
+		g_slowFrameCooldown = cooldownSeconds;
+	}
+
+	void FrameProfiler::SetDumpFormat(DumpFormat format)
+	{
+		g_dumpFormat = format;
+	}
+
+	void FrameProfiler::RequestDump()
+	{
+		g_dumpRequested.store(true, std::memory_order_relaxed);
+	}
+
+	bool FrameProfiler::Dump(StringView path, DumpFormat format)
+	{
+		if (g_startTicks == 0) {
+			// Never enabled, nothing to write
+			return false;
+		}
+
+		double ticksPerMicrosecond = GetTicksPerMicrosecond();
+		auto snapshots = TakeSnapshot();
+
+		auto s = fs::Open(path, FileAccess::Write);
+		if (!s->IsValid()) {
+			return false;
+		}
+
+		if (format == DumpFormat::Binary) {
+			WriteBinary(*s, snapshots, ticksPerMicrosecond);
+		} else {
+			WriteChromeTrace(*s, snapshots, ticksPerMicrosecond);
+		}
+		return true;
+	}
+
+	void FrameProfiler::SetCurrentThreadName(const char* name)
+	{
+		std::size_t length = std::min(std::strlen(name), sizeof(t_owner.Name) - 1);
+		std::memcpy(t_owner.Name, name, length);
+		t_owner.Name[length] = '\0';
+
+		if (t_owner.Buffer != nullptr) {
+			g_registryMutex.Lock();
+			std::memcpy(t_owner.Buffer->Name, t_owner.Name, sizeof(t_owner.Name));
+			g_registryMutex.Unlock();
+		}
+	}
+
+	void FrameProfiler::OnFrameEnd(float frameDurationSeconds)
+	{
+		if (!IsEnabled()) {
+			return;
+		}
+
+		if (g_dumpRequested.exchange(false, std::memory_order_relaxed)) {
+			DumpToOutputDirectory("Requested");
+		} else if (g_slowFrameThreshold > 0.0f && frameDurationSeconds * 1000.0f > g_slowFrameThreshold &&
+			(!g_hasAutomaticDump || g_lastAutomaticDump.secondsSince() >= g_slowFrameCooldown)) {
+			g_hasAutomaticDump = true;
+			g_lastAutomaticDump = TimeStamp::now();
+			DumpToOutputDirectory("SlowFrame");
+		}
+	}
+
+	std::uint64_t FrameProfiler::Now()
+	{
+#if defined(DEATH_TARGET_X86) && !defined(DEATH_TARGET_EMSCRIPTEN)
+		// Same counter as the asynchronous logger uses, invariant on every CPU the game still supports
+		return __rdtsc();
+#elif defined(DEATH_TARGET_MSVC) && defined(_M_ARM64)
+		// The same virtual counter as below, MSVC has no inline assembly on ARM64
+		return (std::uint64_t)_ReadStatusReg(ARM64_CNTVCT);
+#elif defined(__aarch64__)
+		std::uint64_t virtualTimerValue;
+		__asm__ volatile("mrs %0, cntvct_el0" : "=r"(virtualTimerValue));
+		return virtualTimerValue;
+#else
+		return clock().now();
+#endif
+	}
+
+	void FrameProfiler::Record(const SourceLocation* location, std::uint64_t begin, std::uint64_t end)
+	{
+		ThreadBuffer* buffer = t_owner.Buffer;
+		if DEATH_UNLIKELY(buffer == nullptr) {
+			buffer = AcquireThreadBuffer();
+		}
+
+		buffer->Lock.lock();
+		std::uint64_t writeIndex = buffer->WriteIndex.load(std::memory_order_relaxed);
+		ZoneEvent& e = buffer->Events[writeIndex & (EventsPerThread - 1)];
+		e.Location = location;
+		e.Begin = begin;
+		e.End = end;
+		buffer->WriteIndex.store(writeIndex + 1, std::memory_order_relaxed);
+		buffer->Lock.unlock();
+	}
+}
+
+#endif
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <Common.h>
+#include <Containers/StringView.h>
+
+#include <atomic>
+
+using namespace Death::Containers;
+
+namespace nCine
+{
+	/**
+		@brief Lightweight always-available frame profiler
+
+		Records the existing `ZoneScoped*` instrumentation sites into a fixed-size ring buffer per thread when
+		the engine is built without Tracy. Recording is off by default and toggled at runtime, so a disabled
+		zone costs one relaxed atomic load. The collected zones of all threads (including the tile rasterizer
+		workers and the network thread) can be written as a Chrome trace (`chrome://tracing`, Perfetto) or in
+		a compact binary form, either on demand or automatically once a frame exceeds a configured duration.
+	*/
+	class FrameProfiler
+	{
+	public:
+		/** @brief Output format of @ref Dump() */
+		enum class DumpFormat {
+			ChromeTrace,		/**< Chrome trace event JSON */
+			Binary				/**< Compact binary form, see @ref Dump() */
+		};
+
+		/** @brief Static description of one instrumented zone, one instance per `ZoneScoped*` site */
+		struct SourceLocation {
+			/** @brief Explicit zone name, or `nullptr` to use the function name */
+			const char* Name;
+			/** @brief Enclosing function */
+			const char* Function;
+			/** @brief Source file */
+			const char* File;
+			/** @brief Source line */
+			std::uint32_t Line;
+			/** @brief Color in `0xRRGGBB` format, `0` if not specified */
+			std::uint32_t Color;
+		};
+
+		/** @brief Records the enclosing scope as one zone of the current thread */
+		class Zone
+		{
+		public:
+			explicit Zone(const SourceLocation* location)
+				: _location(location), _begin(IsEnabled() ? Now() : 0) {}
+
+			~Zone() {
+				if (_begin != 0) {
+					Record(_location, _begin, Now());
+				}
+			}
+
+			Zone(const Zone&) = delete;
+			Zone& operator=(const Zone&) = delete;
+
+		private:
+			const SourceLocation* _location;
+			std::uint64_t _begin;
+		};
+
+		/** @brief Number of zones each thread keeps, older zones are overwritten */
+		static constexpr std::uint32_t EventsPerThread = 16384;
+
+		FrameProfiler() = delete;
+		~FrameProfiler() = delete;
+
+		/** @brief Returns `true` if zones are being recorded */
+		static bool IsEnabled() {
+			return _enabled.load(std::memory_order_relaxed);
+		}
+		/** @brief Starts or stops recording of zones */
+		static void SetEnabled(bool value);
+
+		/** @brief Sets the directory used by automatic and requested dumps */
+		static void SetOutputDirectory(StringView path);
+		/**
+			@brief Sets the frame duration that triggers an automatic dump
+
+			A frame that takes longer than the threshold dumps the recorded zones at its end, so the slow frame
+			and the ones leading to it are in the trace. At most one automatic dump is written per
+			@p cooldownSeconds. Zero disables automatic dumps.
+		*/
+		static void SetSlowFrameThreshold(float milliseconds, float cooldownSeconds = 30.0f);
+		/** @brief Sets the format of automatic and requested dumps */
+		static void SetDumpFormat(DumpFormat format);
+		/** @brief Requests a dump at the end of the current frame */
+		static void RequestDump();
+
+		/**
+			@brief Writes all recorded zones to the given file
+
+			The binary form starts with the 8-byte signature `"J2PROF\0\1"` and the ticks per microsecond as
+			a `double`, then lists the threads (name, count, and `{ location index: u32, begin: u64,
+			duration: u32 }` per zone, ticks relative to the start of the recording) and the locations (name,
+			function, file, line, color). All strings are length-prefixed by a `u16`, all values are little-endian.
+		*/
+		static bool Dump(StringView path, DumpFormat format);
+
+		/** @brief Names the current thread in dumps */
+		static void SetCurrentThreadName(const char* name);
+
+		/** @brief Called by the application at the end of each frame */
+		static void OnFrameEnd(float frameDurationSeconds);
+
+		/** @brief Returns the current profiler timestamp in ticks */
+		static std::uint64_t Now();
+
+	private:
+		static std::atomic<bool> _enabled;
+
+		static void Record(const SourceLocation* location, std::uint64_t begin, std::uint64_t end);
+	};
+}
+
+#if !defined(DOXYGEN_GENERATING_OUTPUT)
+#	define __NCINE_PROFILER_ZONE_LOCATION(name, color) \
+		static const ::nCine::FrameProfiler::SourceLocation DEATH_PASTE(__frameProfilerLocation, __LINE__) { name, __FUNCTION__, __FILE__, (std::uint32_t)__LINE__, color }
+#	define __NCINE_PROFILER_ZONE(varname, name, color) \
+		__NCINE_PROFILER_ZONE_LOCATION(name, color); \
+		::nCine::FrameProfiler::Zone varname(&DEATH_PASTE(__frameProfilerLocation, __LINE__))
+#endif
@@ -21,6 +21,7 @@ namespace nCine
 	{
 		friend class ShaderState;
 		friend class Viewport;
+		friend class FlatSceneGraph;
 
 	public:
 		/** @{ @name Constants */
@@ -0,0 +1,472 @@
+#include "FlatSceneGraph.h"
+#include "DrawableNode.h"
+#include "../Application.h"
+#include "../ServiceLocator.h"
+#include "../tracy.h"
+#include "../../Main.h"
+
+#include <algorithm>
+
+namespace nCine
+{
+#if defined(WITH_THREADS)
+	class FlatSceneGraph::RangeCommand : public IThreadCommand
+	{
+	public:
+		RangeCommand(FlatSceneGraph* owner, Range range)
+			: _owner(owner), _range(range) {}
+
+		void Execute() override
+		{
+			_owner->ProcessRange(_range.first, _range.last);
+
+			_owner->_jobsMutex.Lock();
+			_owner->_pendingJobs--;
+			if (_owner->_pendingJobs == 0) {
+				_owner->_jobsCV.Signal();
+			}
+			_owner->_jobsMutex.Unlock();
+		}
+
+	private:
+		FlatSceneGraph* _owner;
+		Range _range;
+	};
+#endif
+
+	std::uint32_t FlatSceneGraph::_lastTransformVersion = 0;
+
+	FlatSceneGraph::FlatSceneGraph()
+		: _rootNode(nullptr), _hierarchyVersion(0), _splitIndex(0), _transformVersion(0), _pass(Pass::Update), _alpha(0.0f),
+			_arraysCurrent(false), _updateCount(0), _frameCount(0)
+#if defined(WITH_THREADS)
+			, _pendingJobs(0)
+#endif
+	{
+	}
+
+	FlatSceneGraph::~FlatSceneGraph() = default;
+
+	void FlatSceneGraph::Update(SceneNode* rootNode, float timeMult)
+	{
+		// Only the node logic runs recursively, `SceneNode::OnUpdate()` leaves the transformation to the pass below
+		SceneNode::_transformsDeferred = true;
+		rootNode->OnUpdate(timeMult);
+		SceneNode::_transformsDeferred = false;
+
+		// Nodes created or destroyed by the logic above are picked up here
+		if (rootNode != _rootNode || SceneNode::_hierarchyVersion != _hierarchyVersion) {
+			Rebuild(rootNode);
+		}
+
+		_updateCount = theApplication().GetUpdateCount();
+		RunPass(Pass::Update);
+		_transformVersion = ++_lastTransformVersion;
+	}
+
+	void FlatSceneGraph::Interpolate(SceneNode* rootNode, float alpha)
+	{
+		if (rootNode != _rootNode || SceneNode::_hierarchyVersion != _hierarchyVersion) {
+			Rebuild(rootNode);
+		}
+
+		_alpha = alpha;
+		_updateCount = theApplication().GetUpdateCount();
+		_frameCount = theApplication().GetFrameCount();
+		RunPass(Pass::Interpolate);
+		_transformVersion = ++_lastTransformVersion;
+	}
+
+	void FlatSceneGraph::UpdateCulling(SceneNode* rootNode, const Rectf& cullingRect)
+	{
+		if (!theApplication().GetRenderingSettings().cullingEnabled) {
+			return;
+		}
+
+		if (rootNode != _rootNode || SceneNode::_hierarchyVersion != _hierarchyVersion) {
+			Rebuild(rootNode);
+		}
+
+		// Viewports of a split screen share the root, but only the first one transforms it. The results are written
+		// back to the nodes, so the other ones read them from there instead of their own arrays.
+		_arraysCurrent = (_transformVersion == _lastTransformVersion);
+		_cullingRect = cullingRect;
+		_frameCount = theApplication().GetFrameCount();
+		RunPass(Pass::Culling);
+	}
+
+	void FlatSceneGraph::Rebuild(SceneNode* rootNode)
+	{
+		ZoneScopedC(0x81A861);
+
+		_nodes.clear();
+		_parents.clear();
+		_subtreeEnds.clear();
+		_flags.clear();
+
+		_rootNode = rootNode;
+		_hierarchyVersion = SceneNode::_hierarchyVersion;
+		AppendSubtree(rootNode, -1);
+
+		const std::size_t count = _nodes.size();
+		_transforms.resize_for_overwrite(count);
+		_absScales.resize_for_overwrite(count);
+		_absRotations.resize_for_overwrite(count);
+		_colors.resize_for_overwrite(count);
+		_absLayers.resize_for_overwrite(count);
+		_aabbs.resize_for_overwrite(count);
+		for (std::int32_t i = 0; i < std::int32_t(count); i++) {
+			GatherNode(i);
+		}
+
+		// Everything below a chain of only children depends on the whole chain, so the jobs start under it
+		_splitIndex = 0;
+		while (_splitIndex + 1 < std::int32_t(count) && _subtreeEnds[_splitIndex + 1] == _subtreeEnds[_splitIndex] &&
+			   _parents[_splitIndex + 1] == _splitIndex) {
+			_splitIndex++;
+		}
+	}
+
+	void FlatSceneGraph::AppendSubtree(SceneNode* node, std::int32_t parent)
+	{
+		const std::int32_t index = std::int32_t(_nodes.size());
+		_nodes.push_back(node);
+		_parents.push_back(parent);
+		_subtreeEnds.push_back(index + 1);
+
+		std::uint8_t flags = 0;
+		switch (node->type()) {
+			case Object::ObjectType::SceneNode: break;
+			case Object::ObjectType::ParticleSystem: flags = IsParticleSystem; break;
+			default: flags = IsDrawable; break;
+		}
+		_flags.push_back(flags);
+
+		// Particles are born and die every frame, they stay with their system instead of invalidating the arrays
+		if ((flags & IsParticleSystem) == 0) {
+			for (SceneNode* child : node->_children) {
+				AppendSubtree(child, index);
+			}
+			_subtreeEnds[index] = std::int32_t(_nodes.size());
+		}
+	}
+
+	void FlatSceneGraph::PrepareJobRanges(std::int32_t numJobs)
+	{
+		_jobRanges.clear();
+
+		const std::int32_t count = std::int32_t(_nodes.size());
+		if (_pass == Pass::Culling) {
+			// Nodes are culled independently, so any split will do
+			for (std::int32_t i = 0; i < numJobs; i++) {
+				_jobRanges.push_back({ std::int32_t(std::int64_t(count) * i / numJobs), std::int32_t(std::int64_t(count) * (i + 1) / numJobs) });
+			}
+			return;
+		}
+
+		// Transformations flow from parents to children, so each job gets whole subtrees of the split node
+		const std::int32_t first = _splitIndex + 1;
+		const std::int32_t last = _subtreeEnds[_splitIndex];
+		const std::int32_t targetSize = std::max((last - first) / numJobs, 1);
+		std::int32_t rangeStart = first;
+		std::int32_t child = first;
+		while (child < last) {
+			child = _subtreeEnds[child];
+			if (child - rangeStart >= targetSize || child == last) {
+				_jobRanges.push_back({ rangeStart, child });
+				rangeStart = child;
+			}
+		}
+	}
+
+	void FlatSceneGraph::RunPass(Pass pass)
+	{
+		ZoneScopedC(0x81A861);
+
+		_pass = pass;
+
+		const std::int32_t count = std::int32_t(_nodes.size());
+		std::int32_t numJobs = 1;
+#if defined(WITH_THREADS)
+		const std::int32_t numThreads = std::int32_t(theServiceLocator().GetThreadPool().GetThreadCount());
+		if (numThreads > 0 && count >= 2 * MinNodesPerJob) {
+			numJobs = std::min(numThreads + 1, count / MinNodesPerJob);
+		}
+#endif
+
+		if (pass != Pass::Culling) {
+			// The chain of only children is processed first, everything else depends on it
+			for (std::int32_t i = 0; i <= _splitIndex; i++) {
+				if (!ShouldTransform(i)) {
+					GatherSubtree(i);
+					return;
+				}
+				ProcessRange(i, i + 1);
+			}
+			if (_splitIndex + 1 >= count) {
+				return;
+			}
+		}
+
+		PrepareJobRanges(numJobs);
+
+#if defined(WITH_THREADS)
+		if (_jobRanges.size() > 1) {
+			_jobsMutex.Lock();
+			_pendingJobs = std::int32_t(_jobRanges.size()) - 1;
+			_jobsMutex.Unlock();
+
+			IThreadPool& threadPool = theServiceLocator().GetThreadPool();
+			for (std::size_t i = 1; i < _jobRanges.size(); i++) {
+				threadPool.EnqueueCommand(std::make_unique<RangeCommand>(this, _jobRanges[i]));
+			}
+		}
+#endif
+
+		// The calling thread takes the first range
+		ProcessRange(_jobRanges[0].first, _jobRanges[0].last);
+
+#if defined(WITH_THREADS)
+		if (_jobRanges.size() > 1) {
+			_jobsMutex.Lock();
+			while (_pendingJobs > 0) {
+				_jobsCV.Wait(_jobsMutex);
+			}
+			_jobsMutex.Unlock();
+		}
+#endif
+	}
+
+	void FlatSceneGraph::ProcessRange(std::int32_t first, std::int32_t last)
+	{
+		if (_pass == Pass::Culling) {
+			for (std::int32_t i = first; i < last; i++) {
+				CullNode(i);
+			}
+			return;
+		}
+
+		std::int32_t i = first;
+		while (i < last) {
+			SceneNode& node = *_nodes[i];
+			if (!ShouldTransform(i)) {
+				// A node that was not updated doesn't transform its descendants either
+				GatherSubtree(i);
+				i = _subtreeEnds[i];
+				continue;
+			}
+
+			if (_flags[i] & IsParticleSystem) {
+				if (_pass == Pass::Interpolate) {
+					node.OnInterpolate(_alpha);
+				} else {
+					// The system transformed itself and its particles during the update, before its parent did
+					const std::uint8_t parentFlags = (_parents[i] >= 0 ? _flags[_parents[i]] : 0);
+					if (parentFlags & (ColorChanged | TransformationChanged)) {
+						if (parentFlags & ColorChanged) {
+							node._dirtyBits.set(SceneNode::DirtyBitPositions::ColorBit);
+						}
+						if (parentFlags & TransformationChanged) {
+							node._dirtyBits.set(SceneNode::DirtyBitPositions::TransformationBit);
+							node._dirtyBits.set(SceneNode::DirtyBitPositions::AabbBit);
+						}
+						node.transform();
+						for (SceneNode* particle : node._children) {
+							particle->transform();
+						}
+					}
+				}
+				GatherNode(i);
+				i++;
+				continue;
+			}
+
+			if (_pass == Pass::Interpolate) {
+				// Same as `SceneNode::OnInterpolate()`
+				const bool updatedByLastTick = (node._lastFrameUpdated == _updateCount);
+				const Vector2f delta = node._tickPosition - node._previousTickPosition;
+				if (updatedByLastTick && (delta.X != 0.0f || delta.Y != 0.0f) &&
+					delta.SqrLength() < SceneNode::InterpolationSnapDistance * SceneNode::InterpolationSnapDistance) {
+					const Vector2f position = node._previousTickPosition + delta * _alpha;
+					node._dirtyBits.set(SceneNode::DirtyBitPositions::TransformationBit);
+					node._dirtyBits.set(SceneNode::DirtyBitPositions::AabbBit);
+					TransformNode(i, &position);
+				} else {
+					TransformNode(i, nullptr);
+				}
+				node._lastFrameInterpolated = _frameCount;
+			} else {
+				TransformNode(i, nullptr);
+
+				// Children read the parent state from the flags, so the bits can be reset right away
+				node._dirtyBits.reset(SceneNode::DirtyBitPositions::TransformationBit);
+				node._dirtyBits.reset(SceneNode::DirtyBitPositions::ColorBit);
+				if (node.type() == Object::ObjectType::SceneNode) {
+					node._dirtyBits.reset(SceneNode::DirtyBitPositions::TransformationUploadBit);
+					node._dirtyBits.reset(SceneNode::DirtyBitPositions::ColorUploadBit);
+				}
+			}
+			i++;
+		}
+	}
+
+	bool FlatSceneGraph::ShouldTransform(std::int32_t index) const
+	{
+		const SceneNode& node = *_nodes[index];
+		return (_pass == Pass::Interpolate ? node._updateEnabled : node._lastFrameUpdated == _updateCount);
+	}
+
+	/** @note Same as `SceneNode::transform()`, but the parent values are read from the arrays */
+	void FlatSceneGraph::TransformNode(std::int32_t index, const Vector2f* interpolatedPosition)
+	{
+		SceneNode& node = *_nodes[index];
+		const std::int32_t parent = _parents[index];
+		const std::uint8_t parentFlags = (parent >= 0 ? _flags[parent] : 0);
+		std::uint8_t flags = (_flags[index] & (IsDrawable | IsParticleSystem));
+
+		node._absLayer = (parent >= 0 && node._layer == 0 ? _absLayers[parent] : node._layer);
+		_absLayers[index] = node._absLayer;
+
+		switch (node._visitOrderState) {
+			case SceneNode::VisitOrderState::Enabled: node._withVisitOrder = true; break;
+			case SceneNode::VisitOrderState::SameAsParent: node._withVisitOrder = (parent < 0 || (parentFlags & WithVisitOrder) != 0); break;
+			default: node._withVisitOrder = false; break;
+		}
+		if (node._withVisitOrder) {
+			flags |= WithVisitOrder;
+		}
+
+		if (parentFlags & ColorChanged) {
+			node._dirtyBits.set(SceneNode::DirtyBitPositions::ColorBit);
+		}
+		if (node._dirtyBits.test(SceneNode::DirtyBitPositions::ColorBit)) {
+			node._absColor = (parent >= 0 ? node._color * _colors[parent] : node._color);
+			node._dirtyBits.set(SceneNode::DirtyBitPositions::ColorUploadBit);
+			flags |= ColorChanged;
+		}
+		_colors[index] = node._absColor;
+
+		if (parentFlags & TransformationChanged) {
+			node._dirtyBits.set(SceneNode::DirtyBitPositions::TransformationBit);
+			node._dirtyBits.set(SceneNode::DirtyBitPositions::AabbBit);
+		}
+
+		if (node._dirtyBits.test(SceneNode::DirtyBitPositions::TransformationBit)) {
+			const Vector2f position = (interpolatedPosition != nullptr ? *interpolatedPosition : node._position);
+			float c = 1.0f, s = 0.0f;
+			if (node._rotation != 0.0f) {
+				c = cosf(node._rotation);
+				s = sinf(node._rotation);
+			}
+			const float m00 = c * node._scaleFactor.X;
+			const float m01 = s * node._scaleFactor.X;
+			const float m10 = -s * node._scaleFactor.Y;
+			const float m11 = c * node._scaleFactor.Y;
+			const float tx = position.X - node._anchorPoint.X * m00 - node._anchorPoint.Y * m10;
+			const float ty = position.Y - node._anchorPoint.X * m01 - node._anchorPoint.Y * m11;
+
+			node._localMatrix[0].Set(m00, m01);
+			node._localMatrix[1].Set(m10, m11);
+			node._localMatrix[2].Set(tx, ty);
+
+			Matrix2x3f& world = _transforms[index];
+			if (parent >= 0) {
+				world = _transforms[parent] * node._localMatrix;
+				_absScales[index] = node._scaleFactor * _absScales[parent];
+				_absRotations[index] = node._rotation + _absRotations[parent];
+			} else {
+				world = node._localMatrix;
+				_absScales[index] = node._scaleFactor;
+				_absRotations[index] = node._rotation;
+			}
+
+			node._worldMatrix = world;
+			node._absScaleFactor = _absScales[index];
+			node._absRotation = _absRotations[index];
+			node._absPosition = world[2];
+
+			node._dirtyBits.set(SceneNode::DirtyBitPositions::TransformationUploadBit);
+			flags |= TransformationChanged;
+		} else {
+			_transforms[index] = node._worldMatrix;
+			_absScales[index] = node._absScaleFactor;
+			_absRotations[index] = node._absRotation;
+		}
+
+		_flags[index] = flags;
+	}
+
+	void FlatSceneGraph::GatherNode(std::int32_t index)
+	{
+		const SceneNode& node = *_nodes[index];
+		_transforms[index] = node._worldMatrix;
+		_absScales[index] = node._absScaleFactor;
+		_absRotations[index] = node._absRotation;
+		_colors[index] = node._absColor;
+		_absLayers[index] = node._absLayer;
+		if (_flags[index] & IsDrawable) {
+			_aabbs[index] = static_cast<const DrawableNode&>(node)._aabb;
+		}
+
+		// Untransformed nodes don't pass any change down
+		std::uint8_t flags = (_flags[index] & (IsDrawable | IsParticleSystem));
+		if (node._withVisitOrder) {
+			flags |= WithVisitOrder;
+		}
+		_flags[index] = flags;
+	}
+
+	void FlatSceneGraph::GatherSubtree(std::int32_t index)
+	{
+		const std::int32_t last = _subtreeEnds[index];
+		for (std::int32_t i = index; i < last; i++) {
+			GatherNode(i);
+		}
+	}
+
+	/** @note Same as `DrawableNode::updateCulling()`, but the bounding box is calculated from the arrays */
+	void FlatSceneGraph::CullNode(std::int32_t index)
+	{
+		if (_flags[index] & IsParticleSystem) {
+			for (SceneNode* particle : _nodes[index]->_children) {
+				static_cast<DrawableNode*>(particle)->updateCulling();
+			}
+			return;
+		}
+		if ((_flags[index] & IsDrawable) == 0) {
+			return;
+		}
+
+		DrawableNode& drawable = static_cast<DrawableNode&>(*_nodes[index]);
+		if (!drawable._drawEnabled || drawable._width <= 0.0f || drawable._height <= 0.0f) {
+			return;
+		}
+
+		Rectf& aabb = _aabbs[index];
+		if (!_arraysCurrent) {
+			if (drawable._dirtyBits.test(SceneNode::DirtyBitPositions::AabbBit)) {
+				drawable.updateAabb();
+				drawable._dirtyBits.reset(SceneNode::DirtyBitPositions::AabbBit);
+			}
+			aabb = drawable._aabb;
+		} else if (drawable._dirtyBits.test(SceneNode::DirtyBitPositions::AabbBit)) {
+			const float width = drawable._width * _absScales[index].X;
+			const float height = drawable._height * _absScales[index].Y;
+			const float x = _transforms[index][2].X;
+			const float y = _transforms[index][2].Y;
+			const float rotation = _absRotations[index];
+			if (rotation > SceneNode::MinRotation || rotation < -SceneNode::MinRotation) {
+				const float maxSize = width + height;
+				aabb = Rectf(x - maxSize, y - maxSize, maxSize * 2, maxSize * 2);
+			} else {
+				aabb = Rectf(x, y, width, height);
+			}
+			drawable._aabb = aabb;
+			drawable._dirtyBits.reset(SceneNode::DirtyBitPositions::AabbBit);
+		}
+
+		if (drawable._lastFrameRendered < _frameCount && aabb.Overlaps(_cullingRect)) {
+			drawable._lastFrameRendered = _frameCount;
+		}
+	}
+}
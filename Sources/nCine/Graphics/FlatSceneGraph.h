@@ -0,0 +1,135 @@
+#pragma once
+
+#include "../Primitives/Matrix2x3.h"
+#include "../Primitives/Colorf.h"
+#include "../Primitives/Rect.h"
+
+#if defined(WITH_THREADS)
+#	include "../Threading/ThreadSync.h"
+#endif
+
+#include <Containers/SmallVector.h>
+
+using namespace Death::Containers;
+
+namespace nCine
+{
+	class SceneNode;
+
+	/**
+		@brief Depth-first flattened copy of a scene graph for linear transform and culling passes
+
+		Keeps the nodes under a root in depth-first order together with contiguous arrays of parent indices,
+		subtree ends, absolute 2D affine transforms, scale factors, rotations, colors and bounding boxes. The
+		hierarchy is only walked again when it changes, otherwise transform propagation reads the parent values
+		from the arrays and culling runs over them without recursion. When a thread pool is registered, large
+		trees are split at subtree boundaries and processed by its workers.
+
+		Node logic still runs through the usual @ref SceneNode::OnUpdate() recursion, only the call to
+		`transform()` is deferred to the linear pass. Results are written back to the nodes, so drawing is
+		unaffected. Particle systems transform their own particles and are kept as single entries.
+	*/
+	class FlatSceneGraph
+	{
+	public:
+		FlatSceneGraph();
+		~FlatSceneGraph();
+
+		FlatSceneGraph(const FlatSceneGraph&) = delete;
+		FlatSceneGraph& operator=(const FlatSceneGraph&) = delete;
+
+		/** @brief Runs the node logic of the tree and propagates the transformations in a linear pass */
+		void Update(SceneNode* rootNode, float timeMult);
+		/** @brief Transforms the tree at the position between the last two updates, see @ref SceneNode::OnInterpolate() */
+		void Interpolate(SceneNode* rootNode, float alpha);
+		/** @brief Refreshes the bounding boxes of drawable nodes and marks the ones overlapping the rectangle as rendered */
+		void UpdateCulling(SceneNode* rootNode, const Rectf& cullingRect);
+
+		/** @brief Returns the number of flattened nodes */
+		inline std::uint32_t GetNodeCount() const {
+			return std::uint32_t(_nodes.size());
+		}
+
+	private:
+		/** @brief Trees with fewer nodes are always processed on the calling thread */
+		static constexpr std::int32_t MinNodesPerJob = 2048;
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+		enum class Pass
+		{
+			Update,
+			Interpolate,
+			Culling
+		};
+
+		enum NodeFlags : std::uint8_t
+		{
+			IsDrawable = 0x01,
+			IsParticleSystem = 0x02,
+			// Set by the transform passes for the children to read
+			ColorChanged = 0x04,
+			TransformationChanged = 0x08,
+			WithVisitOrder = 0x10
+		};
+
+		struct Range
+		{
+			std::int32_t first;
+			std::int32_t last;
+		};
+
+#	if defined(WITH_THREADS)
+		class RangeCommand;
+#	endif
+#endif
+
+		SceneNode* _rootNode;
+		std::uint32_t _hierarchyVersion;
+
+		SmallVector<SceneNode*, 0> _nodes;
+		SmallVector<std::int32_t, 0> _parents;
+		SmallVector<std::int32_t, 0> _subtreeEnds;
+		SmallVector<std::uint8_t, 0> _flags;
+		SmallVector<Matrix2x3f, 0> _transforms;
+		SmallVector<Vector2f, 0> _absScales;
+		SmallVector<float, 0> _absRotations;
+		SmallVector<Colorf, 0> _colors;
+		SmallVector<std::uint16_t, 0> _absLayers;
+		SmallVector<Rectf, 0> _aabbs;
+
+		/** @brief Index of the deepest node that is the only child of all its ancestors, its children start the jobs */
+		std::int32_t _splitIndex;
+		SmallVector<Range, 0> _jobRanges;
+
+		/** @brief Incremented by every transform pass of any instance, see @ref _transformVersion */
+		static std::uint32_t _lastTransformVersion;
+		/** @brief Value of @ref _lastTransformVersion after the last transform pass of this instance */
+		std::uint32_t _transformVersion;
+
+		// Per-pass state read by the jobs
+		Pass _pass;
+		float _alpha;
+		Rectf _cullingRect;
+		bool _arraysCurrent;
+		std::uint32_t _updateCount;
+		std::uint32_t _frameCount;
+
+#if defined(WITH_THREADS)
+		Mutex _jobsMutex;
+		CondVariable _jobsCV;
+		std::int32_t _pendingJobs;
+#endif
+
+		void Rebuild(SceneNode* rootNode);
+		void AppendSubtree(SceneNode* node, std::int32_t parent);
+		void PrepareJobRanges(std::int32_t numJobs);
+		void RunPass(Pass pass);
+		void ProcessRange(std::int32_t first, std::int32_t last);
+
+		bool ShouldTransform(std::int32_t index) const;
+		void TransformNode(std::int32_t index, const Vector2f* interpolatedPosition);
+		void GatherNode(std::int32_t index);
+		void GatherSubtree(std::int32_t index);
+		void CullNode(std::int32_t index);
+	};
+}
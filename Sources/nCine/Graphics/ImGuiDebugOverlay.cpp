@@ -650,6 +650,8 @@ namespace nCine
 			ImGui::Checkbox("Batching with indices", &settings.batchingWithIndices);
 			ImGui::SameLine();
 			ImGui::Checkbox("Culling", &settings.cullingEnabled);
+			ImGui::SameLine();
+			ImGui::Checkbox("Flat scene graph", &settings.flatSceneGraph);
 			ImGui::DragIntRange2("Batch size", &minBatchSize, &maxBatchSize, 1.0f, 0, 512);
 
 			settings.minBatchSize = minBatchSize;
@@ -1409,6 +1411,10 @@ namespace nCine
 		}
 
 		ImGui::Text("Viewport chain length: %u", Viewport::GetChain().size());
+#if defined(WITH_RHI_SOFTWARE)
+		const RenderStatistics::TileDamage& tileDamage = RenderStatistics::GetTileDamage();
+		ImGui::Text("%u/%u software tiles skipped as unchanged", tileDamage.skippedTiles, tileDamage.renderedTiles + tileDamage.skippedTiles);
+#endif
 
 		ImGui::End();
 	}
@@ -223,7 +223,7 @@ namespace nCine
 			}
 		}
 
-		_lastFrameUpdated = theApplication().GetFrameCount();
+		_lastFrameUpdated = theApplication().GetUpdateCount();
 
 #if defined(WITH_TRACY)
 		// TODO: Tracy
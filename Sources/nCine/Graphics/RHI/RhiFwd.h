@@ -119,8 +119,15 @@ namespace nCine::RHI
 // so `RHI_CAP_SHADERS` is deliberately left undefined. The pipeline then skips the bloom chain, uses the cheap
 // no-shader lighting path and renders the scene directly to the screen buffer instead of through the shader
 // combine/rescale passes.
+//
+// `RHI_CAP_CPU_RESCALE` means the rescale filters are still available without shaders: the device applies
+// them on the CPU to the finished screen buffer while presenting (see @ref RHI::Software::SwRescale), at
+// a fixed integer scale per filter. It's not available with the 16-bit screen buffer.
 #define RHI_CAP_FRAMEBUFFERS
 #define RHI_CAP_BATCHING
+#if !defined(RHI_USE_FB16)
+#	define RHI_CAP_CPU_RESCALE
+#endif
 
 namespace nCine::RHI::Software
 {
@@ -5,6 +5,7 @@
 #include "SwShaderProgram.h"
 #include "SwRenderTarget.h"
 #include "SwTexture.h"
+#include "SwTileRenderer.h"
 
 #include "../../../../Shaders/Generated/ShaderCompilerTypes.h"
 #include "../../../../Shaders/Generated/SwGeneratedShaders.h"
@@ -57,6 +58,20 @@ namespace nCine::RHI::Software
 			}
 		}
 
+		// Composes a column-major 4x4 projection-view with an instance's model matrix, keeping only the 2D
+		// affine part that maps quad-local X/Y to clip-space X/Y: out = [m00, m01, m10, m11, tx, ty]. The Z
+		// column is never sampled by a planar quad and the 2D pipeline's projections keep w == 1.
+		void Mat4MulAffine2D(const float* pv, const float* model, float* out)
+		{
+			static constexpr int Columns[3] = { 0, 1, 3 };
+			for (int c = 0; c < 3; c++) {
+				const float* col = model + Columns[c] * 4;
+				for (int r = 0; r < 2; r++) {
+					out[c * 2 + r] = pv[r] * col[0] + pv[4 + r] * col[1] + pv[8 + r] * col[2] + pv[12 + r] * col[3];
+				}
+			}
+		}
+
 		// Column-major 4x4 times a column vector: out = m * v
 		void Mat4Vec4(const float* m, const float* v, float* out)
 		{
@@ -103,7 +118,10 @@ namespace nCine::RHI::Software
 	std::int32_t SwDevice::_defaultFbHeight = 0;
 	std::int32_t SwDevice::_defaultFbStride = 0;
 	std::vector<std::uint8_t> SwDevice::_screenPixels;
+	SwRescaleFilter SwDevice::_screenRescaleFilter = SwRescaleFilter::None;
+	std::vector<std::uint8_t> SwDevice::_presentPixels;
 	std::vector<SwDevice::PendingSoftwareLight> SwDevice::_pendingSoftwareLights;
+	std::vector<QuadInstance> SwDevice::_quadInstances;
 
 	void SwDevice::SetBlendingEnabled(bool enabled)
 	{
@@ -336,6 +354,8 @@ namespace nCine::RHI::Software
 
 	void SwDevice::SetDefaultFramebuffer(const Framebuffer& framebuffer)
 	{
+		// The new buffer may reuse the address of an older surface with different content
+		SwTileRenderer::InvalidateSurface(framebuffer.pixels);
 		_defaultFbPixels = framebuffer.pixels;
 		_defaultFbWidth = framebuffer.width;
 		_defaultFbHeight = framebuffer.height;
@@ -376,6 +396,41 @@ namespace nCine::RHI::Software
 		return fb;
 	}
 
+	void SwDevice::SetScreenRescaleFilter(SwRescaleFilter filter)
+	{
+		_screenRescaleFilter = filter;
+		if (filter == SwRescaleFilter::None) {
+			_presentPixels = {};
+		}
+	}
+
+	SwRescaleFilter SwDevice::GetScreenRescaleFilter()
+	{
+		return _screenRescaleFilter;
+	}
+
+	Framebuffer SwDevice::GetPresentFramebuffer()
+	{
+		Framebuffer screen = GetScreenFramebuffer();
+#if defined(RHI_USE_FB16)
+		return screen;
+#else
+		if (_screenRescaleFilter == SwRescaleFilter::None || screen.pixels == nullptr) {
+			return screen;
+		}
+
+		const std::int32_t scale = SwRescale::GetScaleFactor(_screenRescaleFilter);
+		Framebuffer fb;
+		fb.width = screen.width * scale;
+		fb.height = screen.height * scale;
+		fb.strideBytes = fb.width * 4;
+		_presentPixels.resize(std::size_t(fb.strideBytes) * std::size_t(fb.height));
+		fb.pixels = _presentPixels.data();
+		SwRescale::Apply(_screenRescaleFilter, screen.pixels, screen.width, screen.height, screen.strideBytes, fb.pixels, fb.strideBytes);
+		return fb;
+#endif
+	}
+
 	void SwDevice::FlushSoftwareRenderer()
 	{
 		SwRaster::Flush();
@@ -483,6 +538,7 @@ namespace nCine::RHI::Software
 		if (fb.pixels == nullptr) {
 			return;
 		}
+		SwTileRenderer::InvalidateSurface(fb.pixels);
 
 		// Clamp the viewport rectangle to the actual screen buffer (the compositor submits the unclamped rect)
 		const std::int32_t vpX = std::max(0, light.VpX);
@@ -710,8 +766,8 @@ namespace nCine::RHI::Software
 				}
 				const std::uint8_t* inst = blockData + instOffset;
 
-				float mvp[16];
-				Mat4Mul(pv, reinterpret_cast<const float*>(inst + kModelMatrixOffset), mvp);
+				float mvp[6];
+				Mat4MulAffine2D(pv, reinterpret_cast<const float*>(inst + kModelMatrixOffset), mvp);
 				const float* spriteSize = reinterpret_cast<const float*>(inst + spriteSizeOffset);
 				const float* texRect = (hasTexRect ? reinterpret_cast<const float*>(inst + kTexRectOffset) : nullptr);
 
@@ -722,16 +778,8 @@ namespace nCine::RHI::Software
 					std::memcpy(pos, vertexBytes(i) + posOff, sizeof(pos));
 					const float wx = pos[0] * spriteSize[0];
 					const float wy = pos[1] * spriteSize[1];
-					float cx = mvp[0] * wx + mvp[4] * wy + mvp[12];
-					float cy = mvp[1] * wx + mvp[5] * wy + mvp[13];
-					const float cw = mvp[3] * wx + mvp[7] * wy + mvp[15];
-					if (cw != 0.0f && cw != 1.0f) {
-						// The 2D pipeline's projections keep w == 1; divide only when one does not
-						cx /= cw;
-						cy /= cw;
-					}
-					out[0] = cx;
-					out[1] = cy;
+					out[0] = mvp[0] * wx + mvp[2] * wy + mvp[4];
+					out[1] = mvp[1] * wx + mvp[3] * wy + mvp[5];
 					if (texRect != nullptr) {
 						float tex[2];
 						std::memcpy(tex, vertexBytes(i) + texOff, sizeof(tex));
@@ -924,11 +972,11 @@ namespace nCine::RHI::Software
 			bdst = MapBlend(static_cast<BlendingFactor>(static_cast<std::uint32_t>(_blending.DstRgb)));
 		}
 
-		// Fills a draw context from one instance's fixed-function state and hands it to the engine as a
-		// procedural sprite quad (vertexData stays null, so FetchVertex synthesizes the four corners from ff).
-		// userDataSize is the byte size of the block userData points at, so the tile renderer can snapshot it
-		// when the draw is deferred (its storage is caller-stack memory); pass 0 when there is no callback.
-		auto drawQuad = [&](const FFState& ff, FragmentShaderFn fragmentShader, void* userData, std::uint32_t userDataSize) {
+		// Fills a draw context from one instance's fixed-function state for a procedural sprite quad
+		// (vertexData stays null, so FetchVertex synthesizes the four corners from ff). userDataSize is the
+		// byte size of the block userData points at, so the tile renderer can snapshot it when the draw is
+		// deferred (its storage is caller-stack memory); pass 0 when there is no callback.
+		auto makeQuadContext = [&](const FFState& ff, FragmentShaderFn fragmentShader, void* userData, std::uint32_t userDataSize) {
 			DrawContext ctx;
 			for (std::uint32_t u = 0; u < MaxTextureUnits; u++) {
 				ctx.textures[u] = _boundTextures[u];
@@ -951,10 +999,22 @@ namespace nCine::RHI::Software
 			ctx.blendDst = bdst;
 			ctx.scissorEnabled = _scissor.Enabled;
 			ctx.scissorRect = _scissor.Rect;
-			SwRaster::SetDrawContext(ctx);
+			return ctx;
+		};
+
+		// Hands one instance to the engine as a procedural sprite quad
+		auto drawQuad = [&](const FFState& ff, FragmentShaderFn fragmentShader, void* userData, std::uint32_t userDataSize) {
+			SwRaster::SetDrawContext(makeQuadContext(ff, fragmentShader, userData, userDataSize));
 			SwRaster::Draw(PrimitiveType::TriangleStrip, 0, 4);
 		};
 
+		// Hands all instances of a sprite draw to the engine at once, they share everything in ff but the
+		// per-instance fields, so the tile renderer can keep them as one command
+		auto drawInstances = [&](const FFState& ff, FragmentShaderFn fragmentShader) {
+			SwRaster::SetDrawContext(makeQuadContext(ff, fragmentShader, nullptr, 0));
+			SwRaster::DrawInstances(_quadInstances.data(), std::int32_t(_quadInstances.size()));
+		};
+
 		// A generated shader is batched when its instance block carries a BATCH_SIZE-sized array (instanceStride > 0)
 		const bool batched = (effect == SwEffect::DefaultBatchedSprites || effect == SwEffect::DefaultBatchedSpritesNoTexture ||
 			effect == SwEffect::BatchedPaletteRemap ||
@@ -1026,7 +1086,7 @@ namespace nCine::RHI::Software
 			for (std::int32_t k = 0; k < numInstances; k++) {
 				const std::uint8_t* inst = blockData + std::size_t(k) * instanceStride;
 				FFState ff;
-				Mat4Mul(pv, reinterpret_cast<const float*>(inst + kModelMatrixOffset), ff.mvpMatrix);
+				Mat4MulAffine2D(pv, reinterpret_cast<const float*>(inst + kModelMatrixOffset), ff.mvpMatrix);
 				std::memcpy(ff.color, inst + kColorOffset, sizeof(ff.color));
 				std::memcpy(ff.texRect, inst + kTexRectOffset, sizeof(ff.texRect));
 				std::memcpy(ff.spriteSize, inst + kSpriteSizeOffset, sizeof(ff.spriteSize));
@@ -1073,17 +1133,19 @@ namespace nCine::RHI::Software
 					LOGW("Skipped draw: No texture bound to the sampler unit");
 					break;
 				}
+				_quadInstances.resize(std::size_t(numInstances));
 				for (std::int32_t k = 0; k < numInstances; k++) {
 					const std::uint8_t* inst = blockData + std::size_t(k) * instanceStride;
-					FFState ff;
-					Mat4Mul(pv, reinterpret_cast<const float*>(inst + kModelMatrixOffset), ff.mvpMatrix);
-					std::memcpy(ff.color, inst + kColorOffset, sizeof(ff.color));
-					std::memcpy(ff.texRect, inst + kTexRectOffset, sizeof(ff.texRect));
-					std::memcpy(ff.spriteSize, inst + kSpriteSizeOffset, sizeof(ff.spriteSize));
-					ff.hasTexture = true;
-					ff.textureUnit = uTextureUnit;
-					drawQuad(ff, nullptr, nullptr, 0);
+					QuadInstance& quad = _quadInstances[k];
+					Mat4MulAffine2D(pv, reinterpret_cast<const float*>(inst + kModelMatrixOffset), quad.mvpMatrix);
+					std::memcpy(quad.color, inst + kColorOffset, sizeof(quad.color));
+					std::memcpy(quad.texRect, inst + kTexRectOffset, sizeof(quad.texRect));
+					std::memcpy(quad.spriteSize, inst + kSpriteSizeOffset, sizeof(quad.spriteSize));
 				}
+				FFState ff;
+				ff.hasTexture = true;
+				ff.textureUnit = uTextureUnit;
+				drawInstances(ff, nullptr);
 				break;
 			}
 
@@ -1095,15 +1157,18 @@ namespace nCine::RHI::Software
 				// is handled safely. hasTexture stays false so the rasterizer never dereferences a null texture.
 				const FragmentShaderFn noTexFragment = (effect == SwEffect::DefaultBatchedSpritesNoTexture)
 					? &DefaultBatchedSpritesNoTexture_Fragment : &DefaultSpriteNoTexture_Fragment;
+				FFState ff;
+				ff.hasTexture = false;
+				_quadInstances.resize(std::size_t(numInstances));
 				for (std::int32_t k = 0; k < numInstances; k++) {
 					const std::uint8_t* inst = blockData + std::size_t(k) * instanceStride;
-					FFState ff;
-					Mat4Mul(pv, reinterpret_cast<const float*>(inst + kModelMatrixOffset), ff.mvpMatrix);
-					std::memcpy(ff.color, inst + kColorOffset, sizeof(ff.color));
-					std::memcpy(ff.spriteSize, inst + kSpriteSizeNoTexOffset, sizeof(ff.spriteSize));
-					ff.hasTexture = false;
-					drawQuad(ff, noTexFragment, nullptr, 0);
+					QuadInstance& quad = _quadInstances[k];
+					Mat4MulAffine2D(pv, reinterpret_cast<const float*>(inst + kModelMatrixOffset), quad.mvpMatrix);
+					std::memcpy(quad.color, inst + kColorOffset, sizeof(quad.color));
+					std::memcpy(quad.texRect, ff.texRect, sizeof(quad.texRect));
+					std::memcpy(quad.spriteSize, inst + kSpriteSizeNoTexOffset, sizeof(quad.spriteSize));
 				}
+				drawInstances(ff, noTexFragment);
 				break;
 			}
 
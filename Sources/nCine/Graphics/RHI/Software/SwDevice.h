@@ -1,5 +1,6 @@
 #pragma once
 
+#include "SwRescale.h"
 #include "../RhiTypes.h"
 #include "../../../Primitives/Rect.h"
 #include "../../../Primitives/Colorf.h"
@@ -12,6 +13,7 @@ namespace nCine::RHI::Software
 	class SwShaderProgram;
 	class SwRenderTarget;
 	class SwTexture;
+	struct QuadInstance;
 
 	/**
 		@brief Destination framebuffer the device presents and resolves draws into
@@ -183,6 +185,19 @@ namespace nCine::RHI::Software
 		static void ResizeScreenFramebuffer(std::int32_t width, std::int32_t height);
 		/** @brief Returns the owned screen back-buffer (pixels/size/stride) for the window backend to present */
 		static Framebuffer GetScreenFramebuffer();
+		/** @brief Sets the filter @ref GetPresentFramebuffer() applies to the screen back-buffer */
+		static void SetScreenRescaleFilter(SwRescaleFilter filter);
+		/** @brief Returns the filter set by @ref SetScreenRescaleFilter() */
+		static SwRescaleFilter GetScreenRescaleFilter();
+		/**
+			@brief Returns the surface the window backend presents
+
+			The screen back-buffer itself if no rescale filter is set, otherwise a device-owned surface with the
+			back-buffer enlarged by the filter (see @ref SwRescale), so its size can differ from the back-buffer.
+			The filter runs on every call, so it's called once per frame after @ref FlushSoftwareRenderer(). With
+			`RHI_USE_FB16` the back-buffer is always returned unfiltered.
+		*/
+		static Framebuffer GetPresentFramebuffer();
 
 		/**
 			@brief Renders any draws the tile renderer has deferred into the current color buffer
@@ -267,6 +282,9 @@ namespace nCine::RHI::Software
 		static std::int32_t _defaultFbStride;
 		/** @brief Backend-owned pixel store for the screen back-buffer (only used by the present path) */
 		static std::vector<std::uint8_t> _screenPixels;
+		static SwRescaleFilter _screenRescaleFilter;
+		/** @brief Output of the screen rescale filter, see @ref GetPresentFramebuffer() */
+		static std::vector<std::uint8_t> _presentPixels;
 
 		/** @brief One queued software-lighting/water combine, submitted by the compositor and applied at the next Combine draw */
 		struct PendingSoftwareLight
@@ -280,6 +298,8 @@ namespace nCine::RHI::Software
 		};
 		/** @brief FIFO of pending software-lighting combines (one per viewport, in submission order) */
 		static std::vector<PendingSoftwareLight> _pendingSoftwareLights;
+		/** @brief Per-instance fields of the current sprite draw, reused so instanced draws don't allocate */
+		static std::vector<QuadInstance> _quadInstances;
 
 		/** @brief Resolves the color framebuffer that draws and clears write into (RT color 0, else default) */
 		static bool ResolveFramebuffer(Framebuffer& out);
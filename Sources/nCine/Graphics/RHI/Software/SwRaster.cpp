@@ -1272,7 +1272,7 @@ namespace nCine::RHI::Software
 		inline void SampleBilinearFix(const std::uint8_t* texPixels, std::int32_t texW, std::int32_t texH, std::int32_t texBpp,
 		                              std::int32_t uFix, std::int32_t vFix,
 		                              SamplerWrapping wrapS, SamplerWrapping wrapT,
-		                              std::uint8_t* out)
+		                              std::uint8_t* out, std::int32_t texBlocksPerRow = 0)
 		{
 			// Half-pixel offset for correct bilinear centering
 			const std::int32_t uf = uFix - (1 << 15);
@@ -1291,10 +1291,10 @@ namespace nCine::RHI::Software
 			x0 = WrapTexelCoord(x0, texW, wrapS);
 			y0 = WrapTexelCoord(y0, texH, wrapT);
 
-			const std::uint8_t* c00 = texPixels + (static_cast<std::size_t>(y0) * texW + x0) * texBpp;
-			const std::uint8_t* c10 = texPixels + (static_cast<std::size_t>(y0) * texW + x1) * texBpp;
-			const std::uint8_t* c01 = texPixels + (static_cast<std::size_t>(y1) * texW + x0) * texBpp;
-			const std::uint8_t* c11 = texPixels + (static_cast<std::size_t>(y1) * texW + x1) * texBpp;
+			const std::uint8_t* c00 = texPixels + SwTexture::TexelIndex(x0, y0, texW, texBlocksPerRow) * texBpp;
+			const std::uint8_t* c10 = texPixels + SwTexture::TexelIndex(x1, y0, texW, texBlocksPerRow) * texBpp;
+			const std::uint8_t* c01 = texPixels + SwTexture::TexelIndex(x0, y1, texW, texBlocksPerRow) * texBpp;
+			const std::uint8_t* c11 = texPixels + SwTexture::TexelIndex(x1, y1, texW, texBlocksPerRow) * texBpp;
 			std::uint8_t e00[4], e10[4], e01[4], e11[4];
 			if DEATH_UNLIKELY(texBpp != 4) {
 				SwExpandTexel(e00, c00, texBpp); c00 = e00;
@@ -1380,7 +1380,7 @@ namespace nCine::RHI::Software
 		inline void SampleBilinearFloat(const std::uint8_t* texPixels, std::int32_t texW, std::int32_t texH, std::int32_t texBpp,
 		                                float u, float v,
 		                                SamplerWrapping wrapS, SamplerWrapping wrapT,
-		                                std::uint8_t* out)
+		                                std::uint8_t* out, std::int32_t texBlocksPerRow = 0)
 		{
 			const float uf = u * texW - 0.5f;
 			const float vf = v * texH - 0.5f;
@@ -1398,10 +1398,10 @@ namespace nCine::RHI::Software
 			x0 = WrapTexelCoord(x0, texW, wrapS);
 			y0 = WrapTexelCoord(y0, texH, wrapT);
 
-			const std::uint8_t* c00 = texPixels + (static_cast<std::size_t>(y0) * texW + x0) * texBpp;
-			const std::uint8_t* c10 = texPixels + (static_cast<std::size_t>(y0) * texW + x1) * texBpp;
-			const std::uint8_t* c01 = texPixels + (static_cast<std::size_t>(y1) * texW + x0) * texBpp;
-			const std::uint8_t* c11 = texPixels + (static_cast<std::size_t>(y1) * texW + x1) * texBpp;
+			const std::uint8_t* c00 = texPixels + SwTexture::TexelIndex(x0, y0, texW, texBlocksPerRow) * texBpp;
+			const std::uint8_t* c10 = texPixels + SwTexture::TexelIndex(x1, y0, texW, texBlocksPerRow) * texBpp;
+			const std::uint8_t* c01 = texPixels + SwTexture::TexelIndex(x0, y1, texW, texBlocksPerRow) * texBpp;
+			const std::uint8_t* c11 = texPixels + SwTexture::TexelIndex(x1, y1, texW, texBlocksPerRow) * texBpp;
 			std::uint8_t e00[4], e10[4], e01[4], e11[4];
 			if DEATH_UNLIKELY(texBpp != 4) {
 				SwExpandTexel(e00, c00, texBpp); c00 = e00;
@@ -1469,12 +1469,12 @@ namespace nCine::RHI::Software
 			const float* m = ctx.ff.mvpMatrix;
 			// After viewport transform: x = (ndcX + 1) * 0.5 * vpW + vpX
 			// For full coverage: NDC x ranges from -1 to +1 → screen 0 to vpW
-			// That means m[0]*spriteSize[0] + m[12] should be ~+1 (right edge)
-			// and m[12] should be ~-1 (left edge in NDC)
-			float ndcLeft = m[12];
-			float ndcRight = m[0] * ctx.ff.spriteSize[0] + m[12];
-			float ndcTop = m[5] * ctx.ff.spriteSize[1] + m[13];
-			float ndcBottom = m[13];
+			// That means m[0]*spriteSize[0] + m[4] should be ~+1 (right edge)
+			// and m[4] should be ~-1 (left edge in NDC)
+			float ndcLeft = m[4];
+			float ndcRight = m[0] * ctx.ff.spriteSize[0] + m[4];
+			float ndcTop = m[3] * ctx.ff.spriteSize[1] + m[5];
+			float ndcBottom = m[5];
 			if (std::fabs(ndcLeft - (-1.0f)) > 0.01f || std::fabs(ndcRight - 1.0f) > 0.01f) return false;
 			// Allow both normal (bottom=-1, top=+1) and Y-flipped (bottom=+1, top=-1) quads
 			if (std::fabs(ndcBottom - (-1.0f)) < 0.01f && std::fabs(ndcTop - 1.0f) < 0.01f) {
@@ -1485,7 +1485,7 @@ namespace nCine::RHI::Software
 				return false;
 			}
 			// No rotation
-			if (std::fabs(m[1]) > 0.001f || std::fabs(m[4]) > 0.001f) return false;
+			if (std::fabs(m[1]) > 0.001f || std::fabs(m[2]) > 0.001f) return false;
 
 			std::uint8_t* dstBuffer = g_state.colorBuffer;
 			const std::int32_t dstW = g_state.bufferWidth;
@@ -1604,8 +1604,8 @@ namespace nCine::RHI::Software
 				const float wy = ay * ctx.ff.spriteSize[1];
 
 				const float* m = ctx.ff.mvpMatrix;
-				out.x = m[0] * wx + m[4] * wy + m[12];
-				out.y = m[1] * wx + m[5] * wy + m[13];
+				out.x = m[0] * wx + m[2] * wy + m[4];
+				out.y = m[1] * wx + m[3] * wy + m[5];
 
 				out.u = ax * ctx.ff.texRect[0] + ctx.ff.texRect[1];
 				out.v = ay * ctx.ff.texRect[2] + ctx.ff.texRect[3];
@@ -1651,6 +1651,19 @@ namespace nCine::RHI::Software
 		// Axis-aligned quad rasterizer (fast path for non-rotated sprites)
 		// Supports all SamplerWrapping modes and SIMD blending.
 		// =====================================================================
+		// Returns the texels a quad samples: a smaller mip level when it's minified, and with preferTiled the
+		// tiled copy of a large texture. A fragment callback gets level 0, as it may read the texture itself.
+		inline SwTexture::SampledLevel GetQuadTextureLevel(const DrawContext& ctx, const SwTexture* tex,
+		                                                   const Vertex2D& v0, const Vertex2D& v1, const Vertex2D& v2, bool preferTiled)
+		{
+			if (tex == nullptr) {
+				return { nullptr, 0, 0, 0 };
+			}
+			const std::int32_t level = (ctx.fragmentShader == nullptr
+				? tex->SelectMipLevel(QuadTexelsPerPixel(v0, v1, v2, tex->GetWidth(), tex->GetHeight())) : 0);
+			return tex->GetSampledLevel(level, preferTiled);
+		}
+
 		void DrawAxisAlignedQuad(const DrawContext& ctx, Vertex2D v0, Vertex2D v1, Vertex2D v2, Vertex2D v3)
 		{
 			if DEATH_UNLIKELY(g_state.colorBuffer == nullptr) return;
@@ -1695,9 +1708,11 @@ namespace nCine::RHI::Software
 			// Texture info
 			const SwTexture* tex = (ctx.ff.hasTexture && ctx.ff.textureUnit < static_cast<std::int32_t>(MaxTextureUnits)
 							? ctx.textures[ctx.ff.textureUnit] : nullptr);
-			const std::uint8_t* texPixels = (tex != nullptr ? tex->GetPixels(0) : nullptr);
-			const std::int32_t texW = (tex != nullptr ? tex->GetWidth()  : 0);
-			const std::int32_t texH = (tex != nullptr ? tex->GetHeight() : 0);
+			// The axis-aligned walk reads linear rows, only a minified quad switches to a smaller level
+			const SwTexture::SampledLevel texLevel = GetQuadTextureLevel(ctx, tex, v0, v1, v2, false);
+			const std::uint8_t* texPixels = texLevel.pixels;
+			const std::int32_t texW = texLevel.width;
+			const std::int32_t texH = texLevel.height;
 			const std::int32_t texBpp = (tex != nullptr ? tex->GetBytesPerPixel() : 4);
 			const SamplerWrapping wrapS = (tex != nullptr ? tex->GetWrapS() : SamplerWrapping::ClampToEdge);
 			const SamplerWrapping wrapT = (tex != nullptr ? tex->GetWrapT() : SamplerWrapping::ClampToEdge);
@@ -2189,10 +2204,13 @@ namespace nCine::RHI::Software
 			// Texture info
 			const SwTexture* tex = (ctx.ff.hasTexture && ctx.ff.textureUnit < static_cast<std::int32_t>(MaxTextureUnits)
 							? ctx.textures[ctx.ff.textureUnit] : nullptr);
-			const std::uint8_t* texPixels = (tex != nullptr ? tex->GetPixels(0) : nullptr);
-			const std::int32_t texW = (tex != nullptr ? tex->GetWidth() : 0);
-			const std::int32_t texH = (tex != nullptr ? tex->GetHeight() : 0);
+			// A rotated quad walks the texture diagonally, so a large one is sampled from its tiled copy
+			const SwTexture::SampledLevel texLevel = GetQuadTextureLevel(ctx, tex, v0, v1, v2, true);
+			const std::uint8_t* texPixels = texLevel.pixels;
+			const std::int32_t texW = texLevel.width;
+			const std::int32_t texH = texLevel.height;
 			const std::int32_t texBpp = (tex != nullptr ? tex->GetBytesPerPixel() : 4);
+			const std::int32_t texBlocksPerRow = texLevel.blocksPerRow;
 			const SamplerWrapping wrapS = (tex != nullptr ? tex->GetWrapS() : SamplerWrapping::ClampToEdge);
 			const SamplerWrapping wrapT = (tex != nullptr ? tex->GetWrapT() : SamplerWrapping::ClampToEdge);
 			const bool useLinear = (tex != nullptr && tex->GetMagFilter() == SamplerFilter::Linear && texW > 1 && texH > 1);
@@ -2330,7 +2348,7 @@ namespace nCine::RHI::Software
 					// Gather texels into scanline buffer
 					if (useLinear) {
 						for (std::int32_t i = 0; i < scanWidth; i++) {
-							SampleBilinearFix(texPixels, texW, texH, texBpp, uFix, vFix, wrapS, wrapT, &scanBuf[i * 4]);
+							SampleBilinearFix(texPixels, texW, texH, texBpp, uFix, vFix, wrapS, wrapT, &scanBuf[i * 4], texBlocksPerRow);
 							uFix += dudxFix;
 							vFix += dvdxFix;
 						}
@@ -2338,7 +2356,7 @@ namespace nCine::RHI::Software
 						for (std::int32_t i = 0; i < scanWidth; i++) {
 							std::int32_t srcX = WrapTexelFix(uFix, texW, wrapS);
 							std::int32_t srcY = WrapTexelFix(vFix, texH, wrapT);
-							SwExpandTexel(&scanBuf[i * 4], texPixels + (static_cast<std::size_t>(srcY) * texW + srcX) * texBpp, texBpp);
+							SwExpandTexel(&scanBuf[i * 4], texPixels + SwTexture::TexelIndex(srcX, srcY, texW, texBlocksPerRow) * texBpp, texBpp);
 							uFix += dudxFix;
 							vFix += dvdxFix;
 						}
@@ -2415,7 +2433,7 @@ namespace nCine::RHI::Software
 							float wu = WrapUV(u, wrapS);
 							float wv = WrapUV(vv, wrapT);
 							std::uint8_t raw[4];
-							SampleBilinearFloat(texPixels, texW, texH, texBpp, wu, wv, wrapS, wrapT, raw);
+							SampleBilinearFloat(texPixels, texW, texH, texBpp, wu, wv, wrapS, wrapT, raw, texBlocksPerRow);
 							sR = raw[0]; sG = raw[1]; sB = raw[2]; sA = raw[3];
 						} else if (texPixels != nullptr) {
 							float wu = WrapUV(u, wrapS);
@@ -2423,7 +2441,7 @@ namespace nCine::RHI::Software
 							std::int32_t srcX = std::max(0, std::min(texW - 1, static_cast<std::int32_t>(wu * (texW - 1) + 0.5f)));
 							std::int32_t srcY = std::max(0, std::min(texH - 1, static_cast<std::int32_t>(wv * (texH - 1) + 0.5f)));
 							std::uint8_t raw[4];
-							SwExpandTexel(raw, texPixels + (srcY * texW + srcX) * texBpp, texBpp);
+							SwExpandTexel(raw, texPixels + SwTexture::TexelIndex(srcX, srcY, texW, texBlocksPerRow) * texBpp, texBpp);
 							sR = raw[0]; sG = raw[1]; sB = raw[2]; sA = raw[3];
 						} else {
 							sR = 255; sG = 255; sB = 255; sA = 255;
@@ -2780,16 +2798,28 @@ namespace nCine::RHI::Software
 			return;
 		}
 
+		const std::uint8_t rb = static_cast<std::uint8_t>(r * 255.0f);
+		const std::uint8_t gb = static_cast<std::uint8_t>(g * 255.0f);
+		const std::uint8_t bb = static_cast<std::uint8_t>(b * 255.0f);
+		const std::uint8_t ab = static_cast<std::uint8_t>(a * 255.0f);
+		const std::uint32_t pattern = static_cast<std::uint32_t>(rb)
+			| (static_cast<std::uint32_t>(gb) << 8)
+			| (static_cast<std::uint32_t>(bb) << 16)
+			| (static_cast<std::uint32_t>(ab) << 24);
+
+		// Let the tile renderer apply the clear at the next flush, so the tiles that end up unchanged since the
+		// previous frame are neither cleared nor rendered again. It drops the draws queued before the clear.
+		if (SwTileRenderer::SubmitClear(pattern)) {
+			return;
+		}
+
 		// A full-buffer clear wipes everything drawn before it, so drop any deferred draws still queued for
 		// this surface rather than letting them re-render on top of the cleared buffer at the next flush.
 		if (SwTileRenderer::GetPendingCommandCount() > 0) {
 			SwTileRenderer::DiscardPending();
 		}
+		SwTileRenderer::InvalidateSurface(g_state.colorBuffer);
 
-		const std::uint8_t rb = static_cast<std::uint8_t>(r * 255.0f);
-		const std::uint8_t gb = static_cast<std::uint8_t>(g * 255.0f);
-		const std::uint8_t bb = static_cast<std::uint8_t>(b * 255.0f);
-		const std::uint8_t ab = static_cast<std::uint8_t>(a * 255.0f);
 		const std::int32_t totalPixels = g_state.bufferWidth * g_state.bufferHeight;
 #if defined(RHI_USE_FB16)
 		if (g_state.is16Bit) {
@@ -2817,11 +2847,7 @@ namespace nCine::RHI::Software
 			// All channels identical: single memset
 			std::memset(g_state.colorBuffer, rb, static_cast<std::size_t>(totalPixels) * 4);
 		} else {
-			// Build 32-bit RGBA pattern and fill using 32-bit writes
-			const std::uint32_t pattern = static_cast<std::uint32_t>(rb)
-				| (static_cast<std::uint32_t>(gb) << 8)
-				| (static_cast<std::uint32_t>(bb) << 16)
-				| (static_cast<std::uint32_t>(ab) << 24);
+			// Fill using 32-bit writes of the RGBA pattern
 			std::uint32_t* dst32 = reinterpret_cast<std::uint32_t*>(g_state.colorBuffer);
 			for (std::int32_t i = 0; i < totalPixels; ++i) {
 				dst32[i] = pattern;
@@ -2856,6 +2882,7 @@ namespace nCine::RHI::Software
 
 		// Fast path: detect fullscreen texture blits and handle with direct memcpy/stretch
 		if (TryFastBlit(*g_state.drawCtx, type, firstVertex, count)) {
+			SwTileRenderer::InvalidateSurface(g_state.colorBuffer);
 			return;
 		}
 
@@ -2870,6 +2897,9 @@ namespace nCine::RHI::Software
 			SwTileRenderer::Flush();
 		}
 
+		// The immediate paths below write the surface behind the tile renderer's back
+		SwTileRenderer::InvalidateSurface(g_state.colorBuffer);
+
 		// Fast path: procedural 4-vertex quad (TriangleStrip, no vertex buffer)
 		if DEATH_LIKELY(type == PrimitiveType::TriangleStrip && count == 4 && firstVertex == 0 &&
 		    g_state.drawCtx->vertexData == nullptr) {
@@ -2894,10 +2924,49 @@ namespace nCine::RHI::Software
 		DrawPrimitive(*g_state.drawCtx, type, indices);
 	}
 
+	void SwRaster::DrawInstances(const QuadInstance* instances, std::int32_t count)
+	{
+		if DEATH_UNLIKELY(g_state.drawCtx == nullptr || count <= 0) return;
+
+		// A batch that could contain a full-screen blit (opaque, plain textured, unscissored) keeps the
+		// per-quad path, so TryFastBlit() still sees every quad of it
+		const DrawContext& ctx = *g_state.drawCtx;
+		const bool mayBlit = (ctx.ff.hasTexture && ctx.fragmentShader == nullptr && !ctx.blendingEnabled && !ctx.scissorEnabled);
+		if (!mayBlit && SwTileRenderer::IsActive() && SwTileRenderer::SubmitInstances(ctx, instances, count)) {
+			return;
+		}
+
+		// Nothing of the batch was queued, so drawing it quad by quad keeps the order
+		DrawContext quadCtx = ctx;
+		for (std::int32_t i = 0; i < count; i++) {
+			const QuadInstance& inst = instances[i];
+			std::memcpy(quadCtx.ff.mvpMatrix, inst.mvpMatrix, sizeof(inst.mvpMatrix));
+			std::memcpy(quadCtx.ff.color, inst.color, sizeof(inst.color));
+			std::memcpy(quadCtx.ff.texRect, inst.texRect, sizeof(inst.texRect));
+			std::memcpy(quadCtx.ff.spriteSize, inst.spriteSize, sizeof(inst.spriteSize));
+			SetDrawContext(quadCtx);
+			Draw(PrimitiveType::TriangleStrip, 0, 4);
+		}
+	}
+
 	void SwRaster::Flush()
 	{
 		SwTileRenderer::Flush();
 	}
+
+#if defined(DEATH_CPU_USE_RUNTIME_DISPATCH) && !defined(DEATH_CPU_USE_IFUNC)
+	void SwRaster::SetCpuFeatures(Cpu::Features features)
+	{
+		// Nothing may be rasterizing with the previous variants while the pointers are swapped
+		SwTileRenderer::Flush();
+
+		blendScanlineSrcAlpha = blendScanlineSrcAlphaImplementation(features);
+		fusedLutBlendScanline = fusedLutBlendScanlineImplementation(features);
+		tintScanline = tintScanlineImplementation(features);
+		blendScanlineConstSrcAlpha = blendScanlineConstSrcAlphaImplementation(features);
+		combineLightingScanline = combineLightingScanlineImplementation(features);
+	}
+#endif
 }
 
 #endif
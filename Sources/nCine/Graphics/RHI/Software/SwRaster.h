@@ -6,9 +6,15 @@
 #include "../RhiTypes.h"
 #include "../../../Primitives/Rect.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <cstring>
 
+#if defined(DEATH_CPU_USE_RUNTIME_DISPATCH) && !defined(DEATH_CPU_USE_IFUNC)
+#	include <Cpu.h>
+#endif
+
 #if defined(DEATH_TARGET_SSE2)
 #	include <emmintrin.h>
 #elif defined(DEATH_TARGET_NEON)
@@ -63,13 +69,8 @@ namespace nCine::RHI::Software
 	*/
 	struct FFState
 	{
-		/** @brief Model-view-projection transform, 4x4 column-major */
-		float mvpMatrix[16] = {
-			1, 0, 0, 0,
-			0, 1, 0, 0,
-			0, 0, 1, 0,
-			0, 0, 0, 1
-		};
+		/** @brief Model-view-projection transform of the quad plane, 2x3 affine as `(m00, m01, m10, m11, tx, ty)` */
+		float mvpMatrix[6] = { 1, 0, 0, 1, 0, 0 };
 		/** @brief Constant color modulation (tint), normalized RGBA */
 		float color[4] = { 1, 1, 1, 1 };
 		/** @brief Sampled sub-rectangle of the texture as `(uScale, uOffset, vScale, vOffset)` */
@@ -84,6 +85,25 @@ namespace nCine::RHI::Software
 		std::int32_t textureUnit = 0;
 	};
 
+	/**
+		@brief Per-instance state of one sprite of a batched draw
+
+		The fields of @ref FFState that differ between the sprites of one batch. Everything else - the
+		textures and the sampled unit, the fragment callback, the blend and scissor state - is shared by the
+		whole batch through the @ref DrawContext it is drawn with, see @ref SwRaster::DrawInstances().
+	*/
+	struct QuadInstance
+	{
+		/** @brief Model-view-projection transform of the quad plane, see @ref FFState::mvpMatrix */
+		float mvpMatrix[6];
+		/** @brief Constant color modulation (tint), normalized RGBA */
+		float color[4];
+		/** @brief Sampled sub-rectangle of the texture as `(uScale, uOffset, vScale, vOffset)` */
+		float texRect[4];
+		/** @brief Sprite size in pixels the procedural quad corners are scaled by */
+		float spriteSize[2];
+	};
+
 	/**
 		@brief Per-pixel inputs handed to an optional C++ fragment callback
 
@@ -403,6 +423,23 @@ namespace nCine::RHI::Software
 		float r, g, b, a;	/**< Vertex color */
 	};
 
+	/**
+		@brief Returns level-0 texels per screen pixel along the more minified side of a quad
+
+		The edge @p v0 - @p v2 is one side of the quad, @p v0 - @p v1 the other. The immediate and the tile path
+		both select the mip level of a quad from it, so they always sample the same level.
+	*/
+	inline float QuadTexelsPerPixel(const Vertex2D& v0, const Vertex2D& v1, const Vertex2D& v2, std::int32_t texW, std::int32_t texH)
+	{
+		auto sideRatio = [texW, texH](const Vertex2D& a, const Vertex2D& b) {
+			const float dx = b.x - a.x, dy = b.y - a.y;
+			const float du = (b.u - a.u) * texW, dv = (b.v - a.v) * texH;
+			const float screenLength = dx * dx + dy * dy;
+			return (screenLength > 0.0f ? std::sqrt((du * du + dv * dv) / screenLength) : 0.0f);
+		};
+		return std::max(sideRatio(v0, v2), sideRatio(v0, v1));
+	}
+
 	/**
 		@brief Everything one draw call needs beyond the persistent render state
 
@@ -523,6 +560,15 @@ namespace nCine::RHI::Software
 		/** @brief Rasterizes @p count vertices from @p firstVertex as @p primitive into the current color buffer */
 		static void Draw(PrimitiveType primitive, std::int32_t firstVertex, std::int32_t count);
 
+		/**
+			@brief Rasterizes @p count procedural sprite quads that share the current draw context
+
+			Each instance replaces the per-sprite fields of the context's @ref FFState. The batch is handed to
+			the tile renderer as a single command when it can be deferred, otherwise every quad is drawn as if
+			by its own @ref Draw() call.
+		*/
+		static void DrawInstances(const QuadInstance* instances, std::int32_t count);
+
 		/**
 			@brief Renders every draw the tile renderer has deferred for the current color buffer
 
@@ -531,6 +577,18 @@ namespace nCine::RHI::Software
 			it does not return until every worker thread has finished writing.
 		*/
 		static void Flush();
+
+#if defined(DEATH_CPU_USE_RUNTIME_DISPATCH) && !defined(DEATH_CPU_USE_IFUNC)
+		/**
+			@brief Rebinds the dispatched scanline kernels to the variants matching @p features
+
+			Only available when the runtime dispatch goes through function pointers (no IFUNC), where the
+			kernels are otherwise bound once to the best variant the CPU supports. Lets a benchmark measure the
+			scalar and the individual SIMD variants in one process. @p features must be a subset of what
+			@ref Death::Cpu::runtimeFeatures() reports.
+		*/
+		static void SetCpuFeatures(Death::Cpu::Features features);
+#endif
 	};
 }
 
@@ -0,0 +1,1375 @@
+#if defined(WITH_RHI_SOFTWARE)
+
+#include "SwRescale.h"
+#include "SwTileRenderer.h"
+#include "../../../tracy.h"
+
+#include <Cpu.h>
+#if defined(DEATH_TARGET_X86)
+#	if defined(DEATH_ENABLE_AVX2)
+#		include <IntrinsicsAvx.h>
+#	elif defined(DEATH_ENABLE_SSE2)
+#		include <IntrinsicsSse2.h>
+#	endif
+#elif defined(DEATH_TARGET_ARM)
+#	if defined(DEATH_ENABLE_NEON)
+#		include <arm_neon.h>
+#	endif
+#elif defined(DEATH_TARGET_WASM)
+#	if defined(DEATH_ENABLE_SIMD128)
+#		include <wasm_simd128.h>
+#	endif
+#endif
+
+#include <Containers/SmallVector.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace Death;
+using namespace Death::Containers;
+
+namespace nCine::RHI::Software
+{
+	// =====================================================================
+	// SIMD-dispatched horizontal Gaussian filter of the Lottes CRT modes
+	//
+	// Same namespace layout as the dispatched scanline ops in SwRaster.cpp, see the comment there.
+	//
+	// One source row of linear RGBA floats is filtered into `srcWidth * scale` output texels. Output texel
+	// `i * scale + p` is the dot product of the `taps` consecutive source texels starting at `src + i * 4` with
+	// the `taps` weights of phase `p`, i.e. the caller offsets `src` by the half-width of the filter. The vector
+	// variants keep the accumulation order of the scalar one (start from zero, then multiply and add tap by
+	// tap, no fused multiply-add), so they produce the same floats.
+	// =====================================================================
+	extern void DEATH_CPU_DISPATCHED_DECLARATION(rescaleConvolveRow)(float* DEATH_RESTRICT dst, const float* DEATH_RESTRICT src, const float* DEATH_RESTRICT weights, std::int32_t taps, std::int32_t scale, std::int32_t srcWidth);
+	DEATH_CPU_DISPATCHER_DECLARATION(rescaleConvolveRow)
+
+	namespace
+	{
+		DEATH_CPU_MAYBE_UNUSED typename std::decay<decltype(rescaleConvolveRow)>::type rescaleConvolveRowImplementation(Cpu::ScalarT) {
+			return [](float* DEATH_RESTRICT dst, const float* DEATH_RESTRICT src, const float* DEATH_RESTRICT weights, std::int32_t taps, std::int32_t scale, std::int32_t srcWidth) {
+				for (std::int32_t i = 0; i < srcWidth; i++) {
+					const float* s = src + i * 4;
+					for (std::int32_t p = 0; p < scale; p++) {
+						const float* w = weights + p * taps;
+						float r = 0.0f, g = 0.0f, b = 0.0f, a = 0.0f;
+						for (std::int32_t k = 0; k < taps; k++) {
+							r = r + w[k] * s[k * 4 + 0];
+							g = g + w[k] * s[k * 4 + 1];
+							b = b + w[k] * s[k * 4 + 2];
+							a = a + w[k] * s[k * 4 + 3];
+						}
+						dst[0] = r;
+						dst[1] = g;
+						dst[2] = b;
+						dst[3] = a;
+						dst += 4;
+					}
+				}
+			};
+		}
+
+#if defined(DEATH_ENABLE_SSE2)
+		DEATH_CPU_MAYBE_UNUSED DEATH_ENABLE_SSE2 typename std::decay<decltype(rescaleConvolveRow)>::type rescaleConvolveRowImplementation(Cpu::Sse2T) {
+			return [](float* DEATH_RESTRICT dst, const float* DEATH_RESTRICT src, const float* DEATH_RESTRICT weights, std::int32_t taps, std::int32_t scale, std::int32_t srcWidth) DEATH_ENABLE_SSE2 {
+				for (std::int32_t i = 0; i < srcWidth; i++) {
+					const float* s = src + i * 4;
+					for (std::int32_t p = 0; p < scale; p++) {
+						const float* w = weights + p * taps;
+						__m128 acc = _mm_setzero_ps();
+						for (std::int32_t k = 0; k < taps; k++) {
+							acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(w[k]), _mm_loadu_ps(s + k * 4)));
+						}
+						_mm_storeu_ps(dst, acc);
+						dst += 4;
+					}
+				}
+			};
+		}
+#endif
+
+#if defined(DEATH_ENABLE_AVX2)
+		DEATH_CPU_MAYBE_UNUSED DEATH_ENABLE_AVX2 typename std::decay<decltype(rescaleConvolveRow)>::type rescaleConvolveRowImplementation(Cpu::Avx2T) {
+			return [](float* DEATH_RESTRICT dst, const float* DEATH_RESTRICT src, const float* DEATH_RESTRICT weights, std::int32_t taps, std::int32_t scale, std::int32_t srcWidth) DEATH_ENABLE_AVX2 {
+				// Two neighbouring phases of the same source texel read the same taps, so they are computed
+				// together, one per 128-bit lane, and stored as two consecutive output texels
+				for (std::int32_t i = 0; i < srcWidth; i++) {
+					const float* s = src + i * 4;
+					std::int32_t p = 0;
+					for (; p + 1 < scale; p += 2) {
+						const float* w0 = weights + p * taps;
+						const float* w1 = w0 + taps;
+						__m256 acc = _mm256_setzero_ps();
+						for (std::int32_t k = 0; k < taps; k++) {
+							__m256 w = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(w0[k])), _mm_set1_ps(w1[k]), 1);
+							__m256 texel = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(s + k * 4));
+							acc = _mm256_add_ps(acc, _mm256_mul_ps(w, texel));
+						}
+						_mm256_storeu_ps(dst, acc);
+						dst += 8;
+					}
+					for (; p < scale; p++) {
+						const float* w = weights + p * taps;
+						__m128 acc = _mm_setzero_ps();
+						for (std::int32_t k = 0; k < taps; k++) {
+							acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(w[k]), _mm_loadu_ps(s + k * 4)));
+						}
+						_mm_storeu_ps(dst, acc);
+						dst += 4;
+					}
+				}
+			};
+		}
+#endif
+
+#if defined(DEATH_ENABLE_NEON)
+		DEATH_CPU_MAYBE_UNUSED DEATH_ENABLE_NEON typename std::decay<decltype(rescaleConvolveRow)>::type rescaleConvolveRowImplementation(Cpu::NeonT) {
+			return [](float* DEATH_RESTRICT dst, const float* DEATH_RESTRICT src, const float* DEATH_RESTRICT weights, std::int32_t taps, std::int32_t scale, std::int32_t srcWidth) DEATH_ENABLE_NEON {
+				for (std::int32_t i = 0; i < srcWidth; i++) {
+					const float* s = src + i * 4;
+					for (std::int32_t p = 0; p < scale; p++) {
+						const float* w = weights + p * taps;
+						float32x4_t acc = vdupq_n_f32(0.0f);
+						for (std::int32_t k = 0; k < taps; k++) {
+							acc = vaddq_f32(acc, vmulq_n_f32(vld1q_f32(s + k * 4), w[k]));
+						}
+						vst1q_f32(dst, acc);
+						dst += 4;
+					}
+				}
+			};
+		}
+#endif
+
+#if defined(DEATH_ENABLE_SIMD128)
+		DEATH_CPU_MAYBE_UNUSED DEATH_ENABLE_SIMD128 typename std::decay<decltype(rescaleConvolveRow)>::type rescaleConvolveRowImplementation(Cpu::Simd128T) {
+			return [](float* DEATH_RESTRICT dst, const float* DEATH_RESTRICT src, const float* DEATH_RESTRICT weights, std::int32_t taps, std::int32_t scale, std::int32_t srcWidth) DEATH_ENABLE_SIMD128 {
+				for (std::int32_t i = 0; i < srcWidth; i++) {
+					const float* s = src + i * 4;
+					for (std::int32_t p = 0; p < scale; p++) {
+						const float* w = weights + p * taps;
+						v128_t acc = wasm_f32x4_splat(0.0f);
+						for (std::int32_t k = 0; k < taps; k++) {
+							acc = wasm_f32x4_add(acc, wasm_f32x4_mul(wasm_f32x4_splat(w[k]), wasm_v128_load(s + k * 4)));
+						}
+						wasm_v128_store(dst, acc);
+						dst += 4;
+					}
+				}
+			};
+		}
+#endif
+	}
+
+	DEATH_CPU_DISPATCHER_BASE(rescaleConvolveRowImplementation)
+	DEATH_CPU_DISPATCHED(rescaleConvolveRowImplementation, void DEATH_CPU_DISPATCHED_DECLARATION(rescaleConvolveRow)(float* DEATH_RESTRICT dst, const float* DEATH_RESTRICT src, const float* DEATH_RESTRICT weights, std::int32_t taps, std::int32_t scale, std::int32_t srcWidth))({
+		return rescaleConvolveRowImplementation(Cpu::DefaultBase)(dst, src, weights, taps, scale, srcWidth);
+	})
+
+	// =====================================================================
+	// SIMD-dispatched vertical Gaussian filter of the Lottes CRT modes
+	//
+	// `dst[j]` is the weighted sum of `rows[r][j]` over all rows, for `count` floats (a multiple of 4). The
+	// accumulation order matches the scalar variant, see rescaleConvolveRow above.
+	// =====================================================================
+	extern void DEATH_CPU_DISPATCHED_DECLARATION(rescaleAccumulateRows)(float* DEATH_RESTRICT dst, const float* const* DEATH_RESTRICT rows, const float* DEATH_RESTRICT weights, std::int32_t rowCount, std::int32_t count);
+	DEATH_CPU_DISPATCHER_DECLARATION(rescaleAccumulateRows)
+
+	namespace
+	{
+		DEATH_CPU_MAYBE_UNUSED typename std::decay<decltype(rescaleAccumulateRows)>::type rescaleAccumulateRowsImplementation(Cpu::ScalarT) {
+			return [](float* DEATH_RESTRICT dst, const float* const* DEATH_RESTRICT rows, const float* DEATH_RESTRICT weights, std::int32_t rowCount, std::int32_t count) {
+				for (std::int32_t j = 0; j < count; j++) {
+					float acc = 0.0f;
+					for (std::int32_t r = 0; r < rowCount; r++) {
+						acc = acc + weights[r] * rows[r][j];
+					}
+					dst[j] = acc;
+				}
+			};
+		}
+
+#if defined(DEATH_ENABLE_SSE2)
+		DEATH_CPU_MAYBE_UNUSED DEATH_ENABLE_SSE2 typename std::decay<decltype(rescaleAccumulateRows)>::type rescaleAccumulateRowsImplementation(Cpu::Sse2T) {
+			return [](float* DEATH_RESTRICT dst, const float* const* DEATH_RESTRICT rows, const float* DEATH_RESTRICT weights, std::int32_t rowCount, std::int32_t count) DEATH_ENABLE_SSE2 {
+				for (std::int32_t j = 0; j < count; j += 4) {
+					__m128 acc = _mm_setzero_ps();
+					for (std::int32_t r = 0; r < rowCount; r++) {
+						acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(weights[r]), _mm_loadu_ps(rows[r] + j)));
+					}
+					_mm_storeu_ps(dst + j, acc);
+				}
+			};
+		}
+#endif
+
+#if defined(DEATH_ENABLE_AVX2)
+		DEATH_CPU_MAYBE_UNUSED DEATH_ENABLE_AVX2 typename std::decay<decltype(rescaleAccumulateRows)>::type rescaleAccumulateRowsImplementation(Cpu::Avx2T) {
+			return [](float* DEATH_RESTRICT dst, const float* const* DEATH_RESTRICT rows, const float* DEATH_RESTRICT weights, std::int32_t rowCount, std::int32_t count) DEATH_ENABLE_AVX2 {
+				std::int32_t j = 0;
+				for (; j + 8 <= count; j += 8) {
+					__m256 acc = _mm256_setzero_ps();
+					for (std::int32_t r = 0; r < rowCount; r++) {
+						acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_set1_ps(weights[r]), _mm256_loadu_ps(rows[r] + j)));
+					}
+					_mm256_storeu_ps(dst + j, acc);
+				}
+				for (; j < count; j += 4) {
+					__m128 acc = _mm_setzero_ps();
+					for (std::int32_t r = 0; r < rowCount; r++) {
+						acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(weights[r]), _mm_loadu_ps(rows[r] + j)));
+					}
+					_mm_storeu_ps(dst + j, acc);
+				}
+			};
+		}
+#endif
+
+#if defined(DEATH_ENABLE_NEON)
+		DEATH_CPU_MAYBE_UNUSED DEATH_ENABLE_NEON typename std::decay<decltype(rescaleAccumulateRows)>::type rescaleAccumulateRowsImplementation(Cpu::NeonT) {
+			return [](float* DEATH_RESTRICT dst, const float* const* DEATH_RESTRICT rows, const float* DEATH_RESTRICT weights, std::int32_t rowCount, std::int32_t count) DEATH_ENABLE_NEON {
+				for (std::int32_t j = 0; j < count; j += 4) {
+					float32x4_t acc = vdupq_n_f32(0.0f);
+					for (std::int32_t r = 0; r < rowCount; r++) {
+						acc = vaddq_f32(acc, vmulq_n_f32(vld1q_f32(rows[r] + j), weights[r]));
+					}
+					vst1q_f32(dst + j, acc);
+				}
+			};
+		}
+#endif
+
+#if defined(DEATH_ENABLE_SIMD128)
+		DEATH_CPU_MAYBE_UNUSED DEATH_ENABLE_SIMD128 typename std::decay<decltype(rescaleAccumulateRows)>::type rescaleAccumulateRowsImplementation(Cpu::Simd128T) {
+			return [](float* DEATH_RESTRICT dst, const float* const* DEATH_RESTRICT rows, const float* DEATH_RESTRICT weights, std::int32_t rowCount, std::int32_t count) DEATH_ENABLE_SIMD128 {
+				for (std::int32_t j = 0; j < count; j += 4) {
+					v128_t acc = wasm_f32x4_splat(0.0f);
+					for (std::int32_t r = 0; r < rowCount; r++) {
+						acc = wasm_f32x4_add(acc, wasm_f32x4_mul(wasm_f32x4_splat(weights[r]), wasm_v128_load(rows[r] + j)));
+					}
+					wasm_v128_store(dst + j, acc);
+				}
+			};
+		}
+#endif
+	}
+
+	DEATH_CPU_DISPATCHER_BASE(rescaleAccumulateRowsImplementation)
+	DEATH_CPU_DISPATCHED(rescaleAccumulateRowsImplementation, void DEATH_CPU_DISPATCHED_DECLARATION(rescaleAccumulateRows)(float* DEATH_RESTRICT dst, const float* const* DEATH_RESTRICT rows, const float* DEATH_RESTRICT weights, std::int32_t rowCount, std::int32_t count))({
+		return rescaleAccumulateRowsImplementation(Cpu::DefaultBase)(dst, rows, weights, rowCount, count);
+	})
+
+	// =========================================================================
+	// Filter state
+	// =========================================================================
+	namespace
+	{
+		// Clamped border around the source copy, the widest footprint (xBRZ, SABR, CleanEdge) is 5x5
+		constexpr std::int32_t Padding = 2;
+		// Border of the linear rows of the Lottes CRT modes, the bloom filter has 7 taps
+		constexpr std::int32_t CrtPadding = 3;
+		constexpr std::int32_t MaxScale = 4;
+		constexpr std::int32_t SrgbLutSize = 4096;
+
+		struct CrtParams
+		{
+			float hardScan;
+			float hardPix;
+			float hardBloomScan;
+			float hardBloomPix;
+			float maskDark;
+			float maskLight;
+			float brightBoost;
+			float bloomAmount;
+			bool apertureGrille;
+		};
+
+		// Parameters of ResizeCrtShadowMask.shader and ResizeCrtApertureGrille.shader
+		constexpr CrtParams ShadowMaskParams = { -6.0f, -3.0f, -2.0f, -1.5f, 0.55f, 1.5f, 1.0f, 1.0f / 12.0f, false };
+		constexpr CrtParams ApertureGrilleParams = { -8.0f, -3.0f, -2.0f, -1.5f, 0.7f, 1.5f, 1.1f, 1.0f / 16.0f, true };
+
+		struct RescaleState
+		{
+			// RGBA8 copy of the source with `Padding` clamped pixels on each side
+			SmallVector<std::uint8_t, 0> padded;
+			std::int32_t paddedStride = 0;		// In pixels
+			std::int32_t width = 0;
+			std::int32_t height = 0;
+			std::int32_t scale = 1;
+			std::uint8_t* dst = nullptr;
+			std::int32_t dstStride = 0;			// In bytes
+
+			// SABR - blend amount of each output phase, per rule (45, 30, 60, 30+60, relaxed) and corner
+			float sabrBlend[MaxScale * MaxScale][5][4];
+			std::int32_t sabrScale = 0;
+
+			// Lottes CRT
+			const CrtParams* crt = nullptr;
+			SmallVector<float, 0> crtLinear;	// Linear RGBA, `CrtPadding` clamped texels on each side
+			SmallVector<float, 0> crtHorz3;		// Horizontally filtered rows at the output width
+			SmallVector<float, 0> crtHorz5;
+			SmallVector<float, 0> crtHorz7;
+			SmallVector<float, 0> crtScratch;	// One output row of floats per worker slot
+			float crtWeights3[MaxScale * 3];
+			float crtWeights5[MaxScale * 5];
+			float crtWeights7[MaxScale * 7];
+			float crtRowWeights[MaxScale][8];
+			float crtLinearLut[256];
+			float crtLinearLutBoost = -1.0f;
+			std::uint8_t crtSrgbLut[SrgbLutSize + 1];
+			bool crtSrgbLutReady = false;
+
+			// CRT scanlines - luma boost in YIQ space folded into one matrix
+			float scanlineMatrix[3][3];
+			bool scanlineMatrixReady = false;
+		};
+
+		RescaleState g_rescale;
+
+		struct Rgb
+		{
+			float r, g, b;
+		};
+
+		inline Rgb operator+(const Rgb& a, const Rgb& b) {
+			return { a.r + b.r, a.g + b.g, a.b + b.b };
+		}
+		inline Rgb operator-(const Rgb& a, const Rgb& b) {
+			return { a.r - b.r, a.g - b.g, a.b - b.b };
+		}
+		inline Rgb operator*(const Rgb& a, float s) {
+			return { a.r * s, a.g * s, a.b * s };
+		}
+		inline Rgb operator*(float s, const Rgb& a) {
+			return { a.r * s, a.g * s, a.b * s };
+		}
+		inline float Sum(const Rgb& a) {
+			return a.r + a.g + a.b;
+		}
+		inline float AbsDiffSum(const Rgb& a, const Rgb& b) {
+			return std::abs(a.r - b.r) + std::abs(a.g - b.g) + std::abs(a.b - b.b);
+		}
+		inline Rgb Mix(const Rgb& a, const Rgb& b, float t) {
+			return a * (1.0f - t) + b * t;
+		}
+
+		inline std::uint8_t ToByte(float v) {
+			return (v <= 0.0f ? 0 : (v >= 1.0f ? 255 : (std::uint8_t)(v * 255.0f + 0.5f)));
+		}
+
+		inline void StoreOpaque(std::uint8_t* dst, const Rgb& c) {
+			dst[0] = ToByte(c.r);
+			dst[1] = ToByte(c.g);
+			dst[2] = ToByte(c.b);
+			dst[3] = 255;
+		}
+
+		inline const std::uint8_t* TexelAt(const RescaleState& s, std::int32_t x, std::int32_t y) {
+			return s.padded.data() + ((std::size_t)(y + Padding) * s.paddedStride + (x + Padding)) * 4;
+		}
+
+		inline Rgb FetchRgb(const RescaleState& s, std::int32_t x, std::int32_t y) {
+			const std::uint8_t* p = TexelAt(s, x, y);
+			return { p[0] * (1.0f / 255.0f), p[1] * (1.0f / 255.0f), p[2] * (1.0f / 255.0f) };
+		}
+
+		inline std::uint32_t FetchPacked(const RescaleState& s, std::int32_t x, std::int32_t y) {
+			std::uint32_t value;
+			std::memcpy(&value, TexelAt(s, x, y), 4);
+			return value;
+		}
+
+		inline std::uint8_t* OutputAt(const RescaleState& s, std::int32_t x, std::int32_t y) {
+			return s.dst + (std::size_t)y * s.dstStride + (std::size_t)x * 4;
+		}
+
+		void PreparePaddedSource(RescaleState& s, const std::uint8_t* src, std::int32_t srcStride)
+		{
+			s.paddedStride = s.width + Padding * 2;
+			s.padded.resize_for_overwrite((std::size_t)s.paddedStride * (s.height + Padding * 2) * 4);
+
+			for (std::int32_t y = -Padding; y < s.height + Padding; y++) {
+				const std::uint8_t* srcRow = src + (std::size_t)std::clamp(y, 0, s.height - 1) * srcStride;
+				std::uint8_t* row = s.padded.data() + (std::size_t)(y + Padding) * s.paddedStride * 4;
+				for (std::int32_t x = 0; x < Padding; x++) {
+					std::memcpy(row + x * 4, srcRow, 4);
+					std::memcpy(row + (Padding + s.width + x) * 4, srcRow + (s.width - 1) * 4, 4);
+				}
+				std::memcpy(row + Padding * 4, srcRow, (std::size_t)s.width * 4);
+			}
+		}
+
+		// =====================================================================
+		// HQ2x (ResizeHQ2x.shader)
+		//
+		// The shader samples half a texel around the output pixel, which at 2x resolves to the center texel
+		// and its neighbours on the side of the output subpixel.
+		// =====================================================================
+		void Hq2xRow(std::int32_t y, std::int32_t workerSlot, void* userData)
+		{
+			constexpr float Mx = 0.325f, K = -0.25f, MaxW = 0.25f, MinW = -0.05f, LumAdd = 0.25f;
+
+			const RescaleState& s = *static_cast<const RescaleState*>(userData);
+			for (std::int32_t x = 0; x < s.width; x++) {
+				Rgb n[3][3];
+				for (std::int32_t dy = 0; dy < 3; dy++) {
+					for (std::int32_t dx = 0; dx < 3; dx++) {
+						n[dy][dx] = FetchRgb(s, x + dx - 1, y + dy - 1);
+					}
+				}
+
+				for (std::int32_t b = 0; b < 2; b++) {
+					std::uint8_t* out = OutputAt(s, x * 2, y * 2 + b);
+					for (std::int32_t a = 0; a < 2; a++) {
+						const Rgb& c00 = n[b][a];
+						const Rgb& c10 = n[b][1];
+						const Rgb& c20 = n[b][1 + a];
+						const Rgb& c01 = n[1][a];
+						const Rgb& c11 = n[1][1];
+						const Rgb& c21 = n[1][1 + a];
+						const Rgb& c02 = n[1 + b][a];
+						const Rgb& c12 = n[1 + b][1];
+						const Rgb& c22 = n[1 + b][1 + a];
+
+						float md1 = AbsDiffSum(c00, c22);
+						float md2 = AbsDiffSum(c02, c20);
+
+						float w1 = AbsDiffSum(c22, c11) * md2;
+						float w2 = AbsDiffSum(c02, c11) * md1;
+						float w3 = AbsDiffSum(c00, c11) * md2;
+						float w4 = AbsDiffSum(c20, c11) * md1;
+
+						float t1 = w1 + w3;
+						float t2 = w2 + w4;
+						float ww = std::max(t1, t2) + 0.0001f;
+
+						Rgb cx = (w1 * c00 + w2 * c20 + w3 * c22 + w4 * c02 + ww * c11) * (1.0f / (t1 + t2 + ww));
+
+						float lc1 = K / (0.12f * Sum(c10 + c12 + cx) + LumAdd);
+						float lc2 = K / (0.12f * Sum(c01 + c21 + cx) + LumAdd);
+
+						w1 = std::clamp(lc1 * AbsDiffSum(cx, c10) + Mx, MinW, MaxW);
+						w2 = std::clamp(lc2 * AbsDiffSum(cx, c21) + Mx, MinW, MaxW);
+						w3 = std::clamp(lc1 * AbsDiffSum(cx, c12) + Mx, MinW, MaxW);
+						w4 = std::clamp(lc2 * AbsDiffSum(cx, c01) + Mx, MinW, MaxW);
+
+						StoreOpaque(out + a * 4, w1 * c10 + w2 * c21 + w3 * c12 + w4 * c01 + (1.0f - w1 - w2 - w3 - w4) * cx);
+					}
+				}
+			}
+		}
+
+		// =====================================================================
+		// xBRZ 3x (Resize3xBrz.shader)
+		//
+		// The blend rules and the 3x3 output block are evaluated once per source texel instead of once per
+		// output pixel. Colors are compared for exact equality on their packed RGB value (`Reduce()` in the
+		// shader).
+		// =====================================================================
+		enum : std::int32_t {
+			BlendNone = 0,
+			BlendNormal = 1,
+			BlendDominant = 2
+		};
+
+		struct XbrzPixel
+		{
+			Rgb c;
+			std::uint32_t key;
+		};
+
+		inline float DistYCbCr(const Rgb& a, const Rgb& b) {
+			constexpr float WR = 0.2627f, WG = 0.6780f, WB = 0.0593f;
+			constexpr float ScaleB = 0.5f / (1.0f - WB);
+			constexpr float ScaleR = 0.5f / (1.0f - WR);
+			Rgb diff = a - b;
+			float y = diff.r * WR + diff.g * WG + diff.b * WB;
+			float cb = ScaleB * (diff.b - y);
+			float cr = ScaleR * (diff.r - y);
+			return std::sqrt(y * y + cb * cb + cr * cr);
+		}
+
+		inline bool IsPixEqual(const Rgb& a, const Rgb& b) {
+			return (DistYCbCr(a, b) < 30.0f / 255.0f);
+		}
+
+		void XbrzScalePixel(const std::int32_t blend[4], const XbrzPixel* k[9], Rgb dst[9])
+		{
+			constexpr float SteepDirectionThreshold = 2.2f;
+
+			if (blend[2] == BlendNone) {
+				return;
+			}
+
+			float dist_01_04 = DistYCbCr(k[1]->c, k[4]->c);
+			float dist_03_08 = DistYCbCr(k[3]->c, k[8]->c);
+			bool haveShallowLine = (SteepDirectionThreshold * dist_01_04 <= dist_03_08) && (k[0]->key != k[4]->key) && (k[5]->key != k[4]->key);
+			bool haveSteepLine = (SteepDirectionThreshold * dist_03_08 <= dist_01_04) && (k[0]->key != k[8]->key) && (k[7]->key != k[8]->key);
+
+			bool doLineBlend = (blend[2] >= BlendDominant ||
+				!((blend[1] != BlendNone && !IsPixEqual(k[0]->c, k[4]->c)) ||
+				  (blend[3] != BlendNone && !IsPixEqual(k[0]->c, k[8]->c)) ||
+				  (IsPixEqual(k[4]->c, k[3]->c) && IsPixEqual(k[3]->c, k[2]->c) && IsPixEqual(k[2]->c, k[1]->c) && IsPixEqual(k[1]->c, k[8]->c) && !IsPixEqual(k[0]->c, k[2]->c))));
+
+			Rgb blendPix = (DistYCbCr(k[0]->c, k[1]->c) <= DistYCbCr(k[0]->c, k[3]->c) ? k[1]->c : k[3]->c);
+			if (doLineBlend) {
+				dst[1] = Mix(dst[1], blendPix, haveSteepLine ? 0.750f : (haveShallowLine ? 0.250f : 0.125f));
+				dst[2] = Mix(dst[2], blendPix, (!haveShallowLine && !haveSteepLine) ? 0.875f : 1.000f);
+				dst[3] = Mix(dst[3], blendPix, haveShallowLine ? 0.750f : (haveSteepLine ? 0.250f : 0.125f));
+				if (haveShallowLine) {
+					dst[4] = Mix(dst[4], blendPix, 0.250f);
+				}
+				if (haveSteepLine) {
+					dst[8] = Mix(dst[8], blendPix, 0.250f);
+				}
+			} else {
+				dst[2] = Mix(dst[2], blendPix, 0.4545939598f);
+			}
+		}
+
+		inline void XbrzRotateDst(Rgb dst[9])
+		{
+			Rgb tempDst8 = dst[8];
+			Rgb tempDst7 = dst[7];
+			dst[8] = dst[6];
+			dst[7] = dst[5];
+			dst[6] = dst[4];
+			dst[5] = dst[3];
+			dst[4] = dst[2];
+			dst[3] = dst[1];
+			dst[2] = tempDst8;
+			dst[1] = tempDst7;
+		}
+
+		// Blend type of a corner, the edge runs across the corner if the color gradient along it is weaker
+		inline std::int32_t XbrzCornerBlend(float distAlong, float distAcross, bool differsFromNeighbours)
+		{
+			constexpr float DominantDirectionThreshold = 3.6f;
+			if (!(distAcross < distAlong) || !differsFromNeighbours) {
+				return BlendNone;
+			}
+			return ((DominantDirectionThreshold * distAcross) < distAlong ? BlendDominant : BlendNormal);
+		}
+
+		void XbrzRow(std::int32_t y, std::int32_t workerSlot, void* userData)
+		{
+			// Offsets of the shader's `src[]` samples, unused indices are never read
+			static constexpr std::int8_t Offsets[24][2] = {
+				{ 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 }, { -1, 1 }, { -1, 0 }, { -1, -1 }, { 0, -1 },
+				{ 1, -1 }, { 2, -1 }, { 2, 0 }, { 2, 1 }, { 0, 0 }, { 1, 2 }, { 0, 2 }, { -1, 2 },
+				{ 0, 0 }, { -2, 1 }, { -2, 0 }, { -2, -1 }, { 0, 0 }, { -1, -2 }, { 0, -2 }, { 1, -2 }
+			};
+
+			const RescaleState& s = *static_cast<const RescaleState*>(userData);
+			for (std::int32_t x = 0; x < s.width; x++) {
+				XbrzPixel src[24];
+				for (std::int32_t i = 0; i < 24; i++) {
+					const std::uint8_t* p = TexelAt(s, x + Offsets[i][0], y + Offsets[i][1]);
+					src[i].c = { p[0] * (1.0f / 255.0f), p[1] * (1.0f / 255.0f), p[2] * (1.0f / 255.0f) };
+					src[i].key = (std::uint32_t)p[0] | ((std::uint32_t)p[1] << 8) | ((std::uint32_t)p[2] << 16);
+				}
+
+				auto v = [&src](std::int32_t i) { return src[i].key; };
+				auto dist = [&src](std::int32_t a, std::int32_t b) { return DistYCbCr(src[a].c, src[b].c); };
+
+				std::int32_t blendResult[4] = { BlendNone, BlendNone, BlendNone, BlendNone };
+				if (!((v(0) == v(1) && v(3) == v(2)) || (v(0) == v(3) && v(1) == v(2)))) {
+					float dist_03_01 = dist(4, 0) + dist(0, 8) + dist(14, 2) + dist(2, 10) + (4.0f * dist(3, 1));
+					float dist_00_02 = dist(5, 3) + dist(3, 13) + dist(7, 1) + dist(1, 11) + (4.0f * dist(0, 2));
+					blendResult[2] = XbrzCornerBlend(dist_00_02, dist_03_01, v(0) != v(1) && v(0) != v(3));
+				}
+				if (!((v(5) == v(0) && v(4) == v(3)) || (v(5) == v(4) && v(0) == v(3)))) {
+					float dist_04_00 = dist(17, 5) + dist(5, 7) + dist(15, 3) + dist(3, 1) + (4.0f * dist(4, 0));
+					float dist_05_03 = dist(18, 4) + dist(4, 14) + dist(6, 0) + dist(0, 2) + (4.0f * dist(5, 3));
+					blendResult[3] = XbrzCornerBlend(dist_04_00, dist_05_03, v(0) != v(5) && v(0) != v(3));
+				}
+				if (!((v(7) == v(8) && v(0) == v(1)) || (v(7) == v(0) && v(8) == v(1)))) {
+					float dist_00_08 = dist(5, 7) + dist(7, 23) + dist(3, 1) + dist(1, 9) + (4.0f * dist(0, 8));
+					float dist_07_01 = dist(6, 0) + dist(0, 2) + dist(22, 8) + dist(8, 10) + (4.0f * dist(7, 1));
+					blendResult[1] = XbrzCornerBlend(dist_00_08, dist_07_01, v(0) != v(7) && v(0) != v(1));
+				}
+				if (!((v(6) == v(7) && v(5) == v(0)) || (v(6) == v(5) && v(7) == v(0)))) {
+					float dist_05_07 = dist(18, 6) + dist(6, 22) + dist(4, 0) + dist(0, 8) + (4.0f * dist(5, 7));
+					float dist_06_00 = dist(19, 5) + dist(5, 3) + dist(21, 7) + dist(7, 1) + (4.0f * dist(6, 0));
+					blendResult[0] = XbrzCornerBlend(dist_06_00, dist_05_07, v(0) != v(5) && v(0) != v(7));
+				}
+
+				Rgb dst[9];
+				for (std::int32_t i = 0; i < 9; i++) {
+					dst[i] = src[0].c;
+				}
+
+				if (blendResult[0] != BlendNone || blendResult[1] != BlendNone || blendResult[2] != BlendNone || blendResult[3] != BlendNone) {
+					// The kernel is rotated by 90 degrees for each corner, together with the output block
+					static constexpr std::int8_t Rotations[4][9] = {
+						{ 0, 1, 2, 3, 4, 5, 6, 7, 8 },
+						{ 0, 7, 8, 1, 2, 3, 4, 5, 6 },
+						{ 0, 5, 6, 7, 8, 1, 2, 3, 4 },
+						{ 0, 3, 4, 5, 6, 7, 8, 1, 2 }
+					};
+					for (std::int32_t rotation = 0; rotation < 4; rotation++) {
+						const XbrzPixel* k[9];
+						for (std::int32_t i = 0; i < 9; i++) {
+							k[i] = &src[Rotations[rotation][i]];
+						}
+						std::int32_t blend[4];
+						for (std::int32_t i = 0; i < 4; i++) {
+							blend[i] = blendResult[(i - rotation + 4) & 3];
+						}
+						XbrzScalePixel(blend, k, dst);
+						XbrzRotateDst(dst);
+					}
+				}
+
+				static constexpr std::int8_t Layout[3][3] = { { 6, 7, 8 }, { 5, 0, 1 }, { 4, 3, 2 } };
+				for (std::int32_t py = 0; py < 3; py++) {
+					std::uint8_t* out = OutputAt(s, x * 3, y * 3 + py);
+					for (std::int32_t px = 0; px < 3; px++) {
+						StoreOpaque(out + px * 4, dst[Layout[py][px]]);
+					}
+				}
+			}
+		}
+
+		// =====================================================================
+		// SABR (ResizeSabr.shader)
+		//
+		// The edge rules only depend on the source texel, so they are evaluated once per texel and select one of
+		// the precomputed per-phase blend amounts of each corner.
+		// =====================================================================
+		enum : std::int8_t {
+			SabrRule45 = 0,
+			SabrRule30 = 1,
+			SabrRule60 = 2,
+			SabrRule36 = 3,
+			SabrRuleRelaxed = 4,
+			SabrRuleNone = -1
+		};
+
+		inline float SmoothStep(float edge0, float edge1, float x) {
+			float t = std::clamp((x - edge0) / (edge1 - edge0), 0.0f, 1.0f);
+			return t * t * (3.0f - 2.0f * t);
+		}
+
+		void PrepareSabrTables(RescaleState& s)
+		{
+			static constexpr float Ai[4] = { 1.0f, -1.0f, -1.0f, 1.0f };
+			static constexpr float B45[4] = { 1.0f, 1.0f, -1.0f, -1.0f };
+			static constexpr float C45[4] = { 1.5f, 0.5f, -0.5f, 0.5f };
+			static constexpr float B30[4] = { 0.5f, 2.0f, -0.5f, -2.0f };
+			static constexpr float C30[4] = { 1.0f, 1.0f, -0.5f, 0.0f };
+			static constexpr float B60[4] = { 2.0f, 0.5f, -2.0f, -0.5f };
+			static constexpr float C60[4] = { 2.0f, 0.0f, -1.0f, 0.5f };
+			static constexpr float M45[4] = { 0.4f, 0.4f, 0.4f, 0.4f };
+			static constexpr float M30[4] = { 0.2f, 0.4f, 0.2f, 0.4f };
+			static constexpr float M60[4] = { 0.4f, 0.2f, 0.4f, 0.2f };
+			constexpr float Mshift = 0.2f;
+
+			if (s.sabrScale == s.scale) {
+				return;
+			}
+			s.sabrScale = s.scale;
+
+			for (std::int32_t py = 0; py < s.scale; py++) {
+				for (std::int32_t px = 0; px < s.scale; px++) {
+					float fx = (px + 0.5f) / s.scale;
+					float fy = (py + 0.5f) / s.scale;
+					float (&blend)[5][4] = s.sabrBlend[py * s.scale + px];
+					for (std::int32_t c = 0; c < 4; c++) {
+						float ma45 = SmoothStep(C45[c] - M45[c], C45[c] + M45[c], Ai[c] * fy + B45[c] * fx);
+						float ma30 = SmoothStep(C30[c] - M30[c], C30[c] + M30[c], Ai[c] * fy + B30[c] * fx);
+						float ma60 = SmoothStep(C60[c] - M60[c], C60[c] + M60[c], Ai[c] * fy + B60[c] * fx);
+						float marn = SmoothStep(C45[c] - M45[c] + Mshift, C45[c] + M45[c] + Mshift, Ai[c] * fy + B45[c] * fx);
+						blend[SabrRule45][c] = ma45;
+						blend[SabrRule30][c] = ma30;
+						blend[SabrRule60][c] = ma60;
+						blend[SabrRule36][c] = std::max(ma30, ma60);
+						blend[SabrRuleRelaxed][c] = marn;
+					}
+				}
+			}
+		}
+
+		void SabrRow(std::int32_t y, std::int32_t workerSlot, void* userData)
+		{
+			constexpr float Coef = 2.0f;
+			constexpr float Threshold = 0.32f;
+
+			const RescaleState& s = *static_cast<const RescaleState*>(userData);
+			for (std::int32_t x = 0; x < s.width; x++) {
+				Rgb P1 = FetchRgb(s, x - 1, y - 2), P2 = FetchRgb(s, x, y - 2), P3 = FetchRgb(s, x + 1, y - 2);
+				Rgb P6 = FetchRgb(s, x - 1, y - 1), P7 = FetchRgb(s, x, y - 1), P8 = FetchRgb(s, x + 1, y - 1);
+				Rgb P11 = FetchRgb(s, x - 1, y), P12 = FetchRgb(s, x, y), P13 = FetchRgb(s, x + 1, y);
+				Rgb P16 = FetchRgb(s, x - 1, y + 1), P17 = FetchRgb(s, x, y + 1), P18 = FetchRgb(s, x + 1, y + 1);
+				Rgb P21 = FetchRgb(s, x - 1, y + 2), P22 = FetchRgb(s, x, y + 2), P23 = FetchRgb(s, x + 1, y + 2);
+				Rgb P5 = FetchRgb(s, x - 2, y - 1), P10 = FetchRgb(s, x - 2, y), P15 = FetchRgb(s, x - 2, y + 1);
+				Rgb P9 = FetchRgb(s, x + 2, y - 1), P14 = FetchRgb(s, x + 2, y), P19 = FetchRgb(s, x + 2, y + 1);
+
+				auto lum = [](const Rgb& c) { return c.r * 0.21f + c.g * 0.72f + c.b * 0.07f; };
+				float L1 = lum(P1), L2 = lum(P2), L3 = lum(P3), L5 = lum(P5), L6 = lum(P6), L7 = lum(P7), L8 = lum(P8);
+				float L9 = lum(P9), L10 = lum(P10), L11 = lum(P11), L12 = lum(P12), L13 = lum(P13), L14 = lum(P14);
+				float L15 = lum(P15), L16 = lum(P16), L17 = lum(P17), L18 = lum(P18), L19 = lum(P19);
+				float L21 = lum(P21), L22 = lum(P22), L23 = lum(P23);
+
+				// Luminances of the four corners, in the shader's component order
+				const float p7[4] = { L7, L11, L17, L13 };
+				const float p8[4] = { L8, L6, L16, L18 };
+				const float p11[4] = { L11, L17, L13, L7 };
+				const float p13[4] = { L13, L7, L11, L17 };
+				const float p14[4] = { L14, L2, L10, L22 };
+				const float p16[4] = { L16, L18, L8, L6 };
+				const float p17[4] = { L17, L13, L7, L11 };
+				const float p18[4] = { L18, L8, L6, L16 };
+				const float p19[4] = { L19, L3, L5, L21 };
+				const float p22[4] = { L22, L14, L2, L10 };
+				const float p23[4] = { L23, L9, L1, L15 };
+				const float p12 = L12;
+
+				auto eq = [](float a, float b) { return std::abs(a - b) < Threshold; };
+
+				std::int8_t rules[4];
+				bool px[4];
+				bool anyRule = false;
+				for (std::int32_t c = 0; c < 4; c++) {
+					float e45 = std::abs(p12 - p8[c]) + std::abs(p12 - p16[c]) + std::abs(p18[c] - p22[c]) + std::abs(p18[c] - p14[c]) + 4.0f * std::abs(p17[c] - p13[c]);
+					float econt = std::abs(p17[c] - p11[c]) + std::abs(p17[c] - p23[c]) + std::abs(p13[c] - p7[c]) + std::abs(p13[c] - p19[c]) + 4.0f * std::abs(p12 - p18[c]);
+					float e30 = std::abs(p13[c] - p16[c]);
+					float e60 = std::abs(p8[c] - p17[c]);
+
+					bool r45_1 = (p12 != p13[c] && p12 != p17[c]);
+					bool r45_2 = (!eq(p13[c], p7[c]) && !eq(p13[c], p8[c]));
+					bool r45_3 = (!eq(p17[c], p11[c]) && !eq(p17[c], p16[c]));
+					bool r45_4_1 = (!eq(p13[c], p14[c]) && !eq(p13[c], p19[c]));
+					bool r45_4_2 = (!eq(p17[c], p22[c]) && !eq(p17[c], p23[c]));
+					bool r45_4 = (eq(p12, p18[c]) && (r45_4_1 || r45_4_2));
+					bool r45_5 = (eq(p12, p16[c]) || eq(p12, p8[c]));
+					bool r45 = (r45_1 && (r45_2 || r45_3 || r45_4 || r45_5));
+					bool r30 = (p12 != p16[c] && p11[c] != p16[c]);
+					bool r60 = (p12 != p8[c] && p7[c] != p8[c]);
+
+					bool edr45 = (e45 < econt && r45);
+					bool edrrn = (e45 <= econt);
+					bool edr30 = (Coef * e30 <= e60 && r30);
+					bool edr60 = (Coef * e60 <= e30 && r60);
+
+					std::int8_t rule = SabrRuleNone;
+					if (edr45) {
+						rule = (edr30 ? (edr60 ? SabrRule36 : SabrRule30) : (edr60 ? SabrRule60 : SabrRule45));
+					} else if (edrrn) {
+						rule = SabrRuleRelaxed;
+					}
+					rules[c] = rule;
+					anyRule |= (rule != SabrRuleNone);
+
+					px[c] = (std::abs(p12 - p13[c]) >= std::abs(p12 - p17[c]));
+				}
+
+				if (!anyRule) {
+					for (std::int32_t py = 0; py < s.scale; py++) {
+						std::uint8_t* out = OutputAt(s, x * s.scale, y * s.scale + py);
+						for (std::int32_t i = 0; i < s.scale; i++) {
+							StoreOpaque(out + i * 4, P12);
+						}
+					}
+					continue;
+				}
+
+				const Rgb col[4] = {
+					px[0] ? P17 : P13,
+					px[1] ? P13 : P7,
+					px[2] ? P7 : P11,
+					px[3] ? P11 : P17
+				};
+
+				for (std::int32_t py = 0; py < s.scale; py++) {
+					std::uint8_t* out = OutputAt(s, x * s.scale, y * s.scale + py);
+					for (std::int32_t i = 0; i < s.scale; i++) {
+						const float (&blend)[5][4] = s.sabrBlend[py * s.scale + i];
+						float mac[4];
+						for (std::int32_t c = 0; c < 4; c++) {
+							mac[c] = (rules[c] != SabrRuleNone ? blend[rules[c]][c] : 0.0f);
+						}
+
+						Rgb res1 = P12;
+						for (std::int32_t c = 0; c < 4; c++) {
+							res1 = Mix(res1, col[c], mac[c]);
+						}
+						Rgb res2 = P12;
+						for (std::int32_t c = 3; c >= 0; c--) {
+							res2 = Mix(res2, col[c], mac[c]);
+						}
+						StoreOpaque(out + i * 4, AbsDiffSum(P12, res2) >= AbsDiffSum(P12, res1) ? res2 : res1);
+					}
+				}
+			}
+		}
+
+		// =====================================================================
+		// CleanEdge (ResizeCleanEdge.shader, with SLOPE and CLEANUP enabled)
+		//
+		// All decisions of `sliceDist()` depend only on the neighbourhood of the texel and on the quadrant of the
+		// output pixel, so they are made once per texel and quadrant and turned into a "slice" - the edge line and
+		// the cleanup lines as plane equations plus the color to use. Each output pixel then only evaluates the
+		// distances of its point to the slices of its quadrant.
+		// =====================================================================
+		struct EdgeLine
+		{
+			// Signed distance of a point is `c - dot(n, point)`
+			float nx, ny, c;
+		};
+
+		struct EdgeSlice
+		{
+			EdgeLine line;
+			EdgeLine cleanup[2];
+			std::uint32_t color;
+			std::int8_t cleanupCount;
+			bool cleanupMax;
+			bool flip;
+		};
+
+		struct EdgeTexel
+		{
+			std::uint8_t r, g, b, a;
+		};
+
+		inline EdgeTexel ToEdgeTexel(std::uint32_t packed) {
+			EdgeTexel t;
+			std::memcpy(&t, &packed, 4);
+			return t;
+		}
+
+		inline bool EdgeSimilar(std::uint32_t a, std::uint32_t b) {
+			return (a == b || (ToEdgeTexel(a).a == 0 && ToEdgeTexel(b).a == 0));
+		}
+		inline bool EdgeSimilar3(std::uint32_t a, std::uint32_t b, std::uint32_t c) {
+			return EdgeSimilar(a, b) && EdgeSimilar(b, c);
+		}
+		inline bool EdgeSimilar4(std::uint32_t a, std::uint32_t b, std::uint32_t c, std::uint32_t d) {
+			return EdgeSimilar(a, b) && EdgeSimilar(b, c) && EdgeSimilar(c, d);
+		}
+
+		inline std::int32_t EdgeDistToWhite(EdgeTexel t) {
+			std::int32_t dr = 255 - t.r, dg = 255 - t.g, db = 255 - t.b;
+			return dr * dr + dg * dg + db * db;
+		}
+
+		inline bool EdgeHigher(std::uint32_t a, std::uint32_t b) {
+			if (EdgeSimilar(a, b)) {
+				return false;
+			}
+			EdgeTexel ta = ToEdgeTexel(a), tb = ToEdgeTexel(b);
+			if (ta.a == tb.a) {
+				return EdgeDistToWhite(ta) < EdgeDistToWhite(tb);
+			}
+			return ta.a > tb.a;
+		}
+
+		inline float EdgeColorDist(std::uint32_t a, std::uint32_t b) {
+			EdgeTexel ta = ToEdgeTexel(a), tb = ToEdgeTexel(b);
+			std::int32_t dr = ta.r - tb.r, dg = ta.g - tb.g, db = ta.b - tb.b, da = ta.a - tb.a;
+			return std::sqrt((float)(dr * dr + dg * dg + db * db + da * da)) * (1.0f / 255.0f);
+		}
+
+		inline EdgeLine MakeEdgeLine(float x1, float y1, float x2, float y2, float qx, float qy, bool towards)
+		{
+			// Line points are relative to the texel center and mirrored into the quadrant
+			x1 = 0.5f + x1 * qx;
+			y1 = 0.5f + y1 * qy;
+			x2 = 0.5f + x2 * qx;
+			y2 = 0.5f + y2 * qy;
+			float dirX = (towards ? qx : -qx);
+			float dirY = (towards ? qy : -qy);
+
+			float perpX = (y2 - y1);
+			float perpY = -(x2 - x1);
+			float sign = (perpX * dirX + perpY * dirY > 0.0f ? 1.0f : -1.0f);
+			float invLength = sign / std::sqrt(perpX * perpX + perpY * perpY);
+			EdgeLine line;
+			line.nx = perpX * invLength;
+			line.ny = perpY * invLength;
+			line.c = line.nx * x1 + line.ny * y1;
+			return line;
+		}
+
+		bool PlanEdgeSlice(EdgeSlice& slice, float qx, float qy, std::uint32_t ub, std::uint32_t u, std::uint32_t uf, std::uint32_t uff,
+			std::uint32_t b, std::uint32_t c, std::uint32_t f, std::uint32_t ff, std::uint32_t db, std::uint32_t d, std::uint32_t df,
+			std::uint32_t dff, std::uint32_t ddb, std::uint32_t dd, std::uint32_t ddf)
+		{
+			float distAgainst = 4.0f * EdgeColorDist(f, d) + EdgeColorDist(uf, c) + EdgeColorDist(c, db) + EdgeColorDist(ff, df) + EdgeColorDist(df, dd);
+			float distTowards = 4.0f * EdgeColorDist(c, df) + EdgeColorDist(u, f) + EdgeColorDist(f, dff) + EdgeColorDist(b, d) + EdgeColorDist(d, ddf);
+			bool shouldSlice = (distAgainst < distTowards) || ((distAgainst < distTowards + 0.001f) && !EdgeHigher(c, f));
+			if (EdgeSimilar4(f, d, b, u) && EdgeSimilar4(uf, df, db, ub) && !EdgeSimilar(c, f)) {
+				shouldSlice = false;
+			}
+			if (!shouldSlice) {
+				return false;
+			}
+
+			bool flip = false;
+			slice.cleanupCount = 0;
+			slice.cleanupMax = false;
+
+			if (EdgeSimilar3(f, d, db) && !EdgeSimilar3(f, d, b) && !EdgeSimilar(uf, db)) {
+				// Lower shallow 2:1 slant
+				if (!(EdgeSimilar(c, df) && EdgeHigher(c, f))) {
+					if (EdgeHigher(c, f)) {
+						flip = true;
+					}
+					if (EdgeSimilar(u, f) && !EdgeSimilar(c, df) && !EdgeHigher(c, u)) {
+						flip = true;
+					}
+				}
+				slice.line = (flip ? MakeEdgeLine(1.5f, -1.0f, -0.5f, 0.0f, qx, qy, false) : MakeEdgeLine(1.5f, 0.0f, -0.5f, 1.0f, qx, qy, true));
+				if (!flip && EdgeSimilar(c, uf) && !(EdgeSimilar3(c, uf, uff) && !EdgeSimilar3(c, uf, ff) && !EdgeSimilar(d, uff))) {
+					slice.cleanup[slice.cleanupCount++] = MakeEdgeLine(2.0f, -1.0f, 0.0f, 1.0f, qx, qy, true);
+				}
+				slice.color = (EdgeColorDist(c, f) <= EdgeColorDist(c, d) ? f : d);
+			} else if (EdgeSimilar3(uf, f, d) && !EdgeSimilar3(u, f, d) && !EdgeSimilar(uf, db)) {
+				// Forward steep 2:1 slant
+				if (!(EdgeSimilar(c, df) && EdgeHigher(c, d))) {
+					if (EdgeHigher(c, d)) {
+						flip = true;
+					}
+					if (EdgeSimilar(b, d) && !EdgeSimilar(c, df) && !EdgeHigher(c, d)) {
+						flip = true;
+					}
+				}
+				slice.line = (flip ? MakeEdgeLine(0.0f, -0.5f, -1.0f, 1.5f, qx, qy, false) : MakeEdgeLine(1.0f, -0.5f, 0.0f, 1.5f, qx, qy, true));
+				if (!flip && EdgeSimilar(c, db) && !(EdgeSimilar3(c, db, ddb) && !EdgeSimilar3(c, db, dd) && !EdgeSimilar(f, ddb))) {
+					slice.cleanup[slice.cleanupCount++] = MakeEdgeLine(1.0f, 0.0f, -1.0f, 2.0f, qx, qy, true);
+				}
+				slice.color = (EdgeColorDist(c, f) <= EdgeColorDist(c, d) ? f : d);
+			} else if (EdgeSimilar(f, d)) {
+				// 45 degree diagonal
+				if (EdgeSimilar(c, df) && EdgeHigher(c, f)) {
+					if (!EdgeSimilar(c, dd) && !EdgeSimilar(c, ff)) {
+						flip = true;
+					}
+				} else {
+					if (EdgeHigher(c, f)) {
+						flip = true;
+					}
+					if (!EdgeSimilar(c, b) && EdgeSimilar4(b, f, d, u)) {
+						flip = true;
+					}
+				}
+				if (((EdgeSimilar(f, db) && EdgeSimilar3(u, f, df)) || (EdgeSimilar(uf, d) && EdgeSimilar3(b, d, df))) && !EdgeSimilar(c, df)) {
+					flip = true;
+				}
+				slice.line = (flip ? MakeEdgeLine(1.0f, -1.0f, -1.0f, 1.0f, qx, qy, false) : MakeEdgeLine(1.0f, 0.0f, 0.0f, 1.0f, qx, qy, true));
+				slice.cleanupMax = true;
+				if (!flip && EdgeSimilar3(c, uf, uff) && !EdgeSimilar3(c, uf, ff) && !EdgeSimilar(d, uff)) {
+					slice.cleanup[slice.cleanupCount++] = MakeEdgeLine(1.5f, 0.0f, -0.5f, 1.0f, qx, qy, true);
+				}
+				if (!flip && EdgeSimilar3(ddb, db, c) && !EdgeSimilar3(dd, db, c) && !EdgeSimilar(ddb, f)) {
+					slice.cleanup[slice.cleanupCount++] = MakeEdgeLine(1.0f, -0.5f, 0.0f, 1.5f, qx, qy, true);
+				}
+				slice.color = (EdgeColorDist(c, f) <= EdgeColorDist(c, d) ? f : d);
+			} else if (EdgeSimilar3(ff, df, d) && !EdgeSimilar3(ff, df, c) && !EdgeSimilar(uff, d)) {
+				// Far corner of shallow slant
+				if (!(EdgeSimilar(f, dff) && EdgeHigher(f, ff))) {
+					if (EdgeHigher(f, ff)) {
+						flip = true;
+					}
+					if (EdgeSimilar(uf, ff) && !EdgeSimilar(f, dff) && !EdgeHigher(f, uf)) {
+						flip = true;
+					}
+				}
+				slice.line = (flip ? MakeEdgeLine(2.5f, -1.0f, 0.5f, 0.0f, qx, qy, false) : MakeEdgeLine(2.5f, 0.0f, 0.5f, 1.0f, qx, qy, true));
+				slice.color = (EdgeColorDist(f, ff) <= EdgeColorDist(f, df) ? ff : df);
+			} else if (EdgeSimilar3(f, df, dd) && !EdgeSimilar3(c, df, dd) && !EdgeSimilar(f, ddb)) {
+				// Far corner of steep slant
+				if (!(EdgeSimilar(d, ddf) && EdgeHigher(d, dd))) {
+					if (EdgeHigher(d, dd)) {
+						flip = true;
+					}
+					if (EdgeSimilar(db, dd) && !EdgeSimilar(d, ddf) && !EdgeHigher(d, dd)) {
+						flip = true;
+					}
+				}
+				slice.line = (flip ? MakeEdgeLine(0.0f, 0.5f, -1.0f, 2.5f, qx, qy, false) : MakeEdgeLine(1.0f, 0.5f, 0.0f, 2.5f, qx, qy, true));
+				slice.color = (EdgeColorDist(d, df) <= EdgeColorDist(d, dd) ? df : dd);
+			} else {
+				return false;
+			}
+
+			slice.flip = flip;
+			return true;
+		}
+
+		inline bool EdgeSliceCovers(const EdgeSlice& slice, float x, float y)
+		{
+			constexpr float LineWidth = 1.0f;
+
+			float dist = slice.line.c - (slice.line.nx * x + slice.line.ny * y);
+			if (slice.flip) {
+				dist = LineWidth - dist;
+			}
+			for (std::int32_t i = 0; i < slice.cleanupCount; i++) {
+				const EdgeLine& line = slice.cleanup[i];
+				float dist2 = line.c - (line.nx * x + line.ny * y);
+				dist = (slice.cleanupMax ? std::max(dist, dist2) : std::min(dist, dist2));
+			}
+			return (dist - LineWidth * 0.5f <= 0.0f);
+		}
+
+		void CleanEdgeRow(std::int32_t y, std::int32_t workerSlot, void* userData)
+		{
+			const RescaleState& s = *static_cast<const RescaleState*>(userData);
+			const std::int32_t half = s.scale / 2;
+
+			for (std::int32_t x = 0; x < s.width; x++) {
+				std::uint32_t c = FetchPacked(s, x, y);
+
+				// Uniform neighbourhoods are by far the most common case and they can't produce any slice
+				bool isUniform = true;
+				for (std::int32_t dy = -2; dy <= 2 && isUniform; dy++) {
+					const std::uint8_t* row = TexelAt(s, x - 2, y + dy);
+					for (std::int32_t dx = 0; dx < 5; dx++) {
+						if (std::memcmp(row + dx * 4, &c, 4) != 0) {
+							isUniform = false;
+							break;
+						}
+					}
+				}
+
+				EdgeSlice slices[4][3];
+				bool hasSlice[4][3] = {};
+				if (!isUniform) {
+					for (std::int32_t q = 0; q < 4; q++) {
+						std::int32_t qx = ((q & 1) != 0 ? 1 : -1);
+						std::int32_t qy = ((q & 2) != 0 ? 1 : -1);
+						auto n = [&s, x, y, qx, qy](std::int32_t dx, std::int32_t dy) {
+							return FetchPacked(s, x + dx * qx, y + dy * qy);
+						};
+
+						std::uint32_t uub = n(-1, -2), uu = n(0, -2), uuf = n(1, -2), ubb = n(-2, -2);
+						std::uint32_t ub = n(-1, -1), u = n(0, -1), uf = n(1, -1), uff = n(2, -1);
+						std::uint32_t bb = n(-2, 0), b = n(-1, 0), f = n(1, 0), ff = n(2, 0);
+						std::uint32_t dbb = n(-2, 1), db = n(-1, 1), d = n(0, 1), df = n(1, 1), dff = n(2, 1);
+						std::uint32_t ddb = n(-1, 2), dd = n(0, 2), ddf = n(1, 2);
+
+						hasSlice[q][0] = PlanEdgeSlice(slices[q][0], (float)qx, (float)qy, ub, u, uf, uff, b, c, f, ff, db, d, df, dff, ddb, dd, ddf);
+						hasSlice[q][1] = PlanEdgeSlice(slices[q][1], (float)qx, (float)qy, uf, u, ub, ubb, f, c, b, bb, df, d, db, dbb, ddf, dd, ddb);
+						hasSlice[q][2] = PlanEdgeSlice(slices[q][2], (float)qx, (float)qy, db, d, df, dff, b, c, f, ff, ub, u, uf, uff, uub, uu, uuf);
+					}
+				}
+
+				// Main directions of the three slices, the point is mirrored by them before the distance test
+				static constexpr float MainDirs[3][2] = { { 1.0f, 1.0f }, { -1.0f, 1.0f }, { 1.0f, -1.0f } };
+
+				for (std::int32_t py = 0; py < s.scale; py++) {
+					std::uint8_t* out = OutputAt(s, x * s.scale, y * s.scale + py);
+					float ly = (py + 0.5f) / s.scale;
+					for (std::int32_t px = 0; px < s.scale; px++) {
+						std::uint32_t color = c;
+						if (!isUniform) {
+							float lx = (px + 0.5f) / s.scale;
+							std::int32_t q = (px >= half ? 1 : 0) | (py >= half ? 2 : 0);
+							for (std::int32_t i = 0; i < 3; i++) {
+								if (hasSlice[q][i] && EdgeSliceCovers(slices[q][i], MainDirs[i][0] * (lx - 0.5f) + 0.5f, MainDirs[i][1] * (ly - 0.5f) + 0.5f)) {
+									color = slices[q][i].color;
+								}
+							}
+						}
+						std::memcpy(out + px * 4, &color, 4);
+						out[px * 4 + 3] = 255;
+					}
+				}
+			}
+		}
+
+		// =====================================================================
+		// CRT scanlines (ResizeCrtScanlines.shader)
+		//
+		// Every third output row darkens towards the next source row, the other ones boost the luma, which is
+		// folded into one RGB-to-RGB matrix here.
+		// =====================================================================
+		void PrepareScanlineMatrix(RescaleState& s)
+		{
+			static constexpr float ToYiq[3][3] = {
+				{ 0.2989f, 0.5870f, 0.1140f },
+				{ 0.5959f, -0.2744f, -0.3216f },
+				{ 0.2115f, -0.5229f, 0.3114f }
+			};
+			static constexpr float FromYiq[3][3] = {
+				{ 1.0f, 0.956f, 0.6210f },
+				{ 1.0f, -0.2720f, -0.6474f },
+				{ 1.0f, -1.1060f, 1.7046f }
+			};
+			static constexpr float Boost[3] = { 1.1f, 1.0f, 1.0f };
+
+			if (s.scanlineMatrixReady) {
+				return;
+			}
+			for (std::int32_t i = 0; i < 3; i++) {
+				for (std::int32_t j = 0; j < 3; j++) {
+					float value = 0.0f;
+					for (std::int32_t k = 0; k < 3; k++) {
+						value += FromYiq[i][k] * Boost[k] * ToYiq[k][j];
+					}
+					s.scanlineMatrix[i][j] = value;
+				}
+			}
+			s.scanlineMatrixReady = true;
+		}
+
+		void CrtScanlinesRow(std::int32_t y, std::int32_t workerSlot, void* userData)
+		{
+			const RescaleState& s = *static_cast<const RescaleState*>(userData);
+			const auto& m = s.scanlineMatrix;
+
+			for (std::int32_t py = 0; py < s.scale; py++) {
+				std::uint8_t* out = OutputAt(s, 0, y * s.scale + py);
+				bool isDark = (py == s.scale - 1);
+				for (std::int32_t x = 0; x < s.width; x++) {
+					Rgb t0 = FetchRgb(s, x, y);
+					Rgb result;
+					if (isDark) {
+						result = (t0 + FetchRgb(s, x, std::min(y + 1, s.height - 1))) * 0.25f;
+					} else {
+						result.r = m[0][0] * t0.r + m[0][1] * t0.g + m[0][2] * t0.b;
+						result.g = m[1][0] * t0.r + m[1][1] * t0.g + m[1][2] * t0.b;
+						result.b = m[2][0] * t0.r + m[2][1] * t0.g + m[2][2] * t0.b;
+					}
+					for (std::int32_t i = 0; i < s.scale; i++) {
+						StoreOpaque(out + (x * s.scale + i) * 4, result);
+					}
+				}
+			}
+		}
+
+		// =====================================================================
+		// Lottes CRT (ResizeCrtShadowMask.shader and ResizeCrtApertureGrille.shader, without the curvature)
+		//
+		// The Gaussian filters are separable, so the horizontal 3/5/7-tap filters are applied once per source row
+		// at the output width, and every output row is then a weighted sum of eight of these rows - three for the
+		// scanlines and five for the bloom.
+		// =====================================================================
+		inline float CrtGaussian(float pos, float scale) {
+			return std::exp2(scale * pos * pos);
+		}
+
+		inline float ToLinear(float c) {
+			return (c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f));
+		}
+
+		inline float ToSrgb(float c) {
+			return (c < 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 0.41666f) - 0.055f);
+		}
+
+		void PrepareCrtWeights(float* weights, std::int32_t taps, std::int32_t scale, float hardness)
+		{
+			for (std::int32_t p = 0; p < scale; p++) {
+				float dist = -((p + 0.5f) / scale - 0.5f);
+				float sum = 0.0f;
+				for (std::int32_t k = 0; k < taps; k++) {
+					float w = CrtGaussian(dist + (float)(k - taps / 2), hardness);
+					weights[p * taps + k] = w;
+					sum += w;
+				}
+				for (std::int32_t k = 0; k < taps; k++) {
+					weights[p * taps + k] /= sum;
+				}
+			}
+		}
+
+		void PrepareCrtState(RescaleState& s, const CrtParams& params)
+		{
+			s.crt = &params;
+
+			if (s.crtLinearLutBoost != params.brightBoost) {
+				s.crtLinearLutBoost = params.brightBoost;
+				for (std::int32_t i = 0; i < 256; i++) {
+					s.crtLinearLut[i] = ToLinear(params.brightBoost * (i / 255.0f));
+				}
+			}
+			if (!s.crtSrgbLutReady) {
+				s.crtSrgbLutReady = true;
+				for (std::int32_t i = 0; i <= SrgbLutSize; i++) {
+					s.crtSrgbLut[i] = ToByte(ToSrgb((float)i / SrgbLutSize));
+				}
+			}
+
+			PrepareCrtWeights(s.crtWeights3, 3, s.scale, params.hardPix);
+			PrepareCrtWeights(s.crtWeights5, 5, s.scale, params.hardPix);
+			PrepareCrtWeights(s.crtWeights7, 7, s.scale, params.hardBloomPix);
+			for (std::int32_t p = 0; p < s.scale; p++) {
+				float dist = -((p + 0.5f) / s.scale - 0.5f);
+				float* w = s.crtRowWeights[p];
+				for (std::int32_t i = 0; i < 3; i++) {
+					w[i] = CrtGaussian(dist + (float)(i - 1), params.hardScan);
+				}
+				for (std::int32_t i = 0; i < 5; i++) {
+					w[3 + i] = CrtGaussian(dist + (float)(i - 2), params.hardBloomScan) * params.bloomAmount;
+				}
+			}
+
+			std::int32_t outWidth = s.width * s.scale;
+			s.crtLinear.resize_for_overwrite((std::size_t)(s.width + CrtPadding * 2) * s.height * 4);
+			s.crtHorz3.resize_for_overwrite((std::size_t)outWidth * s.height * 4);
+			s.crtHorz5.resize_for_overwrite((std::size_t)outWidth * s.height * 4);
+			s.crtHorz7.resize_for_overwrite((std::size_t)outWidth * s.height * 4);
+			s.crtScratch.resize_for_overwrite((std::size_t)outWidth * 4 * SwTileRenderer::GetWorkerSlotCount());
+		}
+
+		void CrtHorizontalRow(std::int32_t y, std::int32_t workerSlot, void* userData)
+		{
+			RescaleState& s = *static_cast<RescaleState*>(userData);
+			std::int32_t linearWidth = s.width + CrtPadding * 2;
+			std::int32_t outFloats = s.width * s.scale * 4;
+
+			float* linear = s.crtLinear.data() + (std::size_t)y * linearWidth * 4;
+			for (std::int32_t x = 0; x < linearWidth; x++) {
+				const std::uint8_t* p = TexelAt(s, std::clamp(x - CrtPadding, 0, s.width - 1), y);
+				linear[x * 4 + 0] = s.crtLinearLut[p[0]];
+				linear[x * 4 + 1] = s.crtLinearLut[p[1]];
+				linear[x * 4 + 2] = s.crtLinearLut[p[2]];
+				linear[x * 4 + 3] = 1.0f;
+			}
+
+			rescaleConvolveRow(s.crtHorz3.data() + (std::size_t)y * outFloats, linear + (CrtPadding - 1) * 4, s.crtWeights3, 3, s.scale, s.width);
+			rescaleConvolveRow(s.crtHorz5.data() + (std::size_t)y * outFloats, linear + (CrtPadding - 2) * 4, s.crtWeights5, 5, s.scale, s.width);
+			rescaleConvolveRow(s.crtHorz7.data() + (std::size_t)y * outFloats, linear, s.crtWeights7, 7, s.scale, s.width);
+		}
+
+		void CrtVerticalRow(std::int32_t y, std::int32_t workerSlot, void* userData)
+		{
+			RescaleState& s = *static_cast<RescaleState*>(userData);
+			const CrtParams& params = *s.crt;
+			std::int32_t outWidth = s.width * s.scale;
+			std::int32_t outFloats = outWidth * 4;
+			float* acc = s.crtScratch.data() + (std::size_t)workerSlot * outFloats;
+
+			auto row = [&s, outFloats](const SmallVector<float, 0>& rows, std::int32_t index) {
+				return rows.data() + (std::size_t)std::clamp(index, 0, s.height - 1) * outFloats;
+			};
+			const float* rows[8] = {
+				row(s.crtHorz3, y - 1), row(s.crtHorz5, y), row(s.crtHorz3, y + 1),
+				row(s.crtHorz5, y - 2), row(s.crtHorz7, y - 1), row(s.crtHorz7, y), row(s.crtHorz7, y + 1), row(s.crtHorz5, y + 2)
+			};
+
+			for (std::int32_t py = 0; py < s.scale; py++) {
+				std::int32_t oy = y * s.scale + py;
+				rescaleAccumulateRows(acc, rows, s.crtRowWeights[py], 8, outFloats);
+
+				std::uint8_t* out = OutputAt(s, 0, oy);
+				for (std::int32_t ox = 0; ox < outWidth; ox++) {
+					std::int32_t light = (params.apertureGrille ? ox % 3 : ((ox + (oy >> 1) * 3) % 6) >> 1);
+					for (std::int32_t i = 0; i < 3; i++) {
+						float v = acc[ox * 4 + i] * (i == light ? params.maskLight : params.maskDark);
+						out[ox * 4 + i] = (v <= 0.0f ? s.crtSrgbLut[0] : (v >= 1.0f ? 255 : s.crtSrgbLut[(std::int32_t)(v * SrgbLutSize + 0.5f)]));
+					}
+					out[ox * 4 + 3] = 255;
+				}
+			}
+		}
+
+		// =====================================================================
+		// Monochrome (ResizeMonochrome.shader)
+		// =====================================================================
+		void MonochromeRow(std::int32_t y, std::int32_t workerSlot, void* userData)
+		{
+			static constexpr float Bayer[4][4] = {
+				{ 0.0625f, 0.5625f, 0.1875f, 0.6875f },
+				{ 0.8125f, 0.3125f, 0.9375f, 0.4375f },
+				{ 0.25f, 0.75f, 0.125f, 0.625f },
+				{ 1.0f, 0.5f, 0.875f, 0.375f }
+			};
+			static constexpr std::uint8_t Palette[4][4] = {
+				{ 172, 181, 107, 255 },
+				{ 118, 132, 72, 255 },
+				{ 63, 80, 63, 255 },
+				{ 26, 34, 39, 255 }
+			};
+
+			const RescaleState& s = *static_cast<const RescaleState*>(userData);
+			std::uint8_t* out = OutputAt(s, 0, y);
+			for (std::int32_t x = 0; x < s.width; x++) {
+				Rgb color = FetchRgb(s, x, y);
+				float gray = ((color.r - 0.5f) * 1.4f + 0.5f) * 0.3f + ((color.g - 0.5f) * 1.2f + 0.5f) * 0.7f + ((color.b - 0.5f) * 1.0f + 0.5f) * 0.1f;
+				gray += (gray < Bayer[x & 3][y & 3] ? -0.05f : 0.1f);
+				float palette = std::abs(1.0f - gray) * 0.75f + 0.125f;
+				std::int32_t index = (palette < 0.25f ? 0 : (palette < 0.5f ? 1 : (palette < 0.75f ? 2 : 3)));
+				std::memcpy(out + x * 4, Palette[index], 4);
+			}
+		}
+	}
+
+	std::int32_t SwRescale::GetScaleFactor(SwRescaleFilter filter)
+	{
+		switch (filter) {
+			case SwRescaleFilter::HQ2x: return 2;
+			case SwRescaleFilter::Xbrz3x:
+			case SwRescaleFilter::Sabr:
+			case SwRescaleFilter::CrtScanlines:
+			case SwRescaleFilter::CrtShadowMask:
+			case SwRescaleFilter::CrtApertureGrille: return 3;
+			case SwRescaleFilter::CleanEdge: return 4;
+			default: return 1;
+		}
+	}
+
+	void SwRescale::Apply(SwRescaleFilter filter, const std::uint8_t* src, std::int32_t width, std::int32_t height, std::int32_t srcStride,
+		std::uint8_t* dst, std::int32_t dstStride)
+	{
+		if (filter == SwRescaleFilter::None || width <= 0 || height <= 0) {
+			return;
+		}
+
+		ZoneScopedNC("SwRescale::Apply", 0x6D9EC4);
+
+		RescaleState& s = g_rescale;
+		s.width = width;
+		s.height = height;
+		s.scale = GetScaleFactor(filter);
+		s.dst = dst;
+		s.dstStride = dstStride;
+		PreparePaddedSource(s, src, srcStride);
+
+		// Every job writes the output rows of one source row, the rows are independent of each other
+		switch (filter) {
+			case SwRescaleFilter::HQ2x:
+				SwTileRenderer::RunParallel(height, Hq2xRow, &s);
+				break;
+			case SwRescaleFilter::Xbrz3x:
+				SwTileRenderer::RunParallel(height, XbrzRow, &s);
+				break;
+			case SwRescaleFilter::Sabr:
+				PrepareSabrTables(s);
+				SwTileRenderer::RunParallel(height, SabrRow, &s);
+				break;
+			case SwRescaleFilter::CleanEdge:
+				SwTileRenderer::RunParallel(height, CleanEdgeRow, &s);
+				break;
+			case SwRescaleFilter::CrtScanlines:
+				PrepareScanlineMatrix(s);
+				SwTileRenderer::RunParallel(height, CrtScanlinesRow, &s);
+				break;
+			case SwRescaleFilter::CrtShadowMask:
+			case SwRescaleFilter::CrtApertureGrille:
+				PrepareCrtState(s, filter == SwRescaleFilter::CrtApertureGrille ? ApertureGrilleParams : ShadowMaskParams);
+				SwTileRenderer::RunParallel(height, CrtHorizontalRow, &s);
+				SwTileRenderer::RunParallel(height, CrtVerticalRow, &s);
+				break;
+			case SwRescaleFilter::Monochrome:
+				SwTileRenderer::RunParallel(height, MonochromeRow, &s);
+				break;
+			default:
+				break;
+		}
+	}
+
+#if defined(DEATH_CPU_USE_RUNTIME_DISPATCH) && !defined(DEATH_CPU_USE_IFUNC)
+	void SwRescale::SetCpuFeatures(Cpu::Features features)
+	{
+		rescaleConvolveRow = rescaleConvolveRowImplementation(features);
+		rescaleAccumulateRows = rescaleAccumulateRowsImplementation(features);
+	}
+#endif
+}
+
+#endif
@@ -0,0 +1,71 @@
+#pragma once
+
+#if defined(WITH_RHI_SOFTWARE)
+
+#include <cstdint>
+
+#if defined(DEATH_CPU_USE_RUNTIME_DISPATCH) && !defined(DEATH_CPU_USE_IFUNC)
+#	include <Cpu.h>
+#endif
+
+namespace nCine::RHI::Software
+{
+	/**
+		@brief Rescale filter applied to the screen framebuffer before it is presented
+
+		CPU counterparts of the rescale shaders of the post-processing tier (`Resize*.shader`). Each filter
+		outputs an integer multiple of the source size, see @ref SwRescale::GetScaleFactor().
+	*/
+	enum class SwRescaleFilter : std::uint8_t
+	{
+		None,				/**< Presents the screen framebuffer as is */
+		HQ2x,				/**< HQ2x-style smoothing at 2x */
+		Xbrz3x,				/**< xBRZ at 3x */
+		Sabr,				/**< SABR at 3x */
+		CleanEdge,			/**< CleanEdge at 4x */
+		CrtScanlines,		/**< Simple CRT scanlines at 3x */
+		CrtShadowMask,		/**< Lottes CRT with a shadow mask at 3x */
+		CrtApertureGrille,	/**< Lottes CRT with an aperture grille at 3x */
+		Monochrome			/**< Dithered four-shade monochrome palette at 1x */
+	};
+
+	/**
+		@brief CPU implementations of the rescale filters for the presentation path
+
+		The direct rendering tier draws the scene at the logical resolution straight into the screen
+		framebuffer, so there is no shader pass a rescale filter could run in. Instead, the filter is applied
+		to the finished frame while it's being presented: the output rows are split into bands that are
+		processed by the worker pool of @ref SwTileRenderer, and the arithmetic-heavy inner loops (the Gaussian
+		filters of the CRT modes) are dispatched to SSE2/AVX2/NEON/SIMD128 variants. The edge-detecting filters
+		evaluate their rules once per source pixel and only the per-output-pixel blending afterwards, which is
+		what the integer output scale makes possible.
+
+		Both surfaces are RGBA8 with rows in the same order, the output is written opaque.
+	*/
+	namespace SwRescale
+	{
+		/** @brief Returns the integer factor by which the filter enlarges the image, `1` for @ref SwRescaleFilter::None */
+		std::int32_t GetScaleFactor(SwRescaleFilter filter);
+
+		/**
+			@brief Applies the filter to an image
+
+			@param filter		Filter to apply, must not be @ref SwRescaleFilter::None
+			@param src			First row of the RGBA8 source image
+			@param width		Source width in pixels
+			@param height		Source height in pixels
+			@param srcStride	Byte distance between two source rows
+			@param dst			First row of the RGBA8 destination, sized `width * height` times the square of @ref GetScaleFactor()
+			@param dstStride	Byte distance between two destination rows
+		*/
+		void Apply(SwRescaleFilter filter, const std::uint8_t* src, std::int32_t width, std::int32_t height, std::int32_t srcStride,
+			std::uint8_t* dst, std::int32_t dstStride);
+
+#if defined(DEATH_CPU_USE_RUNTIME_DISPATCH) && !defined(DEATH_CPU_USE_IFUNC)
+		/** @brief Rebinds the dispatched filter kernels to the variants matching @p features, see @ref SwRaster::SetCpuFeatures() */
+		void SetCpuFeatures(Death::Cpu::Features features);
+#endif
+	}
+}
+
+#endif
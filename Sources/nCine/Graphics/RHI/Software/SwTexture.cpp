@@ -1,7 +1,9 @@
 #include "SwTexture.h"
 #include "SwDevice.h"
 #include "SwRaster.h"
+#include "SwTileRenderer.h"
 
+#include <algorithm>
 #include <cstring>
 
 namespace nCine::RHI::Software
@@ -27,6 +29,43 @@ namespace nCine::RHI::Software
 				}
 			}
 		}
+
+		// Copies a packed rectangle into a level store, clipped to the level
+		void CopyRect(std::uint8_t* store, std::int32_t storeWidth, std::int32_t storeHeight, std::int32_t dstBpp,
+			std::int32_t xoffset, std::int32_t yoffset, std::int32_t width, std::int32_t height, const std::uint8_t* src, std::int32_t srcBpp)
+		{
+			for (std::int32_t y = 0; y < height; y++) {
+				const std::int32_t dstY = yoffset + y;
+				if (dstY < 0 || dstY >= storeHeight) {
+					continue;
+				}
+				// Clamp the destination span to the texture so a sub-rect running past an edge can never write
+				// past the row (and past the store on the last row)
+				std::int32_t dstX = xoffset;
+				std::int32_t copyW = width;
+				std::int32_t srcX0 = 0;
+				if (dstX < 0) {
+					srcX0 = -dstX;
+					copyW += dstX;
+					dstX = 0;
+				}
+				if (dstX + copyW > storeWidth) {
+					copyW = storeWidth - dstX;
+				}
+				if (copyW <= 0) {
+					continue;
+				}
+				const std::uint8_t* srcRow = src + std::size_t(y) * std::size_t(width) * srcBpp + std::size_t(srcX0) * srcBpp;
+				std::uint8_t* dstRow = store + (std::size_t(dstY) * storeWidth + dstX) * dstBpp;
+				CopyExpandRow(dstRow, dstBpp, srcRow, srcBpp, copyW);
+			}
+		}
+
+		inline bool IsMipmapFilter(nCine::SamplerFilter filter)
+		{
+			return (filter == nCine::SamplerFilter::NearestMipmapNearest || filter == nCine::SamplerFilter::LinearMipmapNearest ||
+				filter == nCine::SamplerFilter::NearestMipmapLinear || filter == nCine::SamplerFilter::LinearMipmapLinear);
+		}
 	}
 
 	std::uint32_t SwTexture::_nextHandle = 1;
@@ -36,7 +75,7 @@ namespace nCine::RHI::Software
 		: _handle(_nextHandle++), _contentVersion(0), _target(target), _format(PixelFormat::Unknown), _uploadFormat(PixelFormat::Unknown),
 			_width(0), _height(0), _strideBytes(0), _bytesPerPixel(0),
 			_minFilter(nCine::SamplerFilter::Nearest), _magFilter(nCine::SamplerFilter::Nearest), _wrap(SamplerWrapping::ClampToEdge),
-			_textureUnit(0), _isRenderTarget(false)
+			_textureUnit(0), _mipVersion(0), _maxLevel(1000), _isRenderTarget(false), _hasUploadedMips(false)
 	{
 		_swizzle[0] = SwizzleChannel::Red;
 		_swizzle[1] = SwizzleChannel::Green;
@@ -85,13 +124,18 @@ namespace nCine::RHI::Software
 		// A deferred tile-renderer command may still reference this texture's current store (the prepared
 		// command snapshots the level-0 pixel pointer at submit); drain the queue before the buffer can be
 		// reallocated so no worker rasterizes from freed memory. A no-op when nothing is queued.
-		if (!_pixels.empty()) {
+		if (!_pixels.empty() || !_levels.empty()) {
 			SwRaster::Flush();
 		}
 		_pixels.assign(std::size_t(_strideBytes) * std::size_t(height > 0 ? height : 0), std::uint8_t(0));
+		// The mip levels and tiled copies belong to the previous store
+		_levels.clear();
+		_hasUploadedMips = false;
 		// The store content changed; the counter is process-global so a stamp is never repeated, even by
-		// a different texture object reusing this one's address
+		// a different texture object reusing this one's address. A render target's tile hashes are dropped
+		// the same way, the store may keep its address.
 		_contentVersion = ++_nextContentVersion;
+		SwTileRenderer::InvalidateSurface(_pixels.data());
 	}
 
 	void SwTexture::SetRenderTarget(bool isRenderTarget)
@@ -129,7 +173,22 @@ namespace nCine::RHI::Software
 	{
 		static_cast<void>(bgr);
 		if (level != 0) {
-			// The fast path samples level 0 only; higher levels are accepted but not stored
+			// Higher levels make up the mip chain of minified quads, they replace the generated one
+			if (level < 0 || _pixels.empty() || width <= 0 || height <= 0) {
+				return;
+			}
+			// A level of the same size is overwritten in place, so the queued draws that sample it must be
+			// rasterized first, like the level 0 store in Allocate()
+			if (level < std::int32_t(_levels.size()) && !_levels[level].pixels.empty()) {
+				SwRaster::Flush();
+			}
+			AllocateLevel(level, width, height);
+			_hasUploadedMips = true;
+			if (data != nullptr) {
+				CopyRect(_levels[level].pixels.data(), width, height, _bytesPerPixel, 0, 0, width, height,
+					static_cast<const std::uint8_t*>(data), BytesPerPixel(format));
+			}
+			_contentVersion = ++_nextContentVersion;
 			return;
 		}
 		Allocate(format, width, height);
@@ -155,37 +214,28 @@ namespace nCine::RHI::Software
 	void SwTexture::TexSubImage2D(std::int32_t level, std::int32_t xoffset, std::int32_t yoffset, std::int32_t width, std::int32_t height, PixelFormat format, bool bgr, const void* data)
 	{
 		static_cast<void>(bgr);
-		if (level != 0 || data == nullptr || _pixels.empty()) {
+		if (level < 0 || data == nullptr || _pixels.empty()) {
 			return;
 		}
-		const std::int32_t srcBpp = BytesPerPixel(format);
-		const std::int32_t dstBpp = BytesPerPixel(_format);
-		for (std::int32_t y = 0; y < height; y++) {
-			const std::int32_t dstY = yoffset + y;
-			if (dstY < 0 || dstY >= _height) {
-				continue;
-			}
-			// Clamp the destination span to the texture so a sub-rect running past an edge can never write
-			// past the row (and past the store on the last row)
-			std::int32_t dstX = xoffset;
-			std::int32_t copyW = width;
-			std::int32_t srcX0 = 0;
-			if (dstX < 0) {
-				srcX0 = -dstX;
-				copyW += dstX;
-				dstX = 0;
-			}
-			if (dstX + copyW > _width) {
-				copyW = _width - dstX;
-			}
-			if (copyW <= 0) {
-				continue;
-			}
-			const std::uint8_t* srcRow = static_cast<const std::uint8_t*>(data) + std::size_t(y) * std::size_t(width) * srcBpp + std::size_t(srcX0) * srcBpp;
-			std::uint8_t* dstRow = _pixels.data() + std::size_t(dstY) * _strideBytes + std::size_t(dstX) * dstBpp;
-			CopyExpandRow(dstRow, dstBpp, srcRow, srcBpp, copyW);
+		if (level > 0 && (level >= std::int32_t(_levels.size()) || _levels[level].pixels.empty())) {
+			return;
+		}
+		// The linear rows are updated in place, which the queued draws would see as well. The tiled copies
+		// and the generated mip chain are rebuilt by the next draw that samples them, so the queued draws
+		// must be rasterized first not to mix the two.
+		if (!_levels.empty()) {
+			SwRaster::Flush();
 		}
+
+		std::uint8_t* store = (level == 0 ? _pixels.data() : _levels[level].pixels.data());
+		const std::int32_t storeWidth = (level == 0 ? _width : _levels[level].width);
+		const std::int32_t storeHeight = (level == 0 ? _height : _levels[level].height);
+		CopyRect(store, storeWidth, storeHeight, _bytesPerPixel, xoffset, yoffset, width, height,
+			static_cast<const std::uint8_t*>(data), BytesPerPixel(format));
 		_contentVersion = ++_nextContentVersion;
+		if (level == 0) {
+			SwTileRenderer::InvalidateSurface(_pixels.data());
+		}
 	}
 
 	void SwTexture::TexStorage2D(std::int32_t levels, PixelFormat format, std::int32_t width, std::int32_t height)
@@ -275,7 +325,148 @@ namespace nCine::RHI::Software
 
 	void SwTexture::SetMaxLevel(std::int32_t maxLevel)
 	{
-		static_cast<void>(maxLevel);
+		_maxLevel = maxLevel;
+	}
+
+	std::int32_t SwTexture::SelectMipLevel(float texelsPerPixel) const
+	{
+		if (texelsPerPixel < 2.0f || !IsMipmapFilter(_minFilter) || _isRenderTarget || _bytesPerPixel != 4 || _pixels.empty()) {
+			return 0;
+		}
+
+		UpdateMipChain();
+
+		// Every level halves the footprint, stop before the level would be coarser than the screen
+		const std::int32_t maxLevel = std::min(std::int32_t(_levels.size()) - 1, _maxLevel);
+		std::int32_t level = 0;
+		while (level < maxLevel && texelsPerPixel >= 2.0f && !_levels[level + 1].pixels.empty()) {
+			level++;
+			texelsPerPixel *= 0.5f;
+		}
+		return level;
+	}
+
+	SwTexture::SampledLevel SwTexture::GetSampledLevel(std::int32_t level, bool preferTiled) const
+	{
+		if (level > 0) {
+			UpdateMipChain();
+			if (level >= std::int32_t(_levels.size()) || _levels[level].pixels.empty()) {
+				level = 0;
+			}
+		}
+
+		SampledLevel result;
+		if (level == 0) {
+			result.pixels = (_pixels.empty() ? nullptr : _pixels.data());
+			result.width = _width;
+			result.height = _height;
+		} else {
+			result.pixels = _levels[level].pixels.data();
+			result.width = _levels[level].width;
+			result.height = _levels[level].height;
+		}
+		result.blocksPerRow = 0;
+
+		if (preferTiled && result.pixels != nullptr && !_isRenderTarget &&
+			std::size_t(result.width) * std::size_t(result.height) * std::size_t(_bytesPerPixel) >= MinTiledStoreBytes) {
+			if (level >= std::int32_t(_levels.size())) {
+				_levels.resize(level + 1);
+			}
+			UpdateTiledPixels(level);
+			result.pixels = _levels[level].tiledPixels.data();
+			result.blocksPerRow = (result.width + TileBlockSize - 1) / TileBlockSize;
+		}
+		return result;
+	}
+
+	void SwTexture::AllocateLevel(std::int32_t level, std::int32_t width, std::int32_t height)
+	{
+		if (level >= std::int32_t(_levels.size())) {
+			_levels.resize(level + 1);
+		}
+		Level& storage = _levels[level];
+		const std::size_t size = std::size_t(width) * std::size_t(height) * std::size_t(_bytesPerPixel);
+		if (storage.pixels.size() != size) {
+			// A queued draw may still sample the old store (see Allocate)
+			if (!storage.pixels.empty() || !storage.tiledPixels.empty()) {
+				SwRaster::Flush();
+			}
+			storage.pixels.assign(size, std::uint8_t(0));
+			storage.tiledPixels.clear();
+		}
+		storage.width = width;
+		storage.height = height;
+	}
+
+	void SwTexture::UpdateMipChain() const
+	{
+		if (_hasUploadedMips || _mipVersion == _contentVersion) {
+			return;
+		}
+		_mipVersion = _contentVersion;
+
+		// Each level is a 2x2 box filter of the previous one, the last row or column of an odd size is reused.
+		// Level sizes only change after Allocate() dropped the chain, so the stores are rewritten in place.
+		const std::uint8_t* src = _pixels.data();
+		std::int32_t srcWidth = _width;
+		std::int32_t srcHeight = _height;
+		for (std::int32_t level = 1; srcWidth > 1 || srcHeight > 1; level++) {
+			const std::int32_t width = std::max(1, srcWidth / 2);
+			const std::int32_t height = std::max(1, srcHeight / 2);
+			if (level >= std::int32_t(_levels.size())) {
+				_levels.resize(level + 1);
+			}
+			Level& storage = _levels[level];
+			storage.pixels.resize(std::size_t(width) * std::size_t(height) * 4);
+			storage.width = width;
+			storage.height = height;
+
+			std::uint8_t* dst = storage.pixels.data();
+			for (std::int32_t y = 0; y < height; y++) {
+				const std::uint8_t* row0 = src + std::size_t(std::min(y * 2, srcHeight - 1)) * srcWidth * 4;
+				const std::uint8_t* row1 = src + std::size_t(std::min(y * 2 + 1, srcHeight - 1)) * srcWidth * 4;
+				for (std::int32_t x = 0; x < width; x++) {
+					const std::int32_t x0 = std::min(x * 2, srcWidth - 1) * 4;
+					const std::int32_t x1 = std::min(x * 2 + 1, srcWidth - 1) * 4;
+					for (std::int32_t c = 0; c < 4; c++) {
+						*dst++ = std::uint8_t((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) >> 2);
+					}
+				}
+			}
+
+			src = storage.pixels.data();
+			srcWidth = width;
+			srcHeight = height;
+		}
+	}
+
+	void SwTexture::UpdateTiledPixels(std::int32_t level) const
+	{
+		Level& storage = _levels[level];
+		if (storage.tiledVersion == _contentVersion && !storage.tiledPixels.empty()) {
+			return;
+		}
+
+		const std::uint8_t* src = (level == 0 ? _pixels.data() : storage.pixels.data());
+		const std::int32_t width = (level == 0 ? _width : storage.width);
+		const std::int32_t height = (level == 0 ? _height : storage.height);
+		const std::int32_t blocksPerRow = (width + TileBlockSize - 1) / TileBlockSize;
+		const std::int32_t blockRows = (height + TileBlockSize - 1) / TileBlockSize;
+		const std::size_t size = std::size_t(blocksPerRow) * std::size_t(blockRows) * TileBlockSize * TileBlockSize * std::size_t(_bytesPerPixel);
+		// Like the mip chain, the size only changes after Allocate() dropped the copy
+		if (storage.tiledPixels.size() != size) {
+			storage.tiledPixels.assign(size, std::uint8_t(0));
+		}
+
+		std::uint8_t* dst = storage.tiledPixels.data();
+		const std::int32_t bpp = _bytesPerPixel;
+		for (std::int32_t y = 0; y < height; y++) {
+			const std::uint8_t* srcRow = src + std::size_t(y) * width * bpp;
+			for (std::int32_t x = 0; x < width; x++) {
+				std::memcpy(dst + TexelIndex(x, y, width, blocksPerRow) * bpp, srcRow + std::size_t(x) * bpp, bpp);
+			}
+		}
+		storage.tiledVersion = _contentVersion;
 	}
 
 	void SwTexture::SetUnpackAlignment(std::int32_t alignment)
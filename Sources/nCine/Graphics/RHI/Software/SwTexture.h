@@ -24,14 +24,47 @@ namespace nCine::RHI::Software
 		the texture is attached as a render target (the rasterizer composites 4 bytes per pixel). It
 		exposes the neutral upload surface `Texture.cpp` drives (`TexImage2D`, `TexSubImage2D`,
 		`TexStorage2D`, filter/wrap/swizzle setters); binding records the texture on the device so the
-		effect running the draw can read its texels. Mip levels above 0 and compressed formats are
-		accepted but not stored (the fast path samples level 0 only).
+		effect running the draw can read its texels. Compressed formats are accepted but not stored.
+
+		The quad rasterizers don't have to sample the linear level-0 rows, see @ref GetSampledLevel():
+		- Rotated and skewed quads walk the texture diagonally, so each pixel of a linear store can touch
+		  a different cache line. Large textures hand them a copy in a tiled layout instead, 4x4 texel
+		  blocks in Morton order, where a texel's neighbours in both directions share the line.
+		- Minified quads of a texture with a mipmap minification filter sample a smaller level of the mip
+		  chain. Levels uploaded by the caller are stored, otherwise the chain is generated from level 0.
+		Both are derived caches, built on first use and rebuilt after an upload. Render targets are always
+		sampled from their level-0 rows, as the rasterizer writes them without bumping the content version.
 	*/
 	class SwTexture
 	{
 	public:
 		/** @brief Number of texture units tracked by the device */
 		static constexpr std::uint32_t MaxTextureUnits = 8;
+		/** @brief Side of the square texel blocks of the tiled layout */
+		static constexpr std::int32_t TileBlockSize = 4;
+
+		/** @brief Texels of one level in the form a sampler reads them, see @ref GetSampledLevel() */
+		struct SampledLevel
+		{
+			/** @brief Base of the texel store, `nullptr` before an upload */
+			const std::uint8_t* pixels;
+			/** @brief Width of the level in texels */
+			std::int32_t width;
+			/** @brief Height of the level in texels */
+			std::int32_t height;
+			/** @brief Number of blocks per block row of the tiled layout, `0` if the store has linear rows */
+			std::int32_t blocksPerRow;
+		};
+
+		/** @brief Returns the index of texel (@p x, @p y) in a level store, see @ref SampledLevel::blocksPerRow */
+		static inline std::size_t TexelIndex(std::int32_t x, std::int32_t y, std::int32_t width, std::int32_t blocksPerRow) {
+			if (blocksPerRow == 0) {
+				return std::size_t(y) * std::size_t(width) + std::size_t(x);
+			}
+			// Blocks are stored in row-major order, the 16 texels of a block in Morton order
+			const std::uint32_t inBlock = std::uint32_t((x & 1) | ((y & 1) << 1) | ((x & 2) << 1) | ((y & 2) << 2));
+			return (std::size_t((y >> 2) * blocksPerRow + (x >> 2)) << 4) | inBlock;
+		}
 
 		explicit SwTexture(TextureTarget target);
 		~SwTexture();
@@ -93,6 +126,10 @@ namespace nCine::RHI::Software
 		inline nCine::SamplerFilter GetMagFilter() const {
 			return _magFilter;
 		}
+		/** @brief Returns the minification filter (decides whether minified quads sample the mip chain) */
+		inline nCine::SamplerFilter GetMinFilter() const {
+			return _minFilter;
+		}
 		/** @brief Returns `true` if the texture is bound as a color render target (its store is treated as bottom-up by the fast blit) */
 		inline bool IsRenderTarget() const {
 			return _isRenderTarget;
@@ -114,6 +151,25 @@ namespace nCine::RHI::Software
 			return _contentVersion;
 		}
 
+		/**
+		 * @brief Returns the mip level a quad samples when @p texelsPerPixel level-0 texels map to one screen pixel
+		 *
+		 * Returns `0` unless the minification filter uses mipmaps and the texture has an RGBA8 store that
+		 * isn't a render target. Otherwise it returns the largest level that is still at least as detailed
+		 * as the screen, so pixel art stays sharp. A level between two others isn't blended in. Generates
+		 * the mip chain on first use.
+		 */
+		std::int32_t SelectMipLevel(float texelsPerPixel) const;
+		/**
+		 * @brief Returns the texels of a level for sampling
+		 *
+		 * With @p preferTiled, a texture too large for the L1 cache returns a copy in the tiled layout, see
+		 * @ref TexelIndex(). The copy is built on first use. The returned store stays valid until the
+		 * texture is reallocated, and later uploads are copied into it in place. Called only from the thread
+		 * that submits the draws, the tile workers just read the stores it returns.
+		 */
+		SampledLevel GetSampledLevel(std::int32_t level, bool preferTiled) const;
+
 		/** @brief Binds the texture to the specified texture unit on the device */
 		bool Bind(std::uint32_t textureUnit) const;
 		/** @brief Binds the texture to texture unit 0 */
@@ -146,7 +202,7 @@ namespace nCine::RHI::Software
 		void SetWrap(SamplerWrapping wrap);
 		/** @brief Sets the sampling swizzle (stored; used by the palette path) */
 		void SetSwizzle(SwizzleChannel r, SwizzleChannel g, SwizzleChannel b, SwizzleChannel a);
-		/** @brief Sets the highest defined mipmap level (ignored) */
+		/** @brief Sets the highest mipmap level the quads may sample */
 		void SetMaxLevel(std::int32_t maxLevel);
 		/** @brief Sets the client pixel-row alignment of uploads (ignored, uploads are tightly packed) */
 		static void SetUnpackAlignment(std::int32_t alignment);
@@ -177,6 +233,19 @@ namespace nCine::RHI::Software
 		static std::int32_t BytesPerPixel(PixelFormat format);
 
 	private:
+		/** @brief Level store; the level-0 entry only holds the tiled copy, its texels are in `_pixels` */
+		struct Level
+		{
+			std::vector<std::uint8_t> pixels;
+			std::vector<std::uint8_t> tiledPixels;
+			std::int32_t width;
+			std::int32_t height;
+			std::uint32_t tiledVersion;
+		};
+
+		/** @brief Level stores smaller than this fit in the L1 cache, they aren't tiled */
+		static constexpr std::size_t MinTiledStoreBytes = 32 * 1024;
+
 		static std::uint32_t _nextHandle;
 		static std::uint32_t _nextContentVersion;
 
@@ -195,8 +264,15 @@ namespace nCine::RHI::Software
 		SwizzleChannel _swizzle[4];
 		mutable std::uint32_t _textureUnit;
 		std::vector<std::uint8_t> _pixels;
+		mutable std::vector<Level> _levels;
+		mutable std::uint32_t _mipVersion;
+		std::int32_t _maxLevel;
 		bool _isRenderTarget;
+		bool _hasUploadedMips;
 
 		void Allocate(PixelFormat format, std::int32_t width, std::int32_t height);
+		void AllocateLevel(std::int32_t level, std::int32_t width, std::int32_t height);
+		void UpdateMipChain() const;
+		void UpdateTiledPixels(std::int32_t level) const;
 	};
 }
@@ -219,7 +219,7 @@ namespace nCine::RHI::Software
 		static inline void SampleBilinearFix(const std::uint8_t* texPixels, std::int32_t texW, std::int32_t texH, std::int32_t texBpp,
 		                                     std::int32_t uFix, std::int32_t vFix,
 		                                     SamplerWrapping wrapS, SamplerWrapping wrapT,
-		                                     std::uint8_t* out)
+		                                     std::uint8_t* out, std::int32_t texBlocksPerRow = 0)
 		{
 			const std::int32_t uf = uFix - (1 << 15);
 			const std::int32_t vf = vFix - (1 << 15);
@@ -232,10 +232,10 @@ namespace nCine::RHI::Software
 			x0 = WrapTexelCoord(x0, texW, wrapS);
 			y0 = WrapTexelCoord(y0, texH, wrapT);
 
-			const std::uint8_t* c00 = texPixels + (static_cast<std::size_t>(y0) * texW + x0) * texBpp;
-			const std::uint8_t* c10 = texPixels + (static_cast<std::size_t>(y0) * texW + x1) * texBpp;
-			const std::uint8_t* c01 = texPixels + (static_cast<std::size_t>(y1) * texW + x0) * texBpp;
-			const std::uint8_t* c11 = texPixels + (static_cast<std::size_t>(y1) * texW + x1) * texBpp;
+			const std::uint8_t* c00 = texPixels + SwTexture::TexelIndex(x0, y0, texW, texBlocksPerRow) * texBpp;
+			const std::uint8_t* c10 = texPixels + SwTexture::TexelIndex(x1, y0, texW, texBlocksPerRow) * texBpp;
+			const std::uint8_t* c01 = texPixels + SwTexture::TexelIndex(x0, y1, texW, texBlocksPerRow) * texBpp;
+			const std::uint8_t* c11 = texPixels + SwTexture::TexelIndex(x1, y1, texW, texBlocksPerRow) * texBpp;
 			std::uint8_t f00[4], f10[4], f01[4], f11[4];
 			if DEATH_UNLIKELY(texBpp != 4) {
 				SwExpandTexel(f00, c00, texBpp); c00 = f00;
@@ -413,8 +413,8 @@ namespace nCine::RHI::Software
 				const float wy = ay * ctx.ff.spriteSize[1];
 
 				const float* m = ctx.ff.mvpMatrix;
-				out.x = m[0] * wx + m[4] * wy + m[12];
-				out.y = m[1] * wx + m[5] * wy + m[13];
+				out.x = m[0] * wx + m[2] * wy + m[4];
+				out.y = m[1] * wx + m[3] * wy + m[5];
 
 				out.u = ax * ctx.ff.texRect[0] + ctx.ff.texRect[1];
 				out.v = ay * ctx.ff.texRect[2] + ctx.ff.texRect[3];
@@ -476,6 +476,7 @@ namespace nCine::RHI::Software
 			prep.v[1] = v1;
 			prep.v[2] = v2;
 			prep.v[3] = v3;
+			std::memcpy(prep.color, ctx.ff.color, sizeof(prep.color));
 
 			// Check axis-aligned (same tolerance as the immediate path)
 			prep.axisAligned = (std::fabs(v0.x - v1.x) < 0.5f && std::fabs(v2.x - v3.x) < 0.5f &&
@@ -490,10 +491,19 @@ namespace nCine::RHI::Software
 			// Texture info
 			const SwTexture* tex = (ctx.ff.hasTexture && ctx.ff.textureUnit < static_cast<std::int32_t>(MaxTextureUnits)
 			                ? ctx.textures[ctx.ff.textureUnit] : nullptr);
-			prep.texPixels = (tex != nullptr ? tex->GetPixels(0) : nullptr);
-			prep.texW = (tex != nullptr ? tex->GetWidth() : 0);
-			prep.texH = (tex != nullptr ? tex->GetHeight() : 0);
+			// A minified quad samples a smaller mip level, a rotated one the tiled copy of a large texture; a
+			// fragment callback gets level 0, as it may read the texture itself (see SwTexture::GetSampledLevel)
+			SwTexture::SampledLevel texLevel = { nullptr, 0, 0, 0 };
+			if (tex != nullptr) {
+				const std::int32_t level = (ctx.fragmentShader == nullptr
+					? tex->SelectMipLevel(QuadTexelsPerPixel(v0, v1, v2, tex->GetWidth(), tex->GetHeight())) : 0);
+				texLevel = tex->GetSampledLevel(level, !prep.axisAligned);
+			}
+			prep.texPixels = texLevel.pixels;
+			prep.texW = texLevel.width;
+			prep.texH = texLevel.height;
 			prep.texBpp = (tex != nullptr ? tex->GetBytesPerPixel() : 4);
+			prep.texBlocksPerRow = texLevel.blocksPerRow;
 			prep.wrapS = (tex != nullptr ? tex->GetWrapS() : SamplerWrapping::ClampToEdge);
 			prep.wrapT = (tex != nullptr ? tex->GetWrapT() : SamplerWrapping::ClampToEdge);
 			prep.useLinear = (tex != nullptr && tex->GetMagFilter() == SamplerFilter::Linear && prep.texW > 1 && prep.texH > 1);
@@ -818,7 +828,7 @@ namespace nCine::RHI::Software
 						fsInput.texWidth = texW;
 						fsInput.texHeight = texH;
 						fsInput.textures = ctx.textures;
-						fsInput.color = ctx.ff.color;
+						fsInput.color = prep.color;
 						fsInput.userData = ctx.fragmentShaderUserData;
 						const float invTexW = 1.0f / static_cast<float>(texW > 0 ? texW : 1);
 						std::int32_t txFixShader = txBase;
@@ -900,7 +910,7 @@ namespace nCine::RHI::Software
 							fsInput.texWidth = texW;
 							fsInput.texHeight = texH;
 							fsInput.textures = ctx.textures;
-							fsInput.color = ctx.ff.color;
+							fsInput.color = prep.color;
 							fsInput.userData = ctx.fragmentShaderUserData;
 							cachedShader(fsInput);
 							sR = px4[0]; sG = px4[1]; sB = px4[2]; sA = px4[3];
@@ -999,6 +1009,7 @@ namespace nCine::RHI::Software
 			const std::int32_t texW = prep.texW;
 			const std::int32_t texH = prep.texH;
 			const std::int32_t texBpp = prep.texBpp;
+			const std::int32_t texBlocksPerRow = prep.texBlocksPerRow;
 			const SamplerWrapping wrapS = prep.wrapS;
 			const SamplerWrapping wrapT = prep.wrapT;
 			const bool useLinear = prep.useLinear;
@@ -1055,13 +1066,13 @@ namespace nCine::RHI::Software
 							if (texPixels != nullptr) {
 								if (useLinear) {
 									std::uint8_t raw[4];
-									SampleBilinearFix(texPixels, texW, texH, texBpp, uFix, vFix, wrapS, wrapT, raw);
+									SampleBilinearFix(texPixels, texW, texH, texBpp, uFix, vFix, wrapS, wrapT, raw, texBlocksPerRow);
 									sR = raw[0]; sG = raw[1]; sB = raw[2]; sA = raw[3];
 								} else {
 									std::int32_t srcX = std::max(0, std::min(texW - 1, WrapTexelFix(uFix, texW, wrapS)));
 									std::int32_t srcY = std::max(0, std::min(texH - 1, WrapTexelFix(vFix, texH, wrapT)));
 									std::uint8_t raw[4];
-									SwExpandTexel(raw, texPixels + (static_cast<std::size_t>(srcY) * texW + srcX) * texBpp, texBpp);
+									SwExpandTexel(raw, texPixels + SwTexture::TexelIndex(srcX, srcY, texW, texBlocksPerRow) * texBpp, texBpp);
 									sR = raw[0]; sG = raw[1]; sB = raw[2]; sA = raw[3];
 								}
 							} else {
@@ -1096,7 +1107,7 @@ namespace nCine::RHI::Software
 								fsInput.texWidth = texW;
 								fsInput.texHeight = texH;
 								fsInput.textures = ctx.textures;
-								fsInput.color = ctx.ff.color;
+								fsInput.color = prep.color;
 								fsInput.userData = ctx.fragmentShaderUserData;
 								cachedShader(fsInput);
 								sR = px4[0]; sG = px4[1]; sB = px4[2]; sA = px4[3];
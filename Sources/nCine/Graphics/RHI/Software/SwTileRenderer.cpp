@@ -2,8 +2,10 @@
 
 #include "SwTileRenderer.h"
 #include "SwShaderRuntime.h"	// sw::swTexture / sw::floor / sw::mod, replicated by the palette-LUT builder
+#include "../../../tracy.h"
 
 #include <Containers/SmallVector.h>
+#include <Cryptography/xxHash.h>
 
 #if defined(DEATH_ENABLE_NEON)
 #	include <arm_neon.h>
@@ -15,6 +17,7 @@
 #include <cstring>
 
 using namespace Death::Containers;
+using namespace Death::Cryptography;
 
 namespace nCine::RHI::Software
 {
@@ -55,6 +58,51 @@ namespace nCine::RHI::Software
 				std::int32_t alphaByteOffset;
 			};
 
+			// Tile hashes of one surface (the screen or a render-target texture) from its previous flushes. A hash
+			// describes what the tile of the surface physically holds, so the next flush can tell whether its
+			// commands would produce the same pixels again; 0 means unknown (not rendered by the layer yet, or
+			// written behind its back).
+			struct SurfaceHistory
+			{
+				const std::uint8_t* buffer = nullptr;
+				std::int32_t width = 0;
+				std::int32_t height = 0;
+				bool isFboTarget = false;
+				std::uint32_t lastUse = 0;
+				// Advanced whenever a pixel of the surface changes; identifies the content of a render target
+				// sampled by a later draw, because render-target writes don't advance the texture's content version
+				std::uint64_t contentStamp = 0;
+				SmallVector<std::uint64_t, 0> tileHashes;
+			};
+
+			// Number of surfaces whose tile hashes are kept - the screen plus the render targets of one frame
+			static constexpr std::int32_t MaxTrackedSurfaces = 8;
+
+			// Fixed seeds of the tile hash: the state a tile starts from before its first binned command runs
+			static constexpr std::uint64_t OpaqueCoverSeed = 0x4F70617175654376ull;
+			static constexpr std::uint64_t ClearSeed = 0x436C656172436F6Cull;
+
+			// Hashed fields of a deferred command, explicitly packed so no padding bytes end up in the hash
+			struct CommandHashKey
+			{
+				float mvpMatrix[6];
+				float color[4];
+				float texRect[4];
+				float spriteSize[2];
+				std::int32_t textureUnit;
+				std::uint32_t flags;
+				std::int32_t scissorRect[4];
+				std::int32_t viewport[4];
+				std::int32_t primType;
+				std::int32_t firstVertex;
+				std::int32_t count;
+				std::int32_t vertexStride;
+				std::uint64_t fragmentShader;
+				std::uint64_t textures[MaxTextureUnits];
+				std::uint64_t textureStamps[MaxTextureUnits];
+				std::uint32_t samplers[MaxTextureUnits];
+			};
+
 			struct TileState
 			{
 				bool initialized = false;
@@ -79,7 +127,13 @@ namespace nCine::RHI::Software
 				SmallVector<DeferredCommand, 0> commands;
 				std::int32_t commandCount = 0;
 
-				// Per-tile command index lists for binning (uint16_t indices into the commands arena), sized
+				// Instance arena: the drawn items of the live commands, grown and reused the same way. Slots
+				// [0, instanceCount) are live; each refers to its command by index, so growth of either
+				// arena never invalidates it.
+				SmallVector<DeferredInstance, 0> instances;
+				std::int32_t instanceCount = 0;
+
+				// Per-tile instance index lists for binning (uint16_t indices into the instance arena), sized
 				// by SetTargetBuffer to the actual destination's tile count (kept at the largest seen)
 				SmallVector<SmallVector<std::uint16_t, 64>, 0> tileBins;
 
@@ -91,6 +145,19 @@ namespace nCine::RHI::Software
 				// Current render target buffer
 				std::uint8_t* targetBuffer = nullptr;
 				bool isFboTarget = false;
+
+				// Damage tracking: tile hashes of the recently used surfaces (the current target's history is
+				// null while the layer is disabled) and the clear deferred to the next flush by SubmitClear()
+				bool damageTracking = true;
+				bool clearPending = false;
+				std::uint32_t clearColor = 0;
+				std::uint64_t clearHash = 0;
+				SurfaceHistory surfaces[MaxTrackedSurfaces];
+				SurfaceHistory* surface = nullptr;
+				std::uint32_t surfaceUseCounter = 0;
+				std::uint64_t nextContentStamp = 0;
+				std::atomic<std::uint32_t> renderedTiles{0};
+				std::atomic<std::uint32_t> skippedTiles{0};
 #if defined(RHI_USE_FB16)
 				// Whether targetBuffer is the RGB565 screen framebuffer (tiles are rasterized in RGBA8
 				// scratch either way; only the tile <-> framebuffer copies convert)
@@ -110,10 +177,15 @@ namespace nCine::RHI::Software
 				CondVariable workDone;
 				std::atomic<std::int32_t> workersActive{0};
 				std::int32_t numSpawnedWorkers = 0; // Actual threads created — may be < MaxWorkers if spawn fails
+				std::int32_t workerCountOverride = -1; // Set by SetWorkerCount(), negative = derive from the CPU count
 				bool shutdownRequested = false;
 
 				// Work distribution
 				std::atomic<std::int32_t> nextTileIndex{0};
+				// Job of the current RunParallel() dispatch, workers process tiles when it's null
+				ParallelJobFunc jobFunc = nullptr;
+				void* jobUserData = nullptr;
+				std::int32_t jobCount = 0;
 				std::int32_t flushGeneration = 0; // Incremented each Flush to prevent worker re-entry
 				std::int32_t workerGeneration[MaxWorkers] = {}; // Last generation each worker processed
 
@@ -140,6 +212,127 @@ namespace nCine::RHI::Software
 
 			TileState g_tile;
 
+			// =====================================================================
+			// Damage tracking
+			// =====================================================================
+
+			inline std::uint64_t CombineHash(std::uint64_t hash, std::uint64_t value)
+			{
+				hash ^= value + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+				return hash;
+			}
+
+			void ResetSurfaceHistory(SurfaceHistory& surface)
+			{
+				surface.contentStamp = ++g_tile.nextContentStamp;
+				std::int32_t tileCount = ((surface.width + TileSize - 1) >> TileSizeShift) * ((surface.height + TileSize - 1) >> TileSizeShift);
+				surface.tileHashes.assign(tileCount, 0);
+			}
+
+			// Returns the history of the surface, reusing the least recently used slot for a new one
+			SurfaceHistory* AcquireSurfaceHistory(const std::uint8_t* buffer, std::int32_t width, std::int32_t height, bool isFboTarget)
+			{
+				SurfaceHistory* surface = nullptr;
+				SurfaceHistory* leastRecent = &g_tile.surfaces[0];
+				for (SurfaceHistory& s : g_tile.surfaces) {
+					if (s.buffer == buffer) {
+						surface = &s;
+						break;
+					}
+					if (s.lastUse < leastRecent->lastUse) {
+						leastRecent = &s;
+					}
+				}
+
+				if (surface == nullptr || surface->width != width || surface->height != height || surface->isFboTarget != isFboTarget) {
+					if (surface == nullptr) {
+						surface = leastRecent;
+					}
+					surface->buffer = buffer;
+					surface->width = width;
+					surface->height = height;
+					surface->isFboTarget = isFboTarget;
+					ResetSurfaceHistory(*surface);
+				}
+
+				surface->lastUse = ++g_tile.surfaceUseCounter;
+				return surface;
+			}
+
+			// Returns a stamp identifying the current content of a render target that is sampled as a texture,
+			// a surface without history gets a unique one, so draws sampling it never match a previous frame
+			std::uint64_t GetSurfaceContentStamp(const std::uint8_t* buffer)
+			{
+				if (buffer != nullptr) {
+					for (const SurfaceHistory& s : g_tile.surfaces) {
+						if (s.buffer == buffer) {
+							return s.contentStamp;
+						}
+					}
+				}
+				return ++g_tile.nextContentStamp;
+			}
+
+			// Hashes everything the output of a submitted command depends on. Textures are identified by their
+			// content version (globally unique per upload) and sampler state, render targets by the content stamp
+			// of their surface. The effect parameter block and the general vertices are hashed from the command's
+			// own snapshots.
+			std::uint64_t ComputeCommandHash(const DeferredCommand& cmd)
+			{
+				const DrawContext& ctx = cmd.ctx;
+
+				CommandHashKey key;
+				std::memset(&key, 0, sizeof(key));
+				std::memcpy(key.mvpMatrix, ctx.ff.mvpMatrix, sizeof(key.mvpMatrix));
+				std::memcpy(key.color, ctx.ff.color, sizeof(key.color));
+				std::memcpy(key.texRect, ctx.ff.texRect, sizeof(key.texRect));
+				std::memcpy(key.spriteSize, ctx.ff.spriteSize, sizeof(key.spriteSize));
+				key.textureUnit = ctx.ff.textureUnit;
+				key.flags = (ctx.ff.hasTexture ? 0x01 : 0) | (ctx.blendingEnabled ? 0x02 : 0) | (ctx.scissorEnabled ? 0x04 : 0) |
+					(ctx.paletteRemapHint ? 0x08 : 0) | (ctx.constantColorHint ? 0x10 : 0) |
+					(std::uint32_t(ctx.blendSrc) << 8) | (std::uint32_t(ctx.blendDst) << 16);
+				if (ctx.scissorEnabled) {
+					key.scissorRect[0] = ctx.scissorRect.X;
+					key.scissorRect[1] = ctx.scissorRect.Y;
+					key.scissorRect[2] = ctx.scissorRect.W;
+					key.scissorRect[3] = ctx.scissorRect.H;
+				}
+				key.viewport[0] = cmd.viewportX;
+				key.viewport[1] = cmd.viewportY;
+				key.viewport[2] = cmd.viewportW;
+				key.viewport[3] = cmd.viewportH;
+				key.primType = std::int32_t(cmd.primType);
+				key.firstVertex = cmd.firstVertex;
+				key.count = cmd.count;
+				key.vertexStride = ctx.vertexStride;
+				key.fragmentShader = std::uint64_t(reinterpret_cast<std::uintptr_t>(ctx.fragmentShader));
+				for (std::uint32_t i = 0; i < MaxTextureUnits; i++) {
+					const SwTexture* texture = ctx.textures[i];
+					if (texture == nullptr) {
+						continue;
+					}
+					key.textures[i] = std::uint64_t(reinterpret_cast<std::uintptr_t>(texture));
+					// The high bit keeps the two kinds of stamps apart
+					key.textureStamps[i] = (texture->IsRenderTarget()
+						? (GetSurfaceContentStamp(texture->GetPixels(0)) | (1ull << 63))
+						: texture->GetContentVersion());
+					const SwizzleChannel* swizzle = texture->GetSwizzle();
+					key.samplers[i] = std::uint32_t(texture->GetMagFilter()) | (std::uint32_t(texture->GetMinFilter()) << 4) |
+						(std::uint32_t(texture->GetWrapS()) << 8) |
+						(std::uint32_t(swizzle[0]) << 16) | (std::uint32_t(swizzle[1]) << 20) |
+						(std::uint32_t(swizzle[2]) << 24) | (std::uint32_t(swizzle[3]) << 28);
+				}
+
+				std::uint64_t hash = xxHash3(&key, sizeof(key));
+				if (ctx.fragmentShader != nullptr && ctx.fragmentShaderUserData != nullptr) {
+					hash = xxHash3(cmd.userDataStorage, ctx.fragmentShaderUserDataSize, hash);
+				}
+				if (ctx.vertexData != nullptr) {
+					hash = xxHash3(cmd.vertexStorage.data(), cmd.vertexStorage.size() * sizeof(float), hash);
+				}
+				return hash;
+			}
+
 			// =====================================================================
 			// Palette-LUT builder for the PaletteRemap fast path (see SwPaletteLut in SwRaster.h)
 			// =====================================================================
@@ -273,6 +466,127 @@ namespace nCine::RHI::Software
 				return std::int32_t(g_tile.paletteLuts.size()) - 1;
 			}
 
+			// =====================================================================
+			// Submission helpers shared by SubmitCommand() and SubmitInstances()
+			// =====================================================================
+
+			// Fills the next command slot (growing the arena on demand, capacity and each slot's heap allocations
+			// retained across frames) with the context and the viewport of a new command. Growth may move the
+			// live slots below it; that is safe because their self-referential ctx pointers are only fixed up
+			// (and dereferenced) at Flush. The slot only becomes live when the caller increments commandCount,
+			// so a discarded command is simply reused by the next submission.
+			DeferredCommand& BeginCommand(const DrawContext& ctx)
+			{
+				const std::int32_t cmdIdx = g_tile.commandCount;
+				if (cmdIdx >= std::int32_t(g_tile.commands.size())) {
+					g_tile.commands.emplace_back();
+				}
+				DeferredCommand& cmd = g_tile.commands[cmdIdx];
+				cmd.ctx = ctx;
+				// scissorRect.Y is stored in top-down screen space so the tile rasterizer can use it directly as a
+				// pixel-row clip. ctx.scissorRect.Y is bottom-up (the RHI scissor convention), so flip it here.
+				if DEATH_UNLIKELY(ctx.scissorEnabled) {
+					cmd.ctx.scissorRect.Y = g_tile.fbHeight - ctx.scissorRect.Y - ctx.scissorRect.H;
+				}
+				// Use the viewport snapshot for the NDC→screen transform (mirrors SwRaster::SetViewport). Fall
+				// back to the full buffer when no explicit viewport was set (matches SwDevice::Dispatch).
+				if (g_tile.viewportW > 0 && g_tile.viewportH > 0) {
+					cmd.viewportX = g_tile.viewportX;
+					cmd.viewportY = g_tile.viewportY;
+					cmd.viewportW = g_tile.viewportW;
+					cmd.viewportH = g_tile.viewportH;
+				} else {
+					cmd.viewportX = 0;
+					cmd.viewportY = 0;
+					cmd.viewportW = g_tile.fbWidth;
+					cmd.viewportH = g_tile.fbHeight;
+				}
+				cmd.paletteLutIndex = -1;
+				return cmd;
+			}
+
+			// Returns the next instance slot, which becomes live when the caller increments instanceCount
+			DeferredInstance& BeginInstance(std::int32_t command)
+			{
+				const std::int32_t instIdx = g_tile.instanceCount;
+				if (instIdx >= std::int32_t(g_tile.instances.size())) {
+					g_tile.instances.emplace_back();
+				}
+				DeferredInstance& inst = g_tile.instances[instIdx];
+				inst.command = command;
+				inst.opaqueOverwrite = false;
+				return inst;
+			}
+
+			// Clips inclusive screen-space bounds to the command's scissor (already flipped to top-down rows by
+			// BeginCommand), returns false when nothing is left
+			inline bool ClipToScissor(const DrawContext& cmdCtx, std::int32_t& minX, std::int32_t& minY, std::int32_t& maxX, std::int32_t& maxY)
+			{
+				if DEATH_UNLIKELY(cmdCtx.scissorEnabled) {
+					minX = std::max(minX, cmdCtx.scissorRect.X);
+					minY = std::max(minY, cmdCtx.scissorRect.Y);
+					maxX = std::min(maxX, cmdCtx.scissorRect.X + cmdCtx.scissorRect.W - 1);
+					maxY = std::min(maxY, cmdCtx.scissorRect.Y + cmdCtx.scissorRect.H - 1);
+				}
+				return (minX <= maxX && minY <= maxY);
+			}
+
+			// Classifies a destination-independent full write (the reverse-painter cull's trigger, see the
+			// field in SwTileRenderer.h). Only an axis-aligned procedural quad qualifies - it writes every
+			// pixel of its drawn rectangle - and only when nothing it writes depends on the destination:
+			// blending off (whatever the source, the write replaces the pixel), or the fast blend pair with
+			// a source that is provably opaque everywhere (src-over with alpha 255 is the same replace).
+			void ClassifyOverwrite(const DeferredCommand& cmd, DeferredInstance& inst)
+			{
+				const PreparedQuad& prep = inst.prep;
+				inst.opaqueOverwrite = false;
+				if (!prep.valid || !prep.axisAligned) {
+					return;
+				}
+				bool overwrites = !prep.useBlend;
+				if (!overwrites && prep.useFastBlend) {
+					if (prep.constantFill) {
+						overwrites = (prep.constColor[3] >= 255);
+					} else if (cmd.paletteLutIndex >= 0) {
+						// Every LUT entry opaque and the source alpha a constant 1 - each sampled texel,
+						// whatever its index, lands on an opaque entry
+						const SwPaletteLut& lut = g_tile.paletteLuts[cmd.paletteLutIndex];
+						overwrites = (lut.allOpaque && lut.alphaByteOffset == -1);
+					}
+				}
+				if (!overwrites) {
+					return;
+				}
+				// The axis-aligned rasterizer writes exactly [int(fxMin), int(fxMax - 0.5)] per axis
+				// (tile-clipped); the binning AABB rounds the max edges up to int(fxMax), which may claim
+				// one pixel column/row the rasterizer never writes - fine for binning (conservative) but
+				// not for a cover test, so the cull gets its own exact rectangle
+				std::int32_t coverMinX = static_cast<std::int32_t>(prep.fxMin);
+				std::int32_t coverMaxX = static_cast<std::int32_t>(prep.fxMax - 0.5f);
+				std::int32_t coverMinY = static_cast<std::int32_t>(prep.fyMin);
+				std::int32_t coverMaxY = static_cast<std::int32_t>(prep.fyMax - 0.5f);
+				inst.opaqueOverwrite = ClipToScissor(cmd.ctx, coverMinX, coverMinY, coverMaxX, coverMaxY);
+				inst.coverMinX = coverMinX;
+				inst.coverMinY = coverMinY;
+				inst.coverMaxX = coverMaxX;
+				inst.coverMaxY = coverMaxY;
+			}
+
+			// Appends an instance to the bins of every tile its inclusive screen-space bounds overlap
+			void BinInstance(std::int32_t instIdx, std::int32_t minX, std::int32_t minY, std::int32_t maxX, std::int32_t maxY)
+			{
+				const std::int32_t tileMinCol = std::max(0, minX >> TileSizeShift);
+				const std::int32_t tileMaxCol = std::min(g_tile.tilesX - 1, maxX >> TileSizeShift);
+				const std::int32_t tileMinRow = std::max(0, minY >> TileSizeShift);
+				const std::int32_t tileMaxRow = std::min(g_tile.tilesY - 1, maxY >> TileSizeShift);
+
+				for (std::int32_t row = tileMinRow; row <= tileMaxRow; row++) {
+					for (std::int32_t col = tileMinCol; col <= tileMaxCol; col++) {
+						g_tile.tileBins[row * g_tile.tilesX + col].push_back(static_cast<std::uint16_t>(instIdx));
+					}
+				}
+			}
+
 			// Per-tile scratch buffer (each worker uses its own slice; slot 0 belongs to the main thread,
 			// slots 1..MaxWorkers to the workers): 32x32x4 = 4096 bytes per slice, so each slice also starts
 			// on its own cache line
@@ -384,16 +698,16 @@ namespace nCine::RHI::Software
 				}
 
 				const auto& bin = g_tile.tileBins[tileIndex];
-				if (bin.empty()) {
+				if (bin.empty() && !g_tile.clearPending) {
 					return; // No commands touch this tile - nothing to do
 				}
 
 				// Thread-local scratch buffer
 				std::uint8_t* tileBuf = g_tileScratch[workerIndex];
 
-				// Reverse-painter cull: the last command that overwrites this whole tile independent of the
+				// Reverse-painter cull: the last instance that overwrites this whole tile independent of the
 				// destination (opaqueOverwrite + full cover, see SwTileRenderer.h) makes everything before it
-				// invisible here - each earlier pixel is overwritten - so the walk starts at that command and
+				// invisible here - each earlier pixel is overwritten - so the walk starts at that instance and
 				// the framebuffer read-back is skipped entirely. In a side-scroller this is the common tile:
 				// solid ground/foreground covers it and the parallax layers behind cost nothing. Subsumes the
 				// former first-command rule (a non-blended background covering the tile), which as a bonus
@@ -402,28 +716,55 @@ namespace nCine::RHI::Software
 				std::size_t firstCmd = 0;
 				bool needsReadBack = true;
 				for (std::size_t i = bin.size(); i > 0;) {
-					const DeferredCommand& cmd = g_tile.commands[bin[--i]];
-					if (cmd.opaqueOverwrite &&
-					    cmd.coverMinX <= tileX && cmd.coverMinY <= tileY &&
-					    cmd.coverMaxX >= tileX + tileW - 1 && cmd.coverMaxY >= tileY + tileH - 1) {
+					const DeferredInstance& inst = g_tile.instances[bin[--i]];
+					if (inst.opaqueOverwrite &&
+					    inst.coverMinX <= tileX && inst.coverMinY <= tileY &&
+					    inst.coverMaxX >= tileX + tileW - 1 && inst.coverMaxY >= tileY + tileH - 1) {
 						firstCmd = i;
 						needsReadBack = false;
 						break;
 					}
 				}
 
+				// Damage tracking: fold the visible instances into a hash of the tile's final content, starting from
+				// what the tile is initialized with. If the surface still holds exactly that from a previous flush,
+				// there's nothing to do. A read-back of unknown content can't be hashed, so the tile is rendered.
+				std::uint64_t* storedHash = (g_tile.surface != nullptr ? &g_tile.surface->tileHashes[tileIndex] : nullptr);
+				std::uint64_t tileHash = 0;
+				if (g_tile.damageTracking && storedHash != nullptr) {
+					tileHash = (!needsReadBack ? OpaqueCoverSeed : (g_tile.clearPending ? g_tile.clearHash : *storedHash));
+					if (tileHash != 0) {
+						for (std::size_t k = firstCmd; k < bin.size(); k++) {
+							tileHash = CombineHash(tileHash, g_tile.instances[bin[k]].contentHash);
+						}
+						if DEATH_UNLIKELY(tileHash == 0) {
+							tileHash = 1;
+						}
+						if (tileHash == *storedHash) {
+							g_tile.skippedTiles.fetch_add(1, std::memory_order_relaxed);
+							return;
+						}
+					}
+				}
+
 				if (needsReadBack) {
-					// Initialize the tile with current framebuffer contents (needed for correct blending)
-					CopyFramebufferToTile(tileBuf, g_tile.targetBuffer,
-					                      tileX, tileY, tileW, tileH,
-					                      g_tile.fbWidth, g_tile.fbHeight, g_tile.isFboTarget);
+					if (g_tile.clearPending) {
+						// The deferred full-surface clear, the stale framebuffer content is not needed
+						ClearTileBuffer(tileBuf, TileSize * TileSize, g_tile.clearColor);
+					} else {
+						// Initialize the tile with current framebuffer contents (needed for correct blending)
+						CopyFramebufferToTile(tileBuf, g_tile.targetBuffer,
+						                      tileX, tileY, tileW, tileH,
+						                      g_tile.fbWidth, g_tile.fbHeight, g_tile.isFboTarget);
+					}
 				}
 
-				// Render the visible suffix of the commands binned to this tile
+				// Render the visible suffix of the instances binned to this tile
 				for (std::size_t k = firstCmd; k < bin.size(); k++) {
-					const DeferredCommand& cmd = g_tile.commands[bin[k]];
+					const DeferredInstance& inst = g_tile.instances[bin[k]];
+					const DeferredCommand& cmd = g_tile.commands[inst.command];
 					TileInternal::RenderCommandToTile(
-						cmd.ctx, &cmd.prep, cmd.primType, cmd.firstVertex, cmd.count,
+						cmd.ctx, &inst.prep, cmd.primType, cmd.firstVertex, cmd.count,
 						tileBuf, tileX, tileY, tileW, tileH,
 						cmd.viewportX, cmd.viewportY, cmd.viewportW, cmd.viewportH);
 				}
@@ -432,15 +773,46 @@ namespace nCine::RHI::Software
 				CopyTileToFramebuffer(tileBuf, g_tile.targetBuffer,
 				                      tileX, tileY, tileW, tileH,
 				                      g_tile.fbWidth, g_tile.fbHeight, g_tile.isFboTarget);
+
+				if (storedHash != nullptr) {
+					*storedHash = tileHash;
+				}
+				g_tile.renderedTiles.fetch_add(1, std::memory_order_relaxed);
 			}
 
 #if defined(WITH_THREADS)
+			// =====================================================================
+			// Processes the work items of the current dispatch (tiles, or the indices of a RunParallel()
+			// job) from the shared atomic counter until none is left
+			// =====================================================================
+			void ProcessWorkItems(std::int32_t workerIndex)
+			{
+				if (g_tile.jobFunc != nullptr) {
+					while (true) {
+						std::int32_t idx = g_tile.nextTileIndex.fetch_add(1, std::memory_order_relaxed);
+						if (idx >= g_tile.jobCount) {
+							break;
+						}
+						g_tile.jobFunc(idx, workerIndex, g_tile.jobUserData);
+					}
+				} else {
+					while (true) {
+						std::int32_t idx = g_tile.nextTileIndex.fetch_add(1, std::memory_order_relaxed);
+						if (idx >= g_tile.totalTiles) {
+							break;
+						}
+						ProcessTile(idx, workerIndex);
+					}
+				}
+			}
+
 			// =====================================================================
 			// Worker thread function: process tiles from a shared atomic counter
 			// =====================================================================
 			void WorkerThreadFunc(void* arg)
 			{
 				const std::int32_t workerIndex = static_cast<std::int32_t>(reinterpret_cast<std::intptr_t>(arg));
+				Thread::SetCurrentName("Tile renderer");
 
 				while (true) {
 					// Wait for new work (generation must advance)
@@ -456,12 +828,9 @@ namespace nCine::RHI::Software
 					g_tile.mutex.Unlock();
 
 					// Process tiles using an atomic counter (work-stealing pattern)
-					while (true) {
-						std::int32_t idx = g_tile.nextTileIndex.fetch_add(1, std::memory_order_relaxed);
-						if (idx >= g_tile.totalTiles) {
-							break;
-						}
-						ProcessTile(idx, workerIndex + 1); // +1 because the main thread uses slot 0
+					{
+						ZoneScopedNC("Tiles", 0x6D9EC4);
+						ProcessWorkItems(workerIndex + 1); // +1 because the main thread uses slot 0
 					}
 
 					// Signal completion
@@ -474,6 +843,40 @@ namespace nCine::RHI::Software
 					g_tile.mutex.Unlock();
 				}
 			}
+
+			// Wakes the workers for the prepared dispatch, processes work items on the calling thread too
+			// and waits until all workers are done
+			void RunOnWorkers()
+			{
+				g_tile.nextTileIndex.store(0, std::memory_order_relaxed);
+
+				g_tile.mutex.Lock();
+				g_tile.flushGeneration++;
+				// Set the active count based on the successfully spawned threads
+				g_tile.workersActive.store(g_tile.numSpawnedWorkers, std::memory_order_release);
+				g_tile.workReady.Broadcast();
+				g_tile.mutex.Unlock();
+
+				// The main thread also processes work items (worker slot 0)
+				{
+					ZoneScopedNC("Tiles", 0x6D9EC4);
+					ProcessWorkItems(0);
+				}
+
+				// Wait for all workers to finish
+				{
+					ZoneScopedNC("Wait for workers", 0x6D9EC4);
+					g_tile.mutex.Lock();
+					while (g_tile.workersActive.load(std::memory_order_acquire) > 0) {
+						g_tile.workDone.Wait(g_tile.mutex);
+					}
+					g_tile.mutex.Unlock();
+				}
+
+				// Ensure all worker writes are globally visible before the engine moves on to
+				// DiscardPending or flipping buffers.
+				std::atomic_thread_fence(std::memory_order_acquire);
+			}
 #endif
 		}
 
@@ -500,7 +903,7 @@ namespace nCine::RHI::Software
 			// Spawn worker threads
 #if defined(DEATH_TARGET_VITA)
 			// Vita has 4 cores: core 0 (OS) + cores 1-3 (app). Force 3 workers.
-			const std::int32_t numWorkers = 3;
+			std::int32_t numWorkers = 3;
 #else
 			// Leave scheduling headroom instead of saturating every logical CPU: the flush barrier waits
 			// for ALL workers, so with `workers + main == logical CPUs` any other runnable thread (audio
@@ -512,11 +915,14 @@ namespace nCine::RHI::Software
 			// Small machines keep at least the 3 workers the tile renderer always used there.
 			const std::int32_t logicalCpus = static_cast<std::int32_t>(Thread::GetProcessorCount());
 			const std::int32_t reservedCpus = std::max(2, logicalCpus / 4);
-			const std::int32_t numWorkers = std::clamp(
+			std::int32_t numWorkers = std::clamp(
 				logicalCpus - 1 - reservedCpus,
 				std::min(3, logicalCpus - 1),
 				static_cast<std::int32_t>(TileState::MaxWorkers));
 #endif
+			if (g_tile.workerCountOverride >= 0) {
+				numWorkers = std::min(g_tile.workerCountOverride, static_cast<std::int32_t>(TileState::MaxWorkers));
+			}
 
 			for (std::int32_t i = 0; i < numWorkers; i++) {
 				g_tile.workers[i] = Thread(WorkerThreadFunc,
@@ -533,6 +939,8 @@ namespace nCine::RHI::Software
 			g_tile.totalTiles = 0;
 			g_tile.commandCount = 0;
 			g_tile.targetBuffer = nullptr;
+			g_tile.surface = nullptr;
+			g_tile.clearPending = false;
 		}
 
 		void Shutdown()
@@ -559,6 +967,13 @@ namespace nCine::RHI::Software
 			g_tile.initialized = false;
 		}
 
+		void SetWorkerCount(std::int32_t count)
+		{
+#if defined(WITH_THREADS)
+			g_tile.workerCountOverride = count;
+#endif
+		}
+
 		bool IsActive()
 		{
 			return g_tile.initialized;
@@ -586,7 +1001,7 @@ namespace nCine::RHI::Software
 			}
 
 			// The target is actually changing: flush whatever is still queued for the old one first
-			if (g_tile.commandCount > 0) {
+			if (g_tile.commandCount > 0 || g_tile.clearPending) {
 				Flush();
 			}
 
@@ -598,6 +1013,7 @@ namespace nCine::RHI::Software
 				g_tile.fbHeight = 0;
 				g_tile.totalTiles = 0;
 				g_tile.isFboTarget = false;
+				g_tile.surface = nullptr;
 				return;
 			}
 
@@ -617,6 +1033,7 @@ namespace nCine::RHI::Software
 			if (std::int32_t(g_tile.tileBins.size()) < g_tile.totalTiles) {
 				g_tile.tileBins.resize(g_tile.totalTiles);
 			}
+			g_tile.surface = AcquireSurfaceHistory(buffer, width, height, isFboTarget);
 		}
 
 		bool SubmitCommand(const DrawContext& ctx, PrimitiveType type,
@@ -646,36 +1063,14 @@ namespace nCine::RHI::Software
 				}
 			}
 
-			if DEATH_UNLIKELY(g_tile.commandCount >= MaxCommands) {
+			if DEATH_UNLIKELY(g_tile.commandCount >= MaxCommands || g_tile.instanceCount >= MaxInstances) {
 				// Buffer full - flush and retry, or fall back to immediate
 				Flush();
-				if (g_tile.commandCount >= MaxCommands) return false;
-			}
-
-			// Use the viewport snapshot for the NDC→screen transform (mirrors SwRaster::SetViewport). Fall
-			// back to the full buffer when no explicit viewport was set (matches SwDevice::Dispatch).
-			std::int32_t vpX = g_tile.viewportX;
-			std::int32_t vpY = g_tile.viewportY;
-			std::int32_t vpW = g_tile.viewportW;
-			std::int32_t vpH = g_tile.viewportH;
-			if (vpW <= 0 || vpH <= 0) {
-				vpX = 0;
-				vpY = 0;
-				vpW = g_tile.fbWidth;
-				vpH = g_tile.fbHeight;
-			}
-
-			// Acquire a command slot, growing the arena on demand (geometric growth, capacity and each
-			// slot's heap allocations retained across frames). Growth may move the live slots below cmdIdx;
-			// that is safe because their self-referential ctx pointers are only fixed up (and dereferenced)
-			// at Flush. A discarded command simply never increments commandCount, so the slot is reused by
-			// the next submission.
-			const std::int32_t cmdIdx = g_tile.commandCount;
-			if (cmdIdx >= std::int32_t(g_tile.commands.size())) {
-				g_tile.commands.emplace_back();
+				if (g_tile.commandCount >= MaxCommands || g_tile.instanceCount >= MaxInstances) return false;
 			}
-			DeferredCommand& cmd = g_tile.commands[cmdIdx];
-			cmd.ctx = ctx;
+
+			const std::int32_t cmdIdx = g_tile.commandCount;
+			DeferredCommand& cmd = BeginCommand(ctx);
 			// Snapshot the fragment-callback parameter block into the command's own storage (ctx points at
 			// caller-stack memory, which is still alive here). cmd.ctx.fragmentShaderUserData keeps the
 			// caller pointer for the submit-time consumers below (PrepareQuad's constant-fill evaluation,
@@ -692,36 +1087,38 @@ namespace nCine::RHI::Software
 				const float* src = static_cast<const float*>(ctx.vertexData);
 				cmd.vertexStorage.assign(src, src + floatCount);
 			}
-			// scissorRect.Y is stored in top-down screen space so the tile rasterizer can use it directly as a
-			// pixel-row clip. ctx.scissorRect.Y is bottom-up (the RHI scissor convention), so flip it here.
-			if DEATH_UNLIKELY(ctx.scissorEnabled) {
-				cmd.ctx.scissorRect.Y = g_tile.fbHeight - ctx.scissorRect.Y - ctx.scissorRect.H;
-			}
+
+			const std::int32_t vpX = cmd.viewportX;
+			const std::int32_t vpY = cmd.viewportY;
+			const std::int32_t vpW = cmd.viewportW;
+			const std::int32_t vpH = cmd.viewportH;
+
+			// A single draw is a command with one instance
+			const std::int32_t instIdx = g_tile.instanceCount;
+			DeferredInstance& inst = BeginInstance(cmdIdx);
 
 			// Compute the screen-space AABB from the draw command
 			std::int32_t screenMinX, screenMinY, screenMaxX, screenMaxY;
-			bool accurateBounds;
 
 			if DEATH_LIKELY(type == PrimitiveType::TriangleStrip && count == 4 && firstVertex == 0 && ctx.vertexData == nullptr) {
 				// Procedural sprite quad: run the submit-time preparation (the four FetchVertex transforms
 				// plus the texture / tint / blend / UV-step derivation the tile rasterizers used to redo per
 				// binned tile, see PreparedQuad) and take the binning bounds from the exact screen-space
 				// vertices the rasterizer will consume.
-				TileInternal::PrepareQuad(cmd.ctx, vpX, vpY, vpW, vpH, cmd.prep);
-				if DEATH_UNLIKELY(!cmd.prep.valid) {
+				TileInternal::PrepareQuad(cmd.ctx, vpX, vpY, vpW, vpH, inst.prep);
+				if DEATH_UNLIKELY(!inst.prep.valid) {
 					return true; // Degenerate quad - accepted but discarded (it draws nothing on any path)
 				}
-				screenMinX = std::max(0, static_cast<std::int32_t>(cmd.prep.fxMin));
-				screenMinY = std::max(0, static_cast<std::int32_t>(cmd.prep.fyMin));
-				screenMaxX = std::min(g_tile.fbWidth - 1, static_cast<std::int32_t>(cmd.prep.fxMax));
-				screenMaxY = std::min(g_tile.fbHeight - 1, static_cast<std::int32_t>(cmd.prep.fyMax));
-				accurateBounds = true;
+				screenMinX = std::max(0, static_cast<std::int32_t>(inst.prep.fxMin));
+				screenMinY = std::max(0, static_cast<std::int32_t>(inst.prep.fyMin));
+				screenMaxX = std::min(g_tile.fbWidth - 1, static_cast<std::int32_t>(inst.prep.fxMax));
+				screenMaxY = std::min(g_tile.fbHeight - 1, static_cast<std::int32_t>(inst.prep.fyMax));
 			} else if (cmd.ctx.vertexData != nullptr) {
 				// General vertex-fed draw: bin by the transformed vertices' bounding box (the same NDC ->
-				// screen mapping the rasterizer's vertex fetch applies, padded a pixel for its snap).
-				// accurateBounds stays false - an AABB does not promise the geometry covers it, and the
-				// read-back-skip optimization must only fire for full-cover draws.
-				cmd.prep.valid = false;
+				// screen mapping the rasterizer's vertex fetch applies, padded a pixel for its snap). An
+				// AABB does not promise the geometry covers it, so the prepared quad stays invalid and the
+				// read-back-skip optimization never fires for it.
+				inst.prep.valid = false;
 				const std::int32_t strideFloats = (cmd.ctx.vertexStride > 0 ? cmd.ctx.vertexStride / std::int32_t(sizeof(float)) : 4);
 				const float* v = static_cast<const float*>(cmd.ctx.vertexData) + std::size_t(firstVertex) * std::size_t(strideFloats);
 				float fxMin = FLT_MAX, fxMax = -FLT_MAX, fyMin = FLT_MAX, fyMax = -FLT_MAX;
@@ -737,29 +1134,16 @@ namespace nCine::RHI::Software
 				screenMinY = std::max(0, static_cast<std::int32_t>(fyMin) - 1);
 				screenMaxX = std::min(g_tile.fbWidth - 1, static_cast<std::int32_t>(fxMax) + 1);
 				screenMaxY = std::min(g_tile.fbHeight - 1, static_cast<std::int32_t>(fyMax) + 1);
-				accurateBounds = false;
 			} else {
 				// For non-procedural quads, use full framebuffer bounds (conservative)
-				cmd.prep.valid = false;
+				inst.prep.valid = false;
 				screenMinX = 0;
 				screenMinY = 0;
 				screenMaxX = g_tile.fbWidth - 1;
 				screenMaxY = g_tile.fbHeight - 1;
-				accurateBounds = false;
-			}
-
-			// Scissor clip — Y always flipped for tile culling because tile rows are indexed top-down in
-			// screen space but the framebuffer stores rows bottom-up.
-			if DEATH_UNLIKELY(ctx.scissorEnabled) {
-				std::int32_t scY0 = g_tile.fbHeight - ctx.scissorRect.Y - ctx.scissorRect.H;
-				std::int32_t scY1 = g_tile.fbHeight - 1 - ctx.scissorRect.Y;
-				screenMinX = std::max(screenMinX, ctx.scissorRect.X);
-				screenMinY = std::max(screenMinY, scY0);
-				screenMaxX = std::min(screenMaxX, ctx.scissorRect.X + ctx.scissorRect.W - 1);
-				screenMaxY = std::min(screenMaxY, scY1);
 			}
 
-			if DEATH_UNLIKELY(screenMinX > screenMaxX || screenMinY > screenMaxY) {
+			if DEATH_UNLIKELY(!ClipToScissor(cmd.ctx, screenMinX, screenMinY, screenMaxX, screenMaxY)) {
 				return true; // Command is fully clipped - accepted but discarded
 			}
 
@@ -768,73 +1152,81 @@ namespace nCine::RHI::Software
 			// not met) keeps the generic fragment. Runs at submit time, while the caller's userData pointer
 			// is still alive.
 			cmd.paletteLutIndex = (ctx.paletteRemapHint ? AcquirePaletteLut(cmd.ctx) : -1);
-
-			// Classify a destination-independent full write (the reverse-painter cull's trigger, see the
-			// field in SwTileRenderer.h). Only an axis-aligned procedural quad qualifies - it writes every
-			// pixel of its drawn rectangle - and only when nothing it writes depends on the destination:
-			// blending off (whatever the source, the write replaces the pixel), or the fast blend pair with
-			// a source that is provably opaque everywhere (src-over with alpha 255 is the same replace).
-			cmd.opaqueOverwrite = false;
-			if (accurateBounds && cmd.prep.valid && cmd.prep.axisAligned) {
-				bool overwrites = !cmd.prep.useBlend;
-				if (!overwrites && cmd.prep.useFastBlend) {
-					if (cmd.prep.constantFill) {
-						overwrites = (cmd.prep.constColor[3] >= 255);
-					} else if (cmd.paletteLutIndex >= 0) {
-						// Every LUT entry opaque and the source alpha a constant 1 - each sampled texel,
-						// whatever its index, lands on an opaque entry
-						const SwPaletteLut& lut = g_tile.paletteLuts[cmd.paletteLutIndex];
-						overwrites = (lut.allOpaque && lut.alphaByteOffset == -1);
-					}
-				}
-				if (overwrites) {
-					// The axis-aligned rasterizer writes exactly [int(fxMin), int(fxMax - 0.5)] per axis
-					// (tile-clipped); the binning AABB above rounds the max edges up to int(fxMax), which may
-					// claim one pixel column/row the rasterizer never writes - fine for binning (conservative)
-					// but not for a cover test, so the cull gets its own exact rectangle
-					std::int32_t coverMinX = static_cast<std::int32_t>(cmd.prep.fxMin);
-					std::int32_t coverMaxX = static_cast<std::int32_t>(cmd.prep.fxMax - 0.5f);
-					std::int32_t coverMinY = static_cast<std::int32_t>(cmd.prep.fyMin);
-					std::int32_t coverMaxY = static_cast<std::int32_t>(cmd.prep.fyMax - 0.5f);
-					if DEATH_UNLIKELY(ctx.scissorEnabled) {
-						// cmd.ctx.scissorRect.Y was flipped to top-down above, matching tile coordinates
-						coverMinX = std::max(coverMinX, cmd.ctx.scissorRect.X);
-						coverMaxX = std::min(coverMaxX, cmd.ctx.scissorRect.X + cmd.ctx.scissorRect.W - 1);
-						coverMinY = std::max(coverMinY, cmd.ctx.scissorRect.Y);
-						coverMaxY = std::min(coverMaxY, cmd.ctx.scissorRect.Y + cmd.ctx.scissorRect.H - 1);
-					}
-					cmd.coverMinX = coverMinX;
-					cmd.coverMinY = coverMinY;
-					cmd.coverMaxX = coverMaxX;
-					cmd.coverMaxY = coverMaxY;
-					cmd.opaqueOverwrite = (coverMinX <= coverMaxX && coverMinY <= coverMaxY);
-				}
-			}
+			ClassifyOverwrite(cmd, inst);
 
 			cmd.primType = type;
 			cmd.firstVertex = firstVertex;
 			cmd.count = count;
-			cmd.viewportX = vpX;
-			cmd.viewportY = vpY;
-			cmd.viewportW = vpW;
-			cmd.viewportH = vpH;
-			cmd.screenMinX = screenMinX;
-			cmd.screenMinY = screenMinY;
-			cmd.screenMaxX = screenMaxX;
-			cmd.screenMaxY = screenMaxY;
-			cmd.boundsAreAccurate = accurateBounds;
+			inst.contentHash = (g_tile.damageTracking ? ComputeCommandHash(cmd) : 0);
 			g_tile.commandCount++;
+			g_tile.instanceCount++;
 
-			// Bin into overlapping tiles (clamp to the valid tile range)
-			const std::int32_t tileMinCol = std::max(0, screenMinX >> TileSizeShift);
-			const std::int32_t tileMaxCol = std::min(g_tile.tilesX - 1, screenMaxX >> TileSizeShift);
-			const std::int32_t tileMinRow = std::max(0, screenMinY >> TileSizeShift);
-			const std::int32_t tileMaxRow = std::min(g_tile.tilesY - 1, screenMaxY >> TileSizeShift);
+			BinInstance(instIdx, screenMinX, screenMinY, screenMaxX, screenMaxY);
+			return true;
+		}
+
+		bool SubmitInstances(const DrawContext& ctx, const QuadInstance* instances, std::int32_t count)
+		{
+			if DEATH_UNLIKELY(!g_tile.initialized || g_tile.targetBuffer == nullptr) {
+				return false;
+			}
 
-			for (std::int32_t row = tileMinRow; row <= tileMaxRow; row++) {
-				for (std::int32_t col = tileMinCol; col <= tileMaxCol; col++) {
-					const std::int32_t tileIdx = row * g_tile.tilesX + col;
-					g_tile.tileBins[tileIdx].push_back(static_cast<std::uint16_t>(cmdIdx));
+			// The shared context must describe everything but the per-sprite fields: a parameter block or a
+			// palette LUT is derived from one draw's own state, and general vertices are not a sprite quad
+			if (ctx.fragmentShaderUserData != nullptr || ctx.paletteRemapHint || ctx.vertexData != nullptr) {
+				return false;
+			}
+
+			std::int32_t next = 0;
+			while (next < count) {
+				if DEATH_UNLIKELY(g_tile.commandCount >= MaxCommands || g_tile.instanceCount >= MaxInstances) {
+					// A batch larger than what is left of the window continues as a new command after the flush
+					Flush();
+				}
+
+				const std::int32_t cmdIdx = g_tile.commandCount;
+				DeferredCommand& cmd = BeginCommand(ctx);
+				cmd.primType = PrimitiveType::TriangleStrip;
+				cmd.firstVertex = 0;
+				cmd.count = 4;
+
+				// The shared state is hashed once, each instance only folds its own fields into it
+				const std::uint64_t commandHash = (g_tile.damageTracking ? ComputeCommandHash(cmd) : 0);
+
+				// Scratch context that only feeds PrepareQuad, the per-sprite fields are replaced per instance
+				DrawContext instanceCtx = cmd.ctx;
+				std::int32_t acceptedCount = 0;
+				for (; next < count && g_tile.instanceCount < MaxInstances; next++) {
+					const QuadInstance& src = instances[next];
+					std::memcpy(instanceCtx.ff.mvpMatrix, src.mvpMatrix, sizeof(src.mvpMatrix));
+					std::memcpy(instanceCtx.ff.color, src.color, sizeof(src.color));
+					std::memcpy(instanceCtx.ff.texRect, src.texRect, sizeof(src.texRect));
+					std::memcpy(instanceCtx.ff.spriteSize, src.spriteSize, sizeof(src.spriteSize));
+
+					const std::int32_t instIdx = g_tile.instanceCount;
+					DeferredInstance& inst = BeginInstance(cmdIdx);
+					TileInternal::PrepareQuad(instanceCtx, cmd.viewportX, cmd.viewportY, cmd.viewportW, cmd.viewportH, inst.prep);
+					if DEATH_UNLIKELY(!inst.prep.valid) {
+						continue;
+					}
+					std::int32_t screenMinX = std::max(0, static_cast<std::int32_t>(inst.prep.fxMin));
+					std::int32_t screenMinY = std::max(0, static_cast<std::int32_t>(inst.prep.fyMin));
+					std::int32_t screenMaxX = std::min(g_tile.fbWidth - 1, static_cast<std::int32_t>(inst.prep.fxMax));
+					std::int32_t screenMaxY = std::min(g_tile.fbHeight - 1, static_cast<std::int32_t>(inst.prep.fyMax));
+					if (!ClipToScissor(cmd.ctx, screenMinX, screenMinY, screenMaxX, screenMaxY)) {
+						continue;
+					}
+
+					ClassifyOverwrite(cmd, inst);
+					inst.contentHash = (g_tile.damageTracking ? xxHash3(&src, sizeof(QuadInstance), commandHash) : 0);
+					g_tile.instanceCount++;
+					acceptedCount++;
+
+					BinInstance(instIdx, screenMinX, screenMinY, screenMaxX, screenMaxY);
+				}
+
+				if (acceptedCount > 0) {
+					g_tile.commandCount++;
 				}
 			}
 
@@ -843,7 +1235,7 @@ namespace nCine::RHI::Software
 
 		void Flush()
 		{
-			if DEATH_UNLIKELY(!g_tile.initialized || g_tile.commandCount == 0) {
+			if DEATH_UNLIKELY(!g_tile.initialized || (g_tile.commandCount == 0 && !g_tile.clearPending)) {
 				return;
 			}
 
@@ -853,6 +1245,8 @@ namespace nCine::RHI::Software
 				return;
 			}
 
+			ZoneScopedNC("SwTileRenderer::Flush", 0x6D9EC4);
+
 			// Fix up the per-command pointers now that submissions are done for this window and neither the
 			// command arena nor the LUT pool grows any further, so everything stays stable for every worker:
 			// - palette-LUT pool indices resolve into pointers
@@ -870,34 +1264,11 @@ namespace nCine::RHI::Software
 				}
 			}
 
+			const std::uint32_t renderedTilesBefore = g_tile.renderedTiles.load(std::memory_order_relaxed);
+
 #if defined(WITH_THREADS)
 			// Multi-threaded tile processing using an atomic work counter
-			g_tile.nextTileIndex.store(0, std::memory_order_relaxed);
-
-			g_tile.mutex.Lock();
-			g_tile.flushGeneration++;
-			// Set the active count based on the successfully spawned threads
-			g_tile.workersActive.store(g_tile.numSpawnedWorkers, std::memory_order_release);
-			g_tile.workReady.Broadcast();
-			g_tile.mutex.Unlock();
-
-			// The main thread also processes tiles (worker slot 0)
-			while (true) {
-				std::int32_t idx = g_tile.nextTileIndex.fetch_add(1, std::memory_order_relaxed);
-				if (idx >= g_tile.totalTiles) break;
-				ProcessTile(idx, 0);
-			}
-
-			// Wait for all workers to finish
-			g_tile.mutex.Lock();
-			while (g_tile.workersActive.load(std::memory_order_acquire) > 0) {
-				g_tile.workDone.Wait(g_tile.mutex);
-			}
-			g_tile.mutex.Unlock();
-
-			// Ensure all worker pixel writes are globally visible before the engine moves on to
-			// DiscardPending or flipping buffers.
-			std::atomic_thread_fence(std::memory_order_acquire);
+			RunOnWorkers();
 #else
 			// Single-threaded fallback: process tiles sequentially
 			for (std::int32_t i = 0; i < g_tile.totalTiles; i++) {
@@ -905,6 +1276,11 @@ namespace nCine::RHI::Software
 			}
 #endif
 
+			// Draws sampling this surface later must not match their previous hashes if any pixel changed
+			if (g_tile.surface != nullptr && g_tile.renderedTiles.load(std::memory_order_relaxed) != renderedTilesBefore) {
+				g_tile.surface->contentStamp = ++g_tile.nextContentStamp;
+			}
+
 			// Reset for the next frame
 			DiscardPending();
 		}
@@ -912,6 +1288,8 @@ namespace nCine::RHI::Software
 		void DiscardPending()
 		{
 			g_tile.commandCount = 0;
+			g_tile.instanceCount = 0;
+			g_tile.clearPending = false;
 			for (std::int32_t i = 0; i < g_tile.totalTiles; i++) {
 				g_tile.tileBins[i].clear();
 			}
@@ -924,6 +1302,100 @@ namespace nCine::RHI::Software
 		{
 			return g_tile.commandCount;
 		}
+
+		bool SubmitClear(std::uint32_t color)
+		{
+			if DEATH_UNLIKELY(!g_tile.initialized || g_tile.targetBuffer == nullptr || !g_tile.damageTracking) {
+				return false;
+			}
+
+			// Everything queued so far would be cleared anyway
+			DiscardPending();
+
+			g_tile.clearPending = true;
+			g_tile.clearColor = color;
+			g_tile.clearHash = xxHash3(&color, sizeof(color), ClearSeed);
+			if DEATH_UNLIKELY(g_tile.clearHash == 0) {
+				g_tile.clearHash = 1;
+			}
+			return true;
+		}
+
+		void InvalidateSurface(const std::uint8_t* buffer)
+		{
+			if (buffer == nullptr) {
+				return;
+			}
+			for (SurfaceHistory& s : g_tile.surfaces) {
+				if (s.buffer == buffer) {
+					ResetSurfaceHistory(s);
+				}
+			}
+		}
+
+		void SetDamageTracking(bool enabled)
+		{
+			if (g_tile.damageTracking == enabled) {
+				return;
+			}
+
+			// Queued commands were hashed (or not) under the previous setting, and the histories won't be
+			// updated while it's disabled
+			Flush();
+			g_tile.damageTracking = enabled;
+			for (SurfaceHistory& s : g_tile.surfaces) {
+				if (s.buffer != nullptr) {
+					ResetSurfaceHistory(s);
+				}
+			}
+		}
+
+		DamageStatistics GetDamageStatistics()
+		{
+			DamageStatistics stats;
+			stats.renderedTiles = g_tile.renderedTiles.load(std::memory_order_relaxed);
+			stats.skippedTiles = g_tile.skippedTiles.load(std::memory_order_relaxed);
+			return stats;
+		}
+
+		void ResetDamageStatistics()
+		{
+			g_tile.renderedTiles.store(0, std::memory_order_relaxed);
+			g_tile.skippedTiles.store(0, std::memory_order_relaxed);
+		}
+
+		std::int32_t GetWorkerSlotCount()
+		{
+#if defined(WITH_THREADS)
+			if (g_tile.initialized) {
+				return g_tile.numSpawnedWorkers + 1;
+			}
+#endif
+			return 1;
+		}
+
+		void RunParallel(std::int32_t count, ParallelJobFunc func, void* userData)
+		{
+			if (count <= 0) {
+				return;
+			}
+
+#if defined(WITH_THREADS)
+			if (g_tile.initialized && g_tile.numSpawnedWorkers > 0 && count > 1) {
+				g_tile.jobFunc = func;
+				g_tile.jobUserData = userData;
+				g_tile.jobCount = count;
+				RunOnWorkers();
+				g_tile.jobFunc = nullptr;
+				g_tile.jobUserData = nullptr;
+				g_tile.jobCount = 0;
+				return;
+			}
+#endif
+			for (std::int32_t i = 0; i < count; i++) {
+				func(i, 0, userData);
+			}
+		}
 	}
 }
 
@@ -26,9 +26,18 @@ namespace nCine::RHI::Software
 
 		The layer is transparent to the device: @ref SwRaster forwards each draw to @ref SubmitCommand(),
 		which either accepts it for deferral (returning `true`) or declines it (returning `false`) so the
-		caller runs it through the immediate rasterizer instead. @ref Flush() is called before the surface
+		caller runs it through the immediate rasterizer instead. A batch of sprites sharing one draw state is
+		submitted as a whole through @ref SubmitInstances(), so it costs one command plus a compact record per
+		sprite, and the tiles bin those records rather than commands. @ref Flush() is called before the surface
 		is read back (present) or a different render target is bound, and it never returns until every
 		worker has finished writing, so the pixels are complete and race-free by the time it does.
+
+		Each flush also tracks damage from frame to frame. Every command gets a content hash at submit time
+		(its state, vertices, effect parameters and the content versions of the sampled textures), and a
+		tile's binned commands fold into a tile hash that is remembered per surface. A tile whose hash
+		matches the one it was last rendered with already holds the right pixels and is skipped - a
+		full-surface clear is deferred through @ref SubmitClear() for this reason, so it doesn't wipe them.
+		Anything writing a surface behind the layer's back must call @ref InvalidateSurface().
 	*/
 	namespace SwTileRenderer
 	{
@@ -40,11 +49,19 @@ namespace nCine::RHI::Software
 			@brief Upper bound on the commands deferred in one flush window
 
 			A flush threshold, not a static allocation: the command arena grows on demand (geometrically,
-			retaining capacity across frames), so a typical frame only ever allocates as many ~900-byte
+			retaining capacity across frames), so a typical frame only ever allocates as many ~550-byte
 			command slots as it actually submits at once - instead of the former fixed 4096-slot (~3.6 MB)
 			static array sized for the worst case. Hitting the bound flushes and reuses the arena.
 		*/
 		static constexpr std::int32_t MaxCommands = 4096;
+		/**
+			@brief Upper bound on the instances deferred in one flush window
+
+			Every command has at least one @ref DeferredInstance, a batch from @ref SubmitInstances() has one
+			per sprite. Like @ref MaxCommands this is a flush threshold of an arena that grows on demand; it
+			also keeps the instance indices stored in the tile bins within 16 bits.
+		*/
+		static constexpr std::int32_t MaxInstances = 16384;
 
 		/**
 			@brief Sanity ceiling on a destination surface edge
@@ -78,17 +95,21 @@ namespace nCine::RHI::Software
 			bool axisAligned;
 			/** @brief The four transformed screen-space vertices (exact `FetchVertex` output, snap included) */
 			Vertex2D v[4];
+			/** @brief Instance color handed to a fragment callback (the quad's own, not the shared context's) */
+			float color[4];
 
 			// -- Shared derived state (both quad rasterizers) --
 
-			/** @brief Level-0 texel base of the sampled texture, or `nullptr` for an untextured draw */
+			/** @brief Texel base of the sampled texture level, or `nullptr` for an untextured draw */
 			const std::uint8_t* texPixels;
-			/** @brief Sampled texture width in texels (0 when untextured) */
+			/** @brief Sampled level width in texels (0 when untextured) */
 			std::int32_t texW;
-			/** @brief Sampled texture height in texels (0 when untextured) */
+			/** @brief Sampled level height in texels (0 when untextured) */
 			std::int32_t texH;
 			/** @brief Byte size of one stored texel (@ref SwTexture stores R8/RG8 natively; 4 when untextured) */
 			std::int32_t texBpp;
+			/** @brief Blocks per block row if the texels are in the tiled layout (affine quads only), `0` for linear rows, see @ref SwTexture::TexelIndex() */
+			std::int32_t texBlocksPerRow;
 			/** @brief Horizontal wrap mode of the sampled texture */
 			nCine::SamplerWrapping wrapS;
 			/** @brief Vertical wrap mode of the sampled texture */
@@ -180,11 +201,12 @@ namespace nCine::RHI::Software
 		};
 
 		/**
-			@brief One deferred draw call together with its pre-computed screen-space bounds
+			@brief One deferred draw call, the state shared by all of its instances
 
 			A snapshot of the @ref DrawContext plus the primitive range and the viewport that was active when
 			the command was submitted, so the worker can reproduce the exact vertex transform later on another
-			thread. The screen-space AABB (inclusive pixel bounds) drives tile binning.
+			thread. What is drawn lives in its @ref DeferredInstance records - one for a single draw, one per
+			sprite for a batch.
 		*/
 		struct DeferredCommand
 		{
@@ -206,36 +228,6 @@ namespace nCine::RHI::Software
 			/** @brief Viewport height at submit time */
 			std::int32_t viewportH;
 
-			/** @brief Inclusive screen-space AABB minimum X used for tile binning */
-			std::int32_t screenMinX;
-			/** @brief Inclusive screen-space AABB minimum Y */
-			std::int32_t screenMinY;
-			/** @brief Inclusive screen-space AABB maximum X */
-			std::int32_t screenMaxX;
-			/** @brief Inclusive screen-space AABB maximum Y */
-			std::int32_t screenMaxY;
-
-			/**
-			 * @brief Whether the AABB was computed from real geometry (procedural sprite quad) rather than
-			 * given conservative full-frame bounds. The read-back-skip optimization may only fire when `true`.
-			 */
-			bool boundsAreAccurate;
-
-			/**
-			 * @brief Whether the command overwrites every pixel of its cover rectangle regardless of what the
-			 * destination held before it
-			 *
-			 * Set at submit time for an axis-aligned procedural quad whose write is destination-independent:
-			 * blending disabled, an opaque constant fill, or a palette draw whose LUT maps every index to an
-			 * opaque pixel - all under the fast blend pair, where an opaque source is a plain copy. Everything
-			 * drawn before such a command inside its cover rectangle is overwritten, so a tile it fully covers
-			 * starts its command walk there and skips the framebuffer read-back (the reverse-painter cull in
-			 * `ProcessTile`).
-			 */
-			bool opaqueOverwrite;
-			/** @brief Inclusive screen-space pixel rectangle the command is guaranteed to overwrite (exact drawn extent, scissor applied; valid when @ref opaqueOverwrite) */
-			std::int32_t coverMinX, coverMinY, coverMaxX, coverMaxY;
-
 			/**
 			 * @brief Inline snapshot of the effect's fragment-callback parameter block
 			 *
@@ -266,9 +258,51 @@ namespace nCine::RHI::Software
 			 * retained across reuse of the command slot.
 			 */
 			SmallVector<float, 0> vertexStorage;
+		};
+
+		/**
+			@brief One drawn item of a deferred command, the unit the tiles are binned by
+
+			Holds only what differs between the sprites of a batch: the prepared quad (which already carries
+			the instance's transformed vertices, UV setup and tint), the overwrite classification and the
+			content hash. A draw that is not a procedural quad has a single instance with an invalid
+			@ref prep. A batch of N sprites costs N of these and a single command slot, instead of N copies of
+			the context and of the parameter-block storage.
+		*/
+		struct DeferredInstance
+		{
+			/** @brief Index of the owning command in the command arena */
+			std::int32_t command;
+
+			/**
+			 * @brief Whether the instance overwrites every pixel of its cover rectangle regardless of what the
+			 * destination held before it
+			 *
+			 * Set at submit time for an axis-aligned procedural quad whose write is destination-independent:
+			 * blending disabled, an opaque constant fill, or a palette draw whose LUT maps every index to an
+			 * opaque pixel - all under the fast blend pair, where an opaque source is a plain copy. Everything
+			 * drawn before such an instance inside its cover rectangle is overwritten, so a tile it fully covers
+			 * starts its walk there and skips the framebuffer read-back (the reverse-painter cull in
+			 * `ProcessTile`).
+			 */
+			bool opaqueOverwrite;
+			/** @brief Inclusive screen-space pixel rectangle the instance is guaranteed to overwrite (exact drawn extent, scissor applied; valid when @ref opaqueOverwrite) */
+			std::int32_t coverMinX, coverMinY, coverMaxX, coverMaxY;
 
-			/** @brief Submit-time precomputed vertices and derived state of a procedural quad command */
+			/** @brief Submit-time precomputed vertices and derived state of a procedural quad */
 			PreparedQuad prep;
+
+			/** @brief Hash of everything the instance's output depends on, folded into the tile hashes for damage tracking */
+			std::uint64_t contentHash;
+		};
+
+		/** @brief Tile counters of the damage tracking, see @ref GetDamageStatistics() */
+		struct DamageStatistics
+		{
+			/** @brief Number of tiles that were rasterized */
+			std::uint32_t renderedTiles;
+			/** @brief Number of tiles that were skipped because they were unchanged since they were last rendered */
+			std::uint32_t skippedTiles;
 		};
 
 		/** @brief Spins up the worker pool and resets the queue (idempotent; called once at startup) */
@@ -277,6 +311,15 @@ namespace nCine::RHI::Software
 		/** @brief Signals the workers to exit, joins them and releases resources */
 		void Shutdown();
 
+		/**
+			@brief Overrides the number of worker threads spawned by the next @ref Initialize()
+
+			The main thread always processes tiles as well, so `0` renders single-threaded. A negative value
+			restores the automatic count derived from the logical CPUs. Takes effect only after a
+			@ref Shutdown() / @ref Initialize() cycle; ignored on a build without `WITH_THREADS`.
+		*/
+		void SetWorkerCount(std::int32_t count);
+
 		/** @brief Returns `true` when the layer is initialized and accepting deferred commands */
 		bool IsActive();
 
@@ -307,6 +350,18 @@ namespace nCine::RHI::Software
 		bool SubmitCommand(const DrawContext& ctx, PrimitiveType type,
 		                   std::int32_t firstVertex, std::int32_t count);
 
+		/**
+			@brief Submits a batch of procedural sprite quads sharing one draw context for deferred rendering
+
+			The batch is stored as one command holding @p ctx and a @ref DeferredInstance per sprite, each
+			quad is prepared and binned on its own. Only plain and constant-color sprites can be batched -
+			a context with a fragment parameter block, a palette hint or general vertices is declined.
+
+			@returns `true` if the whole batch was accepted, `false` if nothing was and the caller should draw
+			the quads one by one
+		*/
+		bool SubmitInstances(const DrawContext& ctx, const QuadInstance* instances, std::int32_t count);
+
 		/**
 			@brief Renders every queued command tile by tile, then clears the queue
 
@@ -317,11 +372,61 @@ namespace nCine::RHI::Software
 		*/
 		void Flush();
 
-		/** @brief Drops all queued commands without rendering them (e.g. after a full-surface clear) */
+		/** @brief Drops all queued commands and a deferred clear without rendering them (e.g. after a full-surface clear) */
 		void DiscardPending();
 
+		/**
+			@brief Defers a full-surface clear of the current target to the next @ref Flush()
+
+			Tiles that end up unchanged keep the pixels from the last frame instead of being cleared and
+			rendered again, the remaining ones start from the clear color without a framebuffer read-back.
+
+			@param color		Packed RGBA8 clear color (red in the lowest byte)
+			@returns `true` if the clear was accepted, `false` if the caller should clear the surface itself
+		*/
+		bool SubmitClear(std::uint32_t color);
+
+		/**
+			@brief Forgets the tile hashes of a surface because it was written outside of the layer
+
+			Must be called after an immediate draw, a CPU pass or an upload modifies the surface, otherwise
+			its tiles could be skipped by the next flush. A no-op for a surface that isn't tracked.
+		*/
+		void InvalidateSurface(const std::uint8_t* buffer);
+
+		/** @brief Enables or disables skipping of unchanged tiles (enabled by default) */
+		void SetDamageTracking(bool enabled);
+
+		/** @brief Returns the tile counters accumulated since the last @ref ResetDamageStatistics() */
+		DamageStatistics GetDamageStatistics();
+
+		/** @brief Resets the counters returned by @ref GetDamageStatistics() */
+		void ResetDamageStatistics();
+
 		/** @brief Returns the number of commands currently queued */
 		std::int32_t GetPendingCommandCount();
+
+		/**
+			@brief Job callback of @ref RunParallel(), called once for every index in `[0, count)`
+
+			@p workerSlot identifies the calling thread, it's below @ref GetWorkerSlotCount() and no two
+			threads run with the same slot at once, so it can index per-thread scratch memory.
+		*/
+		using ParallelJobFunc = void (*)(std::int32_t index, std::int32_t workerSlot, void* userData);
+
+		/** @brief Returns the number of threads that can take part in @ref RunParallel(), including the calling one */
+		std::int32_t GetWorkerSlotCount();
+
+		/**
+			@brief Runs a job over the worker pool of the layer
+
+			Lets other full-surface CPU passes (the rescale filters of @ref SwRescale) share the tile workers
+			instead of spawning threads of their own. The indices are handed out through the same atomic
+			counter as the tiles, the calling thread takes part too, and the call does not return until every
+			index has been processed. Must not be called while a flush is running. Runs sequentially on the
+			calling thread on a build without `WITH_THREADS` or before @ref Initialize().
+		*/
+		void RunParallel(std::int32_t count, ParallelJobFunc func, void* userData);
 	}
 }
 
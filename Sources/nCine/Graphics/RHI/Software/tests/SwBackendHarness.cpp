@@ -7,13 +7,15 @@
 // spriteSize), then `Use()`s the program, binds, commits and issues `Device::DrawArrays`/`DrawElements`.
 // Finally it asserts known pixels and writes the framebuffer to a PNG.
 //
-// Build (from the scratchpad, MSVC): see the cl.exe command in the accompanying run; the backend needs
-// only RhiTypes.h, Primitives and ShaderCompilerTypes.h besides its own sources.
+// Built and registered with CTest by the CMakeLists.txt next to this file (NCINE_BUILD_SW_TESTS). It links the
+// Sw* sources, the Shared base layer and the threading primitives only, not the rest of the engine.
 
 // WITH_RHI_SOFTWARE is defined on the compiler command line so every translation unit sees it
 
-#include "nCine/Graphics/RHI/Software/SwBackend.h"
+#include "SwTestCommon.h"
 #include "nCine/Graphics/RHI/Software/SwRaster.h"
+#include "nCine/Graphics/RHI/Software/SwRescale.h"
+#include "nCine/Graphics/RHI/Software/SwTileRenderer.h"
 #include "Shaders/Generated/DefaultSprite.h"
 #include "Shaders/Generated/TexturedBackground.h"
 #include "Shaders/Generated/TexturedBackgroundCircle.h"
@@ -32,118 +34,11 @@ using namespace nCine;
 
 namespace
 {
-	// ---- Minimal RGBA8 PNG writer (stored/uncompressed DEFLATE, so no zlib dependency) ----
-
-	void PutBE32(std::vector<std::uint8_t>& out, std::uint32_t v)
-	{
-		out.push_back(std::uint8_t(v >> 24));
-		out.push_back(std::uint8_t(v >> 16));
-		out.push_back(std::uint8_t(v >> 8));
-		out.push_back(std::uint8_t(v));
-	}
-
-	std::uint32_t Crc32(const std::uint8_t* data, std::size_t length)
-	{
-		std::uint32_t crc = 0xFFFFFFFFu;
-		for (std::size_t i = 0; i < length; i++) {
-			crc ^= data[i];
-			for (int b = 0; b < 8; b++) {
-				crc = (crc >> 1) ^ (0xEDB88320u & (~(crc & 1u) + 1u));
-			}
-		}
-		return crc ^ 0xFFFFFFFFu;
-	}
-
-	std::uint32_t Adler32(const std::uint8_t* data, std::size_t length)
-	{
-		std::uint32_t a = 1, b = 0;
-		for (std::size_t i = 0; i < length; i++) {
-			a = (a + data[i]) % 65521u;
-			b = (b + a) % 65521u;
-		}
-		return (b << 16) | a;
-	}
-
-	void WriteChunk(std::vector<std::uint8_t>& png, const char* type, const std::vector<std::uint8_t>& data)
-	{
-		PutBE32(png, std::uint32_t(data.size()));
-		std::vector<std::uint8_t> typeAndData;
-		typeAndData.insert(typeAndData.end(), type, type + 4);
-		typeAndData.insert(typeAndData.end(), data.begin(), data.end());
-		png.insert(png.end(), typeAndData.begin(), typeAndData.end());
-		PutBE32(png, Crc32(typeAndData.data(), typeAndData.size()));
-	}
-
-	bool WritePng(const char* path, const std::uint8_t* rgba, std::int32_t width, std::int32_t height, std::int32_t stride)
-	{
-		// Filtered raw data: one filter byte (0 = none) per scanline followed by the RGBA row
-		std::vector<std::uint8_t> raw;
-		raw.reserve(std::size_t(height) * (1 + std::size_t(width) * 4));
-		for (std::int32_t y = 0; y < height; y++) {
-			raw.push_back(0);
-			const std::uint8_t* row = rgba + std::size_t(y) * stride;
-			raw.insert(raw.end(), row, row + std::size_t(width) * 4);
-		}
-
-		// zlib stream wrapping stored DEFLATE blocks
-		std::vector<std::uint8_t> zlib;
-		zlib.push_back(0x78);
-		zlib.push_back(0x01);
-		std::size_t offset = 0;
-		while (offset < raw.size()) {
-			std::size_t blockLen = raw.size() - offset;
-			if (blockLen > 65535) {
-				blockLen = 65535;
-			}
-			const bool last = (offset + blockLen >= raw.size());
-			zlib.push_back(last ? 1 : 0);
-			zlib.push_back(std::uint8_t(blockLen & 0xFF));
-			zlib.push_back(std::uint8_t((blockLen >> 8) & 0xFF));
-			const std::uint16_t nlen = std::uint16_t(~std::uint16_t(blockLen));
-			zlib.push_back(std::uint8_t(nlen & 0xFF));
-			zlib.push_back(std::uint8_t((nlen >> 8) & 0xFF));
-			zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + blockLen);
-			offset += blockLen;
-		}
-		const std::uint32_t adler = Adler32(raw.data(), raw.size());
-		PutBE32(zlib, adler);
-
-		std::vector<std::uint8_t> png = {0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A};
-		std::vector<std::uint8_t> ihdr;
-		PutBE32(ihdr, std::uint32_t(width));
-		PutBE32(ihdr, std::uint32_t(height));
-		ihdr.push_back(8);		// bit depth
-		ihdr.push_back(6);		// color type: RGBA
-		ihdr.push_back(0);		// compression
-		ihdr.push_back(0);		// filter
-		ihdr.push_back(0);		// interlace
-		WriteChunk(png, "IHDR", ihdr);
-		WriteChunk(png, "IDAT", zlib);
-		WriteChunk(png, "IEND", std::vector<std::uint8_t>{});
-
-		std::ofstream file(path, std::ios::binary);
-		if (!file) {
-			return false;
-		}
-		file.write(reinterpret_cast<const char*>(png.data()), std::streamsize(png.size()));
-		return file.good();
-	}
-
 	// ---- Pixel assertions ----
 
 	int g_checks = 0;
 	int g_failures = 0;
 
-	void MakeTranslation(float tx, float ty, float* m)
-	{
-		for (int i = 0; i < 16; i++) {
-			m[i] = 0.0f;
-		}
-		m[0] = m[5] = m[10] = m[15] = 1.0f;
-		m[12] = tx;
-		m[13] = ty;
-	}
-
 	const std::uint8_t* PixelAt(const std::uint8_t* pixels, std::int32_t stride, std::int32_t x, std::int32_t y)
 	{
 		return pixels + std::size_t(y) * stride + std::size_t(x) * 4;
@@ -165,23 +60,6 @@ namespace
 		}
 	}
 
-	// ---- Uniform-buffer suballocator (registered with the backend, backed by one host buffer) ----
-
-	RHI::Buffer* g_uniformBuffer = nullptr;
-	std::uint32_t g_uniformBump = 0;
-
-	RHI::BufferRange AllocUniformRange(std::uint32_t bytes)
-	{
-		RHI::BufferRange range;
-		const std::uint32_t alignedOffset = (g_uniformBump + 15u) & ~15u;
-		range.object = g_uniformBuffer;
-		range.offset = alignedOffset;
-		range.size = bytes;
-		range.mapBase = g_uniformBuffer->HostData();
-		g_uniformBump = alignedOffset + bytes;
-		return range;
-	}
-
 	// ---- One sprite draw, replaying CommitAll() + Issue() ----
 
 	enum class DrawKind { Arrays, Elements };
@@ -234,42 +112,6 @@ namespace
 	}
 }
 
-// ---- Shared helpers for the effect tests ----
-
-void MakePath(const char* baseDir, const char* name, char* out, std::size_t outSize)
-{
-	std::snprintf(out, outSize, "%s/%s", baseDir, name);
-}
-
-// Ortho projection with a top-left origin, mapping model [0,W]x[0,H] to the viewport (y flipped)
-void BuildOrtho(std::int32_t width, std::int32_t height, float* m)
-{
-	const float near = -1.0f, far = 1.0f;
-	const float proj[16] = {
-		2.0f / width, 0.0f, 0.0f, 0.0f,
-		0.0f, -2.0f / height, 0.0f, 0.0f,
-		0.0f, 0.0f, -2.0f / (far - near), 0.0f,
-		-1.0f, 1.0f, -(far + near) / (far - near), 1.0f
-	};
-	std::memcpy(m, proj, sizeof(proj));
-}
-
-// Writes one instance's std140 InstanceBlock bytes (112-byte layout shared by every sprite-family shader)
-void FillInstanceRaw(std::uint8_t* dst, const float* model, const float* color, const float* texRect,
-	const float* spriteSize, float palOffset)
-{
-	std::memset(dst, 0, 112);
-	std::memcpy(dst + 0, model, 16 * sizeof(float));
-	std::memcpy(dst + 64, color, 4 * sizeof(float));
-	std::memcpy(dst + 80, texRect, 4 * sizeof(float));
-	std::memcpy(dst + 96, spriteSize, 2 * sizeof(float));
-	std::memcpy(dst + 104, &palOffset, sizeof(float));
-}
-
-const float kIdentityView[16] = {1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1};
-const float kTexRectFull[4] = {1.0f, 0.0f, 1.0f, 0.0f};
-const float kWhite[4] = {1.0f, 1.0f, 1.0f, 1.0f};
-
 bool RunSpriteTest(const char* baseDir)
 {
 	char outputPath[512];
@@ -284,7 +126,7 @@ bool RunSpriteTest(const char* baseDir)
 	RHI::ShaderProgram program(RHI::ShaderProgram::QueryPhase::Immediate);
 	program.SetReflection(&nCine::ShadersGen::DefaultSprite.Variants[0]);
 	program.Link(RHI::ShaderProgram::Introspection::Enabled);
-	program.SetObjectLabel("DefaultSprite");
+	program.SetObjectLabel("Sprite");
 
 	// --- Streaming uniform buffer + suballocator ---
 	RHI::Buffer uniformBuffer(BufferTarget::Uniform);
@@ -406,8 +248,9 @@ bool RunSpriteTest(const char* baseDir)
 	std::printf("Sprite 2 - color modulation (white x (1, 0.5, 0.25)):\n");
 	CheckPixel(pixels, stride, 40, fy(32), 255, 128, 64, 255, 2, "modulated white");
 
+	// Alpha is blended with One / OneMinusSrcAlpha (as set by DrawSprite()), so an opaque target stays opaque
 	std::printf("Sprite 3 - alpha blend (half-alpha white over gray 40):\n");
-	CheckPixel(pixels, stride, 216, fy(32), 148, 148, 148, 191, 2, "alpha-blended white");
+	CheckPixel(pixels, stride, 216, fy(32), 148, 148, 148, 255, 2, "alpha-blended white");
 
 	std::printf("Sprite 4 - scissor (right half clipped):\n");
 	CheckPixel(pixels, stride, 110, fy(186), 255, 0, 0, 255, 0, "scissor kept = red");
@@ -422,20 +265,6 @@ bool RunSpriteTest(const char* baseDir)
 // Full-screen procedural effects (TexturedBackground / Combine) and the palette-remap path
 // ============================================================================================
 
-// Uploads a full RGBA8 image built by a per-texel callback (helps stage the combine/scene textures)
-template<class Fn>
-void UploadRgba(RHI::Texture& texture, std::int32_t w, std::int32_t h, Fn texel)
-{
-	std::vector<std::uint8_t> data(std::size_t(w) * std::size_t(h) * 4);
-	for (std::int32_t y = 0; y < h; y++) {
-		for (std::int32_t x = 0; x < w; x++) {
-			std::uint8_t* p = data.data() + (std::size_t(y) * w + x) * 4;
-			texel(x, y, p);
-		}
-	}
-	texture.TexImage2D(0, PixelFormat::RGBA8, false, w, h, data.data());
-}
-
 // --- TexturedBackground / TexturedBackgroundCircle: solid source -> analytic horizon/edge asserts ---
 
 bool RunBackgroundTest(const char* baseDir, bool circle)
@@ -1153,7 +982,7 @@ bool RunPaletteTest(const char* baseDir)
 		const int er = int(16 * sa + 40 * (1 - sa) + 0.5f);
 		const int eg = int(239 * sa + 40 * (1 - sa) + 0.5f);
 		const int eb = int(128 * sa + 40 * (1 - sa) + 0.5f);
-		const int ea = int(128 * sa + 255 * (1 - sa) + 0.5f);
+		const int ea = int(255 * sa + 255 * (1 - sa) + 0.5f);		// Alpha blends with One / OneMinusSrcAlpha
 		std::printf("RG8 index (alpha in G), alpha-blended over the clear:\n");
 		CheckPixel(pixels, stride, 2, 10, 40, 40, 40, 255, 1, "index 0 (G=0) = clear shows through");
 		CheckPixel(pixels, stride, 6, 10, er, eg, eb, ea, 2, "index 16 (G=128) blended");
@@ -1162,6 +991,392 @@ bool RunPaletteTest(const char* baseDir)
 	return wroteAll;
 }
 
+// --- SwRescale (CPU rescale filters of the direct tier presentation) ---
+
+bool RunRescaleTest(const char* baseDir)
+{
+	namespace SwRescale = RHI::Software::SwRescale;
+	using RHI::Software::SwRescaleFilter;
+
+	constexpr std::int32_t W = 24, H = 16;
+	std::printf("\n=== SwRescale ===\n");
+
+	// Flat source: the edge-detecting filters must not invent edges, every output pixel keeps the colour
+	std::vector<std::uint8_t> flat(std::size_t(W) * H * 4);
+	for (std::size_t i = 0; i < flat.size(); i += 4) {
+		flat[i] = 200; flat[i + 1] = 100; flat[i + 2] = 50; flat[i + 3] = 255;
+	}
+
+	const struct { SwRescaleFilter Filter; std::int32_t Scale; const char* Name; } EdgeFilters[] = {
+		{ SwRescaleFilter::HQ2x, 2, "HQ2x" },
+		{ SwRescaleFilter::Xbrz3x, 3, "xBRZ" },
+		{ SwRescaleFilter::Sabr, 3, "SABR" },
+		{ SwRescaleFilter::CleanEdge, 4, "CleanEdge" }
+	};
+
+	std::printf("Flat source stays flat:\n");
+	for (const auto& filter : EdgeFilters) {
+		g_checks++;
+		std::int32_t scale = SwRescale::GetScaleFactor(filter.Filter);
+		if (scale != filter.Scale) {
+			g_failures++;
+			std::printf("  FAIL %-28s scale = %d, expected %d\n", filter.Name, scale, filter.Scale);
+			continue;
+		}
+
+		std::int32_t dstStride = W * scale * 4;
+		std::vector<std::uint8_t> dst(std::size_t(dstStride) * H * scale);
+		SwRescale::Apply(filter.Filter, flat.data(), W, H, W * 4, dst.data(), dstStride);
+		CheckPixel(dst.data(), dstStride, 0, 0, 200, 100, 50, 255, 1, filter.Name);
+		CheckPixel(dst.data(), dstStride, W * scale / 2 + 1, H * scale / 2 - 1, 200, 100, 50, 255, 1, filter.Name);
+		CheckPixel(dst.data(), dstStride, W * scale - 1, H * scale - 1, 200, 100, 50, 255, 1, filter.Name);
+	}
+
+	// Black maps to the darkest shade of the palette regardless of the dither threshold
+	{
+		std::vector<std::uint8_t> black(std::size_t(W) * H * 4, 0);
+		std::vector<std::uint8_t> dst(black.size());
+		SwRescale::Apply(SwRescaleFilter::Monochrome, black.data(), W, H, W * 4, dst.data(), W * 4);
+		std::printf("Monochrome:\n");
+		CheckPixel(dst.data(), W * 4, 0, 0, 26, 34, 39, 255, 0, "black -> darkest shade");
+		CheckPixel(dst.data(), W * 4, 3, 5, 26, 34, 39, 255, 0, "black -> darkest shade");
+	}
+
+	// Gradient source with hard edges for the Gaussian CRT filters, the SIMD variants must match the scalar one
+	std::vector<std::uint8_t> gradient(std::size_t(W) * H * 4);
+	for (std::int32_t y = 0; y < H; y++) {
+		for (std::int32_t x = 0; x < W; x++) {
+			std::uint8_t* p = &gradient[(std::size_t(y) * W + x) * 4];
+			p[0] = std::uint8_t(x * 255 / (W - 1));
+			p[1] = std::uint8_t(y * 255 / (H - 1));
+			p[2] = std::uint8_t(((x / 3 + y / 2) & 1) != 0 ? 255 : 0);
+			p[3] = 255;
+		}
+	}
+
+	bool wroteAll = true;
+	const struct { SwRescaleFilter Filter; const char* Name; } CrtFilters[] = {
+		{ SwRescaleFilter::CrtShadowMask, "sw_rescale_crt_mask.png" },
+		{ SwRescaleFilter::CrtApertureGrille, "sw_rescale_crt_grille.png" }
+	};
+	std::printf("CRT filters:\n");
+	for (const auto& filter : CrtFilters) {
+		constexpr std::int32_t Scale = 3;
+		constexpr std::int32_t DstStride = W * Scale * 4;
+		std::vector<std::uint8_t> dst(std::size_t(DstStride) * H * Scale);
+		SwRescale::Apply(filter.Filter, gradient.data(), W, H, W * 4, dst.data(), DstStride);
+
+#if defined(DEATH_CPU_USE_RUNTIME_DISPATCH) && !defined(DEATH_CPU_USE_IFUNC)
+		// Accumulation order is the same in every variant, but FMA contraction may differ by one step
+		std::vector<std::uint8_t> reference(dst.size());
+		SwRescale::SetCpuFeatures(Death::Cpu::Scalar);
+		SwRescale::Apply(filter.Filter, gradient.data(), W, H, W * 4, reference.data(), DstStride);
+		SwRescale::SetCpuFeatures(Death::Cpu::runtimeFeatures());
+
+		std::int32_t maxDiff = 0;
+		for (std::size_t i = 0; i < dst.size(); i++) {
+			maxDiff = std::max(maxDiff, std::abs(std::int32_t(dst[i]) - std::int32_t(reference[i])));
+		}
+		g_checks++;
+		if (maxDiff > 1) {
+			g_failures++;
+			std::printf("  FAIL %-28s SIMD differs from scalar by %d\n", filter.Name, maxDiff);
+		} else {
+			std::printf("  ok   %-28s SIMD matches scalar (max diff %d)\n", filter.Name, maxDiff);
+		}
+#endif
+		std::int32_t translucentCount = 0;
+		for (std::size_t i = 3; i < dst.size(); i += 4) {
+			translucentCount += (dst[i] != 255 ? 1 : 0);
+		}
+		g_checks++;
+		if (translucentCount != 0) {
+			g_failures++;
+			std::printf("  FAIL %-28s %d pixels are not opaque\n", filter.Name, translucentCount);
+		} else {
+			std::printf("  ok   %-28s output is opaque\n", filter.Name);
+		}
+
+		char outputPath[1024];
+		MakePath(baseDir, filter.Name, outputPath, sizeof(outputPath));
+		wroteAll = WritePng(outputPath, dst.data(), W * Scale, H * Scale, DstStride) && wroteAll;
+	}
+
+	return wroteAll;
+}
+
+// --- SwTileRenderer damage tracking (unchanged tiles are skipped from frame to frame) ---
+
+bool RunDamageTest(const char* baseDir)
+{
+	using RHI::Software::SwTileRenderer::DamageStatistics;
+	namespace SwTileRenderer = RHI::Software::SwTileRenderer;
+
+	constexpr std::int32_t W = 128, H = 128;
+	g_uniformBump = 0;
+	std::printf("\n=== SwTileRenderer damage tracking ===\n");
+
+	RHI::ShaderProgram program(RHI::ShaderProgram::QueryPhase::Immediate);
+	program.SetReflection(&nCine::ShadersGen::DefaultSprite.Variants[0]);
+	program.Link(RHI::ShaderProgram::Introspection::Enabled);
+	program.SetObjectLabel("Sprite");
+
+	RHI::Buffer uniformBuffer(BufferTarget::Uniform);
+	uniformBuffer.BufferData(64 * 1024, nullptr, BufferUsage::StreamDraw);
+	g_uniformBuffer = &uniformBuffer;
+	RHI::ShaderUniformBlocks::SetUniformRangeAllocator(&AllocUniformRange);
+
+	std::vector<std::uint8_t> cameraBuffer(program.GetUniformsSize() + 16, 0);
+	RHI::ShaderUniforms camera(&program);
+	camera.SetUniformsDataPointer(cameraBuffer.data());
+	const float projection[16] = {
+		2.0f / W, 0.0f, 0.0f, 0.0f,
+		0.0f, -2.0f / H, 0.0f, 0.0f,
+		0.0f, 0.0f, -1.0f, 0.0f,
+		-1.0f, 1.0f, 0.0f, 1.0f
+	};
+	const float view[16] = {
+		1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1
+	};
+	camera.GetUniform("uProjectionMatrix")->SetFloatVector(projection);
+	camera.GetUniform("uViewMatrix")->SetFloatVector(view);
+
+	std::vector<std::uint8_t> blockBuffer(program.GetUniformBlocksSize() + 16, 0);
+	RHI::ShaderUniformBlocks blocks(&program);
+	blocks.SetUniformsDataPointer(blockBuffer.data());
+
+	const std::uint8_t white[4] = { 255, 255, 255, 255 };
+	RHI::Texture texture(TextureTarget::Texture2D);
+	texture.TexImage2D(0, PixelFormat::RGBA8, false, 1, 1, white);
+
+	RHI::Buffer vbo(BufferTarget::Vertex);
+	vbo.BufferData(4 * 4 * sizeof(float), nullptr, BufferUsage::StaticDraw);
+	RHI::Buffer ibo(BufferTarget::Index);
+
+	RHI::Texture colorTexture(TextureTarget::Texture2D);
+	colorTexture.TexImage2D(0, PixelFormat::RGBA8, false, W, H, nullptr);
+	RHI::RenderTarget renderTarget;
+	renderTarget.AttachColorTexture(colorTexture, 0);
+	renderTarget.SetDrawBuffers(1);
+
+	// Sprite A covers the 2x2 tiles at the top-left, sprite B the 2x2 tiles at the bottom-right
+	const float texRect[4] = { 1.0f, 0.0f, 1.0f, 0.0f };
+	const float sizeA[2] = { 48.0f, 48.0f };
+	const float sizeB[2] = { 32.0f, 32.0f };
+	const float colorA[4] = { 1.0f, 0.5f, 0.25f, 1.0f };
+	auto renderFrame = [&](const float* colorB) {
+		renderTarget.BindDraw();
+		RHI::Device::SetupInitialState();
+		RHI::Device::SetViewport(Recti(0, 0, W, H));
+		RHI::Device::SetClearColor(Colorf(40.0f / 255.0f, 40.0f / 255.0f, 40.0f / 255.0f, 1.0f));
+		RHI::Device::Clear(ClearFlags::Color);
+
+		float model[16];
+		MakeTranslation(8.0f, 8.0f, model);
+		DrawSprite(program, camera, blocks, texture, vbo, ibo, model, colorA, texRect, sizeA,
+			false, BlendingFactor::One, BlendingFactor::Zero, nullptr, DrawKind::Arrays);
+		MakeTranslation(80.0f, 80.0f, model);
+		DrawSprite(program, camera, blocks, texture, vbo, ibo, model, colorB, texRect, sizeB,
+			false, BlendingFactor::One, BlendingFactor::Zero, nullptr, DrawKind::Arrays);
+
+		SwTileRenderer::ResetDamageStatistics();
+		RHI::Software::SwRaster::Flush();
+		return SwTileRenderer::GetDamageStatistics();
+	};
+
+	auto checkDamage = [](const DamageStatistics& stats, std::uint32_t rendered, std::uint32_t skipped, const char* label) {
+		g_checks++;
+		if (stats.renderedTiles != rendered || stats.skippedTiles != skipped) {
+			g_failures++;
+			std::printf("  FAIL %-40s rendered %u, skipped %u, expected %u / %u\n", label, stats.renderedTiles, stats.skippedTiles, rendered, skipped);
+		} else {
+			std::printf("  ok   %-40s rendered %u, skipped %u\n", label, stats.renderedTiles, stats.skippedTiles);
+		}
+	};
+
+	const std::uint8_t* pixels = colorTexture.GetPixels();
+	const std::int32_t stride = colorTexture.GetStrideBytes();
+	auto fy = [&](std::int32_t y) { return H - 1 - y; };
+
+	const float greenB[4] = { 0.0f, 1.0f, 0.0f, 1.0f };
+	const float blueB[4] = { 0.0f, 0.0f, 1.0f, 1.0f };
+	checkDamage(renderFrame(greenB), 16, 0, "first frame renders every tile");
+	checkDamage(renderFrame(greenB), 0, 16, "identical frame skips every tile");
+	CheckPixel(pixels, stride, 20, fy(20), 255, 128, 64, 255, 2, "skipped tile keeps sprite A");
+	CheckPixel(pixels, stride, 64, fy(64), 40, 40, 40, 255, 0, "skipped tile keeps the clear");
+
+	checkDamage(renderFrame(blueB), 4, 12, "changed tint renders only its tiles");
+	CheckPixel(pixels, stride, 96, fy(96), 0, 0, 255, 255, 2, "sprite B is re-rendered");
+
+	const std::uint8_t gray[4] = { 128, 128, 128, 255 };
+	texture.TexImage2D(0, PixelFormat::RGBA8, false, 1, 1, gray);
+	checkDamage(renderFrame(blueB), 8, 8, "texture upload renders its sprites");
+	CheckPixel(pixels, stride, 20, fy(20), 128, 64, 32, 255, 2, "sprite A uses the new texels");
+
+	// A write behind the layer's back must not leave stale tiles
+	std::memset(colorTexture.MutablePixels(), 0, std::size_t(stride) * H);
+	SwTileRenderer::InvalidateSurface(colorTexture.GetPixels());
+	checkDamage(renderFrame(blueB), 16, 0, "invalidated surface renders every tile");
+	CheckPixel(pixels, stride, 64, fy(64), 40, 40, 40, 255, 0, "clear is applied again");
+
+	static_cast<void>(baseDir);
+	return true;
+}
+
+// --- SwTexture tiled layout (rotated quads) and mip chain (minified quads) ---
+
+bool RunTextureLayoutTest(const char* baseDir)
+{
+	char outputPath[512];
+	MakePath(baseDir, "sw_texture_layout.png", outputPath, sizeof(outputPath));
+	constexpr std::int32_t TexSize = 128;
+	constexpr std::int32_t W = 160, H = 160;
+	g_uniformBump = 0;
+	std::printf("\n=== SwTexture tiled layout and mip chain ===\n");
+
+	auto checkValue = [](std::int32_t actual, std::int32_t expected, const char* label) {
+		g_checks++;
+		if (actual != expected) {
+			g_failures++;
+			std::printf("  FAIL %-40s %d, expected %d\n", label, actual, expected);
+		} else {
+			std::printf("  ok   %-40s %d\n", label, actual);
+		}
+	};
+
+	// Quadrants: top-left red, top-right green, bottom-left blue, bottom-right yellow (64 KiB, gets a tiled copy)
+	std::vector<std::uint8_t> quadrants(std::size_t(TexSize) * TexSize * 4);
+	for (std::int32_t y = 0; y < TexSize; y++) {
+		for (std::int32_t x = 0; x < TexSize; x++) {
+			std::uint8_t* p = &quadrants[(std::size_t(y) * TexSize + x) * 4];
+			const bool right = (x >= TexSize / 2), bottom = (y >= TexSize / 2);
+			p[0] = std::uint8_t(bottom == right ? 255 : 0);
+			p[1] = std::uint8_t(right ? 255 : 0);
+			p[2] = std::uint8_t(bottom && !right ? 255 : 0);
+			p[3] = 255;
+		}
+	}
+	RHI::Texture quadTexture(TextureTarget::Texture2D);
+	quadTexture.TexImage2D(0, PixelFormat::RGBA8, false, TexSize, TexSize, quadrants.data());
+
+	const RHI::Texture::SampledLevel linear = quadTexture.GetSampledLevel(0, false);
+	const RHI::Texture::SampledLevel tiled = quadTexture.GetSampledLevel(0, true);
+	checkValue(linear.blocksPerRow, 0, "axis-aligned quads read linear rows");
+	checkValue(tiled.blocksPerRow, TexSize / RHI::Texture::TileBlockSize, "rotated quads read 4x4 blocks");
+	std::int32_t mismatches = 0;
+	for (std::int32_t y = 0; y < TexSize; y++) {
+		for (std::int32_t x = 0; x < TexSize; x++) {
+			const std::size_t tiledOffset = RHI::Texture::TexelIndex(x, y, TexSize, tiled.blocksPerRow) * 4;
+			mismatches += (std::memcmp(tiled.pixels + tiledOffset, &quadrants[(std::size_t(y) * TexSize + x) * 4], 4) != 0 ? 1 : 0);
+		}
+	}
+	checkValue(mismatches, 0, "tiled copy matches the texels");
+
+	// One-texel black and white checker, minifying it averages to gray only with the mip chain
+	std::vector<std::uint8_t> checker(std::size_t(TexSize) * TexSize * 4);
+	for (std::int32_t y = 0; y < TexSize; y++) {
+		for (std::int32_t x = 0; x < TexSize; x++) {
+			std::uint8_t* p = &checker[(std::size_t(y) * TexSize + x) * 4];
+			p[0] = p[1] = p[2] = std::uint8_t(((x ^ y) & 1) != 0 ? 255 : 0);
+			p[3] = 255;
+		}
+	}
+	RHI::Texture checkerTexture(TextureTarget::Texture2D);
+	checkerTexture.TexImage2D(0, PixelFormat::RGBA8, false, TexSize, TexSize, checker.data());
+	checkValue(checkerTexture.SelectMipLevel(4.0f), 0, "no mipmap filter samples level 0");
+	checkerTexture.SetMinFiltering(SamplerFilter::LinearMipmapNearest);
+	checkValue(checkerTexture.SelectMipLevel(1.5f), 0, "1.5 texels per pixel samples level 0");
+	checkValue(checkerTexture.SelectMipLevel(2.0f), 1, "2 texels per pixel samples level 1");
+	checkValue(checkerTexture.SelectMipLevel(5.0f), 2, "5 texels per pixel samples level 2");
+	const RHI::Texture::SampledLevel level1 = checkerTexture.GetSampledLevel(1, false);
+	checkValue(level1.width, TexSize / 2, "level 1 width");
+	checkValue(level1.pixels[0], 128, "level 1 is the 2x2 average");
+
+	RHI::ShaderProgram program(RHI::ShaderProgram::QueryPhase::Immediate);
+	program.SetReflection(&nCine::ShadersGen::DefaultSprite.Variants[0]);
+	program.Link(RHI::ShaderProgram::Introspection::Enabled);
+	program.SetObjectLabel("Sprite");
+
+	RHI::Buffer uniformBuffer(BufferTarget::Uniform);
+	uniformBuffer.BufferData(64 * 1024, nullptr, BufferUsage::StreamDraw);
+	g_uniformBuffer = &uniformBuffer;
+	RHI::ShaderUniformBlocks::SetUniformRangeAllocator(&AllocUniformRange);
+
+	std::vector<std::uint8_t> cameraBuffer(program.GetUniformsSize() + 16, 0);
+	RHI::ShaderUniforms camera(&program);
+	camera.SetUniformsDataPointer(cameraBuffer.data());
+	const float projection[16] = {
+		2.0f / W, 0.0f, 0.0f, 0.0f,
+		0.0f, -2.0f / H, 0.0f, 0.0f,
+		0.0f, 0.0f, -1.0f, 0.0f,
+		-1.0f, 1.0f, 0.0f, 1.0f
+	};
+	const float view[16] = {
+		1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1
+	};
+	camera.GetUniform("uProjectionMatrix")->SetFloatVector(projection);
+	camera.GetUniform("uViewMatrix")->SetFloatVector(view);
+
+	std::vector<std::uint8_t> blockBuffer(program.GetUniformBlocksSize() + 16, 0);
+	RHI::ShaderUniformBlocks blocks(&program);
+	blocks.SetUniformsDataPointer(blockBuffer.data());
+
+	RHI::Buffer vbo(BufferTarget::Vertex);
+	vbo.BufferData(4 * 4 * sizeof(float), nullptr, BufferUsage::StaticDraw);
+	RHI::Buffer ibo(BufferTarget::Index);
+
+	RHI::Texture colorTexture(TextureTarget::Texture2D);
+	colorTexture.TexImage2D(0, PixelFormat::RGBA8, false, W, H, nullptr);
+	RHI::RenderTarget renderTarget;
+	renderTarget.AttachColorTexture(colorTexture, 0);
+	renderTarget.SetDrawBuffers(1);
+	renderTarget.BindDraw();
+
+	RHI::Device::SetupInitialState();
+	RHI::Device::SetViewport(Recti(0, 0, W, H));
+	RHI::Device::SetClearColor(Colorf(40.0f / 255.0f, 40.0f / 255.0f, 40.0f / 255.0f, 1.0f));
+	RHI::Device::Clear(ClearFlags::Color);
+
+	const float texRect[4] = { 1.0f, 0.0f, 1.0f, 0.0f };
+	const float white[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+	// Rotated by 90 degrees, so texel (u, v) lands on (144 - 128 * v, 16 + 128 * u) and the affine path samples it
+	const float fullSize[2] = { float(TexSize), float(TexSize) };
+	float model[16];
+	MakeTranslation(144.0f, 16.0f, model);
+	model[0] = 0.0f; model[1] = 1.0f;
+	model[4] = -1.0f; model[5] = 0.0f;
+	DrawSprite(program, camera, blocks, quadTexture, vbo, ibo, model, white, texRect, fullSize,
+		false, BlendingFactor::One, BlendingFactor::Zero, nullptr, DrawKind::Arrays);
+	RHI::Software::SwRaster::Flush();
+
+	const std::uint8_t* pixels = colorTexture.GetPixels();
+	const std::int32_t stride = colorTexture.GetStrideBytes();
+	auto fy = [&](std::int32_t y) { return H - 1 - y; };
+	CheckPixel(pixels, stride, 112, fy(48), 255, 0, 0, 255, 0, "rotated top-left = red");
+	CheckPixel(pixels, stride, 112, fy(112), 0, 255, 0, 255, 0, "rotated top-right = green");
+	CheckPixel(pixels, stride, 48, fy(48), 0, 0, 255, 255, 0, "rotated bottom-left = blue");
+	CheckPixel(pixels, stride, 48, fy(112), 255, 255, 0, 255, 0, "rotated bottom-right = yellow");
+
+	// Minified four times: level 2 averages 4x4 texels of the checker
+	const float quarterSize[2] = { float(TexSize / 4), float(TexSize / 4) };
+	MakeTranslation(4.0f, 4.0f, model);
+	DrawSprite(program, camera, blocks, checkerTexture, vbo, ibo, model, white, texRect, quarterSize,
+		false, BlendingFactor::One, BlendingFactor::Zero, nullptr, DrawKind::Arrays);
+	RHI::Software::SwRaster::Flush();
+	CheckPixel(pixels, stride, 12, fy(12), 128, 128, 128, 255, 1, "minified checker = gray");
+
+	// Without a mipmap filter, every pixel picks a single black or white texel
+	checkerTexture.SetMinFiltering(SamplerFilter::Linear);
+	DrawSprite(program, camera, blocks, checkerTexture, vbo, ibo, model, white, texRect, quarterSize,
+		false, BlendingFactor::One, BlendingFactor::Zero, nullptr, DrawKind::Arrays);
+	RHI::Software::SwRaster::Flush();
+	const std::uint8_t* aliased = PixelAt(pixels, stride, 12, fy(12));
+	checkValue((aliased[0] == 0 || aliased[0] == 255) ? 1 : 0, 1, "level 0 minified checker aliases");
+
+	return WritePng(outputPath, pixels, W, H, stride);
+}
+
 int main(int argc, char** argv)
 {
 	// Unbuffered stdout so a crash in a later test cannot swallow the log of the earlier ones
@@ -1178,6 +1393,9 @@ int main(int argc, char** argv)
 	wroteAll = RunBackgroundWarpTest(baseDir) && wroteAll;
 	wroteAll = RunCombineTest(baseDir) && wroteAll;
 	wroteAll = RunPaletteTest(baseDir) && wroteAll;
+	wroteAll = RunRescaleTest(baseDir) && wroteAll;
+	wroteAll = RunDamageTest(baseDir) && wroteAll;
+	wroteAll = RunTextureLayoutTest(baseDir) && wroteAll;
 
 	std::printf("\n=====================================\n");
 	std::printf("Total checks: %d, failures: %d, all PNGs written: %s\n", g_checks, g_failures, wroteAll ? "yes" : "no");
@@ -0,0 +1,898 @@
+// Benchmark and golden-image regression suite for the software RHI backend.
+//
+// Renders a fixed set of scenes that stand for what a frame of the game is made of - scrolling tile layers,
+// thousands of sprites, palette-remapped sprites, the lighting/water combine, the two-pass blur and the final
+// upscale - through the same `RHI::` calls `RenderCommand::Issue()` makes. Every scene is rendered at several
+// resolutions, with several tile-renderer worker counts and (on a build whose CPU dispatch goes through
+// function pointers) with the scalar, SSE2 and AVX2 scanline kernels, and:
+//
+//  - every configuration must produce exactly the same pixels as the scalar single-threaded one,
+//  - that image's CRC-32 must match the golden checksum of the scene/resolution in SwRenderBench.golden,
+//  - and the time per frame is reported as nanoseconds per destination pixel.
+//
+// So a change to SwRaster / SwTileRenderer comes with both the proof it is still pixel-identical (`--check`,
+// which is what CTest runs) and the numbers showing whether it is faster (the default mode, which renders
+// every configuration `--iterations` times after a warm-up frame).
+//
+// Usage: SwRenderBench [--check] [--iterations <n>] [--golden <file>] [--update] [--png <dir>] [--scene <name>]
+//
+// `--update` rewrites the golden file from the scalar single-threaded images, for a change that is meant to
+// alter the output (say why in the commit). The checksums are of the x86-64 reference build; a platform
+// where the compiler contracts float expressions differently can legitimately disagree, so the cross-variant
+// check is the one that has to hold everywhere.
+
+// WITH_RHI_SOFTWARE is defined on the compiler command line so every translation unit sees it
+
+#include "SwTestCommon.h"
+#include "nCine/Graphics/RHI/Software/SwRaster.h"
+#include "nCine/Graphics/RHI/Software/SwTileRenderer.h"
+#include "Shaders/Generated/DefaultSprite.h"
+#include "Shaders/Generated/PaletteRemap.h"
+#include "Shaders/Generated/Combine.h"
+#include "Shaders/Generated/Blur.h"
+
+#include <Cpu.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Death;
+
+namespace
+{
+	// Small deterministic generator, so the scenes are identical on every run and every platform
+	struct Random
+	{
+		std::uint32_t State;
+
+		explicit Random(std::uint32_t seed) : State(seed) {}
+
+		std::uint32_t Next() {
+			State ^= State << 13;
+			State ^= State >> 17;
+			State ^= State << 5;
+			return State;
+		}
+
+		float NextFloat(float min, float max) {
+			return min + (max - min) * float(Next() & 0xFFFFFF) / float(0x1000000);
+		}
+
+		std::int32_t NextInt(std::int32_t min, std::int32_t max) {
+			return min + std::int32_t(Next() % std::uint32_t(max - min + 1));
+		}
+	};
+
+	// Model matrix of a `width` x `height` sprite rotated by `angle` around its centre at (`cx`, `cy`)
+	void MakeRotation(float cx, float cy, float width, float height, float angle, float* m)
+	{
+		const float c = std::cos(angle), s = std::sin(angle);
+		MakeTranslation(0.0f, 0.0f, m);
+		m[0] = c;
+		m[1] = s;
+		m[4] = -s;
+		m[5] = c;
+		m[12] = cx - (c * width * 0.5f - s * height * 0.5f);
+		m[13] = cy - (s * width * 0.5f + c * height * 0.5f);
+	}
+
+	// ---- One program with its camera uniforms and instance block, drawing one sprite quad per call ----
+
+	class SpritePass
+	{
+	public:
+		SpritePass(const ShaderCompiler::Program& source, const char* label, std::int32_t width, std::int32_t height)
+			: _program(RHI::ShaderProgram::QueryPhase::Immediate), _vbo(BufferTarget::Vertex), _ibo(BufferTarget::Index)
+		{
+			_program.SetReflection(&source.Variants[0]);
+			_program.Link(RHI::ShaderProgram::Introspection::Enabled);
+			_program.SetObjectLabel(label);
+
+			_cameraBuffer.resize(_program.GetUniformsSize() + 16, 0);
+			_camera = std::make_unique<RHI::ShaderUniforms>(&_program);
+			_camera->SetUniformsDataPointer(_cameraBuffer.data());
+			float projection[16];
+			BuildOrtho(width, height, projection);
+			_camera->GetUniform("uProjectionMatrix")->SetFloatVector(projection);
+			_camera->GetUniform("uViewMatrix")->SetFloatVector(kIdentityView);
+
+			_blockBuffer.resize(_program.GetUniformBlocksSize() + 16, 0);
+			_blocks = std::make_unique<RHI::ShaderUniformBlocks>(&_program);
+			_blocks->SetUniformsDataPointer(_blockBuffer.data());
+			RHI::UniformBlockCache* instanceBlock = _blocks->GetUniformBlock("InstanceBlock");
+			_modelMatrix = instanceBlock->GetUniform("modelMatrix");
+			_color = instanceBlock->GetUniform("color");
+			_texRect = instanceBlock->GetUniform("texRect");
+			_spriteSize = instanceBlock->GetUniform("spriteSize");
+			_palOffset = instanceBlock->GetUniform("palOffset");
+
+			_vbo.BufferData(4 * 4 * sizeof(float), nullptr, BufferUsage::StaticDraw);
+			const std::uint16_t indices[6] = {0, 1, 2, 2, 1, 3};
+			_ibo.BufferData(sizeof(indices), indices, BufferUsage::StaticDraw);
+		}
+
+		RHI::UniformCache* GetCameraUniform(const char* name) {
+			return _camera->GetUniform(name);
+		}
+
+		void Draw(RHI::Texture& texture, RHI::Texture* palette, const float* model, const float* color,
+			const float* texRect, float width, float height, float palOffset, bool blend)
+		{
+			_modelMatrix->SetFloatVector(model);
+			_color->SetFloatVector(color);
+			_texRect->SetFloatVector(texRect);
+			_spriteSize->SetFloatValue(width, height);
+			if (_palOffset != nullptr) {
+				_palOffset->SetFloatValue(palOffset);
+			}
+			_blocks->CommitUniformBlocks();
+
+			texture.Bind(0);
+			if (palette != nullptr) {
+				palette->Bind(1);
+			}
+			_program.Use();
+			_blocks->Bind();
+			_camera->CommitUniforms();
+
+			RHI::Device::SetBlendingEnabled(blend);
+			if (blend) {
+				RHI::Device::SetBlendingFactors(BlendingFactor::SrcAlpha, BlendingFactor::OneMinusSrcAlpha,
+					BlendingFactor::One, BlendingFactor::OneMinusSrcAlpha);
+			}
+			_program.DefineVertexFormat(&_vbo, &_ibo, 0);
+			_vbo.Bind();
+			RHI::Device::DrawArrays(PrimitiveType::TriangleStrip, 0, 4);
+		}
+
+	private:
+		RHI::ShaderProgram _program;
+		RHI::Buffer _vbo;
+		RHI::Buffer _ibo;
+		std::vector<std::uint8_t> _cameraBuffer;
+		std::vector<std::uint8_t> _blockBuffer;
+		std::unique_ptr<RHI::ShaderUniforms> _camera;
+		std::unique_ptr<RHI::ShaderUniformBlocks> _blocks;
+		RHI::UniformCache* _modelMatrix;
+		RHI::UniformCache* _color;
+		RHI::UniformCache* _texRect;
+		RHI::UniformCache* _spriteSize;
+		RHI::UniformCache* _palOffset;
+	};
+
+	// ---- Render-target texture the scenes draw into ----
+
+	class SceneTarget
+	{
+	public:
+		SceneTarget(std::int32_t width, std::int32_t height)
+			: _texture(TextureTarget::Texture2D), _width(width), _height(height)
+		{
+			_texture.TexImage2D(0, PixelFormat::RGBA8, false, width, height, nullptr);
+			_renderTarget.AttachColorTexture(_texture, 0);
+			_renderTarget.SetDrawBuffers(1);
+		}
+
+		void Bind(const Colorf& clearColor) {
+			_renderTarget.BindDraw();
+			RHI::Device::SetViewport(Recti(0, 0, _width, _height));
+			RHI::Device::SetScissorTestEnabled(false);
+			RHI::Device::SetClearColor(clearColor);
+			RHI::Device::Clear(ClearFlags::Color);
+		}
+
+		RHI::Texture& GetTexture() {
+			return _texture;
+		}
+
+	private:
+		RHI::Texture _texture;
+		RHI::RenderTarget _renderTarget;
+		std::int32_t _width;
+		std::int32_t _height;
+	};
+
+	// ---- Scenes ----
+
+	class Scene
+	{
+	public:
+		Scene(std::int32_t width, std::int32_t height) : _width(width), _height(height) {}
+		virtual ~Scene() = default;
+
+		/** @brief Restores whatever a previous frame changed in the inputs (not timed) */
+		virtual void BeginFrame() {}
+		/** @brief Renders and flushes one frame */
+		virtual void Render() = 0;
+		/** @brief Returns the rendered image, rows top-down */
+		virtual void GetImage(std::vector<std::uint8_t>& image) = 0;
+
+	protected:
+		std::int32_t _width;
+		std::int32_t _height;
+
+		// Copies a render-target texture, whose rows are stored bottom-up, top-down into `image`
+		void ReadTarget(RHI::Texture& texture, std::vector<std::uint8_t>& image) {
+			const std::uint8_t* pixels = texture.GetPixels();
+			const std::int32_t stride = texture.GetStrideBytes();
+			const std::size_t rowBytes = std::size_t(_width) * 4;
+			image.resize(rowBytes * _height);
+			for (std::int32_t y = 0; y < _height; y++) {
+				std::memcpy(image.data() + std::size_t(y) * rowBytes, pixels + std::size_t(_height - 1 - y) * stride, rowBytes);
+			}
+		}
+	};
+
+	// Two scrolled layers of 32x32 tiles from an atlas: an opaque background layer and a sparse, partly
+	// transparent foreground layer, both drawn with the sprite blend state the game uses for tiles
+	class TileLayersScene : public Scene
+	{
+	public:
+		TileLayersScene(std::int32_t width, std::int32_t height)
+			: Scene(width, height), _target(width, height), _pass(nCine::ShadersGen::DefaultSprite, "Sprite", width, height),
+				_atlas(TextureTarget::Texture2D)
+		{
+			// 8x8 tiles of 32x32: the first 32 are opaque, the rest have transparent holes and soft edges
+			UploadRgba(_atlas, 256, 256, [](std::int32_t x, std::int32_t y, std::uint8_t* p) {
+				const std::int32_t tile = (y / 32) * 8 + (x / 32);
+				const std::int32_t tx = x % 32, ty = y % 32;
+				p[0] = std::uint8_t(tile * 37 + tx * 3);
+				p[1] = std::uint8_t(tile * 91 + ty * 5);
+				p[2] = std::uint8_t((tx ^ ty) * 8);
+				if (tile < 32) {
+					p[3] = 255;
+				} else {
+					const std::int32_t dx = tx - 16, dy = ty - 16;
+					const std::int32_t d = dx * dx + dy * dy;
+					p[3] = std::uint8_t(d < 64 ? 0 : (d < 144 ? (d - 64) * 3 : 255));
+				}
+			});
+		}
+
+		void Render() override {
+			_target.Bind(Colorf(0.1f, 0.1f, 0.2f, 1.0f));
+			g_uniformBump = 0;
+
+			constexpr std::int32_t ScrollX = 13, ScrollY = 7;
+			const std::int32_t tilesX = (_width + ScrollX) / 32 + 1;
+			const std::int32_t tilesY = (_height + ScrollY) / 32 + 1;
+			float model[16];
+			for (std::int32_t layer = 0; layer < 2; layer++) {
+				for (std::int32_t y = 0; y < tilesY; y++) {
+					for (std::int32_t x = 0; x < tilesX; x++) {
+						std::int32_t tile = (x * 7 + y * 3 + layer * 5) % 32;
+						if (layer == 1) {
+							if (((x * 5 + y * 11) % 3) == 0) {
+								continue;
+							}
+							tile += 32;
+						}
+						const float texRect[4] = {1.0f / 8.0f, float(tile % 8) / 8.0f, 1.0f / 8.0f, float(tile / 8) / 8.0f};
+						MakeTranslation(float(x * 32 - ScrollX), float(y * 32 - ScrollY), model);
+						_pass.Draw(_atlas, nullptr, model, kWhite, texRect, 32.0f, 32.0f, 0.0f, true);
+					}
+				}
+			}
+			RHI::Software::SwRaster::Flush();
+		}
+
+		void GetImage(std::vector<std::uint8_t>& image) override {
+			ReadTarget(_target.GetTexture(), image);
+		}
+
+	private:
+		SceneTarget _target;
+		SpritePass _pass;
+		RHI::Texture _atlas;
+	};
+
+	// A few thousand alpha-blended, tinted sprites of varying size, a quarter of them rotated (affine path)
+	class SpritesScene : public Scene
+	{
+	public:
+		static constexpr std::int32_t Count = 2000;
+
+		SpritesScene(std::int32_t width, std::int32_t height)
+			: Scene(width, height), _target(width, height), _pass(nCine::ShadersGen::DefaultSprite, "Sprite", width, height),
+				_texture(TextureTarget::Texture2D)
+		{
+			// An anti-aliased ball with a shaded interior
+			UploadRgba(_texture, 64, 64, [](std::int32_t x, std::int32_t y, std::uint8_t* p) {
+				const float dx = x - 31.5f, dy = y - 31.5f;
+				const float d = std::sqrt(dx * dx + dy * dy);
+				const float coverage = std::clamp(31.0f - d, 0.0f, 1.0f);
+				p[0] = std::uint8_t(255 - x * 2);
+				p[1] = std::uint8_t(128 + y);
+				p[2] = std::uint8_t(64 + (x + y));
+				p[3] = std::uint8_t(coverage * 255.0f + 0.5f);
+			});
+
+			Random random(0x5EED0001u);
+			_sprites.resize(Count);
+			for (Sprite& sprite : _sprites) {
+				sprite.Size = random.NextFloat(16.0f, 64.0f);
+				sprite.X = random.NextFloat(-sprite.Size * 0.5f, float(width));
+				sprite.Y = random.NextFloat(-sprite.Size * 0.5f, float(height));
+				sprite.Angle = ((random.Next() & 3) == 0 ? random.NextFloat(0.1f, 3.0f) : 0.0f);
+				sprite.Color[0] = random.NextFloat(0.5f, 1.0f);
+				sprite.Color[1] = random.NextFloat(0.5f, 1.0f);
+				sprite.Color[2] = random.NextFloat(0.5f, 1.0f);
+				sprite.Color[3] = ((random.Next() & 1) == 0 ? 1.0f : random.NextFloat(0.3f, 1.0f));
+			}
+		}
+
+		void Render() override {
+			_target.Bind(Colorf(0.2f, 0.3f, 0.2f, 1.0f));
+			g_uniformBump = 0;
+
+			float model[16];
+			for (const Sprite& sprite : _sprites) {
+				if (sprite.Angle != 0.0f) {
+					MakeRotation(sprite.X + sprite.Size * 0.5f, sprite.Y + sprite.Size * 0.5f, sprite.Size, sprite.Size, sprite.Angle, model);
+				} else {
+					MakeTranslation(std::floor(sprite.X), std::floor(sprite.Y), model);
+				}
+				_pass.Draw(_texture, nullptr, model, sprite.Color, kTexRectFull, sprite.Size, sprite.Size, 0.0f, true);
+			}
+			RHI::Software::SwRaster::Flush();
+		}
+
+		void GetImage(std::vector<std::uint8_t>& image) override {
+			ReadTarget(_target.GetTexture(), image);
+		}
+
+	private:
+		struct Sprite
+		{
+			float X, Y, Size, Angle;
+			float Color[4];
+		};
+
+		SceneTarget _target;
+		SpritePass _pass;
+		RHI::Texture _texture;
+		std::vector<Sprite> _sprites;
+	};
+
+	// Indexed (R8) tiles and sprites looked up through a 256x256 palette texture, as the game draws its
+	// original-data graphics: a full opaque tile layer plus blended sprites using four palette rows
+	class PaletteRemapScene : public Scene
+	{
+	public:
+		static constexpr std::int32_t Count = 600;
+
+		PaletteRemapScene(std::int32_t width, std::int32_t height)
+			: Scene(width, height), _target(width, height), _pass(Jazz2::ShadersGen::PaletteRemap, "PaletteRemap", width, height),
+				_indices(TextureTarget::Texture2D), _palette(TextureTarget::Texture2D)
+		{
+			// Index 0 is transparent in every row, the rest are opaque
+			UploadRgba(_palette, 256, 256, [](std::int32_t x, std::int32_t y, std::uint8_t* p) {
+				p[0] = std::uint8_t(x + y * 64);
+				p[1] = std::uint8_t(255 - x + y * 32);
+				p[2] = std::uint8_t((x * 3) ^ (y * 50));
+				p[3] = (x == 0 ? 0 : 255);
+			});
+
+			// 8x8 cells of 32x32 indices: the top half is solid, the bottom half has index-0 holes
+			std::vector<std::uint8_t> data(256 * 256);
+			for (std::int32_t y = 0; y < 256; y++) {
+				for (std::int32_t x = 0; x < 256; x++) {
+					const std::int32_t tx = x % 32, ty = y % 32;
+					std::uint8_t index = std::uint8_t(1 + ((tx + ty * 3 + (x / 32) * 17) % 255));
+					if (y >= 128 && ((tx - 16) * (tx - 16) + (ty - 16) * (ty - 16)) > 200) {
+						index = 0;
+					}
+					data[std::size_t(y) * 256 + x] = index;
+				}
+			}
+			_indices.TexImage2D(0, PixelFormat::R8, false, 256, 256, data.data());
+
+			Random random(0x5EED0002u);
+			_sprites.resize(Count);
+			for (Sprite& sprite : _sprites) {
+				sprite.X = float(random.NextInt(-16, width - 16));
+				sprite.Y = float(random.NextInt(-16, height - 16));
+				sprite.Cell = random.NextInt(32, 63);
+				sprite.PalOffset = float(random.NextInt(0, 3) * 256);
+			}
+		}
+
+		void Render() override {
+			_target.Bind(Colorf(0.0f, 0.0f, 0.0f, 1.0f));
+			g_uniformBump = 0;
+
+			float model[16];
+			const std::int32_t tilesX = (_width + 31) / 32;
+			const std::int32_t tilesY = (_height + 31) / 32;
+			for (std::int32_t y = 0; y < tilesY; y++) {
+				for (std::int32_t x = 0; x < tilesX; x++) {
+					const std::int32_t cell = (x * 3 + y * 5) % 32;
+					MakeTranslation(float(x * 32), float(y * 32), model);
+					_pass.Draw(_indices, &_palette, model, kWhite, CellRect(cell).data(), 32.0f, 32.0f, 0.0f, true);
+				}
+			}
+			for (const Sprite& sprite : _sprites) {
+				MakeTranslation(sprite.X, sprite.Y, model);
+				_pass.Draw(_indices, &_palette, model, kWhite, CellRect(sprite.Cell).data(), 32.0f, 32.0f, sprite.PalOffset, true);
+			}
+			RHI::Software::SwRaster::Flush();
+		}
+
+		void GetImage(std::vector<std::uint8_t>& image) override {
+			ReadTarget(_target.GetTexture(), image);
+		}
+
+	private:
+		struct Sprite
+		{
+			float X, Y, PalOffset;
+			std::int32_t Cell;
+		};
+
+		SceneTarget _target;
+		SpritePass _pass;
+		RHI::Texture _indices;
+		RHI::Texture _palette;
+		std::vector<Sprite> _sprites;
+
+		static std::array<float, 4> CellRect(std::int32_t cell) {
+			return {1.0f / 8.0f, float(cell % 8) / 8.0f, 1.0f / 8.0f, float(cell / 8) / 8.0f};
+		}
+	};
+
+	// The viewport compositor's CPU combine over the screen back-buffer: a half-resolution lightmap with a
+	// handful of lights over a dark ambient, plus the waterline effect in the lower part of the viewport
+	class CombineScene : public Scene
+	{
+	public:
+		CombineScene(std::int32_t width, std::int32_t height)
+			: Scene(width, height), _pass(Jazz2::ShadersGen::Combine, "CombineWithWater", width, height)
+		{
+			// The intercepted draw samples nothing, but the pass still binds a texture like any other draw
+			const std::uint8_t white[4] = {255, 255, 255, 255};
+			_dummy.TexImage2D(0, PixelFormat::RGBA8, false, 1, 1, white);
+
+			_lmW = (width + 1) / 2;
+			_lmH = (height + 1) / 2;
+			_lightmap.resize(std::size_t(_lmW) * _lmH * 2);
+			Random random(0x5EED0003u);
+			constexpr std::int32_t LightCount = 12;
+			float lights[LightCount][4];
+			for (auto& light : lights) {
+				light[0] = random.NextFloat(0.0f, float(_lmW));
+				light[1] = random.NextFloat(0.0f, float(_lmH));
+				light[2] = random.NextFloat(20.0f, 80.0f);
+				light[3] = random.NextFloat(0.3f, 1.2f);
+			}
+			for (std::int32_t y = 0; y < _lmH; y++) {
+				for (std::int32_t x = 0; x < _lmW; x++) {
+					float intensity = 0.25f, core = 0.0f;
+					for (const auto& light : lights) {
+						const float dx = x - light[0], dy = y - light[1];
+						const float falloff = std::max(0.0f, 1.0f - std::sqrt(dx * dx + dy * dy) / light[2]);
+						intensity += falloff * light[3];
+						core += falloff * falloff * light[3];
+					}
+					_lightmap[(std::size_t(y) * _lmW + x) * 2] = intensity;
+					_lightmap[(std::size_t(y) * _lmW + x) * 2 + 1] = core;
+				}
+			}
+
+			_scene.resize(std::size_t(width) * height * 4);
+			for (std::int32_t y = 0; y < height; y++) {
+				for (std::int32_t x = 0; x < width; x++) {
+					std::uint8_t* p = _scene.data() + (std::size_t(y) * width + x) * 4;
+					p[0] = std::uint8_t(x * 255 / width);
+					p[1] = std::uint8_t(y * 255 / height);
+					p[2] = std::uint8_t(((x / 16) ^ (y / 16)) & 1 ? 200 : 60);
+					p[3] = 255;
+				}
+			}
+		}
+
+		void BeginFrame() override {
+			RHI::Software::SwDevice::SetRenderTarget(nullptr);
+			RHI::Software::SwDevice::ResizeScreenFramebuffer(_width, _height);
+			RHI::Software::Framebuffer fb = RHI::Software::SwDevice::GetScreenFramebuffer();
+			for (std::int32_t y = 0; y < _height; y++) {
+				std::memcpy(fb.pixels + std::size_t(y) * fb.strideBytes, _scene.data() + std::size_t(y) * _width * 4, std::size_t(_width) * 4);
+			}
+		}
+
+		void Render() override {
+			RHI::Device::SetViewport(Recti(0, 0, _width, _height));
+			RHI::Device::SetBlendingEnabled(false);
+			RHI::Device::SetScissorTestEnabled(false);
+			RHI::Software::SwDevice::SetPendingSoftwareLighting(_lightmap.data(), _lmW, _lmH, 2, 0, 0, _width, _height,
+				0.05f, 0.05f, 0.15f, true, float(_height) * 0.65f, 1.25f, 480.0f);
+			_pass.Draw(_dummy, nullptr, kIdentityView, kWhite, kTexRectFull, float(_width), float(_height), 0.0f, false);
+			RHI::Software::SwRaster::Flush();
+		}
+
+		void GetImage(std::vector<std::uint8_t>& image) override {
+			RHI::Software::Framebuffer fb = RHI::Software::SwDevice::GetScreenFramebuffer();
+			const std::size_t rowBytes = std::size_t(_width) * 4;
+			image.resize(rowBytes * _height);
+			for (std::int32_t y = 0; y < _height; y++) {
+				std::memcpy(image.data() + std::size_t(y) * rowBytes, fb.pixels + std::size_t(y) * fb.strideBytes, rowBytes);
+			}
+		}
+
+	private:
+		SpritePass _pass;
+		RHI::Texture _dummy{TextureTarget::Texture2D};
+		std::vector<float> _lightmap;
+		std::vector<std::uint8_t> _scene;
+		std::int32_t _lmW;
+		std::int32_t _lmH;
+	};
+
+	// The separable Gaussian blur of the bloom/menu chain: a horizontal pass into an intermediate target and
+	// a vertical pass out of it, both through the generated Blur fragment with bilinear sampling
+	class BlurScene : public Scene
+	{
+	public:
+		BlurScene(std::int32_t width, std::int32_t height)
+			: Scene(width, height), _intermediate(width, height), _target(width, height),
+				_horizontal(Jazz2::ShadersGen::Blur, "Blur", width, height), _vertical(Jazz2::ShadersGen::Blur, "Blur", width, height),
+				_source(TextureTarget::Texture2D)
+		{
+			UploadRgba(_source, width, height, [](std::int32_t x, std::int32_t y, std::uint8_t* p) {
+				const bool checker = (((x / 8) ^ (y / 8)) & 1) != 0;
+				p[0] = std::uint8_t(checker ? 240 : 20);
+				p[1] = std::uint8_t((x * 7) ^ (y * 3));
+				p[2] = std::uint8_t(checker ? 30 : 220);
+				p[3] = 255;
+			});
+			for (RHI::Texture* texture : {&_source, &_intermediate.GetTexture()}) {
+				texture->SetMinFiltering(SamplerFilter::Linear);
+				texture->SetMagFiltering(SamplerFilter::Linear);
+				texture->SetWrap(SamplerWrapping::ClampToEdge);
+			}
+			_horizontal.GetCameraUniform("uPixelOffset")->SetFloatValue(1.0f / width, 1.0f / height);
+			_horizontal.GetCameraUniform("uDirection")->SetFloatValue(1.0f, 0.0f);
+			_vertical.GetCameraUniform("uPixelOffset")->SetFloatValue(1.0f / width, 1.0f / height);
+			_vertical.GetCameraUniform("uDirection")->SetFloatValue(0.0f, 1.0f);
+		}
+
+		void Render() override {
+			g_uniformBump = 0;
+			float model[16];
+			MakeTranslation(0.0f, 0.0f, model);
+
+			_intermediate.Bind(Colorf(0.0f, 0.0f, 0.0f, 1.0f));
+			_horizontal.Draw(_source, nullptr, model, kWhite, kTexRectFull, float(_width), float(_height), 0.0f, false);
+			_target.Bind(Colorf(0.0f, 0.0f, 0.0f, 1.0f));
+			_vertical.Draw(_intermediate.GetTexture(), nullptr, model, kWhite, kTexRectFull, float(_width), float(_height), 0.0f, false);
+			RHI::Software::SwRaster::Flush();
+		}
+
+		void GetImage(std::vector<std::uint8_t>& image) override {
+			ReadTarget(_target.GetTexture(), image);
+		}
+
+	private:
+		SceneTarget _intermediate;
+		SceneTarget _target;
+		SpritePass _horizontal;
+		SpritePass _vertical;
+		RHI::Texture _source;
+	};
+
+	// The final upscale of the game's low-resolution view to the output: a third-size image stretched over
+	// the whole target with bilinear filtering
+	class UpscaleScene : public Scene
+	{
+	public:
+		UpscaleScene(std::int32_t width, std::int32_t height)
+			: Scene(width, height), _target(width, height), _pass(nCine::ShadersGen::DefaultSprite, "Sprite", width, height),
+				_source(TextureTarget::Texture2D)
+		{
+			UploadRgba(_source, std::max(1, width / 3), std::max(1, height / 3), [](std::int32_t x, std::int32_t y, std::uint8_t* p) {
+				p[0] = std::uint8_t(x * 5);
+				p[1] = std::uint8_t(y * 7);
+				p[2] = std::uint8_t(((x / 4) ^ (y / 4)) & 1 ? 250 : 10);
+				p[3] = 255;
+			});
+			_source.SetMinFiltering(SamplerFilter::Linear);
+			_source.SetMagFiltering(SamplerFilter::Linear);
+			_source.SetWrap(SamplerWrapping::ClampToEdge);
+		}
+
+		void Render() override {
+			_target.Bind(Colorf(0.0f, 0.0f, 0.0f, 1.0f));
+			g_uniformBump = 0;
+			float model[16];
+			MakeTranslation(0.0f, 0.0f, model);
+			_pass.Draw(_source, nullptr, model, kWhite, kTexRectFull, float(_width), float(_height), 0.0f, false);
+			RHI::Software::SwRaster::Flush();
+		}
+
+		void GetImage(std::vector<std::uint8_t>& image) override {
+			ReadTarget(_target.GetTexture(), image);
+		}
+
+	private:
+		SceneTarget _target;
+		SpritePass _pass;
+		RHI::Texture _source;
+	};
+
+	struct SceneInfo
+	{
+		const char* Name;
+		std::unique_ptr<Scene>(*Create)(std::int32_t width, std::int32_t height);
+	};
+
+	template<class T>
+	std::unique_ptr<Scene> CreateScene(std::int32_t width, std::int32_t height)
+	{
+		return std::make_unique<T>(width, height);
+	}
+
+	const SceneInfo Scenes[] = {
+		{ "TileLayers", &CreateScene<TileLayersScene> },
+		{ "Sprites", &CreateScene<SpritesScene> },
+		{ "PaletteRemap", &CreateScene<PaletteRemapScene> },
+		{ "CombineWater", &CreateScene<CombineScene> },
+		{ "Blur", &CreateScene<BlurScene> },
+		{ "Upscale", &CreateScene<UpscaleScene> }
+	};
+
+	struct Resolution
+	{
+		std::int32_t Width;
+		std::int32_t Height;
+	};
+
+	const Resolution Resolutions[] = { {320, 180}, {640, 360}, {1280, 720} };
+
+	// Worker threads of the tile renderer, -1 = the automatic count the game uses
+	const std::int32_t WorkerCounts[] = { 0, 1, -1 };
+
+	struct KernelVariant
+	{
+		const char* Name;
+#if defined(DEATH_CPU_USE_RUNTIME_DISPATCH) && !defined(DEATH_CPU_USE_IFUNC)
+		Cpu::Features Features;
+#endif
+	};
+
+	// Scalar first: it is the reference every other variant has to reproduce exactly
+#if defined(DEATH_CPU_USE_RUNTIME_DISPATCH) && !defined(DEATH_CPU_USE_IFUNC)
+	const KernelVariant KernelVariants[] = {
+		{ "scalar", Cpu::Scalar },
+#	if defined(DEATH_TARGET_X86)
+		{ "sse2", Cpu::Sse2 },
+		{ "avx2", Cpu::Avx2 },
+#	elif defined(DEATH_TARGET_ARM)
+		{ "neon", Cpu::Neon },
+#	endif
+	};
+#else
+	// The kernels are bound once by the build, so only what it selected can be measured
+	const KernelVariant KernelVariants[] = {
+		{ "default" }
+	};
+#endif
+
+	bool IsVariantSupported(const KernelVariant& variant)
+	{
+#if defined(DEATH_CPU_USE_RUNTIME_DISPATCH) && !defined(DEATH_CPU_USE_IFUNC)
+		return (Cpu::runtimeFeatures() & variant.Features) == variant.Features;
+#else
+		return true;
+#endif
+	}
+
+	void SelectVariant(const KernelVariant& variant)
+	{
+#if defined(DEATH_CPU_USE_RUNTIME_DISPATCH) && !defined(DEATH_CPU_USE_IFUNC)
+		RHI::Software::SwRaster::SetCpuFeatures(variant.Features);
+#endif
+	}
+
+	void SelectWorkerCount(std::int32_t count)
+	{
+		// The pool is spawned lazily again by the next draw
+		RHI::Software::SwTileRenderer::Shutdown();
+		RHI::Software::SwTileRenderer::SetWorkerCount(count);
+	}
+
+	std::map<std::string, std::uint32_t> LoadGolden(const char* path)
+	{
+		std::map<std::string, std::uint32_t> golden;
+		FILE* file = std::fopen(path, "r");
+		if (file == nullptr) {
+			return golden;
+		}
+		char line[256];
+		while (std::fgets(line, sizeof(line), file) != nullptr) {
+			char key[128];
+			unsigned int crc;
+			if (line[0] != '#' && std::sscanf(line, "%127s %x", key, &crc) == 2) {
+				golden[key] = crc;
+			}
+		}
+		std::fclose(file);
+		return golden;
+	}
+
+	bool SaveGolden(const char* path, const std::map<std::string, std::uint32_t>& golden)
+	{
+		FILE* file = std::fopen(path, "w");
+		if (file == nullptr) {
+			return false;
+		}
+		std::fprintf(file, "# CRC-32 of the scalar single-threaded image of every SwRenderBench scene (RGBA8, rows top-down)\n");
+		std::fprintf(file, "# Regenerate with `SwRenderBench --update --golden <this file>` only for an intended output change\n");
+		for (const auto& [key, crc] : golden) {
+			std::fprintf(file, "%s %08x\n", key.c_str(), crc);
+		}
+		std::fclose(file);
+		return true;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::setvbuf(stdout, nullptr, _IONBF, 0);
+
+	bool checkOnly = false, update = false;
+	std::int32_t iterations = 20;
+	const char* goldenPath = nullptr;
+	const char* pngDir = nullptr;
+	const char* sceneFilter = nullptr;
+	for (std::int32_t i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "--check") == 0) {
+			checkOnly = true;
+		} else if (std::strcmp(argv[i], "--update") == 0) {
+			update = true;
+		} else if (std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+			iterations = std::max(1, std::atoi(argv[++i]));
+		} else if (std::strcmp(argv[i], "--golden") == 0 && i + 1 < argc) {
+			goldenPath = argv[++i];
+		} else if (std::strcmp(argv[i], "--png") == 0 && i + 1 < argc) {
+			pngDir = argv[++i];
+		} else if (std::strcmp(argv[i], "--scene") == 0 && i + 1 < argc) {
+			sceneFilter = argv[++i];
+		} else {
+			std::printf("Usage: %s [--check] [--iterations <n>] [--golden <file>] [--update] [--png <dir>] [--scene <name>]\n", argv[0]);
+			return 2;
+		}
+	}
+	if (checkOnly) {
+		iterations = 1;
+	}
+
+	std::map<std::string, std::uint32_t> golden;
+	if (goldenPath != nullptr && !update) {
+		golden = LoadGolden(goldenPath);
+		if (golden.empty()) {
+			std::printf("Golden checksums not found in \"%s\"\n", goldenPath);
+			return 1;
+		}
+	}
+
+	RHI::Buffer uniformBuffer(BufferTarget::Uniform);
+	uniformBuffer.BufferData(4 * 1024 * 1024, nullptr, BufferUsage::StreamDraw);
+	g_uniformBuffer = &uniformBuffer;
+	RHI::ShaderUniformBlocks::SetUniformRangeAllocator(&AllocUniformRange);
+	RHI::Device::SetupInitialState();
+	// Every configuration renders the same frames again, damage tracking would skip them instead of measuring
+	// them, and the kernel variants have to be compared on freshly rendered pixels
+	RHI::Software::SwTileRenderer::SetDamageTracking(false);
+
+	std::printf("%-13s %-10s %-7s %-7s %10s %12s  %s\n", "Scene", "Size", "Kernels", "Workers", "ms/frame", "ns/pixel", "CRC-32");
+
+	std::int32_t failures = 0;
+	std::vector<std::uint8_t> reference, image;
+	for (const SceneInfo& sceneInfo : Scenes) {
+		if (sceneFilter != nullptr && std::strcmp(sceneFilter, sceneInfo.Name) != 0) {
+			continue;
+		}
+		for (const Resolution& resolution : Resolutions) {
+			std::unique_ptr<Scene> scene = sceneInfo.Create(resolution.Width, resolution.Height);
+			char key[128];
+			std::snprintf(key, sizeof(key), "%s@%dx%d", sceneInfo.Name, resolution.Width, resolution.Height);
+			bool hasReference = false;
+			std::uint32_t referenceCrc = 0;
+
+			for (const KernelVariant& variant : KernelVariants) {
+				if (!IsVariantSupported(variant)) {
+					continue;
+				}
+				SelectVariant(variant);
+				for (std::int32_t workers : WorkerCounts) {
+					SelectWorkerCount(workers);
+
+					// Warm-up frame (pool spawn, first-touch of the targets), then the timed frames
+					if (!checkOnly) {
+						scene->BeginFrame();
+						scene->Render();
+					}
+					double elapsedNs = 0.0;
+					for (std::int32_t i = 0; i < iterations; i++) {
+						scene->BeginFrame();
+						const auto begin = std::chrono::steady_clock::now();
+						scene->Render();
+						elapsedNs += double(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+					}
+
+					scene->GetImage(image);
+					const std::uint32_t crc = Crc32(image.data(), image.size());
+					const char* status = "";
+					if (!hasReference) {
+						hasReference = true;
+						referenceCrc = crc;
+						reference = image;
+						if (update) {
+							golden[key] = crc;
+						} else if (goldenPath != nullptr) {
+							auto it = golden.find(key);
+							if (it == golden.end()) {
+								status = "  FAIL no golden checksum";
+								failures++;
+							} else if (it->second != crc) {
+								status = "  FAIL golden mismatch";
+								failures++;
+							}
+						}
+						if (pngDir != nullptr) {
+							char path[512];
+							std::snprintf(path, sizeof(path), "%s/%s_%dx%d.png", pngDir, sceneInfo.Name, resolution.Width, resolution.Height);
+							WritePng(path, image.data(), resolution.Width, resolution.Height, resolution.Width * 4);
+						}
+					} else if (crc != referenceCrc) {
+						std::size_t firstDiff = 0;
+						while (firstDiff < image.size() && image[firstDiff] == reference[firstDiff]) {
+							firstDiff++;
+						}
+						static char diffStatus[128];
+						std::snprintf(diffStatus, sizeof(diffStatus), "  FAIL differs from the reference at pixel (%d, %d)",
+							std::int32_t(firstDiff / 4) % resolution.Width, std::int32_t(firstDiff / 4) / resolution.Width);
+						status = diffStatus;
+						failures++;
+					}
+
+					const double frameNs = elapsedNs / iterations;
+					char workersText[16];
+					if (workers < 0) {
+						std::snprintf(workersText, sizeof(workersText), "auto");
+					} else {
+						std::snprintf(workersText, sizeof(workersText), "%d", workers);
+					}
+					char sizeText[16];
+					std::snprintf(sizeText, sizeof(sizeText), "%dx%d", resolution.Width, resolution.Height);
+					std::printf("%-13s %-10s %-7s %-7s %10.3f %12.3f  %08x%s\n", sceneInfo.Name, sizeText, variant.Name, workersText,
+						frameNs / 1.0e6, frameNs / (double(resolution.Width) * resolution.Height), crc, status);
+				}
+			}
+		}
+	}
+
+	SelectWorkerCount(-1);
+#if defined(DEATH_CPU_USE_RUNTIME_DISPATCH) && !defined(DEATH_CPU_USE_IFUNC)
+	RHI::Software::SwRaster::SetCpuFeatures(Cpu::runtimeFeatures());
+#endif
+
+	if (update) {
+		if (goldenPath == nullptr || !SaveGolden(goldenPath, golden)) {
+			std::printf("Cannot write the golden checksums, pass a writable --golden path\n");
+			return 1;
+		}
+		std::printf("Golden checksums written to \"%s\"\n", goldenPath);
+	}
+
+	std::printf("\n%s: %d failure(s)\n", failures == 0 ? "PASSED" : "FAILED", failures);
+	return (failures == 0 ? 0 : 1);
+}
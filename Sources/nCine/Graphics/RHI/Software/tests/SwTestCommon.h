@@ -0,0 +1,192 @@
+// Helpers shared by the standalone software RHI tools in this directory (SwBackendHarness, SwRenderBench).
+//
+// Header-only on purpose: every tool is a single translation unit linked straight against the Sw* sources,
+// without the rest of the engine, so there is no library to put these into.
+
+#pragma once
+
+// WITH_RHI_SOFTWARE is defined on the compiler command line so every translation unit sees it
+
+#include "nCine/Graphics/RHI/Software/SwBackend.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+using namespace nCine;
+
+// ---- Minimal RGBA8 PNG writer (stored/uncompressed DEFLATE, so no zlib dependency) ----
+
+inline void PutBE32(std::vector<std::uint8_t>& out, std::uint32_t v)
+{
+	out.push_back(std::uint8_t(v >> 24));
+	out.push_back(std::uint8_t(v >> 16));
+	out.push_back(std::uint8_t(v >> 8));
+	out.push_back(std::uint8_t(v));
+}
+
+inline std::uint32_t Crc32(const std::uint8_t* data, std::size_t length)
+{
+	std::uint32_t crc = 0xFFFFFFFFu;
+	for (std::size_t i = 0; i < length; i++) {
+		crc ^= data[i];
+		for (int b = 0; b < 8; b++) {
+			crc = (crc >> 1) ^ (0xEDB88320u & (~(crc & 1u) + 1u));
+		}
+	}
+	return crc ^ 0xFFFFFFFFu;
+}
+
+inline std::uint32_t Adler32(const std::uint8_t* data, std::size_t length)
+{
+	std::uint32_t a = 1, b = 0;
+	for (std::size_t i = 0; i < length; i++) {
+		a = (a + data[i]) % 65521u;
+		b = (b + a) % 65521u;
+	}
+	return (b << 16) | a;
+}
+
+inline void WriteChunk(std::vector<std::uint8_t>& png, const char* type, const std::vector<std::uint8_t>& data)
+{
+	PutBE32(png, std::uint32_t(data.size()));
+	std::vector<std::uint8_t> typeAndData;
+	typeAndData.insert(typeAndData.end(), type, type + 4);
+	typeAndData.insert(typeAndData.end(), data.begin(), data.end());
+	png.insert(png.end(), typeAndData.begin(), typeAndData.end());
+	PutBE32(png, Crc32(typeAndData.data(), typeAndData.size()));
+}
+
+inline bool WritePng(const char* path, const std::uint8_t* rgba, std::int32_t width, std::int32_t height, std::int32_t stride)
+{
+	// Filtered raw data: one filter byte (0 = none) per scanline followed by the RGBA row
+	std::vector<std::uint8_t> raw;
+	raw.reserve(std::size_t(height) * (1 + std::size_t(width) * 4));
+	for (std::int32_t y = 0; y < height; y++) {
+		raw.push_back(0);
+		const std::uint8_t* row = rgba + std::size_t(y) * stride;
+		raw.insert(raw.end(), row, row + std::size_t(width) * 4);
+	}
+
+	// zlib stream wrapping stored DEFLATE blocks
+	std::vector<std::uint8_t> zlib;
+	zlib.push_back(0x78);
+	zlib.push_back(0x01);
+	std::size_t offset = 0;
+	while (offset < raw.size()) {
+		std::size_t blockLen = raw.size() - offset;
+		if (blockLen > 65535) {
+			blockLen = 65535;
+		}
+		const bool last = (offset + blockLen >= raw.size());
+		zlib.push_back(last ? 1 : 0);
+		zlib.push_back(std::uint8_t(blockLen & 0xFF));
+		zlib.push_back(std::uint8_t((blockLen >> 8) & 0xFF));
+		const std::uint16_t nlen = std::uint16_t(~std::uint16_t(blockLen));
+		zlib.push_back(std::uint8_t(nlen & 0xFF));
+		zlib.push_back(std::uint8_t((nlen >> 8) & 0xFF));
+		zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + blockLen);
+		offset += blockLen;
+	}
+	const std::uint32_t adler = Adler32(raw.data(), raw.size());
+	PutBE32(zlib, adler);
+
+	std::vector<std::uint8_t> png = {0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A};
+	std::vector<std::uint8_t> ihdr;
+	PutBE32(ihdr, std::uint32_t(width));
+	PutBE32(ihdr, std::uint32_t(height));
+	ihdr.push_back(8);		// bit depth
+	ihdr.push_back(6);		// color type: RGBA
+	ihdr.push_back(0);		// compression
+	ihdr.push_back(0);		// filter
+	ihdr.push_back(0);		// interlace
+	WriteChunk(png, "IHDR", ihdr);
+	WriteChunk(png, "IDAT", zlib);
+	WriteChunk(png, "IEND", std::vector<std::uint8_t>{});
+
+	std::ofstream file(path, std::ios::binary);
+	if (!file) {
+		return false;
+	}
+	file.write(reinterpret_cast<const char*>(png.data()), std::streamsize(png.size()));
+	return file.good();
+}
+
+// ---- Geometry helpers ----
+
+inline void MakeTranslation(float tx, float ty, float* m)
+{
+	for (int i = 0; i < 16; i++) {
+		m[i] = 0.0f;
+	}
+	m[0] = m[5] = m[10] = m[15] = 1.0f;
+	m[12] = tx;
+	m[13] = ty;
+}
+
+inline void MakePath(const char* baseDir, const char* name, char* out, std::size_t outSize)
+{
+	std::snprintf(out, outSize, "%s/%s", baseDir, name);
+}
+
+// Ortho projection with a top-left origin, mapping model [0,W]x[0,H] to the viewport (y flipped)
+inline void BuildOrtho(std::int32_t width, std::int32_t height, float* m)
+{
+	const float near = -1.0f, far = 1.0f;
+	const float proj[16] = {
+		2.0f / width, 0.0f, 0.0f, 0.0f,
+		0.0f, -2.0f / height, 0.0f, 0.0f,
+		0.0f, 0.0f, -2.0f / (far - near), 0.0f,
+		-1.0f, 1.0f, -(far + near) / (far - near), 1.0f
+	};
+	std::memcpy(m, proj, sizeof(proj));
+}
+
+// Writes one instance's std140 InstanceBlock bytes (112-byte layout shared by every sprite-family shader)
+inline void FillInstanceRaw(std::uint8_t* dst, const float* model, const float* color, const float* texRect,
+	const float* spriteSize, float palOffset)
+{
+	std::memset(dst, 0, 112);
+	std::memcpy(dst + 0, model, 16 * sizeof(float));
+	std::memcpy(dst + 64, color, 4 * sizeof(float));
+	std::memcpy(dst + 80, texRect, 4 * sizeof(float));
+	std::memcpy(dst + 96, spriteSize, 2 * sizeof(float));
+	std::memcpy(dst + 104, &palOffset, sizeof(float));
+}
+
+inline constexpr float kIdentityView[16] = {1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1};
+inline constexpr float kTexRectFull[4] = {1.0f, 0.0f, 1.0f, 0.0f};
+inline constexpr float kWhite[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+
+// Uploads a full RGBA8 image built by a per-texel callback (helps stage the combine/scene textures)
+template<class Fn>
+inline void UploadRgba(RHI::Texture& texture, std::int32_t w, std::int32_t h, Fn texel)
+{
+	std::vector<std::uint8_t> data(std::size_t(w) * std::size_t(h) * 4);
+	for (std::int32_t y = 0; y < h; y++) {
+		for (std::int32_t x = 0; x < w; x++) {
+			std::uint8_t* p = data.data() + (std::size_t(y) * w + x) * 4;
+			texel(x, y, p);
+		}
+	}
+	texture.TexImage2D(0, PixelFormat::RGBA8, false, w, h, data.data());
+}
+
+// ---- Uniform-buffer suballocator (registered with the backend, backed by one host buffer) ----
+
+inline RHI::Buffer* g_uniformBuffer = nullptr;
+inline std::uint32_t g_uniformBump = 0;
+
+inline RHI::BufferRange AllocUniformRange(std::uint32_t bytes)
+{
+	RHI::BufferRange range;
+	const std::uint32_t alignedOffset = (g_uniformBump + 15u) & ~15u;
+	range.object = g_uniformBuffer;
+	range.offset = alignedOffset;
+	range.size = bytes;
+	range.mapBase = g_uniformBuffer->HostData();
+	g_uniformBump = alignedOffset + bytes;
+	return range;
+}
@@ -0,0 +1,14 @@
+// Engine symbols the Sw* sources reference outside of the software backend, stubbed for the standalone tools
+// in this directory, which link the backend without the rest of the engine
+
+#include "nCine/Graphics/RenderResources.h"
+
+namespace nCine
+{
+	// SwShaderProgram's destructor drops the camera uniforms the renderer cached for it; the tools never
+	// go through a camera, so there is nothing to remove
+	bool RenderResources::RemoveCameraUniformData(RHI::ShaderProgram* shaderProgram)
+	{
+		return false;
+	}
+}
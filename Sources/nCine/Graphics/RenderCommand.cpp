@@ -10,7 +10,7 @@ namespace nCine
 	RenderCommand::RenderCommand(Type type)
 		: _materialSortKey(0), _modelMatrixUniform(nullptr), _instanceBlock(nullptr), _cachedShaderChangeCounter(std::uint32_t(-1)),
 			_layer(0), _numInstances(0), _batchSize(0), _transformationCommitted(false), _modelMatrixUniformInBlock(false),
-			_modelMatrix(Matrix4x4f::Identity)
+			_modelMatrix(Matrix2x3f::Identity)
 #if defined(NCINE_PROFILING)
 			, _type(type)
 #endif
@@ -64,7 +64,7 @@ namespace nCine
 		_scissorRect.Set(x, y, width, height);
 	}
 
-	void RenderCommand::SetTransformation(const Matrix4x4f& modelMatrix)
+	void RenderCommand::SetTransformation(const Matrix2x3f& modelMatrix)
 	{
 		_modelMatrix = modelMatrix;
 		_transformationCommitted = false;
@@ -104,13 +104,15 @@ namespace nCine
 		ZoneScopedC(0x81A861);
 
 		const Camera::ProjectionValues cameraValues = RenderResources::GetCurrentCamera()->GetProjectionValues();
-		_modelMatrix[3][2] = CalculateDepth(_layer, cameraValues.nearClip, cameraValues.farClip);
+		const float depth = CalculateDepth(_layer, cameraValues.nearClip, cameraValues.farClip);
 
 		if (_material._shaderProgram && _material._shaderProgram->GetStatus() == RHI::ShaderProgram::Status::LinkedWithIntrospection) {
 			RefreshCachedUniforms();
 			if (_modelMatrixUniform) {
 				//ZoneScopedNC("Set model matrix", 0x81A861);
-				_modelMatrixUniform->SetFloatVector(_modelMatrix.Data());
+				// Shaders still declare a 4x4 model matrix, it only exists for the upload
+				const Matrix4x4f modelMatrix = _modelMatrix.ToMatrix4x4(depth);
+				_modelMatrixUniform->SetFloatVector(modelMatrix.Data());
 				if (!_modelMatrixUniformInBlock) {
 					// The loose uniform was written through a cached pointer, so the material's
 					// uniform manager has to be notified for its commit early-out check
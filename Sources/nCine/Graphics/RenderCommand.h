@@ -1,6 +1,6 @@
 #pragma once
 
-#include "../Primitives/Matrix4x4.h"
+#include "../Primitives/Matrix2x3.h"
 #include "Material.h"
 #include "Geometry.h"
 #include "Texture.h"
@@ -119,12 +119,12 @@ namespace nCine
 		/** @brief Sets the scissor rectangle for this command */
 		void SetScissor(std::int32_t x, std::int32_t y, std::int32_t width, std::int32_t height);
 
-		/** @brief Returns the model transformation matrix */
-		inline const Matrix4x4f& GetTransformation() const {
+		/** @brief Returns the 2D affine model transformation */
+		inline const Matrix2x3f& GetTransformation() const {
 			return _modelMatrix;
 		}
-		/** @brief Sets the model transformation matrix and marks it for re-committing */
-		void SetTransformation(const Matrix4x4f& modelMatrix);
+		/** @brief Sets the 2D affine model transformation and marks it for re-committing */
+		void SetTransformation(const Matrix2x3f& modelMatrix);
 
 		/** @brief Returns the material (read-only) */
 		inline const Material& GetMaterial() const {
@@ -188,7 +188,8 @@ namespace nCine
 #endif
 
 		Recti _scissorRect;
-		Matrix4x4f _modelMatrix;
+		/** @brief Model transformation, expanded to a full matrix with the layer depth only when committed */
+		Matrix2x3f _modelMatrix;
 		Material _material;
 		Geometry _geometry;
 
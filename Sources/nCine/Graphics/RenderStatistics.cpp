@@ -3,6 +3,10 @@
 #include "RenderStatistics.h"
 #include "../tracy.h"
 
+#if defined(WITH_RHI_SOFTWARE)
+#	include "RHI/Software/SwTileRenderer.h"
+#endif
+
 namespace nCine
 {
 	RenderStatistics::Commands RenderStatistics::_allCommands;
@@ -15,6 +19,9 @@ namespace nCine
 	std::uint32_t RenderStatistics::_culledNodes[2] = { 0, 0 };
 	RenderStatistics::VaoPool RenderStatistics::_vaoPool;
 	RenderStatistics::CommandPool RenderStatistics::_commandPool;
+#if defined(WITH_RHI_SOFTWARE)
+	RenderStatistics::TileDamage RenderStatistics::_tileDamage;
+#endif
 
 	void RenderStatistics::Reset()
 	{
@@ -36,6 +43,15 @@ namespace nCine
 
 		_vaoPool.reset();
 		_commandPool.reset();
+
+#if defined(WITH_RHI_SOFTWARE)
+		// The tile renderer flushed the previous frame since the last reset
+		const RHI::Software::SwTileRenderer::DamageStatistics damage = RHI::Software::SwTileRenderer::GetDamageStatistics();
+		RHI::Software::SwTileRenderer::ResetDamageStatistics();
+		_tileDamage.renderedTiles = damage.renderedTiles;
+		_tileDamage.skippedTiles = damage.skippedTiles;
+		TracyPlot("Skipped Tiles", static_cast<int64_t>(damage.skippedTiles));
+#endif
 	}
 
 	void RenderStatistics::GatherStatistics(const RenderCommand& command)
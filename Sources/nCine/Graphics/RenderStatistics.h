@@ -159,6 +159,19 @@ namespace nCine
 			friend RenderStatistics;
 		};
 
+#if defined(WITH_RHI_SOFTWARE)
+		/** @brief Counters for the screen tiles rasterized or skipped as unchanged by the software renderer */
+		class TileDamage
+		{
+		public:
+			std::uint32_t renderedTiles;
+			std::uint32_t skippedTiles;
+
+			TileDamage()
+				: renderedTiles(0), skippedTiles(0) {}
+		};
+#endif
+
 		/** @brief Returns the command statistics aggregated across all types */
 		static inline const Commands& GetAllCommands() {
 			return _allCommands;
@@ -203,6 +216,13 @@ namespace nCine
 			return _commandPool;
 		}
 
+#if defined(WITH_RHI_SOFTWARE)
+		/** @brief Returns the tile damage statistics of the software renderer for the last frame */
+		static inline const TileDamage& GetTileDamage() {
+			return _tileDamage;
+		}
+#endif
+
 	private:
 		static Commands _allCommands;
 		static Commands _typedCommands[(std::int32_t)RenderCommand::Type::Count];
@@ -214,6 +234,9 @@ namespace nCine
 		static std::uint32_t _culledNodes[2];
 		static VaoPool _vaoPool;
 		static CommandPool _commandPool;
+#if defined(WITH_RHI_SOFTWARE)
+		static TileDamage _tileDamage;
+#endif
 
 		static void Reset();
 		static void GatherStatistics(const RenderCommand& command);
@@ -5,6 +5,9 @@
 
 namespace nCine
 {
+	std::uint32_t SceneNode::_hierarchyVersion = 0;
+	bool SceneNode::_transformsDeferred = false;
+
 	/** @param parent The parent can be `nullptr` */
 	SceneNode::SceneNode(SceneNode* parent, float x, float y)
 		: Object(ObjectType::SceneNode),
@@ -14,8 +17,9 @@ namespace nCine
 		_position(x, y), _anchorPoint(0.0f, 0.0f), _scaleFactor(1.0f, 1.0f), _rotation(0.0f),
 		_color(Colorf::White), _layer(0), _absPosition(0.0f, 0.0f), _absScaleFactor(1.0f, 1.0f),
 		_absRotation(0.0f), _absColor(Colorf::White), _absLayer(0),
-		_worldMatrix(Matrix4x4f::Identity), _localMatrix(Matrix4x4f::Identity),
-		_shouldDeleteChildrenOnDestruction(true), _dirtyBits(0xFF), _lastFrameUpdated(0)
+		_worldMatrix(Matrix2x3f::Identity), _localMatrix(Matrix2x3f::Identity),
+		_shouldDeleteChildrenOnDestruction(true), _dirtyBits(0xFF), _lastFrameUpdated(0), _lastFrameInterpolated(0),
+		_previousTickPosition(x, y), _tickPosition(x, y)
 	{
 		setParent(parent);
 	}
@@ -50,13 +54,15 @@ namespace nCine
 		}
 
 		setParent(nullptr);
+		_hierarchyVersion++;
 	}
 
 	SceneNode::SceneNode(SceneNode&& other) noexcept
 		: Object(std::move(other)), _updateEnabled(other._updateEnabled), _drawEnabled(other._drawEnabled), _parent(other._parent),
 			_children(std::move(other._children)), _visitOrderState(other._visitOrderState), _position(other._position), _anchorPoint(other._anchorPoint),
 			_scaleFactor(other._scaleFactor), _rotation(other._rotation), _color(other._color), _layer(other._layer),
-			_shouldDeleteChildrenOnDestruction(other._shouldDeleteChildrenOnDestruction), _dirtyBits(other._dirtyBits), _lastFrameUpdated(other._lastFrameUpdated)
+			_shouldDeleteChildrenOnDestruction(other._shouldDeleteChildrenOnDestruction), _dirtyBits(other._dirtyBits), _lastFrameUpdated(other._lastFrameUpdated),
+			_lastFrameInterpolated(other._lastFrameInterpolated), _previousTickPosition(other._previousTickPosition), _tickPosition(other._tickPosition)
 	{
 		swapChildPointer(this, &other);
 		for (SceneNode* child : _children) {
@@ -82,6 +88,9 @@ namespace nCine
 		_shouldDeleteChildrenOnDestruction = other._shouldDeleteChildrenOnDestruction;
 		_dirtyBits = other._dirtyBits;
 		_lastFrameUpdated = other._lastFrameUpdated;
+		_lastFrameInterpolated = other._lastFrameInterpolated;
+		_previousTickPosition = other._previousTickPosition;
+		_tickPosition = other._tickPosition;
 
 		swapChildPointer(this, &other);
 		for (SceneNode* child : _children) {
@@ -104,6 +113,7 @@ namespace nCine
 		if (parentNode != nullptr) {
 			parentNode->_children.push_back(this);
 			_childOrderIndex = (unsigned int)parentNode->_children.size() - 1;
+			parentNode->hierarchyChanged();
 		}
 		_parent = parentNode;
 
@@ -127,6 +137,7 @@ namespace nCine
 		_children.push_back(childNode);
 		childNode->_childOrderIndex = (unsigned int)_children.size() - 1;
 		childNode->_parent = this;
+		hierarchyChanged();
 
 		return true;
 	}
@@ -169,6 +180,7 @@ namespace nCine
 		// The last child has been moved to this index position
 		if (_children.size() > index)
 			_children[index]->_childOrderIndex = index;
+		hierarchyChanged();
 		return true;
 	}
 
@@ -185,6 +197,7 @@ namespace nCine
 			_dirtyBits.set(DirtyBitPositions::AabbBit);
 		}
 		_children.clear();
+		hierarchyChanged();
 
 		return true;
 	}
@@ -238,6 +251,7 @@ namespace nCine
 
 		std::swap(_children[firstIndex], _children[secondIndex]);
 		std::swap(_children[firstIndex]->_childOrderIndex, _children[secondIndex]->_childOrderIndex);
+		hierarchyChanged();
 		return true;
 	}
 
@@ -266,22 +280,63 @@ namespace nCine
 		// Early return not needed, the first call to this method is on the root node
 
 		if (_updateEnabled) {
-			transform();
+			// A node that missed the previous update (just created or re-enabled) has nothing to interpolate from
+			const std::uint32_t updateCount = theApplication().GetUpdateCount();
+			_previousTickPosition = (_lastFrameUpdated + 1 == updateCount ? _tickPosition : _position);
+			_tickPosition = _position;
+
+			// With a flattened scene graph, the transformation and the reset of the bits are done by its linear pass
+			if (!_transformsDeferred) {
+				transform();
+			}
 
 			for (unsigned int i = 0; i < (unsigned int)_children.size(); i++) {
 				_children[i]->OnUpdate(timeMult);
 			}
 
-			_dirtyBits.reset(DirtyBitPositions::TransformationBit);
-			_dirtyBits.reset(DirtyBitPositions::ColorBit);
+			if (!_transformsDeferred) {
+				_dirtyBits.reset(DirtyBitPositions::TransformationBit);
+				_dirtyBits.reset(DirtyBitPositions::ColorBit);
 
-			// A non-drawable scenenode does not have the `updateRenderCommand()` method to reset the flags
-			if (_type == ObjectType::SceneNode || _type == ObjectType::ParticleSystem) {
-				_dirtyBits.reset(DirtyBitPositions::TransformationUploadBit);
-				_dirtyBits.reset(DirtyBitPositions::ColorUploadBit);
+				// A non-drawable scenenode does not have the `updateRenderCommand()` method to reset the flags
+				if (_type == ObjectType::SceneNode || _type == ObjectType::ParticleSystem) {
+					_dirtyBits.reset(DirtyBitPositions::TransformationUploadBit);
+					_dirtyBits.reset(DirtyBitPositions::ColorUploadBit);
+				}
 			}
 
-			_lastFrameUpdated = theApplication().GetFrameCount();
+			_lastFrameUpdated = updateCount;
+		}
+	}
+
+	void SceneNode::OnInterpolate(float alpha)
+	{
+		// Early return not needed, the first call to this method is on the root node
+
+		if (_updateEnabled) {
+			// Nodes that weren't updated by the last tick stay where they are
+			const bool updatedByLastTick = (_lastFrameUpdated == theApplication().GetUpdateCount());
+			const Vector2f delta = _tickPosition - _previousTickPosition;
+			if (updatedByLastTick && (delta.X != 0.0f || delta.Y != 0.0f) && delta.SqrLength() < InterpolationSnapDistance * InterpolationSnapDistance) {
+				// Transform at the interpolated position, but keep the actual one for the next update
+				const Vector2f position = _position;
+				_position = _previousTickPosition + delta * alpha;
+				_dirtyBits.set(DirtyBitPositions::TransformationBit);
+				_dirtyBits.set(DirtyBitPositions::AabbBit);
+				transform();
+				_position = position;
+			} else {
+				// Picks up the interpolated transformation of the parent, if any
+				transform();
+			}
+
+			for (unsigned int i = 0; i < (unsigned int)_children.size(); i++) {
+				_children[i]->OnInterpolate(alpha);
+			}
+
+			// The transformation bit is left set, so the next update recalculates the actual transformation
+
+			_lastFrameInterpolated = theApplication().GetFrameCount();
 		}
 	}
 
@@ -312,8 +367,9 @@ namespace nCine
 			_withVisitOrder(true), _visitOrderState(other._visitOrderState), _visitOrderIndex(0), _position(other._position),
 			_anchorPoint(other._anchorPoint), _scaleFactor(other._scaleFactor), _rotation(other._rotation), _color(other._color),
 			_layer(other._layer), _absPosition(0.0f, 0.0f), _absScaleFactor(1.0f, 1.0f), _absRotation(0.0f), _absColor(Colorf::White),
-			_absLayer(0), _worldMatrix(Matrix4x4f::Identity), _localMatrix(Matrix4x4f::Identity),
-			_shouldDeleteChildrenOnDestruction(other._shouldDeleteChildrenOnDestruction), _dirtyBits(0xFF)
+			_absLayer(0), _worldMatrix(Matrix2x3f::Identity), _localMatrix(Matrix2x3f::Identity),
+			_shouldDeleteChildrenOnDestruction(other._shouldDeleteChildrenOnDestruction), _dirtyBits(0xFF), _lastFrameUpdated(0),
+			_lastFrameInterpolated(0), _previousTickPosition(other._position), _tickPosition(other._position)
 	{
 		setParent(other._parent);
 	}
@@ -334,6 +390,7 @@ namespace nCine
 				}
 			}
 		}
+		_hierarchyVersion++;
 	}
 
 	void SceneNode::transform()
@@ -381,29 +438,22 @@ namespace nCine
 			const float tx = _position.X - _anchorPoint.X * m00 - _anchorPoint.Y * m10;
 			const float ty = _position.Y - _anchorPoint.X * m01 - _anchorPoint.Y * m11;
 
-			_localMatrix[0].Set(m00, m01, 0.0f, 0.0f);
-			_localMatrix[1].Set(m10, m11, 0.0f, 0.0f);
-			_localMatrix[2].Set(0.0f, 0.0f, 1.0f, 0.0f);
-			_localMatrix[3].Set(tx, ty, 0.0f, 1.0f);
+			_localMatrix[0].Set(m00, m01);
+			_localMatrix[1].Set(m10, m11);
+			_localMatrix[2].Set(tx, ty);
 
 			_absScaleFactor = _scaleFactor;
 			_absRotation = _rotation;
 
 			if (_parent != nullptr) {
-				// Equivalent to _parent->_worldMatrix * _localMatrix, but the two zero columns of the local matrix are skipped
-				const Matrix4x4f& pm = _parent->_worldMatrix;
-				_worldMatrix[0] = pm[0] * m00 + pm[1] * m01;
-				_worldMatrix[1] = pm[0] * m10 + pm[1] * m11;
-				_worldMatrix[2] = pm[2];
-				_worldMatrix[3] = pm[0] * tx + pm[1] * ty + pm[3];
+				_worldMatrix = _parent->_worldMatrix * _localMatrix;
 
 				_absScaleFactor *= _parent->_absScaleFactor;
 				_absRotation += _parent->_absRotation;
 			} else {
 				_worldMatrix = _localMatrix;
 			}
-			_absPosition.X = _worldMatrix[3][0];
-			_absPosition.Y = _worldMatrix[3][1];
+			_absPosition = _worldMatrix[2];
 
 			_dirtyBits.set(DirtyBitPositions::TransformationUploadBit);
 		}
@@ -2,7 +2,7 @@
 
 #include "../Base/Object.h"
 #include "../Primitives/Vector2.h"
-#include "../Primitives/Matrix4x4.h"
+#include "../Primitives/Matrix2x3.h"
 #include "../Primitives/Color.h"
 #include "../Primitives/Colorf.h"
 #include "../Base/BitSet.h"
@@ -27,6 +27,8 @@ namespace nCine
 	*/
 	class SceneNode : public Object
 	{
+		friend class FlatSceneGraph;
+
 	public:
 		/** @brief Whether a node uses its visit order to break ties between same-layer siblings */
 		enum class VisitOrderState
@@ -117,6 +119,13 @@ namespace nCine
 
 		/** @brief Called every frame to update the node state */
 		virtual void OnUpdate(float timeMult);
+		/**
+		 * @brief Transforms the node and its children at the position between the last two updates, used in fixed-timestep mode
+		 *
+		 * The interpolated transformation is only used for rendering, the transformation is recalculated
+		 * from the actual position by the next update.
+		 */
+		void OnInterpolate(float alpha);
 		/** @brief Updates the absolute transform, draws the node and visits its children */
 		virtual void OnVisit(RenderQueue& renderQueue, std::uint32_t& visitOrderIndex);
 		/** @brief Called when the node needs to be drawn, returning `true` if a command was added */
@@ -255,18 +264,18 @@ namespace nCine
 		}
 
 		/** @brief Returns the node world matrix */
-		inline const Matrix4x4f& worldMatrix() const {
+		inline const Matrix2x3f& worldMatrix() const {
 			return _worldMatrix;
 		}
 		/** @brief Sets the node world matrix (only useful when called inside `OnPostUpdate()`) */
-		void setWorldMatrix(const Matrix4x4f& worldMatrix);
+		void setWorldMatrix(const Matrix2x3f& worldMatrix);
 
 		/** @brief Returns the node local matrix */
-		inline const Matrix4x4f& localMatrix() const {
+		inline const Matrix2x3f& localMatrix() const {
 			return _localMatrix;
 		}
 		/** @brief Sets the node local matrix */
-		void setLocalMatrix(const Matrix4x4f& localMatrix);
+		void setLocalMatrix(const Matrix2x3f& localMatrix);
 
 		/**
 		 * @brief Returns the delete children on destruction flag
@@ -285,6 +294,15 @@ namespace nCine
 		inline std::uint32_t lastFrameUpdated() const {
 			return _lastFrameUpdated;
 		}
+		/** @brief Returns the last frame in which any viewport interpolated this node */
+		inline std::uint32_t lastFrameInterpolated() const {
+			return _lastFrameInterpolated;
+		}
+		/** @brief Makes the next rendered frames start from the current position, e.g. after the node has been teleported */
+		inline void resetInterpolation() {
+			_previousTickPosition = _position;
+			_tickPosition = _position;
+		}
 
 	protected:
 		/** @brief Bit positions inside the dirty bitset */
@@ -378,19 +396,39 @@ namespace nCine
 		/** @brief Bitset that stores the various dirty state bits */
 		BitSet<std::uint8_t> _dirtyBits;
 
-		/** @brief World transformation matrix (calculated from the local and the parent's world matrix) */
-		Matrix4x4f _worldMatrix;
-		/** @brief Local transformation matrix */
-		Matrix4x4f _localMatrix;
+		/** @brief World 2D affine transformation (calculated from the local and the parent's world matrix) */
+		Matrix2x3f _worldMatrix;
+		/** @brief Local 2D affine transformation */
+		Matrix2x3f _localMatrix;
 
 		/** @brief Last frame any viewport updated this node */
 		std::uint32_t _lastFrameUpdated;
+		/** @brief Last frame any viewport interpolated this node */
+		std::uint32_t _lastFrameInterpolated;
+		/** @brief Node position in the update before the last one, used for interpolation */
+		Vector2f _previousTickPosition;
+		/** @brief Node position in the last update, used for interpolation */
+		Vector2f _tickPosition;
+
+		/** @brief Longer moves between two updates are not interpolated, so teleported nodes don't sweep across the screen */
+		static constexpr float InterpolationSnapDistance = 128.0f;
+
+		/** @brief Incremented whenever a node is attached, detached, reordered or destroyed */
+		static std::uint32_t _hierarchyVersion;
+		/** @brief Whether `OnUpdate()` leaves the transformation to the linear pass of a @ref FlatSceneGraph */
+		static bool _transformsDeferred;
 
 		/** @brief Protected copy constructor used to clone objects */
 		SceneNode(const SceneNode& other);
 
 		/** @brief Swaps the child pointer of a parent when moving an object */
 		void swapChildPointer(SceneNode* first, SceneNode* second);
+		/** @brief Invalidates the flattened copies of the hierarchy, particles are not part of them */
+		inline void hierarchyChanged() {
+			if (_type != ObjectType::ParticleSystem) {
+				_hierarchyVersion++;
+			}
+		}
 
 		virtual void transform();
 	};
@@ -529,14 +567,14 @@ namespace nCine
 		_dirtyBits.set(DirtyBitPositions::ColorBit);
 	}
 
-	inline void SceneNode::setWorldMatrix(const Matrix4x4f& worldMatrix)
+	inline void SceneNode::setWorldMatrix(const Matrix2x3f& worldMatrix)
 	{
 		_worldMatrix = worldMatrix;
 		_dirtyBits.set(DirtyBitPositions::TransformationBit);
 		_dirtyBits.set(DirtyBitPositions::AabbBit);
 	}
 
-	inline void SceneNode::setLocalMatrix(const Matrix4x4f& localMatrix)
+	inline void SceneNode::setLocalMatrix(const Matrix2x3f& localMatrix)
 	{
 		_localMatrix = localMatrix;
 		_dirtyBits.set(DirtyBitPositions::TransformationBit);
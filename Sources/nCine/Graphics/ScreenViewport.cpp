@@ -54,6 +54,27 @@ namespace nCine
 		Viewport::Update();
 	}
 
+	void ScreenViewport::ResetUpdated()
+	{
+		// Allows the chain to be updated again by the next tick of the same frame
+		for (std::size_t i = 0; i < _chain.size(); i++) {
+			if (_chain[i]) {
+				_chain[i]->_stateBits.reset(StateBitPositions::UpdatedBit);
+			}
+		}
+		_stateBits.reset(StateBitPositions::UpdatedBit);
+	}
+
+	void ScreenViewport::Interpolate(float alpha)
+	{
+		for (std::int32_t i = std::int32_t(_chain.size()) - 1; i >= 0; i--) {
+			if (_chain[i]) {
+				_chain[i]->Interpolate(alpha);
+			}
+		}
+		Viewport::Interpolate(alpha);
+	}
+
 	void ScreenViewport::Visit()
 	{
 		for (std::int32_t i = std::int32_t(_chain.size()) - 1; i >= 0; i--) {
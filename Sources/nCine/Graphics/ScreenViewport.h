@@ -26,6 +26,8 @@ namespace nCine
 
 	private:
 		void Update();
+		void ResetUpdated();
+		void Interpolate(float alpha);
 		void Visit();
 		void SortAndCommitQueue();
 		void Draw();
@@ -4,6 +4,7 @@
 #include "../Application.h"
 #include "../IAppEventHandler.h"
 #include "DrawableNode.h"
+#include "FlatSceneGraph.h"
 #include "Camera.h"
 #include "RHI/Rhi.h"
 #include "Texture.h"
@@ -282,16 +283,49 @@ namespace nCine
 
 		if (_rootNode != nullptr) {
 			ZoneScopedC(0x81A861);
-			if (_rootNode->lastFrameUpdated() < theApplication().GetFrameCount()) {
-				_rootNode->OnUpdate(theApplication().GetTimeMult());
+			FlatSceneGraph* flatSceneGraph = GetFlatSceneGraph();
+			if (_rootNode->lastFrameUpdated() < theApplication().GetUpdateCount()) {
+				if (flatSceneGraph != nullptr) {
+					flatSceneGraph->Update(_rootNode, theApplication().GetTimeMult());
+				} else {
+					_rootNode->OnUpdate(theApplication().GetTimeMult());
+				}
 			}
 			// AABBs should update after nodes have been transformed
-			UpdateCulling(_rootNode);
+			if (flatSceneGraph != nullptr) {
+				flatSceneGraph->UpdateCulling(_rootNode, _cullingRect);
+			} else {
+				UpdateCulling(_rootNode);
+			}
 		}
 
 		_stateBits.set(StateBitPositions::UpdatedBit);
 	}
 
+	void Viewport::Interpolate(float alpha)
+	{
+		RenderResources::SetCurrentViewport(this);
+		RenderResources::SetCurrentCamera(_camera);
+
+		if (_rootNode != nullptr) {
+			ZoneScopedC(0x81A861);
+			FlatSceneGraph* flatSceneGraph = GetFlatSceneGraph();
+			if (_rootNode->lastFrameInterpolated() < theApplication().GetFrameCount()) {
+				if (flatSceneGraph != nullptr) {
+					flatSceneGraph->Interpolate(_rootNode, alpha);
+				} else {
+					_rootNode->OnInterpolate(alpha);
+				}
+			}
+			// Culling should use the interpolated transformations
+			if (flatSceneGraph != nullptr) {
+				flatSceneGraph->UpdateCulling(_rootNode, _cullingRect);
+			} else {
+				UpdateCulling(_rootNode);
+			}
+		}
+	}
+
 	void Viewport::Visit()
 	{
 		RenderResources::SetCurrentViewport(this);
@@ -450,4 +484,14 @@ namespace nCine
 			drawable->updateCulling();
 		}
 	}
+
+	FlatSceneGraph* Viewport::GetFlatSceneGraph()
+	{
+		if (!theApplication().GetRenderingSettings().flatSceneGraph) {
+			_flatSceneGraph = nullptr;
+		} else if (_flatSceneGraph == nullptr) {
+			_flatSceneGraph = std::make_unique<FlatSceneGraph>();
+		}
+		return _flatSceneGraph.get();
+	}
 }
@@ -16,6 +16,7 @@ using namespace Death::Containers;
 namespace nCine
 {
 	class SceneNode;
+	class FlatSceneGraph;
 	class Camera;
 	class Texture;
 
@@ -261,13 +262,17 @@ namespace nCine
 		void CalculateCullingRect();
 
 		void Update();
+		void Interpolate(float alpha);
 		void Visit();
 		void SortAndCommitQueue();
 		void Draw(std::uint32_t nextIndex);
 
 	private:
 		std::uint32_t _numColorAttachments;
+		/** @brief Flattened copy of the scene graph, only allocated when enabled in the rendering settings */
+		std::unique_ptr<FlatSceneGraph> _flatSceneGraph;
 
 		void UpdateCulling(SceneNode* node);
+		FlatSceneGraph* GetFlatSceneGraph();
 	};
 }
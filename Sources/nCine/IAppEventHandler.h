@@ -32,6 +32,12 @@ namespace nCine
 		virtual void OnBeginFrame() {}
 		/** @brief Called every time the scenegraph has been traversed and all nodes have been transformed */
 		virtual void OnPostUpdate() {}
+		/**
+		 * @brief Called once per frame in fixed-timestep mode, after all ticks of the frame and before the scenegraph is drawn
+		 *
+		 * The @p alpha factor tells how far the rendered frame is between the previous and the last tick.
+		 */
+		virtual void OnInterpolate(float alpha) {}
 		/** @brief Called every time a viewport is going to be drawn */
 		virtual void OnDrawViewport(Viewport& viewport) {}
 		/** @brief Called at the end of each frame, just before swapping buffers */
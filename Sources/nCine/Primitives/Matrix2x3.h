@@ -0,0 +1,267 @@
+#pragma once
+
+#include "Vector2.h"
+#include "Matrix4x4.h"
+
+namespace nCine
+{
+	inline namespace Primitives
+	{
+		using Death::Containers::NoInitT;
+
+		/**
+			@brief Two-by-three affine matrix
+
+			Column-major 2D affine transformation stored as three @ref Vector2 columns --- the two basis vectors
+			of the linear part followed by the translation. It holds the only elements of a 2D @ref Matrix4x4
+			that are not constant, so it is used wherever the engine transforms in the plane and is expanded by
+			@ref ToMatrix4x4() only when a full matrix has to be uploaded. Provides composition, point
+			transformation and in-place and standalone transform builders (translation, rotation, scaling).
+		*/
+		template<class T>
+		class Matrix2x3
+		{
+		public:
+			constexpr Matrix2x3() noexcept
+				: _vecs{Vector2<T>(T(1), T(0)), Vector2<T>(T(0), T(1)), Vector2<T>(T(0), T(0))} {}
+
+			explicit Matrix2x3(NoInitT) noexcept {}
+
+			Matrix2x3(const Vector2<T>& v0, const Vector2<T>& v1, const Vector2<T>& v2) noexcept;
+			/** @brief Extracts the 2D affine part of a 4x4 matrix, its Z and W rows and columns are dropped */
+			explicit Matrix2x3(const Matrix4x4<T>& m) noexcept;
+
+			void Set(const Vector2<T>& v0, const Vector2<T>& v1, const Vector2<T>& v2);
+
+			T* Data();
+			const T* Data() const;
+
+			Vector2<T>& operator[](std::size_t index);
+			const Vector2<T>& operator[](std::size_t index) const;
+
+			bool operator==(const Matrix2x3& m) const;
+			bool operator!=(const Matrix2x3& m) const;
+
+			Matrix2x3& operator*=(const Matrix2x3& m);
+			Matrix2x3 operator*(const Matrix2x3& m) const;
+			/** @brief Transforms a point, the translation is applied */
+			Vector2<T> operator*(const Vector2<T>& v) const;
+
+			/** @brief Applies a translation to the matrix in place */
+			Matrix2x3& Translate(T xx, T yy);
+			/** @overload */
+			Matrix2x3& Translate(const Vector2<T>& v);
+			/** @brief Applies a rotation around the Z axis to the matrix in place */
+			Matrix2x3& RotateZ(T radians);
+			/** @brief Applies a non-uniform scaling to the matrix in place */
+			Matrix2x3& Scale(T xx, T yy);
+			/** @brief Applies a uniform scaling to the matrix in place */
+			Matrix2x3& Scale(T s);
+
+			/** @brief Creates a translation matrix */
+			static Matrix2x3 Translation(T xx, T yy);
+			/** @overload */
+			static Matrix2x3 Translation(const Vector2<T>& v);
+			// Kept a real call on SH4 (Dreamcast) for the same reason as Matrix4x4::RotationZ(), see the note there
+#if defined(DEATH_TARGET_DREAMCAST)
+#	define DEATH_MATRIX_ROTATION_BUILDER DEATH_NEVER_INLINE
+#else
+#	define DEATH_MATRIX_ROTATION_BUILDER
+#endif
+			/** @brief Creates a rotation matrix around the Z axis */
+			DEATH_MATRIX_ROTATION_BUILDER static Matrix2x3 RotationZ(T radians);
+			/** @brief Creates a non-uniform scaling matrix */
+			static Matrix2x3 Scaling(T xx, T yy);
+			/** @brief Creates a uniform scaling matrix */
+			static Matrix2x3 Scaling(T s);
+
+			/** @brief Returns the equivalent 4x4 matrix, translated by `zz` along the Z axis */
+			Matrix4x4<T> ToMatrix4x4(T zz = T(0)) const;
+
+			/** @{ @name Constants */
+
+			/** @brief Identity matrix */
+			static const Matrix2x3 Identity;
+
+			/** @} */
+
+		private:
+			Vector2<T> _vecs[3];
+		};
+
+		/** @brief Two-by-three affine matrix of floats */
+		using Matrix2x3f = Matrix2x3<float>;
+
+		template<class T>
+		inline Matrix2x3<T>::Matrix2x3(const Vector2<T>& v0, const Vector2<T>& v1, const Vector2<T>& v2) noexcept
+		{
+			Set(v0, v1, v2);
+		}
+
+		template<class T>
+		inline Matrix2x3<T>::Matrix2x3(const Matrix4x4<T>& m) noexcept
+		{
+			Set(Vector2<T>(m[0][0], m[0][1]), Vector2<T>(m[1][0], m[1][1]), Vector2<T>(m[3][0], m[3][1]));
+		}
+
+		template<class T>
+		inline void Matrix2x3<T>::Set(const Vector2<T>& v0, const Vector2<T>& v1, const Vector2<T>& v2)
+		{
+			_vecs[0] = v0;
+			_vecs[1] = v1;
+			_vecs[2] = v2;
+		}
+
+		template<class T>
+		inline T* Matrix2x3<T>::Data()
+		{
+			return &_vecs[0].X;
+		}
+
+		template<class T>
+		inline const T* Matrix2x3<T>::Data() const
+		{
+			return &_vecs[0].X;
+		}
+
+		template<class T>
+		inline Vector2<T>& Matrix2x3<T>::operator[](std::size_t index)
+		{
+			DEATH_ASSERT(index < 3);
+			return _vecs[index];
+		}
+
+		template<class T>
+		inline const Vector2<T>& Matrix2x3<T>::operator[](std::size_t index) const
+		{
+			DEATH_ASSERT(index < 3);
+			return _vecs[index];
+		}
+
+		template<class T>
+		inline bool Matrix2x3<T>::operator==(const Matrix2x3& m) const
+		{
+			return (_vecs[0] == m[0] && _vecs[1] == m[1] && _vecs[2] == m[2]);
+		}
+
+		template<class T>
+		inline bool Matrix2x3<T>::operator!=(const Matrix2x3& m) const
+		{
+			return !operator==(m);
+		}
+
+		template<class T>
+		inline Matrix2x3<T>& Matrix2x3<T>::operator*=(const Matrix2x3& m)
+		{
+			*this = *this * m;
+			return *this;
+		}
+
+		template<class T>
+		inline Matrix2x3<T> Matrix2x3<T>::operator*(const Matrix2x3& m2) const
+		{
+			const Matrix2x3& m1 = *this;
+
+			return Matrix2x3(m1[0] * m2[0].X + m1[1] * m2[0].Y,
+				m1[0] * m2[1].X + m1[1] * m2[1].Y,
+				m1[0] * m2[2].X + m1[1] * m2[2].Y + m1[2]);
+		}
+
+		template<class T>
+		inline Vector2<T> Matrix2x3<T>::operator*(const Vector2<T>& v) const
+		{
+			return Vector2<T>(_vecs[0].X * v.X + _vecs[1].X * v.Y + _vecs[2].X,
+				_vecs[0].Y * v.X + _vecs[1].Y * v.Y + _vecs[2].Y);
+		}
+
+		template<class T>
+		inline Matrix2x3<T>& Matrix2x3<T>::Translate(T xx, T yy)
+		{
+			_vecs[2] += _vecs[0] * xx + _vecs[1] * yy;
+			return *this;
+		}
+
+		template<class T>
+		inline Matrix2x3<T>& Matrix2x3<T>::Translate(const Vector2<T>& v)
+		{
+			return Translate(v.X, v.Y);
+		}
+
+		template<class T>
+		inline Matrix2x3<T>& Matrix2x3<T>::RotateZ(T radians)
+		{
+			// Always composed from RotationZ(), see the note in Matrix4x4::RotateZ() for the barrier
+			Matrix2x3 r = RotationZ(radians);
+#if defined(DEATH_TARGET_DREAMCAST)
+			asm volatile("" : "+m"(r));
+#endif
+			return (*this = *this * r);
+		}
+
+		template<class T>
+		inline Matrix2x3<T>& Matrix2x3<T>::Scale(T xx, T yy)
+		{
+			_vecs[0] *= xx;
+			_vecs[1] *= yy;
+			return *this;
+		}
+
+		template<class T>
+		inline Matrix2x3<T>& Matrix2x3<T>::Scale(T s)
+		{
+			return Scale(s, s);
+		}
+
+		template<class T>
+		inline Matrix2x3<T> Matrix2x3<T>::Translation(T xx, T yy)
+		{
+			return Matrix2x3(Vector2<T>(1, 0), Vector2<T>(0, 1), Vector2<T>(xx, yy));
+		}
+
+		template<class T>
+		inline Matrix2x3<T> Matrix2x3<T>::Translation(const Vector2<T>& v)
+		{
+			return Translation(v.X, v.Y);
+		}
+
+		template<class T>
+		inline Matrix2x3<T> Matrix2x3<T>::RotationZ(T radians)
+		{
+			const T c = cos(radians);
+			const T s = sin(radians);
+#if defined(DEATH_TARGET_DREAMCAST)
+			const T ns = sin(-radians);	// Never "-s", see the note in Matrix4x4::RotationZ()
+#else
+			const T ns = -s;
+#endif
+
+			return Matrix2x3(Vector2<T>(c, s), Vector2<T>(ns, c), Vector2<T>(0, 0));
+		}
+
+		template<class T>
+		inline Matrix2x3<T> Matrix2x3<T>::Scaling(T xx, T yy)
+		{
+			return Matrix2x3(Vector2<T>(xx, 0), Vector2<T>(0, yy), Vector2<T>(0, 0));
+		}
+
+		template<class T>
+		inline Matrix2x3<T> Matrix2x3<T>::Scaling(T s)
+		{
+			return Scaling(s, s);
+		}
+
+		template<class T>
+		inline Matrix4x4<T> Matrix2x3<T>::ToMatrix4x4(T zz) const
+		{
+			return Matrix4x4<T>(Vector4<T>(_vecs[0].X, _vecs[0].Y, 0, 0),
+				Vector4<T>(_vecs[1].X, _vecs[1].Y, 0, 0),
+				Vector4<T>(0, 0, 1, 0),
+				Vector4<T>(_vecs[2].X, _vecs[2].Y, zz, 1));
+		}
+
+		template<class T>
+		const Matrix2x3<T> Matrix2x3<T>::Identity(Vector2<T>(1, 0), Vector2<T>(0, 1), Vector2<T>(0, 0));
+	}
+}
+
+#undef DEATH_MATRIX_ROTATION_BUILDER
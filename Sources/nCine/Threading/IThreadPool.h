@@ -2,6 +2,7 @@
 
 #include "IThreadCommand.h"
 
+#include <cstdint>
 #include <memory>
 
 namespace nCine
@@ -19,6 +20,8 @@ namespace nCine
 
 		/** @brief Enqueues a command to be executed by a worker thread */
 		virtual void EnqueueCommand(std::unique_ptr<IThreadCommand>&& threadCommand) = 0;
+		/** @brief Returns the number of worker threads, zero if enqueued commands are never executed */
+		virtual std::uint32_t GetThreadCount() const = 0;
 	};
 
 	inline IThreadPool::~IThreadPool() { }
@@ -29,6 +32,7 @@ namespace nCine
 	{
 	public:
 		void EnqueueCommand(std::unique_ptr<IThreadCommand>&& threadCommand) override { }
+		std::uint32_t GetThreadCount() const override { return 0; }
 	};
 #endif
 }
\ No newline at end of file
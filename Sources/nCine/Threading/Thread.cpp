@@ -1,5 +1,6 @@
 #include "Thread.h"
 #include "../../Main.h"
+#include "../Base/FrameProfiler.h"
 
 #include <atomic>
 #include <cstring>
@@ -428,6 +429,9 @@ namespace nCine
 
 	void Thread::SetCurrentName(const char* name)
 	{
+#if defined(WITH_FRAME_PROFILER)
+		FrameProfiler::SetCurrentThreadName(name);
+#endif
 #if defined(WITH_TRACY)
 		tracy::SetThreadName(name);
 #elif defined(DEATH_TARGET_WINDOWS)
@@ -53,6 +53,11 @@ namespace nCine
 		_queueMutex.Unlock();
 	}
 
+	std::uint32_t ThreadPool::GetThreadCount() const
+	{
+		return std::uint32_t(_threads.size());
+	}
+
 	void ThreadPool::WorkerFunction(void* arg)
 	{
 		ThreadStruct* threadStruct = static_cast<ThreadStruct*>(arg);
@@ -28,6 +28,7 @@ namespace nCine
 		~ThreadPool() override;
 
 		void EnqueueCommand(std::unique_ptr<IThreadCommand>&& threadCommand) override;
+		std::uint32_t GetThreadCount() const override;
 
 	private:
 #ifndef DOXYGEN_GENERATING_OUTPUT
@@ -4,19 +4,34 @@
 #else
 
 // From Tracy.hpp
-#	define ZoneNamed(x, y)
-#	define ZoneNamedN(x, y, z)
-#	define ZoneNamedC(x, y, z)
-#	define ZoneNamedNC(x, y, z, w)
+#	if defined(WITH_FRAME_PROFILER)
+// Without Tracy, scoped zones are recorded by the built-in frame profiler instead
+#		include "Base/FrameProfiler.h"
+
+#		define ZoneNamed(x, y) __NCINE_PROFILER_ZONE(x, nullptr, 0)
+#		define ZoneNamedN(x, y, z) __NCINE_PROFILER_ZONE(x, y, 0)
+#		define ZoneNamedC(x, y, z) __NCINE_PROFILER_ZONE(x, nullptr, y)
+#		define ZoneNamedNC(x, y, z, w) __NCINE_PROFILER_ZONE(x, y, z)
+
+#		define ZoneScoped __NCINE_PROFILER_ZONE(__frameProfilerZone, nullptr, 0)
+#		define ZoneScopedN(x) __NCINE_PROFILER_ZONE(__frameProfilerZone, x, 0)
+#		define ZoneScopedC(x) __NCINE_PROFILER_ZONE(__frameProfilerZone, nullptr, x)
+#		define ZoneScopedNC(x, y) __NCINE_PROFILER_ZONE(__frameProfilerZone, x, y)
+#	else
+#		define ZoneNamed(x, y)
+#		define ZoneNamedN(x, y, z)
+#		define ZoneNamedC(x, y, z)
+#		define ZoneNamedNC(x, y, z, w)
+
+#		define ZoneScoped
+#		define ZoneScopedN(x)
+#		define ZoneScopedC(x)
+#		define ZoneScopedNC(x, y)
+#	endif
 
 #	define ZoneTransient(x, y)
 #	define ZoneTransientN(x, y, z)
 
-#	define ZoneScoped
-#	define ZoneScopedN(x)
-#	define ZoneScopedC(x)
-#	define ZoneScopedNC(x, y)
-
 #	define ZoneText(x, y)
 #	define ZoneTextV(x, y, z)
 #	define ZoneName(x, y)
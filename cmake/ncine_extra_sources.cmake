@@ -663,6 +663,10 @@ if(NCINE_WITH_TRACY)
 		PUBLIC $<INSTALL_INTERFACE:include/tracy>)
 endif()
 
+if(NCINE_WITH_FRAME_PROFILER)
+	target_compile_definitions(${NCINE_APP} PRIVATE "WITH_FRAME_PROFILER")
+endif()
+
 #if(NCINE_WITH_RENDERDOC AND NOT APPLE)
 #	find_file(RENDERDOC_API_H
 #		NAMES renderdoc.h renderdoc_app.h
@@ -1276,6 +1280,8 @@ if(WITH_MULTIPLAYER)
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/Reason.h
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/ServerDiscovery.h
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/ServerInitialization.h
+		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/ServerRoom.h
+		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/SnapshotEncoding.h
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/Teams.h
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/WebhookClient.h
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/GameModes/MpPlayerState.h
@@ -1325,6 +1331,8 @@ if(WITH_MULTIPLAYER)
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/Peer.cpp
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/RaceRouteGenerator.cpp
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/ServerDiscovery.cpp
+		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/ServerRoom.cpp
+		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/SnapshotEncoding.cpp
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/WebhookClient.cpp
 		${NCINE_SOURCE_DIR}/Jazz2/UI/Menu/CreateLocalGameOptionsSection.cpp
 		${NCINE_SOURCE_DIR}/Jazz2/UI/Menu/CreateServerOptionsSection.cpp
@@ -45,6 +45,8 @@ set(HEADERS
 	${NCINE_SOURCE_DIR}/Shared/IO/FileSystem.h
 	${NCINE_SOURCE_DIR}/Shared/IO/MemoryStream.h
 	${NCINE_SOURCE_DIR}/Shared/IO/PakFile.h
+	${NCINE_SOURCE_DIR}/Shared/IO/SpanReader.h
+	${NCINE_SOURCE_DIR}/Shared/IO/SpanWriter.h
 	${NCINE_SOURCE_DIR}/Shared/IO/Stream.h
 	${NCINE_SOURCE_DIR}/Shared/IO/WebRequest.h
 	${NCINE_SOURCE_DIR}/Shared/IO/Compression/DeflateStream.h
@@ -95,6 +97,8 @@ list(APPEND HEADERS
 	${NCINE_SOURCE_DIR}/nCine/Base/BitArray.h
 	${NCINE_SOURCE_DIR}/nCine/Base/BitSet.h
 	${NCINE_SOURCE_DIR}/nCine/Base/Clock.h
+	${NCINE_SOURCE_DIR}/nCine/Base/FrameArena.h
+	${NCINE_SOURCE_DIR}/nCine/Base/FrameProfiler.h
 	${NCINE_SOURCE_DIR}/nCine/Base/FrameTimer.h
 	${NCINE_SOURCE_DIR}/nCine/Base/HashFunctions.h
 	${NCINE_SOURCE_DIR}/nCine/Base/HashMap.h
@@ -113,6 +117,7 @@ list(APPEND HEADERS
 	${NCINE_SOURCE_DIR}/nCine/Graphics/Camera.h
 	${NCINE_SOURCE_DIR}/nCine/Graphics/DisplayMode.h
 	${NCINE_SOURCE_DIR}/nCine/Graphics/DrawableNode.h
+	${NCINE_SOURCE_DIR}/nCine/Graphics/FlatSceneGraph.h
 	${NCINE_SOURCE_DIR}/nCine/Graphics/Geometry.h
 	${NCINE_SOURCE_DIR}/nCine/Graphics/IDebugOverlay.h
 	${NCINE_SOURCE_DIR}/nCine/Graphics/IGfxDevice.h
@@ -163,6 +168,7 @@ list(APPEND HEADERS
 	${NCINE_SOURCE_DIR}/nCine/Primitives/Color.h
 	${NCINE_SOURCE_DIR}/nCine/Primitives/Colorf.h
 	${NCINE_SOURCE_DIR}/nCine/Primitives/Half.h
+	${NCINE_SOURCE_DIR}/nCine/Primitives/Matrix2x3.h
 	${NCINE_SOURCE_DIR}/nCine/Primitives/Matrix4x4.h
 	${NCINE_SOURCE_DIR}/nCine/Primitives/Quaternion.h
 	${NCINE_SOURCE_DIR}/nCine/Primitives/Rect.h
@@ -190,6 +196,7 @@ if(NCINE_PREFERRED_RHI STREQUAL "Software")
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwDevice.h
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwRaster.h
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwRenderTarget.h
+		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwRescale.h
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwRhiCapabilities.h
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwScanlineOps.h
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwShader.h
@@ -316,6 +323,7 @@ list(APPEND HEADERS
 	${NCINE_SOURCE_DIR}/Jazz2/WeaponType.h
 	${NCINE_SOURCE_DIR}/Jazz2/WeatherType.h
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/ActorBase.h
+	${NCINE_SOURCE_DIR}/Jazz2/Actors/ActorPool.h
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/Player.h
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/PlayerCorpse.h
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/SolidObjectBase.h
@@ -425,7 +433,9 @@ list(APPEND HEADERS
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/Weapons/ToasterShot.h
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/Weapons/TNT.h
 	${NCINE_SOURCE_DIR}/Jazz2/Collisions/DynamicTree.h
+	${NCINE_SOURCE_DIR}/Jazz2/Collisions/BroadPhase.h
 	${NCINE_SOURCE_DIR}/Jazz2/Collisions/DynamicTreeBroadPhase.h
+	${NCINE_SOURCE_DIR}/Jazz2/Collisions/SpatialHashBroadPhase.h
 	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/AnimSetMapping.h
 	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/EventConverter.h
 	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/JJ2Anims.h
@@ -444,6 +454,7 @@ list(APPEND HEADERS
 	${NCINE_SOURCE_DIR}/Jazz2/Input/RgbLights.h
 	${NCINE_SOURCE_DIR}/Jazz2/Input/RumbleDescription.h
 	${NCINE_SOURCE_DIR}/Jazz2/Input/RumbleProcessor.h
+	${NCINE_SOURCE_DIR}/Jazz2/Rendering/ActorCullingNode.h
 	${NCINE_SOURCE_DIR}/Jazz2/Rendering/BlurRenderPass.h
 	${NCINE_SOURCE_DIR}/Jazz2/Rendering/CombineRenderer.h
 	${NCINE_SOURCE_DIR}/Jazz2/Rendering/LightingRenderer.h
@@ -518,6 +529,7 @@ if(NCINE_PREFERRED_RHI STREQUAL "Software")
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwDevice.h
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwRaster.h
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwRenderTarget.h
+		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwRescale.h
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwShader.h
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwShaderProgram.h
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwShaderTypes.h
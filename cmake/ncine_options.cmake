@@ -324,6 +324,8 @@ endif()
 option(NCINE_WITH_ANGELSCRIPT "Enable AngelScript scripting support" OFF)
 option(NCINE_WITH_IMGUI "Enable integration with Dear ImGui" OFF)
 option(NCINE_WITH_TRACY "Enable integration with Tracy frame profiler" OFF)
+# Records the existing Tracy zones when Tracy itself is not compiled in, see nCine/Base/FrameProfiler.h
+cmake_dependent_option(NCINE_WITH_FRAME_PROFILER "Enable built-in lightweight frame profiler" ON "NCINE_WITH_THREADS;NOT NCINE_WITH_TRACY;NOT VITA;NOT NINTENDO_WII;NOT NINTENDO_GAMECUBE;NOT PLATFORM_DREAMCAST;NOT PLATFORM_PSP;NOT PLATFORM_PS2;NOT PLATFORM_PS3" OFF)
 #option(NCINE_WITH_RENDERDOC "Enable integration with RenderDoc" OFF)
 
 cmake_dependent_option(NCINE_COMPILE_OPENMPT "Compile libopenmpt from sources instead of using library" OFF "NCINE_WITH_OPENMPT" OFF)
@@ -19,6 +19,7 @@ set(SHARED_SOURCES
 	${NCINE_SOURCE_DIR}/Shared/IO/FileSystem.cpp
 	${NCINE_SOURCE_DIR}/Shared/IO/MemoryStream.cpp
 	${NCINE_SOURCE_DIR}/Shared/IO/PakFile.cpp
+	${NCINE_SOURCE_DIR}/Shared/IO/SpanReader.cpp
 	${NCINE_SOURCE_DIR}/Shared/IO/Stream.cpp
 	${NCINE_SOURCE_DIR}/Shared/IO/WebRequest.cpp
 	${NCINE_SOURCE_DIR}/Shared/IO/Compression/DeflateStream.cpp
@@ -64,6 +65,8 @@ list(APPEND SOURCES
 	${NCINE_SOURCE_DIR}/nCine/Audio/IAudioPlayer.cpp
 	${NCINE_SOURCE_DIR}/nCine/Base/BitArray.cpp
 	${NCINE_SOURCE_DIR}/nCine/Base/Clock.cpp
+	${NCINE_SOURCE_DIR}/nCine/Base/FrameArena.cpp
+	${NCINE_SOURCE_DIR}/nCine/Base/FrameProfiler.cpp
 	${NCINE_SOURCE_DIR}/nCine/Base/FrameTimer.cpp
 	${NCINE_SOURCE_DIR}/nCine/Base/HashFunctions.cpp
 	${NCINE_SOURCE_DIR}/nCine/Base/Object.cpp
@@ -75,6 +78,7 @@ list(APPEND SOURCES
 	${NCINE_SOURCE_DIR}/nCine/Graphics/BinaryShaderCache.cpp
 	${NCINE_SOURCE_DIR}/nCine/Graphics/Camera.cpp
 	${NCINE_SOURCE_DIR}/nCine/Graphics/DrawableNode.cpp
+	${NCINE_SOURCE_DIR}/nCine/Graphics/FlatSceneGraph.cpp
 	${NCINE_SOURCE_DIR}/nCine/Graphics/Geometry.cpp
 	${NCINE_SOURCE_DIR}/nCine/Graphics/IGfxDevice.cpp
 	${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/RhiCapabilitiesBase.cpp
@@ -137,6 +141,7 @@ if(NCINE_PREFERRED_RHI STREQUAL "Software")
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwDevice.cpp
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwRaster.cpp
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwRenderTarget.cpp
+		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwRescale.cpp
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwShaderProgram.cpp
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwShaderUniforms.cpp
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwTexture.cpp
@@ -277,6 +282,7 @@ list(APPEND SOURCES
 	${NCINE_SOURCE_DIR}/Jazz2/PreferencesCache.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Resources.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/ActorBase.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Actors/ActorPool.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/Player.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/PlayerCorpse.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/SolidObjectBase.cpp
@@ -387,11 +393,13 @@ list(APPEND SOURCES
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/Weapons/TNT.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Collisions/DynamicTree.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Collisions/DynamicTreeBroadPhase.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Collisions/SpatialHashBroadPhase.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Events/EventMap.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Events/EventSpawner.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Input/ControlScheme.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Input/RgbLights.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Input/RumbleProcessor.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Rendering/ActorCullingNode.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Rendering/BlurRenderPass.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Rendering/CombineRenderer.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Rendering/LightingRenderer.cpp